@@ -75,6 +75,38 @@ static void			AlgTstFourOutput3(
 				  double s,
 				  double ***a,
 				  int n);
+static void			AlgTstFourDFT(
+				  double *re,
+				  double *im,
+				  int d,
+				  int n);
+static void			AlgTstFourRealLine(
+				  double *a,
+				  int stride,
+				  int n,
+				  int k,
+				  double *cRe,
+				  double *cIm);
+static void			AlgTstFourRealCoef(
+				  double *a,
+				  int nX,
+				  int nY,
+				  int nZ,
+				  int x,
+				  int y,
+				  int z,
+				  double *cRe,
+				  double *cIm);
+static int			AlgTstFourCheck(
+				  int n,
+				  int d,
+				  int realFlg,
+				  double tol,
+				  double s,
+				  double *a,
+				  double *cRe,
+				  double *cIm,
+				  double *maxErr);
 
 extern int      getopt(int argc, char * const *argv, const char *optstring);
 
@@ -87,6 +119,7 @@ int             main(int argc, char **argv)
 {
   int           d = 1,
   		n = 8,
+		anyFlg = 0,
 		asyFlg = 0,
 		outFlg = 1,
 		rndFlg = 0,
@@ -97,14 +130,22 @@ int             main(int argc, char **argv)
 		option,
   		ok = 1,
 		usage = 0;
+  int		nA = 0,
+  		nV = 0,
+		nDif = 0;
   double	scale = 1.0,
+  		tol = 0.0,
+		maxErr = 0.0,
   		z = 0.0;
+  double	*a0 = NULL,
+  		*ref = NULL,
+		*org = NULL;
   double	*a1[2];
   double	**a2[2];
   double	***a3[2];
   struct timeval times[3];
   const	double	asy = ((1.0 / 7.0) + ALG_M_PI) * ALG_M_E / 13;
-  static char	optList[] = "chrsuyNRTd:n:z:";
+  static char	optList[] = "achrsuyNRTd:n:z:";
 
   a1[0] = a1[1] = NULL;
   a2[0] = a2[1] = NULL;
@@ -113,6 +154,9 @@ int             main(int argc, char **argv)
   {
     switch(option)
     {
+      case 'a':
+	anyFlg = 1;
+	break;
       case 'c':
 	realFlg = 0;
 	break;
@@ -145,8 +189,7 @@ int             main(int argc, char **argv)
 	}
 	break;
       case 'n':
-	if((sscanf(optarg, "%d", &n) != 1) || (n < 4) ||
-	   (AlgBitIsPowerOfTwo(n) == 0))
+	if((sscanf(optarg, "%d", &n) != 1) || (n < 1))
 	{
 	  usage = 1;
 	}
@@ -167,6 +210,11 @@ int             main(int argc, char **argv)
 	break;
     }
   }
+  if((usage == 0) && (anyFlg == 0) &&
+     ((n < 4) || (AlgBitIsPowerOfTwo(n) == 0)))
+  {
+    usage = 1;
+  }
   ok = !usage;
   /* Allocate array(s) and set values. */
   if(ok)
@@ -291,6 +339,37 @@ int             main(int argc, char **argv)
       AlgTstFourOutput(d, n, realFlg, z, 1.0,
 		       a1[0], a1[1], a2[0], a2[1], a3[0], a3[1]);
     }
+    /* For the arbitrary size transforms keep a copy of the data and
+     * compute a direct DFT of it for comparison. */
+    if(anyFlg)
+    {
+      int	i;
+
+      nV = (d == 1)? n: (d == 2)? n * n: n * n * n;
+      nA = (realFlg)? nV: 2 * nV;
+      a0 = (d == 1)? a1[0]: (d == 2)? a2[0][0]: a3[0][0][0];
+      if(((org = (double *)AlcMalloc(nA * sizeof(double))) == NULL) ||
+         ((ref = (double *)AlcCalloc(2 * nV, sizeof(double))) == NULL))
+      {
+        ok = 0;
+	(void )fprintf(stderr,
+		       "%s: Failed to allocate reference array(s).\n",
+		       *argv);
+      }
+      else
+      {
+        for(i = 0; i < nA; ++i)
+	{
+	  org[i] = ref[i] = a0[i];
+	  tol += fabs(a0[i]);
+	}
+	tol = 1.0e-9 * ((tol > 1.0)? tol: 1.0);
+	AlgTstFourDFT(ref, ref + nV, d, n);
+      }
+    }
+  }
+  if(ok)
+  {
     /* Do the forward transform. */
     if(timeFlg)
     {
@@ -300,7 +379,12 @@ int             main(int argc, char **argv)
     {
       case 1:
 	scale /= (scaleFlg)? sqrt(n): 1.0;
-        if(realFlg == 0)
+        if(anyFlg)
+	{
+	  ok = (((realFlg)? AlgFourAnyReal1D(a1[0], n, 1):
+	                    AlgFourAny1D(a1[0], a1[1], n, 1)) == ALG_ERR_NONE);
+	}
+	else if(realFlg == 0)
 	{
 	  AlgFour1D(a1[0], a1[1], n, 1);
 	}
@@ -311,7 +395,12 @@ int             main(int argc, char **argv)
 	break;
       case 2:
 	scale /= (scaleFlg)? n: 1.0;
-        if(realFlg == 0)
+        if(anyFlg)
+	{
+	  ok = (((realFlg)? AlgFourAnyReal2D(a2[0], n, n):
+	                    AlgFourAny2D(a2[0], a2[1], n, n)) == ALG_ERR_NONE);
+	}
+	else if(realFlg == 0)
 	{
 	  ok = (AlgFour2D(a2[0], a2[1], useBuf, n, n) == ALG_ERR_NONE);
 	}
@@ -322,7 +411,13 @@ int             main(int argc, char **argv)
         break;
       case 3:
 	scale /= (scaleFlg)? n * sqrt(n): 1.0;
-        if(realFlg == 0)
+        if(anyFlg)
+	{
+	  ok = (((realFlg)? AlgFourAnyReal3D(a3[0], n, n, n):
+	                    AlgFourAny3D(a3[0], a3[1], n, n, n)) ==
+		ALG_ERR_NONE);
+	}
+	else if(realFlg == 0)
 	{
 	  ok = (AlgFour3D(a3[0], a3[1], useBuf, n, n, n) == ALG_ERR_NONE);
 	}
@@ -344,6 +439,18 @@ int             main(int argc, char **argv)
 		     *argv,
 		     (1000000.0 * times[2].tv_sec) + times[2].tv_usec);
     }
+    if(ok && anyFlg)
+    {
+      int	nD;
+
+      nD = AlgTstFourCheck(n, d, realFlg, tol, 1.0, a0, ref, ref + nV,
+                           &maxErr);
+      (void )fprintf(stderr,
+                     "%s: forward transform %d differences from direct DFT,"
+		     " maximum error %g (%s)\n",
+		     *argv, nD, maxErr, (nD == 0)? "pass": "FAIL");
+      nDif += nD;
+    }
   }
   if(ok)
   {
@@ -362,7 +469,13 @@ int             main(int argc, char **argv)
     {
       case 1:
 	scale /= (scaleFlg)? sqrt(n): 1.0;
-        if(realFlg == 0)
+        if(anyFlg)
+	{
+	  ok = (((realFlg)? AlgFourAnyRealInv1D(a1[0], n, 1):
+	                    AlgFourAnyInv1D(a1[0], a1[1], n, 1)) ==
+		ALG_ERR_NONE);
+	}
+	else if(realFlg == 0)
 	{
 	  AlgFourInv1D(a1[0], a1[1], n, 1);
 	}
@@ -373,7 +486,13 @@ int             main(int argc, char **argv)
 	break;
       case 2:
 	scale /= (scaleFlg)?  n: 1.0;
-        if(realFlg == 0)
+        if(anyFlg)
+	{
+	  ok = (((realFlg)? AlgFourAnyRealInv2D(a2[0], n, n):
+	                    AlgFourAnyInv2D(a2[0], a2[1], n, n)) ==
+		ALG_ERR_NONE);
+	}
+	else if(realFlg == 0)
 	{
 	  ok = (AlgFourInv2D(a2[0], a2[1], useBuf, n, n) == ALG_ERR_NONE);
 	}
@@ -384,7 +503,13 @@ int             main(int argc, char **argv)
         break;
       case 3:
 	scale /= (scaleFlg)? n * sqrt(n): 1.0;
-        if(realFlg == 0)
+        if(anyFlg)
+	{
+	  ok = (((realFlg)? AlgFourAnyRealInv3D(a3[0], n, n, n):
+	                    AlgFourAnyInv3D(a3[0], a3[1], n, n, n)) ==
+		ALG_ERR_NONE);
+	}
+	else if(realFlg == 0)
 	{
 	  ok = (AlgFourInv3D(a3[0], a3[1], useBuf, n, n, n) == ALG_ERR_NONE);
 	}
@@ -405,6 +530,20 @@ int             main(int argc, char **argv)
 		     *argv,
 		     (1000000.0 * times[2].tv_sec) + times[2].tv_usec);
     }
+    if(ok && anyFlg)
+    {
+      int	nD;
+
+      /* The inverse transforms are not normalised, so the round trip
+       * scales the data by the number of elements. */
+      nD = AlgTstFourCheck(n, d, realFlg, tol * nV, nV, a0, org,
+                           (realFlg)? NULL: org + nV, &maxErr);
+      (void )fprintf(stderr,
+                     "%s: inverse transform %d differences from given data,"
+		     " maximum error %g (%s)\n",
+		     *argv, nD, maxErr, (nD == 0)? "pass": "FAIL");
+      nDif += nD;
+    }
   }
   if(ok)
   {
@@ -415,16 +554,23 @@ int             main(int argc, char **argv)
 		       a1[0], a1[1], a2[0], a2[1], a3[0], a3[1]);
     }
   }
+  AlcFree(org);
+  AlcFree(ref);
   AlcFree(a1[0]);
   AlcDouble2Free(a2[0]);
   AlcDouble3Free(a3[0]);
   if(usage)
   {
     (void )fprintf(stderr,
-    "Usage: %s [-h] [-c] [-r] [-u] [-y] [-N] [-R] [-T]\n"
+    "Usage: %s [-h] [-a] [-c] [-r] [-u] [-y] [-N] [-R] [-T]\n"
     "\t\t[-d #] [-n #] [-z #]\n"
     "Tests for the libAlg Fourier transform code.\n"
     "Options are:\n"
+    "  -a  Use the arbitrary size transforms, for which the size need\n"
+    "      not be a power of two and buffers are not used. The forward\n"
+    "      transform is compared with a direct DFT and the inverse with\n"
+    "      the given data, with a non zero exit status on failure\n"
+    "      (value %s).\n"
     "  -c  Complex transforms, as opposed to real (value %s).\n"
     "  -r  Real transforms, as opposed to complex (value %s).\n"
     "  -s  Rescale output (value %s).\n"
@@ -434,10 +580,12 @@ int             main(int argc, char **argv)
     "  -T  Print execution times (value %s).\n"
     "  -Y  Use slightly asymetric data values (value %s).\n"
     "  -d  Number of dimensions (value %d).\n"
-    "  -n  Size of array, must be power or two (value %d)\n"
+    "  -n  Size of array, must be power or two unless the arbitrary\n"
+    "      size transforms are used (value %d)\n"
     "  -z  Value any value less than the absolute value of this is\n"
     "      considered zero in output (value %lg)\n",
     *argv,
+    (anyFlg)? "true": "false",
     (realFlg)? "false": "true",
     (realFlg)? "true": "false",
     (scaleFlg)? "true": "false",
@@ -449,6 +597,10 @@ int             main(int argc, char **argv)
     d, n, z);
     ok = 0;
   }
+  if(nDif > 0)
+  {
+    ok = 0;
+  }
   return(!ok);
 }
 
@@ -604,3 +756,222 @@ static void	AlgTstFourOutput3(char *str, double z, double s, double ***a,
     (void )printf("\n");
   }
 }
+
+/*!
+* \ingroup	AlgTst
+* \brief	Computes the forward discrete Fourier transform of the
+* 		given contiguous complex array in place directly, one
+* 		axis at a time, with the same sign convention and
+* 		scaling as the libAlg transforms.
+* \param	re			Real parts.
+* \param	im			Imaginary parts.
+* \param	d			Array dimension.
+* \param	n			Array size.
+*/
+static void	AlgTstFourDFT(double *re, double *im, int d, int n)
+{
+  int		a,
+  		i,
+		j,
+		k,
+		nV,
+		stride = 1;
+  double	*cs,
+  		*sn,
+		*bRe,
+		*bIm;
+
+  nV = (d == 1)? n: (d == 2)? n * n: n * n * n;
+  cs = (double *)AlcMalloc(4 * n * sizeof(double));
+  sn = cs + n;
+  bRe = sn + n;
+  bIm = bRe + n;
+  for(i = 0; i < n; ++i)
+  {
+    cs[i] = cos(2.0 * ALG_M_PI * i / n);
+    sn[i] = -sin(2.0 * ALG_M_PI * i / n);
+  }
+  for(a = 0; a < d; ++a)
+  {
+    for(i = 0; i < nV; ++i)
+    {
+      if((i / stride) % n == 0)
+      {
+	for(k = 0; k < n; ++k)
+	{
+	  double sRe = 0.0,
+	  	 sIm = 0.0;
+
+	  for(j = 0; j < n; ++j)
+	  {
+	    int    l,
+	    	   t;
+
+	    l = i + j * stride;
+	    t = (j * k) % n;
+	    sRe += re[l] * cs[t] - im[l] * sn[t];
+	    sIm += re[l] * sn[t] + im[l] * cs[t];
+	  }
+	  bRe[k] = sRe;
+	  bIm[k] = sIm;
+	}
+	for(k = 0; k < n; ++k)
+	{
+	  re[i + k * stride] = bRe[k];
+	  im[i + k * stride] = bIm[k];
+	}
+      }
+    }
+    stride *= n;
+  }
+  AlcFree(cs);
+}
+
+/*!
+* \ingroup	AlgTst
+* \brief	Gets coefficient k of a real line packed as by
+* 		AlgFourAnyReal1D().
+* \param	a			First element of the line.
+* \param	stride			Offset between line elements.
+* \param	n			Number of elements in the line.
+* \param	k			Coefficient index.
+* \param	cRe			Destination for the real part.
+* \param	cIm			Destination for the imaginary part.
+*/
+static void	AlgTstFourRealLine(double *a, int stride, int n, int k,
+				   double *cRe, double *cIm)
+{
+  int		m;
+
+  m = n / 2;
+  if(k > m)
+  {
+    AlgTstFourRealLine(a, stride, n, n - k, cRe, cIm);
+    *cIm = -*cIm;
+  }
+  else
+  {
+    *cRe = a[k * stride];
+    *cIm = ((k >= 1) && (k <= (n - 1) / 2))? a[(m + k) * stride]: 0.0;
+  }
+}
+
+/*!
+* \ingroup	AlgTst
+* \brief	Gets coefficient (x, y, z), with x no greater than nX / 2,
+* 		from a contiguous array packed as by AlgFourAnyReal3D().
+* 		With nZ = 1 this is the layout of AlgFourAnyReal2D()
+* 		and with nY = nZ = 1 that of AlgFourAnyReal1D().
+* \param	a			Packed transformed data.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	nZ			Number of data in each plane.
+* \param	x			Column of the coefficient.
+* \param	y			Row of the coefficient.
+* \param	z			Plane of the coefficient.
+* \param	cRe			Destination for the real part.
+* \param	cIm			Destination for the imaginary part.
+*/
+static void	AlgTstFourRealCoef(double *a, int nX, int nY, int nZ,
+				   int x, int y, int z,
+				   double *cRe, double *cIm)
+{
+  int		mX,
+  		mY;
+
+  mX = nX / 2;
+  mY = nY / 2;
+  if((x != 0) && ((x != mX) || (nX % 2)))
+  {
+    /* Complex column. */
+    *cRe = a[(z * nY + y) * nX + x];
+    *cIm = a[(z * nY + y) * nX + mX + x];
+  }
+  else if(y > mY)
+  {
+    /* Real column, use the conjugate symmetry. */
+    AlgTstFourRealCoef(a, nX, nY, nZ, x, nY - y, (nZ - z) % nZ, cRe, cIm);
+    *cIm = -*cIm;
+  }
+  else if((y == 0) || ((y == mY) && (nY % 2 == 0)))
+  {
+    /* Real column and real row, so a real line along z. */
+    AlgTstFourRealLine(a + y * nX + x, nX * nY, nZ, z, cRe, cIm);
+  }
+  else
+  {
+    /* Real column and complex row. */
+    *cRe = a[(z * nY + y) * nX + x];
+    *cIm = a[(z * nY + mY + y) * nX + x];
+  }
+}
+
+/*!
+* \return	Number of values which differ by more than the tolerance.
+* \ingroup	AlgTst
+* \brief	Compares the given contiguous array with the given
+* 		complex values scaled by s. For packed real transformed
+* 		data only the coefficients with column no greater than
+* 		n / 2 are compared, the rest following by symmetry.
+* 		For the real data of an inverse transform the
+* 		imaginary parts should be NULL.
+* \param	n			Array size.
+* \param	d			Array dimension.
+* \param	realFlg			Real data if non zero.
+* \param	tol			Tolerance.
+* \param	s			Scale for the comparison values.
+* \param	a			Array to check, with the imaginary
+* 					parts following the real parts for
+* 					complex data.
+* \param	cRe			Real parts for comparison.
+* \param	cIm			Imaginary parts for comparison or
+* 					NULL.
+* \param	maxErr			Destination for the maximum error.
+*/
+static int	AlgTstFourCheck(int n, int d, int realFlg, double tol,
+				double s, double *a, double *cRe, double *cIm,
+				double *maxErr)
+{
+  int		i,
+  		x,
+		nV,
+		nY,
+		nZ,
+		nDif = 0;
+  double	e,
+  		vRe,
+		vIm;
+
+  *maxErr = 0.0;
+  nY = (d > 1)? n: 1;
+  nZ = (d > 2)? n: 1;
+  nV = n * nY * nZ;
+  for(i = 0; i < nV; ++i)
+  {
+    x = i % n;
+    if(realFlg && cIm)
+    {
+      if(x > n / 2)
+      {
+        continue;
+      }
+      AlgTstFourRealCoef(a, n, nY, nZ, x, (i / n) % nY, i / (n * nY),
+      			 &vRe, &vIm);
+    }
+    else
+    {
+      vRe = a[i];
+      vIm = (realFlg)? 0.0: a[nV + i];
+    }
+    e = fabs(vRe - s * cRe[i]) + fabs(vIm - ((cIm)? s * cIm[i]: 0.0));
+    if(e > *maxErr)
+    {
+      *maxErr = e;
+    }
+    if(e > tol)
+    {
+      ++nDif;
+    }
+  }
+  return(nDif);
+}
@@ -54,7 +54,7 @@ WlzBasisFnTransformObj [-o<out object>] [-p<tie points file>]
 		       [-b<basis fn transform>] [-Y<order of polynomial>]
 		       [-D<flags>] [-P<param>]
 		       [-e<displacement seed>] [-r<max displacement>]
-		       [-d] [-g] [-h] [-q] [-Q] [-s] [-t] [-y]
+		       [-d] [-g] [-h] [-q] [-Q] [-s] [-t] [-w] [-y]
 		       [-B] [-C] [-E] [-G] [-L] [-N] [-R] [-S] [-T]
 		       [-U] [<in object>]
 \endverbatim
@@ -191,6 +191,12 @@ WlzBasisFnTransformObj [-o<out object>] [-p<tie points file>]
     <td><b>-U</b></td>
     <td>Output a mesh transform instead of a transformed object.</td>
   </tr>
+  <tr> 
+    <td><b>-w</b></td>
+    <td>Use compactly supported (Wendland) basis function if tie points
+        are given, 3D only. This scales to very large numbers of tie
+	points and the parameter is the normalized support radius.</td>
+  </tr>
   <tr> 
     <td><b>-y</b></td>
     <td>Use polynomianl basis function if tie points are given.</td>
@@ -326,7 +332,7 @@ int             main(int argc, char **argv)
   struct timeval times[6];
   const int	delOut = 1;
   const char    *errMsg;
-  static char	optList[] = "b:e:m:o:p:r:t:D:M:P:Y:cdghqsyBCEGLNQRSTU",
+  static char	optList[] = "b:e:m:o:p:r:t:D:M:P:Y:cdghqswyBCEGLNQRSTU",
   		inObjFileStrDef[] = "-",
 		outObjFileStrDef[] = "-";
 
@@ -443,6 +449,9 @@ int             main(int argc, char **argv)
       case 'T':
         outBasisTrFlag = 1;
 	break;
+      case 'w':
+        basisFnType = WLZ_FN_BASIS_3DCS;
+	break;
       case 'y':
         basisFnType = WLZ_FN_BASIS_2DPOLY;
 	break;
@@ -701,6 +710,8 @@ int             main(int argc, char **argv)
         case WLZ_FN_BASIS_2DMQ:
           basisFnType = WLZ_FN_BASIS_3DMQ;
 	  break;
+        case WLZ_FN_BASIS_3DCS:
+	  break;
         default:
 	  errNum = WLZ_ERR_DOMAIN_TYPE;
 	  ok = 0;
@@ -989,7 +1000,7 @@ int             main(int argc, char **argv)
     "                  [-b<basis fn transform>] [-Y<order of polynomial>]\n"
     "                  [-D<flags>] [-P<param>]\n"
     "                  [-e<displacement seed>] [-r<max displacement>]\n"
-    "                  [-d] [-g] [-h] [-q] [-s] [-t] [-y]\n"
+    "                  [-d] [-g] [-h] [-q] [-s] [-t] [-w] [-y]\n"
     "                  [-B] [-C] [-E] [-G] [-L] [-N] [-Q] [-R] [-S] [-T]\n"
     "                  [-U] [<in object>]\n"
     "Version: ",
@@ -1040,6 +1051,9 @@ int             main(int argc, char **argv)
     "  -T  Output a basis function transform instead of a transformed\n"
     "      object.\n"
     "  -U  Output a mesh transform instead of a transformed object.\n"
+    "  -w  Use compactly supported (Wendland) basis function if tie points\n"
+    "      are given, 3D only. This scales to very large numbers of tie\n"
+    "      points and the parameter is the normalized support radius.\n"
     "  -y  Use polynomial basis function if tie points are given.\n"
     "  -Y  Polynomial order for polynomial basis function (default 3).\n"
     "Computes and applies Woolz basis function transforms.\n"
@@ -49,14 +49,21 @@ static char _WlzBasisFnTransformVertices_c[] = "University of Edinburgh $Id$";
 WlzBasisFnTransformVertices  -  applies a basis function to vertices.
 \par Synopsis
 \verbatim
-WlzBasisFnTransformVertices [-o<out object>] [-p<tie points file>]
-                            [-m<min mesh dist>] [-M<max mesh dist>]
+WlzBasisFnTransformVertices [-e<tolerance>] [-o<out object>]
+                            [-p<tie points file>] [-m<min mesh dist>]
+                            [-M<max mesh dist>]
 			    [-t<basis fn transform>] [-Y<order of polynomial>]
 			    [-g] [-h] [-q] [-Q] [-s] [-y] [-B] [-D] [-G]
 			    [-L] [-T] [<in object>]
 \endverbatim
 \par Options
 <table width="500" border="0">
+  <tr> 
+    <td><b>-e</b></td>
+    <td>Approximate the transform to within the given displacement
+        tolerance, which may be much faster for many vertices
+        (default 0, exact).</td>
+  </tr>
   <tr> 
     <td><b>-o</b></td>
     <td>Output vertices file name.</td>
@@ -162,9 +169,8 @@ int             main(int argc, char **argv)
 		*vxVec0  = NULL,
 		*vxVec1  = NULL,
 		*vertVec = NULL,
-		*vertVecTr = NULL,
-		srcV,
-		transV;
+		*vertVecTr = NULL;
+  double	tol = 0.0;
   WlzMeshTransform *meshTr = NULL;
   WlzBasisFnTransform *basisTr = NULL;
   WlzFnType basisFnType = WLZ_FN_BASIS_2DMQ;
@@ -176,7 +182,7 @@ int             main(int argc, char **argv)
 		*vertptFileStr = NULL,
   		*outVerticesFileStr;
   const char    *errMsg;
-  static char	optList[] = "o:p:v:t:Y:cghqsy",
+  static char	optList[] = "e:o:p:v:t:Y:cghqsy",
   		inObjFileStrDef[] = "-",
 		outVerticesFileStrDef[] = "-",
   		inRecord[IN_RECORD_MAX];
@@ -188,6 +194,13 @@ int             main(int argc, char **argv)
   {
     switch(option)
     {
+      case 'e':
+        if(sscanf(optarg, "%lg", &tol) != 1)
+	{
+	  usage = 1;
+	  ok = 0;
+	}
+	break;
       case 'o':
         outVerticesFileStr = optarg;
 	break;
@@ -423,34 +436,19 @@ int             main(int argc, char **argv)
   if(ok)
   {
     /* Transform the vertices and then write it out. */
-    while(ic < nVertP)
+    errNum = WlzBasisFnTransformVertexBatchD(basisTr, nVertP,
+    					     vertVec, vertVecTr, tol);
+    if(errNum != WLZ_ERR_NONE)
     {
-	if(errNum == WLZ_ERR_NONE)
-	{
-          srcV.vtX  = (vertVec + ic )->vtX;
-	  srcV.vtY  = (vertVec + ic )->vtY;
-	  
-	  transV = WlzBasisFnTransformVertexD( basisTr,
-				 	   srcV,
-					   &errNum);
-	  (vertVecTr + ic )->vtX = transV.vtX;
-	  (vertVecTr + ic )->vtY = transV.vtY;
-
-	  if(errNum != WLZ_ERR_NONE)
-	  {
-	    ok = 0;
-	    (void )WlzStringFromErrorNum(errNum, &errMsg);
-	    (void )fprintf(stderr,
-			   "%s: failed to transfer the vertices  (%s).\n",
-			   *argv, errMsg);
-	  }
-	  /*
-	  vertVecTr++;
-	  vertVec++;
-	  */
-	}
-	ic++;
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+		     "%s: failed to transfer the vertices  (%s).\n",
+		     *argv, errMsg);
     }
+  }
+  if(ok)
+  {
     /* output the transformed vertices */
     if(( fP = fopen(outVerticesFileStr, "w")) == NULL )
     {
@@ -482,7 +480,7 @@ int             main(int argc, char **argv)
     (void )fprintf(stderr,
     "Usage: %s%s%s%sExample: %s%s",
     *argv,
-    " [-o<out object>] [-p<tie points file>]\n"
+    " [-e<tolerance>] [-o<out object>] [-p<tie points file>]\n"
     "                  [-m<min mesh dist>] [-M<max mesh dist>]\n"
     "                  [-t<basis fn transform>] [-Y<order of polynomial>]\n"
     "                  [-g] [-h] [-q] [-Q] [-s] [-y] [-B] [-D] [-G] [-L]\n"
@@ -491,6 +489,9 @@ int             main(int argc, char **argv)
     WlzVersion(),
     "\n"
     "Options:\n"
+    "  -e  Approximate the transform to within the given displacement\n"
+    "      tolerance, which may be much faster for many vertices\n"
+    "      (default 0, exact).\n"
     "  -o  Output vertices file name.\n"
     "  -p  Tie point file.\n"
     "  -v  vertices file.\n"
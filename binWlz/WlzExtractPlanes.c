@@ -0,0 +1,259 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzExtractPlanes_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlz/WlzExtractPlanes.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2012],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Extracts a range of planes from a 3D domain object,
+* 		reading only the planes required when the object was
+* 		written with a plane index.
+* \ingroup	BinWlz
+*
+* \par Binary
+* \ref wlzextractplanes "WlzExtractPlanes"
+*/
+
+/*!
+\ingroup BinWlz
+\defgroup wlzextractplanes WlzExtractPlanes
+\par Name
+WlzExtractPlanes - extracts a range of planes from a 3D domain object.
+\par Synopsis
+\verbatim
+WlzExtractPlanes [-h] [-i] [-o<output object>] [-p<first>,<last>]
+                 [<input object>]
+\endverbatim
+\par Options
+<table width="500" border="0">
+  <tr>
+    <td><b>-h</b></td>
+    <td>Help, prints usage message.</td>
+  </tr>
+  <tr>
+    <td><b>-i</b></td>
+    <td>Write the output object with a plane index.</td>
+  </tr>
+  <tr>
+    <td><b>-o</b></td>
+    <td>Output object file.</td>
+  </tr>
+  <tr>
+    <td><b>-p</b></td>
+    <td>First and last planes of the range, either may be omitted
+        in which case the range is unbounded at that end.</td>
+  </tr>
+</table>
+\par Description
+Reads the planes of a 3D domain object which are within the given range
+and writes them out as a new 3D domain object. If the input object was
+written with a plane index (eg using the -i option or with the
+environment variable WLZ_PLANE_INDEX set) and is read from a file
+rather than a pipe, then only the planes within the range are read.
+Otherwise the whole object is read and the planes are then selected.
+If the range does not intersect the planes of the object then an empty
+object is written.
+All files are read from the standard input and written to the standard
+output unless filenames are given.
+\par Example
+\verbatim
+WlzExtractPlanes -p 100,109 -o out.wlz in.wlz
+\endverbatim
+The ten planes 100 to 109 of the 3D object read from the file in.wlz
+are written to the file out.wlz.
+\par File
+\ref WlzExtractPlanes.c "WlzExtractPlanes.c"
+\par See Also
+\ref BinWlz "WlzIntro(1)"
+\ref wlzexplode "WlzExplode(1)"
+\ref WlzReadObjPlanes "WlzReadObjPlanes(3)"
+*/
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <Wlz.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+extern char     *optarg;
+extern int      optind,
+		opterr,
+		optopt;
+
+int             main(int argc, char **argv)
+{
+  int		option,
+		plane1 = INT_MIN,
+		lastpl = INT_MAX,
+  		ok = 1,
+		usage = 0;
+  WlzObject     *obj = NULL;
+  FILE		*fP = NULL;
+  char 		*inObjFileStr,
+  		*outObjFileStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsg;
+  static char	optList[] = "hio:p:",
+  		fileStrDef[] = "-";
+
+  opterr = 0;
+  inObjFileStr = fileStrDef;
+  outObjFileStr = fileStrDef;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != -1))
+  {
+    switch(option)
+    {
+      case 'i':
+        WlzWriteObjSetPlaneIndex(1);
+	break;
+      case 'o':
+        outObjFileStr = optarg;
+	break;
+      case 'p':
+	{
+	  char	*sep;
+
+	  /* Either bound of the range may be omitted. */
+	  if((sep = strchr(optarg, ',')) == NULL)
+	  {
+	    usage = 1;
+	  }
+	  else
+	  {
+	    if((optarg != sep) && (sscanf(optarg, "%d", &plane1) != 1))
+	    {
+	      usage = 1;
+	    }
+	    if((*(sep + 1) != '\0') && (sscanf(sep + 1, "%d", &lastpl) != 1))
+	    {
+	      usage = 1;
+	    }
+	  }
+	}
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind < argc))
+  {
+    if((optind + 1) != argc)
+    {
+      usage = 1;
+    }
+    else
+    {
+      inObjFileStr = *(argv + optind);
+    }
+  }
+  if((usage == 0) && (plane1 > lastpl))
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    errNum = WLZ_ERR_READ_EOF;
+    if(((fP = (strcmp(inObjFileStr, "-")?
+              fopen(inObjFileStr, "r"): stdin)) == NULL) ||
+       ((obj = WlzAssignObject(WlzReadObjPlanes(fP, plane1, lastpl,
+                                                &errNum), NULL)) == NULL) ||
+       (errNum != WLZ_ERR_NONE))
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+                     "%s: Failed to read planes of object from file %s (%s).\n",
+		     *argv, inObjFileStr, errMsg);
+    }
+    if(fP && strcmp(inObjFileStr, "-"))
+    {
+      (void )fclose(fP);
+      fP = NULL;
+    }
+  }
+  if(ok)
+  {
+    errNum = WLZ_ERR_WRITE_EOF;
+    if(((fP = (strcmp(outObjFileStr, "-")?
+              fopen(outObjFileStr, "w"): stdout)) == NULL) ||
+       ((errNum = WlzWriteObj(fP, obj)) != WLZ_ERR_NONE))
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+                     "%s: Failed to write output object (%s).\n",
+		     *argv, errMsg);
+    }
+    if(fP && strcmp(outObjFileStr, "-"))
+    {
+      (void )fclose(fP);
+    }
+  }
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s%s%s%sExample: %s%s",
+    *argv,
+    " [-h] [-i] [-o<output object>] [-p<first>,<last>]\n"
+    "       [<input object>]\n"
+    "Version: ",
+    WlzVersion(),
+    "\n"
+    "Options:\n"
+    "  -h  Help, prints usage message.\n"
+    "  -i  Write the output object with a plane index.\n"
+    "  -o  Output object file.\n"
+    "  -p  First and last planes of the range, either may be omitted\n"
+    "      in which case the range is unbounded at that end.\n"
+    "Reads the planes of a 3D domain object which are within the given\n"
+    "range and writes them out as a new 3D domain object. If the input\n"
+    "object was written with a plane index and is read from a file rather\n"
+    "than a pipe, then only the planes within the range are read.\n"
+    "If the range does not intersect the planes of the object then an\n"
+    "empty object is written.\n"
+    "All files are read from the standard input and written to the standard\n"
+    "output unless filenames are given.\n",
+    *argv,
+    " -p 100,109 -o out.wlz in.wlz\n"
+    "The ten planes 100 to 109 of the 3D object read from the file in.wlz\n"
+    "are written to the file out.wlz.\n");
+  }
+  return(!ok);
+}
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
@@ -52,7 +52,7 @@ WlzRegisterICP - registers two objects using an iterative closest point
 \par Synopsis
 \verbatim
 WlzRegisterICP [-h] [-o<out obj>]
-               [-E #] [-I] [-M #] [-N] [-i <init tr>] [-t] [-r]
+               [-E #] [-I] [-L #] [-M #] [-N] [-i <init tr>] [-t] [-r]
 	       [<in obj 0>] [<in obj 1>]
 \endverbatim
 \par Options
@@ -69,6 +69,13 @@ WlzRegisterICP [-h] [-o<out obj>]
     <td><b>-I</b></td>
     <td>Maximum number of iterations.</td>
   </tr>
+  <tr> 
+    <td><b>-L</b></td>
+    <td>Number of resolution levels for coarse to fine registration,
+        with the source vertices subsampled by a factor of four at
+	each coarser level. Not used with maximal gradient contours.
+	Default 1.</td>
+  </tr>
   <tr> 
     <td><b>-N</b></td>
     <td>Don't weight using normals.</td>
@@ -123,6 +130,7 @@ sense). The affine transform is then written to out-tr.wlz.
 \ref BinWlz "WlzIntro(1)"
 \ref wlzregisterccor "WlzRegisterCCor(1)"
 \ref WlzRegICPObjs "WlzRegICPObjs(3)"
+\ref WlzRegICPObjsMR "WlzRegICPObjsMR(3)"
 \ref WlzRegICPObjsGrd "WlzRegICPObjsGrd(3)"
 */
 
@@ -146,6 +154,7 @@ int             main(int argc, char **argv)
   int		idx,
 		grdFlg = 0,
 		maxItr = INT_MAX,
+		nLvl = 1,
 		noNorm = 0,
 		option,
 		ok = 1,
@@ -164,7 +173,7 @@ int             main(int argc, char **argv)
   		*outObjFileStr;
   char  	*inObjFileStr[2];
   const char	*errMsg;
-  static char	optList[] = "i:o:E:M:gINhart",
+  static char	optList[] = "i:o:E:L:M:gINhart",
 		outObjFileStrDef[] = "-",
   		inObjFileStrDef[] = "-";
 
@@ -194,6 +203,13 @@ int             main(int argc, char **argv)
 	  ok = 0;
 	}
 	break;
+      case 'L':
+        if((sscanf(optarg, "%d", &nLvl) != 1) || (nLvl < 1))
+	{
+	  usage = 1;
+	  ok = 0;
+	}
+	break;
       case 'M':
         if((sscanf(optarg, "%lg", &minDistWgt) != 1) ||
 	   (minDistWgt < 0.0) || (minDistWgt > 1.0))
@@ -398,10 +414,10 @@ int             main(int argc, char **argv)
     }
     else
     {
-      outDom.t = WlzRegICPObjs(inObj[0], inObj[1],
-			       inTrObj? inTrObj->domain.t: NULL, trType,
-			       NULL, NULL, maxItr,  noNorm,
-			       delta, minDistWgt, &errNum);
+      outDom.t = WlzRegICPObjsMR(inObj[0], inObj[1],
+			         inTrObj? inTrObj->domain.t: NULL, trType,
+			         NULL, NULL, maxItr,  noNorm,
+			         delta, minDistWgt, nLvl, &errNum);
     }
     if(errNum != WLZ_ERR_NONE)
     {
@@ -465,13 +481,17 @@ int             main(int argc, char **argv)
     "Usage: %s%s%s%sExample: %s%s",
     *argv,
     " [-h] [-o<out obj>]\n"
-    "\t\t[-E #] [-I] [-M #] [-N] [-i <init tr>] [-t] [-r]\n"
+    "\t\t[-E #] [-I] [-L #] [-M #] [-N] [-i <init tr>] [-t] [-r]\n"
     "\t\t[<in obj 0>] [<in obj 1>]\n"
     "Version: ",
     WlzVersion(),
     "\n"
     "Options:\n"
     "  -I  Maximum number of iterations.\n"
+    "  -L  Number of resolution levels for coarse to fine registration,\n"
+    "      with the source vertices subsampled by a factor of four at\n"
+    "      each coarser level. Not used with maximal gradient contours.\n"
+    "      Default 1.\n"
     "  -M  Minimum distance weight, range [0.0-1.0]: Useful values are\n"
     "      0.25 (default) for global matching and 0.0 for local matching.\n"
     "  -N  Don't weight using normals.\n"
@@ -52,7 +52,7 @@ WlzSepFilterObj - seperable spatial convolution filter for domain objects
 \par Synopsis
 \verbatim
 WlzSepFilterObj - [-h] [-v] [-o<output object>] [-m#,#,#] [-n#,#,#]
-                  [-g <t>] [-t <flags>] [-P <p>] [-p#] [-G] [-S a|c|s]
+                  [-g <t>] [-t <flags>] [-P <p>] [-p#] [-f] [-G] [-S a|c|s]
 		  [<input object>]
 \endverbatim
 \par Options
@@ -102,6 +102,11 @@ WlzSepFilterObj - [-h] [-v] [-o<output object>] [-m#,#,#] [-n#,#,#]
     <td><b>-p</b></td>
     <td>Used to supply given padding value, default 0.0.</td>
   </tr>
+  <tr>
+    <td><b>-f</b></td>
+    <td>Allow a faster single precision filter to be used, which for
+        some objects may change integer values by one.</td>
+  </tr>
   <tr> 
     <td><b>-G</b></td>
     <td>Use Gaussian filter, default.</td>
@@ -156,6 +161,7 @@ int             main(int argc, char **argv)
   int		option,
 		ok = 1,
 		sep = 0,
+		fast = 0,
 		usage = 0,
 		verbose = 0;
   double	padVal = 0.0;
@@ -171,7 +177,7 @@ int             main(int argc, char **argv)
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   char 		*outFileStr,
   		*inObjFileStr;
-  static char	optList[] = "Ghvg:o:m:n:P:p:t:S:",
+  static char	optList[] = "fGhvg:o:m:n:P:p:t:S:",
 		defFile[] = "-";
 
   opterr = 0;
@@ -190,6 +196,9 @@ int             main(int argc, char **argv)
       case 'v':
         verbose = 1;
 	break;
+      case 'f':
+        fast = 1;
+	break;
       case 'g':
         switch(*optarg)
 	{
@@ -401,6 +410,9 @@ int             main(int argc, char **argv)
       gettimeofday(times + 0, NULL);
     }
     outObj = WlzAssignObject(
+	     (fast)?
+	     WlzGaussFilterFast(inObj, param[0], order, action, gType,
+	     		        pad, padVal, sep, &errNum):
 	     WlzGaussFilter(inObj, param[0], order, action, gType,
 	     		    pad, padVal, sep, &errNum),
 	     NULL);
@@ -456,7 +468,7 @@ int             main(int argc, char **argv)
     "Usage: %s%s%s%sExample: %s%s",
     *argv,
     " [-h] [-o<output object>] [-m#,#,#] [-n#,#,#]\n"
-    "\t[-g <t>] [-t <flags>] [-P <p>] [-p#] [-G]\n"
+    "\t[-g <t>] [-t <flags>] [-P <p>] [-p#] [-f] [-G]\n"
     "\t[-S a|c|s] [-v] [<input object>]\n"
     "Version: ",
     WlzVersion(),
@@ -477,6 +489,8 @@ int             main(int argc, char **argv)
     "      with 'b', 'e', 'v' and 'z' used to select background, end, given\n"
     "      value and zero padding.\n"
     "  -p  Used to supply given padding value, default 0.0.\n"
+    "  -f  Allow a faster single precision filter to be used, which for\n"
+    "      some objects may change integer values by one.\n"
     "  -G  Use a Gaussain filter (default).\n"
     "  -S  Use the input object for each of the directional filters rather\n"
     "      than the output of the previous directional filter. The seperate\n"
@@ -52,6 +52,7 @@ Wlz3DGetSection - gets an arbitrary slice from a 3D object.
 Wlz3DGetSection  [-h] [-A] [-C] [-L] [-N]
                  [-a <pitch,yaw[,roll]>] [-f <fx,fy,fz>]
                  [-d <dist>] [-b <parameter bibfile>] [-m <mode>]
+		 [-P <page cache size>]
 		 [-r <vox scaling>] [-s <scale>] [-o <output file>]
 		 [-t<view transform>] [-u<ux,uy,uz>] [<3D object input file>]
 \endverbatim
@@ -111,6 +112,14 @@ Wlz3DGetSection  [-h] [-A] [-C] [-L] [-N]
     </table>
     </td>
   </tr>
+  <tr> 
+    <td><b>-P</b></td>
+    <td>Page the tiles of a tiled value input object on demand into
+        a cache of the given size (Mb), rather than either reading
+	or memory mapping all of the tiles. This allows sections
+	to be cut from very large tiled objects using little memory.
+	The input object must be read from a file.</td>
+  </tr>
   <tr> 
     <td><b>-r</b></td>
     <td>Voxel size rescaling mode flags:
@@ -173,7 +182,8 @@ static void usage(char *proc_str)
 	  "Usage:\t%s [-a <pitch,yaw[,roll]>] [-f <fx,fy,fz>] [-d <dist>]\n"
 	  "\t[-b <parameter bibfile>] [-m <mode>] [-s <scale>]\n"
 	  "\t[-o <output file>] [-u<ux,uy,uz>] [-A] [-C] [-L] [-N]\n"
-	  "\t[-r<vox scaling>] [-R <ROI domain>] [<3D object input file>]\n"
+	  "\t[-r<vox scaling>] [-R <ROI domain>] [-P <page cache size>]\n"
+	  "\t[<3D object input file>]\n"
 	  "\tGet an arbitrary slice from a 3D object\n"
 	  "\twriting the 2D object to standard output\n"
 	  "Version: %s\n"
@@ -195,6 +205,10 @@ static void usage(char *proc_str)
 	  "\t                       mode = 1 - statue\n"
 	  "\t                       mode = 2 - absolute\n"
 	  "\t  -o<output file>    Output filename, default to stdout\n"
+	  "\t  -P<cache size>     Page the tiles of a tiled value input object\n"
+	  "\t                     on demand into a cache of the given size (Mb)\n"
+	  "\t                     rather than reading or mapping all the tiles,\n"
+	  "\t                     the input object must be read from a file.\n"
 	  "\t  -r<vox rescale>    Voxel size rescaling mode flags:\n"
 	  "\t                       bit 1 set - use voxel-size rescaling\n"
 	  "\t                       bit 2 set - enable global scaling\n"
@@ -225,7 +239,7 @@ int main(int	argc,
   WlzObject	*obj = NULL, *nobj = NULL, *subDomain = NULL;
   FILE		*inFP = NULL, *outFP = NULL, *trFP = NULL, *bibFP = NULL;
   char		*outFile = NULL, *trFile = NULL, *bibFile = NULL;
-  char 		optList[] = "ACLNTa:b:d:f:m:o:r:s:t:u:R:h";
+  char 		optList[] = "ACLNTa:b:d:f:m:o:r:s:t:u:P:R:h";
   int		option;
   int		i,
   		j,
@@ -235,6 +249,7 @@ int main(int	argc,
   		allFlg = 0;
   double	dist=0.0, pitch=0.0, yaw=0.0, roll=0.0;
   double	scale=1.0;
+  double	pageCacheSz;
   WlzDVertex3	fixed={0.0,0.0,0.0};
   WlzDVertex3	up={0.0,0.0,-1.0};
   WlzThreeDViewStruct	*viewStr=NULL;
@@ -332,6 +347,14 @@ int main(int	argc,
       outFile = optarg;
       break;
 
+    case 'P':
+      if((sscanf(optarg, "%lg", &pageCacheSz) < 1) || (pageCacheSz < 0.0)){
+	usage(argv[0]);
+	return 1;
+      }
+      WlzTiledValuesSetPageCacheSz((size_t )(pageCacheSz * 1024.0 * 1024.0));
+      break;
+
     case 'r':
       if( sscanf(optarg, "%d", &voxRescale) < 1 ){
 	usage(argv[0]);
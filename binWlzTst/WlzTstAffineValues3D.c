@@ -0,0 +1,308 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstAffineValues3D_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstAffineValues3D.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the transformed values of 3D affine transforms
+* 		which compares the values found by WlzAffineTransformObj()
+* 		for nearest neighbour and linear interpolation with those
+* 		found here by computing the source position of each voxel
+* 		in turn from the inverse transform.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static short			WlzTstAffineValues3DRef(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzAffineTransform *invTr,
+				  WlzInterpolationType interp,
+				  WlzIVertex3 pos);
+static WlzErrorNum		WlzTstAffineValues3D(
+				  WlzObject *obj,
+				  WlzAffineTransform *tr,
+				  WlzInterpolationType interp,
+				  long *dstNBad,
+				  long *dstNVx);
+
+int		main(int argc, char *argv[])
+{
+  int		idI,
+  		option,
+		sz = 64,
+  		ok = 1,
+  		usage = 0;
+  long		nBad = 0;
+  const char	*errMsgStr;
+  WlzObject	*obj = NULL;
+  WlzAffineTransform *tr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hs:";
+  const WlzInterpolationType interp[2] = {WLZ_INTERPOLATION_NEAREST,
+  					  WLZ_INTERPOLATION_LINEAR};
+  const char	*interpStr[2] = {"nearest", "linear"};
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 2);
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    WlzPixelV	bgd;
+
+    /* Make a cuboid object with random values. */
+    bgd.type = WLZ_GREY_SHORT;
+    bgd.v.shv = 0;
+    obj = WlzAssignObject(
+    	  WlzMakeCuboid(0, sz - 1, 0, sz - 1, 0, sz - 1, WLZ_GREY_SHORT,
+	                bgd, NULL, NULL, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzIterateWSpace *itWSp;
+
+      AlgRandSeed(0);
+      itWSp = WlzIterateInit(obj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+	{
+	  *(itWSp->gP.shp) = (short )(1000.0 * AlgRandUniform());
+	}
+	if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+      }
+      WlzIterateWSpFree(itWSp);
+    }
+    /* A rotation, scale and translation which is unlikely to map voxel
+     * positions onto exact integer or half integer source positions. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      tr = WlzMakeAffineTransform(WLZ_TRANSFORM_3D_AFFINE, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	idR,
+      		idC;
+      const double mat[3][4] = {{ 1.07, -0.33,  0.12,  3.37},
+      				{ 0.35,  1.05, -0.21, -2.19},
+				{-0.09,  0.23,  1.11,  1.71}};
+
+      for(idR = 0; idR < 3; ++idR)
+      {
+        for(idC = 0; idC < 4; ++idC)
+	{
+	  tr->mat[idR][idC] = mat[idR][idC];
+	}
+      }
+    }
+  }
+  for(idI = 0; ok && (errNum == WLZ_ERR_NONE) && (idI < 2); ++idI)
+  {
+    long	nB = 0,
+    		nVx = 0;
+
+    errNum = WlzTstAffineValues3D(obj, tr, interp[idI], &nB, &nVx);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nBad += nB;
+      (void )printf("%s: %s interpolation %ld differences in %ld voxels\n",
+                    argv[0], interpStr[idI], nB, nVx);
+    }
+  }
+  (void )WlzFreeAffineTransform(tr);
+  (void )WlzFreeObj(obj);
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to transform object (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %s\n", argv[0], (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-s#]\n"
+    "Tests the values of 3D affine transformed objects by comparing the\n"
+    "values found by WlzAffineTransformObj() using nearest neighbour and\n"
+    "linear interpolation with those found by computing the source position\n"
+    "of each voxel in turn from the inverse transform.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -s  Size of the random valued cuboid object (default %d).\n",
+    argv[0], 64);
+  }
+  return(!ok);
+}
+
+/* Computes the value of the transformed object at the given position
+ * from the source object's values, using the same expression for the
+ * source position as the transform. */
+static short	WlzTstAffineValues3DRef(WlzGreyValueWSpace *gVWSp,
+					WlzAffineTransform *invTr,
+					WlzInterpolationType interp,
+					WlzIVertex3 pos)
+{
+  int		idx;
+  double	v = 0.0;
+  double	s[3],
+  		t0[3];
+  double	**m;
+
+  m = invTr->mat;
+  for(idx = 0; idx < 3; ++idx)
+  {
+    s[idx] = ((m[idx][3] + (m[idx][2] * pos.vtZ)) + (m[idx][1] * pos.vtY)) +
+             (m[idx][0] * pos.vtX);
+  }
+  if(interp == WLZ_INTERPOLATION_NEAREST)
+  {
+    WlzGreyValueGet(gVWSp, (double )(int )(s[2]), (double )(int )(s[1]),
+                    (double )(int )(s[0]));
+    v = gVWSp->gVal[0].shv;
+  }
+  else
+  {
+    double	t1[3];
+
+    WlzGreyValueGetCon(gVWSp, s[2], s[1], s[0]);
+    for(idx = 0; idx < 3; ++idx)
+    {
+      t0[idx] = s[idx] - WLZ_NINT(s[idx] - 0.5);
+      t1[idx] = 1.0 - t0[idx];
+    }
+    v = (gVWSp->gVal[0].shv * t1[0] * t1[1] * t1[2]) +
+        (gVWSp->gVal[1].shv * t0[0] * t1[1] * t1[2]) +
+        (gVWSp->gVal[2].shv * t1[0] * t0[1] * t1[2]) +
+        (gVWSp->gVal[3].shv * t0[0] * t0[1] * t1[2]) +
+        (gVWSp->gVal[4].shv * t1[0] * t1[1] * t0[2]) +
+        (gVWSp->gVal[5].shv * t0[0] * t1[1] * t0[2]) +
+        (gVWSp->gVal[6].shv * t1[0] * t0[1] * t0[2]) +
+        (gVWSp->gVal[7].shv * t0[0] * t0[1] * t0[2]);
+    v = WLZ_CLAMP(v, (double )(SHRT_MIN), (double )(SHRT_MAX));
+    v = WLZ_NINT(v);
+  }
+  return((short )v);
+}
+
+/* Transforms the given object and counts the voxels of the transformed
+ * object which differ from the reference values. */
+static WlzErrorNum WlzTstAffineValues3D(WlzObject *obj,
+				        WlzAffineTransform *tr,
+				        WlzInterpolationType interp,
+				        long *dstNBad,
+				        long *dstNVx)
+{
+  long		nBad = 0,
+  		nVx = 0;
+  WlzObject	*tObj = NULL;
+  WlzAffineTransform *invTr = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzIterateWSpace *itWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tObj = WlzAssignObject(
+         WlzAffineTransformObj(obj, tr, interp, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    invTr = WlzAffineTransformInverse(tr, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    itWSp = WlzIterateInit(tObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+    {
+      if(*(itWSp->gP.shp) !=
+         WlzTstAffineValues3DRef(gVWSp, invTr, interp, itWSp->pos))
+      {
+        ++nBad;
+      }
+      ++nVx;
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  WlzIterateWSpFree(itWSp);
+  WlzGreyValueFreeWSp(gVWSp);
+  (void )WlzFreeAffineTransform(invTr);
+  (void )WlzFreeObj(tObj);
+  *dstNBad = nBad;
+  *dstNVx = nVx;
+  return(errNum);
+}
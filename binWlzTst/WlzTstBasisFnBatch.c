@@ -0,0 +1,360 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstBasisFnBatch_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstBasisFnBatch.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for batched basis function evaluation which compares
+* 		the displacements found by WlzBasisFnValueBatch2D() and
+* 		WlzBasisFnValueBatch3D() with those found by evaluating
+* 		the basis function at each position in turn. Exact batched
+* 		evaluation (a tolerance of zero, which is the default for
+* 		the existing transform functions) must give identical
+* 		displacements, while approximate evaluation must have a
+* 		maximum error over all positions no greater than the
+* 		tolerance. The times taken are reported but not checked.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstBasisFnBatchTime(void);
+static WlzErrorNum		WlzTstBasisFnBatch(
+				  WlzFnType fnType,
+				  int nLmk,
+				  int nPos,
+				  double tol,
+				  int *dstExactSame,
+				  double *dstMaxErr,
+				  double *dstT);
+
+int		main(int argc, char *argv[])
+{
+  int		idF,
+  		option,
+		nLmk = 500,
+		nPos = 100000,
+		nBad = 0,
+  		ok = 1,
+  		usage = 0;
+  double	tol = WLZ_BASISFN_EVAL_TOL;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hl:n:t:";
+  const WlzFnType fnTypes[5] = {WLZ_FN_BASIS_2DTPS, WLZ_FN_BASIS_2DIMQ,
+  				WLZ_FN_BASIS_2DMQ, WLZ_FN_BASIS_3DIMQ,
+				WLZ_FN_BASIS_3DMQ};
+  const char	*fnStr[5] = {"2D TPS", "2D IMQ", "2D MQ", "3D IMQ", "3D MQ"};
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'l':
+        usage = (sscanf(optarg, "%d", &nLmk) != 1) || (nLmk < 4);
+	break;
+      case 'n':
+        usage = (sscanf(optarg, "%d", &nPos) != 1) || (nPos < 1);
+	break;
+      case 't':
+        usage = (sscanf(optarg, "%lg", &tol) != 1) || (tol <= 0.0);
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  for(idF = 0; ok && (errNum == WLZ_ERR_NONE) && (idF < 5); ++idF)
+  {
+    int		same = 0;
+    double	maxErr = 0.0;
+    double	t[3] = {0.0};
+
+    errNum = WlzTstBasisFnBatch(fnTypes[idF], nLmk, nPos, tol,
+    				&same, &maxErr, t);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nBad += !same + (maxErr > tol);
+      (void )printf("%s: %s exact %gs, batched exact %gs (%s), "
+                    "approximate %gs maximum error %g\n",
+		    argv[0], fnStr[idF], t[0], t[1],
+		    (same)? "identical": "DIFFERENT", t[2], maxErr);
+    }
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to evaluate basis functions (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d differences in exact evaluation or errors "
+                    "above tolerance (%s)\n",
+                    argv[0], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-l#] [-n#] [-t#]\n"
+    "Tests batched basis function evaluation by comparing the displacements\n"
+    "found for many positions with those found for each position in turn.\n"
+    "Batched exact evaluation must give identical displacements and the\n"
+    "maximum error of approximate evaluation over all the positions must be\n"
+    "no greater than the tolerance. The times taken are reported.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -l  Number of landmarks (default %d).\n"
+    "  -n  Number of positions (default %d).\n"
+    "  -t  Tolerance for approximate evaluation (default %g).\n",
+    argv[0], 500, 100000, WLZ_BASISFN_EVAL_TOL);
+  }
+  return(!ok);
+}
+
+static double	WlzTstBasisFnBatchTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
+
+/* Computes a basis function of the given type from random landmarks
+ * with smooth displacements, then evaluates it at random positions
+ * over the landmarks' extent: in turn, batched with a tolerance of zero
+ * and batched with the given tolerance. Sets the exact same flag if the
+ * first two are identical, the maximum error of the approximation and
+ * the three times taken. */
+static WlzErrorNum WlzTstBasisFnBatch(WlzFnType fnType, int nLmk, int nPos,
+				      double tol, int *dstExactSame,
+				      double *dstMaxErr, double *dstT)
+{
+  int		idP,
+  		dim;
+  double	t0,
+  		maxErr = 0.0;
+  const double	ext = 500.0;
+  WlzVertexP	dPts,
+  		sPts,
+		pos,
+		dsp[3];
+  WlzBasisFnTransform *basisTr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dim = ((fnType == WLZ_FN_BASIS_3DIMQ) ||
+         (fnType == WLZ_FN_BASIS_3DMQ))? 3: 2;
+  dPts.v = sPts.v = pos.v = NULL;
+  dsp[0].v = dsp[1].v = dsp[2].v = NULL;
+  if(((dPts.d3 = (WlzDVertex3 *)
+                 AlcMalloc(sizeof(WlzDVertex3) * nLmk)) == NULL) ||
+     ((sPts.d3 = (WlzDVertex3 *)
+                 AlcMalloc(sizeof(WlzDVertex3) * nLmk)) == NULL) ||
+     ((pos.d3 = (WlzDVertex3 *)
+                AlcMalloc(sizeof(WlzDVertex3) * nPos)) == NULL) ||
+     ((dsp[0].d3 = (WlzDVertex3 *)
+                   AlcMalloc(sizeof(WlzDVertex3) * nPos)) == NULL) ||
+     ((dsp[1].d3 = (WlzDVertex3 *)
+                   AlcMalloc(sizeof(WlzDVertex3) * nPos)) == NULL) ||
+     ((dsp[2].d3 = (WlzDVertex3 *)
+                   AlcMalloc(sizeof(WlzDVertex3) * nPos)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idL;
+
+    AlgRandSeed(0);
+    for(idL = 0; idL < nLmk; ++idL)
+    {
+      WlzDVertex3 s,
+      		d;
+
+      s.vtX = ext * AlgRandUniform();
+      s.vtY = ext * AlgRandUniform();
+      s.vtZ = ext * AlgRandUniform();
+      d.vtX = s.vtX + 10.0 * sin(s.vtY / 80.0);
+      d.vtY = s.vtY + 10.0 * cos(s.vtX / 70.0);
+      d.vtZ = s.vtZ + 10.0 * sin((s.vtX + s.vtY) / 90.0);
+      if(dim == 2)
+      {
+        sPts.d2[idL].vtX = s.vtX;
+        sPts.d2[idL].vtY = s.vtY;
+        dPts.d2[idL].vtX = d.vtX;
+        dPts.d2[idL].vtY = d.vtY;
+      }
+      else
+      {
+        sPts.d3[idL] = s;
+        dPts.d3[idL] = d;
+      }
+    }
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      WlzDVertex3 p;
+
+      p.vtX = ext * AlgRandUniform();
+      p.vtY = ext * AlgRandUniform();
+      p.vtZ = ext * AlgRandUniform();
+      if(dim == 2)
+      {
+        pos.d2[idP].vtX = p.vtX;
+        pos.d2[idP].vtY = p.vtY;
+      }
+      else
+      {
+        pos.d3[idP] = p;
+      }
+    }
+    basisTr = (dim == 2)?
+              WlzBasisFnTrFromCPts2D(fnType, 0, nLmk, dPts.d2, nLmk, sPts.d2,
+	                             NULL, &errNum):
+              WlzBasisFnTrFromCPts3D(fnType, 0, nLmk, dPts.d3, nLmk, sPts.d3,
+	                             NULL, &errNum);
+  }
+  /* Evaluate at each position in turn. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzBasisFn	*fn;
+
+    fn = basisTr->basisFn;
+    t0 = WlzTstBasisFnBatchTime();
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      switch(fnType)
+      {
+        case WLZ_FN_BASIS_2DTPS:
+	  dsp[0].d2[idP] = WlzBasisFnValueTPS2D(fn, pos.d2[idP]);
+	  break;
+        case WLZ_FN_BASIS_2DIMQ:
+	  dsp[0].d2[idP] = WlzBasisFnValueIMQ2D(fn, pos.d2[idP]);
+	  break;
+        case WLZ_FN_BASIS_2DMQ:
+	  dsp[0].d2[idP] = WlzBasisFnValueMQ2D(fn, pos.d2[idP]);
+	  break;
+        case WLZ_FN_BASIS_3DIMQ:
+	  dsp[0].d3[idP] = WlzBasisFnValueIMQ3D(fn, pos.d3[idP]);
+	  break;
+        case WLZ_FN_BASIS_3DMQ:
+	  dsp[0].d3[idP] = WlzBasisFnValueMQ3D(fn, pos.d3[idP]);
+	  break;
+	default:
+	  break;
+      }
+    }
+    dstT[0] = WlzTstBasisFnBatchTime() - t0;
+  }
+  /* Evaluate exactly and then approximately in batches. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    t0 = WlzTstBasisFnBatchTime();
+    errNum = (dim == 2)?
+             WlzBasisFnValueBatch2D(basisTr->basisFn, nPos, pos.d2,
+	                            dsp[1].d2, 0.0):
+             WlzBasisFnValueBatch3D(basisTr->basisFn, nPos, pos.d3,
+	                            dsp[1].d3, 0.0);
+    dstT[1] = WlzTstBasisFnBatchTime() - t0;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    t0 = WlzTstBasisFnBatchTime();
+    errNum = (dim == 2)?
+             WlzBasisFnValueBatch2D(basisTr->basisFn, nPos, pos.d2,
+	                            dsp[2].d2, tol):
+             WlzBasisFnValueBatch3D(basisTr->basisFn, nPos, pos.d3,
+	                            dsp[2].d3, tol);
+    dstT[2] = WlzTstBasisFnBatchTime() - t0;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    size_t	sz;
+
+    sz = nPos * ((dim == 2)? sizeof(WlzDVertex2): sizeof(WlzDVertex3));
+    *dstExactSame = memcmp(dsp[0].v, dsp[1].v, sz) == 0;
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      double	d;
+      WlzDVertex3 e;
+
+      if(dim == 2)
+      {
+        e.vtX = dsp[2].d2[idP].vtX - dsp[0].d2[idP].vtX;
+        e.vtY = dsp[2].d2[idP].vtY - dsp[0].d2[idP].vtY;
+	e.vtZ = 0.0;
+      }
+      else
+      {
+        WLZ_VTX_3_SUB(e, dsp[2].d3[idP], dsp[0].d3[idP]);
+      }
+      d = WLZ_VTX_3_LENGTH(e);
+      if(d > maxErr)
+      {
+        maxErr = d;
+      }
+    }
+    *dstMaxErr = maxErr;
+  }
+  (void )WlzBasisFnFreeTransform(basisTr);
+  AlcFree(dPts.v);
+  AlcFree(sPts.v);
+  AlcFree(pos.v);
+  AlcFree(dsp[0].v);
+  AlcFree(dsp[1].v);
+  AlcFree(dsp[2].v);
+  return(errNum);
+}
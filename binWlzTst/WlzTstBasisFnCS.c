@@ -0,0 +1,547 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstBasisFnCS_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstBasisFnCS.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the compactly supported 3D basis function
+* 		WLZ_FN_BASIS_3DCS. The sparse conjugate gradient fit
+* 		of WlzBasisFnCS3DFromCPts() is compared with a dense
+* 		fit, in which the affine polynomial is found by singular
+* 		value decomposition of the least squares system and the
+* 		coefficients by singular value decomposition of the full
+* 		design matrix, as for the other basis functions. The
+* 		displacements must agree at the control points and at
+* 		random positions, must interpolate the control points and
+* 		the fit must be identical with one and several threads.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static void			WlzTstBasisFnCSSetThreads(
+				  int nThr);
+static void			WlzTstBasisFnCSPts(
+				  int clustered,
+				  int nPts,
+				  WlzDVertex3 *dPts,
+				  WlzDVertex3 *sPts);
+static double			WlzTstBasisFnCSPhi(
+				  WlzDVertex3 p,
+				  WlzDVertex3 q,
+				  double s);
+static WlzDVertex3		WlzTstBasisFnCSRefValue(
+				  int nPts,
+				  WlzDVertex3 *dPts,
+				  double *poly,
+				  double *coef,
+				  double s,
+				  WlzDVertex3 p);
+static int			WlzTstBasisFnCSSame(
+				  WlzBasisFn *f0,
+				  WlzBasisFn *f1);
+static int			WlzTstBasisFnCSInterp(
+				  int nPts,
+				  WlzDVertex3 *dPts,
+				  WlzDVertex3 *sPts,
+				  WlzBasisFn *fn,
+				  double tol,
+				  double *maxErr);
+static int			WlzTstBasisFnCSDense(
+				  int nPts,
+				  WlzDVertex3 *dPts,
+				  WlzDVertex3 *sPts,
+				  WlzBasisFn *fn,
+				  double s,
+				  double tol,
+				  double *maxErr,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idC,
+  		option,
+		nPts = 400,
+		nThr = 4,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  WlzDVertex3	*dPts = NULL,
+  		*sPts = NULL;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvn:t:";
+  const double	delta[2] = {0.0, 0.25};
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'n':
+        usage = (sscanf(optarg, "%d", &nPts) != 1) || (nPts < 16);
+	break;
+      case 't':
+        usage = (sscanf(optarg, "%d", &nThr) != 1) || (nThr < 1);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    if(((dPts = (WlzDVertex3 *)
+                AlcMalloc(sizeof(WlzDVertex3) * nPts)) == NULL) ||
+       ((sPts = (WlzDVertex3 *)
+                AlcMalloc(sizeof(WlzDVertex3) * nPts)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  for(idC = 0; ok && (errNum == WLZ_ERR_NONE) && (idC < 4); ++idC)
+  {
+    int		idR,
+    		bad[3] = {0};
+    double	tol,
+		maxDsp = 1.0;
+    double	maxErr[2] = {0.0};
+    WlzBasisFn	*fn[2] = {NULL};
+
+    WlzTstBasisFnCSPts(idC / 2, nPts, dPts, sPts);
+    for(idR = 0; idR < nPts; ++idR)
+    {
+      WlzDVertex3 d;
+
+      WLZ_VTX_3_SUB(d, sPts[idR], dPts[idR]);
+      maxDsp = ALG_MAX(maxDsp, WLZ_VTX_3_LENGTH(d));
+    }
+    tol = 1.0e-06 * maxDsp;
+    for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < 2); ++idR)
+    {
+      WlzTstBasisFnCSSetThreads((idR == 0)? 1: nThr);
+      fn[idR] = WlzBasisFnCS3DFromCPts(nPts, dPts, sPts, delta[idC % 2],
+      				       &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bad[0] = WlzTstBasisFnCSSame(fn[0], fn[1]);
+      bad[1] = WlzTstBasisFnCSInterp(nPts, dPts, sPts, fn[0], tol,
+      				     &(maxErr[0]));
+    }
+    /* The support radius is only known for the given normalized
+     * support, being this times the range of the control points. */
+    if((errNum == WLZ_ERR_NONE) && (delta[idC % 2] > DBL_EPSILON))
+    {
+      WlzDBox3	bBox;
+
+      bBox.xMin = bBox.yMin = bBox.zMin = DBL_MAX;
+      bBox.xMax = bBox.yMax = bBox.zMax = -DBL_MAX;
+      for(idR = 0; idR < 2 * nPts; ++idR)
+      {
+        WlzDVertex3 p;
+
+	p = (idR < nPts)? dPts[idR]: sPts[idR - nPts];
+	bBox.xMin = ALG_MIN(bBox.xMin, p.vtX);
+	bBox.yMin = ALG_MIN(bBox.yMin, p.vtY);
+	bBox.zMin = ALG_MIN(bBox.zMin, p.vtZ);
+	bBox.xMax = ALG_MAX(bBox.xMax, p.vtX);
+	bBox.yMax = ALG_MAX(bBox.yMax, p.vtY);
+	bBox.zMax = ALG_MAX(bBox.zMax, p.vtZ);
+      }
+      bad[2] = WlzTstBasisFnCSDense(nPts, dPts, sPts, fn[0],
+      				    delta[idC % 2] *
+				    ALG_MAX3(bBox.xMax - bBox.xMin,
+				             bBox.yMax - bBox.yMin,
+					     bBox.zMax - bBox.zMin),
+				    tol, &(maxErr[1]), &errNum);
+    }
+    if((errNum == WLZ_ERR_NONE) && (verbose || bad[0] || bad[1] || bad[2]))
+    {
+      (void )printf("%s points, support %g: threads %s, "
+                    "%d not interpolated (max error %g)",
+		    (idC / 2)? "clustered": "uniform", delta[idC % 2],
+		    (bad[0])? "differ": "same", bad[1], maxErr[0]);
+      if(delta[idC % 2] > DBL_EPSILON)
+      {
+        (void )printf(", %d differ from dense fit (max error %g)",
+		      bad[2], maxErr[1]);
+      }
+      (void )printf("\n");
+    }
+    nBad += bad[0] + bad[1] + bad[2];
+    (void )WlzBasisFnFree(fn[0]);
+    (void )WlzBasisFnFree(fn[1]);
+  }
+  AlcFree(dPts);
+  AlcFree(sPts);
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to fit basis function (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d differences (%s)\n",
+		    argv[0], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-n#] [-t#]\n"
+    "Tests the compactly supported 3D basis function fit of\n"
+    "WlzBasisFnCS3DFromCPts() against a dense singular value\n"
+    "decomposition fit, for uniform and clustered control points.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, reporting each fit.\n"
+    "  -n  Number of control points (default %d).\n"
+    "  -t  Number of threads used after one thread (default %d).\n",
+    argv[0], 400, 4);
+  }
+  return(!ok);
+}
+
+/* Sets the number of threads used by the following parallel regions. */
+static void	WlzTstBasisFnCSSetThreads(int nThr)
+{
+#ifdef _OPENMP
+  omp_set_num_threads(nThr);
+#endif
+}
+
+/* Makes random destination control points, either uniformly
+ * distributed through a box or in four clusters, and source control
+ * points displaced from them by an affine transform and a smooth
+ * non-linear displacement. */
+static void	WlzTstBasisFnCSPts(int clustered, int nPts,
+				   WlzDVertex3 *dPts, WlzDVertex3 *sPts)
+{
+  int		idP;
+  const WlzDVertex3 cen[4] = {{-20.0, 15.0, 10.0}, {40.0, 20.0, 30.0},
+  			      {10.0, 55.0, 20.0}, {50.0, 60.0, 5.0}};
+
+  AlgRandSeed(nPts + clustered);
+  for(idP = 0; idP < nPts; ++idP)
+  {
+    WlzDVertex3	d,
+    		p;
+
+    if(clustered)
+    {
+      p.vtX = AlgRandNormal(cen[idP % 4].vtX, 6.0);
+      p.vtY = AlgRandNormal(cen[idP % 4].vtY, 4.0);
+      p.vtZ = AlgRandNormal(cen[idP % 4].vtZ, 3.0);
+    }
+    else
+    {
+      p.vtX = -30.0 + 100.0 * AlgRandUniform();
+      p.vtY = 10.0 + 60.0 * AlgRandUniform();
+      p.vtZ = 5.0 + 40.0 * AlgRandUniform();
+    }
+    d.vtX = 3.0 + 0.02 * p.vtX - 0.05 * p.vtY + 0.01 * p.vtZ +
+            2.0 * sin(p.vtX / 15.0) * cos(p.vtY / 20.0);
+    d.vtY = -2.0 + 0.04 * p.vtX + 0.03 * p.vtY - 0.02 * p.vtZ +
+            1.5 * cos(p.vtZ / 10.0);
+    d.vtZ = 1.0 - 0.01 * p.vtX + 0.02 * p.vtY + 0.05 * p.vtZ +
+            sin((p.vtX + p.vtY) / 25.0);
+    dPts[idP] = p;
+    WLZ_VTX_3_ADD(sPts[idP], p, d);
+  }
+}
+
+/* Wendland phi_{3,1} basis function for the given positions and
+ * support radius. */
+static double	WlzTstBasisFnCSPhi(WlzDVertex3 p, WlzDVertex3 q, double s)
+{
+  double	r,
+  		phi = 0.0;
+  WlzDVertex3	d;
+
+  WLZ_VTX_3_SUB(d, p, q);
+  r = WLZ_VTX_3_LENGTH(d) / s;
+  if(r < 1.0)
+  {
+    phi = pow(1.0 - r, 4.0) * (4.0 * r + 1.0);
+  }
+  return(phi);
+}
+
+/* Computes the displacement at the given position using the dense
+ * polynomial and coefficients, with all control points contributing.
+ * The polynomial has the four coefficients of each component in turn
+ * and the coefficients have the nPts coefficients of each component
+ * in turn. */
+static WlzDVertex3 WlzTstBasisFnCSRefValue(int nPts, WlzDVertex3 *dPts,
+				      double *poly, double *coef, double s,
+				      WlzDVertex3 p)
+{
+  int		idP;
+  double	v[3];
+  WlzDVertex3	dsp;
+
+  for(idP = 0; idP < 3; ++idP)
+  {
+    double	*q;
+
+    q = poly + 4 * idP;
+    v[idP] = q[0] + q[1] * p.vtX + q[2] * p.vtY + q[3] * p.vtZ;
+  }
+  for(idP = 0; idP < nPts; ++idP)
+  {
+    double	phi;
+
+    phi = WlzTstBasisFnCSPhi(p, dPts[idP], s);
+    v[0] += coef[idP] * phi;
+    v[1] += coef[nPts + idP] * phi;
+    v[2] += coef[2 * nPts + idP] * phi;
+  }
+  dsp.vtX = v[0];
+  dsp.vtY = v[1];
+  dsp.vtZ = v[2];
+  return(dsp);
+}
+
+/* Returns zero if the two basis functions have bit for bit identical
+ * polynomial and basis function coefficients, otherwise one. */
+static int	WlzTstBasisFnCSSame(WlzBasisFn *f0, WlzBasisFn *f1)
+{
+  int		bad;
+
+  bad = (f0->type != f1->type) || (f0->nBasis != f1->nBasis) ||
+        (memcmp(f0->poly.d3, f1->poly.d3, 4 * sizeof(WlzDVertex3)) != 0) ||
+        (memcmp(f0->basis.d3, f1->basis.d3,
+	        f0->nBasis * sizeof(WlzDVertex3)) != 0);
+  return(bad);
+}
+
+/* Returns the number of control points at which the basis function
+ * displacement differs from the control point displacement by more
+ * than the tolerance. */
+static int	WlzTstBasisFnCSInterp(int nPts, WlzDVertex3 *dPts,
+				      WlzDVertex3 *sPts, WlzBasisFn *fn,
+				      double tol, double *maxErr)
+{
+  int		idP,
+  		nBad = 0;
+
+  *maxErr = 0.0;
+  for(idP = 0; idP < nPts; ++idP)
+  {
+    double	e;
+    WlzDVertex3	d,
+    		v;
+
+    v = WlzBasisFnValueCS3D(fn, dPts[idP]);
+    WLZ_VTX_3_SUB(d, sPts[idP], dPts[idP]);
+    WLZ_VTX_3_SUB(d, d, v);
+    e = WLZ_VTX_3_LENGTH(d);
+    *maxErr = ALG_MAX(*maxErr, e);
+    nBad += e > tol;
+  }
+  return(nBad);
+}
+
+/* Fits the basis function densely and returns the number of positions,
+ * being the control points and random positions about them, at which
+ * the dense and given basis function displacements differ by more than
+ * the tolerance. */
+static int	WlzTstBasisFnCSDense(int nPts, WlzDVertex3 *dPts,
+				     WlzDVertex3 *sPts, WlzBasisFn *fn,
+				     double s, double tol, double *maxErr,
+				     WlzErrorNum *dstErr)
+{
+  int		idC,
+  		idP,
+		idQ,
+		nBad = 0;
+  double	poly[12];
+  double	*bV = NULL,
+  		*wV = NULL,
+		*coef = NULL;
+  WlzDVertex3	*d3;
+  AlgMatrix	aM,
+  		vM;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	nRnd = 500;
+
+  *maxErr = 0.0;
+  aM.core = vM.core = NULL;
+  /* Affine polynomial by least squares, the back substitution
+   * requiring V to have as many rows as U. */
+  if(((bV = (double *)AlcMalloc(sizeof(double) * nPts)) == NULL) ||
+     ((wV = (double *)AlcMalloc(sizeof(double) * nPts)) == NULL) ||
+     ((coef = (double *)AlcMalloc(sizeof(double) * 3 * nPts)) == NULL) ||
+     ((aM.rect = AlgMatrixRectNew(nPts, 4, NULL)) == NULL) ||
+     ((vM.rect = AlgMatrixRectNew(nPts, 4, NULL)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idP = 0; idP < nPts; ++idP)
+    {
+      aM.rect->array[idP][0] = 1.0;
+      aM.rect->array[idP][1] = dPts[idP].vtX;
+      aM.rect->array[idP][2] = dPts[idP].vtY;
+      aM.rect->array[idP][3] = dPts[idP].vtZ;
+    }
+    errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(aM, wV, vM));
+  }
+  for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < 3); ++idC)
+  {
+    for(idP = 0; idP < nPts; ++idP)
+    {
+      d3 = sPts + idP;
+      bV[idP] = (idC == 0)? d3->vtX - dPts[idP].vtX:
+                (idC == 1)? d3->vtY - dPts[idP].vtY:
+		            d3->vtZ - dPts[idP].vtZ;
+    }
+    errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    (void )memcpy(poly + 4 * idC, bV, 4 * sizeof(double));
+  }
+  AlgMatrixFree(aM);
+  AlgMatrixFree(vM);
+  aM.core = vM.core = NULL;
+  /* Basis function coefficients from the residual displacements using
+   * the full design matrix. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((aM.rect = AlgMatrixRectNew(nPts, nPts, NULL)) == NULL) ||
+       ((vM.rect = AlgMatrixRectNew(nPts, nPts, NULL)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idP = 0; idP < nPts; ++idP)
+    {
+      for(idQ = 0; idQ < nPts; ++idQ)
+      {
+        aM.rect->array[idP][idQ] = WlzTstBasisFnCSPhi(dPts[idP],
+						      dPts[idQ], s);
+      }
+    }
+    errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(aM, wV, vM));
+  }
+  for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < 3); ++idC)
+  {
+    double	*q;
+
+    q = poly + 4 * idC;
+    for(idP = 0; idP < nPts; ++idP)
+    {
+      double	v;
+
+      d3 = dPts + idP;
+      v = q[0] + q[1] * d3->vtX + q[2] * d3->vtY + q[3] * d3->vtZ;
+      bV[idP] = ((idC == 0)? sPts[idP].vtX - d3->vtX:
+                 (idC == 1)? sPts[idP].vtY - d3->vtY:
+		             sPts[idP].vtZ - d3->vtZ) - v;
+    }
+    errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    (void )memcpy(coef + idC * nPts, bV, nPts * sizeof(double));
+  }
+  /* Compare the displacements at the control points and at random
+   * positions within and just beyond their bounding box. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idP = 0; idP < nPts + nRnd; ++idP)
+    {
+      double	e;
+      WlzDVertex3 p,
+      		  d,
+		  v0,
+		  v1;
+
+      if(idP < nPts)
+      {
+        p = dPts[idP];
+      }
+      else
+      {
+        p = dPts[(int )(AlgRandUniform() * (nPts - 1))];
+	p.vtX += s * (AlgRandUniform() - 0.5);
+	p.vtY += s * (AlgRandUniform() - 0.5);
+	p.vtZ += s * (AlgRandUniform() - 0.5);
+      }
+      v0 = WlzTstBasisFnCSRefValue(nPts, dPts, poly, coef, s, p);
+      v1 = WlzBasisFnValueCS3D(fn, p);
+      WLZ_VTX_3_SUB(d, v0, v1);
+      e = WLZ_VTX_3_LENGTH(d);
+      *maxErr = ALG_MAX(*maxErr, e);
+      nBad += e > tol;
+    }
+  }
+  AlgMatrixFree(aM);
+  AlgMatrixFree(vM);
+  AlcFree(coef);
+  AlcFree(wV);
+  AlcFree(bV);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nBad);
+}
@@ -0,0 +1,656 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstCMeshCompact_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstCMeshCompact.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test and benchmark for compact 3D conforming meshes.
+* 		A mesh is made for a sphere and converted to a compact
+* 		mesh. The compact mesh's element neighbours are checked,
+* 		element location and Laplacian smoothing are compared and
+* 		timed against those of the mesh, positions transformed
+* 		by a mesh transform (which uses a compact mesh to locate
+* 		elements when there are many positions) are compared
+* 		with those transformed one at a time, the compact mesh is
+* 		converted back to a mesh (before smoothing, which may
+* 		invert elements) and the memory used by both forms is
+* 		reported.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstCMeshCompactTime(void);
+static int			WlzTstCMeshCompactCheckNbr(
+				  WlzCMeshCompact3D *cMesh);
+static int			WlzTstCMeshCompactCmp(
+				  WlzCMeshCompact3D *c0,
+				  WlzCMeshCompact3D *c1);
+static int			WlzTstCMeshCompactTransformed(
+				  WlzObject *mObj,
+				  WlzCMeshCompact3D *cMesh,
+				  WlzDVertex3 pos,
+				  WlzDVertex3 tPos);
+static int			WlzTstCMeshCompactTransform(
+				  WlzObject *mObj,
+				  WlzCMeshCompact3D *cMesh,
+				  double *dstT,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+		itr = 10,
+		nBad = 0,
+		nLocBad = 0,
+		nTrBad = 0,
+  		ok = 1,
+  		usage = 0;
+  size_t	memMesh = 0,
+  		memCompact = 0;
+  double	rad = 40.0,
+  		minElmSz = 2.0,
+		maxElmSz = 8.0,
+		maxDif = 0.0;
+  double	t[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+  const char	*errMsgStr;
+  WlzObject	*obj = NULL,
+  		*mObj = NULL;
+  WlzCMeshP	mesh;
+  WlzCMesh3D	*rMesh = NULL;
+  WlzCMeshCompact3D *cMesh = NULL,
+  		*rCMesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hi:m:M:r:";
+
+  mesh.v = NULL;
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'i':
+        usage = (sscanf(optarg, "%d", &itr) != 1) || (itr < 0);
+	break;
+      case 'm':
+        usage = (sscanf(optarg, "%lg", &minElmSz) != 1) || (minElmSz <= 0.0);
+	break;
+      case 'M':
+        usage = (sscanf(optarg, "%lg", &maxElmSz) != 1) || (maxElmSz <= 0.0);
+	break;
+      case 'r':
+        usage = (sscanf(optarg, "%lg", &rad) != 1) || (rad < 2.0);
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  /* Make a mesh for a sphere and then its compact form. */
+  if(ok)
+  {
+    obj = WlzAssignObject(
+	  WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, rad, rad, rad, rad,
+			      &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      mesh = WlzCMeshFromObj(obj, minElmSz, maxElmSz, NULL, 1, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzDomain	dom;
+      WlzValues	val;
+
+      dom.cm3 = mesh.m3;
+      val.core = NULL;
+      mObj = WlzAssignObject(
+             WlzMakeMain(WLZ_CMESH_3D, dom, val, NULL, NULL, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      double	t0;
+
+      (void )WlzCMeshSetBoundNodFlags3D(mesh.m3);
+      t0 = WlzTstCMeshCompactTime();
+      cMesh = WlzCMeshCompactFromMesh3D(mesh.m3, &errNum);
+      t[0] = WlzTstCMeshCompactTime() - t0;
+    }
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    nBad += (cMesh->nNod != mesh.m3->res.nod.numEnt) ||
+            (cMesh->nElm != mesh.m3->res.elm.numEnt);
+    nBad += WlzTstCMeshCompactCheckNbr(cMesh);
+  }
+  /* Locate the elements enclosing positions in a raster scan of the
+   * bounding box using the mesh and then the compact mesh. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    int		idP,
+    		nPos,
+		last;
+    int		*elm;
+    double	t0;
+    WlzDVertex3	p;
+    WlzDBox3	bB;
+
+    bB = cMesh->bBox;
+    nPos = (int )(floor(bB.xMax - bB.xMin) * floor(bB.yMax - bB.yMin) *
+                  floor(bB.zMax - bB.zMin));
+    if((elm = (int *)AlcMalloc(sizeof(int) * (nPos + 1))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(idP = 0; idP < 2; ++idP)
+      {
+	int	cnt = 0;
+
+	last = -1;
+	t0 = WlzTstCMeshCompactTime();
+	for(p.vtZ = bB.zMin + 0.5; p.vtZ < bB.zMax - 0.5; p.vtZ += 1.0)
+	{
+	  for(p.vtY = bB.yMin + 0.5; p.vtY < bB.yMax - 0.5; p.vtY += 1.0)
+	  {
+	    for(p.vtX = bB.xMin + 0.5; p.vtX < bB.xMax - 0.5; p.vtX += 1.0)
+	    {
+	      int	e;
+
+	      if(idP == 0)
+	      {
+		e = WlzCMeshElmEnclosingPos3D(mesh.m3, last,
+					      p.vtX, p.vtY, p.vtZ, 0, NULL);
+		elm[cnt] = e;
+	      }
+	      else
+	      {
+		e = WlzCMeshCompactElmEnclosingPos3D(cMesh, last, p);
+		/* Element indices may differ for positions on a face
+		 * and the compact mesh may find elements for positions
+		 * on the mesh boundary which the mesh does not, but any
+		 * position found using the mesh must be found. */
+		if((e < 0) && (elm[cnt] >= 0))
+		{
+		  ++nLocBad;
+		}
+	      }
+	      if(e >= 0)
+	      {
+		last = e;
+	      }
+	      ++cnt;
+	    }
+	  }
+	}
+	t[1 + idP] = WlzTstCMeshCompactTime() - t0;
+      }
+      AlcFree(elm);
+    }
+  }
+  /* Transform positions using a mesh transform, with the compact mesh
+   * used to locate their elements, and compare them with the positions
+   * transformed one at a time. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    nTrBad = WlzTstCMeshCompactTransform(mObj, cMesh, &(t[4]), &errNum);
+  }
+  /* Convert the compact mesh back to a mesh and compare the compact
+   * form of that with the compact mesh. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    rMesh = WlzCMeshCompactToMesh3D(cMesh, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rCMesh = WlzCMeshCompactFromMesh3D(rMesh, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nBad += WlzTstCMeshCompactCmp(cMesh, rCMesh);
+    }
+  }
+  /* Smooth the mesh and the compact mesh and compare the node
+   * positions. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    int		idN;
+    double	t0,
+    		t1;
+
+    t0 = WlzTstCMeshCompactTime();
+    errNum = WlzCMeshLaplacianSmooth3D(mesh.m3, itr, 0.1, 0, 0);
+    t1 = WlzTstCMeshCompactTime();
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzCMeshCompactLaplacianSmooth3D(cMesh, itr, 0.1, 0, 0);
+    }
+    t[3] = WlzTstCMeshCompactTime() - t1;
+    t1 -= t0;
+    for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < cMesh->nNod); ++idN)
+    {
+      double	d;
+      WlzDVertex3 del;
+      WlzCMeshNod3D *nod;
+
+      nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh.m3->res.nod.vec,
+					      cMesh->nodIdx[idN]);
+      WLZ_VTX_3_SUB(del, nod->pos, cMesh->nodPos[idN]);
+      d = WLZ_VTX_3_LENGTH(del);
+      maxDif = ALG_MAX(maxDif, d);
+    }
+    nBad += maxDif > 1.0e-9;
+    (void )printf("%s: smooth %d iterations, mesh %gs, compact %gs, "
+                  "max difference %g\n", argv[0], itr, t1, t[3], maxDif);
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    memMesh = (mesh.m3->res.nod.numEnt * sizeof(WlzCMeshNod3D)) +
+              (mesh.m3->res.elm.numEnt *
+	       (sizeof(WlzCMeshElm3D) + sizeof(WlzCMeshCellElm3D)));
+    memCompact = sizeof(WlzCMeshCompact3D) +
+                 (cMesh->nNod * (sizeof(WlzDVertex3) +
+		                 sizeof(unsigned int) + (2 * sizeof(int)))) +
+		 (cMesh->nElm * 13 * sizeof(int)) +
+		 ((cMesh->cellNum.vtX * cMesh->cellNum.vtY *
+		   cMesh->cellNum.vtZ) + 1 +
+		  cMesh->cellElmOff[cMesh->cellNum.vtX * cMesh->cellNum.vtY *
+		                    cMesh->cellNum.vtZ]) * sizeof(int);
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to test compact meshes (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = (nBad == 0) && (nLocBad == 0) && (nTrBad == 0);
+      (void )printf("%s: %d nodes, %d elements, compact %gs, "
+                    "memory mesh %lu compact %lu (at least)\n"
+		    "%s: transform %gs, %d transform differences\n"
+		    "%s: locate mesh %gs, compact %gs, "
+		    "%d location differences, %d other differences (%s)\n",
+		    argv[0], cMesh->nNod, cMesh->nElm, t[0],
+		    (unsigned long )memMesh, (unsigned long )memCompact,
+		    argv[0], t[4], nTrBad,
+		    argv[0], t[1], t[2], nLocBad, nBad,
+		    (ok)? "pass": "FAIL");
+    }
+  }
+  if(cMesh)
+  {
+    (void )WlzCMeshCompactFree3D(cMesh);
+  }
+  if(rCMesh)
+  {
+    (void )WlzCMeshCompactFree3D(rCMesh);
+  }
+  if(rMesh)
+  {
+    (void )WlzCMeshFree3D(rMesh);
+  }
+  if(mObj)
+  {
+    (void )WlzFreeObj(mObj);
+  }
+  else if(mesh.v)
+  {
+    (void )WlzCMeshFree(mesh);
+  }
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-i#] [-m#] [-M#] [-r#]\n"
+    "Tests and times compact 3D conforming meshes using a mesh made for\n"
+    "a sphere.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -i  Number of smoothing iterations (default %d).\n"
+    "  -m  Minimum mesh element size (default %g).\n"
+    "  -M  Maximum mesh element size (default %g).\n"
+    "  -r  Sphere radius (default %g).\n",
+    argv[0], 10, 2.0, 8.0, 40.0);
+  }
+  return(!ok);
+}
+
+static double	WlzTstCMeshCompactTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
+
+/* Checks that each element neighbour shares the three nodes of the
+ * face opposite the node and has the element as a neighbour, and that
+ * the node to element adjacency is consistent with the element nodes,
+ * returning the number of failures. */
+static int	WlzTstCMeshCompactCheckNbr(WlzCMeshCompact3D *cMesh)
+{
+  int		idE,
+  		idK,
+		idL,
+		nBad = 0;
+
+  for(idE = 0; idE < cMesh->nElm; ++idE)
+  {
+    int		*eNod;
+
+    eNod = cMesh->elmNod + (4 * idE);
+    for(idK = 0; idK < 4; ++idK)
+    {
+      int	nE;
+
+      if((nE = cMesh->elmNbr[(4 * idE) + idK]) >= 0)
+      {
+	int	nShr = 0,
+		back = 0;
+	int	*nNod;
+
+	nNod = cMesh->elmNod + (4 * nE);
+	for(idL = 0; idL < 4; ++idL)
+	{
+	  nShr += (idL != idK) &&
+	          ((nNod[0] == eNod[idL]) || (nNod[1] == eNod[idL]) ||
+	           (nNod[2] == eNod[idL]) || (nNod[3] == eNod[idL]));
+	  back += cMesh->elmNbr[(4 * nE) + idL] == idE;
+	}
+	nBad += (nShr != 3) || (back != 1);
+      }
+    }
+  }
+  for(idK = 0; idK < cMesh->nNod; ++idK)
+  {
+    for(idL = cMesh->nodElmOff[idK]; idL < cMesh->nodElmOff[idK + 1]; ++idL)
+    {
+      int	*eNod;
+
+      eNod = cMesh->elmNod + (4 * cMesh->nodElm[idL]);
+      nBad += (eNod[0] != idK) && (eNod[1] != idK) &&
+              (eNod[2] != idK) && (eNod[3] != idK);
+    }
+  }
+  nBad += cMesh->nodElmOff[cMesh->nNod] != 4 * cMesh->nElm;
+  return(nBad);
+}
+
+/* Compares the nodes, elements and neighbours of the two compact meshes
+ * returning the number of differences. */
+static int	WlzTstCMeshCompactCmp(WlzCMeshCompact3D *c0,
+				      WlzCMeshCompact3D *c1)
+{
+  int		idx,
+  		nBad = 0;
+
+  if((c0->nNod != c1->nNod) || (c0->nElm != c1->nElm))
+  {
+    ++nBad;
+  }
+  else
+  {
+    for(idx = 0; idx < c0->nNod; ++idx)
+    {
+      nBad += (c0->nodPos[idx].vtX != c1->nodPos[idx].vtX) ||
+	      (c0->nodPos[idx].vtY != c1->nodPos[idx].vtY) ||
+	      (c0->nodPos[idx].vtZ != c1->nodPos[idx].vtZ);
+    }
+    for(idx = 0; idx < 4 * c0->nElm; ++idx)
+    {
+      nBad += (c0->elmNod[idx] != c1->elmNod[idx]) ||
+	      (c0->elmNbr[idx] != c1->elmNbr[idx]);
+    }
+  }
+  return(nBad);
+}
+
+/* Sets smooth displacements for the nodes of the mesh transform and then
+ * transforms positions in a raster scan of a box which encloses the mesh,
+ * all at once (so that the elements are located using a compact mesh)
+ * and one at a time (so that the mesh is searched). Returns the number of
+ * positions which are either found in an element when transformed one
+ * at a time but not when all are transformed, or are not transformed
+ * correctly. */
+static int	WlzTstCMeshCompactTransform(WlzObject *mObj,
+					    WlzCMeshCompact3D *cMesh,
+					    double *dstT, WlzErrorNum *dstErr)
+{
+  int		idP,
+  		dim = 3,
+		nPos = 0,
+  		nBad = 0;
+  WlzUByte	*in0 = NULL,
+  		*in1 = NULL;
+  WlzDVertex3	*pos0 = NULL,
+  		*pos1 = NULL,
+		*pos2 = NULL;
+  WlzDBox3	bB;
+  WlzValues	val;
+  WlzCMesh3D	*mesh;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bB = cMesh->bBox;
+  mesh = mObj->domain.cm3;
+  val.x = WlzMakeIndexedValues(mObj, 1, &dim, WLZ_GREY_DOUBLE,
+                               WLZ_VALUE_ATTACH_NOD, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idN;
+
+    mObj->values = WlzAssignValues(val, NULL);
+    for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
+    {
+      WlzCMeshNod3D *nod;
+
+      nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+      if((nod != NULL) && (nod->idx >= 0))
+      {
+	double	*dsp;
+
+	dsp = (double *)WlzIndexedValueGet(val.x, idN);
+	dsp[0] = 3.0 * sin(nod->pos.vtY / 11.0);
+	dsp[1] = 2.0 * cos(nod->pos.vtZ / 7.0);
+	dsp[2] = 4.0 * sin(nod->pos.vtX / 13.0);
+      }
+    }
+    nPos = (int )(floor(bB.xMax - bB.xMin + 5.0) *
+                  floor(bB.yMax - bB.yMin + 5.0) *
+                  floor(bB.zMax - bB.zMin + 5.0));
+    if(((pos0 = (WlzDVertex3 *)
+                AlcMalloc(sizeof(WlzDVertex3) * nPos)) == NULL) ||
+       ((pos1 = (WlzDVertex3 *)
+                AlcMalloc(sizeof(WlzDVertex3) * nPos)) == NULL) ||
+       ((pos2 = (WlzDVertex3 *)
+                AlcMalloc(sizeof(WlzDVertex3) * nPos)) == NULL) ||
+       ((in0 = (WlzUByte *)AlcMalloc(sizeof(WlzUByte) * nPos)) == NULL) ||
+       ((in1 = (WlzUByte *)AlcMalloc(sizeof(WlzUByte) * nPos)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzDVertex3 p;
+
+    /* Start outside the mesh so that the nearest node displacements
+     * are also used. */
+    idP = 0;
+    for(p.vtZ = bB.zMin - 2.0; p.vtZ < bB.zMax + 2.0; p.vtZ += 1.0)
+    {
+      for(p.vtY = bB.yMin - 2.0; p.vtY < bB.yMax + 2.0; p.vtY += 1.0)
+      {
+	for(p.vtX = bB.xMin - 2.0; p.vtX < bB.xMax + 2.0; p.vtX += 1.0)
+	{
+	  if(idP < nPos)
+	  {
+	    pos0[idP++] = p;
+	  }
+	}
+      }
+    }
+    nPos = idP;
+    (void )memcpy(pos1, pos0, sizeof(WlzDVertex3) * nPos);
+    (void )memcpy(pos2, pos0, sizeof(WlzDVertex3) * nPos);
+    *dstT = WlzTstCMeshCompactTime();
+    errNum = WlzCMeshTransformVtxAry3D(mObj, nPos, pos1, nPos, in0);
+    *dstT = WlzTstCMeshCompactTime() - *dstT;
+  }
+  for(idP = 0; (errNum == WLZ_ERR_NONE) && (idP < nPos); ++idP)
+  {
+    errNum = WlzCMeshTransformVtxAry3D(mObj, 1, pos2 + idP, 1, in1 + idP);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      /* The compact mesh may find elements for positions on the mesh
+       * boundary which the mesh does not. Meshes may have overlapping
+       * elements, so positions within an element are checked using
+       * any element which encloses them. */
+      if(in0[idP])
+      {
+        nBad += !WlzTstCMeshCompactTransformed(mObj, cMesh, pos0[idP],
+					       pos1[idP]);
+      }
+      else if(in1[idP])
+      {
+        ++nBad;
+      }
+      else
+      {
+	WlzDVertex3 del;
+
+	WLZ_VTX_3_SUB(del, pos1[idP], pos2[idP]);
+	nBad += WLZ_VTX_3_LENGTH(del) > 1.0e-6;
+      }
+    }
+  }
+  AlcFree(pos0);
+  AlcFree(pos1);
+  AlcFree(pos2);
+  AlcFree(in0);
+  AlcFree(in1);
+  *dstErr = errNum;
+  return(nBad);
+}
+
+/* Returns non-zero if the transformed position is the given position
+ * transformed by linear interpolation of the node displacements of
+ * any element which encloses the given position (within the tolerance
+ * used for locating elements). */
+static int	WlzTstCMeshCompactTransformed(WlzObject *mObj,
+					      WlzCMeshCompact3D *cMesh,
+					      WlzDVertex3 pos,
+					      WlzDVertex3 tPos)
+{
+  int		idC,
+  		idE,
+		found = 0;
+  WlzIVertex3	c;
+
+  c.vtX = (int )floor((pos.vtX - cMesh->bBox.xMin) / cMesh->cellSz);
+  c.vtY = (int )floor((pos.vtY - cMesh->bBox.yMin) / cMesh->cellSz);
+  c.vtZ = (int )floor((pos.vtZ - cMesh->bBox.zMin) / cMesh->cellSz);
+  c.vtX = ALG_CLAMP(c.vtX, 0, cMesh->cellNum.vtX - 1);
+  c.vtY = ALG_CLAMP(c.vtY, 0, cMesh->cellNum.vtY - 1);
+  c.vtZ = ALG_CLAMP(c.vtZ, 0, cMesh->cellNum.vtZ - 1);
+  idC = (((c.vtZ * cMesh->cellNum.vtY) + c.vtY) * cMesh->cellNum.vtX) +
+	c.vtX;
+  for(idE = cMesh->cellElmOff[idC];
+      (found == 0) && (idE < cMesh->cellElmOff[idC + 1]); ++idE)
+  {
+    int		idN;
+    double	v;
+    double	b[4];
+    WlzDVertex3	p[4],
+    		q;
+    int		*eNod;
+
+    eNod = cMesh->elmNod + (4 * cMesh->cellElm[idE]);
+    for(idN = 0; idN < 4; ++idN)
+    {
+      p[idN] = cMesh->nodPos[eNod[idN]];
+    }
+    /* Barycentric coordinates from the volumes of the tetrahedra made
+     * by replacing each node with the given position. */
+    v = WlzGeomTetraSnVolume6(p[0], p[1], p[2], p[3]);
+    for(idN = 0; idN < 4; ++idN)
+    {
+      q = p[idN];
+      p[idN] = pos;
+      b[idN] = WlzGeomTetraSnVolume6(p[0], p[1], p[2], p[3]) / v;
+      p[idN] = q;
+    }
+    if((b[0] > -WLZ_MESH_TOLERANCE) && (b[1] > -WLZ_MESH_TOLERANCE) &&
+       (b[2] > -WLZ_MESH_TOLERANCE) && (b[3] > -WLZ_MESH_TOLERANCE))
+    {
+      WlzDVertex3 del;
+
+      q = pos;
+      for(idN = 0; idN < 4; ++idN)
+      {
+	double	*dsp;
+
+	dsp = (double *)WlzIndexedValueGet(mObj->values.x,
+					   cMesh->nodIdx[eNod[idN]]);
+	q.vtX += b[idN] * dsp[0];
+	q.vtY += b[idN] * dsp[1];
+	q.vtZ += b[idN] * dsp[2];
+      }
+      WLZ_VTX_3_SUB(del, q, tPos);
+      found = WLZ_VTX_3_LENGTH(del) < 1.0e-6;
+    }
+  }
+  return(found);
+}
@@ -44,17 +44,31 @@ static char _WlzTstCMeshTransformObj_c[] = "University of Edinburgh $Id$";
 #include <stdlib.h>
 #include <math.h>
 #include <float.h>
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <Wlz.h>
 
 extern int      getopt(int argc, char * const *argv, const char *optstring);
  
 static WlzErrorNum 		WlzTstCMeshSetDsp(
 				  WlzObject *mObj);
+static WlzErrorNum 		WlzTstCMeshSetDsp2D(
+				  WlzObject *mObj);
 static WlzErrorNum 		WlzTstCMeshSetDsp3D(
 				  WlzObject *mObj);
+static WlzDVertex2 		WlzTstCMeshCompDsp2D(
+				  WlzDBox2 bBox,
+				  WlzDVertex2 pos);
 static WlzDVertex3 		WlzTstCMeshCompDsp3D(
 				  WlzDBox3 bBox,
 				  WlzDVertex3 pos);
+static long			WlzTstCMeshCmpValues(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzErrorNum *dstErr);
+static double			WlzTstCMeshTime(void);
 
 extern char     *optarg;
 extern int      optind,
@@ -64,6 +78,7 @@ extern int      optind,
 int             main(int argc, char **argv)
 {
   int		option,
+  		check = 0,
   		deform = 1,
 		ok = 1,
 		usage = 0;
@@ -82,7 +97,7 @@ int             main(int argc, char **argv)
   		*outObjFileStr,
 		*outVTKFileStr = NULL;
   const char    *errMsg;
-  static char	optList[] = "hIm:M:o:V:",
+  static char	optList[] = "chILm:M:o:V:",
   		inObjFileStrDef[] = "-",
 		outObjFileStrDef[] = "-";
 
@@ -108,9 +123,15 @@ int             main(int argc, char **argv)
       case 'o':
         outObjFileStr = optarg;
 	break;
+      case 'c':
+        check = 1;
+	break;
       case 'I':
         deform = 0;
 	break;
+      case 'L':
+        interp = WLZ_INTERPOLATION_LINEAR;
+	break;
       case 'V':
         outVTKFileStr = optarg;
 	break;
@@ -200,17 +221,56 @@ int             main(int argc, char **argv)
   {
     errNum = WlzTstCMeshSetDsp(mObj);
   }
-  if(ok)
+  if(ok && check)
   {
-    outObj = WlzCMeshTransformObj(inObj, mObj, interp, &errNum);
-    if(errNum != WLZ_ERR_NONE)
+    int		nThr = 1;
+    long	nBad = 0;
+    double	t[2];
+    WlzObject	*sglObj = NULL;
+
+    /* Transform the object using a single thread and then the default
+     * number of threads, the values should be identical. */
+#ifdef _OPENMP
+    nThr = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    t[0] = WlzTstCMeshTime();
+    sglObj = WlzAssignObject(
+	     WlzCMeshTransformObj(inObj, mObj, interp, &errNum), NULL);
+    t[0] = WlzTstCMeshTime() - t[0];
+#ifdef _OPENMP
+    omp_set_num_threads(nThr);
+#endif
+    if(errNum == WLZ_ERR_NONE)
     {
-      ok = 0;
-      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      t[1] = WlzTstCMeshTime();
+      outObj = WlzCMeshTransformObj(inObj, mObj, interp, &errNum);
+      t[1] = WlzTstCMeshTime() - t[1];
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nBad = WlzTstCMeshCmpValues(sglObj, outObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      ok = nBad == 0;
       (void )fprintf(stderr,
-		     "%s: Failed to transform object (%s).\n",
-		     *argv, errMsg);
+		     "%s: 1 thread %gs, %d threads %gs, %ld differences (%s)\n",
+		     *argv, t[0], nThr, t[1], nBad, (ok)? "pass": "FAIL");
     }
+    (void )WlzFreeObj(sglObj);
+  }
+  else if(ok)
+  {
+    outObj = WlzCMeshTransformObj(inObj, mObj, interp, &errNum);
+  }
+  if(ok && (errNum != WLZ_ERR_NONE))
+  {
+    ok = 0;
+    (void )WlzStringFromErrorNum(errNum, &errMsg);
+    (void )fprintf(stderr,
+		   "%s: Failed to transform object (%s).\n",
+		   *argv, errMsg);
   }
   if(ok)
   {
@@ -240,12 +300,16 @@ int             main(int argc, char **argv)
     (void )fprintf(stderr,
     "Usage: %s\n%s",
     *argv,
-    " [-h] [-o<out object>] [-I] [-m #] [-M #] [-V <out VTK file>\n"
-    "                  [<in object>]\n"
+    " [-c] [-h] [-o<out object>] [-I] [-L] [-m #] [-M #]\n"
+    "                  [-V <out VTK file>] [<in object>]\n"
     "Options:\n"
+    "  -c  Check that the values of the transformed object are the same\n"
+    "      using one and then the default number of threads, printing the\n"
+    "      times taken.\n"
     "  -h  Help, prints this usage message.\n"
     "  -o  Output object file name.\n"
     "  -I  Use identity transform, ie displacemets all zero.\n"
+    "  -L  Use linear rather than nearest neighbour interpolation.\n"
     "  -m  Minimum mesh element size.\n"
     "  -M  Maximum mesh element size.\n"
     "  -V  Output VTK mesh file name.\n"
@@ -261,7 +325,7 @@ static WlzErrorNum WlzTstCMeshSetDsp(WlzObject *mObj)
   switch(mObj->type)
   {
     case WLZ_CMESH_2D:
-      errNum = WLZ_ERR_UNIMPLEMENTED;
+      errNum = WlzTstCMeshSetDsp2D(mObj);
       break;
     case WLZ_CMESH_3D:
       errNum = WlzTstCMeshSetDsp3D(mObj);
@@ -273,6 +337,51 @@ static WlzErrorNum WlzTstCMeshSetDsp(WlzObject *mObj)
   return(errNum);
 }
 
+static WlzErrorNum WlzTstCMeshSetDsp2D(WlzObject *mObj)
+{
+  int		idN,
+		nNod,
+		dim = 2;
+  double	*dsp;
+  WlzDVertex2	dspV;
+  WlzDBox2	bBox;
+  AlcVector	*nVec;
+  WlzCMeshNod2D	*nod;
+  WlzCMesh2D	*mesh;
+  WlzValues	values;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  values.x = WlzMakeIndexedValues(mObj, 1, &dim, WLZ_GREY_DOUBLE,
+  				  WLZ_VALUE_ATTACH_NOD, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    mesh = mObj->domain.cm2;
+    bBox = mesh->bBox;
+    nNod = mesh->res.nod.maxEnt;
+    if(WlzIndexedValueExtGet(values.x, nNod) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nVec = mesh->res.nod.vec;
+    mObj->values = WlzAssignValues(values, NULL);
+    for(idN = 0; idN < nNod; ++idN)
+    {
+      nod = (WlzCMeshNod2D *)AlcVectorItemGet(nVec, (size_t )idN);
+      if(nod->idx >= 0)
+      {
+	dsp = (double *)WlzIndexedValueGet(values.x, nod->idx);
+	dspV = WlzTstCMeshCompDsp2D(bBox, nod->pos);
+	dsp[0] = dspV.vtX;
+	dsp[1] = dspV.vtY;
+      }
+    }
+  }
+  return(errNum);
+}
+
 static WlzErrorNum WlzTstCMeshSetDsp3D(WlzObject *mObj)
 {
   int		idN,
@@ -319,6 +428,19 @@ static WlzErrorNum WlzTstCMeshSetDsp3D(WlzObject *mObj)
   return(errNum);
 }
 
+static WlzDVertex2 WlzTstCMeshCompDsp2D(WlzDBox2 bBox, WlzDVertex2 pos)
+{
+  double	x,
+  		y;
+  WlzDVertex2	dsp;
+
+  x = (0.5 * (bBox.xMin + bBox.xMax) - pos.vtX) / (bBox.xMax - bBox.xMin);
+  y = (0.5 * (bBox.yMin + bBox.yMax) - pos.vtY) / (bBox.yMax - bBox.yMin);
+  dsp.vtX = 0.3333 * (bBox.xMax - bBox.xMin) * sin(WLZ_M_PI * x * x);
+  dsp.vtY = 0.3333 * (bBox.yMax - bBox.yMin) * sin(WLZ_M_PI * y * y);
+  return(dsp);
+}
+
 static WlzDVertex3 WlzTstCMeshCompDsp3D(WlzDBox3 bBox, WlzDVertex3 pos)
 {
   double	x,
@@ -334,3 +456,77 @@ static WlzDVertex3 WlzTstCMeshCompDsp3D(WlzDBox3 bBox, WlzDVertex3 pos)
   dsp.vtZ = 0.3333 * (bBox.zMax - bBox.zMin) * sin(WLZ_M_PI * z * z);
   return(dsp);
 }
+
+/* Returns the number of pixels / voxels of the first object at which the
+ * values of the two objects differ. */
+static long	WlzTstCMeshCmpValues(WlzObject *obj0, WlzObject *obj1,
+				     WlzErrorNum *dstErr)
+{
+  long		nBad = 0;
+  WlzIterateWSpace *itWSp = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  itWSp = WlzIterateInit(obj0, WLZ_RASTERDIR_ILIC, 1, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+    {
+      int	same;
+
+      WlzGreyValueGet(gVWSp, itWSp->pos.vtZ, itWSp->pos.vtY,
+		      itWSp->pos.vtX);
+      switch(itWSp->gType)
+      {
+	case WLZ_GREY_INT:
+	  same = *(itWSp->gP.inp) == gVWSp->gVal[0].inv;
+	  break;
+	case WLZ_GREY_SHORT:
+	  same = *(itWSp->gP.shp) == gVWSp->gVal[0].shv;
+	  break;
+	case WLZ_GREY_UBYTE:
+	  same = *(itWSp->gP.ubp) == gVWSp->gVal[0].ubv;
+	  break;
+	case WLZ_GREY_FLOAT:
+	  same = *(itWSp->gP.flp) == gVWSp->gVal[0].flv;
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  same = *(itWSp->gP.dbp) == gVWSp->gVal[0].dbv;
+	  break;
+	case WLZ_GREY_RGBA:
+	  same = *(itWSp->gP.rgbp) == gVWSp->gVal[0].rgbv;
+	  break;
+	default:
+	  same = 0;
+	  break;
+      }
+      if(!same || (gVWSp->gType != itWSp->gType))
+      {
+        ++nBad;
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  WlzIterateWSpFree(itWSp);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nBad);
+}
+
+static double	WlzTstCMeshTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
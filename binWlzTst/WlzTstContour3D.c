@@ -0,0 +1,320 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstContour3D_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstContour3D.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test and benchmark for parallel 3D contour extraction.
+* 		Iso-value or maximal gradient surfaces are computed from a
+* 		synthetic volume using WlzContourObj(), first with a
+* 		single thread and then with the default number of
+* 		threads. The two models are compared vertex by vertex
+* 		and face by face, and the times taken are reported.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstContour3DTime(void);
+static int			WlzTstContour3DCmp(
+				  WlzGMModel *m0,
+				  WlzGMModel *m1);
+static double			WlzTstContour3DSum(
+				  WlzGMModel *model);
+
+int		main(int argc, char *argv[])
+{
+  int		idC,
+  		option,
+		sz = 128,
+		nThr = 1,
+		nBad = 0,
+  		ok = 1,
+  		usage = 0;
+  double	ctrVal = 100.0,
+  		ctrWth = 1.0;
+  double	t[2] = {0.0, 0.0};
+  const char	*errMsgStr;
+  WlzObject	*obj = NULL;
+  WlzContour	*ctr[2] = {NULL, NULL};
+  WlzContourMethod ctrMtd = WLZ_CONTOUR_MTD_ISO;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "ghs:v:w:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'g':
+        ctrMtd = WLZ_CONTOUR_MTD_GRD;
+	ctrVal = 10.0;
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 4);
+	break;
+      case 'v':
+        usage = sscanf(optarg, "%lg", &ctrVal) != 1;
+	break;
+      case 'w':
+        usage = (sscanf(optarg, "%lg", &ctrWth) != 1) || (ctrWth <= 0.0);
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  /* Create a sphere with grey values which vary smoothly with
+   * position, giving many separate surfaces. */
+  if(ok)
+  {
+    WlzValues	val;
+    WlzPixelV	bgdV;
+    WlzObjectType gTType;
+
+    bgdV.type = WLZ_GREY_INT;
+    bgdV.v.inv = 0;
+    obj = WlzAssignObject(
+	  WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, sz / 2, sz / 2, sz / 2,
+			      sz / 2, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gTType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, WLZ_GREY_UBYTE,
+				     NULL);
+      val.vox = WlzNewValuesVox(obj, gTType, bgdV, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzIterateWSpace *itWSp;
+
+      obj->values = WlzAssignValues(val, NULL);
+      itWSp = WlzIterateInit(obj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+	{
+	  *(itWSp->gP.ubp) = (WlzUByte )
+	      WLZ_NINT(100.0 + 80.0 * sin(itWSp->pos.vtX / 7.0) *
+			       cos(itWSp->pos.vtY / 9.0) *
+			       sin(itWSp->pos.vtZ / 11.0));
+	}
+	if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+      }
+      WlzIterateWSpFree(itWSp);
+    }
+  }
+  /* Compute the contours using one and then the default number of
+   * threads. */
+#ifdef _OPENMP
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    nThr = omp_get_max_threads();
+  }
+#endif
+  for(idC = 0; ok && (errNum == WLZ_ERR_NONE) && (idC < 2); ++idC)
+  {
+    double	t0;
+    WlzDomain	dom;
+
+#ifdef _OPENMP
+    omp_set_num_threads((idC == 0)? 1: nThr);
+#endif
+    t0 = WlzTstContour3DTime();
+    dom.ctr = WlzContourObj(obj, ctrMtd, ctrVal, ctrWth, 0, &errNum);
+    ctr[idC] = WlzAssignDomain(dom, NULL).ctr;
+    t[idC] = WlzTstContour3DTime() - t0;
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    nBad = WlzTstContour3DCmp(ctr[0]->model, ctr[1]->model);
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to compute contours (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d vertices, %d faces, sum %.6f, "
+		    "1 thread %gs, %d threads %gs, %d differences (%s)\n",
+		    argv[0], (int )(ctr[0]->model->res.vertex.numElm),
+		    (int )(ctr[0]->model->res.face.numElm),
+		    WlzTstContour3DSum(ctr[0]->model), t[0], nThr, t[1],
+		    nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  (void )WlzFreeContour(ctr[0]);
+  (void )WlzFreeContour(ctr[1]);
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-g] [-h] [-s#] [-v#] [-w#]\n"
+    "Tests and times parallel 3D contour extraction by comparing the\n"
+    "contours computed from a synthetic volume using one and then the\n"
+    "default number of threads.\n"
+    "Options are:\n"
+    "  -g  Maximal gradient instead of iso-value contours.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -s  Volume size (default %d).\n"
+    "  -v  Iso-value or minimum gradient (default %g or %g).\n"
+    "  -w  Gradient filter width parameter (default %g).\n",
+    argv[0], 128, 100.0, 10.0, 1.0);
+  }
+  return(!ok);
+}
+
+static double	WlzTstContour3DTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
+
+/* Compares the vertex positions and face vertices of the two models,
+ * returning the number of differences. */
+static int	WlzTstContour3DCmp(WlzGMModel *m0, WlzGMModel *m1)
+{
+  int		idx,
+  		nBad = 0;
+
+  if((m0->res.vertex.numIdx != m1->res.vertex.numIdx) ||
+     (m0->res.face.numIdx != m1->res.face.numIdx))
+  {
+    ++nBad;
+  }
+  for(idx = 0; (nBad == 0) && (idx < m0->res.vertex.numIdx); ++idx)
+  {
+    WlzGMVertex	*v0,
+    		*v1;
+    WlzDVertex3	p0,
+    		p1;
+
+    v0 = (WlzGMVertex *)AlcVectorItemGet(m0->res.vertex.vec, idx);
+    v1 = (WlzGMVertex *)AlcVectorItemGet(m1->res.vertex.vec, idx);
+    if(v0->idx != v1->idx)
+    {
+      ++nBad;
+    }
+    else if(v0->idx >= 0)
+    {
+      (void )WlzGMVertexGetG3D(v0, &p0);
+      (void )WlzGMVertexGetG3D(v1, &p1);
+      if((p0.vtX != p1.vtX) || (p0.vtY != p1.vtY) || (p0.vtZ != p1.vtZ))
+      {
+        ++nBad;
+      }
+    }
+  }
+  for(idx = 0; (nBad == 0) && (idx < m0->res.face.numIdx); ++idx)
+  {
+    int		idE;
+    WlzGMFace	*f0,
+    		*f1;
+    WlzGMEdgeT	*e0,
+    		*e1;
+
+    f0 = (WlzGMFace *)AlcVectorItemGet(m0->res.face.vec, idx);
+    f1 = (WlzGMFace *)AlcVectorItemGet(m1->res.face.vec, idx);
+    if(f0->idx != f1->idx)
+    {
+      ++nBad;
+    }
+    else if(f0->idx >= 0)
+    {
+      e0 = f0->loopT->edgeT;
+      e1 = f1->loopT->edgeT;
+      for(idE = 0; idE < 3; ++idE)
+      {
+	if(e0->vertexT->diskT->vertex->idx !=
+	   e1->vertexT->diskT->vertex->idx)
+	{
+	  ++nBad;
+	}
+	e0 = e0->next;
+	e1 = e1->next;
+      }
+    }
+  }
+  return(nBad);
+}
+
+/* Returns the sum of the vertex coordinates of the model. */
+static double	WlzTstContour3DSum(WlzGMModel *model)
+{
+  int		idx;
+  double	sum = 0.0;
+
+  for(idx = 0; idx < model->res.vertex.numIdx; ++idx)
+  {
+    WlzGMVertex	*v;
+    WlzDVertex3	p;
+
+    v = (WlzGMVertex *)AlcVectorItemGet(model->res.vertex.vec, idx);
+    if(v->idx >= 0)
+    {
+      (void )WlzGMVertexGetG3D(v, &p);
+      sum += p.vtX + p.vtY + p.vtZ;
+    }
+  }
+  return(sum);
+}
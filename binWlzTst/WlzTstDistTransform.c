@@ -0,0 +1,263 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstDistTransform_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstDistTransform.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the exact Euclidean distance transform which compares
+* 		the distances computed by WlzDistanceTransform() with those
+* 		found by brute force search of the reference domain.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+  		dim = 2,
+		nRef = 0,
+  		ok = 1,
+  		usage = 0;
+  double	rad = 20.0,
+  		refRad = 3.0,
+		vSzZ = 1.0,
+		maxErr = 0.0;
+  const char	*errMsgStr;
+  WlzIVertex3	*refVtx = NULL;
+  WlzObject	*forObj = NULL,
+  		*refObj = NULL,
+		*dstObj = NULL;
+  WlzIterateWSpace *itWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "23hr:R:z:";
+  const double	tol = 1.0e-3;
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case '2':
+        dim = 2;
+	break;
+      case '3':
+        dim = 3;
+	break;
+      case 'r':
+        usage = (sscanf(optarg, "%lg", &rad) != 1) || (rad < 1.0);
+	break;
+      case 'R':
+        usage = (sscanf(optarg, "%lg", &refRad) != 1) || (refRad < 0.0);
+	break;
+      case 'z':
+        usage = (sscanf(optarg, "%lg", &vSzZ) != 1) || (vSzZ <= 0.0);
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  /* Create a spherical foreground object and a reference object which
+   * is the union of small spheres: two off centre within the foreground
+   * object and one beyond it, all centred on the same column so that
+   * the columns of the reference object have several runs. */
+  if(ok)
+  {
+    int		idS;
+    WlzObjectType oType;
+    WlzObject	*sObj[3];
+
+    oType = (dim == 2)? WLZ_2D_DOMAINOBJ: WLZ_3D_DOMAINOBJ;
+    forObj = WlzAssignObject(
+             WlzMakeSphereObject(oType, rad, 0.0, 0.0, 0.0, &errNum), NULL);
+    for(idS = 0; idS < 3; ++idS)
+    {
+      sObj[idS] = NULL;
+    }
+    for(idS = 0; (errNum == WLZ_ERR_NONE) && (idS < 3); ++idS)
+    {
+      double	cZ;
+      const double cZ3[3] = {1.0 / 7.0, -1.0 / 2.0, 1.0};
+
+      cZ = rad * cZ3[idS] + ((idS == 2)? refRad + 2.0: 0.0);
+      sObj[idS] = WlzAssignObject(
+      		  WlzMakeSphereObject(oType, refRad, rad / 3.0,
+		  		      (dim == 2)? cZ: rad / 5.0,
+				      (dim == 2)? 0.0: cZ, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      refObj = WlzAssignObject(WlzUnionN(3, sObj, 0, &errNum), NULL);
+    }
+    for(idS = 0; idS < 3; ++idS)
+    {
+      (void )WlzFreeObj(sObj[idS]);
+    }
+    if((errNum == WLZ_ERR_NONE) && (dim == 3))
+    {
+      forObj->domain.p->voxel_size[2] = vSzZ;
+    }
+  }
+  /* Collect the reference object's voxels. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    nRef = (int )WlzVolume(refObj, &errNum);
+    if((errNum == WLZ_ERR_NONE) &&
+       ((refVtx = (WlzIVertex3 *)
+                  AlcMalloc(nRef * sizeof(WlzIVertex3))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      itWSp = WlzIterateInit(refObj, WLZ_RASTERDIR_ILIC, 0, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	idR = 0;
+
+      while((idR < nRef) && ((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE))
+      {
+        refVtx[idR++] = itWSp->pos;
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+        errNum = WLZ_ERR_NONE;
+      }
+    }
+    WlzIterateWSpFree(itWSp);
+    itWSp = NULL;
+  }
+  /* Compute the distance transform. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    dstObj = WlzAssignObject(
+             WlzDistanceTransform(forObj, refObj, WLZ_EUCLIDEAN_DISTANCE,
+	                          0.0, 0.0, &errNum), NULL);
+  }
+  /* Compare the computed distances with brute force distances. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    itWSp = WlzIterateInit(dstObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+      {
+        int	idR;
+	double	d,
+		dMin = DBL_MAX;
+
+	for(idR = 0; idR < nRef; ++idR)
+	{
+	  double dx,
+	  	 dy,
+		 dz;
+
+	  dx = itWSp->pos.vtX - refVtx[idR].vtX;
+	  dy = itWSp->pos.vtY - refVtx[idR].vtY;
+	  dz = vSzZ * (itWSp->pos.vtZ - refVtx[idR].vtZ);
+	  d = (dx * dx) + (dy * dy) + (dz * dz);
+	  if(d < dMin)
+	  {
+	    dMin = d;
+	  }
+	}
+	d = fabs(sqrt(dMin) - *(itWSp->gP.flp));
+	if(d > maxErr)
+	{
+	  maxErr = d;
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+        errNum = WLZ_ERR_NONE;
+      }
+    }
+    WlzIterateWSpFree(itWSp);
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to compute distance transform (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = maxErr < tol;
+      (void )printf("%s: maximum error %g (%s)\n",
+                    argv[0], maxErr, (ok)? "pass": "FAIL");
+    }
+  }
+  AlcFree(refVtx);
+  (void )WlzFreeObj(dstObj);
+  (void )WlzFreeObj(refObj);
+  (void )WlzFreeObj(forObj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-2] [-3] [-h] [-r#] [-R#] [-z#]\n"
+    "Tests the exact Euclidean distance transform by comparing distances\n"
+    "from small spheres, within and beyond a larger sphere, with brute force\n"
+    "distances.\n"
+    "Options are:\n"
+    "  -2  2D objects (default).\n"
+    "  -3  3D objects.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -r  Foreground sphere radius (default %g).\n"
+    "  -R  Reference spheres radius (default %g).\n"
+    "  -z  Voxel size in z for 3D objects (default %g).\n",
+    argv[0], 20.0, 3.0, 1.0);
+  }
+  return(!ok);
+}
@@ -0,0 +1,576 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstEncodedValues_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstEncodedValues.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test and benchmark for encoded value tables. Synthetic
+* 		2D and 3D objects with irregular and rectangular domains
+* 		and values of each grey type (and tiled 3D values) are
+* 		written and read back using each value encoding and
+* 		compared with the original objects. The tiled values are
+* 		also read back with a small page cache, which should read
+* 		(and decode) only the tiles which are accessed.
+* 		The file sizes and times to write and read a larger 3D
+* 		object are then reported for each encoding.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstEncodedValuesTime(void);
+static int			WlzTstEncodedValuesCmp(
+				  WlzObject *o0,
+				  WlzObject *o1,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstEncodedValuesRW(
+				  WlzObject *obj,
+				  WlzValueEncoding enc,
+				  size_t cacheSz,
+				  long *dstSz,
+				  double *dstT,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstEncodedValuesMakeObj(
+				  WlzObjectType oType,
+				  WlzGreyType gType,
+				  int shape,
+				  int sz,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idS,
+  		option,
+		sz = 48,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  const char	*errMsgStr;
+  const char	*encStr[3] = {"none", "rle", "zlib"};
+  const WlzValueEncoding encs[3] = {WLZ_VALUE_ENCODING_NONE,
+				    WLZ_VALUE_ENCODING_RLE,
+				    WLZ_VALUE_ENCODING_ZLIB};
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvs:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 8);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  /* Round trip 2D and 3D objects with irregular domains, 2D objects with
+   * rectangular domains and 3D objects with tiled values, for each grey
+   * type and encoding. */
+  for(idS = 0; ok && (errNum == WLZ_ERR_NONE) && (idS < 4); ++idS)
+  {
+    int		idG;
+    const char	*shapeStr[4] = {"2D", "3D", "2D rect", "3D tiled"};
+    const WlzGreyType gTypes[6] = {WLZ_GREY_UBYTE, WLZ_GREY_SHORT,
+                                   WLZ_GREY_INT, WLZ_GREY_FLOAT,
+				   WLZ_GREY_DOUBLE, WLZ_GREY_RGBA};
+
+    for(idG = 0; (errNum == WLZ_ERR_NONE) && (idG < 6); ++idG)
+    {
+      int	idE;
+      WlzObject	*obj;
+
+      if((idS == 3) && (gTypes[idG] == WLZ_GREY_RGBA))
+      {
+        continue;
+      }
+      obj = WlzAssignObject(
+            WlzTstEncodedValuesMakeObj(
+	        ((idS % 2) == 0)? WLZ_2D_DOMAINOBJ: WLZ_3D_DOMAINOBJ,
+	        gTypes[idG], idS / 2, ((idS % 2) == 0)? 4 * sz: sz,
+		&errNum), NULL);
+      for(idE = 0; (errNum == WLZ_ERR_NONE) && (idE < 3); ++idE)
+      {
+	int	bad = 0;
+	long	fSz = 0;
+	double	t[2];
+	WlzObject *rObj;
+
+	rObj = WlzTstEncodedValuesRW(obj, encs[idE], 0, &fSz, t, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  bad = WlzTstEncodedValuesCmp(obj, rObj, &errNum);
+	  nBad += bad;
+	}
+	if(verbose && (errNum == WLZ_ERR_NONE))
+	{
+	  (void )printf("%s %s %s %ld bytes %s\n",
+	                shapeStr[idS], WlzStringFromGreyType(gTypes[idG], NULL),
+			encStr[idE], fSz, (bad)? "DIFFERENT": "same");
+	}
+	(void )WlzFreeObj(rObj);
+	/* Read tiled values with a page cache (of the minimum number of
+	 * pages), no tiles should be read until they are accessed. */
+	if((errNum == WLZ_ERR_NONE) && (idS == 3))
+	{
+	  size_t nRead[2] = {0, 0};
+
+	  rObj = WlzTstEncodedValuesRW(obj, encs[idE], 1, &fSz, t, &errNum);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    if(rObj->values.t->pager == NULL)
+	    {
+	      bad = 1;
+	    }
+	    else
+	    {
+	      nRead[0] = rObj->values.t->pager->nRead;
+	      bad = WlzTstEncodedValuesCmp(obj, rObj, &errNum);
+	      nRead[1] = rObj->values.t->pager->nRead;
+	      bad = bad || (nRead[0] != 0) || (nRead[1] == 0);
+	    }
+	    nBad += bad;
+	  }
+	  if(verbose && (errNum == WLZ_ERR_NONE))
+	  {
+	    (void )printf("%s %s %s paged %lu reads of %lu tiles %s\n",
+			  shapeStr[idS],
+			  WlzStringFromGreyType(gTypes[idG], NULL),
+			  encStr[idE], (unsigned long )(nRead[1]),
+			  (unsigned long )(rObj->values.t->numTiles),
+			  (bad)? "DIFFERENT": "same");
+	  }
+	  (void )WlzFreeObj(rObj);
+	}
+      }
+      (void )WlzFreeObj(obj);
+    }
+  }
+  /* Report the file size and times for a larger 3D object. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    int		idE;
+    WlzObject	*obj;
+
+    obj = WlzAssignObject(
+          WlzTstEncodedValuesMakeObj(WLZ_3D_DOMAINOBJ, WLZ_GREY_SHORT, 0,
+	                             4 * sz, &errNum), NULL);
+    for(idE = 0; (errNum == WLZ_ERR_NONE) && (idE < 3); ++idE)
+    {
+      long	fSz = 0;
+      double	t[2];
+      WlzObject	*rObj;
+
+      rObj = WlzTstEncodedValuesRW(obj, encs[idE], 0, &fSz, t, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	nBad += WlzTstEncodedValuesCmp(obj, rObj, &errNum);
+	(void )printf("%s: encoding %s %ld bytes, write %gs, read %gs\n",
+		      argv[0], encStr[idE], fSz, t[0], t[1]);
+      }
+      (void )WlzFreeObj(rObj);
+    }
+    (void )WlzFreeObj(obj);
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to write or read encoded values (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d differences (%s)\n",
+		    argv[0], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-s#]\n"
+    "Tests encoded value tables by writing and reading objects, with\n"
+    "values which are partly constant over shells and partly random,\n"
+    "using each encoding and comparing them with the originals. The file\n"
+    "size and times for each encoding are then reported.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, reporting each test object.\n"
+    "  -s  Width of the 3D test objects in pixels, the 2D objects and the\n"
+    "      timed object are 4 times as wide (default %d).\n",
+    argv[0], 48);
+  }
+  return(!ok);
+}
+
+static double	WlzTstEncodedValuesTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
+
+/* Returns zero if the two objects have the same domain, background and
+ * values, otherwise one. */
+static int	WlzTstEncodedValuesCmp(WlzObject *o0, WlzObject *o1,
+				       WlzErrorNum *dstErr)
+{
+  int		same = 1;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzPixelV	b0,
+  		b1;
+  WlzIBox3	x0,
+  		x1;
+  WlzIterateWSpace *it0 = NULL,
+  		*it1 = NULL;
+  WlzGreyValueWSpace *gVWSp[2] = {NULL, NULL};
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((o0 == NULL) || (o1 == NULL) || (o1->values.core == NULL) ||
+     (o0->type != o1->type) ||
+     (WlzVolume(o0, NULL) != WlzVolume(o1, NULL)))
+  {
+    same = 0;
+  }
+  if(same)
+  {
+    x0 = WlzBoundingBox3I(o0, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      x1 = WlzBoundingBox3I(o1, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      b0 = WlzGetBackground(o0, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      b1 = WlzGetBackground(o1, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gType = WlzGreyTypeFromObj(o0, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzValueConvertPixel(&b0, b0, gType);
+      (void )WlzValueConvertPixel(&b1, b1, gType);
+      same = (memcmp(&(b0.v), &(b1.v), WlzGreySize(gType)) == 0) &&
+	     (x0.xMin == x1.xMin) && (x0.xMax == x1.xMax) &&
+	     (x0.yMin == x1.yMin) && (x0.yMax == x1.yMax) &&
+	     (x0.zMin == x1.zMin) && (x0.zMax == x1.zMax);
+    }
+  }
+  /* Iterate through the domains, which may have tiled values, getting
+   * the grey values at each position. */
+  if(same && (errNum == WLZ_ERR_NONE))
+  {
+    it0 = WlzIterateInit(o0, WLZ_RASTERDIR_ILIC, 0, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      it1 = WlzIterateInit(o1, WLZ_RASTERDIR_ILIC, 0, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gVWSp[0] = WlzGreyValueMakeWSp(o0, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gVWSp[1] = WlzGreyValueMakeWSp(o1, &errNum);
+    }
+  }
+  if(same && (errNum == WLZ_ERR_NONE))
+  {
+    size_t	gSz;
+
+    gSz = WlzGreySize(gType);
+    while(same && ((errNum = WlzIterate(it0)) == WLZ_ERR_NONE))
+    {
+      if(((errNum = WlzIterate(it1)) != WLZ_ERR_NONE) ||
+	 (it0->pos.vtX != it1->pos.vtX) ||
+	 (it0->pos.vtY != it1->pos.vtY) ||
+	 (it0->pos.vtZ != it1->pos.vtZ))
+      {
+        same = 0;
+      }
+      else
+      {
+	WlzGreyValueGet(gVWSp[0], it0->pos.vtZ, it0->pos.vtY, it0->pos.vtX);
+	WlzGreyValueGet(gVWSp[1], it1->pos.vtZ, it1->pos.vtY, it1->pos.vtX);
+	same = (gVWSp[0]->gType == gVWSp[1]->gType) &&
+	       (memcmp(&(gVWSp[0]->gVal[0]), &(gVWSp[1]->gVal[0]), gSz) == 0);
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+      same = same && (WlzIterate(it1) == WLZ_ERR_EOO);
+    }
+    else if(same == 0)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  WlzIterateWSpFree(it0);
+  WlzIterateWSpFree(it1);
+  WlzGreyValueFreeWSp(gVWSp[0]);
+  WlzGreyValueFreeWSp(gVWSp[1]);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(!same);
+}
+
+/* Writes the object to a temporary file using the given encoding and
+ * reads it back using the given page cache size for tiled values,
+ * setting the file size and the write and read times. */
+static WlzObject *WlzTstEncodedValuesRW(WlzObject *obj, WlzValueEncoding enc,
+				       size_t cacheSz, long *dstSz,
+				       double *dstT, WlzErrorNum *dstErr)
+{
+  FILE		*fP;
+  double	t0;
+  WlzObject	*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  WlzEncodedValuesSetType(enc);
+  if((fP = tmpfile()) == NULL)
+  {
+    errNum = WLZ_ERR_FILE_OPEN;
+  }
+  else
+  {
+    t0 = WlzTstEncodedValuesTime();
+    errNum = WlzWriteObj(fP, obj);
+    (void )fflush(fP);
+    dstT[0] = WlzTstEncodedValuesTime() - t0;
+    *dstSz = ftell(fP);
+    rewind(fP);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzTiledValuesSetPageCacheSz(cacheSz);
+      t0 = WlzTstEncodedValuesTime();
+      rObj = WlzAssignObject(WlzReadObj(fP, &errNum), NULL);
+      dstT[1] = WlzTstEncodedValuesTime() - t0;
+      WlzTiledValuesSetPageCacheSz(0);
+    }
+    (void )fclose(fP);
+  }
+  WlzEncodedValuesSetType(WLZ_VALUE_ENCODING_NONE);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/* Makes a test object with values which suit the encodings, being
+ * constant over concentric shells (long runs) for x below the centre and
+ * random (literals) above it. Shape 0 is a disc or ball with an off
+ * centre hole, so that lines have more than one interval, shape 1 is a
+ * rectangle in 2D or has tiled values in 3D. */
+static WlzObject *WlzTstEncodedValuesMakeObj(WlzObjectType oType,
+					     WlzGreyType gType, int shape,
+					     int sz, WlzErrorNum *dstErr)
+{
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzPixelV	bgdV;
+  WlzObject	*obj = NULL,
+		*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgdV.type = WLZ_GREY_INT;
+  bgdV.v.inv = 7;
+  val.core = NULL;
+  if((shape == 1) && (oType == WLZ_2D_DOMAINOBJ))
+  {
+    dom.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_RECT,
+                                  -3, sz - 4, 5, sz + sz / 3, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj = WlzAssignObject(
+	    WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum),
+	    NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      val.v = WlzNewValueTb(obj,
+                 WlzGreyValueTableType(0, WLZ_GREY_TAB_RECT, gType, NULL),
+		 bgdV, &errNum);
+    }
+  }
+  else
+  {
+    WlzObjectType gTType;
+    WlzObject	*bObj[2] = {NULL, NULL};
+
+    bObj[0] = WlzAssignObject(
+	      WlzMakeSphereObject(oType, sz / 2, sz / 2, sz / 2, sz / 2 + 3,
+				  &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bObj[1] = WlzAssignObject(
+		WlzMakeSphereObject(oType, sz / 5, sz / 2 + sz / 6, sz / 2,
+				    sz / 2 + 3, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj = WlzAssignObject(WlzDiffDomain(bObj[0], bObj[1], &errNum), NULL);
+    }
+    (void )WlzFreeObj(bObj[0]);
+    (void )WlzFreeObj(bObj[1]);
+    gTType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(oType == WLZ_2D_DOMAINOBJ)
+      {
+	val.v = WlzNewValueTb(obj, gTType, bgdV, &errNum);
+      }
+      else
+      {
+	val.vox = WlzNewValuesVox(obj, gTType, bgdV, &errNum);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzIterateWSpace *itWSp;
+
+    obj->values = WlzAssignValues(val, NULL);
+    itWSp = WlzIterateInit(obj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      AlgRandSeed(sz);
+      while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+      {
+	double	v;
+
+	if(itWSp->pos.vtX < sz / 2)
+	{
+	  WlzDVertex3 d;
+
+	  d.vtX = itWSp->pos.vtX - sz / 2;
+	  d.vtY = itWSp->pos.vtY - sz / 2;
+	  d.vtZ = (oType == WLZ_2D_DOMAINOBJ)? 0.0:
+		  itWSp->pos.vtZ - (sz / 2 + 3);
+	  v = 20.0 + 15.0 * floor(WLZ_VTX_3_LENGTH(d) / 4.0);
+	}
+	else
+	{
+	  v = 200.0 * AlgRandUniform();
+	}
+	switch(gType)
+	{
+	  case WLZ_GREY_UBYTE:
+	    *(itWSp->gP.ubp) = (WlzUByte )WLZ_NINT(v);
+	    break;
+	  case WLZ_GREY_SHORT:
+	    *(itWSp->gP.shp) = (short )WLZ_NINT(v * 40.0 - 2000.0);
+	    break;
+	  case WLZ_GREY_INT:
+	    *(itWSp->gP.inp) = WLZ_NINT(v * 1000.0);
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    *(itWSp->gP.flp) = (float )v;
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    *(itWSp->gP.dbp) = v + 1.0e-3 * itWSp->pos.vtX;
+	    break;
+	  case WLZ_GREY_RGBA:
+	    {
+	      int	c;
+
+	      c = WLZ_NINT(v * 0.5);
+	      WLZ_RGBA_RGBA_SET(*(itWSp->gP.rgbp), c, 255 - c, c / 2, 255);
+	    }
+	    break;
+	  default:
+	    break;
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+    }
+    WlzIterateWSpFree(itWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((shape == 1) && (oType == WLZ_3D_DOMAINOBJ))
+    {
+      rObj = WlzMakeTiledValuesFromObj(obj, 4096, 1, gType, 0, NULL, bgdV,
+				       &errNum);
+    }
+    else
+    {
+      rObj = WlzMakeMain(obj->type, obj->domain, obj->values, NULL, NULL,
+                         &errNum);
+    }
+  }
+  (void )WlzFreeObj(obj);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
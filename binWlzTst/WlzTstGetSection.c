@@ -0,0 +1,489 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstGetSection_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstGetSection.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test and benchmark for section extraction. Sections are cut
+* 		from a synthetic volume at a sequence of view angles and
+* 		distances, as by Wlz3DGetSection, using
+* 		WlzGetSectionFromObject(). Each section is compared with
+* 		values found using WlzGreyValueGet() or WlzGreyValueGetCon()
+* 		for each pixel in turn, and the times taken by both are
+* 		reported. Sections may also be cut concurrently using a
+* 		section server.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstGetSectionTime(void);
+static WlzUInt			WlzTstGetSectionRef(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzInterpolationType interp,
+				  WlzDVertex3 p);
+static WlzUInt			WlzTstGetSectionVal(
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  size_t off);
+
+int		main(int argc, char *argv[])
+{
+  int		idS,
+  		option,
+		nSec = 20,
+		sz = 256,
+		sphere = 0,
+		useSrv = 0,
+		nBad = 0,
+  		ok = 1,
+  		usage = 0;
+  double	t0 = 0.0,
+  		t1 = 0.0,
+		t2;
+  const char	*errMsgStr;
+  WlzObject	*obj = NULL;
+  WlzObject	**sec = NULL;
+  WlzGreyType	gType = WLZ_GREY_UBYTE;
+  WlzSectionServer *srv = NULL;
+  WlzThreeDViewStruct **view = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzInterpolationType interp = WLZ_INTERPOLATION_NEAREST;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "chlSg:n:s:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'g':
+        switch(*optarg)
+	{
+	  case 'u':
+	    gType = WLZ_GREY_UBYTE;
+	    break;
+	  case 's':
+	    gType = WLZ_GREY_SHORT;
+	    break;
+	  case 'r':
+	    gType = WLZ_GREY_RGBA;
+	    break;
+	  default:
+	    usage = 1;
+	    break;
+	}
+	break;
+      case 'c':
+        useSrv = 1;
+	break;
+      case 'l':
+        interp = WLZ_INTERPOLATION_LINEAR;
+	break;
+      case 'n':
+        usage = (sscanf(optarg, "%d", &nSec) != 1) || (nSec < 1);
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 4);
+	break;
+      case 'S':
+        sphere = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  /* Create either a cuboid, which has rectangular domains and values,
+   * or a sphere, with grey values which vary with position. */
+  if(ok)
+  {
+    WlzPixelV	bgdV;
+
+    bgdV.type = WLZ_GREY_INT;
+    bgdV.v.inv = 7;
+    if(sphere)
+    {
+      WlzValues	val;
+      WlzObjectType gTType;
+
+      obj = WlzAssignObject(
+            WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, sz / 2, sz / 2, sz / 2,
+	                        sz / 2, &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        gTType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, NULL);
+	val.vox = WlzNewValuesVox(obj, gTType, bgdV, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	obj->values = WlzAssignValues(val, NULL);
+      }
+    }
+    else
+    {
+      obj = WlzAssignObject(
+            WlzMakeCuboid(0, sz - 1, 0, sz - 1, 0, sz - 1, gType, bgdV,
+	                  NULL, NULL, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzIterateWSpace *itWSp;
+
+      itWSp = WlzIterateInit(obj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+	{
+	  int	v;
+
+	  v = (3 * itWSp->pos.vtX) + (5 * itWSp->pos.vtY) +
+	      (11 * itWSp->pos.vtZ) +
+	      ((itWSp->pos.vtX * itWSp->pos.vtY) % 13);
+	  switch(gType)
+	  {
+	    case WLZ_GREY_UBYTE:
+	      *(itWSp->gP.ubp) = v & 0xff;
+	      break;
+	    case WLZ_GREY_SHORT:
+	      *(itWSp->gP.shp) = v - 4000;
+	      break;
+	    default: /* WLZ_GREY_RGBA */
+	      WLZ_RGBA_RGBA_SET(*(itWSp->gP.rgbp), v & 0xff, (v >> 2) & 0xff,
+	                        (v >> 4) & 0xff, 255);
+	      break;
+	  }
+	}
+	if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+      }
+      WlzIterateWSpFree(itWSp);
+    }
+  }
+  /* Make views at a sequence of angles and distances. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    if(((view = (WlzThreeDViewStruct **)
+                AlcCalloc(nSec, sizeof(WlzThreeDViewStruct *))) == NULL) ||
+       ((sec = (WlzObject **)AlcCalloc(nSec, sizeof(WlzObject *))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  for(idS = 0; ok && (errNum == WLZ_ERR_NONE) && (idS < nSec); ++idS)
+  {
+    view[idS] = WlzMake3DViewStruct(WLZ_3D_VIEW_STRUCT, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      view[idS]->theta = (37.0 * idS) * WLZ_M_PI / 180.0;
+      view[idS]->phi = (23.0 * idS) * WLZ_M_PI / 180.0;
+      view[idS]->zeta = 0.0;
+      view[idS]->dist = (idS % 5) * 0.1 * sz / 4;
+      view[idS]->fixed.vtX = view[idS]->fixed.vtY =
+                             view[idS]->fixed.vtZ = 0.5 * sz;
+      view[idS]->view_mode = WLZ_UP_IS_UP_MODE;
+      view[idS]->up.vtX = view[idS]->up.vtY = 0.0;
+      view[idS]->up.vtZ = -1.0;
+      view[idS]->scale = 1.0;
+      errNum = WlzInit3DViewStruct(view[idS], obj);
+    }
+  }
+  /* Cut the sections, either one after another or concurrently using
+   * a section server. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    t0 = WlzTstGetSectionTime();
+    if(useSrv)
+    {
+      srv = WlzMakeSectionServer(obj, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for(idS = 0; idS < nSec; ++idS)
+	{
+	  WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	  sec[idS] = WlzAssignObject(
+		     WlzGetSubSectionFromServer(srv, NULL, view[idS], interp,
+						NULL, &errNum2), NULL);
+	  if(errNum2 != WLZ_ERR_NONE)
+	  {
+#ifdef _OPENMP
+#pragma omp critical (WlzTstGetSection)
+#endif
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+    }
+    else
+    {
+      for(idS = 0; (errNum == WLZ_ERR_NONE) && (idS < nSec); ++idS)
+      {
+	sec[idS] = WlzAssignObject(
+		   WlzGetSectionFromObject(obj, view[idS], interp, &errNum),
+		   NULL);
+      }
+    }
+    t1 = WlzTstGetSectionTime();
+  }
+  /* Check each section against the values found for each pixel in
+   * turn. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  for(idS = 0; ok && (errNum == WLZ_ERR_NONE) && (idS < nSec); ++idS)
+  {
+    int		k,
+		l,
+		xOff,
+		yOff;
+    WlzRectValues *rVal;
+    WlzIntervalDomain *iDom;
+
+    iDom = sec[idS]->domain.i;
+    rVal = sec[idS]->values.r;
+    xOff = WLZ_NINT(view[idS]->minvals.vtX);
+    yOff = WLZ_NINT(view[idS]->minvals.vtY);
+    for(l = iDom->line1; l <= iDom->lastln; ++l)
+    {
+      for(k = iDom->kol1; k <= iDom->lastkl; ++k)
+      {
+	size_t	off;
+	WlzUInt	v;
+	WlzDVertex3	p;
+
+	p.vtX = view[idS]->xp_to_x[k - xOff] + view[idS]->yp_to_x[l - yOff];
+	p.vtY = view[idS]->xp_to_y[k - xOff] + view[idS]->yp_to_y[l - yOff];
+	p.vtZ = view[idS]->xp_to_z[k - xOff] + view[idS]->yp_to_z[l - yOff];
+	v = WlzTstGetSectionRef(gVWSp, interp, p);
+	off = ((size_t )(l - rVal->line1) * rVal->width) + k - rVal->kol1;
+	if(v != WlzTstGetSectionVal(rVal->values, gType, off))
+	{
+	  ++nBad;
+	}
+      }
+    }
+  }
+  t2 = WlzTstGetSectionTime();
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to get sections (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d sections %gs%s, per pixel reference %gs, "
+                    "%d differences (%s)\n",
+                    argv[0], nSec, t1 - t0, (useSrv)? " (server)": "",
+		    t2 - t1, nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(view)
+  {
+    for(idS = 0; idS < nSec; ++idS)
+    {
+      (void )WlzFree3DViewStruct(view[idS]);
+    }
+    AlcFree(view);
+  }
+  if(sec)
+  {
+    for(idS = 0; idS < nSec; ++idS)
+    {
+      (void )WlzFreeObj(sec[idS]);
+    }
+    AlcFree(sec);
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  (void )WlzFreeSectionServer(srv);
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-c] [-h] [-l] [-S] [-g<u|s|r>] [-n#] [-s#]\n"
+    "Tests and times section extraction by comparing sections cut from\n"
+    "a synthetic volume with the values found for each pixel in turn.\n"
+    "Options are:\n"
+    "  -c  Cut the sections concurrently using a section server.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -l  Use linear interpolation instead of nearest neighbour.\n"
+    "  -S  Use a sphere (interval domains) instead of a cuboid.\n"
+    "  -g  Grey type: u ubyte (default), s short or r RGBA.\n"
+    "  -n  Number of sections (default %d).\n"
+    "  -s  Volume size (default %d).\n",
+    argv[0], 20, 256);
+  }
+  return(!ok);
+}
+
+static double	WlzTstGetSectionTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
+
+/* Returns the given value as an unsigned integer for comparison. */
+static WlzUInt	WlzTstGetSectionVal(WlzGreyP gP, WlzGreyType gType,
+				    size_t off)
+{
+  WlzUInt	v;
+
+  switch(gType)
+  {
+    case WLZ_GREY_UBYTE:
+      v = gP.ubp[off];
+      break;
+    case WLZ_GREY_SHORT:
+      v = (WlzUInt )(gP.shp[off]);
+      break;
+    default: /* WLZ_GREY_RGBA */
+      v = gP.rgbp[off];
+      break;
+  }
+  return(v);
+}
+
+/* Computes the value at the given position using the grey value
+ * workspace, as the section functions did before direct access. */
+static WlzUInt	WlzTstGetSectionRef(WlzGreyValueWSpace *gVWSp,
+				    WlzInterpolationType interp,
+				    WlzDVertex3 p)
+{
+  WlzUInt	v;
+
+  if(interp == WLZ_INTERPOLATION_NEAREST)
+  {
+    WlzGreyP	gP;
+
+    WlzGreyValueGet(gVWSp, WLZ_NINT(p.vtZ), WLZ_NINT(p.vtY),
+                    WLZ_NINT(p.vtX));
+    gP.v = gVWSp->gVal;
+    v = WlzTstGetSectionVal(gP, gVWSp->gType, 0);
+  }
+  else
+  {
+    int		idC,
+    		idN,
+		nC;
+    double	w;
+    double	c[4];
+    WlzDVertex3 f,
+		t;
+
+    f.vtX = WLZ_NINT(p.vtX - 0.5);
+    f.vtY = WLZ_NINT(p.vtY - 0.5);
+    f.vtZ = WLZ_NINT(p.vtZ - 0.5);
+    t.vtX = p.vtX - f.vtX;
+    t.vtY = p.vtY - f.vtY;
+    t.vtZ = p.vtZ - f.vtZ;
+    WlzGreyValueGetCon(gVWSp, f.vtZ, f.vtY, f.vtX);
+    nC = (gVWSp->gType == WLZ_GREY_RGBA)? 4: 1;
+    c[0] = c[1] = c[2] = c[3] = 0.0;
+    for(idN = 0; idN < 8; ++idN)
+    {
+      w = ((idN & 1)? t.vtX: 1.0 - t.vtX) *
+	  ((idN & 2)? t.vtY: 1.0 - t.vtY) *
+	  ((idN & 4)? t.vtZ: 1.0 - t.vtZ);
+      switch(gVWSp->gType)
+      {
+	case WLZ_GREY_UBYTE:
+	  c[0] += w * gVWSp->gVal[idN].ubv;
+	  break;
+	case WLZ_GREY_SHORT:
+	  c[0] += w * gVWSp->gVal[idN].shv;
+	  break;
+	default: /* WLZ_GREY_RGBA */
+	  c[0] += w * WLZ_RGBA_RED_GET(gVWSp->gVal[idN].rgbv);
+	  c[1] += w * WLZ_RGBA_GREEN_GET(gVWSp->gVal[idN].rgbv);
+	  c[2] += w * WLZ_RGBA_BLUE_GET(gVWSp->gVal[idN].rgbv);
+	  c[3] += w * WLZ_RGBA_ALPHA_GET(gVWSp->gVal[idN].rgbv);
+	  break;
+      }
+    }
+    for(idC = 0; idC < nC; ++idC)
+    {
+      c[idC] = (gVWSp->gType == WLZ_GREY_SHORT)?
+               WLZ_CLAMP(c[idC], SHRT_MIN, SHRT_MAX):
+               WLZ_CLAMP(c[idC], 0, 255);
+      c[idC] = WLZ_NINT(c[idC]);
+    }
+    switch(gVWSp->gType)
+    {
+      case WLZ_GREY_UBYTE:
+        v = (WlzUInt )(c[0]);
+	break;
+      case WLZ_GREY_SHORT:
+        v = (WlzUInt )((short )(c[0]));
+	break;
+      default: /* WLZ_GREY_RGBA */
+	WLZ_RGBA_RGBA_SET(v, (WlzUInt )(c[0]), (WlzUInt )(c[1]),
+			  (WlzUInt )(c[2]), (WlzUInt )(c[3]));
+        break;
+    }
+  }
+  return(v);
+}
@@ -0,0 +1,602 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstGreyScanPar_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstGreyScanPar.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test and benchmark for the parallel grey value scans.
+* 		Synthetic 2D and 3D objects with irregular domains and
+* 		values of each grey type (and tiled 3D values) are used
+* 		to compare WlzGreyStatsPar(), WlzHistogramObjPar() and
+* 		WlzThresholdPar() with WlzGreyStats(), WlzHistogramObj()
+* 		and WlzThreshold() and the fused WlzGreyScanPar() with
+* 		the separate parallel functions. The serial and parallel
+* 		functions are then timed using a larger 3D object.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstGreyScanParTime(void);
+static int			WlzTstGreyScanParCmpDom(
+				  WlzObject *o0,
+				  WlzObject *o1);
+static int			WlzTstGreyScanParCmpHist(
+				  WlzObject *h0,
+				  WlzObject *h1);
+static int			WlzTstGreyScanParCmpD(
+				  double d0,
+				  double d1);
+static int			WlzTstGreyScanParObj(
+				  WlzObject *obj,
+				  const char *name,
+				  int verbose,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstGreyScanParMakeObj(
+				  WlzObjectType oType,
+				  WlzGreyType gType,
+				  int tiled,
+				  int sz,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idD,
+  		option,
+		sz = 48,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  double	t[3] = {0.0, 0.0, 0.0};
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvs:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 8);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  /* Compare the parallel and serial functions for 2D and 3D objects
+   * with each grey type, with and without tiled values in 3D. */
+  for(idD = 0; ok && (errNum == WLZ_ERR_NONE) && (idD < 3); ++idD)
+  {
+    int		idG;
+    const WlzGreyType gTypes[6] = {WLZ_GREY_UBYTE, WLZ_GREY_SHORT,
+                                   WLZ_GREY_INT, WLZ_GREY_FLOAT,
+				   WLZ_GREY_DOUBLE, WLZ_GREY_RGBA};
+
+    for(idG = 0; (errNum == WLZ_ERR_NONE) && (idG < 6); ++idG)
+    {
+      char	name[64];
+      WlzObject	*obj;
+
+      /* Tiled values are only tested in 3D. */
+      if((idD == 2) && (gTypes[idG] == WLZ_GREY_RGBA))
+      {
+        continue;
+      }
+      (void )sprintf(name, "%s %s",
+		     (idD == 0)? "2D": ((idD == 1)? "3D": "3D tiled"),
+                     WlzStringFromGreyType(gTypes[idG], NULL));
+      obj = WlzAssignObject(
+            WlzTstGreyScanParMakeObj(
+	        (idD == 0)? WLZ_2D_DOMAINOBJ: WLZ_3D_DOMAINOBJ,
+	        gTypes[idG], idD == 2, (idD == 0)? 4 * sz: sz, &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        nBad += WlzTstGreyScanParObj(obj, name, verbose, &errNum);
+      }
+      (void )WlzFreeObj(obj);
+    }
+  }
+  /* Time the serial and parallel functions and the fused scan using a
+   * larger 3D object. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    int		idM;
+    WlzObject	*obj;
+    WlzPixelV	thrV;
+
+    thrV.type = WLZ_GREY_INT;
+    thrV.v.inv = 100;
+    obj = WlzAssignObject(
+          WlzTstGreyScanParMakeObj(WLZ_3D_DOMAINOBJ, WLZ_GREY_UBYTE, 0,
+	                           4 * sz, &errNum), NULL);
+    for(idM = 0; (errNum == WLZ_ERR_NONE) && (idM < 3); ++idM)
+    {
+      double	t0;
+      WlzObject	*hObj = NULL,
+      		*tObj = NULL;
+      WlzGreyScanStats stats;
+
+      t0 = WlzTstGreyScanParTime();
+      switch(idM)
+      {
+        case 0:
+	  (void )WlzGreyStats(obj, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+	                      &errNum);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    hObj = WlzHistogramObj(obj, 0, 0.0, 1.0, &errNum);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    tObj = WlzThreshold(obj, thrV, WLZ_THRESH_HIGH, &errNum);
+	  }
+	  break;
+        case 1:
+	  (void )WlzGreyStatsPar(obj, NULL, NULL, NULL, NULL, NULL, NULL,
+	                         NULL, &errNum);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    hObj = WlzHistogramObjPar(obj, 0, 0.0, 1.0, &errNum);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    tObj = WlzThresholdPar(obj, thrV, WLZ_THRESH_HIGH, &errNum);
+	  }
+	  break;
+	default:
+	  errNum = WlzGreyScanPar(obj, 0, 0.0, 1.0, thrV, WLZ_THRESH_HIGH,
+	                          &stats, &hObj, &tObj);
+	  break;
+      }
+      t[idM] = WlzTstGreyScanParTime() - t0;
+      (void )WlzFreeObj(hObj);
+      (void )WlzFreeObj(tObj);
+    }
+    (void )WlzFreeObj(obj);
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to scan grey values (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: statistics, histogram and threshold serial %gs, "
+		    "parallel %gs, fused %gs, %d differences (%s)\n",
+		    argv[0], t[0], t[1], t[2], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-s#]\n"
+    "Tests the parallel grey value statistics, histogram and threshold\n"
+    "functions against the serial functions using discs and balls with\n"
+    "random values, thresholded to give speckled domains, and times them.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, reporting each test object.\n"
+    "  -s  Diameter of the 3D balls, the disc and the timed ball have 4\n"
+    "      times this diameter (default %d).\n",
+    argv[0], 48);
+  }
+  return(!ok);
+}
+
+static double	WlzTstGreyScanParTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
+
+/* Returns zero if the two objects have the same domain and bounding box,
+ * otherwise one. */
+static int	WlzTstGreyScanParCmpDom(WlzObject *o0, WlzObject *o1)
+{
+  int		nBad = 1;
+  WlzLong	v0,
+  		v1,
+		vI;
+  WlzObject	*oI;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  v0 = (o0->type == WLZ_EMPTY_OBJ)? 0: WlzVolume(o0, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    v1 = (o1->type == WLZ_EMPTY_OBJ)? 0: WlzVolume(o1, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && (v0 == v1))
+  {
+    if(v0 == 0)
+    {
+      nBad = 0;
+    }
+    else
+    {
+      WlzIBox3	b0,
+      		b1;
+
+      b0 = WlzBoundingBox3I(o0, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        b1 = WlzBoundingBox3I(o1, &errNum);
+      }
+      if((errNum == WLZ_ERR_NONE) &&
+         (memcmp(&b0, &b1, sizeof(WlzIBox3)) == 0))
+      {
+	oI = WlzAssignObject(WlzIntersect2(o0, o1, &errNum), NULL);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  vI = (oI->type == WLZ_EMPTY_OBJ)? 0: WlzVolume(oI, &errNum);
+	  nBad = (errNum != WLZ_ERR_NONE) || (vI != v0);
+	}
+	(void )WlzFreeObj(oI);
+      }
+    }
+  }
+  return(nBad);
+}
+
+/* Returns zero if the two histograms have the same bins, otherwise one. */
+static int	WlzTstGreyScanParCmpHist(WlzObject *h0, WlzObject *h1)
+{
+  int		nBad = 1;
+  WlzHistogramDomain *d0,
+  		*d1;
+
+  d0 = h0->domain.hist;
+  d1 = h1->domain.hist;
+  if((d0->nBins == d1->nBins) &&
+     (fabs(d0->origin - d1->origin) < DBL_EPSILON) &&
+     (fabs(d0->binSize - d1->binSize) < DBL_EPSILON))
+  {
+    nBad = (d0->nBins > 0) &&
+           (memcmp(d0->binValues.inp, d1->binValues.inp,
+	           d0->nBins * sizeof(int)) != 0);
+  }
+  return(nBad);
+}
+
+/* Returns zero if the two values are the same allowing for rounding
+ * errors from the order of summation, otherwise one. */
+static int	WlzTstGreyScanParCmpD(double d0, double d1)
+{
+  return(fabs(d0 - d1) > 1.0e-9 * (fabs(d0) + fabs(d1) + 1.0));
+}
+
+/* Compares the parallel scans of the given object with the serial
+ * functions and returns the number of differences. */
+static int	WlzTstGreyScanParObj(WlzObject *obj, const char *name,
+				     int verbose, WlzErrorNum *dstErr)
+{
+  int		idH,
+  		idT,
+  		area[2] = {0, 0},
+		bad,
+		nBad = 0;
+  double	s[2][6];
+  WlzGreyType	gType[2];
+  WlzPixelV	thrV;
+  WlzGreyScanStats stats;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Statistics. */
+  area[0] = WlzGreyStats(obj, gType + 0, s[0] + 0, s[0] + 1, s[0] + 2,
+                         s[0] + 3, s[0] + 4, s[0] + 5, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		i;
+
+    area[1] = WlzGreyStatsPar(obj, gType + 1, s[1] + 0, s[1] + 1, s[1] + 2,
+                              s[1] + 3, s[1] + 4, s[1] + 5, &errNum);
+    bad = (area[0] != area[1]) || (gType[0] != gType[1]);
+    for(i = 0; i < 6; ++i)
+    {
+      bad |= WlzTstGreyScanParCmpD(s[0][i], s[1][i]);
+    }
+    nBad += bad;
+    if(verbose || bad)
+    {
+      (void )printf("%-16s statistics area %d min %g max %g mean %g "
+                    "sd %g %s\n",
+		    name, area[1], s[1][0], s[1][1], s[1][4], s[1][5],
+		    (bad)? "differ": "same");
+    }
+  }
+  /* Histograms, with the range of values and with given bins. */
+  for(idH = 0; (errNum == WLZ_ERR_NONE) && (idH < 2) &&
+               (gType[0] != WLZ_GREY_RGBA); ++idH)
+  {
+    int		nBins;
+    double	origin,
+    		binSz;
+    WlzObject	*h0,
+    		*h1 = NULL;
+
+    /* WlzGreyRange(), used by WlzHistogramObj() to find the range of
+     * values, does not support tiled values. */
+    if((idH == 0) && (gType[0] != WLZ_GREY_UBYTE) &&
+       WlzGreyTableIsTiled(obj->values.core->type))
+    {
+      continue;
+    }
+    nBins = (idH == 0)? 0: 50;
+    origin = (idH == 0)? 0.0: 20.0;
+    binSz = (idH == 0)? 1.0: 3.5;
+    h0 = WlzAssignObject(
+         WlzHistogramObj(obj, nBins, origin, binSz, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      h1 = WlzAssignObject(
+	   WlzHistogramObjPar(obj, nBins, origin, binSz, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bad = WlzTstGreyScanParCmpHist(h0, h1);
+      nBad += bad;
+      if(verbose || bad)
+      {
+	(void )printf("%-16s histogram %d bins from %g %s\n",
+	              name, h1->domain.hist->nBins,
+		      h1->domain.hist->origin, (bad)? "differ": "same");
+      }
+    }
+    (void )WlzFreeObj(h0);
+    (void )WlzFreeObj(h1);
+  }
+  /* Thresholds of each type. */
+  thrV.type = WLZ_GREY_INT;
+  thrV.v.inv = (gType[0] == WLZ_GREY_RGBA)? 220: 100;
+  for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < 3); ++idT)
+  {
+    WlzThresholdType thrType;
+    WlzObject	*t0,
+    		*t1 = NULL;
+
+    thrType = (idT == 0)? WLZ_THRESH_LOW:
+              (idT == 1)? WLZ_THRESH_HIGH: WLZ_THRESH_EQUAL;
+    t0 = WlzAssignObject(WlzThreshold(obj, thrV, thrType, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      t1 = WlzAssignObject(
+           WlzThresholdPar(obj, thrV, thrType, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bad = WlzTstGreyScanParCmpDom(t0, t1);
+      nBad += bad;
+      if(verbose || bad)
+      {
+	(void )printf("%-16s threshold type %d volume %ld %s\n",
+	              name, idT,
+		      (t1->type == WLZ_EMPTY_OBJ)?
+		      0L: (long )WlzVolume(t1, NULL),
+		      (bad)? "differs": "same");
+      }
+    }
+    (void )WlzFreeObj(t0);
+    (void )WlzFreeObj(t1);
+  }
+  /* The fused scan must give the same results as the separate parallel
+   * scans. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzObject	*h[2] = {NULL, NULL},
+    		*t[2] = {NULL, NULL};
+
+    errNum = WlzGreyScanPar(obj, 40, 30.0, 2.5, thrV, WLZ_THRESH_HIGH,
+                            &stats, h + 0, t + 0);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzGreyScanPar(obj, 40, 30.0, 2.5, thrV, WLZ_THRESH_HIGH,
+			      NULL, h + 1, NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      t[1] = WlzThresholdPar(obj, thrV, WLZ_THRESH_HIGH, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bad = (stats.area != area[1]) ||
+            (stats.min != s[1][0]) || (stats.max != s[1][1]) ||
+            (stats.sum != s[1][2]) || (stats.sumSq != s[1][3]) ||
+	    WlzTstGreyScanParCmpD(sqrt(stats.var), s[1][5]) ||
+	    WlzTstGreyScanParCmpHist(h[0], h[1]) ||
+	    WlzTstGreyScanParCmpDom(t[0], t[1]);
+      nBad += bad;
+      if(verbose || bad)
+      {
+	(void )printf("%-16s fused scan %s\n", name,
+		      (bad)? "differs": "same");
+      }
+    }
+    (void )WlzFreeObj(h[0]);
+    (void )WlzFreeObj(h[1]);
+    (void )WlzFreeObj(t[0]);
+    (void )WlzFreeObj(t[1]);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nBad);
+}
+
+/* Makes a test object with a speckled domain, having many short
+ * intervals to be divided between the threads, by thresholding a disc or
+ * ball with random values of the given grey type. A quarter of the values
+ * are on the histogram bin and threshold boundaries, so that values which
+ * are binned or thresholded differently are found. The 3D objects do not
+ * start at plane zero. */
+static WlzObject *WlzTstGreyScanParMakeObj(WlzObjectType oType,
+					   WlzGreyType gType, int tiled,
+					   int sz, WlzErrorNum *dstErr)
+{
+  WlzValues	val;
+  WlzPixelV	bgdV,
+  		thrV;
+  WlzObjectType gTType;
+  WlzObject	*obj = NULL,
+		*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgdV.type = WLZ_GREY_INT;
+  bgdV.v.inv = 0;
+  obj = WlzAssignObject(
+	WlzMakeSphereObject(oType, sz / 2, sz / 2, sz / 2, sz / 2 + 3,
+	                    &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gTType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, NULL);
+    if(oType == WLZ_2D_DOMAINOBJ)
+    {
+      val.v = WlzNewValueTb(obj, gTType, bgdV, &errNum);
+    }
+    else
+    {
+      val.vox = WlzNewValuesVox(obj, gTType, bgdV, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzIterateWSpace *itWSp;
+
+    obj->values = WlzAssignValues(val, NULL);
+    itWSp = WlzIterateInit(obj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      AlgRandSeed(sz + gType);
+      while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+      {
+	double	v;
+
+	v = AlgRandUniform();
+	if(v < 0.25)
+	{
+	  v = 30.0 + 2.5 * floor(v * 240.0);
+	}
+	else
+	{
+	  v = 20.0 + 160.0 * AlgRandUniform();
+	}
+	switch(gType)
+	{
+	  case WLZ_GREY_UBYTE:
+	    *(itWSp->gP.ubp) = (WlzUByte )WLZ_NINT(v);
+	    break;
+	  case WLZ_GREY_SHORT:
+	    *(itWSp->gP.shp) = (short )WLZ_NINT(v);
+	    break;
+	  case WLZ_GREY_INT:
+	    *(itWSp->gP.inp) = WLZ_NINT(v);
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    *(itWSp->gP.flp) = (float )v;
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    *(itWSp->gP.dbp) = v;
+	    break;
+	  case WLZ_GREY_RGBA:
+	    WLZ_RGBA_RGBA_SET(*(itWSp->gP.rgbp), WLZ_NINT(v),
+			      (int )(255.0 * AlgRandUniform()),
+			      (int )(255.0 * AlgRandUniform()), 255);
+	    break;
+	  default:
+	    break;
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+    }
+    WlzIterateWSpFree(itWSp);
+  }
+  if((errNum == WLZ_ERR_NONE) && tiled)
+  {
+    WlzObject	*tObj;
+
+    tObj = WlzMakeTiledValuesFromObj(obj, 4096, 1, gType, 0, NULL, bgdV,
+                                     &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzFreeObj(obj);
+      obj = WlzAssignObject(tObj, NULL);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Threshold the disc or ball so that the domain is speckled, but
+     * keep its values. */
+    thrV.type = WLZ_GREY_INT;
+    thrV.v.inv = 60;
+    rObj = WlzThreshold(obj, thrV, WLZ_THRESH_HIGH, &errNum);
+  }
+  (void )WlzFreeObj(obj);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
@@ -0,0 +1,279 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstGreyValueBatch_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstGreyValueBatch.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for batched grey value access which compares the values
+* 		found by WlzGreyValueGetBatch() with those found using
+* 		WlzGreyValueGet() and WlzGreyValueGetCon() for each point.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+  		dim = 2,
+		nPos = 10000,
+  		ok = 1,
+  		usage = 0;
+  double	rad = 20.0,
+		maxErr = 0.0;
+  double	*bVal = NULL;
+  const char	*errMsgStr;
+  WlzVertexP	pos;
+  WlzObject	*obj = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzInterpolationType interp = WLZ_INTERPOLATION_NEAREST;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "23hln:r:";
+  const double	tol = 1.0e-6;
+
+  opterr = 0;
+  pos.v = NULL;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case '2':
+        dim = 2;
+	break;
+      case '3':
+        dim = 3;
+	break;
+      case 'l':
+        interp = WLZ_INTERPOLATION_LINEAR;
+	break;
+      case 'n':
+        usage = (sscanf(optarg, "%d", &nPos) != 1) || (nPos < 1);
+	break;
+      case 'r':
+        usage = (sscanf(optarg, "%lg", &rad) != 1) || (rad < 1.0);
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  /* Create a spherical object with grey values which vary with
+   * position. */
+  if(ok)
+  {
+    WlzPixelV	bgdV;
+    WlzValues	val;
+    WlzObjectType oType,
+    		gTType;
+
+    bgdV.type = WLZ_GREY_INT;
+    bgdV.v.inv = -7;
+    gTType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, WLZ_GREY_INT, NULL);
+    oType = (dim == 2)? WLZ_2D_DOMAINOBJ: WLZ_3D_DOMAINOBJ;
+    obj = WlzAssignObject(
+          WlzMakeSphereObject(oType, rad, 0.0, 0.0, 0.0, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(dim == 2)
+      {
+        val.v = WlzNewValueTb(obj, gTType, bgdV, &errNum);
+      }
+      else
+      {
+        val.vox = WlzNewValuesVox(obj, gTType, bgdV, &errNum);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj->values = WlzAssignValues(val, NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzIterateWSpace *itWSp;
+
+      itWSp = WlzIterateInit(obj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+	{
+	  *(itWSp->gP.inp) = (3 * itWSp->pos.vtX) + (5 * itWSp->pos.vtY) +
+	                     (11 * itWSp->pos.vtZ) +
+			     ((itWSp->pos.vtX * itWSp->pos.vtY) % 13);
+	}
+	if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+      }
+      WlzIterateWSpFree(itWSp);
+    }
+  }
+  /* Create random positions which cover and extend beyond the object. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    if(((pos.d3 = (WlzDVertex3 *)
+                  AlcMalloc(nPos * sizeof(WlzDVertex3))) == NULL) ||
+       ((bVal = (double *)AlcMalloc(nPos * sizeof(double))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	idP;
+      double	ext;
+
+      ext = 2.0 * (rad + 2.0);
+      AlgRandSeed(0);
+      for(idP = 0; idP < nPos; ++idP)
+      {
+        pos.d3[idP].vtX = ext * (AlgRandUniform() - 0.5);
+        pos.d3[idP].vtY = ext * (AlgRandUniform() - 0.5);
+        pos.d3[idP].vtZ = (dim == 2)? 0.0: ext * (AlgRandUniform() - 0.5);
+      }
+    }
+  }
+  /* Get the values using the batch function and then compare them with
+   * the values found for each point in turn. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    errNum = WlzGreyValueGetBatch(gVWSp, interp, WLZ_VERTEX_D3, nPos, pos,
+                                  bVal);
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    int		idP;
+
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      double	d,
+      		v;
+      WlzDVertex3 p;
+
+      p = pos.d3[idP];
+      if(interp == WLZ_INTERPOLATION_NEAREST)
+      {
+        WlzGreyValueGet(gVWSp, p.vtZ, p.vtY, p.vtX);
+	v = gVWSp->gVal[0].inv;
+      }
+      else
+      {
+        int	idN;
+	double	w;
+	WlzDVertex3 f,
+		t;
+
+	f.vtX = floor(p.vtX);
+	f.vtY = floor(p.vtY);
+	f.vtZ = floor(p.vtZ);
+	t.vtX = p.vtX - f.vtX;
+	t.vtY = p.vtY - f.vtY;
+	t.vtZ = p.vtZ - f.vtZ;
+        WlzGreyValueGetCon(gVWSp, f.vtZ, f.vtY, f.vtX);
+	v = 0.0;
+	for(idN = 0; idN < ((dim == 2)? 4: 8); ++idN)
+	{
+	  w = ((idN & 1)? t.vtX: 1.0 - t.vtX) *
+	      ((idN & 2)? t.vtY: 1.0 - t.vtY);
+	  if(dim == 3)
+	  {
+	    w *= (idN & 4)? t.vtZ: 1.0 - t.vtZ;
+	  }
+	  v += w * gVWSp->gVal[idN].inv;
+	}
+      }
+      d = fabs(v - bVal[idP]);
+      if(d > maxErr)
+      {
+        maxErr = d;
+      }
+    }
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to get grey values (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = maxErr < tol;
+      (void )printf("%s: maximum error %g (%s)\n",
+                    argv[0], maxErr, (ok)? "pass": "FAIL");
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  AlcFree(pos.v);
+  AlcFree(bVal);
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-2] [-3] [-h] [-l] [-n#] [-r#]\n"
+    "Tests batched grey value access by comparing the values found at\n"
+    "random positions in and around a sphere with those found for each\n"
+    "position in turn.\n"
+    "Options are:\n"
+    "  -2  2D object (default).\n"
+    "  -3  3D object.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -l  Use linear interpolation instead of nearest neighbour.\n"
+    "  -n  Number of positions (default %d).\n"
+    "  -r  Sphere radius (default %g).\n",
+    argv[0], 10000, 20.0);
+  }
+  return(!ok);
+}
@@ -0,0 +1,834 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstIndexedPlanes_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstIndexedPlanes.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test and benchmark for 3D domain objects written with a
+* 		plane index. Synthetic 3D objects with values of each
+* 		grey type, with empty planes and without values are
+* 		written with and without a plane index and read back,
+* 		both from a file (when the planes are read concurrently)
+* 		and through a pipe (when they are read in order). The
+* 		objects read are compared with those read without a
+* 		plane index, and must be written again to the same bytes.
+* 		Ranges of planes are then read using
+* 		WlzReadObjPlanes() and compared with the same planes
+* 		selected from the whole object. The times to write and
+* 		read a larger object are then reported.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstIndexedPlanesTime(void);
+static int			WlzTstIndexedPlanesPixSame(
+				  WlzPixelV p0,
+				  WlzPixelV p1);
+static WlzObjectType		WlzTstIndexedPlanesVTb(
+				  WlzValues v,
+				  WlzPixelV *bgd);
+static int			WlzTstIndexedPlanesCmp(
+				  WlzObject *o0,
+				  WlzObject *o1,
+				  int strict,
+				  WlzErrorNum *dstErr);
+static int			WlzTstIndexedPlanesWriteCmp(
+				  WlzObject *o0,
+				  WlzObject *o1,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstIndexedPlanesSelect(
+				  WlzObject *obj,
+				  int p1,
+				  int lp,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzTstIndexedPlanesRW(
+				  WlzObject **dstObj,
+				  WlzObject *obj,
+				  int idx,
+				  int pipe,
+				  const int *rng,
+				  double *dstT);
+static WlzObject		*WlzTstIndexedPlanesMakeObj(
+				  WlzGreyType gType,
+				  int shape,
+				  int sz,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idS,
+  		option,
+		sz = 32,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvs:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 8);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  /* Round trip objects with values, with empty planes and without
+   * values, for each grey type, writing with and without a plane index
+   * (and with encoded plane values) and reading from both files and
+   * pipes. */
+  for(idS = 0; ok && (errNum == WLZ_ERR_NONE) && (idS < 3); ++idS)
+  {
+    int		idG;
+    const char	*shapeStr[3] = {"values", "empty planes", "no values"};
+    const WlzGreyType gTypes[6] = {WLZ_GREY_UBYTE, WLZ_GREY_SHORT,
+                                   WLZ_GREY_INT, WLZ_GREY_FLOAT,
+				   WLZ_GREY_DOUBLE, WLZ_GREY_RGBA};
+
+    for(idG = 0; (errNum == WLZ_ERR_NONE) && (idG < 6); ++idG)
+    {
+      int	idM;
+      double	t[2];
+      WlzObject	*obj,
+      		*refObj = NULL;
+
+      if((idS == 2) && (idG > 0))
+      {
+        break;
+      }
+      obj = WlzAssignObject(
+            WlzTstIndexedPlanesMakeObj(gTypes[idG], idS, sz, &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzTstIndexedPlanesRW(&refObj, obj, 0, 0, NULL, t);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        int	bad;
+
+	bad = WlzTstIndexedPlanesCmp(obj, refObj, 0, &errNum);
+	nBad += bad;
+	if(verbose && (errNum == WLZ_ERR_NONE))
+	{
+	  (void )printf("%s %s without index %s\n", shapeStr[idS],
+	                WlzStringFromGreyType(gTypes[idG], NULL),
+			(bad)? "DIFFERENT": "same");
+	}
+      }
+      for(idM = 0; (errNum == WLZ_ERR_NONE) && (idM < 4); ++idM)
+      {
+        int	bad = 0;
+	WlzObject *rObj = NULL;
+	const char *modeStr[4] = {"file", "pipe", "file zlib", "pipe zlib"};
+
+	WlzEncodedValuesSetType((idM < 2)? WLZ_VALUE_ENCODING_NONE:
+	                                   WLZ_VALUE_ENCODING_ZLIB);
+	errNum = WlzTstIndexedPlanesRW(&rObj, obj, 1, idM % 2, NULL, t);
+	WlzEncodedValuesSetType(WLZ_VALUE_ENCODING_NONE);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  bad = WlzTstIndexedPlanesCmp(refObj, rObj, 1, &errNum);
+	}
+	if((errNum == WLZ_ERR_NONE) && (bad == 0))
+	{
+	  bad = WlzTstIndexedPlanesWriteCmp(refObj, rObj, &errNum);
+	}
+	nBad += bad;
+	if(verbose && (errNum == WLZ_ERR_NONE))
+	{
+	  (void )printf("%s %s with index %s %s\n", shapeStr[idS],
+	                WlzStringFromGreyType(gTypes[idG], NULL),
+			modeStr[idM], (bad)? "DIFFERENT": "same");
+	}
+	(void )WlzFreeObj(rObj);
+      }
+      (void )WlzFreeObj(refObj);
+      (void )WlzFreeObj(obj);
+    }
+  }
+  /* Read ranges of planes, within, overlapping, covering and outside
+   * the planes of the objects, with and without a plane index and from
+   * both files and pipes. */
+  for(idS = 0; ok && (errNum == WLZ_ERR_NONE) && (idS < 3); ++idS)
+  {
+    int		idR;
+    WlzObject	*obj,
+      		*refObj = NULL;
+    const char	*shapeStr[3] = {"values", "empty planes", "no values"};
+
+    obj = WlzAssignObject(
+	  WlzTstIndexedPlanesMakeObj(WLZ_GREY_SHORT, idS, sz, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      double	t[2];
+
+      errNum = WlzTstIndexedPlanesRW(&refObj, obj, 0, 0, NULL, t);
+    }
+    for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < 5); ++idR)
+    {
+      int	idM,
+      		p1,
+		lp;
+      int	rng[2];
+      WlzObject	*selObj;
+
+      p1 = obj->domain.p->plane1;
+      lp = obj->domain.p->lastpl;
+      switch(idR)
+      {
+        case 0:
+	  rng[0] = p1 + 3;
+	  rng[1] = p1 + 7;
+	  break;
+	case 1:
+	  rng[0] = p1 - 5;
+	  rng[1] = p1 + 1;
+	  break;
+	case 2:
+	  rng[0] = lp;
+	  rng[1] = lp;
+	  break;
+	case 3:
+	  rng[0] = p1 - 5;
+	  rng[1] = lp + 5;
+	  break;
+	default:
+	  rng[0] = lp + 1;
+	  rng[1] = lp + 9;
+	  break;
+      }
+      selObj = WlzAssignObject(
+               WlzTstIndexedPlanesSelect(refObj, rng[0], rng[1], &errNum),
+	       NULL);
+      for(idM = 0; (errNum == WLZ_ERR_NONE) && (idM < 4); ++idM)
+      {
+	int	bad = 0;
+	double	t[2];
+	WlzObject *rObj = NULL;
+	const char *modeStr[4] = {"file", "pipe", "file with index",
+				  "pipe with index"};
+
+	errNum = WlzTstIndexedPlanesRW(&rObj, obj, idM / 2, idM % 2, rng, t);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  bad = WlzTstIndexedPlanesCmp(selObj, rObj, 1, &errNum);
+	  nBad += bad;
+	}
+	if(verbose && (errNum == WLZ_ERR_NONE))
+	{
+	  (void )printf("%s planes %d,%d %s %s\n", shapeStr[idS],
+	                rng[0], rng[1], modeStr[idM],
+			(bad)? "DIFFERENT": "same");
+	}
+	(void )WlzFreeObj(rObj);
+      }
+      (void )WlzFreeObj(selObj);
+    }
+    (void )WlzFreeObj(refObj);
+    (void )WlzFreeObj(obj);
+  }
+  /* Report the times for a larger object. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    int		idx;
+    WlzObject	*obj;
+
+    obj = WlzAssignObject(
+          WlzTstIndexedPlanesMakeObj(WLZ_GREY_SHORT, 0, 4 * sz, &errNum),
+	  NULL);
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 2); ++idx)
+    {
+      double	t[2];
+      WlzObject	*rObj = NULL;
+
+      errNum = WlzTstIndexedPlanesRW(&rObj, obj, idx, 0, NULL, t);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	nBad += WlzTstIndexedPlanesCmp(obj, rObj, 0, &errNum);
+	(void )printf("%s: %s index, write %gs, read %gs\n",
+		      argv[0], (idx)? "with": "without", t[0], t[1]);
+      }
+      (void )WlzFreeObj(rObj);
+    }
+    (void )WlzFreeObj(obj);
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to write or read indexed planes (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d differences (%s)\n",
+		    argv[0], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-s#]\n"
+    "Tests 3D objects written with a plane index by writing and reading\n"
+    "crescent shaped objects, with values which encode the voxel\n"
+    "positions, and comparing them with the same objects written without\n"
+    "an index. Whole objects and ranges of planes are read. The write and\n"
+    "read times of a larger object are then reported.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, reporting each test object.\n"
+    "  -s  Diameter of the outer ball of the crescents, the timed object\n"
+    "      has four times this diameter (default %d).\n",
+    argv[0], 32);
+  }
+  return(!ok);
+}
+
+static double	WlzTstIndexedPlanesTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
+
+/* Returns non-zero if the two pixel values have the same type and
+ * value. */
+static int	WlzTstIndexedPlanesPixSame(WlzPixelV p0, WlzPixelV p1)
+{
+  int		same;
+
+  same = (p0.type == p1.type) &&
+         ((p0.type == WLZ_GREY_ERROR) ||
+	  (memcmp(&(p0.v), &(p1.v), WlzGreySize(p0.type)) == 0));
+  return(same);
+}
+
+/* Returns the grey table type of a value table and its background. */
+static WlzObjectType WlzTstIndexedPlanesVTb(WlzValues v, WlzPixelV *bgd)
+{
+  WlzObjectType	type = WLZ_NULL;
+
+  bgd->type = WLZ_GREY_ERROR;
+  bgd->v.dbv = 0.0;
+  if(v.core != NULL)
+  {
+    type = v.core->type;
+    switch(WlzGreyTableTypeToTableType(type, NULL))
+    {
+      case WLZ_GREY_TAB_RAGR:
+	*bgd = v.v->bckgrnd;
+	break;
+      case WLZ_GREY_TAB_RECT:
+	*bgd = v.r->bckgrnd;
+	break;
+      case WLZ_GREY_TAB_INTL:
+	*bgd = v.i->bckgrnd;
+	break;
+      default:
+	break;
+    }
+  }
+  return(type);
+}
+
+/* Returns zero if the two objects are both empty or are 3D objects
+ * with the same plane domain and voxel value table fields, the same
+ * plane domains and value table types and the same values, otherwise
+ * one. If strict is non-zero the backgrounds must also be the same,
+ * which is not so for an object and the same object read from a file,
+ * because the voxel value table background is written as an int. */
+static int	WlzTstIndexedPlanesCmp(WlzObject *o0, WlzObject *o1,
+				       int strict, WlzErrorNum *dstErr)
+{
+  int		idp,
+  		nPln = 0,
+  		same = 1;
+  WlzPlaneDomain *p0,
+  		*p1;
+  WlzVoxelValues *v0,
+  		*v1;
+  WlzIterateWSpace *it0 = NULL,
+  		*it1 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((o0 != NULL) && (o1 != NULL) &&
+     (o0->type == WLZ_EMPTY_OBJ) && (o1->type == WLZ_EMPTY_OBJ))
+  {
+    same = 1;
+  }
+  else if((o0 == NULL) || (o1 == NULL) ||
+     (o0->type != WLZ_3D_DOMAINOBJ) || (o1->type != WLZ_3D_DOMAINOBJ) ||
+     ((o0->values.core == NULL) != (o1->values.core == NULL)) ||
+     ((o0->plist == NULL) != (o1->plist == NULL)))
+  {
+    same = 0;
+  }
+  else
+  {
+    p0 = o0->domain.p;
+    p1 = o1->domain.p;
+    v0 = o0->values.vox;
+    v1 = o1->values.vox;
+    nPln = p0->lastpl - p0->plane1 + 1;
+    same = (p0->type == p1->type) &&
+           (p0->plane1 == p1->plane1) && (p0->lastpl == p1->lastpl) &&
+           (p0->line1 == p1->line1) && (p0->lastln == p1->lastln) &&
+           (p0->kol1 == p1->kol1) && (p0->lastkl == p1->lastkl) &&
+	   (memcmp(p0->voxel_size, p1->voxel_size, 3 * sizeof(float)) == 0);
+    if(same && (v0 != NULL))
+    {
+      same = (v0->type == v1->type) &&
+             (v0->plane1 == v1->plane1) && (v0->lastpl == v1->lastpl) &&
+	     (!strict || WlzTstIndexedPlanesPixSame(v0->bckgrnd, v1->bckgrnd));
+    }
+  }
+  for(idp = 0; same && (idp < nPln); ++idp)
+  {
+    WlzIntervalDomain *i0,
+    		*i1;
+
+    i0 = p0->domains[idp].i;
+    i1 = p1->domains[idp].i;
+    if((i0 == NULL) || (i1 == NULL))
+    {
+      same = i0 == i1;
+    }
+    else
+    {
+      same = (i0->type == i1->type) &&
+             (i0->line1 == i1->line1) && (i0->lastln == i1->lastln) &&
+	     (i0->kol1 == i1->kol1) && (i0->lastkl == i1->lastkl);
+    }
+    if(same && (v0 != NULL))
+    {
+      WlzPixelV	b0,
+      		b1;
+
+      same = (WlzTstIndexedPlanesVTb(v0->values[idp], &b0) ==
+              WlzTstIndexedPlanesVTb(v1->values[idp], &b1)) &&
+	     (!strict || WlzTstIndexedPlanesPixSame(b0, b1));
+    }
+  }
+  /* Compare the voxel positions and values. */
+  if(same && (o0->type == WLZ_3D_DOMAINOBJ))
+  {
+    it0 = WlzIterateInit(o0, WLZ_RASTERDIR_ILIC, v0 != NULL, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      it1 = WlzIterateInit(o1, WLZ_RASTERDIR_ILIC, v1 != NULL, &errNum);
+    }
+  }
+  if(same && (errNum == WLZ_ERR_NONE) && (o0->type == WLZ_3D_DOMAINOBJ))
+  {
+    while(same && ((errNum = WlzIterate(it0)) == WLZ_ERR_NONE))
+    {
+      if(((errNum = WlzIterate(it1)) != WLZ_ERR_NONE) ||
+	 (it0->pos.vtX != it1->pos.vtX) ||
+	 (it0->pos.vtY != it1->pos.vtY) ||
+	 (it0->pos.vtZ != it1->pos.vtZ))
+      {
+        same = 0;
+      }
+      else if(v0 != NULL)
+      {
+	same = (it0->gType == it1->gType) &&
+	       (memcmp(it0->gP.ubp, it1->gP.ubp,
+	               WlzGreySize(it0->gType)) == 0);
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+      same = same && (WlzIterate(it1) == WLZ_ERR_EOO);
+    }
+    else if(same == 0)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  WlzIterateWSpFree(it0);
+  WlzIterateWSpFree(it1);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(!same);
+}
+
+/* Makes a new object with the planes of the given 3D object which are
+ * within the given range, sharing the plane domains and values, or an
+ * empty object if there are no such planes. */
+static WlzObject *WlzTstIndexedPlanesSelect(WlzObject *obj, int p1, int lp,
+					    WlzErrorNum *dstErr)
+{
+  int		idp,
+  		off;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzPlaneDomain *pDom;
+  WlzObject	*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  pDom = obj->domain.p;
+  p1 = WLZ_MAX(p1, pDom->plane1);
+  lp = WLZ_MIN(lp, pDom->lastpl);
+  off = p1 - pDom->plane1;
+  if(p1 > lp)
+  {
+    rObj = WlzMakeEmpty(&errNum);
+  }
+  else
+  {
+    dom.p = WlzMakePlaneDomain(pDom->type, p1, lp,
+                               pDom->line1, pDom->lastln,
+			       pDom->kol1, pDom->lastkl, &errNum);
+    if((errNum == WLZ_ERR_NONE) && (obj->values.core != NULL))
+    {
+      val.vox = WlzMakeVoxelValueTb(obj->values.vox->type, p1, lp,
+				    obj->values.vox->bckgrnd, NULL, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )memcpy(dom.p->voxel_size, pDom->voxel_size, 3 * sizeof(float));
+      for(idp = p1; idp <= lp; ++idp)
+      {
+	dom.p->domains[idp - p1] = WlzAssignDomain(
+				   pDom->domains[idp - p1 + off], NULL);
+	if(val.core != NULL)
+	{
+	  val.vox->values[idp - p1] = WlzAssignValues(
+				obj->values.vox->values[idp - p1 + off], NULL);
+	}
+      }
+      rObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, obj->plist, NULL,
+			 &errNum);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/* Writes the object twice to a temporary file, with or without a plane
+ * index, and reads both copies back either from the file or through a
+ * pipe, returning the second copy and setting the write and read times
+ * of the first. If a range is given then only the planes within it are
+ * read using WlzReadObjPlanes(). */
+static WlzErrorNum WlzTstIndexedPlanesRW(WlzObject **dstObj, WlzObject *obj,
+					 int idx, int pipe, const int *rng,
+					 double *dstT)
+{
+  int		fd,
+  		idc;
+  FILE		*fP = NULL;
+  char		fName[] = "/tmp/WlzTstIndexedPlanesXXXXXX";
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  WlzWriteObjSetPlaneIndex(idx);
+  if(((fd = mkstemp(fName)) < 0) || ((fP = fdopen(fd, "w")) == NULL))
+  {
+    errNum = WLZ_ERR_FILE_OPEN;
+  }
+  for(idc = 0; (errNum == WLZ_ERR_NONE) && (idc < 2); ++idc)
+  {
+    double	t0;
+
+    t0 = WlzTstIndexedPlanesTime();
+    errNum = WlzWriteObj(fP, obj);
+    (void )fflush(fP);
+    dstT[idc] = WlzTstIndexedPlanesTime() - t0;
+  }
+  if(fP != NULL)
+  {
+    (void )fclose(fP);
+    fP = NULL;
+  }
+  WlzWriteObjSetPlaneIndex(0);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(pipe)
+    {
+      char	cmd[64];
+
+      (void )sprintf(cmd, "cat %s", fName);
+      fP = popen(cmd, "r");
+    }
+    else
+    {
+      fP = fopen(fName, "r");
+    }
+    if(fP == NULL)
+    {
+      errNum = WLZ_ERR_FILE_OPEN;
+    }
+  }
+  for(idc = 0; (errNum == WLZ_ERR_NONE) && (idc < 2); ++idc)
+  {
+    double	t0;
+    WlzObject	*rObj;
+
+    t0 = WlzTstIndexedPlanesTime();
+    rObj = WlzAssignObject((rng)?
+                           WlzReadObjPlanes(fP, rng[0], rng[1], &errNum):
+			   WlzReadObj(fP, &errNum), NULL);
+    if(idc == 0)
+    {
+      dstT[1] = WlzTstIndexedPlanesTime() - t0;
+      (void )WlzFreeObj(rObj);
+    }
+    else
+    {
+      *dstObj = rObj;
+    }
+  }
+  if(fP != NULL)
+  {
+    (void )((pipe)? pclose(fP): fclose(fP));
+  }
+  (void )unlink(fName);
+  return(errNum);
+}
+
+/* Returns zero if the two objects are written (without a plane index)
+ * to identical bytes, otherwise one. */
+static int	WlzTstIndexedPlanesWriteCmp(WlzObject *o0, WlzObject *o1,
+					    WlzErrorNum *dstErr)
+{
+  int		c0,
+  		c1,
+  		same = 0;
+  FILE		*f0 = NULL,
+  		*f1 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(((f0 = tmpfile()) == NULL) || ((f1 = tmpfile()) == NULL))
+  {
+    errNum = WLZ_ERR_FILE_OPEN;
+  }
+  else if(((errNum = WlzWriteObj(f0, o0)) == WLZ_ERR_NONE) &&
+          ((errNum = WlzWriteObj(f1, o1)) == WLZ_ERR_NONE))
+  {
+    rewind(f0);
+    rewind(f1);
+    do
+    {
+      c0 = getc(f0);
+      c1 = getc(f1);
+    } while((c0 == c1) && (c0 != EOF));
+    same = c0 == c1;
+  }
+  if(f0 != NULL)
+  {
+    (void )fclose(f0);
+  }
+  if(f1 != NULL)
+  {
+    (void )fclose(f1);
+  }
+  *dstErr = errNum;
+  return(!same);
+}
+
+/* Makes a crescent, the difference of two balls so that the planes have
+ * irregular domains of differing sizes, with values which encode the
+ * voxel positions so that misplaced planes or lines are detected, and a
+ * property list. Shape 1 has empty planes and shape 2 has no values. */
+static WlzObject *WlzTstIndexedPlanesMakeObj(WlzGreyType gType, int shape,
+					     int sz, WlzErrorNum *dstErr)
+{
+  WlzValues	val;
+  WlzPixelV	bgdV;
+  WlzObject	*obj[2] = {NULL, NULL},
+		*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgdV.type = WLZ_GREY_INT;
+  bgdV.v.inv = 7;
+  obj[0] = WlzAssignObject(
+	   WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, sz / 2, sz / 2, sz / 2,
+			       sz / 2 + 3, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj[1] = WlzAssignObject(
+	     WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, sz / 3, sz / 2 + sz / 4,
+				 sz / 2, sz / 2 + 3, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzDiffDomain(obj[0], obj[1], &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    val.vox = WlzNewValuesVox(rObj,
+                WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, NULL),
+		bgdV, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzIterateWSpace *itWSp;
+
+    rObj->values = WlzAssignValues(val, NULL);
+    itWSp = WlzIterateInit(rObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+      {
+	int	v;
+
+	v = itWSp->pos.vtX + (3 * itWSp->pos.vtY) + (7 * itWSp->pos.vtZ);
+	switch(gType)
+	{
+	  case WLZ_GREY_UBYTE:
+	    *(itWSp->gP.ubp) = (WlzUByte )(v & 0xff);
+	    break;
+	  case WLZ_GREY_SHORT:
+	    *(itWSp->gP.shp) = (short )(v - 100);
+	    break;
+	  case WLZ_GREY_INT:
+	    *(itWSp->gP.inp) = v * 1000;
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    *(itWSp->gP.flp) = (float )v + 0.25f;
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    *(itWSp->gP.dbp) = v + (1.0 / 3.0);
+	    break;
+	  case WLZ_GREY_RGBA:
+	    WLZ_RGBA_RGBA_SET(*(itWSp->gP.rgbp), itWSp->pos.vtX & 0xff,
+			      itWSp->pos.vtY & 0xff, itWSp->pos.vtZ & 0xff,
+			      255);
+	    break;
+	  default:
+	    break;
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+    }
+    WlzIterateWSpFree(itWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzPlaneDomain *pDom;
+
+    pDom = rObj->domain.p;
+    pDom->voxel_size[0] = 0.5f;
+    pDom->voxel_size[2] = 2.0f;
+    if(shape == 1)
+    {
+      int	idp;
+
+      /* Clear every third plane. */
+      for(idp = 1; idp <= pDom->lastpl - pDom->plane1; idp += 3)
+      {
+	(void )WlzFreeDomain(pDom->domains[idp]);
+	pDom->domains[idp].core = NULL;
+	(void )WlzFreeValues(rObj->values.vox->values[idp]);
+	rObj->values.vox->values[idp].core = NULL;
+      }
+    }
+    else if(shape == 2)
+    {
+      (void )WlzFreeVoxelValueTb(rObj->values.vox);
+      rObj->values.core = NULL;
+    }
+    rObj->plist = WlzAssignPropertyList(WlzMakePropertyList(NULL), NULL);
+    if(rObj->plist == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      WlzProperty prop;
+
+      prop.name = WlzMakeNameProperty("WlzTstIndexedPlanes", &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	(void )AlcDLPListEntryAppend(rObj->plist->list, NULL,
+	                             (void *)(prop.core),
+				     WlzFreePropertyListEntry);
+      }
+    }
+  }
+  (void )WlzFreeObj(obj[0]);
+  (void )WlzFreeObj(obj[1]);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(rObj);
+    rObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
@@ -0,0 +1,378 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstIndexedSurface_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstIndexedSurface.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test and benchmark for indexed surfaces computed from 3D
+* 		contours. A surface computed directly using
+* 		WlzContourObjIndexedSurface() is compared with one
+* 		converted from the model computed by WlzContourObj(),
+* 		the direct surface is then converted to a model and
+* 		back again and compared with itself. The times taken
+* 		are reported.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstIndexedSurfaceTime(void);
+static int			WlzTstIndexedSurfaceCmp(
+				  WlzIndexedSurface *s0,
+				  WlzIndexedSurface *s1);
+static int			WlzTstIndexedSurfaceCmpSorted(
+				  WlzIndexedSurface *s0,
+				  WlzIndexedSurface *s1);
+static int			WlzTstIndexedSurfaceVtxCmp(
+				  const void *p0,
+				  const void *p1);
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+		sz = 128,
+		nBad = 0,
+  		ok = 1,
+  		usage = 0;
+  double	ctrVal = 100.0,
+  		ctrWth = 1.0;
+  double	t[3] = {0.0, 0.0, 0.0};
+  const char	*errMsgStr;
+  WlzObject	*obj = NULL;
+  WlzGMModel	*model = NULL;
+  WlzIndexedSurface *srf[3] = {NULL, NULL, NULL};
+  WlzContourMethod ctrMtd = WLZ_CONTOUR_MTD_ISO;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "ghs:v:w:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'g':
+        ctrMtd = WLZ_CONTOUR_MTD_GRD;
+	ctrVal = 10.0;
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 4);
+	break;
+      case 'v':
+        usage = sscanf(optarg, "%lg", &ctrVal) != 1;
+	break;
+      case 'w':
+        usage = (sscanf(optarg, "%lg", &ctrWth) != 1) || (ctrWth <= 0.0);
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  /* Create a sphere with grey values which vary smoothly with
+   * position, giving many separate surfaces. */
+  if(ok)
+  {
+    WlzValues	val;
+    WlzPixelV	bgdV;
+    WlzObjectType gTType;
+
+    bgdV.type = WLZ_GREY_INT;
+    bgdV.v.inv = 0;
+    obj = WlzAssignObject(
+	  WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, sz / 2, sz / 2, sz / 2,
+			      sz / 2, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gTType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, WLZ_GREY_UBYTE,
+				     NULL);
+      val.vox = WlzNewValuesVox(obj, gTType, bgdV, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzIterateWSpace *itWSp;
+
+      obj->values = WlzAssignValues(val, NULL);
+      itWSp = WlzIterateInit(obj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+	{
+	  *(itWSp->gP.ubp) = (WlzUByte )
+	      WLZ_NINT(100.0 + 80.0 * sin(itWSp->pos.vtX / 7.0) *
+			       cos(itWSp->pos.vtY / 9.0) *
+			       sin(itWSp->pos.vtZ / 11.0));
+	}
+	if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+      }
+      WlzIterateWSpFree(itWSp);
+    }
+  }
+  /* Compute a surface via a contour and its model. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    double	t0;
+    WlzDomain	dom;
+
+    t0 = WlzTstIndexedSurfaceTime();
+    dom.ctr = WlzContourObj(obj, ctrMtd, ctrVal, ctrWth, 0, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dom = WlzAssignDomain(dom, NULL);
+      srf[0] = WlzIndexedSurfaceFromGMModel(dom.ctr->model, &errNum);
+      (void )WlzFreeContour(dom.ctr);
+    }
+    t[0] = WlzTstIndexedSurfaceTime() - t0;
+  }
+  /* Compute the surface directly. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    double	t0;
+
+    t0 = WlzTstIndexedSurfaceTime();
+    srf[1] = WlzContourObjIndexedSurface(obj, ctrMtd, ctrVal, ctrWth, 0,
+                                         &errNum);
+    t[1] = WlzTstIndexedSurfaceTime() - t0;
+  }
+  /* Convert the direct surface to a model and back again. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    double	t0;
+
+    t0 = WlzTstIndexedSurfaceTime();
+    model = WlzIndexedSurfaceToGMModel(srf[1], &errNum);
+    t[2] = WlzTstIndexedSurfaceTime() - t0;
+    if(errNum == WLZ_ERR_NONE)
+    {
+      srf[2] = WlzIndexedSurfaceFromGMModel(model, &errNum);
+    }
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    nBad = WlzTstIndexedSurfaceCmpSorted(srf[0], srf[1]) +
+           WlzTstIndexedSurfaceCmp(srf[1], srf[2]);
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to compute surfaces (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d vertices, %d faces, via model %gs, "
+		    "direct %gs, to model %gs, %d differences (%s)\n",
+		    argv[0], srf[1]->nVtx, srf[1]->nFce, t[0], t[1], t[2],
+		    nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  (void )WlzFreeIndexedSurface(srf[0]);
+  (void )WlzFreeIndexedSurface(srf[1]);
+  (void )WlzFreeIndexedSurface(srf[2]);
+  (void )WlzGMModelFree(model);
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-g] [-h] [-s#] [-v#] [-w#]\n"
+    "Tests and times indexed surfaces computed from 3D contours of a\n"
+    "synthetic volume.\n"
+    "Options are:\n"
+    "  -g  Maximal gradient instead of iso-value contours.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -s  Volume size (default %d).\n"
+    "  -v  Iso-value or minimum gradient (default %g or %g).\n"
+    "  -w  Gradient filter width parameter (default %g).\n",
+    argv[0], 128, 100.0, 10.0, 1.0);
+  }
+  return(!ok);
+}
+
+static double	WlzTstIndexedSurfaceTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
+
+/* Compares the vertices and faces of the two surfaces index by index,
+ * allowing the vertices of a face to be rotated, returning the number
+ * of differences. */
+static int	WlzTstIndexedSurfaceCmp(WlzIndexedSurface *s0,
+					WlzIndexedSurface *s1)
+{
+  int		idx,
+  		nBad = 0;
+
+  if((s0->nVtx != s1->nVtx) || (s0->nFce != s1->nFce))
+  {
+    ++nBad;
+  }
+  for(idx = 0; (nBad == 0) && (idx < s0->nVtx); ++idx)
+  {
+    if(WlzTstIndexedSurfaceVtxCmp(s0->vtx + idx, s1->vtx + idx))
+    {
+      ++nBad;
+    }
+  }
+  for(idx = 0; (nBad == 0) && (idx < s0->nFce); ++idx)
+  {
+    int		r;
+    int		*f0,
+    		*f1;
+
+    f0 = s0->idx + (3 * idx);
+    f1 = s1->idx + (3 * idx);
+    r = (f0[0] == f1[0])? 0: (f0[0] == f1[1])? 1: 2;
+    if((f0[0] != f1[r]) || (f0[1] != f1[(r + 1) % 3]) ||
+       (f0[2] != f1[(r + 2) % 3]))
+    {
+      ++nBad;
+    }
+  }
+  return(nBad);
+}
+
+/* Compares the sorted vertex positions of the two surfaces and the
+ * sorted positions of the least vertex of each face, returning the
+ * number of differences. Vertex indices may differ between the
+ * surfaces. */
+static int	WlzTstIndexedSurfaceCmpSorted(WlzIndexedSurface *s0,
+					      WlzIndexedSurface *s1)
+{
+  int		idx,
+  		nBad = 0;
+  WlzDVertex3	*buf[2] = {NULL, NULL};
+
+  if((s0->nVtx != s1->nVtx) || (s0->nFce != s1->nFce) ||
+     ((buf[0] = (WlzDVertex3 *)AlcMalloc(sizeof(WlzDVertex3) *
+                (s0->nVtx + s0->nFce))) == NULL) ||
+     ((buf[1] = (WlzDVertex3 *)AlcMalloc(sizeof(WlzDVertex3) *
+                (s1->nVtx + s1->nFce))) == NULL))
+  {
+    ++nBad;
+  }
+  else
+  {
+    int		idS;
+    WlzIndexedSurface *s[2];
+
+    s[0] = s0;
+    s[1] = s1;
+    for(idS = 0; idS < 2; ++idS)
+    {
+      WlzDVertex3 *fBuf;
+
+      fBuf = buf[idS] + s[idS]->nVtx;
+      (void )memcpy(buf[idS], s[idS]->vtx,
+                     sizeof(WlzDVertex3) * s[idS]->nVtx);
+      for(idx = 0; idx < s[idS]->nFce; ++idx)
+      {
+	int	idV;
+	int	*f;
+
+	f = s[idS]->idx + (3 * idx);
+        fBuf[idx] = s[idS]->vtx[f[0]];
+	for(idV = 1; idV < 3; ++idV)
+	{
+	  if(WlzTstIndexedSurfaceVtxCmp(s[idS]->vtx + f[idV], fBuf + idx) < 0)
+	  {
+	    fBuf[idx] = s[idS]->vtx[f[idV]];
+	  }
+	}
+      }
+      qsort(buf[idS], s[idS]->nVtx, sizeof(WlzDVertex3),
+            WlzTstIndexedSurfaceVtxCmp);
+      qsort(fBuf, s[idS]->nFce, sizeof(WlzDVertex3),
+            WlzTstIndexedSurfaceVtxCmp);
+    }
+    for(idx = 0; idx < s0->nVtx + s0->nFce; ++idx)
+    {
+      if(WlzTstIndexedSurfaceVtxCmp(buf[0] + idx, buf[1] + idx))
+      {
+        ++nBad;
+      }
+    }
+  }
+  AlcFree(buf[0]);
+  AlcFree(buf[1]);
+  return(nBad);
+}
+
+/* Lexicographic comparison of two vertices for qsort(). */
+static int	WlzTstIndexedSurfaceVtxCmp(const void *p0, const void *p1)
+{
+  int		cmp = 0;
+  const WlzDVertex3 *v0,
+  		*v1;
+
+  v0 = (const WlzDVertex3 *)p0;
+  v1 = (const WlzDVertex3 *)p1;
+  if(v0->vtX != v1->vtX)
+  {
+    cmp = (v0->vtX < v1->vtX)? -1: 1;
+  }
+  else if(v0->vtY != v1->vtY)
+  {
+    cmp = (v0->vtY < v1->vtY)? -1: 1;
+  }
+  else if(v0->vtZ != v1->vtZ)
+  {
+    cmp = (v0->vtZ < v1->vtZ)? -1: 1;
+  }
+  return(cmp);
+}
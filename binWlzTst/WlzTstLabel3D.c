@@ -0,0 +1,773 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstLabel3D_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstLabel3D.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the labeling of 3D domains by WlzLabel3D().
+* 		A random volume, which is sparse in its first planes and
+* 		dense in its last, is labeled using 6 and 26-connectivity
+* 		with and without ignoring small fragments, using one and
+* 		then several threads. The labeled objects must be the
+* 		components found by a voxel flood fill, in the same order.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static void			WlzTstLabel3DSetThreads(
+				  int nThr);
+static int			WlzTstLabel3DNbr(
+				  int dim,
+				  int full,
+				  int nbr[26][3]);
+static int			WlzTstLabel3DFlood(
+				  const WlzUByte *bm,
+				  int *lbl,
+				  WlzIVertex3 sz,
+				  int p0,
+				  int p1,
+				  int nNbr,
+				  int nbr[26][3],
+				  int *stk);
+static int			WlzTstLabel3DFill(
+				  const WlzUByte *bm,
+				  int *lbl,
+				  WlzIVertex3 sz,
+				  WlzConnectType con,
+				  int ignLn,
+				  WlzErrorNum *dstErr);
+static int			WlzTstLabel3DCmp(
+				  WlzCompoundArray *cObj,
+				  const int *lbl,
+				  int nC,
+				  WlzIVertex3 sz,
+				  WlzIVertex3 org,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzTstLabel3DFirst(
+				  WlzObject *obj,
+				  int *dstLn,
+				  int *dstKl);
+static int			WlzTstLabel3DPlanes(
+				  WlzObject *obj,
+				  WlzConnectType con,
+				  int ignLn,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstLabel3DObj(
+				  WlzUByte ***bm,
+				  WlzIVertex3 sz,
+				  WlzIVertex3 org,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idC,
+  		option,
+		sz = 64,
+		nThr = 4,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  int		*lbl = NULL;
+  WlzUByte	***bm = NULL;
+  WlzIVertex3	aSz,
+  		aOrg;
+  WlzObject	*obj = NULL;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvs:t:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 8);
+	break;
+      case 't':
+        usage = (sscanf(optarg, "%d", &nThr) != 1) || (nThr < 1);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    /* Use a box which is not a cube and does not have its origin at
+     * zero. */
+    WLZ_VTX_3_SET(aSz, sz + 3, sz - 5, sz);
+    WLZ_VTX_3_SET(aOrg, -7, 3, 11);
+    if(AlcUnchar3Malloc(&bm, aSz.vtZ, aSz.vtY, aSz.vtX) != ALC_ER_NONE)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if((lbl = (int *)AlcMalloc(sizeof(int) *
+                                    aSz.vtX * aSz.vtY * aSz.vtZ)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      obj = WlzAssignObject(WlzTstLabel3DObj(bm, aSz, aOrg, &errNum), NULL);
+    }
+  }
+  for(idC = 0; ok && (errNum == WLZ_ERR_NONE) && (idC < 4); ++idC)
+  {
+    int		idT,
+    		nC,
+		ignLn;
+    WlzConnectType con;
+
+    con = (idC % 2)? WLZ_26_CONNECTED: WLZ_6_CONNECTED;
+    ignLn = (idC / 2) * 2;
+    nC = WlzTstLabel3DFill(**bm, lbl, aSz, con, ignLn, &errNum);
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < 2); ++idT)
+    {
+      int	bad = 0;
+      WlzObject	*lObj;
+
+      WlzTstLabel3DSetThreads((idT == 0)? 1: nThr);
+      lObj = WlzAssignObject(
+             WlzLabel3D(obj, aSz.vtX * aSz.vtY, ignLn, con, &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	bad = WlzTstLabel3DCmp((WlzCompoundArray *)lObj, lbl, nC, aSz, aOrg,
+	                       &errNum);
+	nBad += bad;
+      }
+      if((errNum == WLZ_ERR_NONE) && (verbose || bad))
+      {
+	(void )printf("%d-connected ignLn = %d threads = %d, "
+		      "%d components %d differences\n",
+		      (con == WLZ_6_CONNECTED)? 6: 26, ignLn,
+		      (idT == 0)? 1: nThr, nC, bad);
+      }
+      (void )WlzFreeObj(lObj);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	bad;
+
+      bad = WlzTstLabel3DPlanes(obj, con, ignLn, &errNum);
+      nBad += bad;
+      if((errNum == WLZ_ERR_NONE) && (verbose || bad))
+      {
+	(void )printf("%d-connected ignLn = %d single planes, "
+		      "%d differences from WlzLabel()\n",
+		      (con == WLZ_6_CONNECTED)? 6: 26, ignLn, bad);
+      }
+    }
+  }
+  (void )WlzFreeObj(obj);
+  AlcFree(lbl);
+  (void )AlcUnchar3Free(bm);
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to label the domain (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d differences (%s)\n",
+		    argv[0], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-s#] [-t#]\n"
+    "Tests that WlzLabel3D() finds the same components, in the same\n"
+    "order, as a voxel flood fill of a random volume using 6 and\n"
+    "26-connectivity, with and without ignoring small fragments and\n"
+    "with one and several threads. Each plane is also labeled on its\n"
+    "own, which must give the same objects as the 2D WlzLabel().\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, reporting each labeling.\n"
+    "  -s  Approximate size of the volume (default %d).\n"
+    "  -t  Number of threads used after one thread (default %d).\n",
+    argv[0], 64, 4);
+  }
+  return(!ok);
+}
+
+/* Sets the number of threads used by the following parallel regions. */
+static void	WlzTstLabel3DSetThreads(int nThr)
+{
+#ifdef _OPENMP
+  omp_set_num_threads(nThr);
+#endif
+}
+
+/* Sets the neighbour offsets for 4 or 8-connectivity (dim 2) or 6
+ * or 26-connectivity (dim 3), full being non-zero for 8 and 26, and
+ * returns the number of neighbours. */
+static int	WlzTstLabel3DNbr(int dim, int full, int nbr[26][3])
+{
+  int		dx,
+  		dy,
+		dz,
+		n = 0;
+
+  for(dz = (dim == 2)? 0: -1; dz <= ((dim == 2)? 0: 1); ++dz)
+  {
+    for(dy = -1; dy <= 1; ++dy)
+    {
+      for(dx = -1; dx <= 1; ++dx)
+      {
+        int	m;
+
+	m = abs(dx) + abs(dy) + abs(dz);
+	if((m > 0) && (full || (m == 1)))
+	{
+	  nbr[n][0] = dx;
+	  nbr[n][1] = dy;
+	  nbr[n][2] = dz;
+	  ++n;
+	}
+      }
+    }
+  }
+  return(n);
+}
+
+/* Labels the set voxels of planes p0 to p1 - 1 by flood filling them
+ * in raster (plane, line, column) order using the given neighbours,
+ * so that the components are numbered from 1 in the order of their
+ * first voxel. The labels of the planes must be zero on entry, the
+ * stack must have room for all their voxels and the number of
+ * components is returned. */
+static int	WlzTstLabel3DFlood(const WlzUByte *bm, int *lbl,
+				   WlzIVertex3 sz, int p0, int p1,
+				   int nNbr, int nbr[26][3], int *stk)
+{
+  int		i,
+  		i0,
+		i1,
+		nC = 0;
+
+  i0 = p0 * sz.vtY * sz.vtX;
+  i1 = p1 * sz.vtY * sz.vtX;
+  for(i = i0; i < i1; ++i)
+  {
+    if(bm[i] && (lbl[i] == 0))
+    {
+      int	nS = 0;
+
+      lbl[i] = ++nC;
+      stk[nS++] = i;
+      while(nS > 0)
+      {
+        int	j,
+		k,
+		x,
+		y,
+		z;
+
+	j = stk[--nS];
+	x = j % sz.vtX;
+	y = (j / sz.vtX) % sz.vtY;
+	z = j / (sz.vtX * sz.vtY);
+	for(k = 0; k < nNbr; ++k)
+	{
+	  int	nx,
+	  	ny,
+		nz;
+
+	  nx = x + nbr[k][0];
+	  ny = y + nbr[k][1];
+	  nz = z + nbr[k][2];
+	  if((nx >= 0) && (nx < sz.vtX) && (ny >= 0) && (ny < sz.vtY) &&
+	     (nz >= p0) && (nz < p1))
+	  {
+	    int	l;
+
+	    l = (nz * sz.vtY + ny) * sz.vtX + nx;
+	    if(bm[l] && (lbl[l] == 0))
+	    {
+	      lbl[l] = nC;
+	      stk[nS++] = l;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  return(nC);
+}
+
+/* Labels the set voxels of the bitmap into lbl and returns the number
+ * of components. When ignLn is greater than zero the 2D fragments of
+ * each plane which span fewer than ignLn + 1 lines or columns are
+ * first removed, as documented for WlzLabel3D(). */
+static int	WlzTstLabel3DFill(const WlzUByte *bm, int *lbl,
+				  WlzIVertex3 sz, WlzConnectType con,
+				  int ignLn, WlzErrorNum *dstErr)
+{
+  int		i,
+  		nC = 0,
+		nNbr,
+  		nV;
+  int		nbr[26][3];
+  int		*stk = NULL,
+  		*box = NULL;
+  WlzUByte	*kp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nV = sz.vtX * sz.vtY * sz.vtZ;
+  if(((stk = (int *)AlcMalloc(sizeof(int) * nV)) == NULL) ||
+     ((kp = (WlzUByte *)AlcMalloc(nV)) == NULL) ||
+     ((box = (int *)AlcMalloc(sizeof(int) * 4 * sz.vtX * sz.vtY)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    (void )memcpy(kp, bm, nV);
+    (void )memset(lbl, 0, sizeof(int) * nV);
+    if(ignLn > 0)
+    {
+      int	p,
+      		nP;
+
+      nP = sz.vtX * sz.vtY;
+      nNbr = WlzTstLabel3DNbr(2, con != WLZ_6_CONNECTED, nbr);
+      for(p = 0; p < sz.vtZ; ++p)
+      {
+	int	f,
+		nF;
+	int	*pLbl;
+
+	pLbl = lbl + p * nP;
+	nF = WlzTstLabel3DFlood(bm, lbl, sz, p, p + 1, nNbr, nbr, stk);
+	for(f = 0; f < nF; ++f)
+	{
+	  box[4 * f] = box[4 * f + 2] = INT_MAX;
+	  box[4 * f + 1] = box[4 * f + 3] = INT_MIN;
+	}
+	for(i = 0; i < nP; ++i)
+	{
+	  if(pLbl[i])
+	  {
+	    int	*b;
+
+	    b = box + 4 * (pLbl[i] - 1);
+	    b[0] = ALG_MIN(b[0], i / sz.vtX);
+	    b[1] = ALG_MAX(b[1], i / sz.vtX);
+	    b[2] = ALG_MIN(b[2], i % sz.vtX);
+	    b[3] = ALG_MAX(b[3], i % sz.vtX);
+	  }
+	}
+	for(i = 0; i < nP; ++i)
+	{
+	  if(pLbl[i])
+	  {
+	    int	*b;
+
+	    b = box + 4 * (pLbl[i] - 1);
+	    if(((b[1] - b[0]) < ignLn) || ((b[3] - b[2]) < ignLn))
+	    {
+	      kp[p * nP + i] = 0;
+	    }
+	    pLbl[i] = 0;
+	  }
+	}
+      }
+    }
+    nNbr = WlzTstLabel3DNbr(3, con != WLZ_6_CONNECTED, nbr);
+    nC = WlzTstLabel3DFlood(kp, lbl, sz, 0, sz.vtZ, nNbr, nbr, stk);
+  }
+  AlcFree(stk);
+  AlcFree(kp);
+  AlcFree(box);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nC);
+}
+
+/* Returns the number of labeled objects which are not the flood fill
+ * component with the same index, counting a difference in the number
+ * of objects as one more. */
+static int	WlzTstLabel3DCmp(WlzCompoundArray *cObj, const int *lbl,
+				 int nC, WlzIVertex3 sz, WlzIVertex3 org,
+				 WlzErrorNum *dstErr)
+{
+  int		i,
+		nV,
+		nBad = 0;
+  int		*cnt = NULL;
+  WlzValues	nulVal;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nulVal.core = NULL;
+  nV = sz.vtX * sz.vtY * sz.vtZ;
+  if((cnt = (int *)AlcCalloc(nC + 1, sizeof(int))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    for(i = 0; i < nV; ++i)
+    {
+      ++cnt[lbl[i]];
+    }
+    nBad = cObj->n != nC;
+  }
+  for(i = 0; (errNum == WLZ_ERR_NONE) && (i < cObj->n); ++i)
+  {
+    int		p,
+    		bad = 0,
+    		nVx = 0;
+    WlzPlaneDomain *pDom;
+
+    pDom = cObj->o[i]->domain.p;
+    for(p = pDom->plane1; (errNum == WLZ_ERR_NONE) && (p <= pDom->lastpl);
+        ++p)
+    {
+      WlzDomain	dom2;
+      WlzObject	*obj2;
+      WlzIntervalWSpace iWSp;
+
+      dom2 = pDom->domains[p - pDom->plane1];
+      if(dom2.core == NULL)
+      {
+        continue;
+      }
+      obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, nulVal, NULL, NULL,
+                         &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzInitRasterScan(obj2, &iWSp, WLZ_RASTERDIR_ILIC);
+      }
+      while((errNum == WLZ_ERR_NONE) &&
+            ((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE))
+      {
+	int	k,
+		x,
+		y,
+		z;
+
+	y = iWSp.linpos - org.vtY;
+	z = p - org.vtZ;
+	for(k = iWSp.lftpos; k <= iWSp.rgtpos; ++k)
+	{
+	  x = k - org.vtX;
+	  if((x < 0) || (x >= sz.vtX) || (y < 0) || (y >= sz.vtY) ||
+	     (z < 0) || (z >= sz.vtZ) ||
+	     (lbl[(z * sz.vtY + y) * sz.vtX + x] != i + 1))
+	  {
+	    bad = 1;
+	  }
+	  ++nVx;
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+        errNum = WLZ_ERR_NONE;
+      }
+      (void )WlzFreeObj(obj2);
+    }
+    if((i >= nC) || (nVx != cnt[i + 1]))
+    {
+      bad = 1;
+    }
+    nBad += bad;
+  }
+  AlcFree(cnt);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nBad);
+}
+
+/* Finds the line and column of the first pixel of the given 2D domain
+ * object in raster order. */
+static WlzErrorNum WlzTstLabel3DFirst(WlzObject *obj, int *dstLn,
+				      int *dstKl)
+{
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum;
+
+  errNum = WlzInitRasterScan(obj, &iWSp, WLZ_RASTERDIR_ILIC);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzNextInterval(&iWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *dstLn = iWSp.linpos;
+    *dstKl = iWSp.lftpos;
+  }
+  return(errNum);
+}
+
+/* Labels each plane of the object on its own using WlzLabel3D() and
+ * as a 2D object using WlzLabel() with 4 or 8-connectivity, and
+ * returns the number of planes for which the labeled domains differ.
+ * WlzLabel() does not order its objects in raster order, so they are
+ * matched by their first pixel. */
+static int	WlzTstLabel3DPlanes(WlzObject *obj, WlzConnectType con,
+				    int ignLn, WlzErrorNum *dstErr)
+{
+  int		p,
+  		nBad = 0;
+  WlzPlaneDomain *pDom;
+  WlzValues	nulVal;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nulVal.core = NULL;
+  pDom = obj->domain.p;
+  for(p = pDom->plane1; (errNum == WLZ_ERR_NONE) && (p <= pDom->lastpl);
+      ++p)
+  {
+    int		i,
+    		bad = 0,
+    		n2 = 0,
+		maxObj;
+    WlzDomain	dom2,
+    		dom3;
+    WlzObject	*obj2 = NULL,
+    		*obj3 = NULL,
+		*lObj = NULL;
+    WlzObject	**lObj2 = NULL;
+    WlzCompoundArray *cObj;
+
+    dom3.core = NULL;
+    dom2 = pDom->domains[p - pDom->plane1];
+    if(dom2.core == NULL)
+    {
+      continue;
+    }
+    maxObj = (dom2.i->lastln - dom2.i->line1 + 1) *
+             (dom2.i->lastkl - dom2.i->kol1 + 1);
+    obj2 = WlzAssignObject(
+           WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, nulVal, NULL, NULL, &errNum),
+	   NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dom3.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN, p, p,
+      				  dom2.i->line1, dom2.i->lastln,
+				  dom2.i->kol1, dom2.i->lastkl, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dom3.p->domains[0] = WlzAssignDomain(dom2, NULL);
+      obj3 = WlzAssignObject(
+             WlzMakeMain(WLZ_3D_DOMAINOBJ, dom3, nulVal, NULL, NULL,
+	                 &errNum), NULL);
+      if(obj3 == NULL)
+      {
+        (void )WlzFreePlaneDomain(dom3.p);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzLabel(obj2, &n2, &lObj2, maxObj, ignLn,
+                        (con == WLZ_6_CONNECTED)? WLZ_4_CONNECTED:
+			                          WLZ_8_CONNECTED);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      lObj = WlzAssignObject(WlzLabel3D(obj3, maxObj, ignLn, con, &errNum),
+      			     NULL);
+      if(errNum == WLZ_ERR_DOMAIN_DATA)
+      {
+        /* All the fragments are ignored. */
+	errNum = WLZ_ERR_NONE;
+	bad = n2 != 0;
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && lObj)
+    {
+      cObj = (WlzCompoundArray *)lObj;
+      bad = cObj->n != n2;
+      for(i = 0; (errNum == WLZ_ERR_NONE) && !bad && (i < n2); ++i)
+      {
+        WlzObject *o0,
+		  *o1 = NULL;
+
+	int	j,
+		ln0,
+		kl0,
+		ln1,
+		kl1;
+
+	o0 = NULL;
+	o1 = WlzAssignObject(
+	     WlzMakeMain(WLZ_2D_DOMAINOBJ, cObj->o[i]->domain.p->domains[0],
+	                 nulVal, NULL, NULL, &errNum), NULL);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzTstLabel3DFirst(o1, &ln1, &kl1);
+	}
+	for(j = 0; (errNum == WLZ_ERR_NONE) && (o0 == NULL) && (j < n2); ++j)
+	{
+	  errNum = WlzTstLabel3DFirst(lObj2[j], &ln0, &kl0);
+	  if((ln0 == ln1) && (kl0 == kl1))
+	  {
+	    o0 = lObj2[j];
+	  }
+	}
+	if(o0 == NULL)
+	{
+	  bad = 1;
+	}
+	else if(errNum == WLZ_ERR_NONE)
+	{
+	  WlzObject *oI;
+
+	  oI = WlzAssignObject(WlzIntersect2(o0, o1, &errNum), NULL);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    WlzLong a0,
+	    	    aI;
+
+	    a0 = WlzArea(o0, &errNum);
+	    aI = (oI->type == WLZ_EMPTY_OBJ)? 0: WlzArea(oI, &errNum);
+	    bad = (a0 != aI) || (WlzArea(o1, &errNum) != aI);
+	  }
+	  (void )WlzFreeObj(oI);
+	}
+	(void )WlzFreeObj(o1);
+      }
+    }
+    nBad += bad;
+    if(lObj2)
+    {
+      for(i = 0; i < n2; ++i)
+      {
+        (void )WlzFreeObj(lObj2[i]);
+      }
+      AlcFree(lObj2);
+    }
+    (void )WlzFreeObj(lObj);
+    (void )WlzFreeObj(obj3);
+    (void )WlzFreeObj(obj2);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nBad);
+}
+
+/* Sets the bitmap to random values, with about 12% of voxels set in
+ * the first plane and 42% in the last, so that the 6-connected
+ * components range from isolated voxels to ones spanning many planes
+ * and the 26-connected components percolate. Returns the domain
+ * object of the set voxels, with the bitmap origin at org. */
+static WlzObject *WlzTstLabel3DObj(WlzUByte ***bm, WlzIVertex3 sz,
+				   WlzIVertex3 org, WlzErrorNum *dstErr)
+{
+  int		x,
+  		y,
+		z;
+  WlzPixelV	thrV;
+  WlzValues	nulVal;
+  WlzObject	*gObj = NULL,
+  		*tObj = NULL,
+		*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nulVal.core = NULL;
+  AlgRandSeed(sz.vtZ);
+  for(z = 0; z < sz.vtZ; ++z)
+  {
+    double	d;
+
+    d = 0.12 + (0.3 * z) / sz.vtZ;
+    for(y = 0; y < sz.vtY; ++y)
+    {
+      for(x = 0; x < sz.vtX; ++x)
+      {
+        bm[z][y][x] = (AlgRandUniform() < d)? 1: 0;
+      }
+    }
+  }
+  gObj = WlzAssignObject(
+         WlzFromArray3D((void ***)bm, sz, org, WLZ_GREY_UBYTE,
+			WLZ_GREY_UBYTE, 0.0, 1.0, 0, 0, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    thrV.type = WLZ_GREY_INT;
+    thrV.v.inv = 1;
+    tObj = WlzAssignObject(
+           WlzThreshold(gObj, thrV, WLZ_THRESH_HIGH, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, tObj->domain, nulVal, NULL, NULL,
+                       &errNum);
+  }
+  (void )WlzFreeObj(tObj);
+  (void )WlzFreeObj(gObj);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
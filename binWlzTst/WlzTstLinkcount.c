@@ -0,0 +1,182 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstLinkcount_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstLinkcount.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Microbenchmark and test for concurrent linkcount changes.
+* 		Many threads repeatedly make objects which share a single
+* 		domain and value table, assign and then free them. The
+* 		elapsed time is reported for an increasing number of
+* 		threads and the final linkcounts are checked.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+  		nThr,
+		maxThr = 1,
+		nItr = 1000000,
+  		ok = 1,
+  		usage = 0;
+  const char	*errMsgStr;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hn:t:";
+
+  opterr = 0;
+#ifdef _OPENMP
+  maxThr = omp_get_max_threads();
+#endif
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'n':
+        usage = (sscanf(optarg, "%d", &nItr) != 1) || (nItr < 1);
+	break;
+      case 't':
+        usage = (sscanf(optarg, "%d", &maxThr) != 1) || (maxThr < 1);
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    WlzPixelV	bgdV;
+
+    bgdV.type = WLZ_GREY_UBYTE;
+    bgdV.v.ubv = 0;
+    obj = WlzAssignObject(
+          WlzMakeRect(0, 63, 0, 63, WLZ_GREY_UBYTE, NULL, bgdV,
+	              NULL, NULL, &errNum), NULL);
+  }
+  for(nThr = 1; ok && (errNum == WLZ_ERR_NONE) && (nThr <= maxThr);
+      nThr = (nThr == maxThr)? maxThr + 1: ALG_MIN(2 * nThr, maxThr))
+  {
+    int		idI,
+    		dLc,
+		vLc;
+    struct timeval times[3];
+
+    dLc = obj->domain.core->linkcount;
+    vLc = obj->values.core->linkcount;
+    gettimeofday(times + 0, NULL);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(static)
+#endif
+    for(idI = 0; idI < nItr; ++idI)
+    {
+      WlzObject	*tObj;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      tObj = WlzAssignObject(
+             WlzMakeMain(WLZ_2D_DOMAINOBJ, obj->domain, obj->values,
+	                 NULL, NULL, &errNum2), NULL);
+      if(errNum2 == WLZ_ERR_NONE)
+      {
+        (void )WlzAssignObject(tObj, NULL);
+	(void )WlzFreeObj(tObj);
+      }
+      (void )WlzFreeObj(tObj);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzTstLinkcount)
+#endif
+	{
+	  errNum = errNum2;
+	}
+      }
+    }
+    gettimeofday(times + 1, NULL);
+    ALC_TIMERSUB(times + 1, times + 0, times + 2);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      ok = (obj->domain.core->linkcount == dLc) &&
+           (obj->values.core->linkcount == vLc);
+      (void )printf("%s: threads %d, time %gs, %g ops/s (%s)\n",
+		    argv[0], nThr,
+		    times[2].tv_sec + (1.0e-06 * times[2].tv_usec),
+		    nItr / (times[2].tv_sec + (1.0e-06 * times[2].tv_usec)),
+		    (ok)? "pass": "FAIL");
+    }
+  }
+  if(ok && (errNum != WLZ_ERR_NONE))
+  {
+    ok = 0;
+    (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+    (void )fprintf(stderr,
+		   "%s: Failed to make, assign or free objects (%s).\n",
+		   argv[0], errMsgStr);
+  }
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-n#] [-t#]\n"
+    "Microbenchmark and test for concurrent linkcount changes. Objects\n"
+    "sharing a single domain and value table are repeatedly made,\n"
+    "assigned and freed using 1, 2, 4, ... threads up to the maximum,\n"
+    "with the elapsed time reported for each number of threads.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -n  Number of make, assign and free iterations (default %d).\n"
+    "  -t  Maximum number of threads (default is the OpenMP maximum).\n",
+    argv[0], 1000000);
+  }
+  return(!ok);
+}
@@ -0,0 +1,325 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstRankFilter_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstRankFilter.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for WlzRankFilter() which compares the sliding
+* 		histogram filter, used for UBYTE, SHORT and INT values
+* 		with a limited range, with the buffer based filter used
+* 		for the same values converted to DOUBLE. 2D and 3D objects
+* 		with random values are filtered with ranks including
+* 		zero and one. INT values with a range too great for the
+* 		histogram (which would overflow an int) are also tested.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static int			WlzTstRankFilterCmp(
+				  WlzObject *iObj,
+				  WlzObject *dObj,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstRankFilterMakeObj(
+				  WlzObjectType oType,
+				  WlzGreyType gType,
+				  int sz,
+				  double vMin,
+				  double vMax,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idC,
+  		option,
+		sz = 24,
+		fSz = 5,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvf:s:";
+  const double	ranks[4] = {0.0, 0.3, 0.5, 1.0};
+  const WlzGreyType gTypes[4] = {WLZ_GREY_UBYTE, WLZ_GREY_SHORT,
+  				 WLZ_GREY_INT, WLZ_GREY_INT};
+  const double	vRng[4][2] = {{0.0, 255.0}, {-3000.0, 3000.0},
+  			      {-30000.0, 30000.0},
+			      {-2000000000.0, 2000000000.0}};
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'f':
+        usage = (sscanf(optarg, "%d", &fSz) != 1) || (fSz < 2);
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 4);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  AlgRandSeed(0);
+  for(idC = 0; ok && (errNum == WLZ_ERR_NONE) && (idC < 8); ++idC)
+  {
+    int		idR;
+    WlzObjectType oType;
+    WlzGreyType	gType;
+
+    oType = (idC < 4)? WLZ_2D_DOMAINOBJ: WLZ_3D_DOMAINOBJ;
+    gType = gTypes[idC % 4];
+    for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < 4); ++idR)
+    {
+      int	bad = 0;
+      WlzObject	*iObj,
+      		*dObj = NULL;
+
+      iObj = WlzAssignObject(
+             WlzTstRankFilterMakeObj(oType, gType, sz, vRng[idC % 4][0],
+	                             vRng[idC % 4][1], &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        dObj = WlzAssignObject(
+	       WlzConvertPix(iObj, WLZ_GREY_DOUBLE, &errNum), NULL);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        errNum = WlzRankFilter(iObj, fSz, ranks[idR]);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        errNum = WlzRankFilter(dObj, fSz, ranks[idR]);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        bad = WlzTstRankFilterCmp(iObj, dObj, &errNum);
+	nBad += bad;
+      }
+      if(verbose && (errNum == WLZ_ERR_NONE))
+      {
+        (void )printf("%s %s range %g,%g rank %g %s\n",
+		      (oType == WLZ_2D_DOMAINOBJ)? "2D": "3D",
+		      WlzStringFromGreyType(gType, NULL),
+		      vRng[idC % 4][0], vRng[idC % 4][1], ranks[idR],
+		      (bad)? "DIFFERENT": "same");
+      }
+      (void )WlzFreeObj(iObj);
+      (void )WlzFreeObj(dObj);
+    }
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to rank filter objects (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d differences (%s)\n",
+		    argv[0], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-f#] [-s#]\n"
+    "Tests WlzRankFilter() by comparing the values of rank filtered 2D\n"
+    "and 3D objects with integral values with those of the same objects\n"
+    "filtered after conversion to double values.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, reporting each test.\n"
+    "  -f  Rank filter size (default %d).\n"
+    "  -s  Diameter of the test objects (default %d).\n",
+    argv[0], 5, 24);
+  }
+  return(!ok);
+}
+
+/* Returns zero if the two objects have the same domains and the values
+ * of the first are equal to the double values of the second, otherwise
+ * one. */
+static int	WlzTstRankFilterCmp(WlzObject *iObj, WlzObject *dObj,
+				    WlzErrorNum *dstErr)
+{
+  int		same = 1;
+  WlzIterateWSpace *it0 = NULL,
+  		*it1 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  it0 = WlzIterateInit(iObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    it1 = WlzIterateInit(dObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while(same && ((errNum = WlzIterate(it0)) == WLZ_ERR_NONE))
+    {
+      double	v;
+
+      if(((errNum = WlzIterate(it1)) != WLZ_ERR_NONE) ||
+	 (it0->pos.vtX != it1->pos.vtX) ||
+	 (it0->pos.vtY != it1->pos.vtY) ||
+	 (it0->pos.vtZ != it1->pos.vtZ))
+      {
+        same = 0;
+      }
+      else
+      {
+	switch(it0->gType)
+	{
+	  case WLZ_GREY_UBYTE:
+	    v = *(it0->gP.ubp);
+	    break;
+	  case WLZ_GREY_SHORT:
+	    v = *(it0->gP.shp);
+	    break;
+	  default:
+	    v = *(it0->gP.inp);
+	    break;
+	}
+        same = v == *(it1->gP.dbp);
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+      same = same && (WlzIterate(it1) == WLZ_ERR_EOO);
+    }
+    else if(same == 0)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  WlzIterateWSpFree(it0);
+  WlzIterateWSpFree(it1);
+  *dstErr = errNum;
+  return(!same);
+}
+
+/* Makes a disc or ball of the given diameter, offset from the origin,
+ * with random values of the given type, uniformly distributed over the
+ * given range. */
+static WlzObject *WlzTstRankFilterMakeObj(WlzObjectType oType,
+					  WlzGreyType gType, int sz,
+					  double vMin, double vMax,
+					  WlzErrorNum *dstErr)
+{
+  double	r;
+  WlzObjectType	gTType;
+  WlzPixelV	bgdV;
+  WlzObject	*obj = NULL,
+  		*rObj = NULL;
+  WlzIterateWSpace *it = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  r = 0.5 * sz;
+  bgdV.type = gType;
+  bgdV.v.dbv = 0.0;
+  obj = WlzAssignObject(
+        WlzMakeSphereObject(oType, r, r + 3, r + 5, r + 7, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gTType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzNewObjectValues(obj, gTType, bgdV, 0, bgdV, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    it = WlzIterateInit(rObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzIterate(it)) == WLZ_ERR_NONE)
+    {
+      double	v;
+
+      v = vMin + (vMax - vMin) * AlgRandUniform();
+      switch(gType)
+      {
+	case WLZ_GREY_UBYTE:
+	  *(it->gP.ubp) = (WlzUByte )WLZ_NINT(v);
+	  break;
+	case WLZ_GREY_SHORT:
+	  *(it->gP.shp) = (short )WLZ_NINT(v);
+	  break;
+	default:
+	  *(it->gP.inp) = WLZ_NINT(v);
+	  break;
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  WlzIterateWSpFree(it);
+  (void )WlzFreeObj(obj);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(rObj);
+    rObj = NULL;
+  }
+  *dstErr = errNum;
+  return(rObj);
+}
@@ -0,0 +1,661 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstRegICP_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstRegICP.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the ICP registration. Source vertices and
+* 		normals which are a transformed and differently sampled
+* 		copy of a 2D or 3D target are registered with one and
+* 		then several threads, both at a single and at multiple
+* 		resolutions, and the transforms must be identical.
+* 		Affine registration without an initial transform, which
+* 		replaces the rigid transform found first, must converge
+* 		to the inverse of the known transform. The blocked least
+* 		squares sums of WlzAffineTransformLSq() must not depend
+* 		on the number of threads, and the distance weighting of
+* 		WlzRegICPTreeAndVertices() must use the greatest match
+* 		distance even when it is the first.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+/* Least distance weight passed to the user weight function during the
+ * first iteration, used to check the distance weighting of
+ * WlzRegICPTreeAndVertices(). */
+typedef struct _WlzTstRegICPWgt
+{
+  int		calls;
+  int		nFirst;
+  double	minWVx;
+} WlzTstRegICPWgt;
+
+static void			WlzTstRegICPSetThreads(
+				  int nThr);
+static int			WlzTstRegICPTrSame(
+				  WlzAffineTransform *tr0,
+				  WlzAffineTransform *tr1);
+static int			WlzTstRegICPTrInverse(
+				  WlzAffineTransform *tr0,
+				  WlzAffineTransform *tr1);
+static int			WlzTstRegICPThreads(
+				  WlzVertexType vType,
+				  int n,
+				  int nThr,
+				  int verbose,
+				  WlzErrorNum *dstErr);
+static int			WlzTstRegICPLSq(
+				  WlzVertexType vType,
+				  int n,
+				  int nThr,
+				  int verbose,
+				  WlzErrorNum *dstErr);
+static int			WlzTstRegICPMaxDist(
+				  int n,
+				  int verbose,
+				  WlzErrorNum *dstErr);
+static double			WlzTstRegICPWgtFn(
+				  WlzVertexType vType,
+				  WlzAffineTransform *tr,
+				  AlcKDTTree *tree,
+				  WlzVertexP tVx,
+				  WlzVertexP sVx,
+				  WlzVertex tV,
+				  WlzVertex sV,
+				  double wVx,
+				  double wNr,
+				  void *data);
+static WlzErrorNum		WlzTstRegICPMakeVertices(
+				  WlzVertexType vType,
+				  int n,
+				  double off,
+				  WlzAffineTransform *tr,
+				  WlzVertexP *dstVx,
+				  WlzVertexP *dstNr);
+
+int		main(int argc, char *argv[])
+{
+  int		idD,
+  		option,
+		n = 3000,
+		nThr = 4,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvn:t:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'n':
+        usage = (sscanf(optarg, "%d", &n) != 1) || (n < 1500);
+	break;
+      case 't':
+        usage = (sscanf(optarg, "%d", &nThr) != 1) || (nThr < 2);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  for(idD = 0; ok && (errNum == WLZ_ERR_NONE) && (idD < 2); ++idD)
+  {
+    WlzVertexType vType;
+
+    vType = (idD == 0)? WLZ_VERTEX_D2: WLZ_VERTEX_D3;
+    nBad += WlzTstRegICPThreads(vType, n, nThr, verbose, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nBad += WlzTstRegICPLSq(vType, n, nThr, verbose, &errNum);
+    }
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    nBad += WlzTstRegICPMaxDist(n, verbose, &errNum);
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to register vertices (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d differences (%s)\n",
+		    argv[0], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-n#] [-t#]\n"
+    "Tests the ICP registration of 2D and 3D vertices with normals, which\n"
+    "must give identical transforms with one and several threads and\n"
+    "must converge for affine registration without an initial transform.\n"
+    "Also tests that the least squares affine transforms do not depend\n"
+    "on the number of threads and that WlzRegICPTreeAndVertices() weights\n"
+    "the matches using the greatest distance.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, reporting each test.\n"
+    "  -n  Number of vertices, at least 1500 for the registrations to\n"
+    "      converge closely (default %d).\n"
+    "  -t  Number of threads compared with one thread (default %d).\n",
+    argv[0], 3000, 4);
+  }
+  return(!ok);
+}
+
+/* Sets the number of threads used by the following parallel regions. */
+static void	WlzTstRegICPSetThreads(int nThr)
+{
+#ifdef _OPENMP
+  omp_set_num_threads(nThr);
+#endif
+}
+
+/* Returns non-zero if the two transforms have identical matrices. */
+static int	WlzTstRegICPTrSame(WlzAffineTransform *tr0,
+				   WlzAffineTransform *tr1)
+{
+  int		idR,
+  		same;
+
+  same = (tr0 != NULL) && (tr1 != NULL);
+  for(idR = 0; same && (idR < 4); ++idR)
+  {
+    same = memcmp(tr0->mat[idR], tr1->mat[idR], 4 * sizeof(double)) == 0;
+  }
+  return(same);
+}
+
+/* Returns non-zero if the product of the two transforms is close to the
+ * identity transform, ie the second is the inverse of the first. The
+ * last column of the matrix is the translation. The tolerances allow for
+ * the bias of the weighted rigid least squares fit. */
+static int	WlzTstRegICPTrInverse(WlzAffineTransform *tr0,
+				      WlzAffineTransform *tr1)
+{
+  int		idR,
+  		idC,
+		dim,
+  		inv = 0;
+  WlzAffineTransform *pTr;
+
+  pTr = WlzAffineTransformProduct(tr0, tr1, NULL);
+  if(pTr != NULL)
+  {
+    inv = 1;
+    dim = (WlzAffineTransformDimension(pTr, NULL) == 2)? 2: 3;
+    for(idR = 0; inv && (idR < dim); ++idR)
+    {
+      for(idC = 0; inv && (idC <= dim); ++idC)
+      {
+	double	d;
+
+	d = fabs(pTr->mat[idR][idC] - ((idR == idC)? 1.0: 0.0));
+	inv = d < ((idC == dim)? 0.5: 1.0e-2);
+      }
+    }
+    (void )WlzFreeAffineTransform(pTr);
+  }
+  return(inv);
+}
+
+/* Registers a transformed copy of target vertices to the target using
+ * one and then the given number of threads, rigidly at a single and then
+ * at three resolutions and then affine without an initial transform.
+ * Returns the number of registrations which either differ with the
+ * number of threads or do not find the inverse of the transform. */
+static int	WlzTstRegICPThreads(WlzVertexType vType, int n, int nThr,
+				    int verbose, WlzErrorNum *dstErr)
+{
+  int		idR,
+  		nBad = 0;
+  WlzVertexP	tVx,
+  		tNr,
+		sVx,
+		sNr;
+  WlzAffineTransform *tr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tVx.v = tNr.v = sVx.v = sNr.v = NULL;
+  tr = WlzAffineTransformFromPrimVal(
+       (vType == WLZ_VERTEX_D2)? WLZ_TRANSFORM_2D_AFFINE:
+                                 WLZ_TRANSFORM_3D_AFFINE,
+       2.0, -1.5, (vType == WLZ_VERTEX_D2)? 0.0: 1.0, 1.0,
+       (vType == WLZ_VERTEX_D2)? 0.05: 0.02,
+       (vType == WLZ_VERTEX_D2)? 0.0: 0.01, 0.0, 0.0, 0.0, 0,
+       &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzTstRegICPMakeVertices(vType, n, 0.0, NULL, &tVx, &tNr);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzTstRegICPMakeVertices(vType, n, 0.0, tr, &sVx, &sNr);
+  }
+  for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < 3); ++idR)
+  {
+    int		idT,
+    		bad;
+    int		conv[2] = {0, 0};
+    WlzTransformType trType;
+    WlzAffineTransform *rTr[2] = {NULL, NULL};
+    const int	nLvl[3] = {1, 3, 1};
+
+    trType = (idR < 2)?
+             ((vType == WLZ_VERTEX_D2)? WLZ_TRANSFORM_2D_REG:
+	                                WLZ_TRANSFORM_3D_REG):
+             ((vType == WLZ_VERTEX_D2)? WLZ_TRANSFORM_2D_AFFINE:
+	                                WLZ_TRANSFORM_3D_AFFINE);
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < 2); ++idT)
+    {
+      WlzTstRegICPSetThreads((idT == 0)? 1: nThr);
+      rTr[idT] = WlzRegICPVerticesMR(tVx, tNr, n, sVx, sNr, n, vType, 0,
+				     NULL, trType, conv + idT, NULL, 200,
+				     1.0e-6, 0.25, nLvl[idR], &errNum);
+    }
+    WlzTstRegICPSetThreads(nThr);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bad = !(conv[0] && conv[1] && WlzTstRegICPTrSame(rTr[0], rTr[1]) &&
+	      WlzTstRegICPTrInverse(tr, rTr[0]));
+      nBad += bad;
+      if(verbose)
+      {
+	(void )printf("%s %s %d levels, 1 and %d threads %s\n",
+		      (vType == WLZ_VERTEX_D2)? "2D": "3D",
+		      (idR < 2)? "rigid": "affine", nLvl[idR], nThr,
+		      (bad)? "DIFFERENT": "same");
+      }
+    }
+    (void )WlzFreeAffineTransform(rTr[0]);
+    (void )WlzFreeAffineTransform(rTr[1]);
+  }
+  (void )WlzFreeAffineTransform(tr);
+  AlcFree(tVx.v);
+  AlcFree(tNr.v);
+  AlcFree(sVx.v);
+  AlcFree(sNr.v);
+  *dstErr = errNum;
+  return(nBad);
+}
+
+/* Computes least squares rigid and affine transforms from random
+ * matched vertices, many more than one block of the least squares sums,
+ * using one and then the given number of threads. Returns the number of
+ * transforms which differ. */
+static int	WlzTstRegICPLSq(WlzVertexType vType, int n, int nThr,
+				int verbose, WlzErrorNum *dstErr)
+{
+  int		idR,
+		idV,
+		nV,
+  		nBad = 0;
+  double	*wgt = NULL;
+  WlzVertexP	tVx,
+  		sVx;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nV = 10 * n + 17;
+  tVx.v = sVx.v = NULL;
+  if(((wgt = (double *)AlcMalloc(sizeof(double) * nV)) == NULL) ||
+     ((tVx.d3 = (WlzDVertex3 *)AlcMalloc(sizeof(WlzDVertex3) * nV)) == NULL) ||
+     ((sVx.d3 = (WlzDVertex3 *)AlcMalloc(sizeof(WlzDVertex3) * nV)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    AlgRandSeed(n);
+    for(idV = 0; idV < nV; ++idV)
+    {
+      WlzDVertex3 p;
+
+      p.vtX = 200.0 * AlgRandUniform();
+      p.vtY = 200.0 * AlgRandUniform();
+      p.vtZ = 200.0 * AlgRandUniform();
+      wgt[idV] = AlgRandUniform();
+      if(vType == WLZ_VERTEX_D2)
+      {
+	sVx.d2[idV].vtX = p.vtX;
+	sVx.d2[idV].vtY = p.vtY;
+	tVx.d2[idV].vtX = (0.99 * p.vtX) - (0.1 * p.vtY) + 3.0 +
+			  AlgRandUniform();
+	tVx.d2[idV].vtY = (0.1 * p.vtX) + (1.01 * p.vtY) - 2.0 +
+			  AlgRandUniform();
+      }
+      else
+      {
+	sVx.d3[idV] = p;
+	tVx.d3[idV].vtX = (0.99 * p.vtX) - (0.1 * p.vtY) + 3.0 +
+			  AlgRandUniform();
+	tVx.d3[idV].vtY = (0.1 * p.vtX) + (1.01 * p.vtY) + (0.05 * p.vtZ) -
+			  2.0 + AlgRandUniform();
+	tVx.d3[idV].vtZ = (-0.05 * p.vtY) + p.vtZ + 1.0 + AlgRandUniform();
+      }
+    }
+  }
+  for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < 2); ++idR)
+  {
+    int		idT,
+    		bad;
+    WlzTransformType trType;
+    WlzAffineTransform *rTr[2] = {NULL, NULL};
+
+    trType = (idR == 0)?
+             ((vType == WLZ_VERTEX_D2)? WLZ_TRANSFORM_2D_REG:
+	                                WLZ_TRANSFORM_3D_REG):
+             ((vType == WLZ_VERTEX_D2)? WLZ_TRANSFORM_2D_AFFINE:
+	                                WLZ_TRANSFORM_3D_AFFINE);
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < 2); ++idT)
+    {
+      WlzTstRegICPSetThreads((idT == 0)? 1: nThr);
+      rTr[idT] = WlzAffineTransformLSq(vType, nV, tVx, nV, sVx, nV, wgt,
+				       trType, &errNum);
+    }
+    WlzTstRegICPSetThreads(nThr);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bad = !WlzTstRegICPTrSame(rTr[0], rTr[1]);
+      nBad += bad;
+      if(verbose)
+      {
+	(void )printf("%s %s least squares %d vertices, 1 and %d threads %s\n",
+		      (vType == WLZ_VERTEX_D2)? "2D": "3D",
+		      (idR == 0)? "rigid": "affine", nV, nThr,
+		      (bad)? "DIFFERENT": "same");
+      }
+    }
+    (void )WlzFreeAffineTransform(rTr[0]);
+    (void )WlzFreeAffineTransform(rTr[1]);
+  }
+  AlcFree(wgt);
+  AlcFree(tVx.v);
+  AlcFree(sVx.v);
+  *dstErr = errNum;
+  return(nBad);
+}
+
+/* Registers 2D source vertices, ordered so that the first has the
+ * greatest distance to the target, using WlzRegICPTreeAndVertices()
+ * with a user weight function which finds the least distance weight.
+ * Returns one if the least distance weight is not the minimum distance
+ * weight, ie the greatest distance was not used. */
+static int	WlzTstRegICPMaxDist(int n, int verbose, WlzErrorNum *dstErr)
+{
+  int		idV,
+  		conv = 0,
+  		bad = 0;
+  int		*sIdx = NULL,
+  		*shfBuf = NULL;
+  double	*wgtBuf = NULL;
+  WlzVertexP	tVx,
+  		tNr,
+		sVx,
+		sNr,
+		tVxBuf,
+		sVxBuf;
+  AlcKDTTree	*tree = NULL;
+  WlzAffineTransform *rTr = NULL;
+  WlzTstRegICPWgt wgtData;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	minDistWgt = 0.25;
+
+  tVx.v = tNr.v = sVx.v = sNr.v = tVxBuf.v = sVxBuf.v = NULL;
+  errNum = WlzTstRegICPMakeVertices(WLZ_VERTEX_D2, n, 0.0, NULL,
+                                    &tVx, &tNr);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzTstRegICPMakeVertices(WLZ_VERTEX_D2, n, 0.5, NULL,
+                                      &sVx, &sNr);
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     (((sIdx = (int *)AlcMalloc(sizeof(int) * n)) == NULL) ||
+      ((shfBuf = (int *)AlcMalloc(sizeof(int) * n)) == NULL) ||
+      ((wgtBuf = (double *)AlcMalloc(sizeof(double) * n)) == NULL) ||
+      ((tVxBuf.d2 = (WlzDVertex2 *)
+                    AlcMalloc(sizeof(WlzDVertex2) * n)) == NULL) ||
+      ((sVxBuf.d2 = (WlzDVertex2 *)
+                    AlcMalloc(sizeof(WlzDVertex2) * n)) == NULL)))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Move the source vertices outward along their normals by
+     * decreasing distances, so that the first match has the greatest
+     * distance. */
+    for(idV = 0; idV < n; ++idV)
+    {
+      double	d;
+
+      sIdx[idV] = idV;
+      d = 5.0 * (n - idV) / n;
+      sVx.d2[idV].vtX += d * sNr.d2[idV].vtX;
+      sVx.d2[idV].vtY += d * sNr.d2[idV].vtY;
+    }
+    tree = WlzVerticesBuildTree(WLZ_VERTEX_D2, n, tVx, shfBuf, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wgtData.calls = 0;
+    wgtData.nFirst = n;
+    wgtData.minWVx = DBL_MAX;
+    rTr = WlzRegICPTreeAndVertices(tree, WLZ_TRANSFORM_2D_REG,
+				   WLZ_VERTEX_D2, 0, n, tVx, tNr,
+				   n, sIdx, sVx, sNr, tVxBuf, sVxBuf, wgtBuf,
+				   1, NULL, &conv, WlzTstRegICPWgtFn, &wgtData,
+				   1.0e-6, minDistWgt, &errNum);
+    if(errNum == WLZ_ERR_ALG_CONVERGENCE)
+    {
+      /* Only the weights of the first iteration are needed. */
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bad = (wgtData.calls < n) ||
+          (fabs(wgtData.minWVx - minDistWgt) > 1.0e-9);
+    if(verbose)
+    {
+      (void )printf("2D least distance weight %g of %g %s\n",
+		    wgtData.minWVx, minDistWgt, (bad)? "DIFFERENT": "same");
+    }
+  }
+  (void )WlzFreeAffineTransform(rTr);
+  (void )AlcKDTTreeFree(tree);
+  AlcFree(sIdx);
+  AlcFree(shfBuf);
+  AlcFree(wgtBuf);
+  AlcFree(tVx.v);
+  AlcFree(tNr.v);
+  AlcFree(sVx.v);
+  AlcFree(sNr.v);
+  AlcFree(tVxBuf.v);
+  AlcFree(sVxBuf.v);
+  *dstErr = errNum;
+  return(bad);
+}
+
+/* User weight function which finds the least distance weight of the
+ * first iteration and returns the weight which would otherwise be
+ * used. */
+static double	WlzTstRegICPWgtFn(WlzVertexType vType,
+				  WlzAffineTransform *tr, AlcKDTTree *tree,
+				  WlzVertexP tVx, WlzVertexP sVx,
+				  WlzVertex tV, WlzVertex sV,
+				  double wVx, double wNr, void *data)
+{
+  WlzTstRegICPWgt *wgtData;
+
+  wgtData = (WlzTstRegICPWgt *)data;
+  if(wgtData->calls < wgtData->nFirst)
+  {
+    wgtData->minWVx = WLZ_MIN(wgtData->minWVx, wVx);
+  }
+  ++(wgtData->calls);
+  return(wVx * wNr);
+}
+
+/* Makes vertices and outward unit normals on a closed curve in 2D or a
+ * rounded box in 3D, with the sampling parameter offset by the given
+ * fraction of a step, and transforms them by the given transform which
+ * may be NULL. */
+static WlzErrorNum WlzTstRegICPMakeVertices(WlzVertexType vType, int n,
+					double off, WlzAffineTransform *tr,
+					WlzVertexP *dstVx, WlzVertexP *dstNr)
+{
+  int		idV;
+  size_t	vSz;
+  WlzVertexP	vx,
+  		nr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  vSz = (vType == WLZ_VERTEX_D2)? sizeof(WlzDVertex2): sizeof(WlzDVertex3);
+  nr.v = NULL;
+  if(((vx.v = AlcMalloc(vSz * n)) == NULL) ||
+     ((nr.v = AlcMalloc(vSz * n)) == NULL))
+  {
+    AlcFree(vx.v);
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  for(idV = 0; (errNum == WLZ_ERR_NONE) && (idV < n); ++idV)
+  {
+    if(vType == WLZ_VERTEX_D2)
+    {
+      double	t,
+      		r,
+		dr,
+		l;
+      WlzDVertex2 d;
+
+      /* r(t) = 100(1 + 0.2cos(3t) + 0.1sin(5t)), with the normal
+       * perpendicular to the tangent (r'cos(t) - r sin(t),
+       * r'sin(t) + r cos(t)). */
+      t = 2.0 * ALG_M_PI * (idV + off) / n;
+      r = 100.0 * (1.0 + (0.2 * cos(3.0 * t)) + (0.1 * sin(5.0 * t)));
+      dr = 100.0 * ((-0.6 * sin(3.0 * t)) + (0.5 * cos(5.0 * t)));
+      vx.d2[idV].vtX = r * cos(t);
+      vx.d2[idV].vtY = r * sin(t);
+      d.vtX = (dr * sin(t)) + (r * cos(t));
+      d.vtY = -(dr * cos(t)) + (r * sin(t));
+      l = WLZ_VTX_2_LENGTH(d);
+      WLZ_VTX_2_SCALE(nr.d2[idV], d, 1.0 / l);
+      if(tr)
+      {
+        vx.d2[idV] = WlzAffineTransformVertexD2(tr, vx.d2[idV], NULL);
+        nr.d2[idV] = WlzAffineTransformNormalD2(tr, nr.d2[idV], NULL);
+      }
+    }
+    else
+    {
+      double	l,
+      		s,
+      		t,
+		rho;
+      WlzDVertex3 d,
+      		q;
+      const WlzDVertex3 a = {60.0, 90.0, 120.0};
+
+      /* Directions on a spiral which covers the unit sphere evenly,
+       * scaled to the rounded box |x/ax|^4 + |y/ay|^4 + |z/az|^4 = 1
+       * with the normal along the gradient (x^3/ax^4, y^3/ay^4,
+       * z^3/az^4). */
+      d.vtZ = -1.0 + (2.0 * (idV + off) / n);
+      s = sqrt(1.0 - (d.vtZ * d.vtZ));
+      t = (idV + off) * ALG_M_PI * (3.0 - sqrt(5.0));
+      d.vtX = s * cos(t);
+      d.vtY = s * sin(t);
+      q.vtX = d.vtX / a.vtX;
+      q.vtY = d.vtY / a.vtY;
+      q.vtZ = d.vtZ / a.vtZ;
+      q.vtX *= q.vtX;
+      q.vtY *= q.vtY;
+      q.vtZ *= q.vtZ;
+      rho = pow((q.vtX * q.vtX) + (q.vtY * q.vtY) + (q.vtZ * q.vtZ), -0.25);
+      WLZ_VTX_3_SCALE(vx.d3[idV], d, rho);
+      q = vx.d3[idV];
+      d.vtX = q.vtX * q.vtX * q.vtX / (a.vtX * a.vtX * a.vtX * a.vtX);
+      d.vtY = q.vtY * q.vtY * q.vtY / (a.vtY * a.vtY * a.vtY * a.vtY);
+      d.vtZ = q.vtZ * q.vtZ * q.vtZ / (a.vtZ * a.vtZ * a.vtZ * a.vtZ);
+      l = WLZ_VTX_3_LENGTH(d);
+      WLZ_VTX_3_SCALE(nr.d3[idV], d, 1.0 / l);
+      if(tr)
+      {
+        vx.d3[idV] = WlzAffineTransformVertexD3(tr, vx.d3[idV], NULL);
+        nr.d3[idV] = WlzAffineTransformNormalD3(tr, nr.d3[idV], NULL);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *dstVx = vx;
+    *dstNr = nr;
+  }
+  return(errNum);
+}
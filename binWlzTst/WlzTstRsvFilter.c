@@ -0,0 +1,525 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstRsvFilter_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstRsvFilter.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the recursive filters of WlzRsvFilterObj().
+* 		2D and 3D objects, made from a disc or ball with an off
+* 		centre hole and a rectangle or cuboid, so that there are
+* 		many lines of both equal and different lengths, are
+* 		filtered along the lines and the values must be those
+* 		given by WlzRsvFilterBuffer() for each interval. Filtering
+* 		along all the axes must give identical values with one and
+* 		several threads, and with plain and tiled values.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static void			WlzTstRsvFilterSetThreads(
+				  int nThr);
+static int			WlzTstRsvFilterLines(
+				  WlzObject *sObj,
+				  WlzObject *fObj,
+				  WlzRsvFilter *ftr,
+				  WlzErrorNum *dstErr);
+static int			WlzTstRsvFilterCmp(
+				  WlzObject *o0,
+				  WlzObject *o1,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstRsvFilterObj(
+				  WlzObjectType oType,
+				  WlzGreyType gType,
+				  int sz,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idD,
+  		option,
+		sz = 64,
+		nThr = 4,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvs:t:";
+  const WlzRsvFilterName ftrName[2] = {WLZ_RSVFILTER_NAME_DERICHE_1,
+  				       WLZ_RSVFILTER_NAME_GAUSS_0};
+  const double	ftrPrm[2] = {1.0, 2.0};
+  const WlzGreyType gTypes[3] = {WLZ_GREY_DOUBLE, WLZ_GREY_UBYTE,
+  				 WLZ_GREY_FLOAT};
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 16);
+	break;
+      case 't':
+        usage = (sscanf(optarg, "%d", &nThr) != 1) || (nThr < 1);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  for(idD = 0; ok && (errNum == WLZ_ERR_NONE) && (idD < 2); ++idD)
+  {
+    int		idG;
+    WlzObjectType oType;
+
+    oType = (idD == 0)? WLZ_2D_DOMAINOBJ: WLZ_3D_DOMAINOBJ;
+    for(idG = 0; (errNum == WLZ_ERR_NONE) && (idG < 3); ++idG)
+    {
+      int	idF;
+      WlzObject	*obj = NULL,
+      		*tObj = NULL;
+
+      obj = WlzAssignObject(
+	    WlzTstRsvFilterObj(oType, gTypes[idG], sz, &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        WlzPixelV bgdV;
+
+	bgdV.type = WLZ_GREY_INT;
+	bgdV.v.inv = 0;
+	tObj = WlzAssignObject(
+	       WlzMakeTiledValuesFromObj(obj, 4096, 1, gTypes[idG], 0, NULL,
+	                                 bgdV, &errNum), NULL);
+      }
+      for(idF = 0; (errNum == WLZ_ERR_NONE) && (idF < 2); ++idF)
+      {
+	int	bad[3] = {0};
+	WlzRsvFilter *ftr;
+	WlzObject *fObj[3] = {NULL};
+
+	ftr = WlzRsvFilterMakeFilter(ftrName[idF], ftrPrm[idF], &errNum);
+	/* Along the lines against WlzRsvFilterBuffer(), only for double
+	 * values as other grey types are clamped. */
+	if((errNum == WLZ_ERR_NONE) && (gTypes[idG] == WLZ_GREY_DOUBLE))
+	{
+	  WlzTstRsvFilterSetThreads(nThr);
+	  fObj[0] = WlzAssignObject(
+		    WlzRsvFilterObj(obj, ftr, WLZ_RSVFILTER_ACTION_X,
+				    &errNum), NULL);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    bad[0] = WlzTstRsvFilterLines(obj, fObj[0], ftr, &errNum);
+	  }
+	  (void )WlzFreeObj(fObj[0]);
+	  fObj[0] = NULL;
+	}
+	/* Along all axes with one and several threads and with tiled
+	 * values. */
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  int	idR;
+	  const int actMsk = WLZ_RSVFILTER_ACTION_X | WLZ_RSVFILTER_ACTION_Y |
+			     WLZ_RSVFILTER_ACTION_Z;
+
+	  for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < 3); ++idR)
+	  {
+	    WlzTstRsvFilterSetThreads((idR == 0)? 1: nThr);
+	    fObj[idR] = WlzAssignObject(
+			WlzRsvFilterObj((idR == 2)? tObj: obj, ftr, actMsk,
+					&errNum), NULL);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    bad[1] = WlzTstRsvFilterCmp(fObj[0], fObj[1], &errNum);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    bad[2] = WlzTstRsvFilterCmp(fObj[0], fObj[2], &errNum);
+	  }
+	}
+	if((errNum == WLZ_ERR_NONE) && (verbose || bad[0] || bad[1] || bad[2]))
+	{
+	  (void )printf("%dD %-15s filter %d, %d lines differ from "
+			"WlzRsvFilterBuffer(), threads %s, tiled %s\n",
+			(oType == WLZ_2D_DOMAINOBJ)? 2: 3,
+			WlzStringFromGreyType(gTypes[idG], NULL),
+			(int )ftrName[idF], bad[0],
+			(bad[1])? "differ": "same", (bad[2])? "differ": "same");
+	}
+	nBad += bad[0] + bad[1] + bad[2];
+	(void )WlzFreeObj(fObj[0]);
+	(void )WlzFreeObj(fObj[1]);
+	(void )WlzFreeObj(fObj[2]);
+	WlzRsvFilterFreeFilter(ftr);
+      }
+      (void )WlzFreeObj(tObj);
+      (void )WlzFreeObj(obj);
+    }
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to filter object (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d differences (%s)\n",
+		    argv[0], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-s#] [-t#]\n"
+    "Tests that WlzRsvFilterObj() filters each line as\n"
+    "WlzRsvFilterBuffer() does, and that filtering along all axes gives\n"
+    "identical values with one and several threads and with plain and\n"
+    "tiled values.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, reporting each filter.\n"
+    "  -s  Diameter of the test objects (default %d).\n"
+    "  -t  Number of threads used after one thread (default %d).\n",
+    argv[0], 64, 4);
+  }
+  return(!ok);
+}
+
+/* Sets the number of threads used by the following parallel regions. */
+static void	WlzTstRsvFilterSetThreads(int nThr)
+{
+#ifdef _OPENMP
+  omp_set_num_threads(nThr);
+#endif
+}
+
+/* Filters each interval of the given double valued object using
+ * WlzRsvFilterBuffer() and returns the number of intervals for which
+ * the values of the filtered object are not identical. */
+static int	WlzTstRsvFilterLines(WlzObject *sObj, WlzObject *fObj,
+				     WlzRsvFilter *ftr, WlzErrorNum *dstErr)
+{
+  int		p,
+  		p0 = 0,
+		p1 = 0,
+		nBad = 0;
+  double	*buf[3] = {NULL};
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(sObj->type == WLZ_3D_DOMAINOBJ)
+  {
+    p0 = sObj->domain.p->plane1;
+    p1 = sObj->domain.p->lastpl;
+  }
+  if((buf[0] = (double *)AlcMalloc(3 * 4096 * sizeof(double))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    buf[1] = buf[0] + 4096;
+    buf[2] = buf[1] + 4096;
+    gVWSp = WlzGreyValueMakeWSp(fObj, &errNum);
+  }
+  for(p = p0; (errNum == WLZ_ERR_NONE) && (p <= p1); ++p)
+  {
+    WlzObject	*obj2 = NULL;
+    WlzIntervalWSpace iWSp;
+    WlzGreyWSpace gWSp;
+
+    if(sObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      obj2 = WlzAssignObject(sObj, NULL);
+    }
+    else
+    {
+      WlzDomain	dom2;
+      WlzValues	val2;
+
+      dom2 = sObj->domain.p->domains[p - p0];
+      val2 = sObj->values.vox->values[p - sObj->values.vox->plane1];
+      if(dom2.core == NULL)
+      {
+        continue;
+      }
+      obj2 = WlzAssignObject(
+             WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, val2, NULL, NULL, &errNum),
+	     NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	int	k,
+		len,
+		bad = 0;
+
+	len = iWSp.rgtpos - iWSp.lftpos + 1;
+	(void )memcpy(buf[0], gWSp.u_grintptr.dbp, len * sizeof(double));
+	errNum = WlzRsvFilterBuffer(ftr, buf[0], buf[1], buf[2], len);
+	for(k = 0; (errNum == WLZ_ERR_NONE) && (k < len); ++k)
+	{
+	  WlzGreyValueGet(gVWSp, p, iWSp.linpos, iWSp.lftpos + k);
+	  if(gVWSp->gVal[0].dbv != buf[0][k])
+	  {
+	    bad = 1;
+	  }
+	}
+	nBad += bad;
+      }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+    }
+    (void )WlzFreeObj(obj2);
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  AlcFree(buf[0]);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nBad);
+}
+
+/* Returns zero if the two objects have the same grey type and bit for
+ * bit identical values over the domain of the first, otherwise one. */
+static int	WlzTstRsvFilterCmp(WlzObject *o0, WlzObject *o1,
+				   WlzErrorNum *dstErr)
+{
+  int		bad = 0;
+  WlzGreyType	gType;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzIterateWSpace *itWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gType = WlzGreyTypeFromObj(o0, &errNum);
+  if((errNum == WLZ_ERR_NONE) && (WlzGreyTypeFromObj(o1, NULL) != gType))
+  {
+    bad = 1;
+  }
+  if((errNum == WLZ_ERR_NONE) && !bad)
+  {
+    gVWSp = WlzGreyValueMakeWSp(o1, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && !bad)
+  {
+    itWSp = WlzIterateInit(o0, WLZ_RASTERDIR_ILIC, 1, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && !bad)
+  {
+    while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+    {
+      WlzGreyValueGet(gVWSp, itWSp->pos.vtZ, itWSp->pos.vtY,
+      		      itWSp->pos.vtX);
+      switch(gType)
+      {
+        case WLZ_GREY_SHORT:
+	  bad |= *(itWSp->gP.shp) != gVWSp->gVal[0].shv;
+	  break;
+        case WLZ_GREY_INT:
+	  bad |= *(itWSp->gP.inp) != gVWSp->gVal[0].inv;
+	  break;
+        case WLZ_GREY_FLOAT:
+	  bad |= memcmp(itWSp->gP.flp, &(gVWSp->gVal[0].flv),
+	                sizeof(float)) != 0;
+	  break;
+        case WLZ_GREY_DOUBLE:
+	  bad |= memcmp(itWSp->gP.dbp, &(gVWSp->gVal[0].dbv),
+	                sizeof(double)) != 0;
+	  break;
+	default:
+	  bad = 1;
+	  break;
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  WlzIterateWSpFree(itWSp);
+  WlzGreyValueFreeWSp(gVWSp);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(bad);
+}
+
+/* Makes a test object from a disc or ball with an off centre hole and
+ * a rectangle or cuboid, which gives many lines of the same length as
+ * well as lines of many different lengths. The values are random. */
+static WlzObject *WlzTstRsvFilterObj(WlzObjectType oType,
+				     WlzGreyType gType, int sz,
+				     WlzErrorNum *dstErr)
+{
+  int		c;
+  WlzObject	*obj = NULL,
+		*rObj = NULL;
+  WlzObject	*tObj[3] = {NULL};
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  c = sz / 2;
+  tObj[0] = WlzAssignObject(
+            WlzMakeSphereObject(oType, 0.45 * sz, c, c, c, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tObj[1] = WlzAssignObject(
+	      WlzMakeSphereObject(oType, 0.2 * sz, c + 0.15 * sz, c, c,
+				  &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tObj[2] = WlzAssignObject(
+	      WlzMakeCuboidObject(oType, 0.25 * sz, 0.2 * sz, 0.15 * sz,
+				  c - 0.3 * sz, c + 0.1 * sz, c, &errNum),
+	      NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj = WlzAssignObject(WlzDiffDomain(tObj[0], tObj[1], &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzAssignObject(WlzUnion2(obj, tObj[2], &errNum), NULL);
+  }
+  (void )WlzFreeObj(obj);
+  obj = NULL;
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzPixelV	bgdV;
+    WlzValues	val;
+    WlzObjectType gTType;
+
+    bgdV.type = WLZ_GREY_INT;
+    bgdV.v.inv = 0;
+    gTType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, NULL);
+    if(oType == WLZ_2D_DOMAINOBJ)
+    {
+      val.v = WlzNewValueTb(rObj, gTType, bgdV, &errNum);
+    }
+    else
+    {
+      val.vox = WlzNewValuesVox(rObj, gTType, bgdV, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj = WlzMakeMain(oType, rObj->domain, val, NULL, NULL, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzIterateWSpace *itWSp;
+
+    itWSp = WlzIterateInit(obj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      AlgRandSeed(sz + gType);
+      while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+      {
+	double	v;
+
+	v = 255.0 * AlgRandUniform();
+	switch(gType)
+	{
+	  case WLZ_GREY_UBYTE:
+	    *(itWSp->gP.ubp) = (WlzUByte )WLZ_NINT(v);
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    *(itWSp->gP.flp) = (float )v;
+	    break;
+	  default:
+	    *(itWSp->gP.dbp) = v;
+	    break;
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+    }
+    WlzIterateWSpFree(itWSp);
+  }
+  (void )WlzFreeObj(rObj);
+  for(c = 0; c < 3; ++c)
+  {
+    (void )WlzFreeObj(tObj[c]);
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
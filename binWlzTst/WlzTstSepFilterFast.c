@@ -0,0 +1,463 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstSepFilterFast_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstSepFilterFast.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the blocked single precision separable filter.
+* 		Random unsigned byte, short and float cuboids are Gaussian
+* 		filtered by WlzGaussFilterFast() and WlzGaussFilter() for
+* 		a range of derivative orders, directions, padding and
+* 		return grey types. Float results must agree to within
+* 		float rounding and integer results to within one. Objects
+* 		which can not use the blocked filter, because they are
+* 		not cuboids or have separate filter passes, must give
+* 		identical results.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstSepFilterFastVal(
+				  WlzGreyValueWSpace *gVWSp);
+static int			WlzTstSepFilterFastCmp(
+				  WlzObject *dObj,
+				  WlzObject *fObj,
+				  double tol,
+				  double *dstMaxD,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstSepFilterFastObj(
+				  WlzGreyType gType,
+				  int sz,
+				  int notch,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idG,
+  		option,
+		sz = 40,
+		nThr = 4,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvs:t:";
+  const WlzGreyType gTypes[3] = {WLZ_GREY_UBYTE, WLZ_GREY_SHORT,
+  				 WLZ_GREY_FLOAT};
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 24);
+	break;
+      case 't':
+        usage = (sscanf(optarg, "%d", &nThr) != 1) || (nThr < 1);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+#ifdef _OPENMP
+  if(ok)
+  {
+    omp_set_num_threads(nThr);
+  }
+#endif
+  for(idG = 0; ok && (errNum == WLZ_ERR_NONE) && (idG < 3); ++idG)
+  {
+    int		idB;
+
+    for(idB = 0; (errNum == WLZ_ERR_NONE) && (idB < 2); ++idB)
+    {
+      int	idC;
+      WlzObject	*obj;
+
+      obj = WlzAssignObject(
+            WlzTstSepFilterFastObj(gTypes[idG], sz, idB, &errNum), NULL);
+      for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < 6); ++idC)
+      {
+	int	bad,
+		sep = 0;
+	double	maxD = 0.0,
+		tol;
+	WlzGreyType oType;
+	AlgPadType pad;
+	WlzDVertex3 sigma;
+	WlzIVertex3 order,
+		    direc;
+	WlzObject   *dObj = NULL,
+		    *fObj = NULL;
+	const char  *gStr;
+
+	/* Cycle through the orders, directions, padding and return grey
+	 * types, the last case having separate passes. */
+	WLZ_VTX_3_SET(sigma, 1.5, 2.0, 2.5);
+	WLZ_VTX_3_SET(order, idC % 3, 0, (idC / 2) % 3);
+	WLZ_VTX_3_SET(direc, 1, idC != 2, idC != 4);
+	pad = (idC % 3 == 0)? ALG_PAD_END:
+	      (idC % 3 == 1)? ALG_PAD_VALUE: ALG_PAD_ZERO;
+	oType = (idC % 2)? WLZ_GREY_FLOAT:
+	        (idC == 2)? WLZ_GREY_INT: WLZ_GREY_ERROR;
+	sep = (idC == 5)? 2: 0;
+	dObj = WlzAssignObject(
+	       WlzGaussFilter(obj, sigma, order, direc, oType, pad, 17.0,
+			      sep, &errNum), NULL);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  fObj = WlzAssignObject(
+		 WlzGaussFilterFast(obj, sigma, order, direc, oType, pad,
+				    17.0, sep, &errNum), NULL);
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  /* Only the blocked filter, which is used for cuboids without
+	   * separate passes, may differ. */
+	  if(idB || sep)
+	  {
+	    tol = 0.0;
+	  }
+	  else if((oType == WLZ_GREY_FLOAT) ||
+		  ((oType == WLZ_GREY_ERROR) && (gTypes[idG] == WLZ_GREY_FLOAT)))
+	  {
+	    tol = 1.0e-4;
+	  }
+	  else
+	  {
+	    tol = 1.0;
+	  }
+	  bad = WlzTstSepFilterFastCmp(dObj, fObj, tol, &maxD, &errNum);
+	  nBad += bad;
+	  if((errNum == WLZ_ERR_NONE) && (verbose || bad))
+	  {
+	    gStr = WlzStringFromGreyType(gTypes[idG], NULL);
+	    (void )printf("%-15s %s order %d,%d,%d direc %d,%d,%d pad %d "
+			  "sep %d, maximum difference %g (%s)\n",
+			  gStr, (idB)? "notched": "cuboid ",
+			  order.vtX, order.vtY, order.vtZ,
+			  direc.vtX, direc.vtY, direc.vtZ, pad, sep, maxD,
+			  (bad)? "differs": "same");
+	  }
+	}
+	(void )WlzFreeObj(dObj);
+	(void )WlzFreeObj(fObj);
+      }
+      (void )WlzFreeObj(obj);
+    }
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to filter object (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %d differences (%s)\n",
+		    argv[0], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-s#] [-t#]\n"
+    "Tests that WlzGaussFilterFast() gives the same values as\n"
+    "WlzGaussFilter() to within float rounding for float values and to\n"
+    "within one for integer values, and identical values for objects\n"
+    "which can not use the blocked single precision filter, here\n"
+    "because they are notched or have separate filter passes.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, reporting each filter.\n"
+    "  -s  Approximate size of the test objects, at least 24 so that\n"
+    "      all lines are longer than the filter kernels (default %d).\n"
+    "  -t  Number of threads (default %d).\n",
+    argv[0], 40, 4);
+  }
+  return(!ok);
+}
+
+/* Returns the value of the grey value workspace as a double. */
+static double	WlzTstSepFilterFastVal(WlzGreyValueWSpace *gVWSp)
+{
+  double	v = 0.0;
+
+  switch(gVWSp->gType)
+  {
+    case WLZ_GREY_UBYTE:
+      v = gVWSp->gVal[0].ubv;
+      break;
+    case WLZ_GREY_SHORT:
+      v = gVWSp->gVal[0].shv;
+      break;
+    case WLZ_GREY_INT:
+      v = gVWSp->gVal[0].inv;
+      break;
+    case WLZ_GREY_FLOAT:
+      v = gVWSp->gVal[0].flv;
+      break;
+    case WLZ_GREY_DOUBLE:
+      v = gVWSp->gVal[0].dbv;
+      break;
+    default:
+      break;
+  }
+  return(v);
+}
+
+/* Compares the values of the two filtered objects, which must have the
+ * same domain and grey type, over the domain of the first. Float values
+ * may differ by tol relative to the largest absolute value and other
+ * values by tol. Returns one if they differ by more than this, setting
+ * the maximum difference. */
+static int	WlzTstSepFilterFastCmp(WlzObject *dObj, WlzObject *fObj,
+				       double tol, double *dstMaxD,
+				       WlzErrorNum *dstErr)
+{
+  int		bad = 0;
+  double	maxD = 0.0,
+  		maxV = 0.0;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzIterateWSpace *itWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((WlzGreyTypeFromObj(dObj, &errNum) !=
+      WlzGreyTypeFromObj(fObj, NULL)) ||
+     (WlzVolume(dObj, NULL) != WlzVolume(fObj, NULL)))
+  {
+    bad = 1;
+  }
+  if((errNum == WLZ_ERR_NONE) && !bad)
+  {
+    gType = WlzGreyTypeFromObj(dObj, NULL);
+    gVWSp = WlzGreyValueMakeWSp(fObj, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && !bad)
+  {
+    itWSp = WlzIterateInit(dObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && !bad)
+  {
+    while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+    {
+      double	d,
+      		v;
+
+      WlzGreyValueGet(gVWSp, itWSp->pos.vtZ, itWSp->pos.vtY,
+      		      itWSp->pos.vtX);
+      switch(gType)
+      {
+        case WLZ_GREY_UBYTE:
+	  v = *(itWSp->gP.ubp);
+	  break;
+        case WLZ_GREY_SHORT:
+	  v = *(itWSp->gP.shp);
+	  break;
+        case WLZ_GREY_INT:
+	  v = *(itWSp->gP.inp);
+	  break;
+        case WLZ_GREY_FLOAT:
+	  v = *(itWSp->gP.flp);
+	  break;
+	default:
+	  v = *(itWSp->gP.dbp);
+	  break;
+      }
+      d = fabs(v - WlzTstSepFilterFastVal(gVWSp));
+      maxD = ALG_MAX(maxD, d);
+      maxV = ALG_MAX(maxV, fabs(v));
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    bad = maxD > ((gType == WLZ_GREY_FLOAT)? tol * maxV: tol);
+  }
+  WlzIterateWSpFree(itWSp);
+  WlzGreyValueFreeWSp(gVWSp);
+  *dstMaxD = maxD;
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(bad);
+}
+
+/* Makes a test object with a cuboid domain or, if notch is non-zero,
+ * the cuboid with a notch along z cut from one corner, so that the
+ * blocked filter can not be used but all lines remain longer than the
+ * kernels. AlgConvolveD() requires this. The cuboid does not have its
+ * origin at zero and its values are a smooth pattern with a ramp along
+ * z and random noise added, scaled to suit the grey type. */
+static WlzObject *WlzTstSepFilterFastObj(WlzGreyType gType, int sz,
+				         int notch, WlzErrorNum *dstErr)
+{
+  int		x,
+  		y,
+		z;
+  double	s,
+  		o;
+  double	***ary = NULL;
+  WlzIVertex3	aSz,
+  		aOrg;
+  WlzObject	*cObj = NULL,
+  		*bObj = NULL,
+		*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  WLZ_VTX_3_SET(aSz, sz - 3, sz + 5, sz - 7);
+  WLZ_VTX_3_SET(aOrg, 5, -9, 2);
+  switch(gType)
+  {
+    case WLZ_GREY_SHORT:
+      s = 10.0;
+      o = -500.0;
+      break;
+    case WLZ_GREY_FLOAT:
+      s = 1.0 / 7.0;
+      o = 0.0;
+      break;
+    default:
+      s = 1.0;
+      o = 0.0;
+      break;
+  }
+  if(AlcDouble3Malloc(&ary, aSz.vtZ, aSz.vtY, aSz.vtX) != ALC_ER_NONE)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    AlgRandSeed(sz + gType);
+    for(z = 0; z < aSz.vtZ; ++z)
+    {
+      for(y = 0; y < aSz.vtY; ++y)
+      {
+	for(x = 0; x < aSz.vtX; ++x)
+	{
+	  double v;
+
+	  v = 100.0 + 60.0 * sin(x / 3.0) * cos(y / 4.0) +
+	      (40.0 * z) / aSz.vtZ + 40.0 * AlgRandUniform();
+	  ary[z][y][x] = o + s * floor(v);
+	}
+      }
+    }
+    cObj = WlzFromArray3D((void ***)ary, aSz, aOrg, gType, WLZ_GREY_DOUBLE,
+			  0.0, 1.0, 1, 0, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && notch)
+  {
+    WlzObject	*nObj = NULL;
+
+    cObj = WlzAssignObject(cObj, NULL);
+    nObj = WlzAssignObject(
+           WlzMakeCuboidObject(WLZ_3D_DOMAINOBJ,
+	                       aSz.vtX / 2, aSz.vtY / 2, aSz.vtZ,
+	                       aOrg.vtX + aSz.vtX, aOrg.vtY + aSz.vtY,
+			       aOrg.vtZ + aSz.vtZ / 2, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bObj = WlzAssignObject(WlzDiffDomain(cObj, nObj, &errNum), NULL);
+    }
+    (void )WlzFreeObj(nObj);
+    /* Give the notched object its own value table, so that no values
+     * lie outside its domain. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzPixelV	bgdV;
+      WlzValues	val;
+
+      bgdV.type = WLZ_GREY_INT;
+      bgdV.v.inv = 0;
+      val.vox = WlzNewValuesVox(bObj,
+                                WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR,
+				                      gType, NULL),
+				bgdV, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        rObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, bObj->domain, val,
+			   NULL, NULL, &errNum);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzFreeObj(WlzGreyTransfer(rObj, cObj, 1, &errNum));
+    }
+    (void )WlzFreeObj(bObj);
+    (void )WlzFreeObj(cObj);
+  }
+  else
+  {
+    rObj = cObj;
+  }
+  (void )AlcDouble3Free(ary);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
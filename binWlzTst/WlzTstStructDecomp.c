@@ -0,0 +1,572 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstStructDecomp_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstStructDecomp.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test and benchmark for decomposed structuring element
+* 		morphology. Synthetic 2D and 3D objects are dilated
+* 		and eroded by rectangles, cuboids, the standard
+* 		structuring elements, digital discs and balls and
+* 		irregular structuring elements, both centred and off
+* 		centre, using every decomposition which is possible
+* 		for the structuring element. The domains are compared
+* 		with those from the direct method. Opening and closing
+* 		with a ball and with a sphere made by
+* 		WlzMakeSphereObject() are then timed with and without
+* 		decomposition.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstStructDecompTime(void);
+static int			WlzTstStructDecompCmp(
+				  WlzObject *o0,
+				  WlzObject *o1);
+static int			WlzTstStructDecompSE(
+				  WlzObject *obj,
+				  WlzObject *se,
+				  const char *name,
+				  int verbose,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstStructDecompObj(
+				  WlzObjectType oType,
+				  int sz,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstStructDecompBall(
+				  WlzObjectType oType,
+				  int r2,
+				  int cx,
+				  int cy,
+				  int cz,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idD,
+  		option,
+		sz = 48,
+		rad = 20,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  double	t[2][4] = {{0.0}};
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvr:s:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'r':
+        usage = (sscanf(optarg, "%d", &rad) != 1) || (rad < 1);
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 8);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  /* Compare every possible decomposition with the direct method for
+   * a range of structuring elements in 2D and 3D. */
+  for(idD = 0; ok && (errNum == WLZ_ERR_NONE) && (idD < 2); ++idD)
+  {
+    int		idS,
+    		nSE;
+    WlzObjectType oType;
+    WlzObject	*obj = NULL;
+    WlzObject	*se[16];
+    const char	*seName[16];
+
+    oType = (idD == 0)? WLZ_2D_DOMAINOBJ: WLZ_3D_DOMAINOBJ;
+    obj = WlzAssignObject(
+          WlzTstStructDecompObj(oType, (idD == 0)? 4 * sz: sz, &errNum),
+	  NULL);
+    nSE = 0;
+    if(errNum == WLZ_ERR_NONE)
+    {
+      seName[nSE] = "rectangle";
+      se[nSE++] = WlzMakeCuboidObject(oType, 3.0, 1.0, 2.0, 1.0, -2.0, 1.0,
+                                      &errNum);
+      seName[nSE] = "4-connected r = 3";
+      se[nSE++] = WlzMakeStdStructElement(oType, WLZ_4_DISTANCE, 3.0,
+                                          &errNum);
+      seName[nSE] = "8-connected r = 2";
+      se[nSE++] = WlzMakeStdStructElement(oType, WLZ_8_DISTANCE, 2.0,
+                                          &errNum);
+      seName[nSE] = "octagonal r = 3";
+      se[nSE++] = WlzMakeStdStructElement(oType, WLZ_OCTAGONAL_DISTANCE, 3.0,
+                                          &errNum);
+      seName[nSE] = "octagonal r = 4";
+      se[nSE++] = WlzMakeStdStructElement(oType, WLZ_OCTAGONAL_DISTANCE, 4.0,
+                                          &errNum);
+      seName[nSE] = "ball r^2 = 10";
+      se[nSE++] = WlzTstStructDecompBall(oType, 10, 0, 0, 0, &errNum);
+      seName[nSE] = "ball r^2 = 5 off centre";
+      se[nSE++] = WlzTstStructDecompBall(oType, 5, 2, -1, 1, &errNum);
+      seName[nSE] = "sphere r = 3";
+      se[nSE++] = WlzMakeSphereObject(oType, 3.0, 0.0, 0.0, 0.0, &errNum);
+      seName[nSE] = "sphere r = 5 off centre";
+      se[nSE++] = WlzMakeSphereObject(oType, 5.0, 2.0, -1.0, 1.0, &errNum);
+      if(oType == WLZ_3D_DOMAINOBJ)
+      {
+	seName[nSE] = "6-connected r = 2";
+	se[nSE++] = WlzMakeStdStructElement(oType, WLZ_6_DISTANCE, 2.0,
+					    &errNum);
+	seName[nSE] = "18-connected r = 2";
+	se[nSE++] = WlzMakeStdStructElement(oType, WLZ_18_DISTANCE, 2.0,
+					    &errNum);
+	seName[nSE] = "26-connected r = 1";
+	se[nSE++] = WlzMakeStdStructElement(oType, WLZ_26_DISTANCE, 1.0,
+					    &errNum);
+	seName[nSE] = "2D disc r^2 = 8";
+	se[nSE++] = WlzTstStructDecompBall(WLZ_2D_DOMAINOBJ, 8, 0, 0, 0,
+	                                   &errNum);
+      }
+    }
+    for(idS = 0; (errNum == WLZ_ERR_NONE) && (idS < nSE); ++idS)
+    {
+      nBad += WlzTstStructDecompSE(obj, se[idS], seName[idS], verbose,
+                                   &errNum);
+    }
+    for(idS = 0; idS < nSE; ++idS)
+    {
+      (void )WlzFreeObj(se[idS]);
+    }
+    (void )WlzFreeObj(obj);
+  }
+  /* Time opening and closing with a ball and with a sphere. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    int		idE;
+    WlzObject	*obj = NULL;
+
+    obj = WlzAssignObject(
+          WlzTstStructDecompObj(WLZ_3D_DOMAINOBJ, 4 * sz, &errNum), NULL);
+    for(idE = 0; (errNum == WLZ_ERR_NONE) && (idE < 2); ++idE)
+    {
+      int	idM;
+      WlzObject	*se = NULL,
+		*tObj[2] = {NULL};
+
+      se = WlzAssignObject(
+	   (idE == 0)?
+	   WlzTstStructDecompBall(WLZ_3D_DOMAINOBJ, rad * rad, 0, 0, 0,
+				  &errNum):
+	   WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, rad, 0.0, 0.0, 0.0,
+			       &errNum), NULL);
+      for(idM = 0; (errNum == WLZ_ERR_NONE) && (idM < 2); ++idM)
+      {
+	int	idO;
+	WlzStructElmDecomp dcp;
+
+	dcp = (idM == 0)? WLZ_STRUCTELM_DECOMP_NONE:
+			  WLZ_STRUCTELM_DECOMP_AUTO;
+	for(idO = 0; (errNum == WLZ_ERR_NONE) && (idO < 2); ++idO)
+	{
+	  double	t0;
+	  WlzObject *o0 = NULL;
+
+	  t0 = WlzTstStructDecompTime();
+	  if(idO == 0)
+	  {
+	    o0 = WlzAssignObject(
+		 WlzStructErosionDecomp(obj, se, dcp, &errNum), NULL);
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      tObj[idM] = WlzAssignObject(
+			  WlzStructDilationDecomp(o0, se, dcp, &errNum), NULL);
+	    }
+	  }
+	  else
+	  {
+	    o0 = WlzAssignObject(
+		 WlzStructDilationDecomp(obj, se, dcp, &errNum), NULL);
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      WlzObject *o1;
+
+	      o1 = WlzAssignObject(
+		   WlzStructErosionDecomp(o0, se, dcp, &errNum), NULL);
+	      if((errNum == WLZ_ERR_NONE) && !WlzTstStructDecompCmp(o1, obj))
+	      {
+		/* The closing must contain the object. */
+		WlzObject	*o2;
+
+		o2 = WlzAssignObject(WlzUnion2(o1, obj, &errNum), NULL);
+		if((errNum == WLZ_ERR_NONE) && WlzTstStructDecompCmp(o1, o2))
+		{
+		  ++nBad;
+		}
+		(void )WlzFreeObj(o2);
+	      }
+	      (void )WlzFreeObj(o1);
+	    }
+	  }
+	  (void )WlzFreeObj(o0);
+	  t[idE][(2 * idM) + idO] = WlzTstStructDecompTime() - t0;
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	nBad += WlzTstStructDecompCmp(tObj[0], tObj[1]);
+      }
+      (void )WlzFreeObj(tObj[0]);
+      (void )WlzFreeObj(tObj[1]);
+      (void )WlzFreeObj(se);
+    }
+    (void )WlzFreeObj(obj);
+  }
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to compute morphology (%s).\n",
+		     argv[0], errMsgStr);
+    }
+    else
+    {
+      int	idE;
+
+      ok = nBad == 0;
+      for(idE = 0; idE < 2; ++idE)
+      {
+	(void )printf("%s: %s r = %d, opening direct %gs decomposed %gs, "
+		      "closing direct %gs decomposed %gs\n",
+		      argv[0], (idE == 0)? "ball": "sphere", rad,
+		      t[idE][0], t[idE][2], t[idE][1], t[idE][3]);
+      }
+      (void )printf("%s: %d differences (%s)\n",
+		    argv[0], nBad, (ok)? "pass": "FAIL");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-r#] [-s#]\n"
+    "Tests decomposed structuring element morphology against direct\n"
+    "morphology, using a disc or ball with a bite, a cavity and a small\n"
+    "separate part, and times opening and closing with a ball and with\n"
+    "a sphere made by WlzMakeSphereObject().\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, reporting each structuring element.\n"
+    "  -r  Radius of the ball and sphere used for timing (default %d).\n"
+    "  -s  Diameter of the 3D test object, the 2D test object and the\n"
+    "      timed object have 4 times this diameter (default %d).\n",
+    argv[0], 20, 48);
+  }
+  return(!ok);
+}
+
+static double	WlzTstStructDecompTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
+
+/* Returns zero if the two objects have the same domain, otherwise
+ * one. */
+static int	WlzTstStructDecompCmp(WlzObject *o0, WlzObject *o1)
+{
+  int		nBad = 1;
+  WlzLong	v0,
+  		v1,
+		vI;
+  WlzObject	*oI;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  v0 = (o0->type == WLZ_EMPTY_OBJ)? 0: WlzVolume(o0, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    v1 = (o1->type == WLZ_EMPTY_OBJ)? 0: WlzVolume(o1, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && (v0 == v1))
+  {
+    if(v0 == 0)
+    {
+      nBad = 0;
+    }
+    else
+    {
+      oI = WlzAssignObject(WlzIntersect2(o0, o1, &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	vI = (oI->type == WLZ_EMPTY_OBJ)? 0: WlzVolume(oI, &errNum);
+	nBad = (errNum != WLZ_ERR_NONE) || (vI != v0);
+      }
+      (void )WlzFreeObj(oI);
+    }
+  }
+  return(nBad);
+}
+
+/* Dilates and erodes the object by the structuring element using
+ * every decomposition possible for the structuring element and returns
+ * the number of results which differ from the direct method. */
+static int	WlzTstStructDecompSE(WlzObject *obj, WlzObject *se,
+				     const char *name, int verbose,
+				     WlzErrorNum *dstErr)
+{
+  int		ers,
+  		nBad = 0;
+  WlzStructElmDecomp dcp,
+  		auto_dcp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(ers = 0; (errNum == WLZ_ERR_NONE) && (ers < 2); ++ers)
+  {
+    WlzObject	*o0;
+
+    auto_dcp = WlzStructElmDecompFind(obj, se, ers, &errNum);
+    o0 = (ers)?
+	 WlzStructErosionDecomp(obj, se, WLZ_STRUCTELM_DECOMP_NONE, &errNum):
+	 WlzStructDilationDecomp(obj, se, WLZ_STRUCTELM_DECOMP_NONE, &errNum);
+    o0 = WlzAssignObject(o0, NULL);
+    for(dcp = WLZ_STRUCTELM_DECOMP_AUTO;
+        (errNum == WLZ_ERR_NONE) && (dcp <= WLZ_STRUCTELM_DECOMP_PLANES);
+	dcp = (WlzStructElmDecomp )(dcp + 1))
+    {
+      WlzObject	*o1;
+      WlzErrorNum errNum1 = WLZ_ERR_NONE;
+
+      if(dcp == WLZ_STRUCTELM_DECOMP_NONE)
+      {
+        continue;
+      }
+      o1 = WlzAssignObject(
+           (ers)? WlzStructErosionDecomp(obj, se, dcp, &errNum1):
+	          WlzStructDilationDecomp(obj, se, dcp, &errNum1), NULL);
+      if(errNum1 == WLZ_ERR_NONE)
+      {
+	int	bad;
+
+	bad = WlzTstStructDecompCmp(o0, o1);
+	nBad += bad;
+	if(verbose || bad)
+	{
+	  (void )printf("%dD %-24s %s method %d (auto %d) %s\n",
+	                (obj->type == WLZ_2D_DOMAINOBJ)? 2: 3, name,
+			(ers)? "erosion ": "dilation", dcp, auto_dcp,
+			(bad)? "differs": "same");
+	}
+      }
+      else if(errNum1 != WLZ_ERR_PARAM_DATA)
+      {
+        errNum = errNum1;
+      }
+      (void )WlzFreeObj(o1);
+    }
+    (void )WlzFreeObj(o0);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nBad);
+}
+
+/* Makes a test object, without values, from a disc or ball with an
+ * off centre bite taken out of it (leaving thin horns), a cavity and a
+ * small separate disc or ball within the bite, so that the structuring
+ * elements meet concavities, holes and narrow gaps. */
+static WlzObject *WlzTstStructDecompObj(WlzObjectType oType, int sz,
+				        WlzErrorNum *dstErr)
+{
+  int		idB,
+  		c;
+  WlzObject	*obj = NULL,
+		*rObj = NULL;
+  WlzObject	*bObj[4] = {NULL, NULL, NULL, NULL};
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	bR[4] = {0.5, 0.28, 0.12, 0.08},
+		bX[4] = {0.0, 0.3, -0.2, 0.3};
+
+  c = sz / 2;
+  for(idB = 0; (errNum == WLZ_ERR_NONE) && (idB < 4); ++idB)
+  {
+    bObj[idB] = WlzAssignObject(
+		WlzMakeSphereObject(oType, bR[idB] * sz, c + bX[idB] * sz,
+				    c, c, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj = WlzAssignObject(WlzDiffDomain(bObj[0], bObj[1], &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzAssignObject(WlzDiffDomain(obj, bObj[2], &errNum), NULL);
+    (void )WlzFreeObj(obj);
+    obj = rObj;
+    rObj = NULL;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzUnion2(obj, bObj[3], &errNum);
+  }
+  (void )WlzFreeObj(obj);
+  for(idB = 0; idB < 4; ++idB)
+  {
+    (void )WlzFreeObj(bObj[idB]);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/* Makes a digital disc or ball, ie the lattice points within distance
+ * sqrt(r2) of the given centre. */
+static WlzObject *WlzTstStructDecompBall(WlzObjectType oType, int r2,
+					 int cx, int cy, int cz,
+					 WlzErrorNum *dstErr)
+{
+  int		p,
+  		r,
+		nPln;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  r = (int )floor(sqrt((double )r2));
+  nPln = (oType == WLZ_2D_DOMAINOBJ)? 1: 2 * r + 1;
+  if(oType == WLZ_3D_DOMAINOBJ)
+  {
+    dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+                               cz - r, cz + r, cy - r, cy + r, cx - r, cx + r,
+			       &errNum);
+  }
+  for(p = 0; (errNum == WLZ_ERR_NONE) && (p < nPln); ++p)
+  {
+    int		l,
+    		dz;
+    WlzDomain	dom2;
+    WlzInterval	*itv;
+
+    dz = (oType == WLZ_2D_DOMAINOBJ)? 0: p - r;
+    dom2.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+                                   cy - r, cy + r, cx - r, cx + r, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if((itv = (WlzInterval *)
+                AlcCalloc(2 * r + 1, sizeof(WlzInterval))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+	(void )WlzFreeIntervalDomain(dom2.i);
+      }
+      else
+      {
+	dom2.i->freeptr = AlcFreeStackPush(dom2.i->freeptr, (void *)itv,
+	                                   NULL);
+	for(l = -r; l <= r; ++l)
+	{
+	  int	h,
+	  	d2;
+
+	  d2 = r2 - (l * l) - (dz * dz);
+	  if(d2 >= 0)
+	  {
+	    h = (int )floor(sqrt((double )d2));
+	    itv->ileft = r - h;
+	    itv->iright = r + h;
+	    (void )WlzMakeInterval(cy + l, dom2.i, 1, itv);
+	    ++itv;
+	  }
+	  else
+	  {
+	    (void )WlzMakeInterval(cy + l, dom2.i, 0, NULL);
+	  }
+	}
+	(void )WlzStandardIntervalDomain(dom2.i);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(oType == WLZ_2D_DOMAINOBJ)
+      {
+        dom = dom2;
+      }
+      else
+      {
+        dom.p->domains[p] = WlzAssignDomain(dom2, NULL);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(oType == WLZ_3D_DOMAINOBJ)
+    {
+      (void )WlzStandardPlaneDomain(dom.p, NULL);
+    }
+    obj = WlzMakeMain(oType, dom, val, NULL, NULL, &errNum);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
@@ -61,8 +61,10 @@ int		main(int argc, char *argv[])
 		usage = 0,
 		dim = 2,
 		section = 0,
+		paged = 0,
 		timer = 0;
-  double	yaw = 0.0,
+  double	pageCacheSz = 0.0,
+  		yaw = 0.0,
   		pitch = 0.0,
 		roll =  0.0,
 		dist = 0.0,
@@ -76,14 +78,15 @@ int		main(int argc, char *argv[])
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   FILE		*fP = NULL;
   WlzObject	*inObj = NULL,
-  		*tlObj = NULL;
+  		*tlObj = NULL,
+		*pgObj = NULL;
   char		*inFileStr,
 		*outFileStr,
   		*secFileStr;
   struct timeval times[3];
   const char	*errMsg;
   const size_t	tlSz = WLZ_TILEDVALUES_TILE_SIZE;
-  static char	optList[] = "hsto:S:",
+  static char	optList[] = "hsto:p:S:",
   		inFileStrDef[] = "-";
 
   opterr = 0;
@@ -102,6 +105,13 @@ int		main(int argc, char *argv[])
       case 'o':
         outFileStr = optarg;
 	break;
+      case 'p':
+        paged = 1;
+	if((sscanf(optarg, "%lg", &pageCacheSz) != 1) || (pageCacheSz < 0.0))
+	{
+	  usage = 1;
+	}
+	break;
       case 's':
         section = 1;
 	break;
@@ -128,6 +138,10 @@ int		main(int argc, char *argv[])
       inFileStr = *(argv + optind);
     }
   }
+  if(paged && ((outFileStr == NULL) || (strcmp(outFileStr, "-") == 0)))
+  {
+    usage = 1;
+  }
   ok = !usage;
   if(ok)
   {
@@ -222,6 +236,84 @@ int		main(int argc, char *argv[])
 		     "%s: Failed to write tiled object to file %s (%s).\n",
 		     *argv, outFileStr, errMsg);
     }
+    if(fP && strcmp(outFileStr, "-"))
+    {
+      (void )fclose(fP);
+      fP = NULL;
+    }
+  }
+  if(ok && paged)
+  {
+    /* Read the tiled object back with it's tiles paged and check that
+     * all it's values are the same as those of the tiled object. */
+    WlzTiledValuesSetPageCacheSz((size_t )(pageCacheSz * 1024.0 * 1024.0));
+    if(((fP = fopen(outFileStr, "rb")) == NULL) ||
+       ((pgObj= WlzAssignObject(WlzReadObj(fP, &errNum), NULL)) == NULL))
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+                     "%s: Failed to read paged object from file %s (%s).\n",
+		     *argv, outFileStr, errMsg);
+    }
+    if(fP)
+    {
+      (void )fclose(fP);
+    }
+    WlzTiledValuesSetPageCacheSz(0);
+    if(ok && (pgObj->values.t->pager == NULL))
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: Object tiles were not paged.\n", *argv);
+    }
+    if(ok)
+    {
+      int	idX,
+      		idY,
+		idZ,
+		nDif = 0;
+      WlzIBox3	box;
+      WlzGreyValueWSpace *tlWSp = NULL,
+      		*pgWSp = NULL;
+
+      box = WlzBoundingBox3I(tlObj, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        tlWSp = WlzGreyValueMakeWSp(tlObj, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        pgWSp = WlzGreyValueMakeWSp(pgObj, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	for(idZ = box.zMin - 1; idZ <= box.zMax + 1; ++idZ)
+	{
+	  for(idY = box.yMin - 1; idY <= box.yMax + 1; ++idY)
+	  {
+	    for(idX = box.xMin - 1; idX <= box.xMax + 1; ++idX)
+	    {
+	      WlzGreyValueGet(tlWSp, idZ, idY, idX);
+	      WlzGreyValueGet(pgWSp, idZ, idY, idX);
+	      if(tlWSp->gVal[0].ubv != pgWSp->gVal[0].ubv)
+	      {
+		++nDif;
+	      }
+	    }
+	  }
+	}
+      }
+      WlzGreyValueFreeWSp(tlWSp);
+      WlzGreyValueFreeWSp(pgWSp);
+      if((errNum != WLZ_ERR_NONE) || (nDif != 0))
+      {
+	ok = 0;
+	(void )WlzStringFromErrorNum(errNum, &errMsg);
+	(void )fprintf(stderr,
+		       "%s: Paged object values differ at %d positions (%s).\n",
+		       *argv, nDif, errMsg);
+      }
+    }
   }
   if(ok && section && (dim == 3))
   {
@@ -239,7 +331,7 @@ int		main(int argc, char *argv[])
       view->up = up;
       view->view_mode = mode;
       view->scale = scale;
-      errNum = WlzInit3DViewStruct(view, tlObj);
+      errNum = WlzInit3DViewStruct(view, (pgObj)? pgObj: tlObj);
     }
     if(errNum == WLZ_ERR_NONE)
     {
@@ -247,7 +339,8 @@ int		main(int argc, char *argv[])
       {
 	gettimeofday(times + 0, NULL); 
       }
-      secObj = WlzGetSubSectionFromObject(tlObj, NULL, view, interp,
+      secObj = WlzGetSubSectionFromObject((pgObj)? pgObj: tlObj,
+      					  NULL, view, interp,
       					  NULL, &errNum);
       if(timer)
       {
@@ -278,6 +371,7 @@ int		main(int argc, char *argv[])
     (void )WlzFree3DViewStruct(view);
     (void )WlzFreeObj(secObj);
   }
+  (void )WlzFreeObj(pgObj);
   (void )WlzFreeObj(tlObj);
   (void )WlzFreeObj(inObj);
   if(usage)
@@ -285,12 +379,15 @@ int		main(int argc, char *argv[])
     (void )fprintf(stderr,
     "Usage: %s%s",
     *argv,
-    " [-o<output object>] [-h] [-o <file>] [-s] [-S <file>] [-t]\n"
-    "                  [<input object>]\n"
+    " [-o<output object>] [-h] [-o <file>] [-p <size>] [-s] [-S <file>]\n"
+    "                  [-t] [<input object>]\n"
     "Copied the input object to an object with tiled values.\n"
     "Options:\n"
     "  -h  Prints this usage information.\n"
     "  -o  Output tiled object.\n"
+    "  -p  Read the output tiled object back with it's tiles paged into\n"
+    "      a cache of the given size (Mb), check that it's values are the\n"
+    "      same and then cut any section from it.\n"
     "  -s  Cut section from tiled object.\n"
     "  -S  Output file for section object.\n"
     "  -t  Output timing information.\n");
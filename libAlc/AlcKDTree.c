@@ -46,6 +46,56 @@ static char _AlcKDTree_c[] = "University of Edinburgh $Id$";
 #include <limits.h>
 #include <Alc.h>
 
+/*!
+* \def		ALC_KDT_KNN_STACK
+* \ingroup	AlcKDTree
+* \brief	Number of nearest neighbour distances that are held on
+*		the stack, rather than being allocated, by AlcKDTGetKNN().
+*/
+#define ALC_KDT_KNN_STACK	(64)
+
+/*!
+* \struct	_AlcKDTQueryWSp
+* \ingroup	AlcKDTree
+* \brief	Workspace for a single k-nearest neighbour or radius
+*		query. Each query has it's own workspace so that many
+*		queries may be made concurrently on the same tree.
+*/
+typedef struct _AlcKDTQueryWSp
+{
+  AlcPointP	key;		/*!< The query key. */
+  int		radius;		/*!< Non-zero for a radius query, in
+  				     which case all nodes within the
+				     radius are found rather than the
+				     k nearest. */
+  size_t	k;		/*!< Maximum number of nodes to be found
+  				     for a k-nearest neighbour query or
+				     number of node pointers that may
+				     be stored for a radius query. */
+  size_t	n;		/*!< Number of nodes found. */
+  double	maxDSq;		/*!< Square of the maximum distance. */
+  AlcKDTNode	**nod;		/*!< Nodes found, for k-nearest neighbour
+  				     queries these are sorted by
+				     increasing distance. */
+  double	*dSq;		/*!< Squared distances of the nodes
+  				     found. */
+} AlcKDTQueryWSp;
+
+/*!
+* \struct	_AlcKDTBuildWSp
+* \ingroup	AlcKDTree
+* \brief	Workspace used when building a balanced tree from an
+*		array of keys.
+*/
+typedef struct _AlcKDTBuildWSp
+{
+  AlcPointP	keys;		/*!< The given keys. */
+  size_t	*idx;		/*!< Indices of the keys. */
+  AlcKDTNode	*nodes;		/*!< Contiguous array of nodes. */
+  AlcPointP	nodeKeys;	/*!< Contiguous array of node keys and
+  				     bounds. */
+} AlcKDTBuildWSp;
+
 static void			AlcKDTBoundSet(
 				  AlcKDTTree *tree,
 				  AlcKDTNode *node,
@@ -65,11 +115,6 @@ static int			AlcKDTNodeValueCompare(
 				  AlcKDTTree *tree,
 				  AlcKDTNode *node,
 				  AlcPointP key);
-static int			AlcKDTNodeIntersectsSphereBB(
-				  AlcKDTTree *tree,
-				  AlcKDTNode *node,
-				  AlcPointP centre,
-				  double radius);
 static double			AlcKDTKeyDistSq(
 				  AlcKDTTree *tree,
 				  AlcPointP key0,
@@ -79,12 +124,39 @@ static AlcErrno        		AlcKDTTreeExpand(
 static AlcKDTNode		*AlcKDTNodeAlcNew(
 				  AlcKDTTree *tree,
 				  AlcErrno *dstErr);
-static AlcKDTNode 		*AlcKDTNodeGetNN(
+static int			AlcKDTKeyCompare(
 				  AlcKDTTree *tree,
+				  int split,
+				  AlcPointP key0,
+				  AlcPointP key1);
+static int			AlcKDTBuildSplit(
+				  AlcKDTTree *tree,
+				  AlcKDTBuildWSp *wSp,
+				  size_t lo,
+				  size_t hi);
+static void			AlcKDTBuildSelect(
+				  AlcKDTTree *tree,
+				  AlcKDTBuildWSp *wSp,
+				  int split,
+				  size_t lo,
+				  size_t hi,
+				  size_t mid);
+static AlcKDTNode		*AlcKDTBuildNodes(
+				  AlcKDTTree *tree,
+				  AlcKDTBuildWSp *wSp,
+				  AlcKDTNode *parent,
+				  int cmp,
+				  size_t lo,
+				  size_t hi,
+				  size_t base);
+static void			AlcKDTNodeQuery(
+				  AlcKDTTree *tree,
+				  AlcKDTNode *node,
+				  AlcKDTQueryWSp *wSp);
+static void			AlcKDTQueryWSpAdd(
+				  AlcKDTQueryWSp *wSp,
 				  AlcKDTNode *node,
-				  AlcPointP key,
-				  double minDist,
-				  double *dstDist);
+				  double dSq);
 
 /*!
 * \return     	KD-tree data structure, or NULL on error.
@@ -157,6 +229,315 @@ AlcKDTTree	*AlcKDTTreeNew(AlcPointType type, int dim, double tol,
   return(tree);
 }
 
+/*!
+* \return	KD-tree data structure, or NULL on error.
+* \ingroup	AlcKDTree
+* \brief	Creates a balanced KD-tree from an array of keys. Rather
+*		than inserting the keys one at a time, the tree is built
+*		by recursively splitting the keys at their median along
+*		the dimension in which they have the greatest extent.
+*		The nodes and their keys are allocated as single blocks
+*		and laid out in depth first order, which keeps nodes
+*		that are close in the tree close in memory.
+*		The index of each node is the index of it's key in the
+*		given array. Unlike AlcKDTInsert() duplicate keys are
+*		not merged. Further nodes may be inserted into the tree
+*		using AlcKDTInsert().
+* \param	type			Type of tree node key.
+* \param	dim			Dimension of tree (must be >= 1).
+* \param	tol			Tollerance for key comparision,
+*					see AlcKDTTreeNew().
+* \param	nKeys			Number of keys.
+* \param	keys			Array of nKeys keys, each of
+*					which has dim values of the given
+*					type.
+* \param	dstErr			Destination pointer for error
+*					code, may be NULL.
+*/
+AlcKDTTree	*AlcKDTTreeBuild(AlcPointType type, int dim, double tol,
+				 size_t nKeys, void *keys, AlcErrno *dstErr)
+{
+  size_t	idx;
+  AlcBlockStack	*nStk,
+  		*kStk;
+  AlcKDTBuildWSp wSp;
+  AlcKDTTree	*tree = NULL;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  wSp.idx = NULL;
+  if((nKeys > 0) && (keys == NULL))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else
+  {
+    tree = AlcKDTTreeNew(type, dim, tol, nKeys, &errNum);
+  }
+  if((errNum == ALC_ER_NONE) && (nKeys > 0))
+  {
+    nStk = AlcBlockStackNew(nKeys, sizeof(AlcKDTNode), tree->freeStack,
+			    &errNum);
+    if(errNum == ALC_ER_NONE)
+    {
+      tree->freeStack = nStk;
+      kStk = AlcBlockStackNew(nKeys, 3 * tree->keySz, tree->freeStack,
+			      &errNum);
+    }
+    if(errNum == ALC_ER_NONE)
+    {
+      tree->freeStack = kStk;
+      nStk->elmCnt = nStk->maxElm;
+      kStk->elmCnt = kStk->maxElm;
+      if((wSp.idx = (size_t *)AlcMalloc(sizeof(size_t) * nKeys)) == NULL)
+      {
+	errNum = ALC_ER_ALLOC;
+      }
+    }
+    if(errNum == ALC_ER_NONE)
+    {
+      for(idx = 0; idx < nKeys; ++idx)
+      {
+	wSp.idx[idx] = idx;
+      }
+      wSp.keys.kV = keys;
+      wSp.nodes = (AlcKDTNode *)(nStk->elements);
+      wSp.nodeKeys.kV = kStk->elements;
+      tree->root = AlcKDTBuildNodes(tree, &wSp, NULL, 0, 0, nKeys, 0);
+      tree->nNodes = nKeys;
+    }
+    AlcFree(wSp.idx);
+  }
+  if(errNum != ALC_ER_NONE)
+  {
+    (void )AlcKDTTreeFree(tree);
+    tree = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tree);
+}
+
+/*!
+* \return	New node at the root of the sub-tree.
+* \ingroup	AlcKDTree
+* \brief	Recursively builds the balanced sub-tree for the keys
+*		with indices in the range [lo, hi). The node for the
+*		median key is placed at base in the node array followed
+*		by the nodes of it's childP and then it's childN
+*		sub-trees.
+* \param	tree			The KD-tree being built.
+* \param	wSp			Build workspace.
+* \param	parent			Parent node, NULL for the root.
+* \param	cmp			Which of the parent's children
+*					the new node will become, see
+*					AlcKDTNodeNew().
+* \param	lo			First index of the range.
+* \param	hi			One past the last index of the
+*					range, must be greater than lo.
+* \param	base			Index of the new node in the node
+*					array.
+*/
+static AlcKDTNode *AlcKDTBuildNodes(AlcKDTTree *tree, AlcKDTBuildWSp *wSp,
+				    AlcKDTNode *parent, int cmp,
+				    size_t lo, size_t hi, size_t base)
+{
+  int		split;
+  size_t	mid;
+  AlcPointP	key;
+  AlcKDTNode	*node;
+
+  split = AlcKDTBuildSplit(tree, wSp, lo, hi);
+  mid = lo + ((hi - lo) / 2);
+  AlcKDTBuildSelect(tree, wSp, split, lo, hi, mid);
+  node = wSp->nodes + base;
+  node->idx = wSp->idx[mid];
+  node->split = split;
+  node->parent = parent;
+  if(tree->type == ALC_POINTTYPE_INT)
+  {
+    node->key.kI = wSp->nodeKeys.kI + (3 * tree->dim * base);
+    node->boundN.kI = node->key.kI + tree->dim;
+    node->boundP.kI = node->key.kI + (2 * tree->dim);
+    key.kI = wSp->keys.kI + (tree->dim * node->idx);
+  }
+  else /* tree->type == ALC_POINTTYPE_DBL */
+  {
+    node->key.kD = wSp->nodeKeys.kD + (3 * tree->dim * base);
+    node->boundN.kD = node->key.kD + tree->dim;
+    node->boundP.kD = node->key.kD + (2 * tree->dim);
+    key.kD = wSp->keys.kD + (tree->dim * node->idx);
+  }
+  AlcKDTValuesSet(tree, node->key, key);
+  AlcKDTBoundSet(tree, node, cmp);
+  /* Keys less than the median key are in childP. */
+  node->childP = (mid > lo)?
+		 AlcKDTBuildNodes(tree, wSp, node, 1, lo, mid,
+		                  base + 1): NULL;	 	/* Recursive */
+  node->childN = (hi > mid + 1)?
+		 AlcKDTBuildNodes(tree, wSp, node, -1, mid + 1, hi,
+		                  base + 1 + mid - lo): NULL; 	/* Recursive */
+  return(node);
+}
+
+/*!
+* \return	Splitting dimension.
+* \ingroup	AlcKDTree
+* \brief	Finds the dimension in which the keys with indices in
+*		the range [lo, hi) have the greatest extent.
+* \param	tree			The KD-tree being built.
+* \param	wSp			Build workspace.
+* \param	lo			First index of the range.
+* \param	hi			One past the last index of the
+*					range.
+*/
+static int	AlcKDTBuildSplit(AlcKDTTree *tree, AlcKDTBuildWSp *wSp,
+				 size_t lo, size_t hi)
+{
+  int		idD,
+  		split = 0;
+  size_t	idx;
+  double	ext,
+  		maxExt = -1.0;
+
+  for(idD = 0; idD < tree->dim; ++idD)
+  {
+    double	v,
+    		vMin,
+		vMax;
+
+    vMin = DBL_MAX;
+    vMax = -DBL_MAX;
+    for(idx = lo; idx < hi; ++idx)
+    {
+      v = (tree->type == ALC_POINTTYPE_INT)?
+	  (double )(wSp->keys.kI[(tree->dim * wSp->idx[idx]) + idD]):
+	  wSp->keys.kD[(tree->dim * wSp->idx[idx]) + idD];
+      if(v < vMin)
+      {
+	vMin = v;
+      }
+      if(v > vMax)
+      {
+	vMax = v;
+      }
+    }
+    ext = vMax - vMin;
+    if(ext > maxExt)
+    {
+      maxExt = ext;
+      split = idD;
+    }
+  }
+  return(split);
+}
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Partially sorts the key indices in the range [lo, hi)
+*		so that the key at mid is that which would be there if
+*		the keys were sorted, with no key before it greater and
+*		no key after it less than it. Keys are ordered as by
+*		AlcKDTKeyCompare().
+* \param	tree			The KD-tree being built.
+* \param	wSp			Build workspace.
+* \param	split			Splitting dimension.
+* \param	lo			First index of the range.
+* \param	hi			One past the last index of the
+*					range.
+* \param	mid			Index of the key to be selected.
+*/
+static void	AlcKDTBuildSelect(AlcKDTTree *tree, AlcKDTBuildWSp *wSp,
+				  int split, size_t lo, size_t hi, size_t mid)
+{
+  size_t	i,
+  		j,
+		t,
+		r;
+  AlcPointP	pivot,
+  		key;
+
+  r = hi - 1;
+  while(r > lo)
+  {
+    /* Hoare partition about the median of the first, middle and last
+     * keys. */
+    size_t	m;
+    size_t	*idx;
+
+    idx = wSp->idx;
+    m = lo + ((r - lo) / 2);
+#define ALC_KDT_BUILD_KEY(P,I) \
+    if(tree->type == ALC_POINTTYPE_INT) \
+    { \
+      (P).kI = wSp->keys.kI + (tree->dim * idx[(I)]); \
+    } \
+    else \
+    { \
+      (P).kD = wSp->keys.kD + (tree->dim * idx[(I)]); \
+    }
+#define ALC_KDT_BUILD_SWAP(I,J) \
+    t = idx[(I)]; idx[(I)] = idx[(J)]; idx[(J)] = t;
+    ALC_KDT_BUILD_KEY(pivot, lo);
+    ALC_KDT_BUILD_KEY(key, m);
+    if(AlcKDTKeyCompare(tree, split, key, pivot) < 0)
+    {
+      ALC_KDT_BUILD_SWAP(lo, m);
+    }
+    ALC_KDT_BUILD_KEY(pivot, lo);
+    ALC_KDT_BUILD_KEY(key, r);
+    if(AlcKDTKeyCompare(tree, split, key, pivot) < 0)
+    {
+      ALC_KDT_BUILD_SWAP(lo, r);
+    }
+    ALC_KDT_BUILD_KEY(pivot, m);
+    ALC_KDT_BUILD_KEY(key, r);
+    if(AlcKDTKeyCompare(tree, split, key, pivot) < 0)
+    {
+      ALC_KDT_BUILD_SWAP(m, r);
+    }
+    ALC_KDT_BUILD_KEY(pivot, m);
+    i = lo;
+    j = r;
+    for(;;)
+    {
+      ALC_KDT_BUILD_KEY(key, i);
+      while(AlcKDTKeyCompare(tree, split, key, pivot) < 0)
+      {
+	++i;
+	ALC_KDT_BUILD_KEY(key, i);
+      }
+      ALC_KDT_BUILD_KEY(key, j);
+      while(AlcKDTKeyCompare(tree, split, key, pivot) > 0)
+      {
+	--j;
+	ALC_KDT_BUILD_KEY(key, j);
+      }
+      if(i >= j)
+      {
+	break;
+      }
+      /* The pivot key may move so keep pointing at it's values. */
+      ALC_KDT_BUILD_SWAP(i, j);
+      ++i;
+      --j;
+    }
+#undef ALC_KDT_BUILD_KEY
+#undef ALC_KDT_BUILD_SWAP
+    /* Keys in [lo, j] are not greater and those in (j, r] are not
+     * less than the pivot. */
+    if(mid <= j)
+    {
+      r = j;
+    }
+    else
+    {
+      lo = j + 1;
+    }
+  }
+}
+
 /*!
 * \return      	Number of nodes.
 * \ingroup	AlcKDTree
@@ -690,7 +1071,9 @@ AlcKDTNode 	*AlcKDTGetLeaf(AlcKDTTree *tree,  AlcKDTNode *node,
 * \ingroup	AlcKDTree
 *		tree has no nodes.
 * \brief  	Searches for the nearest neighbour node to the given
-*		key within the tree.
+*		key within the tree. This function does not modify the
+*		tree and so may be called concurrently from several
+*		threads.
 * \param     	tree			Given tree,
 * \param	keyVal			Key values which must be
 *					consistent with the tree's node
@@ -699,8 +1082,6 @@ AlcKDTNode 	*AlcKDTGetLeaf(AlcKDTTree *tree,  AlcKDTNode *node,
 *					key and the nearest neighbour,
 *					any node at a greater distance
 *					is not a nearest neighbour.
-*					Confusingly used for the minimum
-*					key-node distance found.
 * \param	dstNNDist		Destination pointer for distance
 *					to nearest neighbour, may be NULL.
 * \param	dstErr			Destination pointer for error
@@ -710,216 +1091,347 @@ AlcKDTNode	*AlcKDTGetNN(AlcKDTTree *tree,  void *keyVal,
 			     double minDist, double *dstNNDist,
 			     AlcErrno *dstErr)
 {
+  double	dSq;
+  AlcKDTNode	*nNNode = NULL;
+  AlcErrno	errNum = ALC_ER_NONE;
 
-  double	dist,
-		distSq;
-  AlcPointP	key;
-  AlcKDTNode	*tstNode0,
-		*tstNode1,
-		*nNNode = NULL;
+  (void )AlcKDTGetKNN(tree, keyVal, 1, minDist, &nNNode, &dSq, &errNum);
+  if(nNNode && dstNNDist)
+  {
+    *dstNNDist = dSq;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nNNode);
+}
+
+/*!
+* \return	Number of nodes found.
+* \ingroup	AlcKDTree
+* \brief	Searches for the k nearest neighbour nodes to the given
+*		key within the tree. The nodes found are sorted by
+*		increasing distance from the key. This function does
+*		not modify the tree and so may be called concurrently
+*		from several threads.
+* \param	tree			Given tree.
+* \param	keyVal			Key values which must be
+*					consistent with the tree's node
+*					key type and dimension.
+* \param	k			Maximum number of nodes to find.
+* \param	maxDist			Maximum distance between the
+*					given key and a neighbour, nodes
+*					at this or a greater distance are
+*					not neighbours.
+* \param	dstNod			Destination array for at least k
+*					node pointers, must not be NULL.
+* \param	dstDist			Destination array for at least k
+*					distances, may be NULL.
+* \param	dstErr			Destination pointer for error
+*					code, may be NULL.
+*/
+size_t		AlcKDTGetKNN(AlcKDTTree *tree, void *keyVal, size_t k,
+			     double maxDist, AlcKDTNode **dstNod,
+			     double *dstDist, AlcErrno *dstErr)
+{
+  size_t	idx;
+  double	dSqBuf[ALC_KDT_KNN_STACK];
+  AlcKDTQueryWSp wSp;
   AlcErrno	errNum = ALC_ER_NONE;
 
-  if((tree == NULL) || (keyVal == NULL))
+  wSp.n = 0;
+  wSp.dSq = NULL;
+  if((tree == NULL) || (keyVal == NULL) || (dstNod == NULL))
   {
     errNum = ALC_ER_NULLPTR;
   }
-  else
+  else if((k > 0) && tree->root && (maxDist > 0.0))
   {
-    key.kV = keyVal;
-    if(tree->root != NULL)
+    wSp.key.kV = keyVal;
+    wSp.radius = 0;
+    wSp.k = k;
+    wSp.maxDSq = (maxDist < sqrt(DBL_MAX))? maxDist * maxDist: DBL_MAX;
+    wSp.nod = dstNod;
+    if(dstDist)
     {
-      /* Find leaf node which encloses the given key. */
-      tstNode0 = AlcKDTGetLeaf(tree, tree->root, key);
-      /* Update the minimum distance criterea for a nearest neighbour. */
-      distSq = AlcKDTKeyDistSq(tree, tstNode0->key, key);
-      if(distSq < (minDist * minDist))
-      {
-	nNNode = tstNode0;
-	dist = minDist = sqrt(distSq);
-      }
-      /* Walk up the tree until either the parent is NULL (at root of tree)
-       * or the parent node does not intersect the hyper-sphere with
-       * centre at key with radius minDist). */
-      while(((tstNode1 = tstNode0->parent) != NULL) &&
-	    AlcKDTNodeIntersectsSphereBB(tree, tstNode1, key, minDist))
+      wSp.dSq = dstDist;
+    }
+    else if(k <= ALC_KDT_KNN_STACK)
+    {
+      wSp.dSq = dSqBuf;
+    }
+    else if((wSp.dSq = (double *)AlcMalloc(sizeof(double) * k)) == NULL)
+    {
+      errNum = ALC_ER_ALLOC;
+    }
+    if(errNum == ALC_ER_NONE)
+    {
+      AlcKDTNodeQuery(tree, tree->root, &wSp);
+      if(dstDist)
       {
-	tstNode0 = tstNode1;
+	for(idx = 0; idx < wSp.n; ++idx)
+	{
+	  dstDist[idx] = sqrt(dstDist[idx]);
+	}
       }
-      /* Walk back down the tree testing nodes that intersect the hyper-sphere
-       * until either the child is NULL (at a leaf) or the child does not
-       * intersect the hyper-sphere, updating the nearest neighbour node
-       * and distance while walking. */
-      tstNode1 = AlcKDTNodeGetNN(tree, tstNode0, key, minDist, &dist);
-      if(tstNode1 && (dist < minDist))
+      else if(k > ALC_KDT_KNN_STACK)
       {
-	minDist = dist;
-	nNNode = tstNode1;
+	AlcFree(wSp.dSq);
       }
     }
   }
-  if(dstNNDist)
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(wSp.n);
+}
+
+/*!
+* \return	Number of nodes within the given radius of the key,
+*		this may be greater than maxNod.
+* \ingroup	AlcKDTree
+* \brief	Searches for all nodes within the given distance of
+*		the given key. The nodes are not sorted. This function
+*		does not modify the tree and so may be called
+*		concurrently from several threads.
+* \param	tree			Given tree.
+* \param	keyVal			Key values which must be
+*					consistent with the tree's node
+*					key type and dimension.
+* \param	radius			Radius of the hyper-sphere within
+*					which (inclusive) nodes are found.
+* \param	maxNod			Maximum number of node pointers
+*					and distances that may be set,
+*					only the first maxNod nodes found
+*					are set.
+* \param	dstNod			Destination array for at least
+*					maxNod node pointers, may be NULL
+*					if maxNod is zero.
+* \param	dstDist			Destination array for at least
+*					maxNod distances, may be NULL.
+* \param	dstErr			Destination pointer for error
+*					code, may be NULL.
+*/
+size_t		AlcKDTGetWithinRadius(AlcKDTTree *tree, void *keyVal,
+				      double radius, size_t maxNod,
+				      AlcKDTNode **dstNod, double *dstDist,
+				      AlcErrno *dstErr)
+{
+  size_t	idx;
+  AlcKDTQueryWSp wSp;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  wSp.n = 0;
+  if((tree == NULL) || (keyVal == NULL) || ((maxNod > 0) && (dstNod == NULL)))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if(tree->root && (radius >= 0.0))
   {
-    if(nNNode != NULL)
+    wSp.key.kV = keyVal;
+    wSp.radius = 1;
+    wSp.k = maxNod;
+    wSp.maxDSq = radius * radius;
+    wSp.nod = dstNod;
+    wSp.dSq = dstDist;
+    AlcKDTNodeQuery(tree, tree->root, &wSp);
+    if(dstDist)
     {
-      *dstNNDist = minDist;
+      idx = (wSp.n < maxNod)? wSp.n: maxNod;
+      while(idx-- > 0)
+      {
+	dstDist[idx] = sqrt(dstDist[idx]);
+      }
     }
   }
   if(dstErr)
   {
     *dstErr = errNum;
   }
-  return(nNNode);
+  return(wSp.n);
 }
 
 /*!
-* \return:	Nearest neighbour node in tree, NULL on error or if tree
+* \return	Error code.
 * \ingroup	AlcKDTree
-*		has no nodes.
-* \brief  	Walks down the tree testing nodes that intersect the
-* 		hyper-sphere until either the child is NULL (at a leaf)
-*		or the child does not intersect the hyper-sphere,
-*		updating the nearest neighbour node and distance while
-*		walking.
-* \param     	tree			Given tree,
-* \param	node			Given node.
-* \param	key			Given key.
-* \param	minDist			Minimum distance between given
-*					key and the nearest neighbour,
-*					any node at a greater distance
-*					is not a nearest neighbour.
-* \param	doubleminDist		Destination pointer for minimum
-*					distance to nearest neighbour
-*					so far.
+* \brief	Searches for the k nearest neighbour nodes of each of
+*		the given keys, see AlcKDTGetKNN(). When built with
+*		OpenMP the queries are made in parallel. The tree is
+*		not modified and this function may be called
+*		concurrently from several threads.
+* \param	tree			Given tree.
+* \param	nKeys			Number of keys.
+* \param	keys			Array of nKeys keys, each of
+*					which has tree dimension values
+*					of the tree's key type.
+* \param	k			Maximum number of nodes to find
+*					for each key.
+* \param	maxDist			Maximum distance between a key
+*					and it's neighbours.
+* \param	dstNod			Destination array for nKeys * k
+*					node pointers with the neighbours
+*					of key i at i * k. Node pointers
+*					for which no neighbour was found
+*					are set to NULL.
+* \param	dstDist			Destination array for nKeys * k
+*					distances, may be NULL.
+* \param	dstCnt			Destination array for the nKeys
+*					numbers of neighbours found, may
+*					be NULL.
 */
-static AlcKDTNode *AlcKDTNodeGetNN(AlcKDTTree *tree,  AlcKDTNode *node,
-				   AlcPointP key, double minDist,
-				   double *dstDist)
+AlcErrno	AlcKDTGetKNNBatch(AlcKDTTree *tree, size_t nKeys, void *keys,
+				  size_t k, double maxDist,
+				  AlcKDTNode **dstNod, double *dstDist,
+				  size_t *dstCnt)
 {
-  double	tstDist,
-		tstDistSq;
-  AlcKDTNode	*tstNode,
-		*nNNode = NULL;
-
-  /* If this node's bounding box intersects the hyper-sphere check
-   * the node and its children for the nearest neighbour. */
-  if(AlcKDTNodeIntersectsSphereBB(tree, node, key, minDist))
+  long		idK;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if((tree == NULL) ||
+     ((nKeys > 0) && (k > 0) && ((keys == NULL) || (dstNod == NULL))))
   {
-    tstDistSq = AlcKDTKeyDistSq(tree, node->key, key);
-    if(tstDistSq < (minDist * minDist))
-    {
-      nNNode = node;
-      minDist = sqrt(tstDistSq);
-    }
-    if(node->childN)
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if(k > 0)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+    for(idK = 0; idK < (long )nKeys; ++idK)
     {
-      tstNode = AlcKDTNodeGetNN(tree, node->childN, key, minDist,
-				&tstDist); 			/* Recursive */
-      if(tstNode && (tstDist < minDist))
+      size_t	n,
+      		off;
+      void	*key;
+      AlcErrno	errK;
+
+      off = idK * k;
+      key = (tree->type == ALC_POINTTYPE_INT)?
+	    (void *)((int *)keys + (idK * tree->dim)):
+	    (void *)((double *)keys + (idK * tree->dim));
+      n = AlcKDTGetKNN(tree, key, k, maxDist, dstNod + off,
+		       (dstDist)? dstDist + off: NULL, &errK);
+      if(errK != ALC_ER_NONE)
       {
-	nNNode = tstNode;
-	minDist = tstDist;
+#ifdef _OPENMP
+#pragma omp critical (AlcKDTGetKNNBatch)
+#endif
+	{
+	  errNum = errK;
+	}
       }
-    }
-    if(node->childP)
-    {
-      tstNode = AlcKDTNodeGetNN(tree, node->childP, key, minDist,
-				&tstDist); 			/* Recursive */
-      if(tstNode && (tstDist < minDist))
+      if(dstCnt)
       {
-	nNNode = tstNode;
-	minDist = tstDist;
+        dstCnt[idK] = n;
+      }
+      while(n < k)
+      {
+        dstNod[off + n] = NULL;
+	if(dstDist)
+	{
+	  dstDist[off + n] = -1.0;
+	}
+	++n;
       }
     }
-    *dstDist = minDist;
   }
-  return(nNNode);
+  return(errNum);
 }
 
-
 /*!
-* \return	Non zero if the given node intersects the given sphere.
 * \ingroup	AlcKDTree
-* \brief  	Computes whether the given node intersects the given
-*		hyper-sphere's bounding box.
-*		There are 2 algorithms that can be used.
-*		* Always true test, NOT RECOMENDED for anything except
-*		  testing.
-*		* Box intersection test, checks for an intersection
-*		  between the bounding boxes of the node and the
-*		  hyper-sphere.
-* 		
-* 		This function will in most cases dominate the performance
-* 		of kD-tree queries so there's been some effort to optimise
-* 		the code.
-* \param     	tree			Given tree,
+* \brief	Recursively searches the tree below and including the
+*		given node for nodes closer to the query key than the
+*		furthest node yet found. The near side of each split is
+*		searched before the far side, which is only searched if
+*		the splitting plane is closer to the key than the
+*		furthest node found so far.
+* \param	tree			Given tree.
 * \param	node			Given node.
-* \param	centre			Given key at centre of the
-*					hyper-sphere.
-* \param	radius			Radius of the hyper-sphere.
+* \param	wSp			Query workspace.
 */
-static int	AlcKDTNodeIntersectsSphereBB(AlcKDTTree *tree,
-				             AlcKDTNode *node,
-					     AlcPointP centre,
-					     double radius)
-#ifdef ALC_KDT_ALWAYSTRUE_TEST
+static void	AlcKDTNodeQuery(AlcKDTTree *tree, AlcKDTNode *node,
+				AlcKDTQueryWSp *wSp)
 {
-  return(1);
+  double	dSq,
+  		diff,
+		limSq;
+  AlcKDTNode	*far;
+
+  while(node)
+  {
+    dSq = AlcKDTKeyDistSq(tree, node->key, wSp->key);
+    AlcKDTQueryWSpAdd(wSp, node, dSq);
+    diff = (tree->type == ALC_POINTTYPE_INT)?
+           (double )(node->key.kI[node->split] - wSp->key.kI[node->split]):
+	   node->key.kD[node->split] - wSp->key.kD[node->split];
+    /* A +ve comparison puts the key in childP. */
+    if(diff > 0.0)
+    {
+      far = node->childN;
+      node = node->childP;
+    }
+    else
+    {
+      far = node->childP;
+      node = node->childN;
+    }
+    if(node)
+    {
+      AlcKDTNodeQuery(tree, node, wSp); 			/* Recursive */
+    }
+    limSq = (wSp->radius || (wSp->n < wSp->k))?
+            wSp->maxDSq: wSp->dSq[wSp->k - 1];
+    node = ((diff * diff) < limSq ||
+            (wSp->radius && ((diff * diff) <= limSq)))? far: NULL;
+  }
 }
-#else
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Adds the given node to the nodes found by a query if
+*		it is close enough to the query key.
+* \param	wSp			Query workspace.
+* \param	node			Given node.
+* \param	dSq			Squared distance of the node from
+*					the query key.
+*/
+static void	AlcKDTQueryWSpAdd(AlcKDTQueryWSp *wSp, AlcKDTNode *node,
+				  double dSq)
 {
-  int  		idx,
-		inside = 1;
+  size_t	idx;
 
-  idx = 0;
-  if(tree->type == ALC_POINTTYPE_INT)
+  if(wSp->radius)
   {
-    int		radF,
-    		radC;
-
-    radF = (int )floor(radius);
-    radC = (int )ceil(radius);
-    switch(tree->dim)
+    if(dSq <= wSp->maxDSq)
     {
-      case 2:
-	{
-	  inside = (node->boundP.kI[0] >= (centre.kI[0] - radF)) &&
-		   (node->boundN.kI[0] <= (centre.kI[0] + radC)) &&
-	           (node->boundP.kI[1] >= (centre.kI[1] - radF)) &&
-		   (node->boundN.kI[1] <= (centre.kI[1] + radC));
-	}
-	break;
-      case 3:
-	{
-	  inside = (node->boundP.kI[0] >= (centre.kI[0] - radF)) &&
-		   (node->boundN.kI[0] <= (centre.kI[0] + radC)) &&
-	           (node->boundP.kI[1] >= (centre.kI[1] - radF)) &&
-		   (node->boundN.kI[1] <= (centre.kI[1] + radC)) &&
-	           (node->boundP.kI[2] >= (centre.kI[2] - radF)) &&
-		   (node->boundN.kI[2] <= (centre.kI[2] + radC));
-	}
-	break;
-      default:
-	do
+      if(wSp->n < wSp->k)
+      {
+	wSp->nod[wSp->n] = node;
+	if(wSp->dSq)
 	{
-	  inside &= (node->boundP.kI[idx] >= (centre.kI[idx] - radF)) &&
-		    (node->boundN.kI[idx] <= (centre.kI[idx] + radC));
+	  wSp->dSq[wSp->n] = dSq;
 	}
-	while(inside && (++idx < tree->dim));
-	break;
+      }
+      ++(wSp->n);
     }
   }
-  else /* tree->type == ALC_POINTTYPE_DBL */
+  else if((dSq < wSp->maxDSq) &&
+          ((wSp->n < wSp->k) || (dSq < wSp->dSq[wSp->k - 1])))
   {
-    do
+    /* Insertion into the sorted list of the k nearest nodes. */
+    idx = (wSp->n < wSp->k)? wSp->n++: wSp->k - 1;
+    while((idx > 0) && (wSp->dSq[idx - 1] > dSq))
     {
-      inside &= (node->boundP.kD[idx] >= (centre.kD[idx] - radius)) &&
-		(node->boundN.kD[idx] <= (centre.kD[idx] + radius));
+      wSp->nod[idx] = wSp->nod[idx - 1];
+      wSp->dSq[idx] = wSp->dSq[idx - 1];
+      --idx;
     }
-    while(inside && (++idx < tree->dim));
+    wSp->nod[idx] = node;
+    wSp->dSq[idx] = dSq;
   }
-  return(inside);
 }
-#endif
 
 /*!
 * \return	<void>
@@ -1054,6 +1566,40 @@ static int	AlcKDTNodeValueCompare(AlcKDTTree *tree, AlcKDTNode *node,
   return(cmp);
 }
 
+/*!
+* \return	Result of comparision 0, -ve or +ve.
+* \ingroup	AlcKDTree
+* \brief	Compares two keys exactly, first using their values in
+*		the splitting dimension and then their values in the
+*		following dimensions (cyclically). This gives the same
+*		ordering as AlcKDTNodeValueCompare() for a zero
+*		tolerance.
+* \param	tree			Tree, used to determine key type.
+* \param	split			Splitting dimension.
+* \param	key0			First key.
+* \param	key1			Second key.
+*/
+static int	AlcKDTKeyCompare(AlcKDTTree *tree, int split,
+				 AlcPointP key0, AlcPointP key1)
+{
+  int		idx,
+  		cmp = 0;
+
+  idx = split;
+  do
+  {
+    if(tree->type == ALC_POINTTYPE_INT)
+    {
+      cmp = (key0.kI[idx] > key1.kI[idx]) - (key0.kI[idx] < key1.kI[idx]);
+    }
+    else /* tree->type == ALC_POINTTYPE_DBL */
+    {
+      cmp = (key0.kD[idx] > key1.kD[idx]) - (key0.kD[idx] < key1.kD[idx]);
+    }
+  } while((cmp == 0) && ((idx = (idx + 1) % tree->dim) != split));
+  return(cmp);
+}
+
 #ifdef ALC_KDT_TEST
 int		main(int argc, char *argv[])
 {
@@ -536,6 +536,13 @@ extern AlcKDTTree	       *AlcKDTTreeNew(
 				  double tol,
 				  size_t nNodes,
 				  AlcErrno *dstErr);
+extern AlcKDTTree		*AlcKDTTreeBuild(
+				  AlcPointType type,
+				  int dim,
+				  double tol,
+				  size_t nKeys,
+				  void *keys,
+				  AlcErrno *dstErr);
 extern AlcErrno 	  	AlcKDTTreeFree(
 				    AlcKDTTree *tree);
 extern AlcKDTNode		*AlcKDTNodeNew(
@@ -569,6 +576,31 @@ extern AlcKDTNode	       *AlcKDTGetNN(
 				  double minDist,
 				  double *dstNNDist,
 				  AlcErrno *dstErr);
+extern size_t			AlcKDTGetKNN(
+				  AlcKDTTree *tree,
+				  void *keyVal,
+				  size_t k,
+				  double maxDist,
+				  AlcKDTNode **dstNod,
+				  double *dstDist,
+				  AlcErrno *dstErr);
+extern size_t			AlcKDTGetWithinRadius(
+				  AlcKDTTree *tree,
+				  void *keyVal,
+				  double radius,
+				  size_t maxNod,
+				  AlcKDTNode **dstNod,
+				  double *dstDist,
+				  AlcErrno *dstErr);
+extern AlcErrno			AlcKDTGetKNNBatch(
+				  AlcKDTTree *tree,
+				  size_t nKeys,
+				  void *keys,
+				  size_t k,
+				  double maxDist,
+				  AlcKDTNode **dstNod,
+				  double *dstDist,
+				  size_t *dstCnt);
 
 /************************************************************************
 * AlcLRUCache.c
@@ -647,6 +679,13 @@ extern AlcUFTree 		*AlcUFTreeNew(
 extern int			AlcUFTreeFind(
                                   AlcUFTree *uft,
                                   int p);
+extern int			AlcUFTreeConcFind(
+                                  AlcUFTree *uft,
+                                  int p);
+extern int			AlcUFTreeConcUnion(
+                                  AlcUFTree *uft,
+                                  int p,
+                                  int q);
 extern int			AlcUFTreeConnected(
                                   AlcUFTree *uft,
                                   int p,
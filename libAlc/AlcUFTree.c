@@ -40,6 +40,11 @@ static char _AlcUFTree_c[] = "University of Edinburgh $Id$";
 * 		Robert Sedgewick, Kevin Wayne "Algorithms (4th Edition)".
 * 		There is very little parameter checking in these functions
 * 		and all given parameters must be valid.
+* 		The concurrent functions AlcUFTreeConcFind() and
+* 		AlcUFTreeConcUnion() may be called by many threads at once
+* 		on the same tree. They link by node index rather than by
+* 		component size, so that the root of each component is
+* 		always it's lowest indexed node.
 * \ingroup	AlcUFTree
 */
 
@@ -47,6 +52,19 @@ static char _AlcUFTree_c[] = "University of Edinburgh $Id$";
 #include <stdlib.h>
 #include <Alc.h>
 
+/* The concurrent union find functions use atomic loads and compare and
+ * swap operations when the compiler supports them, otherwise they are
+ * serialised using the AlcUFTree OpenMP critical section. */
+#if defined(__GNUC__) || defined(__clang__)
+#define ALC_UFTREE_ATOMIC
+#define ALC_UFTREE_LOAD(P)	__atomic_load_n((P), __ATOMIC_RELAXED)
+#define ALC_UFTREE_CAS(P,O,N) \
+		__atomic_compare_exchange_n((P), (O), (N), 0, \
+		                            __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+#else
+#define ALC_UFTREE_LOAD(P)	(*(P))
+#endif
+
 /*!
 * \ingroup	AlcUFTree
 * \brief	Free a union find tree data structure.
@@ -192,6 +210,119 @@ void				AlcUFTreeUnion(
   }
 }
 
+/*!
+* \return	The component containing the given node.
+* \ingroup	AlcUFTree
+* \brief	Finds the component containing the given node. This
+* 		function may be called concurrently with itself and
+* 		AlcUFTreeConcUnion() and it halves the path from the node
+* 		to it's root as it goes.
+* \param	uft			The union find tree.
+* \param	p			Given node.
+*/
+int				AlcUFTreeConcFind(
+				  AlcUFTree *uft,
+				  int p)
+{
+  int		q,
+  		r,
+		s;
+
+  r = p;
+  while((q = ALC_UFTREE_LOAD(uft->pr + r)) != r)
+  {
+    s = ALC_UFTREE_LOAD(uft->pr + q);
+    if(s == q)
+    {
+      r = q;
+      break;
+    }
+#ifdef ALC_UFTREE_ATOMIC
+    /* Failure just means that some other thread has already moved this
+     * node closer to it's root. */
+    (void )ALC_UFTREE_CAS(uft->pr + r, &q, s);
+#endif
+    r = s;
+  }
+  return(r);
+}
+
+/*!
+* \return	Non-zero if the two components were merged.
+* \ingroup	AlcUFTree
+* \brief	Concurrent version of AlcUFTreeUnion(), which may be called
+* 		by many threads at once on the same tree. The root with the
+* 		greater index is always linked to that with the lesser
+* 		index, so the component sizes are not maintained. This
+* 		function should not be mixed with AlcUFTreeUnion() on the
+* 		same tree.
+* \param	uft			The union find tree.
+* \param	p			Node in first component.
+* \param	q			Node in second component.
+*/
+int				AlcUFTreeConcUnion(
+				  AlcUFTree *uft,
+				  int p,
+				  int q)
+{
+  int		merged = 0;
+
+#ifdef ALC_UFTREE_ATOMIC
+  for(;;)
+  {
+    int		rP,
+    		rQ;
+
+    rP = AlcUFTreeConcFind(uft, p);
+    rQ = AlcUFTreeConcFind(uft, q);
+    if(rP == rQ)
+    {
+      break;
+    }
+    if(rP < rQ)
+    {
+      int	t;
+
+      t = rP; rP = rQ; rQ = t;
+    }
+    /* Only succeeds if rP is still a root, otherwise try again. */
+    if(ALC_UFTREE_CAS(uft->pr + rP, &rP, rQ))
+    {
+      (void )__atomic_fetch_sub(&(uft->nCmp), 1, __ATOMIC_RELAXED);
+      merged = 1;
+      break;
+    }
+  }
+#else
+#ifdef _OPENMP
+#pragma omp critical (AlcUFTree)
+  {
+#endif
+    int		rP,
+    		rQ;
+
+    rP = AlcUFTreeConcFind(uft, p);
+    rQ = AlcUFTreeConcFind(uft, q);
+    if(rP != rQ)
+    {
+      if(rP < rQ)
+      {
+	uft->pr[rQ] = rP;
+      }
+      else
+      {
+	uft->pr[rP] = rQ;
+      }
+      --(uft->nCmp);
+      merged = 1;
+    }
+#ifdef _OPENMP
+  }
+#endif
+#endif
+  return(merged);
+}
+
 #ifdef ALC_UFTREE_MAIN
 int		main(int argc, char *argv[])
 {
@@ -0,0 +1,283 @@
+#pragma ident "MRC HGU $Id$"
+/***********************************************************************
+* Project:      Mouse Atlas
+* Title:        AlcKDTreeTest.c
+* Date:         October 2026
+* Author:       agent
+* Copyright:	2026 University of Edinburgh, UK.
+*		All rights reserved.
+* Address:	MRC Human Genetics Unit,
+*		Western General Hospital,
+*		Edinburgh, EH4 2XU, UK.
+* Purpose:      Test and benchmark program for AlcKDTree kD-trees.
+*		Compares trees built by incremental insertion with
+*		those built by AlcKDTTreeBuild(), checks nearest
+*		neighbour, k-nearest neighbour and radius queries
+*		against a brute force search and times single and
+*		batched queries.
+*		Usage: AlcKDTreeTest [<dim> [<n keys> [<n queries> [<k>]]]]
+* $Revision$
+* Maintenance:	Log changes below, with most recent at top of list.
+************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include <sys/time.h>
+#include <Alc.h>
+
+static double	AlcKDTreeTestTime(void);
+static double	AlcKDTreeTestDistSq(int dim, double *k0, double *k1);
+static int	AlcKDTreeTestCheck(AlcKDTTree *tree, int dim, size_t nKeys,
+				   double *keys, size_t nQry, double *qry,
+				   size_t k);
+
+int		main(int argc, char **argv)
+{
+  int		dim = 3,
+  		nBad = 0;
+  size_t	idx,
+  		nKeys = 200000,
+		nQry = 200000,
+		k = 8;
+  double	t0,
+  		t1,
+		sum;
+  double	*keys = NULL,
+  		*qry = NULL,
+		*dist = NULL;
+  AlcKDTNode	**nod = NULL;
+  AlcKDTTree	*insTree = NULL,
+  		*blkTree = NULL;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if(argc > 1)
+  {
+    dim = atoi(argv[1]);
+  }
+  if(argc > 2)
+  {
+    nKeys = atol(argv[2]);
+  }
+  if(argc > 3)
+  {
+    nQry = atol(argv[3]);
+  }
+  if(argc > 4)
+  {
+    k = atol(argv[4]);
+  }
+  if((dim < 1) || (nKeys < 1) || (k < 1))
+  {
+    (void )fprintf(stderr,
+    		   "Usage: %s [<dim> [<n keys> [<n queries> [<k>]]]]\n",
+		   *argv);
+    return(1);
+  }
+  if(((keys = (double *)AlcMalloc(sizeof(double) * dim * nKeys)) == NULL) ||
+     ((qry = (double *)AlcMalloc(sizeof(double) * dim * nQry)) == NULL) ||
+     ((dist = (double *)AlcMalloc(sizeof(double) * k * nQry)) == NULL) ||
+     ((nod = (AlcKDTNode **)
+             AlcMalloc(sizeof(AlcKDTNode *) * k * nQry)) == NULL))
+  {
+    errNum = ALC_ER_ALLOC;
+  }
+  if(errNum == ALC_ER_NONE)
+  {
+    srand48(0);
+    for(idx = 0; idx < dim * nKeys; ++idx)
+    {
+      keys[idx] = drand48();
+    }
+    for(idx = 0; idx < dim * nQry; ++idx)
+    {
+      qry[idx] = drand48();
+    }
+    (void )printf("dim %d, keys %lu, queries %lu, k %lu\n",
+		  dim, (unsigned long )nKeys, (unsigned long )nQry,
+		  (unsigned long )k);
+    /* Build a tree by incremental insertion. A zero tolerance is used
+     * so that, as in the bulk built tree and the brute force check,
+     * only identical keys are merged. */
+    t0 = AlcKDTreeTestTime();
+    insTree = AlcKDTTreeNew(ALC_POINTTYPE_DBL, dim, 0.0, nKeys, &errNum);
+    for(idx = 0; (errNum == ALC_ER_NONE) && (idx < nKeys); ++idx)
+    {
+      (void )AlcKDTInsert(insTree, keys + (dim * idx), NULL, &errNum);
+    }
+    t1 = AlcKDTreeTestTime();
+    (void )printf("insert build       %8.3fs\n", t1 - t0);
+  }
+  if(errNum == ALC_ER_NONE)
+  {
+    t0 = AlcKDTreeTestTime();
+    blkTree = AlcKDTTreeBuild(ALC_POINTTYPE_DBL, dim, 0.0, nKeys, keys,
+			      &errNum);
+    t1 = AlcKDTreeTestTime();
+    (void )printf("bulk build         %8.3fs\n", t1 - t0);
+  }
+  if(errNum == ALC_ER_NONE)
+  {
+    /* Single nearest neighbour queries. */
+    t0 = AlcKDTreeTestTime();
+    sum = 0.0;
+    for(idx = 0; idx < nQry; ++idx)
+    {
+      double	d;
+
+      if(AlcKDTGetNN(insTree, qry + (dim * idx), DBL_MAX, &d, NULL))
+      {
+	sum += d;
+      }
+    }
+    t1 = AlcKDTreeTestTime();
+    (void )printf("insert tree NN     %8.3fs (%g)\n", t1 - t0, sum);
+    t0 = AlcKDTreeTestTime();
+    sum = 0.0;
+    for(idx = 0; idx < nQry; ++idx)
+    {
+      double	d;
+
+      if(AlcKDTGetNN(blkTree, qry + (dim * idx), DBL_MAX, &d, NULL))
+      {
+	sum += d;
+      }
+    }
+    t1 = AlcKDTreeTestTime();
+    (void )printf("bulk tree NN       %8.3fs (%g)\n", t1 - t0, sum);
+    /* Batched k-nearest neighbour queries. */
+    t0 = AlcKDTreeTestTime();
+    errNum = AlcKDTGetKNNBatch(blkTree, nQry, qry, k, DBL_MAX,
+			       nod, dist, NULL);
+    t1 = AlcKDTreeTestTime();
+    sum = 0.0;
+    for(idx = 0; idx < nQry; ++idx)
+    {
+      sum += dist[idx * k];
+    }
+    (void )printf("bulk tree kNN batch %7.3fs (%g)\n", t1 - t0, sum);
+  }
+  if(errNum == ALC_ER_NONE)
+  {
+    /* Check queries against a brute force search for a few keys. */
+    idx = (nQry < 100)? nQry: 100;
+    nBad = AlcKDTreeTestCheck(insTree, dim, nKeys, keys, idx, qry, k) +
+           AlcKDTreeTestCheck(blkTree, dim, nKeys, keys, idx, qry, k);
+    (void )printf("check              %s\n", (nBad)? "FAILED": "passed");
+  }
+  if(errNum != ALC_ER_NONE)
+  {
+    (void )fprintf(stderr, "%s: error %d\n", *argv, (int )errNum);
+  }
+  (void )AlcKDTTreeFree(insTree);
+  (void )AlcKDTTreeFree(blkTree);
+  AlcFree(keys);
+  AlcFree(qry);
+  AlcFree(dist);
+  AlcFree(nod);
+  return((errNum != ALC_ER_NONE) || (nBad != 0));
+}
+
+static double	AlcKDTreeTestTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (1.0e-06 * tv.tv_usec));
+}
+
+static double	AlcKDTreeTestDistSq(int dim, double *k0, double *k1)
+{
+  int		idx;
+  double	d,
+  		dSq = 0.0;
+
+  for(idx = 0; idx < dim; ++idx)
+  {
+    d = k0[idx] - k1[idx];
+    dSq += d * d;
+  }
+  return(dSq);
+}
+
+/* Checks nearest neighbour, k-nearest neighbour and radius queries
+ * against a brute force search, returning the number of failures. */
+static int	AlcKDTreeTestCheck(AlcKDTTree *tree, int dim, size_t nKeys,
+				   double *keys, size_t nQry, double *qry,
+				   size_t k)
+{
+  int		nBad = 0;
+  size_t	idQ,
+  		idK,
+		idN,
+		n,
+		nIn;
+  double	d,
+  		r;
+  double	*bDSq,
+  		*dist;
+  AlcKDTNode	**nod;
+
+  bDSq = (double *)AlcMalloc(sizeof(double) * (k + 1));
+  dist = (double *)AlcMalloc(sizeof(double) * nKeys);
+  nod = (AlcKDTNode **)AlcMalloc(sizeof(AlcKDTNode *) * nKeys);
+  for(idQ = 0; idQ < nQry; ++idQ)
+  {
+    double	*q;
+
+    q = qry + (dim * idQ);
+    /* Brute force sorted k nearest squared distances. */
+    n = 0;
+    for(idK = 0; idK < nKeys; ++idK)
+    {
+      d = AlcKDTreeTestDistSq(dim, q, keys + (dim * idK));
+      if((n < k) || (d < bDSq[k - 1]))
+      {
+	idN = (n < k)? n++: k - 1;
+	while((idN > 0) && (bDSq[idN - 1] > d))
+	{
+	  bDSq[idN] = bDSq[idN - 1];
+	  --idN;
+	}
+	bDSq[idN] = d;
+      }
+    }
+    if((AlcKDTGetNN(tree, q, DBL_MAX, &d, NULL) == NULL) ||
+       (fabs(d - sqrt(bDSq[0])) > 1.0e-12))
+    {
+      ++nBad;
+    }
+    if(AlcKDTGetKNN(tree, q, k, DBL_MAX, nod, dist, NULL) != n)
+    {
+      ++nBad;
+    }
+    else
+    {
+      for(idN = 0; idN < n; ++idN)
+      {
+	if(fabs(dist[idN] - sqrt(bDSq[idN])) > 1.0e-12)
+	{
+	  ++nBad;
+	}
+      }
+    }
+    /* Radius query with the radius of the k'th nearest neighbour. */
+    r = sqrt(bDSq[n - 1]);
+    nIn = 0;
+    for(idK = 0; idK < nKeys; ++idK)
+    {
+      if(AlcKDTreeTestDistSq(dim, q, keys + (dim * idK)) <= r * r)
+      {
+	++nIn;
+      }
+    }
+    if(AlcKDTGetWithinRadius(tree, q, r, nKeys, nod, dist, NULL) != nIn)
+    {
+      ++nBad;
+    }
+  }
+  AlcFree(bDSq);
+  AlcFree(dist);
+  AlcFree(nod);
+  return(nBad);
+}
@@ -52,6 +52,10 @@ static char _AlgCrossCorr_c[] = "University of Edinburgh $Id$";
 * \brief	Cross correlates the given 2D double arrays leaving
 *		the result in the first of the two arrays.
 *		The cross correlation data are un-normalized.
+*		Power of two sizes are transformed using AlgFourReal2D()
+*		and other sizes using AlgFourAnyReal2D(), for which
+*		sizes which factor into 2, 3, 5 and 7 are fastest
+*		(see AlgFourGoodSize()).
 * \param	data0			Data for/with obj0's FFT 
 *					(source: AlcDouble2Malloc)
 *					which holds the cross	
@@ -66,8 +70,8 @@ static char _AlgCrossCorr_c[] = "University of Edinburgh $Id$";
 AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
 			            int nX, int nY)
 {
-  int		tI0,
-		tI1,
+  int		tI0 = 0,
+		tI1 = 0,
 		idX,
 		idY,
   		nX2,
@@ -91,12 +95,8 @@ AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
   {
     (void )AlgBitNextPowerOfTwo((unsigned int *)&tI0, nX);
     (void )AlgBitNextPowerOfTwo((unsigned int *)&tI1, nY);
-    if((tI0 != nX) || (tI1 != nY))
-    {
-      errNum = ALG_ERR_FUNC;
-    }
   }
-  if(errNum == ALG_ERR_NONE)
+  if((errNum == ALG_ERR_NONE) && (tI0 == nX) && (tI1 == nY))
   {
     AlgFourReal2D(data0, 1, nX, nY);
     AlgFourReal2D(data1, 1, nX, nY);
@@ -138,6 +138,64 @@ AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
     *(*(data0 + nY2) + nX2) *= *(*(data1 + nY2) + nX2);
     AlgFourRealInv2D(data0, 1, nX, nY);
   }
+  else if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourAnyReal2D(data0, nX, nY);
+    if(errNum == ALG_ERR_NONE)
+    {
+      errNum = AlgFourAnyReal2D(data1, nX, nY);
+    }
+    if(errNum == ALG_ERR_NONE)
+    {
+      int	idR,
+      		nRX;
+
+      /* As above but for both even and odd sizes: the columns 0 and
+       * (for even nX) nX / 2 are real columns packed along y, all other
+       * columns hold complex values with their imaginary parts nX / 2
+       * columns to the right. */
+      nX2 = nX / 2;
+      nY2 = nY / 2;
+      nRX = ((nX % 2) == 0)? 2: 1;
+      for(idY = 0; idY < nY; ++idY)
+      {
+	tDP1 = *(data0 + idY) + 1;
+	tDP2 = *(data1 + idY) + 1;
+	for(idX = 1; idX <= (nX - 1) / 2; ++idX)
+	{
+	  tD1 = *tDP1;
+	  tD2 = *(tDP1 + nX2);
+	  tD3 = *tDP2;
+	  tD4 = -*(tDP2 + nX2);
+	  *tDP1 = tD1 * tD3 - tD2 * tD4;
+	  *(tDP1 + nX2) = tD1 * tD4 + tD2 * tD3;
+	  ++tDP1;
+	  ++tDP2;
+	}
+      }
+      for(idR = 0; idR < nRX; ++idR)
+      {
+	idX = idR * nX2;
+	for(idY = 1; idY <= (nY - 1) / 2; ++idY)
+	{
+	  tDP1 = *(data0 + idY) + idX;
+	  tDP2 = *(data0 + nY2 + idY) + idX;
+	  tD1 = *tDP1;
+	  tD2 = *tDP2;
+	  tD3 = *(*(data1 + idY) + idX);
+	  tD4 = -*(*(data1 + nY2 + idY) + idX);
+	  *tDP1 = tD1 * tD3 - tD2 * tD4;
+	  *tDP2 = tD1 * tD4 + tD2 * tD3;
+	}
+	*(*data0 + idX) *= *(*data1 + idX);
+	if((nY % 2) == 0)
+	{
+	  *(*(data0 + nY2) + idX) *= *(*(data1 + nY2) + idX);
+	}
+      }
+      errNum = AlgFourAnyRealInv2D(data0, nX, nY);
+    }
+  }
   return(errNum);
 }
 
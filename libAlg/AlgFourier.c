@@ -74,6 +74,14 @@ static char _AlgFourier_c[] = "University of Edinburgh $Id$";
 *		data. Using buffers can result in an order of magnitude
 *		lower run times depending on whether the array fit into
 *		the fastest caches of the CPUs.
+*
+*		The AlgFourAny*() functions compute the same transforms
+*		with the same scaling as the functions above, but for
+*		arrays of any size. Sizes which factor into 2, 3, 5 and 7
+*		(see AlgFourGoodSize()) are fastest. They always use
+*		contiguous buffers and require the multi-dimensional
+*		arrays to be contiguous, as allocated by AlcDouble2Malloc()
+*		or AlcDouble3Malloc().
 * \ingroup      AlgFourier
 * \todo         -
 * \bug          None known.
@@ -140,6 +148,104 @@ static AlgError			AlgFourRepXYZReal1D(
 				  int numZ,
 				  AlgFourDir dir);
 
+/*!
+* \struct	_AlgFourPlan
+* \ingroup	AlgFourier
+* \brief	Precomputed factors and twiddle factors for the arbitrary
+* 		size complex transforms. Lengths which factor into 2, 3, 5
+* 		and 7 are transformed using self sorting mixed radix
+* 		(Stockham) passes. Other lengths use Bluestein's chirp-z
+* 		convolution with a mixed radix transform of a longer
+* 		length.
+*/
+typedef struct _AlgFourPlan
+{
+  int		num;		/*!< Transform length. */
+  int		nFac;		/*!< Number of radix factors. */
+  int		fac[32];	/*!< Radix factors. */
+  int		wSpSz;		/*!< Number of doubles of workspace needed
+  				     in addition to the data. */
+  double	*tw;		/*!< Twiddle factors
+  				     \f$e^{-2 \pi i k / n}\f$ as interleaved
+				     real and imaginary values. */
+  int		bNum;		/*!< Bluestein convolution length. */
+  double	*bChirp;	/*!< Bluestein chirp, length num. */
+  double	*bFChirp;	/*!< Scaled transform of the conjugate
+  				     chirp, length bNum. */
+  struct _AlgFourPlan *bPlan;	/*!< Plan for the convolution. */
+  struct _AlgFourPlan *next;	/*!< Next plan in the cache. */
+} AlgFourPlan;
+
+/*!
+* \struct	_AlgFourLine
+* \ingroup	AlgFourier
+* \brief	A line of a multi-dimensional array to be transformed.
+*/
+typedef struct _AlgFourLine
+{
+  int		real;		/*!< Non-zero if the line(s) are real, in
+  				     which case both are in the first array
+				     and the second may be absent. */
+  long		off0;		/*!< Offset to the first (real) line. */
+  long		off1;		/*!< Offset to the second (imaginary) line
+  				     or -1 if none. */
+} AlgFourLine;
+
+static void			AlgFourPlanFree(
+				  AlgFourPlan *plan);
+static void			AlgFourPlanExec(
+				  const AlgFourPlan *plan,
+				  double *x,
+				  double *w);
+static void			AlgFourPlanPass(
+				  const AlgFourPlan *plan,
+				  int nS,
+				  int rdx,
+				  const double *x,
+				  double *y);
+static void			AlgFourAnyCpx(
+				  const AlgFourPlan *plan,
+				  double *x,
+				  double *w,
+				  AlgFourDir dir);
+static void			AlgFourAnyRealPair(
+				  const AlgFourPlan *plan,
+				  double *x,
+				  double *w,
+				  AlgFourDir dir);
+static AlgError			AlgFourAnyLines(
+				  double *p0,
+				  double *p1,
+				  int nLn,
+				  AlgFourLine *ln,
+				  int num,
+				  long step,
+				  AlgFourDir dir);
+static AlgError			AlgFourAnyCpxAxis(
+				  double *real,
+				  double *imag,
+				  AlgFourAxis axis,
+				  int numX,
+				  int numY,
+				  int numZ,
+				  AlgFourDir dir);
+static AlgError			AlgFourAnyRealAxis(
+				  double *data,
+				  AlgFourAxis axis,
+				  int numX,
+				  int numY,
+				  int numZ,
+				  AlgFourDir dir);
+static AlgFourPlan		*AlgFourPlanMake(
+				  int num,
+				  AlgError *dstErr);
+static AlgFourPlan		*AlgFourPlanGet(
+				  int num,
+				  AlgError *dstErr);
+
+/* Cache of plans for the arbitrary size transforms. */
+static AlgFourPlan		*algFourPlanCache = NULL;
+
 /*!
 * \return	void
 * \ingroup      AlgFourier
@@ -1360,6 +1466,481 @@ AlgError	AlgFourRealInv3D(double ***real,
   return(errNum);
 }
 
+/*!
+* \return	Smallest integer not less than the given integer which
+*		has no prime factors other than 2, 3, 5 and 7.
+* \ingroup	AlgFourier
+* \brief	Finds a good size for the arbitrary size transforms,
+*		ie the smallest \f$2^a 3^b 5^c 7^d \geq n\f$. Padding
+*		data to a good size is usually far cheaper than padding
+*		to the next power of two.
+* \param	n			Given size.
+*/
+int		AlgFourGoodSize(int n)
+{
+  int		m,
+  		t;
+
+  m = (n < 1)? 1: n;
+  for(;;)
+  {
+    t = m;
+    while((t % 2) == 0)
+    {
+      t /= 2;
+    }
+    while((t % 3) == 0)
+    {
+      t /= 3;
+    }
+    while((t % 5) == 0)
+    {
+      t /= 5;
+    }
+    while((t % 7) == 0)
+    {
+      t /= 7;
+    }
+    if(t == 1)
+    {
+      break;
+    }
+    ++m;
+  }
+  return(m);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Frees all the cached plans of the arbitrary size
+*		transforms. This must not be called while any of the
+*		AlgFourAny*() functions are running.
+*/
+void		AlgFourPlanCacheFree(void)
+{
+  AlgFourPlan	*plan;
+
+#ifdef _OPENMP
+#pragma omp critical (AlgFourPlanCache)
+#endif
+  {
+    while((plan = algFourPlanCache) != NULL)
+    {
+      algFourPlanCache = plan->next;
+      AlgFourPlanFree(plan);
+    }
+  }
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional complex data of any length, and does it in
+*		place. The result is the same as given by AlgFour1D()
+*		for power of two lengths.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between the
+* 					data to be transformed.
+*/
+AlgError	AlgFourAny1D(double *real, double *imag, int num, int step)
+{
+  AlgError	errNum;
+  AlgFourLine	ln;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAny1D FE %p %p %d %d\n",
+	   real, imag, num, step));
+  ln.real = 0;
+  ln.off0 = ln.off1 = 0;
+  errNum = AlgFourAnyLines(real, imag, 1, &ln, num, step, ALG_FOUR_DIR_FWD);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAny1D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given one
+*		dimensional complex data of any length, and does it in
+*		place. The result is the same as given by AlgFourInv1D()
+*		for power of two lengths.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between the
+* 					data to be transformed.
+*/
+AlgError	AlgFourAnyInv1D(double *real, double *imag, int num, int step)
+{
+  AlgError	errNum;
+  AlgFourLine	ln;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyInv1D FE %p %p %d %d\n",
+	   real, imag, num, step));
+  ln.real = 0;
+  ln.off0 = ln.off1 = 0;
+  errNum = AlgFourAnyLines(real, imag, 1, &ln, num, step, ALG_FOUR_DIR_INV);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyInv1D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional real data of any length, and does it in
+*		place. With \f$m = \lfloor n / 2 \rfloor\f$ the
+*		transformed data are packed as the real parts of the
+*		\f$0 \ldots m\f$ coefficients followed by the imaginary
+*		parts of the \f$1 \ldots \lfloor (n - 1) / 2 \rfloor\f$
+*		coefficients, which for power of two lengths is the same
+*		as given by AlgFourReal1D().
+* \param	real			Given real data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between the
+* 					data to be transformed.
+*/
+AlgError	AlgFourAnyReal1D(double *real, int num, int step)
+{
+  AlgError	errNum;
+  AlgFourLine	ln;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyReal1D FE %p %d %d\n",
+	   real, num, step));
+  ln.real = 1;
+  ln.off0 = 0;
+  ln.off1 = -1;
+  errNum = AlgFourAnyLines(real, NULL, 1, &ln, num, step, ALG_FOUR_DIR_FWD);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyReal1D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given one
+*		dimensional data which resulted from a transform using
+*		AlgFourAnyReal1D(), and does it in place.
+* \param	real			Given real/complex data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between the
+* 					data to be transformed.
+*/
+AlgError	AlgFourAnyRealInv1D(double *real, int num, int step)
+{
+  AlgError	errNum;
+  AlgFourLine	ln;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyRealInv1D FE %p %d %d\n",
+	   real, num, step));
+  ln.real = 1;
+  ln.off0 = 0;
+  ln.off1 = -1;
+  errNum = AlgFourAnyLines(real, NULL, 1, &ln, num, step, ALG_FOUR_DIR_INV);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyRealInv1D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given two
+*		dimensional complex data of any size, and does it in
+*		place. The arrays must be contiguous.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+*/
+AlgError	AlgFourAny2D(double **real, double **imag,
+			     int numX, int numY)
+{
+  AlgError	errNum;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAny2D FE %p %p %d %d\n",
+	   real, imag, numX, numY));
+  errNum = AlgFourAnyCpxAxis(*real, *imag, ALG_FOUR_AXIS_X,
+  			     numX, numY, 1, ALG_FOUR_DIR_FWD);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourAnyCpxAxis(*real, *imag, ALG_FOUR_AXIS_Y,
+    			       numX, numY, 1, ALG_FOUR_DIR_FWD);
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAny2D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given two
+*		dimensional complex data of any size, and does it in
+*		place. The arrays must be contiguous.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+*/
+AlgError	AlgFourAnyInv2D(double **real, double **imag,
+			        int numX, int numY)
+{
+  AlgError	errNum;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyInv2D FE %p %p %d %d\n",
+	   real, imag, numX, numY));
+  errNum = AlgFourAnyCpxAxis(*real, *imag, ALG_FOUR_AXIS_Y,
+  			     numX, numY, 1, ALG_FOUR_DIR_INV);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourAnyCpxAxis(*real, *imag, ALG_FOUR_AXIS_X,
+    			       numX, numY, 1, ALG_FOUR_DIR_INV);
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyInv2D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given two
+*		dimensional real data of any size, and does it in
+*		place. The array must be contiguous.
+*		Each row is transformed as by AlgFourAnyReal1D(), then
+*		the columns \f$0\f$ and (for even \f$n_x\f$)
+*		\f$n_x / 2\f$ are transformed as real columns, while the
+*		remaining columns are transformed as complex columns with
+*		the real parts in column \f$k\f$ and the imaginary parts
+*		in column \f$\lfloor n_x / 2 \rfloor + k\f$. For even
+*		sizes the layout is the same as given by AlgFourReal2D().
+* \param	data			Given real data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+*/
+AlgError	AlgFourAnyReal2D(double **data, int numX, int numY)
+{
+  AlgError	errNum;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyReal2D FE %p %d %d\n",
+	   data, numX, numY));
+  errNum = AlgFourAnyRealAxis(*data, ALG_FOUR_AXIS_X,
+  			      numX, numY, 1, ALG_FOUR_DIR_FWD);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourAnyRealAxis(*data, ALG_FOUR_AXIS_Y,
+    				numX, numY, 1, ALG_FOUR_DIR_FWD);
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyReal2D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given two
+*		dimensional data which resulted from a transform using
+*		AlgFourAnyReal2D(), and does it in place.
+* \param	data			Given real/complex data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+*/
+AlgError	AlgFourAnyRealInv2D(double **data, int numX, int numY)
+{
+  AlgError	errNum;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyRealInv2D FE %p %d %d\n",
+	   data, numX, numY));
+  errNum = AlgFourAnyRealAxis(*data, ALG_FOUR_AXIS_Y,
+  			      numX, numY, 1, ALG_FOUR_DIR_INV);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourAnyRealAxis(*data, ALG_FOUR_AXIS_X,
+    				numX, numY, 1, ALG_FOUR_DIR_INV);
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyRealInv2D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given three
+*		dimensional complex data of any size, and does it in
+*		place. The arrays must be contiguous.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of data in each plane.
+*/
+AlgError	AlgFourAny3D(double ***real, double ***imag,
+			     int numX, int numY, int numZ)
+{
+  int		idA;
+  AlgError	errNum = ALG_ERR_NONE;
+  const AlgFourAxis axes[3] = {ALG_FOUR_AXIS_X, ALG_FOUR_AXIS_Y,
+  			       ALG_FOUR_AXIS_Z};
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAny3D FE %p %p %d %d %d\n",
+	   real, imag, numX, numY, numZ));
+  for(idA = 0; (errNum == ALG_ERR_NONE) && (idA < 3); ++idA)
+  {
+    errNum = AlgFourAnyCpxAxis(**real, **imag, axes[idA],
+			       numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAny3D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given three
+*		dimensional complex data of any size, and does it in
+*		place. The arrays must be contiguous.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of data in each plane.
+*/
+AlgError	AlgFourAnyInv3D(double ***real, double ***imag,
+			        int numX, int numY, int numZ)
+{
+  int		idA;
+  AlgError	errNum = ALG_ERR_NONE;
+  const AlgFourAxis axes[3] = {ALG_FOUR_AXIS_Z, ALG_FOUR_AXIS_Y,
+  			       ALG_FOUR_AXIS_X};
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyInv3D FE %p %p %d %d %d\n",
+	   real, imag, numX, numY, numZ));
+  for(idA = 0; (errNum == ALG_ERR_NONE) && (idA < 3); ++idA)
+  {
+    errNum = AlgFourAnyCpxAxis(**real, **imag, axes[idA],
+			       numX, numY, numZ, ALG_FOUR_DIR_INV);
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyInv3D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given three
+*		dimensional real data of any size, and does it in
+*		place. The array must be contiguous.
+*		Each plane is transformed as by AlgFourAnyReal2D(),
+*		then along the z axis the data of the real columns
+*		(see AlgFourAnyReal2D()) are transformed as real lines
+*		in rows \f$0\f$ and (for even \f$n_y\f$) \f$n_y / 2\f$
+*		and as complex lines (rows \f$k\f$ and
+*		\f$\lfloor n_y / 2 \rfloor + k\f$) otherwise, while the
+*		data of the complex columns are transformed as complex
+*		lines. This layout is not the same as that given by
+*		AlgFourReal3D().
+* \param	data			Given real data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of data in each plane.
+*/
+AlgError	AlgFourAnyReal3D(double ***data, int numX, int numY, int numZ)
+{
+  int		idA;
+  AlgError	errNum = ALG_ERR_NONE;
+  const AlgFourAxis axes[3] = {ALG_FOUR_AXIS_X, ALG_FOUR_AXIS_Y,
+  			       ALG_FOUR_AXIS_Z};
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyReal3D FE %p %d %d %d\n",
+	   data, numX, numY, numZ));
+  for(idA = 0; (errNum == ALG_ERR_NONE) && (idA < 3); ++idA)
+  {
+    errNum = AlgFourAnyRealAxis(**data, axes[idA],
+			        numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyReal3D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given three
+*		dimensional data which resulted from a transform using
+*		AlgFourAnyReal3D(), and does it in place.
+* \param	data			Given real/complex data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of data in each plane.
+*/
+AlgError	AlgFourAnyRealInv3D(double ***data,
+				    int numX, int numY, int numZ)
+{
+  int		idA;
+  AlgError	errNum = ALG_ERR_NONE;
+  const AlgFourAxis axes[3] = {ALG_FOUR_AXIS_Z, ALG_FOUR_AXIS_Y,
+  			       ALG_FOUR_AXIS_X};
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyRealInv3D FE %p %d %d %d\n",
+	   data, numX, numY, numZ));
+  for(idA = 0; (errNum == ALG_ERR_NONE) && (idA < 3); ++idA)
+  {
+    errNum = AlgFourAnyRealAxis(**data, axes[idA],
+			        numX, numY, numZ, ALG_FOUR_DIR_INV);
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourAnyRealInv3D FX %d\n",
+	   (int )errNum));
+  return(errNum);
+}
+
 /*!
 * \return	Error code, may be set if buffers can not be allocated.
 * \brief	Computes repeated Fourier transforms of a 1D complex
@@ -2274,3 +2855,929 @@ static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
   }
   return(errNum);
 }
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Frees a plan for the arbitrary size transforms.
+* \param	plan			Given plan, may be NULL.
+*/
+static void	AlgFourPlanFree(AlgFourPlan *plan)
+{
+  if(plan)
+  {
+    AlgFourPlanFree(plan->bPlan);
+    AlcFree(plan->tw);
+    AlcFree(plan->bChirp);
+    AlcFree(plan->bFChirp);
+    AlcFree(plan);
+  }
+}
+
+/*!
+* \return	New plan or NULL on error.
+* \ingroup	AlgFourier
+* \brief	Makes a new plan for the arbitrary size transforms of
+*		the given length. The plan is not cached.
+* \param	num			Transform length.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static AlgFourPlan *AlgFourPlanMake(int num, AlgError *dstErr)
+{
+  int		idN,
+  		rem;
+  AlgFourPlan	*plan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+  const int	radix[5] = {4, 2, 3, 5, 7};
+
+  if(num < 1)
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if(((plan = (AlgFourPlan *)AlcCalloc(1, sizeof(AlgFourPlan))) == NULL) ||
+          ((plan->tw = (double *)AlcMalloc(sizeof(double) * 2 * num)) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    int		idR;
+
+    plan->num = num;
+    for(idN = 0; idN < num; ++idN)
+    {
+      double	a;
+
+      a = (2.0 * ALG_M_PI * idN) / num;
+      plan->tw[2 * idN] = cos(a);
+      plan->tw[2 * idN + 1] = -sin(a);
+    }
+    rem = num;
+    for(idR = 0; idR < 5; ++idR)
+    {
+      while((rem % radix[idR]) == 0)
+      {
+        plan->fac[plan->nFac++] = radix[idR];
+	rem /= radix[idR];
+      }
+    }
+    plan->wSpSz = 2 * num;
+    if(rem > 1)
+    {
+      /* Length has a large prime factor so use Bluestein's algorithm with
+       * a chirp w_n = exp(-i pi n^2 / N), computing n^2 modulo 2N to
+       * avoid loss of precision. */
+      plan->nFac = 0;
+      plan->bNum = AlgFourGoodSize(2 * num - 1);
+      plan->wSpSz = 4 * plan->bNum;
+      if(((plan->bChirp = (double *)
+                          AlcMalloc(sizeof(double) * 2 * num)) == NULL) ||
+         ((plan->bFChirp = (double *)
+			   AlcCalloc(2 * plan->bNum, sizeof(double))) == NULL))
+      {
+        errNum = ALG_ERR_MALLOC;
+      }
+      else
+      {
+        plan->bPlan = AlgFourPlanMake(plan->bNum, &errNum);
+      }
+      if(errNum == ALG_ERR_NONE)
+      {
+        double	s;
+	double	*b,
+		*w;
+
+	if((w = (double *)AlcMalloc(sizeof(double) *
+				    plan->bPlan->wSpSz)) == NULL)
+	{
+	  errNum = ALG_ERR_MALLOC;
+	}
+	else
+	{
+	  b = plan->bFChirp;
+	  for(idN = 0; idN < num; ++idN)
+	  {
+	    double	a;
+	    long long	m;
+
+	    m = ((long long )idN * idN) % (2 * (long long )num);
+	    a = (ALG_M_PI * m) / num;
+	    plan->bChirp[2 * idN] = cos(a);
+	    plan->bChirp[2 * idN + 1] = -sin(a);
+	    b[2 * idN] = plan->bChirp[2 * idN];
+	    b[2 * idN + 1] = -plan->bChirp[2 * idN + 1];
+	    if(idN > 0)
+	    {
+	      b[2 * (plan->bNum - idN)] = b[2 * idN];
+	      b[2 * (plan->bNum - idN) + 1] = b[2 * idN + 1];
+	    }
+	  }
+	  AlgFourPlanExec(plan->bPlan, b, w);
+	  s = 1.0 / plan->bNum;
+	  for(idN = 0; idN < 2 * plan->bNum; ++idN)
+	  {
+	    b[idN] *= s;
+	  }
+	  AlcFree(w);
+	}
+      }
+    }
+  }
+  if(errNum != ALG_ERR_NONE)
+  {
+    AlgFourPlanFree(plan);
+    plan = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(plan);
+}
+
+/*!
+* \return	Cached plan or NULL on error.
+* \ingroup	AlgFourier
+* \brief	Gets a plan for the arbitrary size transforms of the
+*		given length from the cache, making and caching a new
+*		plan if required.
+* \param	num			Transform length.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static AlgFourPlan *AlgFourPlanGet(int num, AlgError *dstErr)
+{
+  AlgFourPlan	*plan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp critical (AlgFourPlanCache)
+#endif
+  {
+    plan = algFourPlanCache;
+    while(plan && (plan->num != num))
+    {
+      plan = plan->next;
+    }
+  }
+  if(plan == NULL)
+  {
+    AlgFourPlan	*newPlan;
+
+    /* Plans are made outside of the critical section, so another thread
+     * may have cached a plan of the same length in the meantime. */
+    if((newPlan = AlgFourPlanMake(num, &errNum)) != NULL)
+    {
+#ifdef _OPENMP
+#pragma omp critical (AlgFourPlanCache)
+#endif
+      {
+	plan = algFourPlanCache;
+	while(plan && (plan->num != num))
+	{
+	  plan = plan->next;
+	}
+	if(plan == NULL)
+	{
+	  plan = newPlan;
+	  plan->next = algFourPlanCache;
+	  algFourPlanCache = plan;
+	  newPlan = NULL;
+	}
+      }
+      AlgFourPlanFree(newPlan);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(plan);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Computes a single radix pass of a self sorting (Stockham)
+*		forward transform.
+* \param	plan			Plan for the transform.
+* \param	nS			Product of the radices of the
+*					previous passes.
+* \param	rdx			Radix of this pass.
+* \param	x			Source interleaved complex data.
+* \param	y			Destination interleaved complex data.
+*/
+static void	AlgFourPlanPass(const AlgFourPlan *plan, int nS, int rdx,
+				const double *x, double *y)
+{
+  int		idJ,
+		m,
+		oS,
+		twS;
+  const double	*tw;
+  const double	c3 = -0.5,
+		s3 = 0.86602540378443864676,
+		c51 = 0.30901699437494742410,
+		c52 = -0.80901699437494742410,
+		s51 = 0.95105651629515357212,
+		s52 = 0.58778525229247312917;
+
+  tw = plan->tw;
+  m = plan->num / rdx;
+  twS = plan->num / (nS * rdx);
+  oS = 2 * nS;			      /* Offset between outputs in doubles. */
+  for(idJ = 0; idJ < m; ++idJ)
+  {
+    int		idR,
+		k,
+		o;
+    double	v[16];
+
+    k = idJ % nS;
+    for(idR = 0; idR < rdx; ++idR)
+    {
+      int	i;
+      double	re,
+      		im;
+
+      i = 2 * (idJ + idR * m);
+      re = x[i];
+      im = x[i + 1];
+      if((k > 0) && (idR > 0))
+      {
+        int	t;
+
+	t = 2 * k * idR * twS;
+	v[2 * idR] = re * tw[t] - im * tw[t + 1];
+	v[2 * idR + 1] = re * tw[t + 1] + im * tw[t];
+      }
+      else
+      {
+        v[2 * idR] = re;
+	v[2 * idR + 1] = im;
+      }
+    }
+    o = 2 * (((idJ / nS) * nS * rdx) + k);
+    switch(rdx)
+    {
+      case 2:
+	y[o] = v[0] + v[2];
+	y[o + 1] = v[1] + v[3];
+	y[o + oS] = v[0] - v[2];
+	y[o + oS + 1] = v[1] - v[3];
+	break;
+      case 3:
+	{
+	  double t1r, t1i, t2r, t2i, mr, mi;
+
+	  t1r = v[2] + v[4];
+	  t1i = v[3] + v[5];
+	  t2r = s3 * (v[2] - v[4]);
+	  t2i = s3 * (v[3] - v[5]);
+	  mr = v[0] + c3 * t1r;
+	  mi = v[1] + c3 * t1i;
+	  y[o] = v[0] + t1r;
+	  y[o + 1] = v[1] + t1i;
+	  y[o + oS] = mr + t2i;
+	  y[o + oS + 1] = mi - t2r;
+	  y[o + 2 * oS] = mr - t2i;
+	  y[o + 2 * oS + 1] = mi + t2r;
+	}
+	break;
+      case 4:
+	{
+	  double t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i;
+
+	  t0r = v[0] + v[4];
+	  t0i = v[1] + v[5];
+	  t1r = v[0] - v[4];
+	  t1i = v[1] - v[5];
+	  t2r = v[2] + v[6];
+	  t2i = v[3] + v[7];
+	  t3r = v[3] - v[7];			     /* -i (v_1 - v_3) */
+	  t3i = v[6] - v[2];
+	  y[o] = t0r + t2r;
+	  y[o + 1] = t0i + t2i;
+	  y[o + oS] = t1r + t3r;
+	  y[o + oS + 1] = t1i + t3i;
+	  y[o + 2 * oS] = t0r - t2r;
+	  y[o + 2 * oS + 1] = t0i - t2i;
+	  y[o + 3 * oS] = t1r - t3r;
+	  y[o + 3 * oS + 1] = t1i - t3i;
+	}
+	break;
+      case 5:
+	{
+	  double t1r, t1i, t2r, t2i, t3r, t3i, t4r, t4i,
+	  	 a1r, a1i, a2r, a2i, b1r, b1i, b2r, b2i;
+
+	  t1r = v[2] + v[8];
+	  t1i = v[3] + v[9];
+	  t2r = v[4] + v[6];
+	  t2i = v[5] + v[7];
+	  t3r = v[2] - v[8];
+	  t3i = v[3] - v[9];
+	  t4r = v[4] - v[6];
+	  t4i = v[5] - v[7];
+	  a1r = v[0] + c51 * t1r + c52 * t2r;
+	  a1i = v[1] + c51 * t1i + c52 * t2i;
+	  a2r = v[0] + c52 * t1r + c51 * t2r;
+	  a2i = v[1] + c52 * t1i + c51 * t2i;
+	  b1r = s51 * t3r + s52 * t4r;
+	  b1i = s51 * t3i + s52 * t4i;
+	  b2r = s52 * t3r - s51 * t4r;
+	  b2i = s52 * t3i - s51 * t4i;
+	  y[o] = v[0] + t1r + t2r;
+	  y[o + 1] = v[1] + t1i + t2i;
+	  y[o + oS] = a1r + b1i;
+	  y[o + oS + 1] = a1i - b1r;
+	  y[o + 2 * oS] = a2r + b2i;
+	  y[o + 2 * oS + 1] = a2i - b2r;
+	  y[o + 3 * oS] = a2r - b2i;
+	  y[o + 3 * oS + 1] = a2i + b2r;
+	  y[o + 4 * oS] = a1r - b1i;
+	  y[o + 4 * oS + 1] = a1i + b1r;
+	}
+	break;
+      default:
+	{
+	  int	idQ,
+	  	twR;
+
+	  /* Direct DFT using the twiddle factors of the full length. */
+	  twR = plan->num / rdx;
+	  for(idQ = 0; idQ < rdx; ++idQ)
+	  {
+	    double sr = 0.0,
+	    	   si = 0.0;
+
+	    for(idR = 0; idR < rdx; ++idR)
+	    {
+	      int	t;
+
+	      t = 2 * ((idQ * idR) % rdx) * twR;
+	      sr += v[2 * idR] * tw[t] - v[2 * idR + 1] * tw[t + 1];
+	      si += v[2 * idR] * tw[t + 1] + v[2 * idR + 1] * tw[t];
+	    }
+	    y[o + idQ * oS] = sr;
+	    y[o + idQ * oS + 1] = si;
+	  }
+	}
+	break;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Computes the unscaled forward transform of the given
+*		interleaved complex data in place.
+* \param	plan			Plan for the transform.
+* \param	x			Interleaved complex data.
+* \param	w			Workspace of plan->wSpSz doubles.
+*/
+static void	AlgFourPlanExec(const AlgFourPlan *plan, double *x, double *w)
+{
+  int		idN;
+
+  if(plan->bNum > 0)
+  {
+    int		bNum;
+    double	*a,
+    		*c,
+		*f;
+
+    bNum = plan->bNum;
+    a = w;
+    c = plan->bChirp;
+    f = plan->bFChirp;
+    for(idN = 0; idN < plan->num; ++idN)
+    {
+      a[2 * idN] = x[2 * idN] * c[2 * idN] - x[2 * idN + 1] * c[2 * idN + 1];
+      a[2 * idN + 1] = x[2 * idN] * c[2 * idN + 1] +
+		       x[2 * idN + 1] * c[2 * idN];
+    }
+    for(idN = 2 * plan->num; idN < 2 * bNum; ++idN)
+    {
+      a[idN] = 0.0;
+    }
+    AlgFourPlanExec(plan->bPlan, a, w + 2 * bNum);
+    /* Multiply by the transformed chirp and conjugate, so that the
+     * inverse transform may be computed as a forward transform. */
+    for(idN = 0; idN < bNum; ++idN)
+    {
+      double	re,
+      		im;
+
+      re = a[2 * idN] * f[2 * idN] - a[2 * idN + 1] * f[2 * idN + 1];
+      im = a[2 * idN] * f[2 * idN + 1] + a[2 * idN + 1] * f[2 * idN];
+      a[2 * idN] = re;
+      a[2 * idN + 1] = -im;
+    }
+    AlgFourPlanExec(plan->bPlan, a, w + 2 * bNum);
+    for(idN = 0; idN < plan->num; ++idN)
+    {
+      double	re,
+      		im;
+
+      re = a[2 * idN];
+      im = -a[2 * idN + 1];
+      x[2 * idN] = re * c[2 * idN] - im * c[2 * idN + 1];
+      x[2 * idN + 1] = re * c[2 * idN + 1] + im * c[2 * idN];
+    }
+  }
+  else
+  {
+    int		idF,
+    		nS = 1;
+    double	*s,
+    		*d,
+		*t;
+
+    s = x;
+    d = w;
+    for(idF = 0; idF < plan->nFac; ++idF)
+    {
+      AlgFourPlanPass(plan, nS, plan->fac[idF], s, d);
+      nS *= plan->fac[idF];
+      t = s;
+      s = d;
+      d = t;
+    }
+    if(s != x)
+    {
+      for(idN = 0; idN < 2 * plan->num; ++idN)
+      {
+        x[idN] = s[idN];
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Computes the unscaled forward or inverse transform of
+*		the given interleaved complex data in place.
+* \param	plan			Plan for the transform.
+* \param	x			Interleaved complex data.
+* \param	w			Workspace of plan->wSpSz doubles.
+* \param	dir			Forward or inverse transform.
+*/
+static void	AlgFourAnyCpx(const AlgFourPlan *plan, double *x, double *w,
+			      AlgFourDir dir)
+{
+  int		idN;
+
+  if(dir == ALG_FOUR_DIR_FWD)
+  {
+    AlgFourPlanExec(plan, x, w);
+  }
+  else
+  {
+    for(idN = 1; idN < 2 * plan->num; idN += 2)
+    {
+      x[idN] = -x[idN];
+    }
+    AlgFourPlanExec(plan, x, w);
+    for(idN = 1; idN < 2 * plan->num; idN += 2)
+    {
+      x[idN] = -x[idN];
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Transforms a pair of real lines using a single complex
+*		transform. For the forward transform the lines are given
+*		as the real and imaginary parts of interleaved complex
+*		data and are returned as the two packed transforms
+*		(see AlgFourAnyReal1D()) one after the other. The
+*		inverse transform reverses this.
+* \param	plan			Plan for the transform.
+* \param	x			Data of 2n doubles.
+* \param	w			Workspace of plan->wSpSz doubles.
+* \param	dir			Forward or inverse transform.
+*/
+static void	AlgFourAnyRealPair(const AlgFourPlan *plan,
+				   double *x, double *w, AlgFourDir dir)
+{
+  int		idK,
+  		num,
+		hN,
+		hI;
+  double	*a,
+  		*b;
+
+  num = plan->num;
+  hN = num / 2;
+  hI = (num - 1) / 2;
+  a = x;
+  b = x + num;
+  if(dir == ALG_FOUR_DIR_FWD)
+  {
+    AlgFourPlanExec(plan, x, w);
+    /* With Z = A + iB then A_k = (Z_k + Z*_{n-k}) / 2 and
+     * B_k = (Z_k - Z*_{n-k}) / 2i. */
+    for(idK = 0; idK <= hN; ++idK)
+    {
+      int	j;
+      double	zr,
+      		zi,
+		yr,
+		yi;
+
+      j = (num - idK) % num;
+      zr = x[2 * idK];
+      zi = x[2 * idK + 1];
+      yr = x[2 * j];
+      yi = x[2 * j + 1];
+      w[idK] = 0.5 * (zr + yr);
+      w[num + idK] = 0.5 * (zi + yi);
+      if((idK > 0) && (idK <= hI))
+      {
+	w[hN + idK] = 0.5 * (zi - yi);
+	w[num + hN + idK] = 0.5 * (yr - zr);
+      }
+    }
+    for(idK = 0; idK < 2 * num; ++idK)
+    {
+      x[idK] = w[idK];
+    }
+  }
+  else
+  {
+    for(idK = 0; idK < num; ++idK)
+    {
+      int	j;
+      double	ar,
+      		ai,
+		br,
+		bi;
+
+      j = (idK <= hN)? idK: num - idK;
+      ar = a[j];
+      br = b[j];
+      ai = bi = 0.0;
+      if((j > 0) && (j <= hI))
+      {
+        ai = a[hN + j];
+	bi = b[hN + j];
+	if(j != idK)
+	{
+	  ai = -ai;
+	  bi = -bi;
+	}
+      }
+      w[2 * idK] = ar - bi;
+      w[2 * idK + 1] = ai + br;
+    }
+    for(idK = 0; idK < 2 * num; ++idK)
+    {
+      x[idK] = w[idK];
+    }
+    AlgFourAnyCpx(plan, x, w, ALG_FOUR_DIR_INV);
+  }
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the forward or inverse transforms of the given
+*		lines in parallel. Real lines (which may be paired) are
+*		offsets into the first array. Complex lines have their
+*		real parts at the first offset into the first array and
+*		their imaginary parts at the second offset into the
+*		second array.
+* \param	p0			First array.
+* \param	p1			Second array, if NULL the first
+*					array is used.
+* \param	nLn			Number of lines.
+* \param	ln			The lines.
+* \param	num			Number of data in each line.
+* \param	step			Offset between the data of each line.
+* \param	dir			Forward or inverse transform.
+*/
+static AlgError	AlgFourAnyLines(double *p0, double *p1, int nLn,
+				AlgFourLine *ln, int num, long step,
+				AlgFourDir dir)
+{
+  int		idL,
+		nThr = 1,
+  		bufSz;
+  double	*bufBase = NULL;
+  AlgFourPlan	*plan;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if(p1 == NULL)
+  {
+    p1 = p0;
+  }
+  plan = AlgFourPlanGet(num, &errNum);
+  if(errNum == ALG_ERR_NONE)
+  {
+#ifdef _OPENMP
+    if(nLn > 1)
+    {
+#pragma omp parallel
+      {
+#pragma omp master
+	{
+	  nThr = omp_get_num_threads();
+	}
+      }
+    }
+#endif
+    bufSz = 2 * num + plan->wSpSz;
+    if((bufBase = (double *)AlcMalloc(sizeof(double) * bufSz * nThr)) == NULL)
+    {
+      errNum = ALG_ERR_MALLOC;
+    }
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) if(nLn > 1)
+#endif
+    for(idL = 0; idL < nLn; ++idL)
+    {
+      int	idN,
+      		thrId = 0;
+      double	*x,
+      		*w,
+		*d0,
+		*d1;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      x = bufBase + (long )bufSz * thrId;
+      w = x + 2 * num;
+      d0 = p0 + ln[idL].off0;
+      d1 = (ln[idL].off1 < 0)? NULL:
+           ((ln[idL].real)? p0: p1) + ln[idL].off1;
+      if(ln[idL].real == 0)
+      {
+	for(idN = 0; idN < num; ++idN)
+	{
+	  x[2 * idN] = d0[idN * step];
+	  x[2 * idN + 1] = d1[idN * step];
+	}
+	AlgFourAnyCpx(plan, x, w, dir);
+	for(idN = 0; idN < num; ++idN)
+	{
+	  d0[idN * step] = x[2 * idN];
+	  d1[idN * step] = x[2 * idN + 1];
+	}
+      }
+      else if(dir == ALG_FOUR_DIR_FWD)
+      {
+	for(idN = 0; idN < num; ++idN)
+	{
+	  x[2 * idN] = d0[idN * step];
+	  x[2 * idN + 1] = (d1)? d1[idN * step]: 0.0;
+	}
+	AlgFourAnyRealPair(plan, x, w, dir);
+	for(idN = 0; idN < num; ++idN)
+	{
+	  d0[idN * step] = x[idN];
+	}
+	if(d1)
+	{
+	  for(idN = 0; idN < num; ++idN)
+	  {
+	    d1[idN * step] = x[num + idN];
+	  }
+	}
+      }
+      else
+      {
+	for(idN = 0; idN < num; ++idN)
+	{
+	  x[idN] = d0[idN * step];
+	  x[num + idN] = (d1)? d1[idN * step]: 0.0;
+	}
+	AlgFourAnyRealPair(plan, x, w, dir);
+	for(idN = 0; idN < num; ++idN)
+	{
+	  d0[idN * step] = x[2 * idN];
+	}
+	if(d1)
+	{
+	  for(idN = 0; idN < num; ++idN)
+	  {
+	    d1[idN * step] = x[2 * idN + 1];
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(bufBase);
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the forward or inverse transforms along an
+*		axis of contiguous complex data.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	axis			Axis of the transforms.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of data in each plane.
+* \param	dir			Forward or inverse transform.
+*/
+static AlgError	AlgFourAnyCpxAxis(double *real, double *imag,
+				  AlgFourAxis axis,
+				  int numX, int numY, int numZ,
+				  AlgFourDir dir)
+{
+  int		idL,
+  		num,
+		nLn;
+  long		step;
+  AlgFourLine	*ln = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  switch(axis)
+  {
+    case ALG_FOUR_AXIS_X:
+      num = numX;
+      step = 1;
+      break;
+    case ALG_FOUR_AXIS_Y:
+      num = numY;
+      step = numX;
+      break;
+    default:
+      num = numZ;
+      step = (long )numX * numY;
+      break;
+  }
+  nLn = (int )(((long )numX * numY * numZ) / num);
+  if((ln = (AlgFourLine *)AlcMalloc(sizeof(AlgFourLine) * nLn)) == NULL)
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    for(idL = 0; idL < nLn; ++idL)
+    {
+      ln[idL].real = 0;
+      switch(axis)
+      {
+	case ALG_FOUR_AXIS_X:
+	  ln[idL].off0 = (long )idL * numX;
+	  break;
+	case ALG_FOUR_AXIS_Y:
+	  ln[idL].off0 = (idL % numX) + ((long )(idL / numX) * numX * numY);
+	  break;
+	default:
+	  ln[idL].off0 = idL;
+	  break;
+      }
+      ln[idL].off1 = ln[idL].off0;
+    }
+    errNum = AlgFourAnyLines(real, imag, nLn, ln, num, step, dir);
+  }
+  AlcFree(ln);
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if a plan or buffers can not
+*		be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the forward or inverse transforms along an
+*		axis of contiguous real data, using the layout described
+*		for AlgFourAnyReal2D() and AlgFourAnyReal3D().
+* \param	data			Given data.
+* \param	axis			Axis of the transforms.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of data in each plane.
+* \param	dir			Forward or inverse transform.
+*/
+static AlgError	AlgFourAnyRealAxis(double *data, AlgFourAxis axis,
+				   int numX, int numY, int numZ,
+				   AlgFourDir dir)
+{
+  int		idX,
+  		idY,
+		idZ,
+		num,
+		nLn = 0,
+		nRX,
+		hX,
+		hY;
+  long		step,
+  		nXY;
+  AlgFourLine	*ln = NULL,
+  		*l;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  hX = numX / 2;
+  hY = numY / 2;
+  nRX = ((numX % 2) == 0)? 2: 1;
+  nXY = (long )numX * numY;
+  switch(axis)
+  {
+    case ALG_FOUR_AXIS_X:
+      num = numX;
+      step = 1;
+      nLn = (numY * numZ + 1) / 2;
+      break;
+    case ALG_FOUR_AXIS_Y:
+      num = numY;
+      step = numX;
+      nLn = (1 + ((numX - 1) / 2)) * numZ;
+      break;
+    default:
+      num = numZ;
+      step = nXY;
+      nLn = (nRX * (1 + ((numY - 1) / 2))) + (((numX - 1) / 2) * numY);
+      break;
+  }
+  if((ln = (AlgFourLine *)AlcMalloc(sizeof(AlgFourLine) * nLn)) == NULL)
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    l = ln;
+    switch(axis)
+    {
+      case ALG_FOUR_AXIS_X:
+	/* Pairs of rows. */
+	for(idY = 0; idY < nLn; ++idY)
+	{
+	  l->real = 1;
+	  l->off0 = (long )(2 * idY) * numX;
+	  l->off1 = ((2 * idY + 1) < (numY * numZ))? l->off0 + numX: -1;
+	  ++l;
+	}
+	break;
+      case ALG_FOUR_AXIS_Y:
+	/* In each plane the real columns as a pair then the complex
+	 * columns. */
+	for(idZ = 0; idZ < numZ; ++idZ)
+	{
+	  long	off;
+
+	  off = idZ * nXY;
+	  l->real = 1;
+	  l->off0 = off;
+	  l->off1 = (nRX > 1)? off + hX: -1;
+	  ++l;
+	  for(idX = 1; idX <= (numX - 1) / 2; ++idX)
+	  {
+	    l->real = 0;
+	    l->off0 = off + idX;
+	    l->off1 = off + hX + idX;
+	    ++l;
+	  }
+	}
+	break;
+      default:
+	/* For each real column the real rows as a pair then the complex
+	 * rows, followed by every row of the complex columns. */
+	for(idX = 0; idX < nRX; ++idX)
+	{
+	  long	off;
+
+	  off = idX * hX;
+	  l->real = 1;
+	  l->off0 = off;
+	  l->off1 = ((numY % 2) == 0)? off + (long )hY * numX: -1;
+	  ++l;
+	  for(idY = 1; idY <= (numY - 1) / 2; ++idY)
+	  {
+	    l->real = 0;
+	    l->off0 = off + (long )idY * numX;
+	    l->off1 = off + (long )(hY + idY) * numX;
+	    ++l;
+	  }
+	}
+	for(idX = 1; idX <= (numX - 1) / 2; ++idX)
+	{
+	  for(idY = 0; idY < numY; ++idY)
+	  {
+	    l->real = 0;
+	    l->off0 = idX + (long )idY * numX;
+	    l->off1 = l->off0 + hX;
+	    ++l;
+	  }
+	}
+	break;
+    }
+    errNum = AlgFourAnyLines(data, NULL, nLn, ln, num, step, dir);
+  }
+  AlcFree(ln);
+  return(errNum);
+}
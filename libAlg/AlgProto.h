@@ -314,6 +314,67 @@ extern AlgError        		AlgFourRealInv3D(
 				  int numX,
 				  int numY,
 				  int numZ);
+extern int			AlgFourGoodSize(
+				  int n);
+extern void			AlgFourPlanCacheFree(void);
+extern AlgError			AlgFourAny1D(
+				  double *real,
+				  double *imag,
+				  int num,
+				  int step);
+extern AlgError			AlgFourAnyInv1D(
+				  double *real,
+				  double *imag,
+				  int num,
+				  int step);
+extern AlgError			AlgFourAnyReal1D(
+				  double *real,
+				  int num,
+				  int step);
+extern AlgError			AlgFourAnyRealInv1D(
+				  double *real,
+				  int num,
+				  int step);
+extern AlgError			AlgFourAny2D(
+				  double **real,
+				  double **imag,
+				  int numX,
+				  int numY);
+extern AlgError			AlgFourAnyInv2D(
+				  double **real,
+				  double **imag,
+				  int numX,
+				  int numY);
+extern AlgError			AlgFourAnyReal2D(
+				  double **data,
+				  int numX,
+				  int numY);
+extern AlgError			AlgFourAnyRealInv2D(
+				  double **data,
+				  int numX,
+				  int numY);
+extern AlgError			AlgFourAny3D(
+				  double ***real,
+				  double ***imag,
+				  int numX,
+				  int numY,
+				  int numZ);
+extern AlgError			AlgFourAnyInv3D(
+				  double ***real,
+				  double ***imag,
+				  int numX,
+				  int numY,
+				  int numZ);
+extern AlgError			AlgFourAnyReal3D(
+				  double ***data,
+				  int numX,
+				  int numY,
+				  int numZ);
+extern AlgError			AlgFourAnyRealInv3D(
+				  double ***data,
+				  int numX,
+				  int numY,
+				  int numZ);
 
 /* From AlgGamma.c */
 extern double			AlgGammaLog(
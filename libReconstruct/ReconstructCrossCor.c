@@ -48,6 +48,7 @@ static char _ReconstructCrossCor_c[] = "University of Edinburgh $Id$";
 static RecError	RecCCorObjToFour(double **data, double *sSq, WlzObject *obj,
 				 WlzIVertex2 org, WlzIVertex2 size,
 				 RecPPControl *ppCtrl);
+static RecError	RecCCorFour(double **data, WlzIVertex2 size, int inverse);
 
 /*!
 * \return	Error code.
@@ -89,8 +90,7 @@ RecError	RecCrossCorrelate(double **data0, double **data1,
   int		idX,
 		idY;
   RecError	errFlag = REC_ERR_NONE;
-  WlzIVertex2	tC2I,
-		p2Size;
+  WlzIVertex2	tC2I;
   double	tD1,
 		tD2,
 		tD3,
@@ -111,12 +111,8 @@ RecError	RecCrossCorrelate(double **data0, double **data1,
   }
   if(errFlag == REC_ERR_NONE)
   {
-    p2Size = RecPowerOfTwoC2I(&tC2I, size);
-    if((tC2I.vtX != size.vtX) || (tC2I.vtY != size.vtY) ||
-       (p2Size.vtX < REC_FOUR_DIMP2_MIN) ||
-       (p2Size.vtY < REC_FOUR_DIMP2_MIN) ||
-       (p2Size.vtX > REC_FOUR_DIMP2_MAX) ||
-       (p2Size.vtY > REC_FOUR_DIMP2_MAX))
+    if((size.vtX < REC_FOUR_DIM_MIN) || (size.vtY < REC_FOUR_DIM_MIN) ||
+       (size.vtX > REC_FOUR_DIM_MAX) || (size.vtY > REC_FOUR_DIM_MAX))
     {
       errFlag = REC_ERR_FUNC;
     }
@@ -131,13 +127,16 @@ RecError	RecCrossCorrelate(double **data0, double **data1,
   }
   if(errFlag == REC_ERR_NONE)
   {
+    /* Columns 0 and (for even sizes) size.vtX / 2 hold real columns
+     * packed along y, all other columns hold complex values with their
+     * imaginary parts size.vtX / 2 columns to the right. */
     tC2I.vtX = size.vtX / 2;
     tC2I.vtY = size.vtY / 2;
     for(idY = 0; idY < size.vtY; ++idY)
     {
       tDP1 = *(data0 + idY) + 1;
       tDP2 = *(data1 + idY) + 1;
-      for(idX = 1; idX < tC2I.vtX; ++idX)
+      for(idX = 1; idX <= (size.vtX - 1) / 2; ++idX)
       {
 	tD1 = *tDP1;
 	tD2 = *(tDP1 + tC2I.vtX);
@@ -151,7 +150,7 @@ RecError	RecCrossCorrelate(double **data0, double **data1,
     }
     for(idX = 0; idX < size.vtX; idX += tC2I.vtX)
     {
-      for(idY = 1; idY < tC2I.vtY; ++idY)
+      for(idY = 1; idY <= (size.vtY - 1) / 2; ++idY)
       {
 	tDP1 = *(data0 + idY) + idX;
 	tDP2 = *(data0 + tC2I.vtY + idY) + idX;
@@ -162,12 +161,17 @@ RecError	RecCrossCorrelate(double **data0, double **data1,
 	*tDP1 = tD1 * tD3 - tD2 * tD4;
 	*tDP2 = tD1 * tD4 + tD2 * tD3;
       }
+      *(*data0 + idX) *= *(*data1 + idX);
+      if((size.vtY % 2) == 0)
+      {
+	*(*(data0 + tC2I.vtY) + idX) *= *(*(data1 + tC2I.vtY) + idX);
+      }
+      if((size.vtX % 2) != 0)
+      {
+        break;
+      }
     }
-    **data0 *= **data1;
-    **(data0 + tC2I.vtY) *= **(data1 + tC2I.vtY);
-    *(*data0 + tC2I.vtX) *= *(*data1 + tC2I.vtX);
-    *(*(data0 + tC2I.vtY) + tC2I.vtX) *= *(*(data1 + tC2I.vtY) + tC2I.vtX);
-    AlgFourRealInv2D(data0, 1, size.vtX, size.vtY);
+    errFlag = RecCCorFour(data0, size, 1);
     REC_DBGW((REC_DBG_CROSS|REC_DBG_LVL_1),
 	     WlzFromArray2D((void **)data0, size, org,
 	     		    WLZ_GREY_UBYTE, WLZ_GREY_DOUBLE,
@@ -240,7 +244,7 @@ static RecError	RecCCorObjToFour(double **data,
 	     WlzFromArray2D((void **)data, size, org,
 	     		    WLZ_GREY_UBYTE, WLZ_GREY_DOUBLE,
 			    0.0, 1.0, 0, 0, NULL), 1);
-    AlgFourReal2D(data, 1, size.vtX, size.vtY);
+    errFlag = RecCCorFour(data, size, 0);
     REC_DBGW((REC_DBG_CROSS|REC_DBG_LVL_3),
 	     WlzFromArray2D((void **)data, size, org,
 	     		    WLZ_GREY_UBYTE, WLZ_GREY_DOUBLE,
@@ -429,3 +433,34 @@ RecError	RecCrossCorrelateROI(double *newCC,
 	   errFlag));
   return(errFlag);
 }
+
+/*!
+* \return	Error code.
+* \ingroup	Reconstruct
+* \brief	Computes the forward or inverse real Fourier transform of
+*		the given data in place. Power of two sizes are transformed
+*		using AlgFourReal2D() and other sizes using
+*		AlgFourAnyReal2D(), both of which give the same layout
+*		for even sizes.
+* \param	data			Given data.
+* \param	size			The size of data.
+* \param	inverse			Inverse transform if non-zero.
+*/
+static RecError	RecCCorFour(double **data, WlzIVertex2 size, int inverse)
+{
+  WlzIVertex2	p2Size;
+  AlgError	algErr;
+
+  (void )RecPowerOfTwoC2I(&p2Size, size);
+  if((p2Size.vtX == size.vtX) && (p2Size.vtY == size.vtY))
+  {
+    algErr = (inverse)? AlgFourRealInv2D(data, 1, size.vtX, size.vtY):
+                        AlgFourReal2D(data, 1, size.vtX, size.vtY);
+  }
+  else
+  {
+    algErr = (inverse)? AlgFourAnyRealInv2D(data, size.vtX, size.vtY):
+                        AlgFourAnyReal2D(data, size.vtX, size.vtY);
+  }
+  return(RecErrorFromWlz(WlzErrorFromAlg(algErr)));
+}
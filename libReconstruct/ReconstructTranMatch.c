@@ -99,7 +99,8 @@ RecError	RecTranMatch(WlzDVertex2 *shift, double *value,
 	  ("RecTranMatch 01 {%d %d %d %d} {%d %d} {%d %d}\n",
 	   objLim.xMin, objLim.yMin, objLim.xMax, objLim.yMax,
 	   origin.vtX, origin.vtY, size.vtX, size.vtY));
-  (void )RecPowerOfTwoC2I(&size, size);
+  size.vtX = AlgFourGoodSize(size.vtX);
+  size.vtY = AlgFourGoodSize(size.vtY);
   REC_DBG((REC_DBG_TRAN|REC_DBG_LVL_2),
 	  ("RecTranMatch 02 {%d %d}\n",
 	   size.vtX, size.vtY));
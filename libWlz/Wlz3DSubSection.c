@@ -41,6 +41,9 @@ static char _Wlz3DSubSection_c[] = "University of Edinburgh $Id$";
 
 #include <limits.h>
 #include <float.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include <Wlz.h>
 
@@ -48,13 +51,87 @@ static char _Wlz3DSubSection_c[] = "University of Edinburgh $Id$";
 #define WLZ_FAST_CODE
 #endif
 
+/*!
+* \struct	_WlzGetSubSecPln
+* \ingroup	WlzSectionTransform
+* \brief	A plane of a 3D object which has a rectangular domain and
+*		rectangular values, for direct access to the values.
+*/
+typedef struct _WlzGetSubSecPln
+{
+  int		line1;		/*!< First line of the plane's domain. */
+  int		lastln;		/*!< Last line of the plane's domain. */
+  int		kol1;		/*!< First column of the plane's domain. */
+  int		lastkl;		/*!< Last column of the plane's domain. */
+  int		vLine1;		/*!< First line of the plane's values. */
+  int		vKol1;		/*!< First column of the plane's values. */
+  int		vWidth;		/*!< Width of the plane's values. */
+  WlzGreyP	val;		/*!< The plane's values, NULL if the plane
+  				     is empty. */
+} WlzGetSubSecPln;
+
+/*!
+* \struct	_WlzGetSubSecFast
+* \ingroup	WlzSectionTransform
+* \brief	Direct access to the values of a 3D object in which every
+*		non-empty plane has a rectangular domain and rectangular
+*		values. This allows sections to be cut without using a
+*		grey value workspace.
+*/
+typedef struct _WlzGetSubSecFast
+{
+  int		plane1;		/*!< First plane. */
+  int		nPln;		/*!< Number of planes. */
+  WlzGreyType	gType;		/*!< Grey type of the values. */
+  WlzGreyV	bkd;		/*!< Background value. */
+  WlzGetSubSecPln *pln;		/*!< The planes. */
+} WlzGetSubSecFast;
+
 static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
   WlzObject		*obj,
   WlzObject		*subDomain,
   WlzThreeDViewStruct	*viewStr,
   WlzErrorNum		*dstErr);
+static int		WlzGetSubSectionIsTiled(
+  WlzObject		*obj,
+  WlzInterpolationType	interp,
+  WlzObject		**maskRtn);
+static WlzErrorNum	WlzGetSubSectionValues(
+  WlzObject		*obj,
+  WlzSectionServer	*srv,
+  WlzObject		*newObj,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp);
+static WlzErrorNum	WlzGetSubSectionGenItv(
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  int			line,
+  int			lft,
+  int			rgt,
+  WlzGreyP		dst);
+static void		WlzGetSubSectionFastItv(
+  WlzGetSubSecFast	*fst,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  int			line,
+  int			lft,
+  int			rgt,
+  WlzGreyP		dst);
+static WlzGetSubSecFast	*WlzGetSubSectionFastMake(
+  WlzObject		*obj,
+  WlzErrorNum		*dstErr);
+static void		WlzGetSubSectionFastFree(
+  WlzGetSubSecFast	*fst);
+static WlzGreyValueWSpace *WlzSectionServerWSpGet(
+  WlzSectionServer	*srv,
+  WlzErrorNum		*dstErr);
+static void		WlzSectionServerWSpPut(
+  WlzSectionServer	*srv,
+  WlzGreyValueWSpace	*gVWSp);
 static WlzObject *WlzGetSubSectionFrom3DDomObj(
   WlzObject 		*obj,
+  WlzSectionServer	*srv,
   WlzObject		*subDomain,
   WlzThreeDViewStruct 	*viewStr,
   WlzInterpolationType	interp,
@@ -106,19 +183,14 @@ WlzObject 	*WlzGetSubSectionFromObject(
     switch(obj->type)
     {
       case WLZ_3D_DOMAINOBJ:
-	if(obj->values.core &&
-	   (maskRtn == NULL) &&
-	   (interp == WLZ_INTERPOLATION_NEAREST) &&
-	   WlzGreyTableIsTiled(obj->values.core->type) &&
-	   (obj->values.t->tileWidth == 16) &&
-	   (obj->values.t->original_table.core == NULL))
+	if(WlzGetSubSectionIsTiled(obj, interp, maskRtn))
 	{
 	  newObj = WlzGetSubSectionFrom3DTiledValueObj(obj, subDomain, view,
 	                                               &errNum);
 	}
 	else
 	{
-	  newObj = WlzGetSubSectionFrom3DDomObj(obj, subDomain, view,
+	  newObj = WlzGetSubSectionFrom3DDomObj(obj, NULL, subDomain, view,
 						interp, maskRtn, &errNum);
 	}
         break;
@@ -134,6 +206,220 @@ WlzObject 	*WlzGetSubSectionFromObject(
   return(newObj);
 }
 
+/*!
+* \return	New section server or NULL on error.
+* \ingroup	WlzSectionTransform
+* \brief	Makes a section server for the given 3D domain object.
+*		The server holds the data which are needed to cut
+*		sections from the object but which do not depend on the
+*		view: direct access data for objects with rectangular
+*		planes and a pool of grey value workspaces for other
+*		objects. Sections are then cut using
+*		WlzGetSubSectionFromServer(), which may be called
+*		concurrently from several threads. The object is
+*		assigned by the server and must not be modified while
+*		the server exists.
+* \param	obj			Given 3D domain object with values.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzSectionServer *WlzMakeSectionServer(
+  WlzObject		*obj,
+  WlzErrorNum		*dstErr)
+{
+  int			nThr = 1;
+  WlzSectionServer	*srv = NULL;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(obj->type != WLZ_3D_DOMAINOBJ)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if(obj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if((srv = (WlzSectionServer *)
+                 AlcCalloc(1, sizeof(WlzSectionServer))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    srv->obj = WlzAssignObject(obj, NULL);
+    if(!WlzGreyTableIsTiled(obj->values.core->type))
+    {
+      srv->fast = WlzGetSubSectionFastMake(obj, &errNum);
+    }
+  }
+  /* Without direct access fill the pool with a grey value workspace
+   * for each thread. */
+  if((errNum == WLZ_ERR_NONE) && (srv->fast == NULL))
+  {
+#ifdef _OPENMP
+    nThr = omp_get_max_threads();
+#endif
+    if((srv->wSp = (WlzGreyValueWSpace **)
+                   AlcCalloc(nThr, sizeof(WlzGreyValueWSpace *))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      srv->maxWSp = nThr;
+      while((errNum == WLZ_ERR_NONE) && (srv->nWSp < nThr))
+      {
+        if((srv->wSp[srv->nWSp] = WlzGreyValueMakeWSp(obj,
+	                                              &errNum)) != NULL)
+	{
+	  ++(srv->nWSp);
+	}
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeSectionServer(srv);
+    srv = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(srv);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Frees a section server and all it's data. No sections may
+*		be being cut using the server when it is freed.
+* \param	srv			Given section server, may be NULL.
+*/
+WlzErrorNum	WlzFreeSectionServer(
+  WlzSectionServer	*srv)
+{
+  int		idW;
+
+  if(srv)
+  {
+    for(idW = 0; idW < srv->nWSp; ++idW)
+    {
+      WlzGreyValueFreeWSp(srv->wSp[idW]);
+    }
+    AlcFree(srv->wSp);
+    WlzGetSubSectionFastFree((WlzGetSubSecFast *)(srv->fast));
+    (void )WlzFreeObj(srv->obj);
+    AlcFree(srv);
+  }
+  return(WLZ_ERR_NONE);
+}
+
+/*!
+* \return	New sub-section object.
+* \ingroup	WlzSectionTransform
+* \brief	Computes a section through the section server's 3D
+*		object, as WlzGetSubSectionFromObject() but without
+*		rebuilding the data held by the server. This function
+*		may be called concurrently from several threads provided
+*		that each uses it's own view transform. If the given
+*		view transform has not been initialised it is initialised
+*		using the server's object.
+* \param	srv			Given section server.
+* \param	subDomain		Given 2D domain within which to
+* 					restrict the section. If NULL
+* 					returned section will be have a
+* 					rectangular domain which is the maximum
+* 					for the given object and view
+* 					transform.
+* \param	view			Given view transform.
+* \param	interp			Interpolation, should be either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	maskRtn			Destination pointer for returned
+* 					domain mask, may be NULL.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzGetSubSectionFromServer(
+  WlzSectionServer	*srv,
+  WlzObject		*subDomain,
+  WlzThreeDViewStruct	*view,
+  WlzInterpolationType	interp,
+  WlzObject		**maskRtn,
+  WlzErrorNum		*dstErr)
+{
+  WlzObject	*newObj = NULL;
+  WlzErrorNum 	errNum = WLZ_ERR_NONE;
+
+  if((srv == NULL) || (srv->obj == NULL) || (view == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(view->type != WLZ_3D_VIEW_STRUCT)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(!(view->initialised))
+  {
+    errNum = WlzInit3DViewStruct(view, srv->obj);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(WlzGetSubSectionIsTiled(srv->obj, interp, maskRtn))
+    {
+      newObj = WlzGetSubSectionFrom3DTiledValueObj(srv->obj, subDomain, view,
+						   &errNum);
+    }
+    else
+    {
+      newObj = WlzGetSubSectionFrom3DDomObj(srv->obj, srv, subDomain, view,
+					    interp, maskRtn, &errNum);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(newObj);
+}
+
+/*!
+* \return	Non-zero if the section can be cut from tiled values.
+* \ingroup	WlzSectionTransform
+* \brief	Checks whether a section can be cut from the given 3D
+*		domain object using WlzGetSubSectionFrom3DTiledValueObj().
+* \param	obj			Given 3D domain object.
+* \param	interp			Interpolation.
+* \param	maskRtn			Destination pointer for returned
+* 					domain mask, may be NULL.
+*/
+static int	WlzGetSubSectionIsTiled(
+  WlzObject		*obj,
+  WlzInterpolationType	interp,
+  WlzObject		**maskRtn)
+{
+  int		tiled;
+
+  tiled = obj->values.core &&
+	  (maskRtn == NULL) &&
+	  (interp == WLZ_INTERPOLATION_NEAREST) &&
+	  WlzGreyTableIsTiled(obj->values.core->type) &&
+	  (obj->values.t->tileWidth == 16) &&
+	  (obj->values.t->original_table.core == NULL);
+  return(tiled);
+}
+
 /*!
 * \return	New sub-section object.
 * \ingroup	WlzSectionTransform
@@ -293,6 +579,7 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
                   lnRel;
       WlzDVertex3 vty;
       WlzGreyP	  lnGP;
+      WlzTiledValuesPage *page = NULL;
 
       lnRel = ln - subBox.yMin;
       switch(gType)
@@ -392,40 +679,59 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
 #endif
 	      {
 		size_t   off;
+		WlzGreyP tGP;
 
 #ifdef WLZ_FAST_CODE
-		off = (idx  << 12) +
-		      ((((pz & 15) << 4) + (py & 15)) << 4) + (px & 15);
+		off = ((((pz & 15) << 4) + (py & 15)) << 4) + (px & 15);
 #else
 		WlzIVertex3 tOff;
 
 		tOff.vtX = px % tv->tileWidth;
 		tOff.vtY = py % tv->tileWidth;
 		tOff.vtZ = pz % tv->tileWidth;
-		off = (idx * tv->tileSz) +
-		      ((tOff.vtZ * tv->tileWidth + tOff.vtY) *
+		off = ((tOff.vtZ * tv->tileWidth + tOff.vtY) *
 		       tv->tileWidth) + tOff.vtX;
 #endif
+		if(tv->pager)
+		{
+		  /* Keep the last tile used by this line pinned, since
+		   * successive voxels of a section line are usually in
+		   * the same tile. */
+		  if((page == NULL) || (page->idx != idx))
+		  {
+		    if(page)
+		    {
+		      WlzTiledValuesPageOut(tv, page);
+		    }
+		    page = WlzTiledValuesPageIn(tv, idx, NULL);
+		  }
+		  tGP.v = (page)? page->values.v: NULL;
+		}
+		else
+		{
+		  tGP = tv->tiles;
+		  off += idx * tv->tileSz;
+		}
 		off *= tv->vpe;
-		switch(gType)
+		switch((tGP.v)? gType: WLZ_GREY_ERROR)
 		{
 	          case WLZ_GREY_INT:
-		    lnGP.inp[klRel] = tv->tiles.inp[off];
+		    lnGP.inp[klRel] = tGP.inp[off];
 		    break;
 	          case WLZ_GREY_SHORT:
-		    lnGP.shp[klRel] = tv->tiles.shp[off];
+		    lnGP.shp[klRel] = tGP.shp[off];
 		    break;
 	          case WLZ_GREY_UBYTE:
-		    lnGP.ubp[klRel] = tv->tiles.ubp[off];
+		    lnGP.ubp[klRel] = tGP.ubp[off];
 		    break;
 	          case WLZ_GREY_FLOAT:
-		    lnGP.flp[klRel] = tv->tiles.flp[off];
+		    lnGP.flp[klRel] = tGP.flp[off];
 		    break;
 	          case WLZ_GREY_DOUBLE:
-		    lnGP.dbp[klRel] = tv->tiles.dbp[off];
+		    lnGP.dbp[klRel] = tGP.dbp[off];
 		    break;
 	          case WLZ_GREY_RGBA:
-		    lnGP.rgbp[klRel] = tv->tiles.rgbp[off];
+		    lnGP.rgbp[klRel] = tGP.rgbp[off];
 		    break;
 		  default:
 		    break;
@@ -435,6 +741,10 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
 	  }
 	}
       }
+      if(page)
+      {
+        WlzTiledValuesPageOut(tv, page);
+      }
     }
   }
   if(dstErr)
@@ -462,14 +772,18 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
 #define WLZ_GETSUBSEC_CONVAL(G,F0,F1,V,K,Y) \
 { \
   int		x; \
-  WlzDVertex3   p; \
+  WlzDVertex3   p, \
+		q; \
  \
   x = k - WLZ_NINT((V)->minvals.vtX); \
   WLZ_GETSUBSEC_POS(p,(V),x,(Y)) \
-  WlzGreyValueGetCon((G), p.vtZ, p.vtY, p.vtX); \
-  (F0).vtX = p.vtX - WLZ_NINT(p.vtX - 0.5); \
-  (F0).vtY = p.vtY - WLZ_NINT(p.vtY - 0.5); \
-  (F0).vtZ = p.vtZ - WLZ_NINT(p.vtZ - 0.5); \
+  q.vtX = WLZ_NINT(p.vtX - 0.5); \
+  q.vtY = WLZ_NINT(p.vtY - 0.5); \
+  q.vtZ = WLZ_NINT(p.vtZ - 0.5); \
+  WlzGreyValueGetCon((G), q.vtZ, q.vtY, q.vtX); \
+  (F0).vtX = p.vtX - q.vtX; \
+  (F0).vtY = p.vtY - q.vtY; \
+  (F0).vtZ = p.vtZ - q.vtZ; \
   (F1).vtX = 1.0 - (F0).vtX; \
   (F1).vtY = 1.0 - (F0).vtY; \
   (F1).vtZ = 1.0 - (F0).vtZ; \
@@ -496,6 +810,7 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
 */
 static WlzObject *WlzGetSubSectionFrom3DDomObj(
   WlzObject		*obj,
+  WlzSectionServer	*srv,
   WlzObject		*subDomain,
   WlzThreeDViewStruct	*viewStr,
   WlzInterpolationType	interp,
@@ -506,7 +821,6 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
 			*mask = NULL;
   WlzDomain		domain;
   WlzValues		values;
-  WlzGreyValueWSpace	*gVWSp = NULL;
   WlzIntervalWSpace	iwsp;
   WlzGreyWSpace		gwsp;
   int			maskFlg = 0,
@@ -639,177 +953,7 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
   /* Scan object setting values */
   if((errNum == WLZ_ERR_NONE) && greyFlg)
   {
-    if((gVWSp = WlzGreyValueMakeWSp(obj, &errNum)))
-    {
-      errNum = WlzInitGreyScan(newObj, &iwsp, &gwsp);
-      while((errNum == WLZ_ERR_NONE) && 
-	    ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-      {
-        int 	k,
-		yp;
-	WlzDVertex3 vty;
-
-	yp = iwsp.linpos - WLZ_NINT(viewStr->minvals.vtY);
-	vty.vtX = viewStr->yp_to_x[yp];
-	vty.vtY = viewStr->yp_to_y[yp];
-	vty.vtZ = viewStr->yp_to_z[yp];
-	switch(interp)
-	{
-	  case WLZ_INTERPOLATION_NEAREST:
-	    switch(gVWSp->gType){
-	      case WLZ_GREY_INT:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.inp)++ = gVWSp->gVal[0].inv;
-		}
-		break;
-	      case WLZ_GREY_SHORT:
-	        for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.shp)++ = gVWSp->gVal[0].shv;
-		}
-		break;
-	      case WLZ_GREY_UBYTE:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.ubp)++ = gVWSp->gVal[0].ubv;
-		}
-		break;
-	      case WLZ_GREY_FLOAT:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.flp)++ = gVWSp->gVal[0].flv;
-		}
-		break;
-	      case WLZ_GREY_DOUBLE:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.dbp)++ = gVWSp->gVal[0].dbv;
-		}
-		break;
-	      case WLZ_GREY_RGBA:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.rgbp)++ = gVWSp->gVal[0].rgbv;
-		}
-		break;
-	      default:
-		break;
-	    }
-	    break;
-	  case WLZ_INTERPOLATION_LINEAR:
-	    {
-	      double		tD0;
-	      WlzDVertex3	tDV0,
-				tDV1;
-
-	      switch(gVWSp->gType){
-		case WLZ_GREY_INT:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).inv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).inv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).inv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).inv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).inv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).inv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).inv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).inv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    tD0 = WLZ_CLAMP(tD0, INT_MIN, INT_MAX);
-		    *(gwsp.u_grintptr.inp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		case WLZ_GREY_SHORT:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).shv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).shv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).shv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).shv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).shv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).shv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).shv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).shv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    tD0 = WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX);
-		    *(gwsp.u_grintptr.shp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		case WLZ_GREY_UBYTE:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).ubv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).ubv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).ubv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).ubv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).ubv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).ubv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).ubv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).ubv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    tD0 = WLZ_CLAMP(tD0, 0, 255);
-		    *(gwsp.u_grintptr.ubp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		case WLZ_GREY_FLOAT:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).flv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).flv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).flv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).flv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).flv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).flv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).flv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).flv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    *(gwsp.u_grintptr.flp)++ = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
-		  }
-		  break;
-		case WLZ_GREY_DOUBLE:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).dbv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).dbv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).dbv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).dbv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).dbv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).dbv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).dbv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).dbv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    *(gwsp.u_grintptr.dbp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		default:
-		  errNum = WLZ_ERR_GREY_TYPE;
-		  break;
-	      }
-	    }
-	    break;
-	  default:
-	    errNum = WLZ_ERR_UNIMPLEMENTED;
-	    break;
-	}
-      }
-      if(errNum == WLZ_ERR_EOO)	   /* Reset error from end of intervals */ 
-      {
-	errNum = WLZ_ERR_NONE;
-      }
-      WlzGreyValueFreeWSp(gVWSp);
-    }
+    errNum = WlzGetSubSectionValues(obj, srv, newObj, viewStr, interp);
   }
 
   /* Check if mask required */
@@ -886,3 +1030,868 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
   }
   return(newObj);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Sets the values of a new section object which has a
+*		rectangular value table, by sampling the given 3D object.
+*		The lines of the section are shared between threads.
+*		If every non-empty plane of the 3D object has a
+*		rectangular domain and rectangular values and the grey
+*		type is WLZ_GREY_UBYTE, WLZ_GREY_SHORT or WLZ_GREY_RGBA
+*		then the values are read directly, otherwise each thread
+*		uses its own grey value workspace.
+* \param	obj			Given 3D domain object with values.
+* \param	srv			Section server which provides the
+*					direct access data and the grey
+*					value workspaces, may be NULL in
+*					which case these are made and freed
+*					here.
+* \param	newObj			New 2D section object with a
+*					rectangular value table.
+* \param	viewStr			Given initialised view transform.
+* \param	interp			Interpolation, either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+*/
+static WlzErrorNum	WlzGetSubSectionValues(
+  WlzObject		*obj,
+  WlzSectionServer	*srv,
+  WlzObject		*newObj,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp)
+{
+  int			idL,
+  			nLn,
+  			nThr = 1;
+  WlzGreyType		gType;
+  WlzIntervalDomain	*iDom;
+  WlzRectValues		*rVal;
+  WlzGetSubSecFast	*fst = NULL;
+  WlzGreyValueWSpace	**gVWSp = NULL;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+  iDom = newObj->domain.i;
+  rVal = newObj->values.r;
+  gType = WlzGreyTableTypeToGreyType(rVal->type, NULL);
+  nLn = iDom->lastln - iDom->line1 + 1;
+  fst = (srv)? (WlzGetSubSecFast *)(srv->fast):
+               WlzGetSubSectionFastMake(obj, &errNum);
+  if((errNum == WLZ_ERR_NONE) && (fst == NULL))
+  {
+    /* Make a grey value workspace for each thread. */
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+        nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    if((gVWSp = (WlzGreyValueWSpace **)
+                AlcCalloc(nThr, sizeof(WlzGreyValueWSpace *))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	idT;
+
+      for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
+      {
+        gVWSp[idT] = (srv)? WlzSectionServerWSpGet(srv, &errNum):
+	                    WlzGreyValueMakeWSp(obj, &errNum);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic, 16)
+#endif
+    for(idL = 0; idL < nLn; ++idL)
+    {
+      int	idI,
+      		nItv,
+		line,
+		thrId = 0;
+      WlzInterval lnItv;
+      WlzInterval *itv;
+      WlzGreyP	dst;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      line = iDom->line1 + idL;
+      if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+      {
+        nItv = 1;
+	lnItv.ileft = 0;
+	lnItv.iright = iDom->lastkl - iDom->kol1;
+	itv = &lnItv;
+      }
+      else
+      {
+        nItv = iDom->intvlines[idL].nintvs;
+	itv = iDom->intvlines[idL].intvs;
+      }
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      for(idI = 0; (errNum2 == WLZ_ERR_NONE) && (idI < nItv); ++idI)
+      {
+	int	lft,
+		rgt;
+	size_t	off;
+
+	lft = iDom->kol1 + itv[idI].ileft;
+	rgt = iDom->kol1 + itv[idI].iright;
+	off = ((size_t )(line - rVal->line1) * rVal->width) +
+	      lft - rVal->kol1;
+	switch(gType)
+	{
+	  case WLZ_GREY_INT:
+	    dst.inp = rVal->values.inp + off;
+	    break;
+	  case WLZ_GREY_SHORT:
+	    dst.shp = rVal->values.shp + off;
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    dst.ubp = rVal->values.ubp + off;
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    dst.flp = rVal->values.flp + off;
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    dst.dbp = rVal->values.dbp + off;
+	    break;
+	  case WLZ_GREY_RGBA:
+	    dst.rgbp = rVal->values.rgbp + off;
+	    break;
+	  default:
+	    errNum2 = WLZ_ERR_GREY_TYPE;
+	    break;
+	}
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  if(fst)
+	  {
+	    WlzGetSubSectionFastItv(fst, viewStr, interp, line, lft, rgt, dst);
+	  }
+	  else
+	  {
+	    errNum2 = WlzGetSubSectionGenItv(gVWSp[thrId], viewStr, interp,
+					     line, lft, rgt, dst);
+	  }
+	}
+      }
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzGetSubSectionValues)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  if(gVWSp)
+  {
+    int		idT;
+
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      if(srv && gVWSp[idT])
+      {
+        WlzSectionServerWSpPut(srv, gVWSp[idT]);
+      }
+      else
+      {
+	WlzGreyValueFreeWSp(gVWSp[idT]);
+      }
+    }
+    AlcFree(gVWSp);
+  }
+  if(srv == NULL)
+  {
+    WlzGetSubSectionFastFree(fst);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Sets the section values for an interval of a line using
+*		the given grey value workspace.
+* \param	gVWSp			Grey value workspace for the 3D object.
+* \param	viewStr			Given initialised view transform.
+* \param	interp			Interpolation, either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	line			Line of the section.
+* \param	lft			First column of the interval.
+* \param	rgt			Last column of the interval.
+* \param	dst			Destination for the interval's values.
+*/
+static WlzErrorNum	WlzGetSubSectionGenItv(
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  int			line,
+  int			lft,
+  int			rgt,
+  WlzGreyP		dst)
+{
+  int		k,
+		yp;
+  WlzDVertex3	vty;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  yp = line - WLZ_NINT(viewStr->minvals.vtY);
+  vty.vtX = viewStr->yp_to_x[yp];
+  vty.vtY = viewStr->yp_to_y[yp];
+  vty.vtZ = viewStr->yp_to_z[yp];
+  switch(interp)
+  {
+    case WLZ_INTERPOLATION_NEAREST:
+      switch(gVWSp->gType){
+	case WLZ_GREY_INT:
+	  for(k = lft; k <= rgt; ++k)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(dst.inp)++ = gVWSp->gVal[0].inv;
+	  }
+	  break;
+	case WLZ_GREY_SHORT:
+	  for(k=lft; k <= rgt; k++)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(dst.shp)++ = gVWSp->gVal[0].shv;
+	  }
+	  break;
+	case WLZ_GREY_UBYTE:
+	  for(k = lft; k <= rgt; ++k)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(dst.ubp)++ = gVWSp->gVal[0].ubv;
+	  }
+	  break;
+	case WLZ_GREY_FLOAT:
+	  for(k = lft; k <= rgt; ++k)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(dst.flp)++ = gVWSp->gVal[0].flv;
+	  }
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  for(k = lft; k <= rgt; ++k)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(dst.dbp)++ = gVWSp->gVal[0].dbv;
+	  }
+	  break;
+	case WLZ_GREY_RGBA:
+	  for(k = lft; k <= rgt; ++k)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(dst.rgbp)++ = gVWSp->gVal[0].rgbv;
+	  }
+	  break;
+	default:
+	  break;
+      }
+      break;
+    case WLZ_INTERPOLATION_LINEAR:
+      {
+	double            tD0;
+	WlzDVertex3       tDV0,
+			  tDV1;
+
+	switch(gVWSp->gType){
+	  case WLZ_GREY_INT:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      tD0 =
+		((gVWSp->gVal[0]).inv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[1]).inv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[2]).inv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[3]).inv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[4]).inv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[5]).inv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[6]).inv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[7]).inv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+	      tD0 = WLZ_CLAMP(tD0, INT_MIN, INT_MAX);
+	      *(dst.inp)++ = WLZ_NINT(tD0);
+	    }
+	    break;
+	  case WLZ_GREY_SHORT:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      tD0 =
+		((gVWSp->gVal[0]).shv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[1]).shv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[2]).shv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[3]).shv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[4]).shv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[5]).shv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[6]).shv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[7]).shv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+	      tD0 = WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX);
+	      *(dst.shp)++ = WLZ_NINT(tD0);
+	    }
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      tD0 =
+		((gVWSp->gVal[0]).ubv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[1]).ubv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[2]).ubv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[3]).ubv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[4]).ubv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[5]).ubv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[6]).ubv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[7]).ubv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+	      tD0 = WLZ_CLAMP(tD0, 0, 255);
+	      *(dst.ubp)++ = WLZ_NINT(tD0);
+	    }
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      tD0 =
+		((gVWSp->gVal[0]).flv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[1]).flv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[2]).flv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[3]).flv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[4]).flv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[5]).flv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[6]).flv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[7]).flv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+	      *(dst.flp)++ = WLZ_CLAMP(tD0, -FLT_MAX, FLT_MAX);
+	    }
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      tD0 =
+		((gVWSp->gVal[0]).dbv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[1]).dbv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[2]).dbv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[3]).dbv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[4]).dbv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[5]).dbv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[6]).dbv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[7]).dbv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+	      *(dst.dbp)++ = tD0;
+	    }
+	    break;
+	  case WLZ_GREY_RGBA:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      int	idC,
+	      		idN;
+	      WlzUInt	u;
+	      double	w;
+	      double	c[4];
+
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      c[0] = c[1] = c[2] = c[3] = 0.0;
+	      for(idN = 0; idN < 8; ++idN)
+	      {
+		w = ((idN & 1)? tDV0.vtX: tDV1.vtX) *
+		    ((idN & 2)? tDV0.vtY: tDV1.vtY) *
+		    ((idN & 4)? tDV0.vtZ: tDV1.vtZ);
+		u = (gVWSp->gVal[idN]).rgbv;
+		c[0] += w * WLZ_RGBA_RED_GET(u);
+		c[1] += w * WLZ_RGBA_GREEN_GET(u);
+		c[2] += w * WLZ_RGBA_BLUE_GET(u);
+		c[3] += w * WLZ_RGBA_ALPHA_GET(u);
+	      }
+	      for(idC = 0; idC < 4; ++idC)
+	      {
+		c[idC] = WLZ_CLAMP(c[idC], 0, 255);
+		c[idC] = WLZ_NINT(c[idC]);
+	      }
+	      WLZ_RGBA_RGBA_SET(u, (WlzUInt )(c[0]), (WlzUInt )(c[1]),
+				(WlzUInt )(c[2]), (WlzUInt )(c[3]));
+	      *(dst.rgbp)++ = u;
+	    }
+	    break;
+	  default:
+	    errNum = WLZ_ERR_GREY_TYPE;
+	    break;
+	}
+      }
+      break;
+    default:
+      errNum = WLZ_ERR_UNIMPLEMENTED;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Plane with the given position, NULL if the position is
+*		outside of the object's domain.
+* \ingroup	WlzSectionTransform
+* \brief	Finds the plane and value offset of the given position
+*		for direct access to the values.
+* \param	fst			Direct access data for the object.
+* \param	pl			Plane coordinate.
+* \param	ln			Line coordinate.
+* \param	kl			Column coordinate.
+* \param	dstOff			Destination for the offset of the
+*					value in the plane's values.
+*/
+static WlzGetSubSecPln	*WlzGetSubSectionFastPos(
+  WlzGetSubSecFast	*fst,
+  int			pl,
+  int			ln,
+  int			kl,
+  size_t		*dstOff)
+{
+  WlzGetSubSecPln *pln = NULL;
+
+  pl -= fst->plane1;
+  if((unsigned int )pl < (unsigned int )(fst->nPln))
+  {
+    pln = fst->pln + pl;
+    if((pln->val.v != NULL) &&
+       ((unsigned int )(ln - pln->line1) <=
+        (unsigned int )(pln->lastln - pln->line1)) &&
+       ((unsigned int )(kl - pln->kol1) <=
+        (unsigned int )(pln->lastkl - pln->kol1)))
+    {
+      *dstOff = ((size_t )(ln - pln->vLine1) * pln->vWidth) +
+                kl - pln->vKol1;
+    }
+    else
+    {
+      pln = NULL;
+    }
+  }
+  return(pln);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzSectionTransform
+* \brief	Finds the eight neighbouring voxels of the given position
+*		for linear interpolation, with the voxels ordered as by
+*		WlzGreyValueGetCon(), together with the interpolation
+*		weights. Voxels which are outside of the object's domain
+*		have a NULL plane.
+* \param	fst			Direct access data for the object.
+* \param	p			Given position.
+* \param	pln			Destination for the eight planes.
+* \param	off			Destination for the eight value
+*					offsets.
+* \param	wgt			Destination for the eight weights.
+*/
+static void		WlzGetSubSectionFastCon(
+  WlzGetSubSecFast	*fst,
+  WlzDVertex3		p,
+  WlzGetSubSecPln	**pln,
+  size_t		*off,
+  double		*wgt)
+{
+  int		idN,
+  		pl,
+		ln,
+		kl;
+  WlzDVertex3	f0,
+  		f1;
+
+  kl = WLZ_NINT(p.vtX - 0.5);
+  ln = WLZ_NINT(p.vtY - 0.5);
+  pl = WLZ_NINT(p.vtZ - 0.5);
+  f0.vtX = p.vtX - kl;
+  f0.vtY = p.vtY - ln;
+  f0.vtZ = p.vtZ - pl;
+  f1.vtX = 1.0 - f0.vtX;
+  f1.vtY = 1.0 - f0.vtY;
+  f1.vtZ = 1.0 - f0.vtZ;
+  for(idN = 0; idN < 8; ++idN)
+  {
+    pln[idN] = WlzGetSubSectionFastPos(fst, pl + (idN >> 2),
+                                       ln + ((idN >> 1) & 1),
+				       kl + (idN & 1), off + idN);
+  }
+  wgt[0] = f1.vtX * f1.vtY * f1.vtZ;
+  wgt[1] = f0.vtX * f1.vtY * f1.vtZ;
+  wgt[2] = f1.vtX * f0.vtY * f1.vtZ;
+  wgt[3] = f0.vtX * f0.vtY * f1.vtZ;
+  wgt[4] = f1.vtX * f1.vtY * f0.vtZ;
+  wgt[5] = f0.vtX * f1.vtY * f0.vtZ;
+  wgt[6] = f1.vtX * f0.vtY * f0.vtZ;
+  wgt[7] = f0.vtX * f0.vtY * f0.vtZ;
+}
+
+/*!
+* \return	void
+* \ingroup	WlzSectionTransform
+* \brief	Sets the section values for an interval of a line by
+*		reading the object's values directly, with a specialised
+*		loop for each grey type and interpolation.
+* \param	fst			Direct access data for the object.
+* \param	viewStr			Given initialised view transform.
+* \param	interp			Interpolation, either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	line			Line of the section.
+* \param	lft			First column of the interval.
+* \param	rgt			Last column of the interval.
+* \param	dst			Destination for the interval's values.
+*/
+static void		WlzGetSubSectionFastItv(
+  WlzGetSubSecFast	*fst,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  int			line,
+  int			lft,
+  int			rgt,
+  WlzGreyP		dst)
+{
+  int		idN,
+  		xp,
+  		xp0,
+		xp1,
+		yp;
+  size_t	off[8];
+  double	wgt[8];
+  WlzDVertex3	p,
+  		vty;
+  WlzGetSubSecPln *pln[8];
+
+  yp = line - WLZ_NINT(viewStr->minvals.vtY);
+  xp0 = lft - WLZ_NINT(viewStr->minvals.vtX);
+  xp1 = rgt - WLZ_NINT(viewStr->minvals.vtX);
+  vty.vtX = viewStr->yp_to_x[yp];
+  vty.vtY = viewStr->yp_to_y[yp];
+  vty.vtZ = viewStr->yp_to_z[yp];
+  if(interp == WLZ_INTERPOLATION_NEAREST)
+  {
+    switch(fst->gType)
+    {
+      case WLZ_GREY_SHORT:
+	for(xp = xp0; xp <= xp1; ++xp)
+	{
+	  WLZ_GETSUBSEC_POS(p, viewStr, xp, vty)
+	  pln[0] = WlzGetSubSectionFastPos(fst, WLZ_NINT(p.vtZ),
+	                                   WLZ_NINT(p.vtY), WLZ_NINT(p.vtX),
+					   off);
+	  *(dst.shp)++ = (pln[0])? pln[0]->val.shp[off[0]]: fst->bkd.shv;
+	}
+	break;
+      case WLZ_GREY_UBYTE:
+	for(xp = xp0; xp <= xp1; ++xp)
+	{
+	  WLZ_GETSUBSEC_POS(p, viewStr, xp, vty)
+	  pln[0] = WlzGetSubSectionFastPos(fst, WLZ_NINT(p.vtZ),
+	                                   WLZ_NINT(p.vtY), WLZ_NINT(p.vtX),
+					   off);
+	  *(dst.ubp)++ = (pln[0])? pln[0]->val.ubp[off[0]]: fst->bkd.ubv;
+	}
+	break;
+      case WLZ_GREY_RGBA:
+	for(xp = xp0; xp <= xp1; ++xp)
+	{
+	  WLZ_GETSUBSEC_POS(p, viewStr, xp, vty)
+	  pln[0] = WlzGetSubSectionFastPos(fst, WLZ_NINT(p.vtZ),
+	                                   WLZ_NINT(p.vtY), WLZ_NINT(p.vtX),
+					   off);
+	  *(dst.rgbp)++ = (pln[0])? pln[0]->val.rgbp[off[0]]: fst->bkd.rgbv;
+	}
+	break;
+      default:
+        break;
+    }
+  }
+  else /* interp == WLZ_INTERPOLATION_LINEAR */
+  {
+    double	tD0;
+
+    switch(fst->gType)
+    {
+      case WLZ_GREY_SHORT:
+	for(xp = xp0; xp <= xp1; ++xp)
+	{
+	  WLZ_GETSUBSEC_POS(p, viewStr, xp, vty)
+	  WlzGetSubSectionFastCon(fst, p, pln, off, wgt);
+	  tD0 = 0.0;
+	  for(idN = 0; idN < 8; ++idN)
+	  {
+	    tD0 += wgt[idN] * ((pln[idN])? pln[idN]->val.shp[off[idN]]:
+	                                   fst->bkd.shv);
+	  }
+	  tD0 = WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX);
+	  *(dst.shp)++ = WLZ_NINT(tD0);
+	}
+	break;
+      case WLZ_GREY_UBYTE:
+	for(xp = xp0; xp <= xp1; ++xp)
+	{
+	  WLZ_GETSUBSEC_POS(p, viewStr, xp, vty)
+	  WlzGetSubSectionFastCon(fst, p, pln, off, wgt);
+	  tD0 = 0.0;
+	  for(idN = 0; idN < 8; ++idN)
+	  {
+	    tD0 += wgt[idN] * ((pln[idN])? pln[idN]->val.ubp[off[idN]]:
+	                                   fst->bkd.ubv);
+	  }
+	  tD0 = WLZ_CLAMP(tD0, 0, 255);
+	  *(dst.ubp)++ = WLZ_NINT(tD0);
+	}
+	break;
+      case WLZ_GREY_RGBA:
+	for(xp = xp0; xp <= xp1; ++xp)
+	{
+	  int	idC;
+	  WlzUInt u;
+	  double c[4];
+
+	  WLZ_GETSUBSEC_POS(p, viewStr, xp, vty)
+	  WlzGetSubSectionFastCon(fst, p, pln, off, wgt);
+	  c[0] = c[1] = c[2] = c[3] = 0.0;
+	  for(idN = 0; idN < 8; ++idN)
+	  {
+	    u = (pln[idN])? pln[idN]->val.rgbp[off[idN]]: fst->bkd.rgbv;
+	    c[0] += wgt[idN] * WLZ_RGBA_RED_GET(u);
+	    c[1] += wgt[idN] * WLZ_RGBA_GREEN_GET(u);
+	    c[2] += wgt[idN] * WLZ_RGBA_BLUE_GET(u);
+	    c[3] += wgt[idN] * WLZ_RGBA_ALPHA_GET(u);
+	  }
+	  for(idC = 0; idC < 4; ++idC)
+	  {
+	    c[idC] = WLZ_CLAMP(c[idC], 0, 255);
+	    c[idC] = WLZ_NINT(c[idC]);
+	  }
+	  WLZ_RGBA_RGBA_SET(u, (WlzUInt )(c[0]), (WlzUInt )(c[1]),
+	                    (WlzUInt )(c[2]), (WlzUInt )(c[3]));
+	  *(dst.rgbp)++ = u;
+	}
+	break;
+      default:
+        break;
+    }
+  }
+}
+
+/*!
+* \return	Direct access data or NULL if the object's values can not
+*		be accessed directly.
+* \ingroup	WlzSectionTransform
+* \brief	Makes the data required for direct access to the values
+*		of the given 3D object. Direct access is only possible if
+*		the object has grey type WLZ_GREY_UBYTE, WLZ_GREY_SHORT or
+*		WLZ_GREY_RGBA, a voxel value table and every non-empty
+*		plane has a rectangular domain and rectangular values.
+*		If direct access is not possible NULL is returned without
+*		an error.
+* \param	obj			Given 3D domain object with values.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzGetSubSecFast	*WlzGetSubSectionFastMake(
+  WlzObject		*obj,
+  WlzErrorNum		*dstErr)
+{
+  int			idP,
+  			ok = 1;
+  WlzPixelV		bkd;
+  WlzPlaneDomain	*pDom;
+  WlzVoxelValues	*vVal;
+  WlzGetSubSecFast	*fst = NULL;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+  pDom = obj->domain.p;
+  vVal = obj->values.vox;
+  if((vVal->type != WLZ_VOXELVALUETABLE_GREY) ||
+     (vVal->plane1 != pDom->plane1) || (vVal->lastpl != pDom->lastpl))
+  {
+    ok = 0;
+  }
+  else
+  {
+    bkd = vVal->bckgrnd;
+    switch(WlzGreyTypeFromObj(obj, &errNum))
+    {
+      case WLZ_GREY_SHORT: /* FALLTHROUGH */
+      case WLZ_GREY_UBYTE: /* FALLTHROUGH */
+      case WLZ_GREY_RGBA:
+	break;
+      default:
+	ok = 0;
+	break;
+    }
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    if(((fst = (WlzGetSubSecFast *)
+               AlcCalloc(1, sizeof(WlzGetSubSecFast))) == NULL) ||
+       ((fst->pln = (WlzGetSubSecPln *)
+                    AlcCalloc(pDom->lastpl - pDom->plane1 + 1,
+		              sizeof(WlzGetSubSecPln))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      fst->plane1 = pDom->plane1;
+      fst->nPln = pDom->lastpl - pDom->plane1 + 1;
+      fst->gType = WlzGreyTypeFromObj(obj, NULL);
+      errNum = WlzValueConvertPixel(&bkd, bkd, fst->gType);
+      fst->bkd = bkd.v;
+    }
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    for(idP = 0; ok && (idP < fst->nPln); ++idP)
+    {
+      WlzDomain	dom;
+      WlzValues	val;
+
+      dom = pDom->domains[idP];
+      val = vVal->values[idP];
+      if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN))
+      {
+	if((dom.core->type != WLZ_INTERVALDOMAIN_RECT) ||
+	   (val.core == NULL) ||
+	   (WlzGreyTableTypeToTableType(val.core->type, NULL) !=
+	    WLZ_GREY_TAB_RECT) ||
+	   (WlzGreyTableTypeToGreyType(val.core->type, NULL) != fst->gType))
+	{
+	  ok = 0;
+	}
+	else
+	{
+	  WlzGetSubSecPln *pln;
+
+	  pln = fst->pln + idP;
+	  pln->line1 = dom.i->line1;
+	  pln->lastln = dom.i->lastln;
+	  pln->kol1 = dom.i->kol1;
+	  pln->lastkl = dom.i->lastkl;
+	  pln->vLine1 = val.r->line1;
+	  pln->vKol1 = val.r->kol1;
+	  pln->vWidth = val.r->width;
+	  pln->val = val.r->values;
+	}
+      }
+    }
+  }
+  if(!ok || (errNum != WLZ_ERR_NONE))
+  {
+    WlzGetSubSectionFastFree(fst);
+    fst = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(fst);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzSectionTransform
+* \brief	Frees direct access data.
+* \param	fst			Given direct access data, may be NULL.
+*/
+static void		WlzGetSubSectionFastFree(
+  WlzGetSubSecFast	*fst)
+{
+  if(fst)
+  {
+    AlcFree(fst->pln);
+    AlcFree(fst);
+  }
+}
+
+/*!
+* \return	Grey value workspace or NULL on error.
+* \ingroup	WlzSectionTransform
+* \brief	Takes a grey value workspace from the section server's
+*		pool, making a new one if the pool is empty.
+* \param	srv			Given section server.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzGreyValueWSpace *WlzSectionServerWSpGet(
+  WlzSectionServer	*srv,
+  WlzErrorNum		*dstErr)
+{
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp critical (WlzSectionServer)
+#endif
+  {
+    if(srv->nWSp > 0)
+    {
+      gVWSp = srv->wSp[--(srv->nWSp)];
+    }
+  }
+  if(gVWSp == NULL)
+  {
+    gVWSp = WlzGreyValueMakeWSp(srv->obj, &errNum);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(gVWSp);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzSectionTransform
+* \brief	Returns a grey value workspace to the section server's
+*		pool, growing the pool if required. If the pool can not
+*		be grown the workspace is freed.
+* \param	srv			Given section server.
+* \param	gVWSp			Given grey value workspace.
+*/
+static void	WlzSectionServerWSpPut(
+  WlzSectionServer	*srv,
+  WlzGreyValueWSpace	*gVWSp)
+{
+#ifdef _OPENMP
+#pragma omp critical (WlzSectionServer)
+#endif
+  {
+    if(srv->nWSp >= srv->maxWSp)
+    {
+      int	maxWSp;
+      WlzGreyValueWSpace **wSp;
+
+      maxWSp = (srv->maxWSp > 0)? 2 * srv->maxWSp: 4;
+      if((wSp = (WlzGreyValueWSpace **)
+                AlcRealloc(srv->wSp,
+		           maxWSp * sizeof(WlzGreyValueWSpace *))) != NULL)
+      {
+        srv->wSp = wSp;
+	srv->maxWSp = maxWSp;
+      }
+    }
+    if(srv->nWSp < srv->maxWSp)
+    {
+      srv->wSp[(srv->nWSp)++] = gVWSp;
+      gVWSp = NULL;
+    }
+  }
+  if(gVWSp)
+  {
+    WlzGreyValueFreeWSp(gVWSp);
+  }
+}
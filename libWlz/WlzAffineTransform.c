@@ -48,7 +48,9 @@ static char _WlzAffineTransform_c[] = "University of Edinburgh $Id$";
 #include <limits.h>
 #include <float.h>
 #include <string.h>
-
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <Wlz.h>
 
 #ifdef _OPENMP
@@ -102,6 +104,17 @@ static WlzErrorNum 		WlzAffineTransformValues3(WlzObject *newObj,
 				  WlzInterpolationType interp,
 				  void *cbData,
 				  WlzAffineTransformCbFn cbFn);
+static WlzErrorNum 		WlzAffineTransformValues3Pln(
+				  WlzObject *newObj,
+				  int pIdx,
+				  int pln,
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzAffineTransform *invTrans,
+				  WlzInterpolationType interp,
+				  WlzGreyType gType,
+				  WlzPixelV bkdV,
+				  void *cbData,
+				  WlzAffineTransformCbFn cbFn);
 static WlzErrorNum 		WlzAffineTransformPrimSet2(
 				  WlzAffineTransform *tr,
 				  WlzAffineTransformPrim prim);
@@ -1652,6 +1665,10 @@ static WlzErrorNum WlzAffineTransformValues2(WlzObject *newObj,
 * \brief	Creates new value, fills in the values and adds it
 *		to the given new object.
 *		not checked.
+*		The planes of the new object are filled in parallel
+*		(when OpenMP is enabled) using a grey value workspace
+*		per thread, except when a callback function is used
+*		as this may not be reentrant.
 * \param	newObj			Partialy transformed object
 *					with a valid domain.
 * \param	srcObj			3D domain object which is being
@@ -1670,31 +1687,18 @@ static WlzErrorNum WlzAffineTransformValues3(WlzObject *newObj,
 					     void *cbData,
 					     WlzAffineTransformCbFn cbFn)
 {
-  int		tI0,
-  		count;
-  double	tD0, x, y, z;
-  WlzIVertex3	idx,
-  		sPos,
-		dPos;
-  WlzDVertex3	tDV0,
-  		tDV1;
+  int		idP,
+  		nPln,
+		nThr = 1;
   WlzIBox3	bBox = {0}; /* Initalised only to silence incorrect warnings. */
   WlzPixelV	bkdV;
-  WlzValues	tVal,
-  		dstValues,
-  		emptyValues;
-  WlzObject 	*tObj0;
-  WlzGreyWSpace	gWSp;
-  WlzIntervalWSpace iWSp;
-  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzValues	dstValues;
+  WlzGreyValueWSpace **gVWSp = NULL;
   WlzAffineTransform *invTrans = NULL;
-  WlzGreyType	gType;
-  WlzDomain	dom2D;
-  double	tMat[3][3];
+  WlzGreyType	gType = WLZ_GREY_ERROR;
   WlzErrorNum	errNum = WLZ_ERR_UNIMPLEMENTED;
 
   dstValues.core = NULL;
-  emptyValues.core = NULL;
   /* Make a new voxel value table. */
   bkdV = WlzGetBackground(srcObj, &errNum);
   if(errNum == WLZ_ERR_NONE)
@@ -1720,341 +1724,502 @@ static WlzErrorNum WlzAffineTransformValues3(WlzObject *newObj,
   {
     invTrans = WlzAffineTransformInverse(trans, &errNum);
   }
-  /* For each plane in the new object make a new value table and
-   * then fill it in. */
+  /* Make a grey value workspace for each thread. */
   if(errNum == WLZ_ERR_NONE)
   {
-    gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
+#ifdef _OPENMP
+    if(interp != WLZ_INTERPOLATION_CALLBACK)
+    {
+#pragma omp parallel
+      {
+#pragma omp master
+        {
+	  nThr = omp_get_num_threads();
+	}
+      }
+    }
+#endif
+    if((gVWSp = (WlzGreyValueWSpace **)
+                AlcCalloc(nThr, sizeof(WlzGreyValueWSpace *))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	idT;
+
+      for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
+      {
+        gVWSp[idT] = WlzGreyValueMakeWSp(srcObj, &errNum);
+      }
+    }
   }
+  /* For each plane in the new object make a new value table and
+   * then fill it in. */
   if(errNum == WLZ_ERR_NONE)
   {
-    idx.vtZ = 0;
-    dPos.vtZ = bBox.zMin;
-    tMat[0][0] = invTrans->mat[0][0];
-    tMat[1][0] = invTrans->mat[1][0];
-    tMat[2][0] = invTrans->mat[2][0];
-    while((errNum == WLZ_ERR_NONE) && (dPos.vtZ <= bBox.zMax))
+    nPln = bBox.zMax - bBox.zMin + 1;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
+#endif
+    for(idP = 0; idP < nPln; ++idP)
     {
-      if(((dom2D = *(newObj->domain.p->domains + idx.vtZ)).core != NULL) &&
+      WlzDomain	dom2D;
+
+      if((errNum == WLZ_ERR_NONE) &&
+         ((dom2D = *(newObj->domain.p->domains + idP)).core != NULL) &&
          (dom2D.core->type != WLZ_EMPTY_DOMAIN))
       {
-	tMat[0][2] = invTrans->mat[0][3] + (invTrans->mat[0][2] * dPos.vtZ);
-	tMat[1][2] = invTrans->mat[1][3] + (invTrans->mat[1][2] * dPos.vtZ);
-	tMat[2][2] = invTrans->mat[2][3] + (invTrans->mat[2][2] * dPos.vtZ);
-	/* Make a 2D domain object for the plane. */
-	tObj0 = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	    *(newObj->domain.p->domains + idx.vtZ),
-	    emptyValues, NULL, NULL, &errNum);
-	if(errNum == WLZ_ERR_NONE)
-	{
-	  tVal.v = WlzNewValueTb(tObj0,
-	  		         WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR,
-				 		       gType, NULL),
-				 bkdV, &errNum);
-	}
-	if(errNum == WLZ_ERR_NONE)
-	{
-	  tObj0->values = WlzAssignValues(tVal, &errNum);
-	}
-	if(errNum == WLZ_ERR_NONE)
+	int	thrId = 0;
+	WlzErrorNum errNum2;
+
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	errNum2 = WlzAffineTransformValues3Pln(newObj, idP, bBox.zMin + idP,
+					       gVWSp[thrId], invTrans,
+					       interp, gType, bkdV,
+					       cbData, cbFn);
+	if(errNum2 != WLZ_ERR_NONE)
 	{
-	  errNum = WlzInitGreyScan(tObj0, &iWSp, &gWSp);
+#ifdef _OPENMP
+#pragma omp critical (WlzAffineTransformValues3)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
 	}
-	if(errNum == WLZ_ERR_NONE)
-	{
-	  /* Fill in the values of the new 2D object. */
-	  while((errNum == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+      }
+    }
+  }
+  if(gVWSp)
+  {
+    int		idT;
+
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      WlzGreyValueFreeWSp(gVWSp[idT]);
+    }
+    AlcFree(gVWSp);
+  }
+  if(invTrans)
+  {
+    (void )WlzFreeAffineTransform(invTrans);
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return				Error number.
+* \brief	Creates a new 2D value table for a single plane of the
+*		given 3D object, fills in it's values by transforming
+*		the source object's values and then adds it to the
+*		new object's voxel value table. Each plane is independent
+*		of all others, so planes may be filled in concurrently
+*		provided that each uses it's own grey value workspace.
+* \param	newObj			Partialy transformed object with
+*					a valid domain and voxel value table.
+* \param	pIdx			Index of the plane with respect to
+*					the first plane of the new object.
+* \param	pln			Plane coordinate.
+* \param	gVWSp			Grey value workspace for the source
+*					object.
+* \param	invTrans		Inverse of the affine transform.
+* \param	interp			Level of interpolation to use.
+* \param	gType			Grey type of the new values.
+* \param	bkdV			Background value.
+* \param	cbData			Data passed to the directly to
+* 					the callback function.
+* \param	cbFn			Callback function.
+*/
+static WlzErrorNum WlzAffineTransformValues3Pln(WlzObject *newObj,
+					     int pIdx, int pln,
+					     WlzGreyValueWSpace *gVWSp,
+					     WlzAffineTransform *invTrans,
+					     WlzInterpolationType interp,
+					     WlzGreyType gType,
+					     WlzPixelV bkdV,
+					     void *cbData,
+					     WlzAffineTransformCbFn cbFn)
+{
+  int		tI0,
+  		count;
+  double	tD0, x, y, z;
+  double	*vBuf = NULL;
+  WlzIVertex3	dPos;
+  WlzDVertex3	tDV0,
+  		tDV1;
+  WlzVertexP	sBuf;
+  WlzValues	tVal,
+  		emptyValues;
+  WlzObject 	*tObj0 = NULL;
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  double	tMat[3][3];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  sBuf.v = NULL;
+  emptyValues.core = NULL;
+  dPos.vtZ = pln;
+  tMat[0][0] = invTrans->mat[0][0];
+  tMat[1][0] = invTrans->mat[1][0];
+  tMat[2][0] = invTrans->mat[2][0];
+  tMat[0][2] = invTrans->mat[0][3] + (invTrans->mat[0][2] * dPos.vtZ);
+  tMat[1][2] = invTrans->mat[1][3] + (invTrans->mat[1][2] * dPos.vtZ);
+  tMat[2][2] = invTrans->mat[2][3] + (invTrans->mat[2][2] * dPos.vtZ);
+  /* Make a 2D domain object for the plane. */
+  tObj0 = WlzMakeMain(WLZ_2D_DOMAINOBJ,
+      *(newObj->domain.p->domains + pIdx),
+      emptyValues, NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tVal.v = WlzNewValueTb(tObj0,
+			   WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR,
+						 gType, NULL),
+			   bkdV, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tObj0->values = WlzAssignValues(tVal, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && (interp == WLZ_INTERPOLATION_NEAREST))
+  {
+    size_t	width;
+
+    /* Buffers for the source positions and values of an interval. */
+    width = tObj0->domain.i->lastkl - tObj0->domain.i->kol1 + 1;
+    if(((sBuf.i3 = (WlzIVertex3 *)
+		   AlcMalloc(sizeof(WlzIVertex3) * width)) == NULL) ||
+       ((vBuf = (double *)AlcMalloc(sizeof(double) * width)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(tObj0, &iWSp, &gWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Fill in the values of the new 2D object. */
+    while((errNum == WLZ_ERR_NONE) &&
+	((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+    {
+      dPos.vtX = iWSp.lftpos;
+      dPos.vtY = iWSp.linpos;
+      tMat[0][1] = tMat[0][2] + (invTrans->mat[0][1] * dPos.vtY);
+      tMat[1][1] = tMat[1][2] + (invTrans->mat[1][1] * dPos.vtY);
+      tMat[2][1] = tMat[2][2] + (invTrans->mat[2][1] * dPos.vtY);
+      count = iWSp.rgtpos - iWSp.lftpos + 1;
+      switch(interp)
+      {
+	case WLZ_INTERPOLATION_NEAREST:
 	  {
-	    dPos.vtX = iWSp.lftpos;
-	    dPos.vtY = iWSp.linpos;
-	    tMat[0][1] = tMat[0][2] + (invTrans->mat[0][1] * dPos.vtY);
-	    tMat[1][1] = tMat[1][2] + (invTrans->mat[1][1] * dPos.vtY);
-	    tMat[2][1] = tMat[2][2] + (invTrans->mat[2][1] * dPos.vtY);
-	    count = iWSp.rgtpos - iWSp.lftpos + 1;
-	    switch(interp)
+	    int	idK;
+
+	    /* Source coordinates are computed for each voxel rather than
+	     * stepped along the interval so that they are rounded the
+	     * same way for all voxels. The values of the whole interval
+	     * are then got in a single batch, which are exact in a
+	     * double for all grey types. */
+	    for(idK = 0; idK < count; ++idK)
+	    {
+	      x = tMat[0][1] + (tMat[0][0] * dPos.vtX);
+	      y = tMat[1][1] + (tMat[1][0] * dPos.vtX);
+	      z = tMat[2][1] + (tMat[2][0] * dPos.vtX);
+	      sBuf.i3[idK].vtX = (int )x;
+	      sBuf.i3[idK].vtY = (int )y;
+	      sBuf.i3[idK].vtZ = (int )z;
+	      ++(dPos.vtX);
+	    }
+	    errNum = WlzGreyValueGetBatch(gVWSp, WLZ_INTERPOLATION_NEAREST,
+					  WLZ_VERTEX_I3, count, sBuf, vBuf);
+	    if(errNum == WLZ_ERR_NONE)
 	    {
-	      case WLZ_INTERPOLATION_NEAREST:
-		while(count-- > 0)
-		{
-		  sPos.vtX = (int )(tMat[0][1] +
-				    (tMat[0][0] * (double )(dPos.vtX)));
-		  sPos.vtY = (int )(tMat[1][1] +
-				    (tMat[1][0] * (double )(dPos.vtX)));
-		  sPos.vtZ = (int )(tMat[2][1] +
-				    (tMat[2][0] * (double )(dPos.vtX)));
-		  WlzGreyValueGet(gVWSp, (double )(sPos.vtZ),
-				  (double )(sPos.vtY), (double )(sPos.vtX));
-		  switch(gWSp.pixeltype)
+	      switch(gWSp.pixeltype)
+	      {
+		case WLZ_GREY_INT:
+		  for(idK = 0; idK < count; ++idK)
 		  {
-		    case WLZ_GREY_INT:
-		      *(gWSp.u_grintptr.inp)++ = (*(gVWSp->gVal)).inv;
-		      break;
-		    case WLZ_GREY_SHORT:
-		      *(gWSp.u_grintptr.shp)++ = (*(gVWSp->gVal)).shv;
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      *(gWSp.u_grintptr.ubp)++ = (*(gVWSp->gVal)).ubv;
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      *(gWSp.u_grintptr.flp)++ = (*(gVWSp->gVal)).flv;
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      *(gWSp.u_grintptr.dbp)++ = (*(gVWSp->gVal)).dbv;
-		      break;
-		    case WLZ_GREY_RGBA:
-		      *(gWSp.u_grintptr.rgbp)++ = (*(gVWSp->gVal)).rgbv;
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
+		    gWSp.u_grintptr.inp[idK] = (int )(vBuf[idK]);
 		  }
-		  ++(dPos.vtX);
-		}
-		break;
-	      case WLZ_INTERPOLATION_LINEAR:
-		while(count-- > 0)
-		{
-		  x = tMat[0][1] + (tMat[0][0] * dPos.vtX);
-		  y = tMat[1][1] + (tMat[1][0] * dPos.vtX);
-		  z = tMat[2][1] + (tMat[2][0] * dPos.vtX);
-		  WlzGreyValueGetCon(gVWSp, z, y, x);
-		  tDV0.vtX = x - WLZ_NINT(x - 0.5);
-		  tDV0.vtY = y - WLZ_NINT(y - 0.5);
-		  tDV0.vtZ = z - WLZ_NINT(z - 0.5);
-		  tDV1.vtX = 1.0 - tDV0.vtX;
-		  tDV1.vtY = 1.0 - tDV0.vtY;
-		  tDV1.vtZ = 1.0 - tDV0.vtZ;
-		  switch(gWSp.pixeltype)
+		  break;
+		case WLZ_GREY_SHORT:
+		  for(idK = 0; idK < count; ++idK)
+		  {
+		    gWSp.u_grintptr.shp[idK] = (short )(vBuf[idK]);
+		  }
+		  break;
+		case WLZ_GREY_UBYTE:
+		  for(idK = 0; idK < count; ++idK)
+		  {
+		    gWSp.u_grintptr.ubp[idK] = (WlzUByte )(vBuf[idK]);
+		  }
+		  break;
+		case WLZ_GREY_FLOAT:
+		  for(idK = 0; idK < count; ++idK)
 		  {
-		    case WLZ_GREY_INT:
-		      tD0 = ((gVWSp->gVal[0]).inv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).inv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).inv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).inv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).inv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).inv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).inv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).inv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0,
-				      (double )(INT_MIN), (double )(INT_MAX));
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.inp)++ = tI0;
-		      break;
-		    case WLZ_GREY_SHORT:
-		      tD0 = ((gVWSp->gVal[0]).shv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).shv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).shv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).shv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).shv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).shv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).shv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).shv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0,
-				      (double )(SHRT_MIN),
-				      (double )(SHRT_MAX));
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.shp)++ = (short )tI0;
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      tD0 = ((gVWSp->gVal[0]).ubv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).ubv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).ubv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).ubv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).ubv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).ubv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).ubv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).ubv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.ubp)++ = (WlzUByte )tI0;
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      tD0 = ((gVWSp->gVal[0]).flv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).flv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).flv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).flv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).flv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).flv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).flv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).flv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
-		      *(gWSp.u_grintptr.flp)++ = (float )tD0;
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      tD0 = ((gVWSp->gVal[0]).dbv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).dbv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).dbv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).dbv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).dbv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).dbv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).dbv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).dbv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      *(gWSp.u_grintptr.dbp)++ = tD0;
-		      break;
-		    case WLZ_GREY_RGBA:
-		      tD0 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_RED_SET(*(gWSp.u_grintptr.rgbp),
-		                       (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_GREEN_SET(*(gWSp.u_grintptr.rgbp),
-		                         (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_BLUE_SET(*(gWSp.u_grintptr.rgbp),
-		                        (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_ALPHA_SET(*(gWSp.u_grintptr.rgbp), (WlzUByte )tI0);
-		      ++(gWSp.u_grintptr.rgbp);
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
+		    gWSp.u_grintptr.flp[idK] = (float )(vBuf[idK]);
 		  }
-		  ++(dPos.vtX);
-		}
+		  break;
+		case WLZ_GREY_DOUBLE:
+		  for(idK = 0; idK < count; ++idK)
+		  {
+		    gWSp.u_grintptr.dbp[idK] = vBuf[idK];
+		  }
+		  break;
+		case WLZ_GREY_RGBA:
+		  for(idK = 0; idK < count; ++idK)
+		  {
+		    gWSp.u_grintptr.rgbp[idK] = (WlzUInt )(vBuf[idK]);
+		  }
+		  break;
+		default:
+		  errNum = WLZ_ERR_GREY_TYPE;
+		  break;
+	      }
+	    }
+	  }
+	  break;
+	case WLZ_INTERPOLATION_LINEAR:
+	  while(count-- > 0)
+	  {
+	    x = tMat[0][1] + (tMat[0][0] * dPos.vtX);
+	    y = tMat[1][1] + (tMat[1][0] * dPos.vtX);
+	    z = tMat[2][1] + (tMat[2][0] * dPos.vtX);
+	    WlzGreyValueGetCon(gVWSp, z, y, x);
+	    tDV0.vtX = x - WLZ_NINT(x - 0.5);
+	    tDV0.vtY = y - WLZ_NINT(y - 0.5);
+	    tDV0.vtZ = z - WLZ_NINT(z - 0.5);
+	    tDV1.vtX = 1.0 - tDV0.vtX;
+	    tDV1.vtY = 1.0 - tDV0.vtY;
+	    tDV1.vtZ = 1.0 - tDV0.vtZ;
+	    switch(gWSp.pixeltype)
+	    {
+	      case WLZ_GREY_INT:
+		tD0 = ((gVWSp->gVal[0]).inv *
+		    tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[1]).inv *
+		   tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[2]).inv *
+		   tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[3]).inv *
+		   tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[4]).inv *
+		   tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[5]).inv *
+		   tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[6]).inv *
+		   tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[7]).inv *
+		   tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0,
+				(double )(INT_MIN), (double )(INT_MAX));
+		tI0 = WLZ_NINT(tD0);
+		*(gWSp.u_grintptr.inp)++ = tI0;
 		break;
-	      case WLZ_INTERPOLATION_CALLBACK:
-		errNum = (*cbFn)(cbData, &gWSp, gVWSp, invTrans,
-				 dPos.vtZ, dPos.vtY);
+	      case WLZ_GREY_SHORT:
+		tD0 = ((gVWSp->gVal[0]).shv *
+		    tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[1]).shv *
+		   tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[2]).shv *
+		   tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[3]).shv *
+		   tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[4]).shv *
+		   tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[5]).shv *
+		   tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[6]).shv *
+		   tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[7]).shv *
+		   tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0,
+				(double )(SHRT_MIN),
+				(double )(SHRT_MAX));
+		tI0 = WLZ_NINT(tD0);
+		*(gWSp.u_grintptr.shp)++ = (short )tI0;
+		break;
+	      case WLZ_GREY_UBYTE:
+		tD0 = ((gVWSp->gVal[0]).ubv *
+		    tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[1]).ubv *
+		   tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[2]).ubv *
+		   tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[3]).ubv *
+		   tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[4]).ubv *
+		   tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[5]).ubv *
+		   tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[6]).ubv *
+		   tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[7]).ubv *
+		   tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		tI0 = WLZ_NINT(tD0);
+		*(gWSp.u_grintptr.ubp)++ = (WlzUByte )tI0;
+		break;
+	      case WLZ_GREY_FLOAT:
+		tD0 = ((gVWSp->gVal[0]).flv *
+		    tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[1]).flv *
+		   tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[2]).flv *
+		   tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[3]).flv *
+		   tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[4]).flv *
+		   tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[5]).flv *
+		   tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[6]).flv *
+		   tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[7]).flv *
+		   tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
+		*(gWSp.u_grintptr.flp)++ = (float )tD0;
+		break;
+	      case WLZ_GREY_DOUBLE:
+		tD0 = ((gVWSp->gVal[0]).dbv *
+		    tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[1]).dbv *
+		   tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[2]).dbv *
+		   tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[3]).dbv *
+		   tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[4]).dbv *
+		   tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[5]).dbv *
+		   tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[6]).dbv *
+		   tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[7]).dbv *
+		   tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		*(gWSp.u_grintptr.dbp)++ = tD0;
+		break;
+	      case WLZ_GREY_RGBA:
+		tD0 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
+		       tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
+		       tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
+		       tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
+		       tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_RED_GET((gVWSp->gVal[4]).rgbv) *
+		       tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_RED_GET((gVWSp->gVal[5]).rgbv) *
+		       tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_RED_GET((gVWSp->gVal[6]).rgbv) *
+		       tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_RED_GET((gVWSp->gVal[7]).rgbv) *
+		       tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		tI0 = WLZ_NINT(tD0);
+		WLZ_RGBA_RED_SET(*(gWSp.u_grintptr.rgbp),
+				 (WlzUByte )tI0);
+		tD0 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
+		       tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
+		       tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
+		       tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
+		       tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_GREEN_GET((gVWSp->gVal[4]).rgbv) *
+		       tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_GREEN_GET((gVWSp->gVal[5]).rgbv) *
+		       tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_GREEN_GET((gVWSp->gVal[6]).rgbv) *
+		       tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_GREEN_GET((gVWSp->gVal[7]).rgbv) *
+		       tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		tI0 = WLZ_NINT(tD0);
+		WLZ_RGBA_GREEN_SET(*(gWSp.u_grintptr.rgbp),
+				   (WlzUByte )tI0);
+		tD0 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
+		       tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
+		       tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
+		       tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
+		       tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_BLUE_GET((gVWSp->gVal[4]).rgbv) *
+		       tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_BLUE_GET((gVWSp->gVal[5]).rgbv) *
+		       tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_BLUE_GET((gVWSp->gVal[6]).rgbv) *
+		       tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_BLUE_GET((gVWSp->gVal[7]).rgbv) *
+		       tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		tI0 = WLZ_NINT(tD0);
+		WLZ_RGBA_BLUE_SET(*(gWSp.u_grintptr.rgbp),
+				  (WlzUByte )tI0);
+		tD0 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
+		       tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
+		       tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
+		       tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
+		       tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		      (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[4]).rgbv) *
+		       tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[5]).rgbv) *
+		       tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[6]).rgbv) *
+		       tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		      (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[7]).rgbv) *
+		       tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		tI0 = WLZ_NINT(tD0);
+		WLZ_RGBA_ALPHA_SET(*(gWSp.u_grintptr.rgbp), (WlzUByte )tI0);
+		++(gWSp.u_grintptr.rgbp);
 		break;
 	      default:
-		errNum = WLZ_ERR_INTERPOLATION_TYPE;
+		errNum = WLZ_ERR_GREY_TYPE;
 		break;
 	    }
+	    ++(dPos.vtX);
 	  }
-          (void )WlzEndGreyScan(&iWSp, &gWSp);
-	}
-	if(errNum == WLZ_ERR_EOO)
-	{
-	  errNum = WLZ_ERR_NONE;
-	}
-	if(errNum == WLZ_ERR_NONE)
-	{
-	  *(newObj->values.vox->values + idx.vtZ) =
-	    WlzAssignValues(tObj0->values, NULL);
-	}
-	if(tObj0)
-	{
-	  (void )WlzFreeObj(tObj0);
-	}
+	  break;
+	case WLZ_INTERPOLATION_CALLBACK:
+	  errNum = (*cbFn)(cbData, &gWSp, gVWSp, invTrans,
+			   dPos.vtZ, dPos.vtY);
+	  break;
+	default:
+	  errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	  break;
       }
-      ++(idx.vtZ);
-      ++(dPos.vtZ);
     }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
   }
-  WlzGreyValueFreeWSp(gVWSp);
-  if(invTrans)
+  if(errNum == WLZ_ERR_EOO)
   {
-    (void )WlzFreeAffineTransform(invTrans);
+    errNum = WLZ_ERR_NONE;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *(newObj->values.vox->values + pIdx) =
+      WlzAssignValues(tObj0->values, NULL);
+  }
+  if(tObj0)
+  {
+    (void )WlzFreeObj(tObj0);
   }
+  AlcFree(sBuf.v);
+  AlcFree(vBuf);
   return(errNum);
 }
 
@@ -44,7 +44,55 @@ static char _WlzAffineTransformLSq_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
+/*!
+* \ingroup	WlzTransform
+* \brief	Number of vertex pairs accumulated by each block of the
+*		blocked sums used by the least squares functions. The
+*		block size is fixed (rather than depending on the number
+*		of threads) so that the sums, and hence the computed
+*		transforms, are the same for any number of threads.
+*/
+#define WLZ_AFFINETRANSFORMLSQ_BLKSZ	(4096)
+
+/*!
+* \ingroup	WlzTransform
+* \brief	The sums which may be accumulated over vertex pairs by
+*		WlzAffineTransformLSqSums().
+*/
+typedef enum _WlzAffineTransformLSqSumType
+{
+  WLZ_AFFINETRANSFORMLSQ_SUM_GEN2D,	/*!< The 12 sums of the general 2D
+  					     normal equations. */
+  WLZ_AFFINETRANSFORMLSQ_SUM_GEN3D,	/*!< The 22 sums of the general 3D
+  					     normal equations. */
+  WLZ_AFFINETRANSFORMLSQ_SUM_CEN2D,	/*!< The 2D centroids and the sum of
+  					     squared distances (5 sums). */
+  WLZ_AFFINETRANSFORMLSQ_SUM_CEN3D,	/*!< The 3D centroids and the sum of
+  					     squared distances (7 sums). */
+  WLZ_AFFINETRANSFORMLSQ_SUM_TEN2D,	/*!< The 2x2 sum of tensor products
+  					     relative to the centroids. */
+  WLZ_AFFINETRANSFORMLSQ_SUM_TEN3D	/*!< The 3x3 sum of tensor products
+  					     relative to the centroids. */
+} WlzAffineTransformLSqSumType;
 
+static void			WlzAffineTransformLSqSumBlk(
+				  WlzAffineTransformLSqSumType sType,
+				  void *vT,
+				  void *vS,
+				  double *vW,
+				  int i0,
+				  int i1,
+				  void *cen,
+				  double *sums);
+static WlzErrorNum		WlzAffineTransformLSqSums(
+				  WlzAffineTransformLSqSumType sType,
+				  void *vT,
+				  void *vS,
+				  double *vW,
+				  int nV,
+				  void *cen,
+				  int nSums,
+				  double *sums);
 static WlzErrorNum 		WlzAffineTransformLSqLinSysSolve(
 				  AlgMatrix aM,
 				  double *bV,
@@ -542,8 +590,6 @@ WlzAffineTransform *WlzAffineTransformLSqGen2D(WlzDVertex2 *vT,
 				WlzDVertex2 *vS, double *vW, int nV,
 				WlzErrorNum *dstErr)
 {
-  int		idx;
-  double	wSq;
   double	**aA,
 		**trA;
   double	bV[4],
@@ -565,49 +611,16 @@ WlzAffineTransform *WlzAffineTransformLSqGen2D(WlzDVertex2 *vT,
   }
   else
   {
-    /* Initialise the array */
-    for(idx = 0; idx < 12; ++idx)
-    {
-      sums[idx] = 0;
-    }
     /* Accumulate values */
-    if(vW)
+    errNum = WlzAffineTransformLSqSums(WLZ_AFFINETRANSFORMLSQ_SUM_GEN2D,
+				       vT, vS, vW, nV, NULL, 12, sums);
+    if(vW == NULL)
     {
-      for(idx = 0; idx < nV; ++idx)
-      {
-	wSq = vW[idx] * vW[idx];
-	sums[0]  += vS[idx].vtX * vS[idx].vtX * wSq;
-	sums[1]  += vS[idx].vtX * vS[idx].vtY * wSq;
-	sums[2]  += vS[idx].vtX * wSq;
-	sums[3]  += vS[idx].vtY * vS[idx].vtY * wSq;
-	sums[4]  += vS[idx].vtY * wSq;
-	sums[5]  += wSq;
-	sums[6]  += vS[idx].vtX * vT[idx].vtX * wSq;
-	sums[7]  += vS[idx].vtY * vT[idx].vtX * wSq;
-	sums[8]  += vT[idx].vtX * wSq;
-	sums[9]  += vS[idx].vtX * vT[idx].vtY * wSq;
-	sums[10] += vS[idx].vtY * vT[idx].vtY * wSq;
-	sums[11] += vT[idx].vtY * wSq;
-      }
-    }
-    else
-    {
-      sums[5]  = (double )nV;
-      for(idx = 0; idx < nV; ++idx)
-      {
-	sums[0]  += vS[idx].vtX * vS[idx].vtX;
-	sums[1]  += vS[idx].vtX * vS[idx].vtY;
-	sums[2]  += vS[idx].vtX;
-	sums[3]  += vS[idx].vtY * vS[idx].vtY;
-	sums[4]  += vS[idx].vtY;
-	sums[6]  += vS[idx].vtX * vT[idx].vtX;
-	sums[7]  += vS[idx].vtY * vT[idx].vtX;
-	sums[8]  += vT[idx].vtX;
-	sums[9]  += vS[idx].vtX * vT[idx].vtY;
-	sums[10] += vS[idx].vtY * vT[idx].vtY;
-	sums[11] += vT[idx].vtY;
-      }
+      sums[5] = (double )nV;
     }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
     /* Allocate workspace */
     if(((aM.rect = AlgMatrixRectNew(3, 3, NULL)) == NULL) ||
        ((trM.rect = AlgMatrixRectNew(4, 4, NULL)) == NULL))
@@ -741,8 +754,6 @@ WlzAffineTransform *WlzAffineTransformLSqGen3D(WlzDVertex3 *vT,
 				WlzDVertex3 *vS, double *vW, int nV,
 				WlzErrorNum *dstErr)
 {
-  int		idx;
-  double	wSq;
   double	**aA = NULL,
 		**trA = NULL;
   double	bV[4],
@@ -765,70 +776,16 @@ WlzAffineTransform *WlzAffineTransformLSqGen3D(WlzDVertex3 *vT,
   }
   else
   {
-    /* Initialise the array */
-    for(idx = 0; idx < 22; ++idx)
-    {
-      sums[idx] = 0;
-    }
     /* Accumulate values */
-    if(vW)
-    {
-      for(idx = 0; idx < nV; ++idx)
-      {
-	wSq = vW[idx] * vW[idx];
-	sums[0]  += vS[idx].vtX * vS[idx].vtX * wSq;
-	sums[1]  += vS[idx].vtX * vS[idx].vtY * wSq;
-	sums[2]  += vS[idx].vtX * vS[idx].vtZ * wSq;
-	sums[3]  += vS[idx].vtX * wSq;
-	sums[4]  += vS[idx].vtY * vS[idx].vtY * wSq;
-	sums[5]  += vS[idx].vtY * vS[idx].vtZ * wSq;
-	sums[6]  += vS[idx].vtY * wSq;
-	sums[7]  += vS[idx].vtZ * vS[idx].vtZ * wSq;
-	sums[8]  += vS[idx].vtZ * wSq;
-	sums[9]  += wSq;
-	sums[10] += vS[idx].vtX * vT[idx].vtX * wSq;
-	sums[11] += vS[idx].vtY * vT[idx].vtX * wSq;
-	sums[12] += vS[idx].vtZ * vT[idx].vtX * wSq;
-	sums[13] += vT[idx].vtX * wSq;
-	sums[14]  += vS[idx].vtX * vT[idx].vtY * wSq;
-	sums[15]  += vS[idx].vtY * vT[idx].vtY * wSq;
-	sums[16]  += vS[idx].vtZ * vT[idx].vtY * wSq;
-	sums[17]  += vT[idx].vtY * wSq;
-	sums[18]  += vS[idx].vtX * vT[idx].vtZ * wSq;
-	sums[19]  += vS[idx].vtY * vT[idx].vtZ * wSq;
-	sums[20]  += vS[idx].vtZ * vT[idx].vtZ * wSq;
-	sums[21]  += vT[idx].vtZ * wSq;
-
-      }
-    }
-    else
+    errNum = WlzAffineTransformLSqSums(WLZ_AFFINETRANSFORMLSQ_SUM_GEN3D,
+				       vT, vS, vW, nV, NULL, 22, sums);
+    if(vW == NULL)
     {
-      sums[9]  = (double )nV;
-      for(idx = 0; idx < nV; ++idx)
-      {
-	sums[0]  += vS[idx].vtX * vS[idx].vtX;
-	sums[1]  += vS[idx].vtX * vS[idx].vtY;
-	sums[2]  += vS[idx].vtX * vS[idx].vtZ;
-	sums[3]  += vS[idx].vtX;
-	sums[4]  += vS[idx].vtY * vS[idx].vtY;
-	sums[5]  += vS[idx].vtY * vS[idx].vtZ;
-	sums[6]  += vS[idx].vtY;
-	sums[7]  += vS[idx].vtZ * vS[idx].vtZ;
-	sums[8]  += vS[idx].vtZ;
-	sums[10] += vS[idx].vtX * vT[idx].vtX;
-	sums[11] += vS[idx].vtY * vT[idx].vtX;
-	sums[12] += vS[idx].vtZ * vT[idx].vtX;
-	sums[13] += vT[idx].vtX;
-	sums[14] += vS[idx].vtX * vT[idx].vtY;
-	sums[15] += vS[idx].vtY * vT[idx].vtY;
-	sums[16] += vS[idx].vtZ * vT[idx].vtY;
-	sums[17] += vT[idx].vtY;
-	sums[18] += vS[idx].vtX * vT[idx].vtZ;
-	sums[19] += vS[idx].vtY * vT[idx].vtZ;
-	sums[20] += vS[idx].vtZ * vT[idx].vtZ;
-	sums[21] += vT[idx].vtZ;
-      }
+      sums[9] = (double )nV;
     }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
     /* Allocate workspace */
     if(((aM.rect = AlgMatrixRectNew(4, 4, NULL)) == NULL) ||
        ((trM.rect = AlgMatrixRectNew(4, 4, NULL)) == NULL))
@@ -944,16 +901,13 @@ WlzAffineTransform *WlzAffineTransformLSqReg2D(WlzDVertex2 *vT,
 		    		WlzDVertex2 *vS, double *vW, int nVtx,
 				WlzErrorNum *dstErr)
 {
-  int		tI0,
-  		idN;
+  int		tI0;
   double	tD0,
   		meanSqD;
-  WlzDVertex2	p0,
-  		p1,
-		cen0,
-  		cen1,
-		rel0,
-		rel1;
+  WlzDVertex2	cen0,
+  		cen1;
+  WlzDVertex2	cen[2];
+  double	sums[5];
   double	wV[2];
   double	**hA,
 		**vA,
@@ -978,37 +932,16 @@ WlzAffineTransform *WlzAffineTransformLSqReg2D(WlzDVertex2 *vT,
     vA = vM.rect->array;
     /* Compute weighted centroids (cen0 and cen1) and a mean of squares of
      * distance * between the weighted vertices. */
-    if(vW)
-    {
-      WLZ_VTX_2_SCALE(p0, *vT, *vW);
-      WLZ_VTX_2_SCALE(p1, *vS, *vW);
-    }
-    else
-    {
-      p0 = *vT;
-      p1 = *vS;
-    }
-    cen0 = p0;
-    cen1 = p1;
-    WLZ_VTX_2_SUB(rel0, p0, p1);
-    meanSqD = WLZ_VTX_2_DOT(rel0, rel0);
-    for(idN = 1; idN < nVtx; ++idN)
-    {
-      if(vW)
-      {
-	WLZ_VTX_2_SCALE(p0, *(vT + idN), *(vW + idN));
-	WLZ_VTX_2_SCALE(p1, *(vS + idN), *(vW + idN));
-      }
-      else
-      {
-        p0 = *(vT + idN);
-	p1 = *(vS + idN);
-      }
-      WLZ_VTX_2_ADD(cen0, cen0, p0);
-      WLZ_VTX_2_ADD(cen1, cen1, p1);
-      WLZ_VTX_2_SUB(rel0, p0, p1);
-      meanSqD += WLZ_VTX_2_DOT(rel0, rel0);
-    }
+    errNum = WlzAffineTransformLSqSums(WLZ_AFFINETRANSFORMLSQ_SUM_CEN2D,
+				       vT, vS, vW, nVtx, NULL, 5, sums);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    cen0.vtX = sums[0];
+    cen0.vtY = sums[1];
+    cen1.vtX = sums[2];
+    cen1.vtY = sums[3];
+    meanSqD = sums[4];
     tD0 = 1.0 / nVtx;
     meanSqD *= tD0;
     if(meanSqD < tol)
@@ -1022,25 +955,17 @@ WlzAffineTransform *WlzAffineTransformLSqReg2D(WlzDVertex2 *vT,
       WLZ_VTX_2_SCALE(cen1, cen1, tD0);
       /* Compute the 2x2 matrix hM, which is the sum of tensor products of
        * the weighted vertices relative to their centroids. */
-      for(idN = 0; idN < nVtx; ++idN)
-      {
-	if(vW)
-	{
-	  WLZ_VTX_2_SCALE(p0, *(vT + idN), *(vW + idN));
-	  WLZ_VTX_2_SCALE(p1, *(vS + idN), *(vW + idN));
-	}
-	else
-	{
-	  p0 = *(vT + idN);
-	  p1 = *(vS + idN);
-	}
-	WLZ_VTX_2_SUB(rel0, p0, cen0);
-	WLZ_VTX_2_SUB(rel1, p1, cen1);
-	hA[0][0] += rel0.vtX * rel1.vtX;
-	hA[0][1] += rel0.vtX * rel1.vtY;
-	hA[1][0] += rel0.vtY * rel1.vtX;
-	hA[1][1] += rel0.vtY * rel1.vtY;
-      }
+      cen[0] = cen0;
+      cen[1] = cen1;
+      errNum = WlzAffineTransformLSqSums(WLZ_AFFINETRANSFORMLSQ_SUM_TEN2D,
+					 vT, vS, vW, nVtx, cen, 4, sums);
+    }
+    if((errNum == WLZ_ERR_NONE) && (tr == NULL))
+    {
+      hA[0][0] = sums[0];
+      hA[0][1] = sums[1];
+      hA[1][0] = sums[2];
+      hA[1][1] = sums[3];
       /* Compute the SVD of the 2x2 matrix, hM = hM.wV.vM. */
       errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(hM, wV, vM));
       if(errNum == WLZ_ERR_NONE)
@@ -1258,17 +1183,14 @@ WlzAffineTransform  *WlzAffineTransformLSqReg3D(WlzDVertex3 *vT,
 				WlzErrorNum *dstErr)
 {
   int		tI0,
-  		idN,
   		idK,
 		idR;
   double	tD0,
   		meanSqD;
-  WlzDVertex3	p0,
-  		p1,
-		cen0,
-  		cen1,
-		rel0,
-		rel1;
+  WlzDVertex3	cen0,
+  		cen1;
+  WlzDVertex3	cen[2];
+  double	sums[9];
   double	*wV = NULL;
   double	**hA,
 		**vA,
@@ -1293,37 +1215,18 @@ WlzAffineTransform  *WlzAffineTransformLSqReg3D(WlzDVertex3 *vT,
     vA = vM.rect->array;
     /* Compute weighted centroids (cen0 and cen1) and a mean of squares of
      * distance * between the weighted vertices. */
-    if(vW)
-    {
-      WLZ_VTX_3_SCALE(p0, *vT, *vW);
-      WLZ_VTX_3_SCALE(p1, *vS, *vW);
-    }
-    else
-    {
-      p0 = *vT;
-      p1 = *vS;
-    }
-    cen0 = p0;
-    cen1 = p1;
-    WLZ_VTX_3_SUB(rel0, p0, p1);
-    meanSqD = WLZ_VTX_3_DOT(rel0, rel0);
-    for(idN = 1; idN < nV; ++idN)
-    {
-      if(vW)
-      {
-	WLZ_VTX_3_SCALE(p0, *(vT + idN), *(vW + idN));
-	WLZ_VTX_3_SCALE(p1, *(vS + idN), *(vW + idN));
-      }
-      else
-      {
-        p0 = *(vT + idN);
-	p1 = *(vS + idN);
-      }
-      WLZ_VTX_3_ADD(cen0, cen0, p0);
-      WLZ_VTX_3_ADD(cen1, cen1, p1);
-      WLZ_VTX_3_SUB(rel0, p0, p1);
-      meanSqD += WLZ_VTX_3_DOT(rel0, rel0);
-    }
+    errNum = WlzAffineTransformLSqSums(WLZ_AFFINETRANSFORMLSQ_SUM_CEN3D,
+				       vT, vS, vW, nV, NULL, 7, sums);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    cen0.vtX = sums[0];
+    cen0.vtY = sums[1];
+    cen0.vtZ = sums[2];
+    cen1.vtX = sums[3];
+    cen1.vtY = sums[4];
+    cen1.vtZ = sums[5];
+    meanSqD = sums[6];
     tD0 = 1.0 / nV;
     meanSqD *= tD0;
     if(meanSqD < tol)
@@ -1337,30 +1240,22 @@ WlzAffineTransform  *WlzAffineTransformLSqReg3D(WlzDVertex3 *vT,
       WLZ_VTX_3_SCALE(cen1, cen1, tD0);
       /* Compute the 3x3 matrix hM, which is the sum of tensor products of
        * the weighted vertices relative to their centroids. */
-      for(idN = 0; idN < nV; ++idN)
-      {
-	if(vW)
-	{
-	  WLZ_VTX_3_SCALE(p0, *(vT + idN), *(vW + idN));
-	  WLZ_VTX_3_SCALE(p1, *(vS + idN), *(vW + idN));
-	}
-	else
-	{
-	  p0 = *(vT + idN);
-	  p1 = *(vS + idN);
-	}
-	WLZ_VTX_3_SUB(rel0, p0, cen0);
-	WLZ_VTX_3_SUB(rel1, p1, cen1);
-	hA[0][0] += rel0.vtX * rel1.vtX;
-	hA[0][1] += rel0.vtX * rel1.vtY;
-	hA[0][2] += rel0.vtX * rel1.vtZ;
-	hA[1][0] += rel0.vtY * rel1.vtX;
-	hA[1][1] += rel0.vtY * rel1.vtY;
-	hA[1][2] += rel0.vtY * rel1.vtZ;
-	hA[2][0] += rel0.vtZ * rel1.vtX;
-	hA[2][1] += rel0.vtZ * rel1.vtY;
-	hA[2][2] += rel0.vtZ * rel1.vtZ;
-      }
+      cen[0] = cen0;
+      cen[1] = cen1;
+      errNum = WlzAffineTransformLSqSums(WLZ_AFFINETRANSFORMLSQ_SUM_TEN3D,
+					 vT, vS, vW, nV, cen, 9, sums);
+    }
+    if((errNum == WLZ_ERR_NONE) && (tr == NULL))
+    {
+      hA[0][0] = sums[0];
+      hA[0][1] = sums[1];
+      hA[0][2] = sums[2];
+      hA[1][0] = sums[3];
+      hA[1][1] = sums[4];
+      hA[1][2] = sums[5];
+      hA[2][0] = sums[6];
+      hA[2][1] = sums[7];
+      hA[2][2] = sums[8];
       /* Compute the SVD of the 3x3 matrix, hM = hM.wV.vM. */
       errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(hM, wV, vM));
       if(errNum == WLZ_ERR_NONE)
@@ -2151,3 +2046,261 @@ static WlzErrorNum WlzAffineTransformLSqLinSysSolve(AlgMatrix aM,
   AlgMatrixFree(wCM);
   return(errNum);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Accumulates sums over the given vertex pairs for the
+*		least squares functions. The vertex pairs are split into
+*		blocks of WLZ_AFFINETRANSFORMLSQ_BLKSZ which may be
+*		accumulated in parallel, with the block sums then added
+*		in block order. Because the blocks do not depend on the
+*		number of threads the sums are deterministic.
+* \param	sType			Type of sums to accumulate.
+* \param	vT			Target vertices, either WlzDVertex2
+*					or WlzDVertex3 to match the sum type.
+* \param	vS			Source vertices, of the same type
+*					as the target vertices.
+* \param	vW			Vertex pair weights, may be NULL.
+* \param	nV			Number of vertex pairs.
+* \param	cen			Target and source centroids (two
+*					vertices) for the tensor sums,
+*					otherwise unused.
+* \param	nSums			Number of sums for the sum type.
+* \param	sums			Destination for the sums.
+*/
+static WlzErrorNum WlzAffineTransformLSqSums(
+				WlzAffineTransformLSqSumType sType,
+				void *vT, void *vS, double *vW, int nV,
+				void *cen, int nSums, double *sums)
+{
+  int		idB,
+  		idS,
+		nBlk;
+  double	*blkSums = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(idS = 0; idS < nSums; ++idS)
+  {
+    sums[idS] = 0.0;
+  }
+  nBlk = (nV + WLZ_AFFINETRANSFORMLSQ_BLKSZ - 1) /
+         WLZ_AFFINETRANSFORMLSQ_BLKSZ;
+  if(nBlk <= 1)
+  {
+    WlzAffineTransformLSqSumBlk(sType, vT, vS, vW, 0, nV, cen, sums);
+  }
+  else if((blkSums = (double *)
+                     AlcCalloc(nBlk * nSums, sizeof(double))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      int	i0,
+      		i1;
+
+      i0 = idB * WLZ_AFFINETRANSFORMLSQ_BLKSZ;
+      i1 = ALG_MIN(i0 + WLZ_AFFINETRANSFORMLSQ_BLKSZ, nV);
+      WlzAffineTransformLSqSumBlk(sType, vT, vS, vW, i0, i1, cen,
+                                  blkSums + (idB * nSums));
+    }
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      double	*bS;
+
+      bS = blkSums + (idB * nSums);
+      for(idS = 0; idS < nSums; ++idS)
+      {
+        sums[idS] += bS[idS];
+      }
+    }
+    AlcFree(blkSums);
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \brief	Accumulates the sums of the given type over the vertex
+*		pairs with indices in the range [i0, i1) into the given
+*		zeroed sums. See WlzAffineTransformLSqSums().
+* \param	sType			Type of sums to accumulate.
+* \param	vT			Target vertices.
+* \param	vS			Source vertices.
+* \param	vW			Vertex pair weights, may be NULL.
+* \param	i0			First vertex pair index.
+* \param	i1			One past the last vertex pair index.
+* \param	cen			Target and source centroids for the
+*					tensor sums.
+* \param	sums			Sums to accumulate into.
+*/
+static void	WlzAffineTransformLSqSumBlk(WlzAffineTransformLSqSumType sType,
+				void *vT, void *vS, double *vW,
+				int i0, int i1, void *cen, double *sums)
+{
+  int		idx;
+  double	wSq;
+  WlzDVertex2	p0,
+		p1,
+		*vT2,
+		*vS2,
+		*cen2;
+  WlzDVertex3	q0,
+		q1,
+		*vT3,
+		*vS3,
+		*cen3;
+
+  vT2 = (WlzDVertex2 *)vT;
+  vS2 = (WlzDVertex2 *)vS;
+  cen2 = (WlzDVertex2 *)cen;
+  vT3 = (WlzDVertex3 *)vT;
+  vS3 = (WlzDVertex3 *)vS;
+  cen3 = (WlzDVertex3 *)cen;
+  switch(sType)
+  {
+    case WLZ_AFFINETRANSFORMLSQ_SUM_GEN2D:
+      for(idx = i0; idx < i1; ++idx)
+      {
+	wSq = (vW)? vW[idx] * vW[idx]: 1.0;
+	sums[0]  += vS2[idx].vtX * vS2[idx].vtX * wSq;
+	sums[1]  += vS2[idx].vtX * vS2[idx].vtY * wSq;
+	sums[2]  += vS2[idx].vtX * wSq;
+	sums[3]  += vS2[idx].vtY * vS2[idx].vtY * wSq;
+	sums[4]  += vS2[idx].vtY * wSq;
+	sums[5]  += wSq;
+	sums[6]  += vS2[idx].vtX * vT2[idx].vtX * wSq;
+	sums[7]  += vS2[idx].vtY * vT2[idx].vtX * wSq;
+	sums[8]  += vT2[idx].vtX * wSq;
+	sums[9]  += vS2[idx].vtX * vT2[idx].vtY * wSq;
+	sums[10] += vS2[idx].vtY * vT2[idx].vtY * wSq;
+	sums[11] += vT2[idx].vtY * wSq;
+      }
+      break;
+    case WLZ_AFFINETRANSFORMLSQ_SUM_GEN3D:
+      for(idx = i0; idx < i1; ++idx)
+      {
+	wSq = (vW)? vW[idx] * vW[idx]: 1.0;
+	sums[0]  += vS3[idx].vtX * vS3[idx].vtX * wSq;
+	sums[1]  += vS3[idx].vtX * vS3[idx].vtY * wSq;
+	sums[2]  += vS3[idx].vtX * vS3[idx].vtZ * wSq;
+	sums[3]  += vS3[idx].vtX * wSq;
+	sums[4]  += vS3[idx].vtY * vS3[idx].vtY * wSq;
+	sums[5]  += vS3[idx].vtY * vS3[idx].vtZ * wSq;
+	sums[6]  += vS3[idx].vtY * wSq;
+	sums[7]  += vS3[idx].vtZ * vS3[idx].vtZ * wSq;
+	sums[8]  += vS3[idx].vtZ * wSq;
+	sums[9]  += wSq;
+	sums[10] += vS3[idx].vtX * vT3[idx].vtX * wSq;
+	sums[11] += vS3[idx].vtY * vT3[idx].vtX * wSq;
+	sums[12] += vS3[idx].vtZ * vT3[idx].vtX * wSq;
+	sums[13] += vT3[idx].vtX * wSq;
+	sums[14] += vS3[idx].vtX * vT3[idx].vtY * wSq;
+	sums[15] += vS3[idx].vtY * vT3[idx].vtY * wSq;
+	sums[16] += vS3[idx].vtZ * vT3[idx].vtY * wSq;
+	sums[17] += vT3[idx].vtY * wSq;
+	sums[18] += vS3[idx].vtX * vT3[idx].vtZ * wSq;
+	sums[19] += vS3[idx].vtY * vT3[idx].vtZ * wSq;
+	sums[20] += vS3[idx].vtZ * vT3[idx].vtZ * wSq;
+	sums[21] += vT3[idx].vtZ * wSq;
+      }
+      break;
+    case WLZ_AFFINETRANSFORMLSQ_SUM_CEN2D:
+      for(idx = i0; idx < i1; ++idx)
+      {
+	if(vW)
+	{
+	  WLZ_VTX_2_SCALE(p0, vT2[idx], vW[idx]);
+	  WLZ_VTX_2_SCALE(p1, vS2[idx], vW[idx]);
+	}
+	else
+	{
+	  p0 = vT2[idx];
+	  p1 = vS2[idx];
+	}
+	sums[0] += p0.vtX;
+	sums[1] += p0.vtY;
+	sums[2] += p1.vtX;
+	sums[3] += p1.vtY;
+	WLZ_VTX_2_SUB(p0, p0, p1);
+	sums[4] += WLZ_VTX_2_DOT(p0, p0);
+      }
+      break;
+    case WLZ_AFFINETRANSFORMLSQ_SUM_CEN3D:
+      for(idx = i0; idx < i1; ++idx)
+      {
+	if(vW)
+	{
+	  WLZ_VTX_3_SCALE(q0, vT3[idx], vW[idx]);
+	  WLZ_VTX_3_SCALE(q1, vS3[idx], vW[idx]);
+	}
+	else
+	{
+	  q0 = vT3[idx];
+	  q1 = vS3[idx];
+	}
+	sums[0] += q0.vtX;
+	sums[1] += q0.vtY;
+	sums[2] += q0.vtZ;
+	sums[3] += q1.vtX;
+	sums[4] += q1.vtY;
+	sums[5] += q1.vtZ;
+	WLZ_VTX_3_SUB(q0, q0, q1);
+	sums[6] += WLZ_VTX_3_DOT(q0, q0);
+      }
+      break;
+    case WLZ_AFFINETRANSFORMLSQ_SUM_TEN2D:
+      for(idx = i0; idx < i1; ++idx)
+      {
+	if(vW)
+	{
+	  WLZ_VTX_2_SCALE(p0, vT2[idx], vW[idx]);
+	  WLZ_VTX_2_SCALE(p1, vS2[idx], vW[idx]);
+	}
+	else
+	{
+	  p0 = vT2[idx];
+	  p1 = vS2[idx];
+	}
+	WLZ_VTX_2_SUB(p0, p0, cen2[0]);
+	WLZ_VTX_2_SUB(p1, p1, cen2[1]);
+	sums[0] += p0.vtX * p1.vtX;
+	sums[1] += p0.vtX * p1.vtY;
+	sums[2] += p0.vtY * p1.vtX;
+	sums[3] += p0.vtY * p1.vtY;
+      }
+      break;
+    case WLZ_AFFINETRANSFORMLSQ_SUM_TEN3D:
+      for(idx = i0; idx < i1; ++idx)
+      {
+	if(vW)
+	{
+	  WLZ_VTX_3_SCALE(q0, vT3[idx], vW[idx]);
+	  WLZ_VTX_3_SCALE(q1, vS3[idx], vW[idx]);
+	}
+	else
+	{
+	  q0 = vT3[idx];
+	  q1 = vS3[idx];
+	}
+	WLZ_VTX_3_SUB(q0, q0, cen3[0]);
+	WLZ_VTX_3_SUB(q1, q1, cen3[1]);
+	sums[0] += q0.vtX * q1.vtX;
+	sums[1] += q0.vtX * q1.vtY;
+	sums[2] += q0.vtX * q1.vtZ;
+	sums[3] += q0.vtY * q1.vtX;
+	sums[4] += q0.vtY * q1.vtY;
+	sums[5] += q0.vtY * q1.vtZ;
+	sums[6] += q0.vtZ * q1.vtX;
+	sums[7] += q0.vtZ * q1.vtY;
+	sums[8] += q0.vtZ * q1.vtZ;
+      }
+      break;
+  }
+}
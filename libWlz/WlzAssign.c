@@ -44,6 +44,21 @@ static char _WlzAssign_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+/* Linkcounts are changed using atomic compare and swap operations when
+ * the compiler supports them, which avoids serialising all assignments
+ * and frees on a single OpenMP critical section. Otherwise the
+ * WlzLinkcount critical section is used. */
+#if defined(__GNUC__) || defined(__clang__)
+#define WLZ_LINKCOUNT_ATOMIC
+#define WLZ_LINKCOUNT_LOAD(P)	__atomic_load_n((P), __ATOMIC_RELAXED)
+#define WLZ_LINKCOUNT_CAS(P,O,N) \
+		__atomic_compare_exchange_n((P), (O), (N), 1, \
+		                            __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+#endif
+
+static WlzErrorNum		WlzLinkcountIncr(
+				  int *linkcount);
+
 /*!
 * \return	Given object with incremented linkcount or NULL on error.
 * \ingroup	WlzAllocation
@@ -61,22 +76,11 @@ WlzObject	*WlzAssignObject(WlzObject *obj, WlzErrorNum *dstErr)
 
   if(obj)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(obj->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(obj->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	rtnObj = obj;
-	obj->linkcount++;
-      }
-#ifdef _OPENMP
+      rtnObj = obj;
     }
-#endif
   }
 #ifdef WLZ_NO_NULL
   else
@@ -123,22 +127,11 @@ WlzDomain 	WlzAssignDomain(WlzDomain domain, WlzErrorNum *dstErr)
   rtnDomain.core = NULL;
   if(domain.core)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(domain.core->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(domain.core->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	rtnDomain = domain;
-	domain.core->linkcount++;
-      }
-#ifdef _OPENMP
+      rtnDomain = domain;
     }
-#endif
   }
 #ifdef WLZ_NO_NULL
   else
@@ -168,24 +161,11 @@ WlzValues 	WlzAssignValues(WlzValues values, WlzErrorNum	*dstErr)
   rtnValues.core = NULL;
   if(values.core)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(values.core->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(values.core->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	rtnValues = values;
-	{
-	  values.core->linkcount++;
-	}
-      }
-#ifdef _OPENMP
+      rtnValues = values;
     }
-#endif
   }
 #ifdef WLZ_NO_NULL
   else
@@ -216,22 +196,11 @@ WlzProperty WlzAssignProperty(WlzProperty property, WlzErrorNum *dstErr)
   rtnProp.core = NULL;
   if(property.core)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(property.core->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(property.core->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	rtnProp = property;
-	property.core->linkcount++;
-      }
-#ifdef _OPENMP
+      rtnProp = property;
     }
-#endif
   }
 #ifdef WLZ_NO_NULL
   else
@@ -261,24 +230,11 @@ WlzPropertyList *WlzAssignPropertyList(WlzPropertyList *pList,
 
   if(pList)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(pList->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(pList->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	rtnPList = pList;
-	{
-	  pList->linkcount++;
-	}
-      }
-#ifdef _OPENMP
+      rtnPList = pList;
     }
-#endif
   }
 #ifdef WLZ_NO_NULL
   else
@@ -310,24 +266,11 @@ WlzAffineTransform *WlzAssignAffineTransform(
 
   if(trans)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(trans->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(trans->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	rtnTrans = trans;
-	{
-	  ++(trans->linkcount);
-	}
-      }
-#ifdef _OPENMP
+      rtnTrans = trans;
     }
-#endif
   }
 #ifdef WLZ_NO_NULL
   else
@@ -358,24 +301,11 @@ WlzTransform 	WlzAssignTransform(WlzTransform t, WlzErrorNum *dstErr)
   tR.core = NULL;
   if(t.core)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(t.core->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(t.core->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	{
-	  ++(t.core->linkcount);
-	}
-	tR = t;
-      }
-#ifdef _OPENMP
+      tR = t;
     }
-#endif
   }
   if(dstErr)
   {
@@ -401,24 +331,11 @@ WlzThreeDViewStruct *WlzAssign3DViewStruct(
 
   if( viewStr )
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(viewStr->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(viewStr->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	rtnViewStr = viewStr;
-	{
-	  ++(viewStr->linkcount);
-	}
-      }
-#ifdef _OPENMP
+      rtnViewStr = viewStr;
     }
-#endif
   }
 #ifdef WLZ_NO_NULL
   else
@@ -448,24 +365,11 @@ WlzBoundList 	*WlzAssignBoundList(WlzBoundList *blist, WlzErrorNum *dstErr)
 
   if(blist)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(blist->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(blist->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	rtnBlist = blist;
-	{
-	  ++(blist->linkcount);
-	}
-      }
-#ifdef _OPENMP
+      rtnBlist = blist;
     }
-#endif
   }
 #ifdef WLZ_NO_NULL
   else
@@ -497,24 +401,11 @@ WlzPolygonDomain *WlzAssignPolygonDomain(
 
   if(poly)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(poly->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(poly->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	rtnPoly = poly;
-	{
-	  ++(poly->linkcount);
-	}
-      }
-#ifdef _OPENMP
+      rtnPoly = poly;
     }
-#endif
   }
 #ifdef WLZ_NO_NULL
   else
@@ -544,24 +435,11 @@ WlzGMModel 	*WlzAssignGMModel(WlzGMModel *model, WlzErrorNum *dstErr)
 
   if(model)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    errNum = WlzLinkcountIncr(&(model->linkcount));
+    if(errNum == WLZ_ERR_NONE)
     {
-#endif
-      if(model->linkcount < 0)
-      {
-	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
-	rtnModel = model;
-	{
-	  ++(model->linkcount);
-	}
-      }
-#ifdef _OPENMP
+      rtnModel = model;
     }
-#endif
   }
   if(dstErr)
   {
@@ -583,12 +461,36 @@ int		WlzUnlink(int *linkcount, WlzErrorNum *dstErr)
   int		canFree = 0;
   WlzErrorNum	errNum = WLZ_ERR_PARAM_NULL;
 
+  if(linkcount)
+  {
+#ifdef WLZ_LINKCOUNT_ATOMIC
+    int		lc0,
+    		lc1;
+
+    lc1 = 0;
+    lc0 = WLZ_LINKCOUNT_LOAD(linkcount);
+    do
+    {
+      if(lc0 < 0)
+      {
+	break;
+      }
+      lc1 = (lc0 <= 1)? -1: lc0 - 1;
+    } while(!WLZ_LINKCOUNT_CAS(linkcount, &lc0, lc1));
+    if(lc0 < 0)
+    {
+      errNum = WLZ_ERR_LINKCOUNT_DATA;
+    }
+    else
+    {
+      errNum = WLZ_ERR_NONE;
+      canFree = lc1 < 0;
+    }
+#else
 #ifdef _OPENMP
 #pragma omp critical (WlzLinkcount)
-  {
-#endif
-    if(linkcount)
     {
+#endif
       if(*linkcount < 0)
       {
 	errNum = WLZ_ERR_LINKCOUNT_DATA;
@@ -602,13 +504,58 @@ int		WlzUnlink(int *linkcount, WlzErrorNum *dstErr)
 	  canFree = 1;
 	}
       }
-    }
 #ifdef _OPENMP
-  }
+    }
 #endif
+#endif
+  }
   if(dstErr)
   {
     *dstErr = errNum;
   }
   return(canFree);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzAllocation
+* \brief	Increments the given linkcount unless it is negative, in
+*		which case the linkcount is not changed and an error is
+*		returned.
+* \param	linkcount		Given linkcount pointer.
+*/
+static WlzErrorNum WlzLinkcountIncr(int *linkcount)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+#ifdef WLZ_LINKCOUNT_ATOMIC
+  int		lc0;
+
+  lc0 = WLZ_LINKCOUNT_LOAD(linkcount);
+  do
+  {
+    if(lc0 < 0)
+    {
+      errNum = WLZ_ERR_LINKCOUNT_DATA;
+      break;
+    }
+  } while(!WLZ_LINKCOUNT_CAS(linkcount, &lc0, lc0 + 1));
+#else
+#ifdef _OPENMP
+#pragma omp critical (WlzLinkcount)
+  {
+#endif
+    if(*linkcount < 0)
+    {
+      errNum = WLZ_ERR_LINKCOUNT_DATA;
+    }
+    else
+    {
+      ++*linkcount;
+    }
+#ifdef _OPENMP
+  }
+#endif
+#endif
+  return(errNum);
+}
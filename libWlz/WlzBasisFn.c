@@ -60,6 +60,33 @@ typedef struct	_WlzBasisFnMapData3D
   WlzCMeshNod3D *nod[4];
 } WlzBasisFnMapData3D;
 
+#define WLZ_BASISFN_BATCH_MINVTX	(32)
+#define WLZ_BASISFN_BATCH_NPROBE	(1024)
+#define WLZ_BASISFN_BATCH_MINPOS	(16 * WLZ_BASISFN_BATCH_NPROBE)
+
+/*!
+* \struct	_WlzBasisFnCS3DGrid
+* \ingroup	WlzFunction
+* \brief	Regular grid of cells used to find the control points within
+* 		the support of a 3D compactly supported basis function.
+* 		The grid is allocated in a single block and is followed
+* 		by an array of nCell + 1 cell offsets and then an array of
+* 		nPts control point indices, so that the indices of the
+* 		control points in cell i are at [off[i], off[i + 1]).
+* 		The cell size is never less than the support radius so
+* 		that only the 3x3x3 cells about a position need be
+* 		searched.
+*/
+typedef struct _WlzBasisFnCS3DGrid
+{
+  double	support;		/*!< Support radius. */
+  double	cellSz;			/*!< Cell size. */
+  WlzDVertex3	org;			/*!< Origin of the grid. */
+  WlzIVertex3	nCell;			/*!< Number of cells along each
+  					     axis. */
+  int		nPts;			/*!< Number of control points. */
+} WlzBasisFnCS3DGrid;
+
 static void			WlzBasisFnEditSV(
 				  int n,
 				  double *vV);
@@ -134,6 +161,58 @@ static WlzDVertex2 		WlzBasisFnValueRedPoly2D(
 static WlzDVertex3      	WlzBasisFnValueRedPoly3D(
                                   WlzDVertex3 *poly,
 				  WlzDVertex3 srcVx);
+static WlzDVertex2		WlzBasisFnValue2D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex2 srcVx);
+static WlzDVertex3		WlzBasisFnValue3D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex3 srcVx);
+static void			WlzBasisFnCubicWeights(
+				  double t,
+				  double *w);
+static double			WlzBasisFnBatchGridNext(
+				  int nGrid,
+				  double h,
+				  double err,
+				  double tol,
+				  double prvH,
+				  double prvErr);
+static WlzErrorNum		WlzBasisFnBatchGrid2D(
+				  WlzBasisFn *basisFn,
+				  int nPos,
+				  WlzDVertex2 *pos,
+				  WlzDVertex2 *dsp,
+				  double tol,
+				  int *dstDone);
+static WlzErrorNum		WlzBasisFnBatchGrid3D(
+				  WlzBasisFn *basisFn,
+				  int nPos,
+				  WlzDVertex3 *pos,
+				  WlzDVertex3 *dsp,
+				  double tol,
+				  int *dstDone);
+static double			WlzBasisFnCSPhi(
+				  double rSq,
+				  double sSq);
+static WlzBasisFnCS3DGrid	*WlzBasisFnCS3DGridNew(
+				  int nPts,
+				  WlzDVertex3 *pts,
+				  double support,
+				  WlzErrorNum *dstErr);
+static int			WlzBasisFnCS3DGridNbr(
+				  WlzBasisFnCS3DGrid *grid,
+				  WlzDVertex3 pos,
+				  WlzIVertex3 *dstC0,
+				  WlzIVertex3 *dstC1);
+static void			WlzBasisFnCS3DPrecon(
+				  void *data,
+				  AlgMatrix aM,
+				  double *rV,
+				  double *zV);
+static int			WlzBasisFnCSCmpDsc(
+				  const void *dummy,
+				  const void *p0,
+				  const void *p1);
 static WlzHistogramDomain 	*WlzBasisFnScalarMOS3DEvalTb(
 				  int nPts,
 				  WlzDVertex3 *cPts,
@@ -479,6 +558,229 @@ WlzDVertex3 	WlzBasisFnValueIMQ3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
   return(newVx);
 }
 
+/*!
+* \return	New vertex value.
+* \ingroup	WlzFunction
+* \brief	Calculates the displacement value for the given vertex using
+*		a 3D compactly supported basis function. Only the control
+*		points within the support radius of the given vertex
+*		contribute and these are found using the basis function's
+*		grid of cells.
+* \param	basisFn			Basis function.
+* \param	srcVx			Source vertex.
+*/
+WlzDVertex3 	WlzBasisFnValueCS3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
+{
+  double	sSq;
+  int		*cOff,
+  		*cIdx;
+  WlzIVertex3	c,
+  		c0,
+		c1;
+  WlzDVertex3	*basisCo,
+		*cPts;
+  WlzDVertex3	newVx;
+  WlzBasisFnCS3DGrid *grid;
+
+  grid = (WlzBasisFnCS3DGrid *)(basisFn->param);
+  newVx = WlzBasisFnValueRedPoly3D(basisFn->poly.d3, srcVx);
+  if(WlzBasisFnCS3DGridNbr(grid, srcVx, &c0, &c1))
+  {
+    cPts    = basisFn->vertices.d3;
+    basisCo = basisFn->basis.d3;
+    sSq = grid->support * grid->support;
+    cOff = (int *)(grid + 1);
+    cIdx = cOff + (grid->nCell.vtX * grid->nCell.vtY * grid->nCell.vtZ) + 1;
+    for(c.vtZ = c0.vtZ; c.vtZ <= c1.vtZ; ++(c.vtZ))
+    {
+      for(c.vtY = c0.vtY; c.vtY <= c1.vtY; ++(c.vtY))
+      {
+        int	i0,
+		i1;
+
+	i0 = (c.vtZ * grid->nCell.vtY + c.vtY) * grid->nCell.vtX;
+	i1 = cOff[i0 + c1.vtX + 1];
+	for(i0 = cOff[i0 + c0.vtX]; i0 < i1; ++i0)
+	{
+	  int	idx;
+	  double phi;
+	  WlzDVertex3 d;
+
+	  idx = cIdx[i0];
+	  WLZ_VTX_3_SUB(d, srcVx, cPts[idx]);
+	  if((phi = WlzBasisFnCSPhi(WLZ_VTX_3_SQRLEN(d), sSq)) > 0.0)
+	  {
+	    newVx.vtX += basisCo[idx].vtX * phi;
+	    newVx.vtY += basisCo[idx].vtY * phi;
+	    newVx.vtZ += basisCo[idx].vtZ * phi;
+	  }
+	}
+      }
+    }
+  }
+  return(newVx);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Calculates the displacement values of a 2D basis function
+*		at many positions.
+*
+*		If the given tolerance is greater than zero, the basis
+*		function uses Euclidean distances and there are enough
+*		positions and control points for it to be worthwhile,
+*		the displacements are approximated. The basis function
+*		is sampled on a regular grid over the bounding box of the
+*		positions and the displacements are then interpolated
+*		from the grid using bi-cubic (Catmull-Rom) interpolation.
+*		The grid is only used if the maximum error, found by
+*		evaluating the basis function exactly at a sample of the
+*		positions, is no greater than half the tolerance. The
+*		first grid is coarse and is then refined once to find how
+*		quickly the error falls with the grid spacing, from which
+*		the spacing needed for the tolerance is predicted. If that
+*		grid would have more than a quarter as many nodes as there
+*		are positions, the error falls too slowly or the predicted
+*		grid fails, the basis function is evaluated exactly at
+*		all the positions, so the cost of trying the grid is then
+*		small compared to that of the exact evaluation. Because
+*		the error is only measured at a sample of the positions it
+*		is an estimate rather than a bound, so callers which need
+*		exact displacements should use a tolerance of zero.
+* \param	basisFn			Basis function.
+* \param	nPos			Number of positions.
+* \param	pos			Given positions.
+* \param	dsp			Destination array for the nPos
+* 					displacements.
+* \param	tol			Tolerance for the approximation,
+* 					if \f$\leq 0\f$ the displacements
+* 					are always computed exactly.
+*/
+WlzErrorNum	WlzBasisFnValueBatch2D(WlzBasisFn *basisFn, int nPos,
+				       WlzDVertex2 *pos, WlzDVertex2 *dsp,
+				       double tol)
+{
+  int		idP,
+  		done = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(basisFn == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(nPos < 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((nPos > 0) && ((pos == NULL) || (dsp == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_2DGAUSS:    /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DPOLY:     /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DIMQ:      /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:       /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DTPS:      /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DCONF_POLY:
+        break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (tol > 0.0) && (basisFn->distFn == NULL) &&
+     (basisFn->nVtx >= WLZ_BASISFN_BATCH_MINVTX) &&
+     (nPos >= WLZ_BASISFN_BATCH_MINPOS))
+  {
+    errNum = WlzBasisFnBatchGrid2D(basisFn, nPos, pos, dsp, tol, &done);
+  }
+  if((errNum == WLZ_ERR_NONE) && (done == 0))
+  {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      dsp[idP] = WlzBasisFnValue2D(basisFn, pos[idP]);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Calculates the displacement values of a 3D basis function
+*		at many positions. This is the 3D equivalent of
+*		WlzBasisFnValueBatch2D(), using tri-cubic interpolation
+*		from the grid when approximating.
+* \param	basisFn			Basis function.
+* \param	nPos			Number of positions.
+* \param	pos			Given positions.
+* \param	dsp			Destination array for the nPos
+* 					displacements.
+* \param	tol			Tolerance for the approximation,
+* 					if \f$\leq 0\f$ the displacements
+* 					are always computed exactly.
+*/
+WlzErrorNum	WlzBasisFnValueBatch3D(WlzBasisFn *basisFn, int nPos,
+				       WlzDVertex3 *pos, WlzDVertex3 *dsp,
+				       double tol)
+{
+  int		idP,
+  		done = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(basisFn == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(nPos < 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((nPos > 0) && ((pos == NULL) || (dsp == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_3DIMQ:      /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:       /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMOS:      /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DCS:
+        break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (tol > 0.0) && (basisFn->distFn == NULL) &&
+     (basisFn->nVtx >= WLZ_BASISFN_BATCH_MINVTX) &&
+     (nPos >= WLZ_BASISFN_BATCH_MINPOS))
+  {
+    errNum = WlzBasisFnBatchGrid3D(basisFn, nPos, pos, dsp, tol, &done);
+  }
+  if((errNum == WLZ_ERR_NONE) && (done == 0))
+  {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      dsp[idP] = WlzBasisFnValue3D(basisFn, pos[idP]);
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	New vertex value.
 * \ingroup	WlzFunction
@@ -3159,112 +3461,502 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
 /*!
 * \return	New basis function.
 * \ingroup	WlzFunction
-* \brief	Creates a new thin plate spline basis function.
+* \brief	Creates a new 3D compactly supported radial basis function
+*		which scales to very large numbers of control points.
+*
+*		An affine polynomial is first fitted to the displacements
+*		by least squares and the residual displacements are then
+*		interpolated using the Wendland \f$\phi_{3,1}\f$ basis
+*		function, which is zero beyond the support radius.
+*		Because the basis function has compact support the design
+*		matrix is sparse and positive definite. The neighbours of
+*		each control point are found using a regular grid of
+*		cells, the matrix is built using linked list row storage
+*		and it is solved using the conjugate gradient method with
+*		a symmetric Gauss-Seidel preconditioner. Memory and time
+*		are therefore proportional to the number of control points
+*		times the mean number of control points within the support
+*		radius, rather than \f$O(n^2)\f$ memory and \f$O(n^3)\f$
+*		time for the dense design matrix solved by singular value
+*		decomposition in the other basis functions.
+*
+*		Away from the control points the displacement falls back
+*		to the affine polynomial within the support radius, so the
+*		support radius should be large compared to the spacing of
+*		the control points. The destination control points must
+*		be distinct.
 * \param	nPts			Number of control point pairs.
 * \param	dPts			Destination control points.
 * \param	sPts			Source control points.
-* \param	prvBasisFn		Previous basis function, which if not
-* 					NULL, may be used to avoid recomputing
-* 					values (eg distance map).
-* \param        mesh                    Mesh which is used to compute
-*                                       constrained distances. If non NULL
-*                                       and the mesh type is
-*                                       WLZ_CMESH_2D then  constrained
-*                                       distances are used and these are
-*                                       computed using the mesh.
-*                                       If NULL or the transform is
-*                                       some other type then Euclidean
-*                                       distances are used.
-*                                       indexed using the node index.
+* \param	delta			Support radius normalized by the
+* 					range of the control points. If
+* 					\f$\leq 0\f$ a support radius is
+* 					chosen so that on average 32
+* 					control points would be within
+* 					the support of each control point
+* 					were they uniformly distributed
+* 					through their bounding box.
 * \param	dstErr			Destination error pointer, may be NULL.
 */
-WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
-				  WlzDVertex2 *dPts, WlzDVertex2 *sPts,
-				  WlzBasisFn *prvBasisFn,
-				  WlzCMesh2D *mesh,
-				  WlzErrorNum *dstErr)
+WlzBasisFn *WlzBasisFnCS3DFromCPts(int nPts, WlzDVertex3 *dPts,
+				WlzDVertex3 *sPts, double delta,
+				WlzErrorNum *dstErr)
 {
-  int		tI0,
-		idN,
-		idX,
-		idY,
-		idX3,
-		idY3,
-		nSys,
-		maxNod,
-                newMaxVx;
-  double	tD0,
-		tD1,
-		range;
-  double	*bV = NULL,
+  int		idC,
+  		idP,
+		maxRow = 0;
+  int		*cIdx = NULL,
+  		*rank = NULL;
+  double	range,
+  		support;
+  double	*dV = NULL,
   		*wV = NULL;
-  double	**aA;
+  double	*rV[3],
+  		*xV[3];
   AlgMatrix	aM,
-  		vM;
-  WlzVertex	sPt;
-  WlzDVertex2	tDVx0;
-  WlzDBox2	extentDB;
-  WlzBasisFn    *newBasisFn = NULL;
+  		pM,
+		vM;
+  AlgMatrix	wM[3];
+  AlgMatrixTriple *row = NULL;
+  WlzDBox3	extentDB;
+  WlzBasisFnCS3DGrid *grid = NULL;
+  WlzBasisFn	*basisFn = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
-  const int     stepVx = 10;
+  const int	maxItr = 10000,
+  		nNbr = 32;
+  const double	tol = 1.0e-09;
 
-  aM.core = NULL;
-  vM.core = NULL;
-  nSys = nPts + 3;
-  if(mesh != NULL)
+  aM.core = pM.core = vM.core = NULL;
+  for(idC = 0; idC < 3; ++idC)
   {
-    if((mesh->type != WLZ_CMESH_2D) ||
-       ((prvBasisFn != NULL) && (mesh != prvBasisFn->mesh.m2)))
+    rV[idC] = xV[idC] = NULL;
+    wM[idC].core = NULL;
+  }
+  if(nPts < 1)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((dPts == NULL) || (sPts == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    WlzBasisFnVxExtent3D(&extentDB, dPts, sPts, nPts);
+    range = ALG_MAX(extentDB.xMax - extentDB.xMin,
+                    extentDB.yMax - extentDB.yMin);
+    range = ALG_MAX(range, extentDB.zMax - extentDB.zMin);
+    if(range < 1.0)
     {
-      errNum = WLZ_ERR_DOMAIN_TYPE;
+      range = 1.0;
+    }
+    if(delta > DBL_EPSILON)
+    {
+      support = delta * range;
+    }
+    else
+    {
+      double	vol;
+
+      vol = ALG_MAX(extentDB.xMax - extentDB.xMin, 0.01 * range) *
+            ALG_MAX(extentDB.yMax - extentDB.yMin, 0.01 * range) *
+            ALG_MAX(extentDB.zMax - extentDB.zMin, 0.01 * range);
+      support = cbrt((3.0 * nNbr * vol) / (4.0 * ALG_M_PI * nPts));
+      support = ALG_MIN(support, range);
+    }
+    if(((basisFn = (WlzBasisFn *)AlcCalloc(sizeof(WlzBasisFn), 1)) == NULL) ||
+       ((basisFn->poly.v = AlcMalloc(sizeof(WlzDVertex3) * 4)) == NULL) ||
+       ((basisFn->basis.v = AlcMalloc(sizeof(WlzDVertex3) * nPts)) == NULL) ||
+       ((basisFn->vertices.v = AlcMalloc(sizeof(WlzDVertex3) *
+                                         nPts)) == NULL) ||
+       ((wV = (double *)AlcMalloc(sizeof(double) * 4)) == NULL) ||
+       ((dV = (double *)AlcMalloc(sizeof(double) * nPts)) == NULL) ||
+       ((rank = (int *)AlcMalloc(sizeof(int) * nPts)) == NULL) ||
+       ((pM.rect = AlgMatrixRectNew(4, 4, NULL)) == NULL) ||
+       ((vM.rect = AlgMatrixRectNew(4, 4, NULL)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < 3); ++idC)
+    {
+      if(((rV[idC] = (double *)AlcMalloc(sizeof(double) * nPts)) == NULL) ||
+         ((xV[idC] = (double *)AlcCalloc(sizeof(double), nPts)) == NULL) ||
+	 ((wM[idC].rect = AlgMatrixRectNew(4, nPts, NULL)) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
     }
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    if(prvBasisFn)
+    grid = WlzBasisFnCS3DGridNew(nPts, dPts, support, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* The rows of the design matrix are ordered by grid cell, so that
+     * neighbouring control points have nearby rows, which improves
+     * both the memory access pattern and the preconditioner. */
+    cIdx = (int *)(grid + 1) +
+           (grid->nCell.vtX * grid->nCell.vtY * grid->nCell.vtZ) + 1;
+    for(idP = 0; idP < nPts; ++idP)
     {
-      /* Create a new basis function, reallocate the buffers of the previous
-       * basis function as required and then use them for the new basis
+      rank[cIdx[idP]] = idP;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    basisFn->type = WLZ_FN_BASIS_3DCS;
+    basisFn->nPoly = 2;
+    basisFn->nBasis = nPts;
+    basisFn->nVtx = nPts;
+    basisFn->maxVx = nPts;
+    basisFn->param = grid;
+    WlzValueCopyDVertexToDVertex3(basisFn->vertices.d3, dPts, nPts);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idX,
+    		idY;
+    double	q[4],
+    		bP[3][4];
+    double	**pA;
+
+    /* Fit the affine polynomial to the displacements by least squares
+     * using the normal equations, with rescaled coordinates to improve
+     * their condition number. */
+    pA = pM.rect->array;
+    for(idY = 0; idY < 4; ++idY)
+    {
+      for(idC = 0; idC < 3; ++idC)
+      {
+        bP[idC][idY] = 0.0;
+      }
+    }
+    for(idP = 0; idP < nPts; ++idP)
+    {
+      q[0] = 1.0;
+      q[1] = (dPts[idP].vtX - extentDB.xMin) / range;
+      q[2] = (dPts[idP].vtY - extentDB.yMin) / range;
+      q[3] = (dPts[idP].vtZ - extentDB.zMin) / range;
+      for(idY = 0; idY < 4; ++idY)
+      {
+        for(idX = 0; idX < 4; ++idX)
+	{
+	  pA[idY][idX] += q[idY] * q[idX];
+	}
+	bP[0][idY] += q[idY] * (sPts[idP].vtX - dPts[idP].vtX);
+	bP[1][idY] += q[idY] * (sPts[idP].vtY - dPts[idP].vtY);
+	bP[2][idY] += q[idY] * (sPts[idP].vtZ - dPts[idP].vtZ);
+      }
+    }
+    errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(pM, wV, vM));
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzBasisFnEditSV(4, wV);
+      for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < 3); ++idC)
+      {
+        errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(pM, wV, vM, bP[idC]));
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzDVertex3 *poly;
+
+      poly = basisFn->poly.d3;
+      poly[0].vtX = bP[0][0] - ((bP[0][1] * extentDB.xMin) +
+                                (bP[0][2] * extentDB.yMin) +
+				(bP[0][3] * extentDB.zMin)) / range;
+      poly[0].vtY = bP[1][0] - ((bP[1][1] * extentDB.xMin) +
+                                (bP[1][2] * extentDB.yMin) +
+				(bP[1][3] * extentDB.zMin)) / range;
+      poly[0].vtZ = bP[2][0] - ((bP[2][1] * extentDB.xMin) +
+                                (bP[2][2] * extentDB.yMin) +
+				(bP[2][3] * extentDB.zMin)) / range;
+      for(idY = 1; idY < 4; ++idY)
+      {
+        poly[idY].vtX = bP[0][idY] / range;
+        poly[idY].vtY = bP[1][idY] / range;
+        poly[idY].vtZ = bP[2][idY] / range;
+      }
+      /* Residual displacements to be interpolated by the basis
        * function. */
-      if(prvBasisFn->type != WLZ_FN_BASIS_2DTPS)
+      for(idP = 0; idP < nPts; ++idP)
       {
-        errNum = WLZ_ERR_DOMAIN_TYPE;
+        WlzDVertex3 p;
+
+	p = WlzBasisFnValueRedPoly3D(poly, dPts[idP]);
+	rV[0][rank[idP]] = sPts[idP].vtX - dPts[idP].vtX - p.vtX;
+	rV[1][rank[idP]] = sPts[idP].vtY - dPts[idP].vtY - p.vtY;
+	rV[2][rank[idP]] = sPts[idP].vtZ - dPts[idP].vtZ - p.vtZ;
       }
-      else
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    AlgError	algErr = ALG_ERR_NONE;
+
+    aM = AlgMatrixNew(ALG_MATRIX_LLR, nPts, nPts, 32 * nPts, 0.0, &algErr);
+    errNum = WlzErrorFromAlg(algErr);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idK;
+    int		*cOff;
+    double	sSq;
+
+    /* Build the sparse design matrix a row at a time, inserting the
+     * entries of each row in descending column order. */
+    sSq = support * support;
+    cOff = (int *)(grid + 1);
+    for(idK = 0; (errNum == WLZ_ERR_NONE) && (idK < nPts); ++idK)
+    {
+      int	nRow = 0;
+      WlzIVertex3 c,
+      		c0,
+		c1;
+
+      idP = cIdx[idK];
+      (void )WlzBasisFnCS3DGridNbr(grid, dPts[idP], &c0, &c1);
+      for(c.vtZ = c0.vtZ; (errNum == WLZ_ERR_NONE) && (c.vtZ <= c1.vtZ);
+          ++(c.vtZ))
       {
-        newMaxVx = prvBasisFn->maxVx;
-        if(prvBasisFn->maxVx < nPts)
-        {
-          newMaxVx = nPts + stepVx;
-          if(((newBasisFn = (WlzBasisFn *)AlcCalloc(sizeof(WlzBasisFn),
-                                                    1)) == NULL) ||
-             ((prvBasisFn->basis.v = AlcRealloc(prvBasisFn->basis.v,
-                                       sizeof(WlzDVertex2) *
-                                       newMaxVx)) == NULL) ||
-             ((prvBasisFn->vertices.v = AlcRealloc(prvBasisFn->vertices.v,
-                                       sizeof(WlzDVertex2) *
-                                       newMaxVx)) == NULL) ||
-             ((prvBasisFn->sVertices.v = AlcRealloc(prvBasisFn->sVertices.v,
-                                       sizeof(WlzDVertex2) *
-                                       newMaxVx)) == NULL) ||
-             ((prvBasisFn->distMap != NULL) &&
-              ((prvBasisFn->distMap = (double **)
-                                      AlcRealloc(prvBasisFn->distMap,
-                                          sizeof(double *) *
-                                          newMaxVx)) == NULL)))
-          {
-            errNum = WLZ_ERR_MEM_ALLOC;
-          }
-        }
-        if(errNum == WLZ_ERR_NONE)
-        {
-          *newBasisFn = *prvBasisFn;
-          prvBasisFn->poly.v = NULL;
-          prvBasisFn->basis.v = NULL;
-          prvBasisFn->vertices.v = NULL;
-          prvBasisFn->sVertices.v = NULL;
-          prvBasisFn->param = NULL;
-          prvBasisFn->mesh.v = NULL;
+	for(c.vtY = c0.vtY; (errNum == WLZ_ERR_NONE) && (c.vtY <= c1.vtY);
+	    ++(c.vtY))
+	{
+	  int	i0,
+		  i1;
+
+	  i0 = (c.vtZ * grid->nCell.vtY + c.vtY) * grid->nCell.vtX;
+	  i1 = cOff[i0 + c1.vtX + 1];
+	  for(i0 = cOff[i0 + c0.vtX]; i0 < i1; ++i0)
+	  {
+	    int	idQ;
+	    double phi;
+	    WlzDVertex3 d;
+
+	    idQ = cIdx[i0];
+	    WLZ_VTX_3_SUB(d, dPts[idP], dPts[idQ]);
+	    if((phi = WlzBasisFnCSPhi(WLZ_VTX_3_SQRLEN(d), sSq)) > 0.0)
+	    {
+	      if(nRow >= maxRow)
+	      {
+		AlgMatrixTriple *newRow;
+
+		maxRow = (maxRow + 64) * 2;
+		if((newRow = (AlgMatrixTriple *)
+		             AlcRealloc(row, sizeof(AlgMatrixTriple) *
+			                     maxRow)) == NULL)
+		{
+		  errNum = WLZ_ERR_MEM_ALLOC;
+		  break;
+		}
+		row = newRow;
+	      }
+	      row[nRow].row = idK;
+	      row[nRow].col = i0;
+	      row[nRow].val = phi;
+	      ++nRow;
+	    }
+	  }
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        int	idR;
+
+	AlgQSort(row, nRow, sizeof(AlgMatrixTriple), NULL,
+	         WlzBasisFnCSCmpDsc);
+	for(idR = 0; idR < nRow; ++idR)
+	{
+	  if(row[idR].col == (size_t )idK)
+	  {
+	    dV[idK] = row[idR].val;
+	  }
+	  errNum = WlzErrorFromAlg(
+	           AlgMatrixLLRSet(aM.llr, idK, row[idR].col, row[idR].val));
+	  if(errNum != WLZ_ERR_NONE)
+	  {
+	    break;
+	  }
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzErrorNum	errC[3];
+
+    /* Solve for the three components of the basis function
+     * coefficients. */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idC = 0; idC < 3; ++idC)
+    {
+      errC[idC] = WlzErrorFromAlg(
+                  AlgMatrixCGSolve(aM, xV[idC], rV[idC], wM[idC],
+		                   WlzBasisFnCS3DPrecon, dV, tol, maxItr,
+				   NULL, NULL));
+    }
+    for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < 3); ++idC)
+    {
+      errNum = errC[idC];
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idP = 0; idP < nPts; ++idP)
+    {
+      basisFn->basis.d3[cIdx[idP]].vtX = xV[0][idP];
+      basisFn->basis.d3[cIdx[idP]].vtY = xV[1][idP];
+      basisFn->basis.d3[cIdx[idP]].vtZ = xV[2][idP];
+    }
+  }
+  for(idC = 0; idC < 3; ++idC)
+  {
+    AlcFree(rV[idC]);
+    AlcFree(xV[idC]);
+    AlgMatrixFree(wM[idC]);
+  }
+  AlcFree(row);
+  AlcFree(rank);
+  AlcFree(dV);
+  AlcFree(wV);
+  AlgMatrixFree(aM);
+  AlgMatrixFree(pM);
+  AlgMatrixFree(vM);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    if(basisFn)
+    {
+      if(basisFn->param == NULL)
+      {
+        AlcFree(grid);
+      }
+      (void )WlzBasisFnFree(basisFn);
+      basisFn = NULL;
+    }
+    else
+    {
+      AlcFree(grid);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(basisFn);
+}
+
+/*!
+* \return	New basis function.
+* \ingroup	WlzFunction
+* \brief	Creates a new thin plate spline basis function.
+* \param	nPts			Number of control point pairs.
+* \param	dPts			Destination control points.
+* \param	sPts			Source control points.
+* \param	prvBasisFn		Previous basis function, which if not
+* 					NULL, may be used to avoid recomputing
+* 					values (eg distance map).
+* \param        mesh                    Mesh which is used to compute
+*                                       constrained distances. If non NULL
+*                                       and the mesh type is
+*                                       WLZ_CMESH_2D then  constrained
+*                                       distances are used and these are
+*                                       computed using the mesh.
+*                                       If NULL or the transform is
+*                                       some other type then Euclidean
+*                                       distances are used.
+*                                       indexed using the node index.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
+				  WlzDVertex2 *dPts, WlzDVertex2 *sPts,
+				  WlzBasisFn *prvBasisFn,
+				  WlzCMesh2D *mesh,
+				  WlzErrorNum *dstErr)
+{
+  int		tI0,
+		idN,
+		idX,
+		idY,
+		idX3,
+		idY3,
+		nSys,
+		maxNod,
+                newMaxVx;
+  double	tD0,
+		tD1,
+		range;
+  double	*bV = NULL,
+  		*wV = NULL;
+  double	**aA;
+  AlgMatrix	aM,
+  		vM;
+  WlzVertex	sPt;
+  WlzDVertex2	tDVx0;
+  WlzDBox2	extentDB;
+  WlzBasisFn    *newBasisFn = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int     stepVx = 10;
+
+  aM.core = NULL;
+  vM.core = NULL;
+  nSys = nPts + 3;
+  if(mesh != NULL)
+  {
+    if((mesh->type != WLZ_CMESH_2D) ||
+       ((prvBasisFn != NULL) && (mesh != prvBasisFn->mesh.m2)))
+    {
+      errNum = WLZ_ERR_DOMAIN_TYPE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(prvBasisFn)
+    {
+      /* Create a new basis function, reallocate the buffers of the previous
+       * basis function as required and then use them for the new basis
+       * function. */
+      if(prvBasisFn->type != WLZ_FN_BASIS_2DTPS)
+      {
+        errNum = WLZ_ERR_DOMAIN_TYPE;
+      }
+      else
+      {
+        newMaxVx = prvBasisFn->maxVx;
+        if(prvBasisFn->maxVx < nPts)
+        {
+          newMaxVx = nPts + stepVx;
+          if(((newBasisFn = (WlzBasisFn *)AlcCalloc(sizeof(WlzBasisFn),
+                                                    1)) == NULL) ||
+             ((prvBasisFn->basis.v = AlcRealloc(prvBasisFn->basis.v,
+                                       sizeof(WlzDVertex2) *
+                                       newMaxVx)) == NULL) ||
+             ((prvBasisFn->vertices.v = AlcRealloc(prvBasisFn->vertices.v,
+                                       sizeof(WlzDVertex2) *
+                                       newMaxVx)) == NULL) ||
+             ((prvBasisFn->sVertices.v = AlcRealloc(prvBasisFn->sVertices.v,
+                                       sizeof(WlzDVertex2) *
+                                       newMaxVx)) == NULL) ||
+             ((prvBasisFn->distMap != NULL) &&
+              ((prvBasisFn->distMap = (double **)
+                                      AlcRealloc(prvBasisFn->distMap,
+                                          sizeof(double *) *
+                                          newMaxVx)) == NULL)))
+          {
+            errNum = WLZ_ERR_MEM_ALLOC;
+          }
+        }
+        if(errNum == WLZ_ERR_NONE)
+        {
+          *newBasisFn = *prvBasisFn;
+          prvBasisFn->poly.v = NULL;
+          prvBasisFn->basis.v = NULL;
+          prvBasisFn->vertices.v = NULL;
+          prvBasisFn->sVertices.v = NULL;
+          prvBasisFn->param = NULL;
+          prvBasisFn->mesh.v = NULL;
           prvBasisFn->distMap = NULL;
           if(newBasisFn->distMap != NULL)
           {
@@ -4458,6 +5150,846 @@ static WlzDVertex3 WlzBasisFnValueRedPoly3D(WlzDVertex3 *poly,
   return(dspVx);
 }
 
+/*!
+* \return	Displacement value.
+* \ingroup	WlzFunction
+* \brief	Calculates the displacement value of a 2D basis function
+*		of any of the types supported by WlzBasisFnValueBatch2D().
+* \param	basisFn			Basis function.
+* \param	srcVx			Source vertex.
+*/
+static WlzDVertex2 WlzBasisFnValue2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
+{
+  WlzDVertex2	dsp;
+
+  switch(basisFn->type)
+  {
+    case WLZ_FN_BASIS_2DGAUSS:
+      dsp = WlzBasisFnValueGauss2D(basisFn, srcVx);
+      break;
+    case WLZ_FN_BASIS_2DPOLY:
+      dsp = WlzBasisFnValuePoly2D(basisFn, srcVx);
+      break;
+    case WLZ_FN_BASIS_2DIMQ:
+      dsp = WlzBasisFnValueIMQ2D(basisFn, srcVx);
+      break;
+    case WLZ_FN_BASIS_2DMQ:
+      dsp = WlzBasisFnValueMQ2D(basisFn, srcVx);
+      break;
+    case WLZ_FN_BASIS_2DTPS:
+      dsp = WlzBasisFnValueTPS2D(basisFn, srcVx);
+      break;
+    case WLZ_FN_BASIS_2DCONF_POLY:
+      dsp = WlzBasisFnValueConf2D(basisFn, srcVx);
+      break;
+    default:
+      WLZ_VTX_2_ZERO(dsp);
+      break;
+  }
+  return(dsp);
+}
+
+/*!
+* \return	Displacement value.
+* \ingroup	WlzFunction
+* \brief	Calculates the displacement value of a 3D basis function
+*		of any of the types supported by WlzBasisFnValueBatch3D().
+* \param	basisFn			Basis function.
+* \param	srcVx			Source vertex.
+*/
+static WlzDVertex3 WlzBasisFnValue3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
+{
+  WlzDVertex3	dsp;
+
+  switch(basisFn->type)
+  {
+    case WLZ_FN_BASIS_3DIMQ:
+      dsp = WlzBasisFnValueIMQ3D(basisFn, srcVx);
+      break;
+    case WLZ_FN_BASIS_3DMQ:
+      dsp = WlzBasisFnValueMQ3D(basisFn, srcVx);
+      break;
+    case WLZ_FN_BASIS_3DMOS:
+      dsp = WlzBasisFnValueMOS3D(basisFn, srcVx);
+      break;
+    case WLZ_FN_BASIS_3DCS:
+      dsp = WlzBasisFnValueCS3D(basisFn, srcVx);
+      break;
+    default:
+      WLZ_VTX_3_ZERO(dsp);
+      break;
+  }
+  return(dsp);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Computes the four Catmull-Rom cubic interpolation weights
+*		for the given offset from the second of four samples.
+* \param	t			Offset in the range [0, 1].
+* \param	w			Destination array for the weights.
+*/
+static void	WlzBasisFnCubicWeights(double t, double *w)
+{
+  double	t2,
+  		t3;
+
+  t2 = t * t;
+  t3 = t2 * t;
+  w[0] = 0.5 * (-t3 + 2.0 * t2 - t);
+  w[1] = 0.5 * (3.0 * t3 - 5.0 * t2 + 2.0);
+  w[2] = 0.5 * (-3.0 * t3 + 4.0 * t2 + t);
+  w[3] = 0.5 * (t3 - t2);
+}
+
+/*!
+* \return	Next grid spacing or zero if no further grid should be
+*		tried.
+* \ingroup	WlzFunction
+* \brief	Chooses the spacing of the next grid to try after a grid
+*		has failed to approximate a basis function to within half
+*		the tolerance. The first grid's spacing is halved to find
+*		the power of the spacing with which the error falls and
+*		this power is then used to predict the spacing which gives
+*		an error of half the tolerance (with a margin). No grid
+*		is tried after a predicted one, or if the error falls more
+*		slowly than with the square of the spacing because the
+*		basis function is then not smooth enough for the grid to
+*		be worthwhile.
+* \param	nGrid			Number of grids tried before the
+*					one which has just failed.
+* \param	h			Spacing of the failed grid.
+* \param	err			Maximum error of the failed grid.
+* \param	tol			Tolerance for the approximation.
+* \param	prvH			Spacing of the previous grid.
+* \param	prvErr			Maximum error of the previous grid.
+*/
+static double	WlzBasisFnBatchGridNext(int nGrid, double h, double err,
+				        double tol, double prvH,
+					double prvErr)
+{
+  double	p,
+  		nH = 0.0;
+
+  if(nGrid == 0)
+  {
+    nH = 0.5 * h;
+  }
+  else if(nGrid == 1)
+  {
+    p = log(prvErr / err) / log(prvH / h);
+    if(p >= 2.0)
+    {
+      nH = 0.9 * h * pow(0.5 * tol / err, 1.0 / p);
+    }
+  }
+  return(nH);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Approximates the displacements of a 2D basis function at
+*		the given positions by bi-cubic interpolation from a
+*		regular grid, or if no grid is good enough evaluates the
+*		basis function exactly, see WlzBasisFnValueBatch2D().
+* \param	basisFn			Basis function.
+* \param	nPos			Number of positions.
+* \param	pos			Given positions.
+* \param	dsp			Destination array for the
+* 					displacements.
+* \param	tol			Tolerance for the approximation.
+* \param	dstDone			Destination pointer, set to non-zero
+* 					if the displacements have been
+* 					computed.
+*/
+static WlzErrorNum WlzBasisFnBatchGrid2D(WlzBasisFn *basisFn, int nPos,
+				      WlzDVertex2 *pos, WlzDVertex2 *dsp,
+				      double tol, int *dstDone)
+{
+  int		idP,
+		done = 0,
+  		nProbe,
+		stride;
+  int		nGrid = 0;
+  double	h,
+  		maxNod,
+		prvH = 0.0,
+		prvErr = 0.0;
+  double	*err = NULL;
+  WlzIVertex2	nCell;
+  WlzDBox2	bBox;
+  WlzDVertex2	*gV = NULL,
+  		*prbV = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bBox.xMin = bBox.xMax = pos[0].vtX;
+  bBox.yMin = bBox.yMax = pos[0].vtY;
+  for(idP = 1; idP < nPos; ++idP)
+  {
+    bBox.xMin = ALG_MIN(bBox.xMin, pos[idP].vtX);
+    bBox.xMax = ALG_MAX(bBox.xMax, pos[idP].vtX);
+    bBox.yMin = ALG_MIN(bBox.yMin, pos[idP].vtY);
+    bBox.yMax = ALG_MAX(bBox.yMax, pos[idP].vtY);
+  }
+  /* Start with a grid that has about a sixteenth of the maximum number
+   * of nodes. */
+  maxNod = nPos / 4.0;
+  h = 4.0 * sqrt(ALG_MAX(bBox.xMax - bBox.xMin, 1.0) *
+                 ALG_MAX(bBox.yMax - bBox.yMin, 1.0) / maxNod);
+  stride = ALG_MAX(nPos / WLZ_BASISFN_BATCH_NPROBE, 1);
+  nProbe = (nPos + stride - 1) / stride;
+  if(((err = (double *)AlcMalloc(sizeof(double) * nProbe)) == NULL) ||
+     ((prbV = (WlzDVertex2 *)
+              AlcMalloc(sizeof(WlzDVertex2) * nProbe)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    /* Evaluate the basis function exactly at the probe positions just
+     * once for all the grids. */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idP = 0; idP < nProbe; ++idP)
+    {
+      prbV[idP] = WlzBasisFnValue2D(basisFn, pos[idP * stride]);
+    }
+  }
+  while((errNum == WLZ_ERR_NONE) && (done == 0) && (h > 0.0))
+  {
+    int		idG,
+		nG;
+    double	maxErr = 0.0;
+    WlzIVertex2 nNod;
+
+    nCell.vtX = ALG_MAX((int )ceil((bBox.xMax - bBox.xMin) / h), 1);
+    nCell.vtY = ALG_MAX((int )ceil((bBox.yMax - bBox.yMin) / h), 1);
+    nNod.vtX = nCell.vtX + 3;
+    nNod.vtY = nCell.vtY + 3;
+    if(((double )(nNod.vtX) * nNod.vtY) > maxNod)
+    {
+      break;
+    }
+    nG = nNod.vtX * nNod.vtY;
+    AlcFree(gV);
+    if((gV = (WlzDVertex2 *)AlcMalloc(sizeof(WlzDVertex2) * nG)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+      break;
+    }
+    /* Sample the basis function on the grid, which extends one node
+     * beyond the bounding box of the positions. */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idG = 0; idG < nG; ++idG)
+    {
+      WlzDVertex2 p;
+
+      p.vtX = bBox.xMin + h * ((idG % nNod.vtX) - 1);
+      p.vtY = bBox.yMin + h * ((idG / nNod.vtX) - 1);
+      gV[idG] = WlzBasisFnValue2D(basisFn, p);
+    }
+    /* Interpolate at the probe positions and compare with the exact
+     * values, then if within tolerance interpolate at all positions. */
+    for(idG = 0; idG < 2; ++idG)
+    {
+      int	n;
+
+      n = (idG == 0)? nProbe: nPos;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for(idP = 0; idP < n; ++idP)
+      {
+	int	iX,
+		iY,
+		jX,
+		jY,
+		idQ;
+	double	wX[4],
+		wY[4];
+	WlzDVertex2 p,
+		v;
+	WlzDVertex2 *r;
+
+	idQ = (idG == 0)? idP * stride: idP;
+	p = pos[idQ];
+	p.vtX = (p.vtX - bBox.xMin) / h;
+	p.vtY = (p.vtY - bBox.yMin) / h;
+	iX = ALG_CLAMP((int )floor(p.vtX), 0, nCell.vtX - 1);
+	iY = ALG_CLAMP((int )floor(p.vtY), 0, nCell.vtY - 1);
+	WlzBasisFnCubicWeights(p.vtX - iX, wX);
+	WlzBasisFnCubicWeights(p.vtY - iY, wY);
+	WLZ_VTX_2_ZERO(v);
+	for(jY = 0; jY < 4; ++jY)
+	{
+	  r = gV + ((iY + jY) * nNod.vtX) + iX;
+	  for(jX = 0; jX < 4; ++jX)
+	  {
+	    double w;
+
+	    w = wX[jX] * wY[jY];
+	    v.vtX += w * r[jX].vtX;
+	    v.vtY += w * r[jX].vtY;
+	  }
+	}
+	if(idG == 0)
+	{
+	  WlzDVertex2 e;
+
+	  WLZ_VTX_2_SUB(e, prbV[idP], v);
+	  err[idP] = WLZ_VTX_2_LENGTH(e);
+	}
+	else
+	{
+	  dsp[idP] = v;
+	}
+      }
+      if(idG == 0)
+      {
+	for(idP = 0; idP < nProbe; ++idP)
+	{
+	  maxErr = ALG_MAX(maxErr, err[idP]);
+	}
+	if(maxErr > 0.5 * tol)
+	{
+	  double nH;
+
+	  nH = WlzBasisFnBatchGridNext(nGrid++, h, maxErr, tol,
+	                               prvH, prvErr);
+	  prvH = h;
+	  prvErr = maxErr;
+	  h = nH;
+	  break;
+	}
+      }
+      else
+      {
+        done = 1;
+      }
+    }
+  }
+  /* If no grid was good enough evaluate the basis function exactly,
+   * reusing the values at the probe positions. */
+  if((errNum == WLZ_ERR_NONE) && (done == 0))
+  {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      dsp[idP] = ((idP % stride) == 0)?
+                 prbV[idP / stride]: WlzBasisFnValue2D(basisFn, pos[idP]);
+    }
+    done = 1;
+  }
+  AlcFree(gV);
+  AlcFree(err);
+  AlcFree(prbV);
+  *dstDone = done;
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Approximates the displacements of a 3D basis function at
+*		the given positions by tri-cubic interpolation from a
+*		regular grid, or if no grid is good enough evaluates the
+*		basis function exactly, see WlzBasisFnValueBatch3D().
+* \param	basisFn			Basis function.
+* \param	nPos			Number of positions.
+* \param	pos			Given positions.
+* \param	dsp			Destination array for the
+* 					displacements.
+* \param	tol			Tolerance for the approximation.
+* \param	dstDone			Destination pointer, set to non-zero
+* 					if the displacements have been
+* 					computed.
+*/
+static WlzErrorNum WlzBasisFnBatchGrid3D(WlzBasisFn *basisFn, int nPos,
+				      WlzDVertex3 *pos, WlzDVertex3 *dsp,
+				      double tol, int *dstDone)
+{
+  int		idP,
+		done = 0,
+  		nProbe,
+		stride;
+  int		nGrid = 0;
+  double	h,
+  		maxNod,
+		prvH = 0.0,
+		prvErr = 0.0;
+  double	*err = NULL;
+  WlzIVertex3	nCell;
+  WlzDBox3	bBox;
+  WlzDVertex3	*gV = NULL,
+  		*prbV = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bBox.xMin = bBox.xMax = pos[0].vtX;
+  bBox.yMin = bBox.yMax = pos[0].vtY;
+  bBox.zMin = bBox.zMax = pos[0].vtZ;
+  for(idP = 1; idP < nPos; ++idP)
+  {
+    bBox.xMin = ALG_MIN(bBox.xMin, pos[idP].vtX);
+    bBox.xMax = ALG_MAX(bBox.xMax, pos[idP].vtX);
+    bBox.yMin = ALG_MIN(bBox.yMin, pos[idP].vtY);
+    bBox.yMax = ALG_MAX(bBox.yMax, pos[idP].vtY);
+    bBox.zMin = ALG_MIN(bBox.zMin, pos[idP].vtZ);
+    bBox.zMax = ALG_MAX(bBox.zMax, pos[idP].vtZ);
+  }
+  /* Start with a grid that has about a sixty fourth of the maximum
+   * number of nodes. */
+  maxNod = nPos / 4.0;
+  h = 4.0 * cbrt(ALG_MAX(bBox.xMax - bBox.xMin, 1.0) *
+                 ALG_MAX(bBox.yMax - bBox.yMin, 1.0) *
+                 ALG_MAX(bBox.zMax - bBox.zMin, 1.0) / maxNod);
+  stride = ALG_MAX(nPos / WLZ_BASISFN_BATCH_NPROBE, 1);
+  nProbe = (nPos + stride - 1) / stride;
+  if(((err = (double *)AlcMalloc(sizeof(double) * nProbe)) == NULL) ||
+     ((prbV = (WlzDVertex3 *)
+              AlcMalloc(sizeof(WlzDVertex3) * nProbe)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    /* Evaluate the basis function exactly at the probe positions just
+     * once for all the grids. */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idP = 0; idP < nProbe; ++idP)
+    {
+      prbV[idP] = WlzBasisFnValue3D(basisFn, pos[idP * stride]);
+    }
+  }
+  while((errNum == WLZ_ERR_NONE) && (done == 0) && (h > 0.0))
+  {
+    int		idG,
+		nG;
+    double	maxErr = 0.0;
+    WlzIVertex3 nNod;
+
+    nCell.vtX = ALG_MAX((int )ceil((bBox.xMax - bBox.xMin) / h), 1);
+    nCell.vtY = ALG_MAX((int )ceil((bBox.yMax - bBox.yMin) / h), 1);
+    nCell.vtZ = ALG_MAX((int )ceil((bBox.zMax - bBox.zMin) / h), 1);
+    nNod.vtX = nCell.vtX + 3;
+    nNod.vtY = nCell.vtY + 3;
+    nNod.vtZ = nCell.vtZ + 3;
+    if(((double )(nNod.vtX) * nNod.vtY * nNod.vtZ) > maxNod)
+    {
+      break;
+    }
+    nG = nNod.vtX * nNod.vtY * nNod.vtZ;
+    AlcFree(gV);
+    if((gV = (WlzDVertex3 *)AlcMalloc(sizeof(WlzDVertex3) * nG)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+      break;
+    }
+    /* Sample the basis function on the grid, which extends one node
+     * beyond the bounding box of the positions. */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idG = 0; idG < nG; ++idG)
+    {
+      int	i;
+      WlzDVertex3 p;
+
+      i = idG / nNod.vtX;
+      p.vtX = bBox.xMin + h * ((idG % nNod.vtX) - 1);
+      p.vtY = bBox.yMin + h * ((i % nNod.vtY) - 1);
+      p.vtZ = bBox.zMin + h * ((i / nNod.vtY) - 1);
+      gV[idG] = WlzBasisFnValue3D(basisFn, p);
+    }
+    /* Interpolate at the probe positions and compare with the exact
+     * values, then if within tolerance interpolate at all positions. */
+    for(idG = 0; idG < 2; ++idG)
+    {
+      int	n;
+
+      n = (idG == 0)? nProbe: nPos;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for(idP = 0; idP < n; ++idP)
+      {
+	int	iX,
+		iY,
+		iZ,
+		jX,
+		jY,
+		jZ,
+		idQ;
+	double	wX[4],
+		wY[4],
+		wZ[4];
+	WlzDVertex3 p,
+		v;
+	WlzDVertex3 *r;
+
+	idQ = (idG == 0)? idP * stride: idP;
+	p = pos[idQ];
+	p.vtX = (p.vtX - bBox.xMin) / h;
+	p.vtY = (p.vtY - bBox.yMin) / h;
+	p.vtZ = (p.vtZ - bBox.zMin) / h;
+	iX = ALG_CLAMP((int )floor(p.vtX), 0, nCell.vtX - 1);
+	iY = ALG_CLAMP((int )floor(p.vtY), 0, nCell.vtY - 1);
+	iZ = ALG_CLAMP((int )floor(p.vtZ), 0, nCell.vtZ - 1);
+	WlzBasisFnCubicWeights(p.vtX - iX, wX);
+	WlzBasisFnCubicWeights(p.vtY - iY, wY);
+	WlzBasisFnCubicWeights(p.vtZ - iZ, wZ);
+	WLZ_VTX_3_ZERO(v);
+	for(jZ = 0; jZ < 4; ++jZ)
+	{
+	  for(jY = 0; jY < 4; ++jY)
+	  {
+	    double wYZ;
+
+	    wYZ = wY[jY] * wZ[jZ];
+	    r = gV + ((((iZ + jZ) * nNod.vtY) + iY + jY) * nNod.vtX) + iX;
+	    for(jX = 0; jX < 4; ++jX)
+	    {
+	      double w;
+
+	      w = wX[jX] * wYZ;
+	      v.vtX += w * r[jX].vtX;
+	      v.vtY += w * r[jX].vtY;
+	      v.vtZ += w * r[jX].vtZ;
+	    }
+	  }
+	}
+	if(idG == 0)
+	{
+	  WlzDVertex3 e;
+
+	  WLZ_VTX_3_SUB(e, prbV[idP], v);
+	  err[idP] = WLZ_VTX_3_LENGTH(e);
+	}
+	else
+	{
+	  dsp[idP] = v;
+	}
+      }
+      if(idG == 0)
+      {
+	for(idP = 0; idP < nProbe; ++idP)
+	{
+	  maxErr = ALG_MAX(maxErr, err[idP]);
+	}
+	if(maxErr > 0.5 * tol)
+	{
+	  double nH;
+
+	  nH = WlzBasisFnBatchGridNext(nGrid++, h, maxErr, tol,
+	                               prvH, prvErr);
+	  prvH = h;
+	  prvErr = maxErr;
+	  h = nH;
+	  break;
+	}
+      }
+      else
+      {
+        done = 1;
+      }
+    }
+  }
+  /* If no grid was good enough evaluate the basis function exactly,
+   * reusing the values at the probe positions. */
+  if((errNum == WLZ_ERR_NONE) && (done == 0))
+  {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      dsp[idP] = ((idP % stride) == 0)?
+                 prbV[idP / stride]: WlzBasisFnValue3D(basisFn, pos[idP]);
+    }
+    done = 1;
+  }
+  AlcFree(gV);
+  AlcFree(err);
+  AlcFree(prbV);
+  *dstDone = done;
+  return(errNum);
+}
+
+/*!
+* \return	Basis function value.
+* \ingroup	WlzFunction
+* \brief	Computes the value of the Wendland \f$\phi_{3,1}\f$
+* 		compactly supported radial basis function
+*		\f[
+		\phi(r) = (1 - r/s)_+^4 (4 r/s + 1)
+		\f]
+*		which is positive definite in three dimensions and
+*		zero for \f$r \geq s\f$.
+* \param	rSq			Square of the radius \f$r\f$.
+* \param	sSq			Square of the support radius \f$s\f$.
+*/
+static double	WlzBasisFnCSPhi(double rSq, double sSq)
+{
+  double	t,
+  		phi = 0.0;
+
+  if(rSq < sSq)
+  {
+    t = sqrt(rSq / sSq);
+    phi = 1.0 - t;
+    phi *= phi;
+    phi *= phi * ((4.0 * t) + 1.0);
+  }
+  return(phi);
+}
+
+/*!
+* \return	New grid allocated in a single block which should be freed
+*		using AlcFree().
+* \ingroup	WlzFunction
+* \brief	Creates a new grid of cells for the given points in
+* 		which the cell size is at least the given support radius.
+*		The cell size is increased as required to keep the
+*		number of cells within a small multiple of the number of
+*		points.
+* \param	nPts			Number of points.
+* \param	pts			The points.
+* \param	support			Support radius.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzBasisFnCS3DGrid *WlzBasisFnCS3DGridNew(int nPts, WlzDVertex3 *pts,
+				double support, WlzErrorNum *dstErr)
+{
+  int		idC,
+  		idP,
+		nC;
+  int		*cOff,
+  		*cIdx,
+		*pCell = NULL;
+  double	maxC,
+  		cellSz;
+  WlzDBox3	bBox;
+  WlzBasisFnCS3DGrid *grid = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bBox.xMin = bBox.xMax = pts[0].vtX;
+  bBox.yMin = bBox.yMax = pts[0].vtY;
+  bBox.zMin = bBox.zMax = pts[0].vtZ;
+  for(idP = 1; idP < nPts; ++idP)
+  {
+    bBox.xMin = ALG_MIN(bBox.xMin, pts[idP].vtX);
+    bBox.xMax = ALG_MAX(bBox.xMax, pts[idP].vtX);
+    bBox.yMin = ALG_MIN(bBox.yMin, pts[idP].vtY);
+    bBox.yMax = ALG_MAX(bBox.yMax, pts[idP].vtY);
+    bBox.zMin = ALG_MIN(bBox.zMin, pts[idP].vtZ);
+    bBox.zMax = ALG_MAX(bBox.zMax, pts[idP].vtZ);
+  }
+  /* Choose the cell size, at least the support radius but large enough
+   * to avoid a grid which is mostly empty cells. */
+  cellSz = support;
+  maxC = 8.0 * nPts + 64.0;
+  for(;;)
+  {
+    double	n;
+
+    n = (floor((bBox.xMax - bBox.xMin) / cellSz) + 1.0) *
+        (floor((bBox.yMax - bBox.yMin) / cellSz) + 1.0) *
+        (floor((bBox.zMax - bBox.zMin) / cellSz) + 1.0);
+    if(n <= maxC)
+    {
+      break;
+    }
+    cellSz *= 1.25 * cbrt(n / maxC);
+  }
+  {
+    WlzIVertex3	n;
+
+    n.vtX = (int )floor((bBox.xMax - bBox.xMin) / cellSz) + 1;
+    n.vtY = (int )floor((bBox.yMax - bBox.yMin) / cellSz) + 1;
+    n.vtZ = (int )floor((bBox.zMax - bBox.zMin) / cellSz) + 1;
+    nC = n.vtX * n.vtY * n.vtZ;
+    if(((pCell = (int *)AlcMalloc(sizeof(int) * nPts)) == NULL) ||
+       ((grid = (WlzBasisFnCS3DGrid *)
+                AlcCalloc(sizeof(WlzBasisFnCS3DGrid) +
+		          (sizeof(int) * (nC + 1 + nPts)), 1)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      grid->support = support;
+      grid->cellSz = cellSz;
+      grid->nCell = n;
+      grid->nPts = nPts;
+      grid->org.vtX = bBox.xMin;
+      grid->org.vtY = bBox.yMin;
+      grid->org.vtZ = bBox.zMin;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Counting sort of the points by cell. */
+    cOff = (int *)(grid + 1);
+    cIdx = cOff + nC + 1;
+    for(idP = 0; idP < nPts; ++idP)
+    {
+      WlzIVertex3 c;
+
+      c.vtX = (int )floor((pts[idP].vtX - grid->org.vtX) / grid->cellSz);
+      c.vtY = (int )floor((pts[idP].vtY - grid->org.vtY) / grid->cellSz);
+      c.vtZ = (int )floor((pts[idP].vtZ - grid->org.vtZ) / grid->cellSz);
+      c.vtX = ALG_CLAMP(c.vtX, 0, grid->nCell.vtX - 1);
+      c.vtY = ALG_CLAMP(c.vtY, 0, grid->nCell.vtY - 1);
+      c.vtZ = ALG_CLAMP(c.vtZ, 0, grid->nCell.vtZ - 1);
+      pCell[idP] = (c.vtZ * grid->nCell.vtY + c.vtY) * grid->nCell.vtX +
+                   c.vtX;
+      ++(cOff[pCell[idP] + 1]);
+    }
+    for(idC = 0; idC < nC; ++idC)
+    {
+      cOff[idC + 1] += cOff[idC];
+    }
+    for(idP = 0; idP < nPts; ++idP)
+    {
+      cIdx[cOff[pCell[idP]]++] = idP;
+    }
+    for(idC = nC; idC > 0; --idC)
+    {
+      cOff[idC] = cOff[idC - 1];
+    }
+    cOff[0] = 0;
+  }
+  AlcFree(pCell);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(grid);
+}
+
+/*!
+* \return	Non-zero if there are cells which may contain control
+* 		points within the support radius of the given position.
+* \ingroup	WlzFunction
+* \brief	Computes the range of cells of the grid which may contain
+* 		control points within the support radius of the given
+* 		position.
+* \param	grid			Given grid.
+* \param	pos			Given position.
+* \param	dstC0			Destination pointer for the first
+* 					cell.
+* \param	dstC1			Destination pointer for the last
+* 					cell.
+*/
+static int	WlzBasisFnCS3DGridNbr(WlzBasisFnCS3DGrid *grid,
+				      WlzDVertex3 pos,
+				      WlzIVertex3 *dstC0, WlzIVertex3 *dstC1)
+{
+  int		nbr;
+  WlzDVertex3	p;
+
+  p.vtX = floor((pos.vtX - grid->org.vtX) / grid->cellSz);
+  p.vtY = floor((pos.vtY - grid->org.vtY) / grid->cellSz);
+  p.vtZ = floor((pos.vtZ - grid->org.vtZ) / grid->cellSz);
+  nbr = (p.vtX >= -1.0) && (p.vtX <= grid->nCell.vtX) &&
+        (p.vtY >= -1.0) && (p.vtY <= grid->nCell.vtY) &&
+        (p.vtZ >= -1.0) && (p.vtZ <= grid->nCell.vtZ);
+  if(nbr)
+  {
+    dstC0->vtX = ALG_MAX((int )(p.vtX) - 1, 0);
+    dstC0->vtY = ALG_MAX((int )(p.vtY) - 1, 0);
+    dstC0->vtZ = ALG_MAX((int )(p.vtZ) - 1, 0);
+    dstC1->vtX = ALG_MIN((int )(p.vtX) + 1, grid->nCell.vtX - 1);
+    dstC1->vtY = ALG_MIN((int )(p.vtY) + 1, grid->nCell.vtY - 1);
+    dstC1->vtZ = ALG_MIN((int )(p.vtZ) + 1, grid->nCell.vtZ - 1);
+  }
+  return(nbr);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Symmetric Gauss-Seidel preconditioner for the conjugate
+*		gradient solution of the compactly supported basis
+*		function design equation. Solves
+*		\f$(\mathbf{D} + \mathbf{L}) \mathbf{D}^{-1}
+*		   (\mathbf{D} + \mathbf{U}) \mathbf{z} = \mathbf{r}\f$
+*		for \f$\mathbf{z}\f$ using a forward and then a backward
+*		sweep through the rows of the linked list row matrix.
+* \param	data			Used to pass the diagonal of the
+* 					matrix.
+* \param	aM			Symmetric linked list row matrix
+* 					with sorted rows.
+* \param	rV			Given vector \f$\mathbf{r}\f$.
+* \param	zV			Destination vector \f$\mathbf{z}\f$.
+*/
+static void	WlzBasisFnCS3DPrecon(void *data, AlgMatrix aM,
+				     double *rV, double *zV)
+{
+  size_t	idR,
+  		nR;
+  double	*dV;
+  AlgMatrixLLRE *p;
+
+  dV = (double *)data;
+  nR = aM.llr->nR;
+  for(idR = 0; idR < nR; ++idR)
+  {
+    double	s;
+
+    s = rV[idR];
+    for(p = aM.llr->tbl[idR]; (p != NULL) && (p->col < idR); p = p->nxt)
+    {
+      s -= p->val * zV[p->col];
+    }
+    zV[idR] = s / dV[idR];
+  }
+  idR = nR;
+  while(idR-- > 0)
+  {
+    double	s;
+
+    s = zV[idR] * dV[idR];
+    for(p = aM.llr->tbl[idR]; p != NULL; p = p->nxt)
+    {
+      if(p->col > idR)
+      {
+        s -= p->val * zV[p->col];
+      }
+    }
+    zV[idR] = s / dV[idR];
+  }
+}
+
+/*!
+* \return	Signed comparison for descending column order.
+* \ingroup	WlzFunction
+* \brief	Compares matrix triples so that they are sorted into
+* 		descending column order, allowing them to be inserted
+* 		into the rows of a linked list row matrix in constant time.
+* \param	dummy			Unused client data.
+* \param	p0			First triple.
+* \param	p1			Second triple.
+*/
+static int	WlzBasisFnCSCmpDsc(const void *dummy,
+				   const void *p0, const void *p1)
+{
+  size_t	c0,
+  		c1;
+
+  c0 = ((const AlgMatrixTriple *)p0)->col;
+  c1 = ((const AlgMatrixTriple *)p1)->col;
+  return((c0 < c1)? 1: (c0 > c1)? -1: 0);
+}
+
 /*!
 * \return	void
 * \ingroup	WlzFunction
@@ -286,6 +286,12 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2DParam(WlzFnType type,
 *		supply the multi-quadric delta or gauss parameter scaling.
 *		The default values of multi-quadric delta = 0.001 and
 *		gauss param = 0.9 are used if nParam <= 0 or param == NULL.
+*		For very large numbers of control points the compactly
+*		supported basis function WLZ_FN_BASIS_3DCS should be used,
+*		for which the parameter is the support radius normalized
+*		by the range of the control points, with the default
+*		(0.0) chosen from the number of control points. This
+*		basis function always uses Euclidean distances.
 * \param	type			Required basis function type.
 * \param	order			Order of polynomial, only used for
 * 					WLZ_FN_BASIS_3DPOLY.
@@ -364,6 +370,13 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts3DParam(WlzFnType type,
 					*param: deltaMQ,
 					NULL, mesh, &errNum);
 	break;
+      case WLZ_FN_BASIS_3DCS:
+	basisTr->basisFn = WlzBasisFnCS3DFromCPts(nDPts,
+					dPts, sPts,
+					((nParam > 0) && (param != NULL))?
+					*param: 0.0,
+					&errNum);
+	break;
       default:
 	 errNum = WLZ_ERR_TRANSFORM_TYPE;
 	 break;
@@ -719,11 +732,32 @@ WlzErrorNum    	WlzBasisFnSetCMesh(WlzObject *mObj,
 */
 WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
 				     WlzBasisFnTransform *basisTr)
+{
+  return(WlzBasisFnSetCMesh2DTol(mObj, basisTr, 0.0));
+}
+
+/*!
+* \return	Error number.
+* \ingroup	WlzTransform
+* \brief	Sets the displacements of the given 2D conforming mesh
+*		transform object according to the basis function transform,
+*		as WlzBasisFnSetCMesh2D() does. If the given tolerance is
+*		greater than zero then the displacements may be
+*		approximated, see WlzBasisFnValueBatch2D(), otherwise
+*		they are computed exactly.
+* \param	mObj			Given mesh transform object.
+* \param	basisTr			Given basis function transform.
+* \param	tol			Displacement tolerance for the
+*					approximation, if zero or less the
+*					displacements are exact.
+*/
+WlzErrorNum    	WlzBasisFnSetCMesh2DTol(WlzObject *mObj,
+				     WlzBasisFnTransform *basisTr,
+				     double tol)
 {
   int		idN,
   		maxNodIdx;
   double	*dsp;
-  WlzDVertex2	dspV;
   WlzCMeshNod2D	*nod;
   WlzCMesh2D	*mesh;
   WlzIndexedValues *ixv;
@@ -766,76 +800,50 @@ WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    switch(basisTr->basisFn->type)
+    int		nPos = 0;
+    int		*nodIdx = NULL;
+    WlzDVertex2	*pos = NULL,
+    		*dspA = NULL;
+
+    /* Gather the node positions, compute all the displacements together
+     * and then set the nodes displacements. */
+    if(((nodIdx = (int *)AlcMalloc(sizeof(int) * maxNodIdx)) == NULL) ||
+       ((pos = (WlzDVertex2 *)
+               AlcMalloc(sizeof(WlzDVertex2) * maxNodIdx)) == NULL) ||
+       ((dspA = (WlzDVertex2 *)
+                AlcMalloc(sizeof(WlzDVertex2) * maxNodIdx)) == NULL))
     {
-      case WLZ_FN_BASIS_2DGAUSS:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueGauss2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
-	}
-        break;
-      case WLZ_FN_BASIS_2DIMQ:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueIMQ2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
-	}
-        break;
-      case WLZ_FN_BASIS_2DMQ:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(idN = 0; idN < maxNodIdx; ++idN)
+      {
+	nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	if(nod->idx >= 0)
 	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueMQ2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
+	  nodIdx[nPos] = idN;
+	  pos[nPos++] = nod->pos;
 	}
-        break;
-      case WLZ_FN_BASIS_2DTPS:
+      }
+      errNum = WlzBasisFnValueBatch2D(basisTr->basisFn, nPos, pos, dspA,
+                                      tol);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
 #ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
+#pragma omp parallel for private(dsp)
 #endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueTPS2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
-	}
-        break;
-      default:
-	errNum = WLZ_ERR_DOMAIN_TYPE;
-        break;
+      for(idN = 0; idN < nPos; ++idN)
+      {
+	dsp = (double *)WlzIndexedValueGet(ixv, nodIdx[idN]);
+	dsp[0] = dspA[idN].vtX;
+	dsp[1] = dspA[idN].vtY;
+      }
     }
+    AlcFree(nodIdx);
+    AlcFree(pos);
+    AlcFree(dspA);
   }
 #ifdef WLZ_CMESH_DEBUG_MESH_DSP_ERR
   if(errNum == WLZ_ERR_NONE)
@@ -916,11 +924,32 @@ WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
 */
 WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
 				     WlzBasisFnTransform *basisTr)
+{
+  return(WlzBasisFnSetCMesh3DTol(mObj, basisTr, 0.0));
+}
+
+/*!
+* \return	Error number.
+* \ingroup	WlzTransform
+* \brief	Sets the displacements of the given 3D conforming mesh
+*		transform object according to the basis function transform,
+*		as WlzBasisFnSetCMesh3D() does. If the given tolerance is
+*		greater than zero then the displacements may be
+*		approximated, see WlzBasisFnValueBatch3D(), otherwise
+*		they are computed exactly.
+* \param	mObj			Given mesh transform object.
+* \param	basisTr			Given basis function transform.
+* \param	tol			Displacement tolerance for the
+*					approximation, if zero or less the
+*					displacements are exact.
+*/
+WlzErrorNum    	WlzBasisFnSetCMesh3DTol(WlzObject *mObj,
+				     WlzBasisFnTransform *basisTr,
+				     double tol)
 {
   int		idN,
   		maxNodIdx;
   double	*dsp;
-  WlzDVertex3	dspV;
   WlzCMeshNod3D	*nod;
   WlzCMesh3D	*mesh;
   WlzIndexedValues *ixv;
@@ -963,46 +992,51 @@ WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    switch(basisTr->basisFn->type)
+    int		nPos = 0;
+    int		*nodIdx = NULL;
+    WlzDVertex3	*pos = NULL,
+    		*dspA = NULL;
+
+    /* Gather the node positions, compute all the displacements together
+     * and then set the nodes displacements. */
+    if(((nodIdx = (int *)AlcMalloc(sizeof(int) * maxNodIdx)) == NULL) ||
+       ((pos = (WlzDVertex3 *)
+               AlcMalloc(sizeof(WlzDVertex3) * maxNodIdx)) == NULL) ||
+       ((dspA = (WlzDVertex3 *)
+                AlcMalloc(sizeof(WlzDVertex3) * maxNodIdx)) == NULL))
     {
-      case WLZ_FN_BASIS_3DIMQ:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-        for(idN = 0; idN < maxNodIdx; ++idN)
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(idN = 0; idN < maxNodIdx; ++idN)
+      {
+	nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	if(nod->idx >= 0)
 	{
-	  nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueIMQ3D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	    dsp[2] = dspV.vtZ;
-	  }
+	  nodIdx[nPos] = idN;
+	  pos[nPos++] = nod->pos;
 	}
-	break;
-      case WLZ_FN_BASIS_3DMQ:
+      }
+      errNum = WlzBasisFnValueBatch3D(basisTr->basisFn, nPos, pos, dspA,
+                                      tol);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
 #ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
+#pragma omp parallel for private(dsp)
 #endif
-        for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueMQ3D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	    dsp[2] = dspV.vtZ;
-	  }
-	}
-	break;
-      default:
-        errNum = WLZ_ERR_VALUES_TYPE;
-	break;
+      for(idN = 0; idN < nPos; ++idN)
+      {
+	dsp = (double *)WlzIndexedValueGet(ixv, nodIdx[idN]);
+	dsp[0] = dspA[idN].vtX;
+	dsp[1] = dspA[idN].vtY;
+	dsp[2] = dspA[idN].vtZ;
+      }
     }
+    AlcFree(nodIdx);
+    AlcFree(pos);
+    AlcFree(dspA);
   }
 #ifdef WLZ_CMESH_DEBUG_MESH_DSP_ERR
   if(errNum == WLZ_ERR_NONE)
@@ -1046,6 +1080,9 @@ WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
           case WLZ_FN_BASIS_3DMQ:
 	    cDspB = WlzBasisFnValueMQ3D(basisTr->basisFn, cPos);
 	    break;
+          case WLZ_FN_BASIS_3DCS:
+	    cDspB = WlzBasisFnValueCS3D(basisTr->basisFn, cPos);
+	    break;
 	  default:
 	    WLZ_VTX_3_ZERO(cDspB);   /* Mainly to silence compiler warnings! */
 	    break;
@@ -1964,23 +2001,73 @@ WlzContour	*WlzBasisFnTransformContour(WlzContour *srcCtr,
 WlzGMModel	*WlzBasisFnTransformGMModel(WlzGMModel *srcM,
 					    WlzBasisFnTransform *basisTr,
 					    int newModel, WlzErrorNum *dstErr)
+{
+  return(WlzBasisFnTransformGMModelTol(srcM, basisTr, newModel, 0.0,
+  				       dstErr));
+}
+
+/*!
+* \return	Transformed model, NULL on error.
+* \ingroup	WlzTransform
+* \brief	Transforms a Woolz GMModel using a the given basis function
+*		transform, as WlzBasisFnTransformGMModel() does. If the
+*		given tolerance is greater than zero then the vertex
+*		displacements may be approximated, see
+*		WlzBasisFnValueBatch2D(), otherwise they are computed
+*		exactly.
+* \param	srcM			Model to be transformed.
+* \param	basisTr			Basis function transform to apply.
+* \param	newModel		Makes a new model if non-zero
+*					otherwise the given model will be
+*					transformed in place.
+* \param	tol			Displacement tolerance for the
+*					approximation, if zero or less the
+*					displacements are exact.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzGMModel	*WlzBasisFnTransformGMModelTol(WlzGMModel *srcM,
+					    WlzBasisFnTransform *basisTr,
+					    int newModel, double tol,
+					    WlzErrorNum *dstErr)
 {
   int		idx,
-  		cnt;
-  WlzDVertex2	tD;
-  AlcVector	*vec;
+  		cnt = 0,
+		nVtx = 0;
+  AlcVector	*vec = NULL;
+  WlzDVertex2	*vtx = NULL;
   WlzGMElemP	elmP;
   WlzGMModel	*dstM = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstM = (newModel)? WlzGMModelCopy(srcM, &errNum): srcM;
-  /* Transform vertex geometries. */
+  /* Transform vertex geometries. Vertices without normals are gathered
+   * and transformed together. */
   if(errNum == WLZ_ERR_NONE)
   {
-    idx = 0;
     vec = dstM->res.vertexG.vec;
     cnt = dstM->res.vertexG.numIdx;
-    while((idx < cnt) && (errNum == WLZ_ERR_NONE))
+    switch(dstM->type)
+    {
+      case WLZ_GMMOD_2I: /* FALLTHROUGH */
+      case WLZ_GMMOD_2D:
+	if((cnt > 0) &&
+	   ((vtx = (WlzDVertex2 *)AlcMalloc(sizeof(WlzDVertex2) *
+	                                    cnt)) == NULL))
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	break;
+      case WLZ_GMMOD_2N:
+        break;
+      default:
+	errNum = WLZ_ERR_DOMAIN_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nVtx = 0;
+    for(idx = 0; (idx < cnt) && (errNum == WLZ_ERR_NONE); ++idx)
     {
       elmP.core = (WlzGMCore *)AlcVectorItemGet(vec, idx);
       if(elmP.core && (elmP.core->idx >= 0))
@@ -1988,15 +2075,11 @@ WlzGMModel	*WlzBasisFnTransformGMModel(WlzGMModel *srcM,
         switch(dstM->type)
         {
           case WLZ_GMMOD_2I:
-	    tD.vtX = elmP.vertexG2I->vtx.vtX;
-	    tD.vtY = elmP.vertexG2I->vtx.vtY;
-	    tD = WlzBasisFnTransformVertexD(basisTr, tD, &errNum);
-	    elmP.vertexG2I->vtx.vtX = WLZ_NINT(tD.vtX);
-	    elmP.vertexG2I->vtx.vtY = WLZ_NINT(tD.vtY);
+	    vtx[nVtx].vtX = elmP.vertexG2I->vtx.vtX;
+	    vtx[nVtx++].vtY = elmP.vertexG2I->vtx.vtY;
             break;
           case WLZ_GMMOD_2D:
-	    elmP.vertexG2D->vtx = WlzBasisFnTransformVertexD(basisTr,
-	    				elmP.vertexG2D->vtx, &errNum);
+	    vtx[nVtx++] = elmP.vertexG2D->vtx;
             break;
           case WLZ_GMMOD_2N:
 	    elmP.vertexG2N->nrm = WlzBasisFnTransformNormalD(basisTr,
@@ -2006,13 +2089,37 @@ WlzGMModel	*WlzBasisFnTransformGMModel(WlzGMModel *srcM,
 					&errNum);
             break;
           default:
-            errNum = WLZ_ERR_DOMAIN_TYPE;
             break;
         }
       }
-      ++idx;
     }
   }
+  if((errNum == WLZ_ERR_NONE) && vtx)
+  {
+    errNum = WlzBasisFnTransformVertexBatchD(basisTr, nVtx, vtx, vtx, tol);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nVtx = 0;
+      for(idx = 0; idx < cnt; ++idx)
+      {
+	elmP.core = (WlzGMCore *)AlcVectorItemGet(vec, idx);
+	if(elmP.core && (elmP.core->idx >= 0))
+	{
+	  if(dstM->type == WLZ_GMMOD_2I)
+	  {
+	    elmP.vertexG2I->vtx.vtX = WLZ_NINT(vtx[nVtx].vtX);
+	    elmP.vertexG2I->vtx.vtY = WLZ_NINT(vtx[nVtx].vtY);
+	  }
+	  else
+	  {
+	    elmP.vertexG2D->vtx = vtx[nVtx];
+	  }
+	  ++nVtx;
+	}
+      }
+    }
+  }
+  AlcFree(vtx);
   /* Compute shell geometries. */
   if(errNum == WLZ_ERR_NONE)
   {
@@ -2182,6 +2289,66 @@ WlzDVertex2	WlzBasisFnTransformVertexD(WlzBasisFnTransform *basisTr,
   return(dstVx);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Transforms the given array of WlzDVertex2 vertices. When
+*		there are many vertices the basis function is evaluated
+*		using WlzBasisFnValueBatch2D() with the given tolerance,
+*		which is much faster than transforming the vertices one
+*		at a time.
+* \param	basisTr			Basis function transform to apply.
+* \param	nVtx			Number of vertices.
+* \param	srcVx			Vertices to be transformed.
+* \param	dstVx			Destination array for the transformed
+*					vertices, may be the same as srcVx.
+* \param	tol			Displacement tolerance, if zero or
+*					less the basis function is evaluated
+*					exactly.
+*/
+WlzErrorNum	WlzBasisFnTransformVertexBatchD(WlzBasisFnTransform *basisTr,
+					int nVtx, WlzDVertex2 *srcVx,
+					WlzDVertex2 *dstVx, double tol)
+{
+  int		idx;
+  WlzDVertex2	*dsp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(basisTr == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(basisTr->type != WLZ_TRANSFORM_2D_BASISFN)
+  {
+    errNum = WLZ_ERR_TRANSFORM_TYPE;
+  }
+  else if((nVtx < 0) || ((nVtx > 0) && ((srcVx == NULL) || (dstVx == NULL))))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(nVtx > 0)
+  {
+    if((dsp = (WlzDVertex2 *)AlcMalloc(sizeof(WlzDVertex2) * nVtx)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      errNum = WlzBasisFnValueBatch2D(basisTr->basisFn, nVtx, srcVx, dsp, tol);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idx = 0; idx < nVtx; ++idx)
+      {
+        dstVx[idx].vtX = srcVx[idx].vtX + dsp[idx].vtX;
+        dstVx[idx].vtY = srcVx[idx].vtY + dsp[idx].vtY;
+      }
+    }
+    AlcFree(dsp);
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Transformed vertex.
 * \ingroup	WlzTransform
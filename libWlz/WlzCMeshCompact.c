@@ -0,0 +1,897 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzCMeshCompact_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzCMeshCompact.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2012],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Compact, read only, representation of 3D conforming
+* 		meshes in which nodes and elements are held in
+* 		contiguous arrays rather than as linked structures.
+* \ingroup	WlzMesh
+*/
+
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <Wlz.h>
+
+static WlzErrorNum		WlzCMeshCompactUpdate3D(
+				  WlzCMeshCompact3D *cMesh);
+static void			WlzCMeshCompactElmCells3D(
+				  WlzCMeshCompact3D *cMesh,
+				  int elmIdx,
+				  WlzIBox3 *dstBox);
+static int			WlzCMeshCompactElmHasPos3D(
+				  WlzCMeshCompact3D *cMesh,
+				  int elmIdx,
+				  WlzDVertex3 pos,
+				  int *dstOut);
+
+/*!
+* \return	New compact mesh or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Makes a compact mesh from the given 3D conforming mesh.
+* 		Deleted nodes and elements of the given mesh are
+* 		squeezed out, with the indices of the nodes and
+* 		elements in the given mesh being kept in the compact
+* 		mesh. The node flags are copied, so boundary nodes
+* 		should have been flagged (see
+* 		WlzCMeshSetBoundNodFlags3D()) if they are needed.
+* \param	mesh			Given mesh.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzCMeshCompact3D *WlzCMeshCompactFromMesh3D(WlzCMesh3D *mesh,
+					     WlzErrorNum *dstErr)
+{
+  int		idE,
+  		idN,
+		nNod = 0,
+		nElm = 0;
+  int		*nodMap = NULL,
+  		*elmMap = NULL;
+  WlzCMeshCompact3D *cMesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_3D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if(((nodMap = (int *)AlcMalloc(sizeof(int) *
+                                      (mesh->res.nod.maxEnt + 1))) == NULL) ||
+          ((elmMap = (int *)AlcMalloc(sizeof(int) *
+                                      (mesh->res.elm.maxEnt + 1))) == NULL) ||
+	  ((cMesh = (WlzCMeshCompact3D *)
+	            AlcCalloc(1, sizeof(WlzCMeshCompact3D))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Build maps from the mesh node and element indices to those of the
+   * compact mesh. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
+    {
+      WlzCMeshNod3D *nod;
+
+      nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+      nodMap[idN] = (nod->idx >= 0)? nNod++: -1;
+    }
+    for(idE = 0; idE < mesh->res.elm.maxEnt; ++idE)
+    {
+      WlzCMeshElm3D *elm;
+
+      elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+      elmMap[idE] = (elm->idx >= 0)? nElm++: -1;
+    }
+    cMesh->nNod = nNod;
+    cMesh->nElm = nElm;
+    if(((cMesh->nodPos = (WlzDVertex3 *)
+                         AlcMalloc(sizeof(WlzDVertex3) *
+			           (nNod + 1))) == NULL) ||
+       ((cMesh->nodFlags = (unsigned int *)
+                           AlcMalloc(sizeof(unsigned int) *
+			             (nNod + 1))) == NULL) ||
+       ((cMesh->nodIdx = (int *)
+                         AlcMalloc(sizeof(int) * (nNod + 1))) == NULL) ||
+       ((cMesh->elmNod = (int *)
+                         AlcMalloc(sizeof(int) * ((4 * nElm) + 1))) == NULL) ||
+       ((cMesh->elmNbr = (int *)
+                         AlcMalloc(sizeof(int) * ((4 * nElm) + 1))) == NULL) ||
+       ((cMesh->elmIdx = (int *)
+                         AlcMalloc(sizeof(int) * (nElm + 1))) == NULL) ||
+       ((cMesh->nodElmOff = (int *)
+                            AlcCalloc(nNod + 1, sizeof(int))) == NULL) ||
+       ((cMesh->nodElm = (int *)
+                         AlcMalloc(sizeof(int) * ((4 * nElm) + 1))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Copy the nodes. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
+    {
+      int	cN;
+
+      if((cN = nodMap[idN]) >= 0)
+      {
+	WlzCMeshNod3D *nod;
+
+	nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	cMesh->nodPos[cN] = nod->pos;
+	cMesh->nodFlags[cN] = nod->flags;
+	cMesh->nodIdx[cN] = idN;
+      }
+    }
+  }
+  /* Copy the elements, their nodes and neighbours, counting the
+   * number of elements which use each node. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idE = 0; idE < mesh->res.elm.maxEnt; ++idE)
+    {
+      int	cE;
+
+      if((cE = elmMap[idE]) >= 0)
+      {
+	int	idF;
+	int	*eNod,
+		*eNbr;
+	WlzCMeshElm3D *elm;
+	WlzCMeshNod3D *nod[4];
+
+	elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+	eNod = cMesh->elmNod + (4 * cE);
+	eNbr = cMesh->elmNbr + (4 * cE);
+	nod[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm);
+	nod[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
+	nod[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
+	nod[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
+	for(idN = 0; idN < 4; ++idN)
+	{
+	  eNod[idN] = nodMap[nod[idN]->idx];
+	  eNbr[idN] = -1;
+	  ++(cMesh->nodElmOff[eNod[idN]]);
+	}
+	for(idF = 0; idF < 4; ++idF)
+	{
+	  WlzCMeshFace *fce;
+
+	  fce = elm->face + idF;
+	  if((fce->opp != NULL) && (fce->opp != fce))
+	  {
+	    /* Find the node of the element which is not on this face. */
+	    for(idN = 0; idN < 4; ++idN)
+	    {
+	      if((nod[idN] != fce->edu[0].nod) &&
+	         (nod[idN] != fce->edu[1].nod) &&
+		 (nod[idN] != fce->edu[2].nod))
+	      {
+		eNbr[idN] = elmMap[fce->opp->elm->idx];
+		break;
+	      }
+	    }
+	  }
+	}
+	cMesh->elmIdx[cE] = idE;
+      }
+    }
+  }
+  /* Build the node to element adjacency. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		off = 0;
+
+    for(idN = 0; idN < nNod; ++idN)
+    {
+      int	cnt;
+
+      cnt = cMesh->nodElmOff[idN];
+      cMesh->nodElmOff[idN] = off;
+      off += cnt;
+    }
+    cMesh->nodElmOff[nNod] = off;
+    for(idE = 0; idE < nElm; ++idE)
+    {
+      for(idN = 0; idN < 4; ++idN)
+      {
+        cMesh->nodElm[cMesh->nodElmOff[cMesh->elmNod[(4 * idE) + idN]]++] =
+	    idE;
+      }
+    }
+    for(idN = nNod; idN > 0; --idN)
+    {
+      cMesh->nodElmOff[idN] = cMesh->nodElmOff[idN - 1];
+    }
+    cMesh->nodElmOff[0] = 0;
+    errNum = WlzCMeshCompactUpdate3D(cMesh);
+  }
+  AlcFree(nodMap);
+  AlcFree(elmMap);
+  if((errNum != WLZ_ERR_NONE) && (cMesh != NULL))
+  {
+    (void )WlzCMeshCompactFree3D(cMesh);
+    cMesh = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cMesh);
+}
+
+/*!
+* \return	New 3D conforming mesh or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Makes a new 3D conforming mesh from the given compact
+* 		mesh. The nodes and elements of the new mesh have the
+* 		indices of the compact mesh.
+* \param	cMesh			Given compact mesh.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzCMesh3D	*WlzCMeshCompactToMesh3D(WlzCMeshCompact3D *cMesh,
+					 WlzErrorNum *dstErr)
+{
+  int		idE,
+  		idN;
+  WlzCMesh3D	*mesh = NULL;
+  WlzCMeshNod3D	**nod = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cMesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((nod = (WlzCMeshNod3D **)
+                 AlcMalloc(sizeof(WlzCMeshNod3D *) *
+		           (cMesh->nNod + 1))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    mesh = WlzCMeshNew3D(&errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    mesh->bBox = cMesh->bBox;
+    mesh->maxSqEdgLen = cMesh->maxSqEdgLen;
+    errNum = WlzCMeshReassignGridCells3D(mesh, cMesh->nNod);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((AlcVectorExtend(mesh->res.nod.vec, cMesh->nNod) != ALC_ER_NONE) ||
+       (AlcVectorExtend(mesh->res.elm.vec, cMesh->nElm) != ALC_ER_NONE))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < cMesh->nNod); ++idN)
+  {
+    nod[idN] = WlzCMeshNewNod3D(mesh, cMesh->nodPos[idN], &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nod[idN]->flags = cMesh->nodFlags[idN];
+    }
+  }
+  for(idE = 0; (errNum == WLZ_ERR_NONE) && (idE < cMesh->nElm); ++idE)
+  {
+    int		*eNod;
+
+    eNod = cMesh->elmNod + (4 * idE);
+    (void )WlzCMeshNewElm3D(mesh, nod[eNod[0]], nod[eNod[1]], nod[eNod[2]],
+                            nod[eNod[3]], 1, &errNum);
+  }
+  AlcFree(nod);
+  if((errNum != WLZ_ERR_NONE) && (mesh != NULL))
+  {
+    (void )WlzCMeshFree3D(mesh);
+    mesh = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(mesh);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Frees the given compact mesh.
+* \param	cMesh			Given compact mesh.
+*/
+WlzErrorNum	WlzCMeshCompactFree3D(WlzCMeshCompact3D *cMesh)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cMesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    AlcFree(cMesh->nodPos);
+    AlcFree(cMesh->nodFlags);
+    AlcFree(cMesh->nodIdx);
+    AlcFree(cMesh->elmNod);
+    AlcFree(cMesh->elmNbr);
+    AlcFree(cMesh->elmIdx);
+    AlcFree(cMesh->nodElmOff);
+    AlcFree(cMesh->nodElm);
+    AlcFree(cMesh->cellElmOff);
+    AlcFree(cMesh->cellElm);
+    AlcFree(cMesh);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Sets the positions of the nodes of the given mesh from
+* 		those of the given compact mesh, which must have been
+* 		made from the mesh (see WlzCMeshCompactFromMesh3D())
+* 		without the mesh being modified since.
+* \param	mesh			Given mesh.
+* \param	cMesh			Given compact mesh.
+* \param	update			Update the mesh bounding box, bucket
+* 					grid and maximum edge length if
+* 					non-zero.
+*/
+WlzErrorNum	WlzCMeshCompactSetNodPos3D(WlzCMesh3D *mesh,
+					   WlzCMeshCompact3D *cMesh,
+					   int update)
+{
+  int		idN;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((mesh == NULL) || (cMesh == NULL))
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_3D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if(cMesh->nNod != mesh->res.nod.numEnt)
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idN = 0; idN < cMesh->nNod; ++idN)
+    {
+      WlzCMeshNod3D *nod;
+
+      nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec,
+      					      cMesh->nodIdx[idN]);
+      nod->pos = cMesh->nodPos[idN];
+    }
+    if(update)
+    {
+      WlzCMeshUpdateBBox3D(mesh);
+      WlzCMeshUpdateMaxSqEdgLen3D(mesh);
+      errNum = WlzCMeshReassignGridCells3D(mesh, 0);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Applies a Laplacian smoothing to the compact mesh in
+* 		which nodes are iteratively moved towards the centroid
+* 		of their imediate neighbours. The neighbours are found
+* 		from the elements which use each node, with each
+* 		neighbour weighted by the number of elements in which it
+* 		shares an edge with the node, just as the edge uses are
+* 		followed by WlzCMeshLaplacianSmooth3D().
+* \param	cMesh			Given compact mesh.
+* \param	itr			Number of iterations.
+* \param	alpha			Weight factor.
+* \param	doBnd			Apply smoothing to boundary nodes
+*					if non-zero.
+* \param	update			Update the bounding box, maximum
+* 					edge length and element location
+* 					grid if non-zero. This must be
+* 					set if elements are to be located
+* 					after smoothing.
+*/
+WlzErrorNum	WlzCMeshCompactLaplacianSmooth3D(WlzCMeshCompact3D *cMesh,
+					         int itr, double alpha,
+						 int doBnd, int update)
+{
+  int		idI,
+  		idN;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cMesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    for(idI = 0; idI < itr; ++idI)
+    {
+      for(idN = 0; idN < cMesh->nNod; ++idN)
+      {
+	if(doBnd ||
+	   ((cMesh->nodFlags[idN] & WLZ_CMESH_NOD_FLAG_BOUNDARY) == 0))
+	{
+	  int	idE,
+	  	nCnt = 0;
+	  WlzDVertex3 nPos,
+	  	*pos;
+
+	  nPos.vtX = nPos.vtY = nPos.vtZ = 0.0;
+	  for(idE = cMesh->nodElmOff[idN]; idE < cMesh->nodElmOff[idN + 1];
+	      ++idE)
+	  {
+	    int	idK;
+	    int	*eNod;
+
+	    eNod = cMesh->elmNod + (4 * cMesh->nodElm[idE]);
+	    for(idK = 0; idK < 4; ++idK)
+	    {
+	      if(eNod[idK] != idN)
+	      {
+		WlzDVertex3 *oPos;
+
+		oPos = cMesh->nodPos + eNod[idK];
+		nPos.vtX += oPos->vtX;
+		nPos.vtY += oPos->vtY;
+		nPos.vtZ += oPos->vtZ;
+		++nCnt;
+	      }
+	    }
+	  }
+	  if(nCnt > 0)
+	  {
+	    pos = cMesh->nodPos + idN;
+	    pos->vtX = (1.0 - alpha) * pos->vtX + alpha * nPos.vtX / nCnt;
+	    pos->vtY = (1.0 - alpha) * pos->vtY + alpha * nPos.vtY / nCnt;
+	    pos->vtZ = (1.0 - alpha) * pos->vtZ + alpha * nPos.vtZ / nCnt;
+	  }
+	}
+      }
+    }
+    if(update)
+    {
+      errNum = WlzCMeshCompactUpdate3D(cMesh);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Index of the enclosing element or a negative value if
+* 		there is no enclosing element.
+* \ingroup	WlzMesh
+* \brief	Locates the element of the compact mesh which encloses
+* 		the given position. If the last element index is valid
+* 		a short walk is made from the last element through the
+* 		face opposite to the node with the least barycentric
+* 		coordinate. If this fails to find the enclosing element
+* 		then the elements which intersect the position's cell of
+* 		the location grid are checked.
+* \param	cMesh			Given compact mesh.
+* \param	lastElmIdx		Last element index to start the walk
+* 					from, may be negative.
+* \param	pos			Given position.
+*/
+int		WlzCMeshCompactElmEnclosingPos3D(WlzCMeshCompact3D *cMesh,
+						 int lastElmIdx,
+						 WlzDVertex3 pos)
+{
+  int		idS,
+  		elmIdx = -1;
+
+  if((cMesh != NULL) && (cMesh->nElm > 0) && (cMesh->cellElmOff != NULL))
+  {
+    int		cE;
+    const int	maxWalk = 32;
+
+    cE = ((lastElmIdx >= 0) && (lastElmIdx < cMesh->nElm))? lastElmIdx: -1;
+    for(idS = 0; (cE >= 0) && (idS < maxWalk); ++idS)
+    {
+      int	out;
+
+      if(WlzCMeshCompactElmHasPos3D(cMesh, cE, pos, &out))
+      {
+        elmIdx = cE;
+	break;
+      }
+      cE = (out < 0)? -1: cMesh->elmNbr[(4 * cE) + out];
+    }
+    if(elmIdx < 0)
+    {
+      WlzIVertex3 c;
+
+      c.vtX = (int )floor((pos.vtX - cMesh->bBox.xMin) / cMesh->cellSz);
+      c.vtY = (int )floor((pos.vtY - cMesh->bBox.yMin) / cMesh->cellSz);
+      c.vtZ = (int )floor((pos.vtZ - cMesh->bBox.zMin) / cMesh->cellSz);
+      if((c.vtX >= 0) && (c.vtX < cMesh->cellNum.vtX) &&
+         (c.vtY >= 0) && (c.vtY < cMesh->cellNum.vtY) &&
+         (c.vtZ >= 0) && (c.vtZ < cMesh->cellNum.vtZ))
+      {
+	int	idC,
+		idE;
+
+	idC = (((c.vtZ * cMesh->cellNum.vtY) + c.vtY) * cMesh->cellNum.vtX) +
+	      c.vtX;
+	for(idE = cMesh->cellElmOff[idC]; idE < cMesh->cellElmOff[idC + 1];
+	    ++idE)
+	{
+	  if(WlzCMeshCompactElmHasPos3D(cMesh, cMesh->cellElm[idE], pos,
+	                                NULL))
+	  {
+	    elmIdx = cMesh->cellElm[idE];
+	    break;
+	  }
+	}
+      }
+    }
+  }
+  return(elmIdx);
+}
+
+/*!
+* \return	Number of neighbouring nodes.
+* \ingroup	WlzMesh
+* \brief	Finds the nodes which share an edge with the given node
+* 		of the compact mesh. The neighbours are not sorted.
+* \param	cMesh			Given compact mesh.
+* \param	nodIdx			Index of the given node.
+* \param	maxNbr			Maximum number of neighbours to
+* 					set in the given array.
+* \param	nbr			Array for the neighbouring node
+* 					indices, may be NULL.
+*/
+int		WlzCMeshCompactNodRing3D(WlzCMeshCompact3D *cMesh,
+					 int nodIdx, int maxNbr, int *nbr)
+{
+  int		idE,
+  		nNbr = 0;
+
+  if((cMesh != NULL) && (nodIdx >= 0) && (nodIdx < cMesh->nNod))
+  {
+    for(idE = cMesh->nodElmOff[nodIdx]; idE < cMesh->nodElmOff[nodIdx + 1];
+        ++idE)
+    {
+      int	idK;
+      int	*eNod;
+
+      eNod = cMesh->elmNod + (4 * cMesh->nodElm[idE]);
+      for(idK = 0; idK < 4; ++idK)
+      {
+	int	idP,
+		oN;
+
+	if((oN = eNod[idK]) != nodIdx)
+	{
+	  /* Check for a duplicate by looking at the neighbours found
+	   * in the previous elements. */
+	  for(idP = cMesh->nodElmOff[nodIdx]; idP < idE; ++idP)
+	  {
+	    int	*pNod;
+
+	    pNod = cMesh->elmNod + (4 * cMesh->nodElm[idP]);
+	    if((pNod[0] == oN) || (pNod[1] == oN) ||
+	       (pNod[2] == oN) || (pNod[3] == oN))
+	    {
+	      break;
+	    }
+	  }
+	  if(idP == idE)
+	  {
+	    if((nbr != NULL) && (nNbr < maxNbr))
+	    {
+	      nbr[nNbr] = oN;
+	    }
+	    ++nNbr;
+	  }
+	}
+      }
+    }
+  }
+  return(nNbr);
+}
+
+/*!
+* \return	Non-zero if the element encloses the position.
+* \ingroup	WlzMesh
+* \brief	Tests whether the given element of the compact mesh
+* 		encloses the given position (within WLZ_MESH_TOLERANCE
+* 		of barycentric coordinates).
+* \param	cMesh			Given compact mesh.
+* \param	elmIdx			Index of the element.
+* \param	pos			Given position.
+* \param	dstOut			Destination pointer for the index of
+* 					the node with the least barycentric
+* 					coordinate, set to -1 if the element
+* 					is degenerate, may be NULL.
+*/
+static int	WlzCMeshCompactElmHasPos3D(WlzCMeshCompact3D *cMesh,
+					   int elmIdx, WlzDVertex3 pos,
+					   int *dstOut)
+{
+  int		idK,
+  		out = -1,
+  		inside = 0;
+  int		*eNod;
+  double	lambda[4];
+
+  eNod = cMesh->elmNod + (4 * elmIdx);
+  if(WlzGeomBaryCoordsTet3D(cMesh->nodPos[eNod[0]], cMesh->nodPos[eNod[1]],
+                            cMesh->nodPos[eNod[2]], cMesh->nodPos[eNod[3]],
+			    pos, lambda))
+  {
+    out = 0;
+    for(idK = 1; idK < 4; ++idK)
+    {
+      if(lambda[idK] < lambda[out])
+      {
+        out = idK;
+      }
+    }
+    inside = lambda[out] > -WLZ_MESH_TOLERANCE;
+  }
+  if(dstOut)
+  {
+    *dstOut = out;
+  }
+  return(inside);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Updates the bounding box, maximum squared edge length
+* 		and element location grid of the compact mesh. The cell
+* 		size of the grid is twice the side of a cube with the
+* 		mean volume per element of the bounding box, increased
+* 		if need be so that there are no more cells than eight
+* 		times the number of elements.
+* \param	cMesh			Given compact mesh.
+*/
+static WlzErrorNum WlzCMeshCompactUpdate3D(WlzCMeshCompact3D *cMesh)
+{
+  int		idE,
+  		idN,
+		nCell;
+  WlzDVertex3	sz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cMesh->nNod > 0)
+  {
+    WlzDVertex3 *pos;
+
+    pos = cMesh->nodPos;
+    cMesh->bBox.xMin = cMesh->bBox.xMax = pos->vtX;
+    cMesh->bBox.yMin = cMesh->bBox.yMax = pos->vtY;
+    cMesh->bBox.zMin = cMesh->bBox.zMax = pos->vtZ;
+    for(idN = 1; idN < cMesh->nNod; ++idN)
+    {
+      ++pos;
+      cMesh->bBox.xMin = ALG_MIN(cMesh->bBox.xMin, pos->vtX);
+      cMesh->bBox.xMax = ALG_MAX(cMesh->bBox.xMax, pos->vtX);
+      cMesh->bBox.yMin = ALG_MIN(cMesh->bBox.yMin, pos->vtY);
+      cMesh->bBox.yMax = ALG_MAX(cMesh->bBox.yMax, pos->vtY);
+      cMesh->bBox.zMin = ALG_MIN(cMesh->bBox.zMin, pos->vtZ);
+      cMesh->bBox.zMax = ALG_MAX(cMesh->bBox.zMax, pos->vtZ);
+    }
+  }
+  cMesh->maxSqEdgLen = 0.0;
+  for(idE = 0; idE < cMesh->nElm; ++idE)
+  {
+    int		idK,
+    		idL;
+    int		*eNod;
+
+    eNod = cMesh->elmNod + (4 * idE);
+    for(idK = 0; idK < 3; ++idK)
+    {
+      for(idL = idK + 1; idL < 4; ++idL)
+      {
+	double	d;
+	WlzDVertex3 del;
+
+	WLZ_VTX_3_SUB(del, cMesh->nodPos[eNod[idK]], cMesh->nodPos[eNod[idL]]);
+	d = WLZ_VTX_3_SQRLEN(del);
+	if(d > cMesh->maxSqEdgLen)
+	{
+	  cMesh->maxSqEdgLen = d;
+	}
+      }
+    }
+  }
+  /* Choose the grid cell size. */
+  sz.vtX = cMesh->bBox.xMax - cMesh->bBox.xMin;
+  sz.vtY = cMesh->bBox.yMax - cMesh->bBox.yMin;
+  sz.vtZ = cMesh->bBox.zMax - cMesh->bBox.zMin;
+  cMesh->cellSz = 2.0 * cbrt(((sz.vtX + 1.0) * (sz.vtY + 1.0) *
+                               (sz.vtZ + 1.0)) / (cMesh->nElm + 1));
+  do
+  {
+    cMesh->cellNum.vtX = (int )floor(sz.vtX / cMesh->cellSz) + 1;
+    cMesh->cellNum.vtY = (int )floor(sz.vtY / cMesh->cellSz) + 1;
+    cMesh->cellNum.vtZ = (int )floor(sz.vtZ / cMesh->cellSz) + 1;
+    nCell = cMesh->cellNum.vtX * cMesh->cellNum.vtY * cMesh->cellNum.vtZ;
+    if(nCell > 8 * (cMesh->nElm + 1))
+    {
+      cMesh->cellSz *= 1.25;
+    }
+  } while(nCell > 8 * (cMesh->nElm + 1));
+  /* Build the cell to element adjacency, first counting the elements
+   * in each cell. */
+  AlcFree(cMesh->cellElmOff);
+  AlcFree(cMesh->cellElm);
+  cMesh->cellElm = NULL;
+  if((cMesh->cellElmOff = (int *)AlcCalloc(nCell + 1, sizeof(int))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    int		idP,
+    		off = 0;
+
+    for(idP = 0; idP < 2; ++idP)
+    {
+      for(idE = 0; idE < cMesh->nElm; ++idE)
+      {
+	int	cX,
+		cY,
+		cZ;
+	WlzIBox3 cB;
+
+	WlzCMeshCompactElmCells3D(cMesh, idE, &cB);
+	for(cZ = cB.zMin; cZ <= cB.zMax; ++cZ)
+	{
+	  for(cY = cB.yMin; cY <= cB.yMax; ++cY)
+	  {
+	    int	idC;
+
+	    idC = (((cZ * cMesh->cellNum.vtY) + cY) * cMesh->cellNum.vtX) +
+	          cB.xMin;
+	    for(cX = cB.xMin; cX <= cB.xMax; ++cX)
+	    {
+	      if(idP == 0)
+	      {
+		++(cMesh->cellElmOff[idC]);
+	      }
+	      else
+	      {
+		cMesh->cellElm[cMesh->cellElmOff[idC]++] = idE;
+	      }
+	      ++idC;
+	    }
+	  }
+	}
+      }
+      if(idP == 0)
+      {
+	for(idN = 0; idN < nCell; ++idN)
+	{
+	  int	cnt;
+
+	  cnt = cMesh->cellElmOff[idN];
+	  cMesh->cellElmOff[idN] = off;
+	  off += cnt;
+	}
+	cMesh->cellElmOff[nCell] = off;
+	if((cMesh->cellElm = (int *)AlcMalloc(sizeof(int) * (off + 1))) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	  break;
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idN = nCell; idN > 0; --idN)
+      {
+	cMesh->cellElmOff[idN] = cMesh->cellElmOff[idN - 1];
+      }
+      cMesh->cellElmOff[0] = 0;
+    }
+    else
+    {
+      AlcFree(cMesh->cellElmOff);
+      cMesh->cellElmOff = NULL;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzMesh
+* \brief	Computes the range of location grid cells which are
+* 		intersected by the bounding box of the given element,
+* 		which is expanded by WLZ_MESH_TOLERANCE.
+* \param	cMesh			Given compact mesh.
+* \param	elmIdx			Index of the element.
+* \param	dstBox			Destination pointer for the range
+* 					of cells.
+*/
+static void	WlzCMeshCompactElmCells3D(WlzCMeshCompact3D *cMesh,
+					  int elmIdx, WlzIBox3 *dstBox)
+{
+  int		idK;
+  int		*eNod;
+  WlzDBox3	bB;
+
+  eNod = cMesh->elmNod + (4 * elmIdx);
+  bB.xMin = bB.xMax = cMesh->nodPos[eNod[0]].vtX;
+  bB.yMin = bB.yMax = cMesh->nodPos[eNod[0]].vtY;
+  bB.zMin = bB.zMax = cMesh->nodPos[eNod[0]].vtZ;
+  for(idK = 1; idK < 4; ++idK)
+  {
+    WlzDVertex3 *p;
+
+    p = cMesh->nodPos + eNod[idK];
+    bB.xMin = ALG_MIN(bB.xMin, p->vtX);
+    bB.xMax = ALG_MAX(bB.xMax, p->vtX);
+    bB.yMin = ALG_MIN(bB.yMin, p->vtY);
+    bB.yMax = ALG_MAX(bB.yMax, p->vtY);
+    bB.zMin = ALG_MIN(bB.zMin, p->vtZ);
+    bB.zMax = ALG_MAX(bB.zMax, p->vtZ);
+  }
+  dstBox->xMin = (int )floor((bB.xMin - WLZ_MESH_TOLERANCE -
+                              cMesh->bBox.xMin) / cMesh->cellSz);
+  dstBox->yMin = (int )floor((bB.yMin - WLZ_MESH_TOLERANCE -
+                              cMesh->bBox.yMin) / cMesh->cellSz);
+  dstBox->zMin = (int )floor((bB.zMin - WLZ_MESH_TOLERANCE -
+                              cMesh->bBox.zMin) / cMesh->cellSz);
+  dstBox->xMax = (int )floor((bB.xMax + WLZ_MESH_TOLERANCE -
+                              cMesh->bBox.xMin) / cMesh->cellSz);
+  dstBox->yMax = (int )floor((bB.yMax + WLZ_MESH_TOLERANCE -
+                              cMesh->bBox.yMin) / cMesh->cellSz);
+  dstBox->zMax = (int )floor((bB.zMax + WLZ_MESH_TOLERANCE -
+                              cMesh->bBox.zMin) / cMesh->cellSz);
+  dstBox->xMin = ALG_MAX(dstBox->xMin, 0);
+  dstBox->yMin = ALG_MAX(dstBox->yMin, 0);
+  dstBox->zMin = ALG_MAX(dstBox->zMin, 0);
+  dstBox->xMax = ALG_MIN(dstBox->xMax, cMesh->cellNum.vtX - 1);
+  dstBox->yMax = ALG_MIN(dstBox->yMax, cMesh->cellNum.vtY - 1);
+  dstBox->zMax = ALG_MIN(dstBox->zMax, cMesh->cellNum.vtZ - 1);
+}
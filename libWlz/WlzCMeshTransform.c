@@ -51,6 +51,10 @@ static char _WlzCMeshTransform_c[] = "University of Edinburgh $Id$";
 
 #define WLZ_CMESH_POS_DTOI(X) ((int )floor(X))
 
+/* Minimum number of positions per mesh element for which a compact mesh
+ * is made to locate the elements enclosing the positions. */
+#define WLZ_CMESH_COMPACT_MINPOSPERELM	(2)
+
 /*!
 * \enum		_WlzCMeshScanElmFlags
 * \ingroup	WlzTransform
@@ -180,10 +184,27 @@ static void 			WlzCMeshUpdateScanElm3D(
 				  WlzObject *mObj,
 				  WlzCMeshScanElm3D *sElm,
 				  int fwd);
+static int			WlzCMeshTransformElmEnclosingPos3D(
+				  WlzCMesh3D *mesh,
+				  WlzCMeshCompact3D *cMesh,
+				  int lastElmIdx,
+				  int *cLastElmIdx,
+				  WlzDVertex3 pos,
+				  int *dstNearNod);
 static void			WlzCMeshScanWSpFree2D(
 				  WlzCMeshScanWSp2D *mSWSp);
 static void			WlzCMeshScanWSpFree3D(
 				  WlzCMeshScanWSp3D *mSWSp);
+static void			WlzCMeshScanElmsUpdate2D(
+				  WlzCMeshScanWSp2D *mSWSp);
+static void			WlzCMeshScanElmsUpdate3D(
+				  WlzCMeshScanWSp3D *mSWSp);
+static int			WlzCMeshScanItvFirstLine2D(
+				  WlzCMeshScanWSp2D *mSWSp,
+				  int ln);
+static int			WlzCMeshScanItvFirstPlane3D(
+				  WlzCMeshScanWSp3D *mSWSp,
+				  int pl);
 static void			WlzCMeshScanClearOlpBuf(
 				  WlzGreyP olpBuf,
 				  int *olpCnt,
@@ -304,6 +325,11 @@ static WlzErrorNum 		WlzCMeshTransformValues2D(
 				  WlzObject *srcObj,
 				  WlzObject *mObj,
 				  WlzInterpolationType interp);
+static WlzErrorNum 		WlzCMeshTransformValuesBand2D(
+				  WlzObject *dstObj,
+				  WlzObject *srcObj,
+				  WlzCMeshScanWSp2D *mSWSp,
+				  WlzInterpolationType interp);
 static WlzErrorNum 		WlzCMeshTetElmItv3D(
 				  AlcVector *itvVec,
 				  int *idI,
@@ -329,6 +355,13 @@ static WlzErrorNum 		WlzCMeshScanObjValues3D(
 				  WlzObject *srcObj,
 				  WlzCMeshScanWSp3D *mSWSp,
 				  WlzInterpolationType interp);
+static WlzErrorNum 		WlzCMeshScanObjValuesPlanes3D(
+				  WlzObject *dstObj,
+				  WlzObject *srcObj,
+				  WlzCMeshScanWSp3D *mSWSp,
+				  WlzInterpolationType interp,
+				  int pln0,
+				  int pln1);
 static WlzErrorNum 		WlzCMeshScanFlushOlpBuf(
 				  WlzGreyP dGP,
 				  WlzGreyP olpBuf,
@@ -433,6 +466,9 @@ static WlzCMesh3D 		*WlzCMeshTransformCMesh3D(
 				  WlzObject *mObj,
 				  int newMesh,
 				  WlzErrorNum *dstErr);
+static WlzCMeshCompact3D	*WlzCMeshTransformCompact3D(
+				  WlzCMesh3D *mesh,
+				  int nPos);
 static WlzCMeshScanWSp2D 	*WlzCMeshScanWSpInit2D(
 				  WlzObject *mObj,
 				  int trans,
@@ -1214,11 +1250,13 @@ WlzErrorNum	WlzCMeshTransformVtxAry3I(WlzObject *mObj,
 					 int nInside, WlzUByte *inside)
 {
   int		idN,
+  		cLastElmIdx,
   		lastElmIdx,
 		nearNod;
   double	*dsp;
   WlzDVertex3	tVtx;
   WlzCMesh3D	*mesh;
+  WlzCMeshCompact3D *cMesh;
   WlzIndexedValues *ixv;
   WlzCMeshScanElm3D sE;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -1239,21 +1277,28 @@ WlzErrorNum	WlzCMeshTransformVtxAry3I(WlzObject *mObj,
   {
     nearNod = -1;
     lastElmIdx = -1;
+    cLastElmIdx = -1;
     mesh = mObj->domain.cm3;
     ixv = mObj->values.x;
+    cMesh = WlzCMeshTransformCompact3D(mesh, nVtx);
     for(idN = 0; idN < nVtx; ++idN)
     {
-      if(((sE.idx = WlzCMeshElmEnclosingPos3D(mesh, lastElmIdx,
-			  (double )(vtx[idN].vtX), (double )(vtx[idN].vtY),
-			  (double )(vtx[idN].vtZ), 0,
+      WlzDVertex3 pos;
+
+      WLZ_VTX_3_SET(pos, vtx[idN].vtX, vtx[idN].vtY, vtx[idN].vtZ);
+      if(((sE.idx = WlzCMeshTransformElmEnclosingPos3D(mesh, cMesh,
+			  lastElmIdx, &cLastElmIdx, pos,
 			  &nearNod)) < 0) && (nearNod < 0))
       {
 	errNum = WLZ_ERR_DOMAIN_DATA;
 	break;
       }
-      if(sE.idx > 0)
+      if(sE.idx >= 0)
       {
-        inside[idN] = 1;
+        if(nInside > 0)
+	{
+	  inside[idN] = 1;
+	}
 	if((sE.idx != lastElmIdx) || ((sE.flags & WLZ_CMESH_SCANELM_FWD) == 0))
 	{
 	  WlzCMeshUpdateScanElm3D(mObj, &sE, 1);
@@ -1268,16 +1313,20 @@ WlzErrorNum	WlzCMeshTransformVtxAry3I(WlzObject *mObj,
       }
       else
       {
-        inside[idN] = 0;
+        if(nInside > 0)
+	{
+	  inside[idN] = 0;
+	}
 	dsp = (double *)WlzIndexedValueGet(ixv, nearNod);
 	tVtx.vtX = vtx[idN].vtX + dsp[0];
 	tVtx.vtY = vtx[idN].vtY + dsp[1];
-	tVtx.vtZ = vtx[idN].vtY + dsp[2];
+	tVtx.vtZ = vtx[idN].vtZ + dsp[2];
       }
       vtx[idN].vtX = WLZ_NINT(tVtx.vtX);
       vtx[idN].vtY = WLZ_NINT(tVtx.vtY);
       vtx[idN].vtZ = WLZ_NINT(tVtx.vtZ);
     }
+    (void )WlzCMeshCompactFree3D(cMesh);
   }
   return(errNum);
 }
@@ -1393,11 +1442,13 @@ WlzErrorNum	WlzCMeshTransformVtxAry3F(WlzObject *mObj,
 					 int nInside, WlzUByte *inside)
 {
   int		idN,
+  		cLastElmIdx,
   		lastElmIdx,
 		nearNod;
   double	*dsp;
   WlzDVertex3	tVtx;
   WlzCMesh3D	*mesh;
+  WlzCMeshCompact3D *cMesh;
   WlzIndexedValues *ixv;
   WlzCMeshScanElm3D sE;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -1418,20 +1469,28 @@ WlzErrorNum	WlzCMeshTransformVtxAry3F(WlzObject *mObj,
   {
     nearNod = -1;
     lastElmIdx = -1;
+    cLastElmIdx = -1;
     mesh = mObj->domain.cm3;
     ixv = mObj->values.x;
+    cMesh = WlzCMeshTransformCompact3D(mesh, nVtx);
     for(idN = 0; idN < nVtx; ++idN)
     {
-      if(((sE.idx = WlzCMeshElmEnclosingPos3D(mesh, lastElmIdx,
-			  vtx[idN].vtX, vtx[idN].vtY, vtx[idN].vtZ,
-			  0, &nearNod)) < 0) && (nearNod < 0))
+      WlzDVertex3 pos;
+
+      WLZ_VTX_3_SET(pos, vtx[idN].vtX, vtx[idN].vtY, vtx[idN].vtZ);
+      if(((sE.idx = WlzCMeshTransformElmEnclosingPos3D(mesh, cMesh,
+			  lastElmIdx, &cLastElmIdx, pos,
+			  &nearNod)) < 0) && (nearNod < 0))
       {
 	errNum = WLZ_ERR_DOMAIN_DATA;
 	break;
       }
-      if(sE.idx > 0)
+      if(sE.idx >= 0)
       {
-        inside[idN] = 1;
+        if(nInside > 0)
+	{
+	  inside[idN] = 1;
+	}
 	if((sE.idx != lastElmIdx) || ((sE.flags & WLZ_CMESH_SCANELM_FWD) == 0))
 	{
 	  WlzCMeshUpdateScanElm3D(mObj, &sE, 1);
@@ -1446,7 +1505,10 @@ WlzErrorNum	WlzCMeshTransformVtxAry3F(WlzObject *mObj,
       }
       else
       {
-        inside[idN] = 0;
+        if(nInside > 0)
+	{
+	  inside[idN] = 0;
+	}
 	dsp = (double *)WlzIndexedValueGet(ixv, nearNod);
 	tVtx.vtX = vtx[idN].vtX + dsp[0];
 	tVtx.vtY = vtx[idN].vtY + dsp[1];
@@ -1456,6 +1518,7 @@ WlzErrorNum	WlzCMeshTransformVtxAry3F(WlzObject *mObj,
       vtx[idN].vtY = (float )(tVtx.vtY);
       vtx[idN].vtZ = (float )(tVtx.vtZ);
     }
+    (void )WlzCMeshCompactFree3D(cMesh);
   }
   return(errNum);
 }
@@ -1671,11 +1734,13 @@ WlzErrorNum	WlzCMeshTransformVtxAry3D(WlzObject *mObj,
 					 int nInside, WlzUByte *inside)
 {
   int		idN,
+  		cLastElmIdx,
 		nearNod,
   		lastElmIdx;
   double	*dsp;
   WlzDVertex3	tVtx;
   WlzCMesh3D	*mesh;
+  WlzCMeshCompact3D *cMesh;
   WlzIndexedValues *ixv;
   WlzCMeshScanElm3D sE;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -1696,20 +1761,28 @@ WlzErrorNum	WlzCMeshTransformVtxAry3D(WlzObject *mObj,
   {
     nearNod = -1;
     lastElmIdx = -1;
+    cLastElmIdx = -1;
     mesh = mObj->domain.cm3;
     ixv = mObj->values.x;
+    cMesh = WlzCMeshTransformCompact3D(mesh, nVtx);
     for(idN = 0; idN < nVtx; ++idN)
     {
-      if(((sE.idx = WlzCMeshElmEnclosingPos3D(mesh, lastElmIdx,
-			  vtx[idN].vtX, vtx[idN].vtY, vtx[idN].vtZ,
-			  0, &nearNod)) < 0) && (nearNod < 0))
+      WlzDVertex3 pos;
+
+      WLZ_VTX_3_SET(pos, vtx[idN].vtX, vtx[idN].vtY, vtx[idN].vtZ);
+      if(((sE.idx = WlzCMeshTransformElmEnclosingPos3D(mesh, cMesh,
+			  lastElmIdx, &cLastElmIdx, pos,
+			  &nearNod)) < 0) && (nearNod < 0))
       {
 	errNum = WLZ_ERR_DOMAIN_DATA;
 	break;
       }
-      if(sE.idx > 0)
+      if(sE.idx >= 0)
       {
-        inside[idN] = 1;
+        if(nInside > 0)
+	{
+	  inside[idN] = 1;
+	}
 	if((sE.idx != lastElmIdx) || ((sE.flags & WLZ_CMESH_SCANELM_FWD) == 0))
 	{
 	  WlzCMeshUpdateScanElm3D(mObj, &sE, 1);
@@ -1724,7 +1797,10 @@ WlzErrorNum	WlzCMeshTransformVtxAry3D(WlzObject *mObj,
       }
       else
       {
-        inside[idN] = 0;
+        if(nInside > 0)
+	{
+	  inside[idN] = 0;
+	}
 	dsp = (double *)WlzIndexedValueGet(ixv, nearNod);
 	tVtx.vtX = vtx[idN].vtX + dsp[0];
 	tVtx.vtY = vtx[idN].vtY + dsp[1];
@@ -1732,6 +1808,7 @@ WlzErrorNum	WlzCMeshTransformVtxAry3D(WlzObject *mObj,
       }
       vtx[idN] = tVtx;
     }
+    (void )WlzCMeshCompactFree3D(cMesh);
   }
   return(errNum);
 }
@@ -4003,6 +4080,9 @@ static void 	WlzCMeshUpdateScanElm3D(WlzObject *mObj,
 * \ingroup	WlzTransform
 * \brief	Sets values in the destination object transforming those
 *		of the source object.
+*		The lines of the destination object are partitioned into
+*		contiguous bands which are filled concurrently, each band
+*		having it's own overlap buffers and grey value workspace.
 * \param	dstObj			2D destination object with transformed
 * 					domain but no values.
 * \param	srcObj			2D source object.
@@ -4013,6 +4093,118 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 					WlzObject *srcObj,
 					WlzObject *mObj,
 					WlzInterpolationType interp)
+{
+  int		idB,
+  		nBnd,
+		nLn,
+		nThr = 1;
+  WlzObject	**bndObj = NULL;
+  WlzCMeshScanWSp2D *mSWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  mSWSp = WlzCMeshScanWSpInit2D(mObj, 1, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzCMeshScanElmsUpdate2D(mSWSp);
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+	nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    nLn = dstObj->domain.i->lastln - dstObj->domain.i->line1 + 1;
+    /* Use a few bands per thread so that the load is balanced even though
+     * the number of intervals per line varies. */
+    nBnd = ALG_MIN(nLn, 4 * nThr);
+    if(nBnd <= 1)
+    {
+      errNum = WlzCMeshTransformValuesBand2D(dstObj, srcObj, mSWSp, interp);
+    }
+    else if((bndObj = (WlzObject **)
+                      AlcCalloc(nBnd, sizeof(WlzObject *))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      WlzIBox2	bndBox;
+
+      /* Make band objects which share the destination object's values
+       * before filling them, since making objects is not thread safe. */
+      bndBox.xMin = dstObj->domain.i->kol1;
+      bndBox.xMax = dstObj->domain.i->lastkl;
+      for(idB = 0; (errNum == WLZ_ERR_NONE) && (idB < nBnd); ++idB)
+      {
+	bndBox.yMin = dstObj->domain.i->line1 +
+		      (int )(((long )nLn * idB) / nBnd);
+	bndBox.yMax = dstObj->domain.i->line1 +
+		      (int )(((long )nLn * (idB + 1)) / nBnd) - 1;
+	bndObj[idB] = WlzAssignObject(
+		      WlzClipObjToBox2D(dstObj, bndBox, &errNum), NULL);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
+#endif
+	for(idB = 0; idB < nBnd; ++idB)
+	{
+	  if((errNum == WLZ_ERR_NONE) &&
+	     (bndObj[idB]->type == WLZ_2D_DOMAINOBJ))
+	  {
+	    WlzErrorNum errNum2;
+
+	    errNum2 = WlzCMeshTransformValuesBand2D(bndObj[idB], srcObj,
+						    mSWSp, interp);
+	    if(errNum2 != WLZ_ERR_NONE)
+	    {
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshTransformValues2D)
+#endif
+	      {
+		if(errNum == WLZ_ERR_NONE)
+		{
+		  errNum = errNum2;
+		}
+	      }
+	    }
+	  }
+	}
+      }
+      for(idB = 0; idB < nBnd; ++idB)
+      {
+        (void )WlzFreeObj(bndObj[idB]);
+      }
+      AlcFree(bndObj);
+    }
+  }
+  WlzCMeshScanWSpFree2D(mSWSp);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Sets values in the destination object transforming those
+*		of the source object, for a band of lines. The element
+*		transforms of the mesh scan workspace must already have
+*		been computed using WlzCMeshScanElmsUpdate2D(), so that
+*		bands of lines may be filled concurrently.
+* \param	dstObj			2D destination object, which may be
+*					a band of the full destination
+*					object sharing it's values.
+* \param	srcObj			2D source object.
+* \param	mSWSp			Mesh scan workspace for the
+*					transform.
+* \param	interp			Level of interpolation.
+*/
+static WlzErrorNum WlzCMeshTransformValuesBand2D(WlzObject *dstObj,
+					WlzObject *srcObj,
+					WlzCMeshScanWSp2D *mSWSp,
+					WlzInterpolationType interp)
 {
   int		idP,
   		idX,
@@ -4040,7 +4232,6 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
   WlzCMeshScanItv2D *mItv0 = NULL,
   		*mItv1 = NULL,
 		*mItv2 = NULL;
-  WlzCMeshScanWSp2D *mSWSp = NULL;
   WlzCMeshScanElm2D *sElm;
   WlzGreyValueWSpace *gVWSp = NULL;
   WlzGreyWSpace gWSp;
@@ -4065,12 +4256,8 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    mItvIdx0 = 0;
-    mSWSp = WlzCMeshScanWSpInit2D(mObj, 1, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    mItv0 = mSWSp->itvs;
+    mItvIdx0 = WlzCMeshScanItvFirstLine2D(mSWSp, dstObj->domain.i->line1);
+    mItv0 = mSWSp->itvs + mItvIdx0;
     errNum = WlzInitGreyScan(dstObj, &iWSp, &gWSp);
   }
   if(errNum == WLZ_ERR_NONE)
@@ -4105,19 +4292,20 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
       WlzValueSetInt(olpCnt, 0, itvWidth);
       /* Update the mesh interval pointer so that it points to the first
        * mesh interval on the which intersects the current grey interval. */
-      while((mItv0->line < iWSp.linpos) && (mItvIdx0 < mSWSp->nItvs))
+      while((mItvIdx0 < mSWSp->nItvs) && (mItv0->line < iWSp.linpos))
       {
 	++mItvIdx0;
 	++mItv0;
       }
-      while((mItv0->line <= iWSp.linpos) &&
-	    (mItv0->rgtI < iWSp.lftpos) &&
-	    (mItvIdx0 < mSWSp->nItvs))
+      while((mItvIdx0 < mSWSp->nItvs) &&
+	    (mItv0->line <= iWSp.linpos) &&
+	    (mItv0->rgtI < iWSp.lftpos))
       {
 	++mItvIdx0;
 	++mItv0;
       }
-      if((mItv0->line == iWSp.linpos) &&
+      if((mItvIdx0 < mSWSp->nItvs) &&
+	 (mItv0->line == iWSp.linpos) &&
 	 (iWSp.lftpos <= mItv0->rgtI) &&
 	 (iWSp.rgtpos >= mItv0->lftI))
       {
@@ -4126,9 +4314,9 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 	 * interval. */
 	mItv1 = mItv0;
 	mItvIdx1 = mItvIdx0;
-	while((mItv1->line == iWSp.linpos) &&
-	      (mItv1->lftI <= iWSp.rgtpos) &&
-	      (mItvIdx1 < mSWSp->nItvs))
+	while((mItvIdx1 < mSWSp->nItvs) &&
+	      (mItv1->line == iWSp.linpos) &&
+	      (mItv1->lftI <= iWSp.rgtpos))
 	{
 	  ++mItvIdx1;
 	  ++mItv1;
@@ -4138,9 +4326,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 	/* For each mesh interval which intersects the current grey interval. */
 	while(mItv1 <= mItv2)
 	{
-	  /* Update mesh scanning. */
 	  sElm = mSWSp->dElm + mItv1->elmIdx;
-	  WlzCMeshUpdateScanElm2D(mSWSp->mTr, sElm, 0);
 	  trXX = sElm->trX[0];
 	  trXYC = (sElm->trX[1] * iWSp.linpos) + sElm->trX[2];
 	  trYX = sElm->trY[0];
@@ -4546,7 +4732,6 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
   }
   AlcFree(olpBuf.inp);
   AlcFree(olpCnt);
-  WlzCMeshScanWSpFree2D(mSWSp);
   WlzGreyValueFreeWSp(gVWSp);
   return(errNum);
 }
@@ -5082,6 +5267,128 @@ static void	WlzCMeshScanWSpFree3D(WlzCMeshScanWSp3D *mSWSp)
   }
 }
 
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Computes the (destination to source) transform of every
+*		element in a 2D conforming mesh scan workspace, so that
+*		the workspace need only be read while scanning.
+* \param	mSWSp			Conforming mesh scan workspace.
+*/
+static void	WlzCMeshScanElmsUpdate2D(WlzCMeshScanWSp2D *mSWSp)
+{
+  int		idE,
+  		nElm;
+
+  nElm = mSWSp->mTr->domain.cm2->res.elm.maxEnt;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(idE = 0; idE < nElm; ++idE)
+  {
+    WlzCMeshScanElm2D *sE;
+
+    sE = mSWSp->dElm + idE;
+    if(sE->idx >= 0)
+    {
+      WlzCMeshUpdateScanElm2D(mSWSp->mTr, sE, 0);
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Computes the (destination to source) transform of every
+*		element in a 3D conforming mesh scan workspace, so that
+*		the workspace need only be read while scanning.
+* \param	mSWSp			Conforming mesh scan workspace.
+*/
+static void	WlzCMeshScanElmsUpdate3D(WlzCMeshScanWSp3D *mSWSp)
+{
+  int		idE,
+  		nElm;
+
+  nElm = mSWSp->mTr->domain.cm3->res.elm.maxEnt;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(idE = 0; idE < nElm; ++idE)
+  {
+    WlzCMeshScanElm3D *sE;
+
+    sE = mSWSp->dElm + idE;
+    if(sE->idx >= 0)
+    {
+      WlzCMeshUpdateScanElm3D(mSWSp->mTr, sE, 0);
+    }
+  }
+}
+
+/*!
+* \return	Index of the first interval on or after the given line,
+*		which will be the number of intervals if there is none.
+* \ingroup	WlzTransform
+* \brief	Finds the first of the sorted intervals of a 2D conforming
+*		mesh scan workspace which is on or after the given line.
+* \param	mSWSp			Conforming mesh scan workspace.
+* \param	ln			Given line.
+*/
+static int	WlzCMeshScanItvFirstLine2D(WlzCMeshScanWSp2D *mSWSp, int ln)
+{
+  int		lo = 0,
+  		hi;
+
+  hi = mSWSp->nItvs;
+  while(lo < hi)
+  {
+    int		mid;
+
+    mid = (lo + hi) / 2;
+    if((mSWSp->itvs + mid)->line < ln)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  return(lo);
+}
+
+/*!
+* \return	Index of the first interval on or after the given plane,
+*		which will be the number of intervals if there is none.
+* \ingroup	WlzTransform
+* \brief	Finds the first of the sorted intervals of a 3D conforming
+*		mesh scan workspace which is on or after the given plane.
+* \param	mSWSp			Conforming mesh scan workspace.
+* \param	pl			Given plane.
+*/
+static int	WlzCMeshScanItvFirstPlane3D(WlzCMeshScanWSp3D *mSWSp, int pl)
+{
+  int		lo = 0,
+  		hi;
+
+  hi = mSWSp->nItvs;
+  while(lo < hi)
+  {
+    int		mid;
+
+    mid = (lo + hi) / 2;
+    if((mSWSp->itvs + mid)->plane < pl)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  return(lo);
+}
+
 /*!
 * \return	Number of intervals added from the conforming mesh
 *		scan element.
@@ -6395,15 +6702,18 @@ static WlzCMesh3D *WlzCMeshTransformCMesh3D(WlzCMesh3D *sMesh,
   {
     int		idN,
 		dMaxNod,
-	        tLastElmIdx = -1;
+	        tLastElmIdx = -1,
+		cLastElmIdx = -1;
     AlcVector	*dNV;
     WlzCMesh3D	*tMesh;
+    WlzCMeshCompact3D *cMesh;
     WlzIndexedValues *tIxv;
 
     tMesh = mTrObj->domain.cm3;
     tIxv = mTrObj->values.x;
     dNV = dMesh->res.nod.vec;
     dMaxNod = dMesh->res.nod.maxEnt;
+    cMesh = WlzCMeshTransformCompact3D(tMesh, dMesh->res.nod.numEnt);
     for(idN = 0; idN < dMaxNod; ++idN)
     {
       int	tNearNod;
@@ -6416,9 +6726,9 @@ static WlzCMesh3D *WlzCMeshTransformCMesh3D(WlzCMesh3D *sMesh,
       dNod = (WlzCMeshNod3D *)AlcVectorItemGet(dNV, idN);
       if((dNod != NULL) && (dNod->idx >= 0))
       {
-	if(((sE.idx = WlzCMeshElmEnclosingPos3D(tMesh, tLastElmIdx,
-			    dNod->pos.vtX, dNod->pos.vtY, dNod->pos.vtZ,
-			    0, &tNearNod)) < 0) && (tNearNod < 0))
+	if(((sE.idx = WlzCMeshTransformElmEnclosingPos3D(tMesh, cMesh,
+			    tLastElmIdx, &cLastElmIdx, dNod->pos,
+			    &tNearNod)) < 0) && (tNearNod < 0))
 	{
 	  errNum = WLZ_ERR_DOMAIN_DATA;
 	  break;
@@ -6451,6 +6761,7 @@ static WlzCMesh3D *WlzCMeshTransformCMesh3D(WlzCMesh3D *sMesh,
 	dNod->pos = dVtx;
       }
     }
+    (void )WlzCMeshCompactFree3D(cMesh);
   }
   if(dstErr != NULL)
   {
@@ -6459,6 +6770,82 @@ static WlzCMesh3D *WlzCMeshTransformCMesh3D(WlzCMesh3D *sMesh,
   return(dMesh);
 }
 
+/*!
+* \return	Compact mesh or NULL.
+* \ingroup	WlzTransform
+* \brief	Makes a compact form of the given 3D conforming mesh for
+* 		locating the elements which enclose the given number of
+* 		positions. The compact mesh is only made when there are
+* 		enough positions for its faster element location to
+* 		repay the cost of making it. A NULL return, which is
+* 		also used on failure, just means that the mesh itself
+* 		should be searched.
+* \param	mesh			Given mesh.
+* \param	nPos			Number of positions to be located.
+*/
+static WlzCMeshCompact3D *WlzCMeshTransformCompact3D(WlzCMesh3D *mesh,
+						     int nPos)
+{
+  WlzCMeshCompact3D *cMesh = NULL;
+
+  if((mesh != NULL) && (mesh->res.elm.numEnt > 0) &&
+     (nPos / WLZ_CMESH_COMPACT_MINPOSPERELM >= mesh->res.elm.numEnt))
+  {
+    cMesh = WlzCMeshCompactFromMesh3D(mesh, NULL);
+  }
+  return(cMesh);
+}
+
+/*!
+* \return	Index of the enclosing element in the mesh or a negative
+* 		value if the position is not within an element.
+* \ingroup	WlzTransform
+* \brief	Finds the element of the given mesh which encloses the
+* 		given position, using the compact form of the mesh if
+* 		it is given. When no enclosing element is found using
+* 		the compact mesh the mesh itself is searched, so that
+* 		the nearest node is found for positions outside of the
+* 		mesh just as by WlzCMeshElmEnclosingPos3D().
+* \param	mesh			Given mesh.
+* \param	cMesh			Compact form of the given mesh,
+* 					may be NULL.
+* \param	lastElmIdx		Index of the last element found in
+* 					the mesh, or a negative value.
+* \param	cLastElmIdx		Used to pass and return the index of
+* 					the last element found in the compact
+* 					mesh, initially a negative value.
+* \param	pos			Given position.
+* \param	dstNearNod		Destination pointer for the index of
+* 					the nearest node, only set when the
+* 					mesh itself is searched.
+*/
+static int	WlzCMeshTransformElmEnclosingPos3D(WlzCMesh3D *mesh,
+					WlzCMeshCompact3D *cMesh,
+					int lastElmIdx, int *cLastElmIdx,
+					WlzDVertex3 pos, int *dstNearNod)
+{
+  int		elmIdx = -1;
+
+  if(cMesh != NULL)
+  {
+    int		cElmIdx;
+
+    cElmIdx = WlzCMeshCompactElmEnclosingPos3D(cMesh, *cLastElmIdx, pos);
+    if(cElmIdx >= 0)
+    {
+      *cLastElmIdx = cElmIdx;
+      elmIdx = cMesh->elmIdx[cElmIdx];
+    }
+  }
+  if(elmIdx < 0)
+  {
+    elmIdx = WlzCMeshElmEnclosingPos3D(mesh, lastElmIdx,
+				       pos.vtX, pos.vtY, pos.vtZ,
+				       0, dstNearNod);
+  }
+  return(elmIdx);
+}
+
 /*!
 * \return	Transformed boundary list or NULL on error.
 * \ingroup	WlzTransform
@@ -7285,6 +7672,9 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
 * \ingroup	WlzTransform
 * \brief	Fills in the destination object's values from the source
 *		object, using the mesh scan workspace.
+*		The destination planes are partitioned into contiguous
+*		bands which are filled concurrently, each band having
+*		it's own overlap buffers and grey value workspace.
 * \param	dstObj			Destination object with values to be
 *					set.
 * \param	srcObj			Source object.
@@ -7297,6 +7687,83 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
 					WlzObject *srcObj,
 					WlzCMeshScanWSp3D *mSWSp,
 					WlzInterpolationType interp)
+{
+  int		idB,
+  		nBnd,
+		nPln,
+		pln0,
+		nThr = 1;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  WlzCMeshScanElmsUpdate3D(mSWSp);
+#ifdef _OPENMP
+#pragma omp parallel
+  {
+#pragma omp master
+    {
+      nThr = omp_get_num_threads();
+    }
+  }
+#endif
+  pln0 = dstObj->domain.p->plane1;
+  nPln = dstObj->domain.p->lastpl - pln0 + 1;
+  /* Use a few bands per thread so that the load is balanced even though
+   * the number of intervals per plane varies. */
+  nBnd = ALG_MIN(nPln, 4 * nThr);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
+#endif
+  for(idB = 0; idB < nBnd; ++idB)
+  {
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzErrorNum errNum2;
+
+      errNum2 = WlzCMeshScanObjValuesPlanes3D(dstObj, srcObj, mSWSp, interp,
+      				pln0 + (int )(((long )nPln * idB) / nBnd),
+				pln0 + (int )(((long )nPln * (idB + 1)) / nBnd) - 1);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshScanObjValues3D)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Fills in the destination object's values from the source
+*		object, using the mesh scan workspace, for a band of
+*		planes. The element transforms of the mesh scan workspace
+*		must already have been computed using
+*		WlzCMeshScanElmsUpdate3D(), so that bands of planes may be
+*		filled concurrently.
+* \param	dstObj			Destination object with values to be
+*					set.
+* \param	srcObj			Source object.
+* \param	mSWSp			Mesh scan workspace which was used to
+*					compute the destination object's
+*					domain.
+* \param	interp			Interpolation type.
+* \param	pln0			First plane of the band.
+* \param	pln1			Last plane of the band.
+*/
+static WlzErrorNum WlzCMeshScanObjValuesPlanes3D(WlzObject *dstObj,
+					WlzObject *srcObj,
+					WlzCMeshScanWSp3D *mSWSp,
+					WlzInterpolationType interp,
+					int pln0,
+					int pln1)
 {
   int		idP,
   		idI,
@@ -7351,17 +7818,17 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    mItvIdx0 = 0;
-    mItv0 = mSWSp->itvs;
+    mItvIdx0 = WlzCMeshScanItvFirstPlane3D(mSWSp, pln0);
+    mItv0 = mSWSp->itvs + mItvIdx0;
     gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    idP = 0;
     dom3.p = dstObj->domain.p;
     val3.vox = dstObj->values.vox;
-    dPos.vtZ = dom3.p->plane1;
-    while((errNum == WLZ_ERR_NONE) && (dPos.vtZ < dom3.p->lastpl))
+    idP = pln0 - dom3.p->plane1;
+    dPos.vtZ = pln0;
+    while((errNum == WLZ_ERR_NONE) && (dPos.vtZ <= pln1))
     {
       if(((dom2 = *(dom3.p->domains + idP)).core != NULL) &&
          (dom2.core->type != WLZ_EMPTY_DOMAIN))
@@ -7384,24 +7851,25 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
 	  /* Update the mesh interval pointer so that it points to the
 	   * first mesh interval on the which intersects the current grey
 	   * interval. */
-	  while((mItv0->plane < dPos.vtZ) && (mItvIdx0 < mSWSp->nItvs))
+	  while((mItvIdx0 < mSWSp->nItvs) && (mItv0->plane < dPos.vtZ))
 	  {
 	    ++mItvIdx0;
 	    ++mItv0;
 	  }
-	  while((mItv0->line < iWSp.linpos) && (mItvIdx0 < mSWSp->nItvs))
+	  while((mItvIdx0 < mSWSp->nItvs) && (mItv0->line < iWSp.linpos))
 	  {
 	    ++mItvIdx0;
 	    ++mItv0;
 	  }
-	  while((mItv0->line <= iWSp.linpos) &&
-		(mItv0->rgtI < iWSp.lftpos) &&
-		(mItvIdx0 < mSWSp->nItvs))
+	  while((mItvIdx0 < mSWSp->nItvs) &&
+		(mItv0->line <= iWSp.linpos) &&
+		(mItv0->rgtI < iWSp.lftpos))
 	  {
 	    ++mItvIdx0;
 	    ++mItv0;
 	  }
-	  if((mItv0->line == iWSp.linpos) &&
+	  if((mItvIdx0 < mSWSp->nItvs) &&
+	     (mItv0->line == iWSp.linpos) &&
 	     (iWSp.lftpos <= mItv0->rgtI) &&
 	     (iWSp.rgtpos >= mItv0->lftI))
 	  {
@@ -7410,9 +7878,9 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
 	     * grey interval. */
 	    mItv1 = mItv0;
 	    mItvIdx1 = mItvIdx0;
-	    while((mItv1->line == iWSp.linpos) &&
-		  (mItv1->lftI <= iWSp.rgtpos) &&
-		  (mItvIdx1 < mSWSp->nItvs))
+	    while((mItvIdx1 < mSWSp->nItvs) &&
+		  (mItv1->line == iWSp.linpos) &&
+		  (mItv1->lftI <= iWSp.rgtpos))
 	    {
 	      ++mItvIdx1;
 	      ++mItv1;
@@ -7430,12 +7898,7 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
 		     mItv1->elmIdx,
 		     mItv1->lftI, mItv1->rgtI, mItv1->line, mItv1->plane);
 #endif
-	      /* Update mesh scanning. */
 	      sE = mSWSp->dElm + mItv1->elmIdx;
-	      if((sE->flags & WLZ_CMESH_SCANELM_REV) == 0)
-	      {
-	         WlzCMeshUpdateScanElm3D(mSWSp->mTr, sE, 0);
-	      }
 	      tV.vtX = (sE->tr[ 1] * dPos.vtY) + (sE->tr[ 2] * dPos.vtZ) +
 		       sE->tr[ 3];
 	      tV.vtY = (sE->tr[ 5] * dPos.vtY) + (sE->tr[ 6] * dPos.vtZ) +
@@ -43,9 +43,14 @@ static char _WlzContour_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <limits.h>
 #include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <Wlz.h>
 
 #define WLZ_CTR_TOLERANCE	(1.0e-06)
+#define WLZ_CONTOUR_SLAB_SZ	(16)   /* Number of planes in a slab of a 3D
+					* object for contour extraction. */
 
 /* #define WLZ_CONTOUR_DEBUG */
 
@@ -82,6 +87,96 @@ typedef enum _WlzContourBndSamMethod
   WLZ_CONTOUR_BNDPTS_RANDOM
 } WlzContourBndSamMethod;
 
+/*!
+* \struct	_WlzContourSpxBuf3D
+* \ingroup	WlzContour
+* \brief	Destination for the 3D simplices (triangles) of a contour.
+*		If the model is non-NULL simplices are added to it
+*		directly, otherwise they are appended to the buffer so
+*		that they can be added to a model later in the same order.
+*		Before buffered simplices are added to a model their
+*		vertices may be welded, giving each distinct vertex of
+*		the buffer an index.
+*		Typedef: ::WlzContourSpxBuf3D.
+*/
+typedef struct _WlzContourSpxBuf3D
+{
+  WlzGMModel	*model;			/*!< Model to add simplices to, may
+  					     be NULL. */
+  int		nSpx;			/*!< Number of simplices in the
+  					     buffer. */
+  int		maxSpx;			/*!< Space allocated for simplices. */
+  WlzDVertex3	*pos;			/*!< Simplex vertex positions, three
+  					     for each simplex. */
+  int		nVtx;			/*!< Number of distinct vertices
+  					     of the welded simplices. */
+  int		maxWld;			/*!< Space allocated for the weld
+  					     vertex arrays. */
+  int		maxHT;			/*!< Space allocated for the weld
+  					     hash table. */
+  int		*vIdx;			/*!< Distinct vertex index for each
+  					     simplex vertex, with the first
+					     set to -1 for a degenerate
+					     simplex. */
+  int		*vFst;			/*!< Index of the first simplex
+  					     vertex of each distinct vertex. */
+  int		*vNxt;			/*!< Next distinct vertex in the
+  					     weld hash table chain. */
+  int		*vHT;			/*!< Weld hash table. */
+  unsigned int	*vHV;			/*!< Hash value of each distinct
+  					     vertex. */
+  WlzGMVertex	**vGM;			/*!< Model vertex of each distinct
+  					     vertex, NULL until created. */
+  double	maxZ;			/*!< Maximum z coordinate of the
+  					     distinct vertices, or for a
+					     destination with a model the
+					     maximum of the vertices which
+					     have been merged into it. */
+} WlzContourSpxBuf3D;
+
+/*!
+* \typedef	WlzContourSlabFn3D
+* \ingroup	WlzContour
+* \brief	Function which computes the simplices of a slab of planes
+*		of a 3D object, with the planes given by their indices
+*		relative to the first plane of the object. The simplices
+*		must be appended to the given buffer in the order in
+*		which a single sweep through all the planes would create
+*		them.
+*/
+typedef WlzErrorNum (*WlzContourSlabFn3D)(void *data, int pn0, int pn1,
+					  WlzContourSpxBuf3D *spx);
+
+/*!
+* \struct	_WlzContourIsoSlabData3D
+* \ingroup	WlzContour
+* \brief	Data for computing iso-value contour slabs.
+*		Typedef: ::WlzContourIsoSlabData3D.
+*/
+typedef struct _WlzContourIsoSlabData3D
+{
+  WlzObject	*obj;			/*!< Given 3D object. */
+  double	isoVal;			/*!< The iso-value. */
+  WlzIBox3	bBox;			/*!< Bounding box of the object. */
+} WlzContourIsoSlabData3D;
+
+/*!
+* \struct	_WlzContourGrdSlabData3D
+* \ingroup	WlzContour
+* \brief	Data for computing maximal gradient contour slabs.
+*		Typedef: ::WlzContourGrdSlabData3D.
+*/
+typedef struct _WlzContourGrdSlabData3D
+{
+  WlzObject	*obj;			/*!< Given 3D object. */
+  WlzObject	*zObj;			/*!< Partial derivatives through
+  					     planes. */
+  WlzRsvFilter	*ftr;			/*!< Derivative filter. */
+  double	grdLoSq;		/*!< Square of the lower gradient
+  					     threshold. */
+  WlzIBox3	bBox;			/*!< Bounding box of the object. */
+} WlzContourGrdSlabData3D;
+
 static WlzContour	*WlzContourIsoObj2D(
 			  WlzObject *srcObj,
 			  double isoVal,
@@ -196,6 +291,39 @@ static WlzErrorNum 	WlzContourBndEmptyPlane3D(
 			  WlzUByte **itvBuf,
 			  WlzIVertex2 bufOrg,
 			  WlzIVertex2 bufSz);
+static WlzErrorNum	WlzContourIsoSpx3D(
+			  WlzObject *srcObj,
+			  double isoVal,
+			  WlzContourSpxBuf3D *dst);
+static WlzErrorNum	WlzContourGrdSpx3D(
+			  WlzObject *srcObj,
+			  double grdLo,
+			  double grdHi,
+			  double ftrPrm,
+			  WlzContourSpxBuf3D *dst);
+static WlzErrorNum	WlzContourSlabs3D(
+			  WlzContourSpxBuf3D *dst,
+			  int pnCnt,
+			  WlzContourSlabFn3D fn,
+			  void *data);
+static WlzErrorNum	WlzContourIsoSlab3D(
+			  void *data,
+			  int pn0,
+			  int pn1,
+			  WlzContourSpxBuf3D *spx);
+static WlzErrorNum	WlzContourGrdSlab3D(
+			  void *data,
+			  int pn0,
+			  int pn1,
+			  WlzContourSpxBuf3D *spx);
+static WlzErrorNum	WlzContourSpxBufAdd3D(
+			  WlzContourSpxBuf3D *spx,
+			  WlzDVertex3 *pos);
+static WlzErrorNum	WlzContourSpxBufWeld3D(
+			  WlzContourSpxBuf3D *spx);
+static WlzErrorNum	WlzContourSpxBufMerge3D(
+			  WlzContourSpxBuf3D *dst,
+			  WlzContourSpxBuf3D *spx);
 static WlzErrorNum	WlzContourIsoCube2D(
 			  WlzContour *ctr,
 			  double isoVal,
@@ -203,7 +331,7 @@ static WlzErrorNum	WlzContourIsoCube2D(
 			  double *ln1,
 			  WlzDVertex2 sqOrg);
 static WlzErrorNum 	WlzContourGrdCube3D(
-			  WlzContour *ctr,
+			  WlzContourSpxBuf3D *spx,
 			  WlzUByte ***mBuf,
 			  double ***zBuf,
 			  double ***yBuf,
@@ -211,7 +339,7 @@ static WlzErrorNum 	WlzContourGrdCube3D(
 			  int *bufIdx,
 			  WlzIVertex3 bufPos,
 			  WlzIVertex3 cbOrg);
-static WlzErrorNum	WlzContourIsoCube3D6T(WlzContour *ctr,
+static WlzErrorNum	WlzContourIsoCube3D6T(WlzContourSpxBuf3D *spx,
 			  double isoVal,
 			  double *pn0ln0,
 			  double *pn0ln1,
@@ -219,7 +347,7 @@ static WlzErrorNum	WlzContourIsoCube3D6T(WlzContour *ctr,
 			  double *pn1ln1,
 			  WlzDVertex3 cbOrg);
 static WlzErrorNum	WlzContourIsoTet3D(
-			  WlzContour *ctr,
+			  WlzContourSpxBuf3D *spx,
 			  double *tVal,
 			  WlzDVertex3 *tPos,
 			  WlzDVertex3 cbOrg);
@@ -234,7 +362,7 @@ static WlzErrorNum	WlzContourGrdLink2D(
 			  double **grdXBuf,
 			  double **grdYBuf);
 static WlzErrorNum	WlzContourGrdLink3D(
-			  WlzContour *ctr,
+			  WlzContourSpxBuf3D *spx,
 			  WlzUByte ***mBuf,
 			  int *bufIdx,
 			  WlzIVertex3 bufPos,
@@ -453,6 +581,102 @@ WlzContour	*WlzContourObj(WlzObject *srcObj, WlzContourMethod ctrMtd,
   return(ctr);
 }
 
+/*!
+* \return	New indexed surface or NULL on error.
+* \ingroup	WlzContour
+* \brief	Computes a 3D contour from the given object as an indexed
+* 		surface, see WlzContourObj() for the methods and their
+* 		parameters.
+* 		For iso-value and maximal gradient contours of 3D domain
+* 		objects the surface is built directly from the simplices
+* 		of the contour, without building a geometric model.
+* 		Other contours are computed using WlzContourObj() and
+* 		then converted using WlzIndexedSurfaceFromGMModel().
+* \param	srcObj			Given object.
+* \param	ctrMtd			Contour generation method.
+* \param	ctrVal			Contour value.
+* \param	ctrWth			Contour (filter) width.
+* \param	nrmFlg			Compute vertex normals if non-zero.
+* \param	dstErr			Destination error pointer, may
+*                                       be NULL.
+*/
+WlzIndexedSurface *WlzContourObjIndexedSurface(WlzObject *srcObj,
+					WlzContourMethod ctrMtd,
+					double ctrVal, double ctrWth,
+					int nrmFlg, WlzErrorNum *dstErr)
+{
+  WlzIndexedSurface *srf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(srcObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(srcObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((srcObj->type == WLZ_3D_DOMAINOBJ) &&
+          ((ctrMtd == WLZ_CONTOUR_MTD_ISO) ||
+	   (ctrMtd == WLZ_CONTOUR_MTD_GRD)))
+  {
+    WlzContourSpxBuf3D spx;
+
+    spx.model = NULL;
+    spx.nSpx = spx.maxSpx = 0;
+    spx.pos = NULL;
+    if(ctrMtd == WLZ_CONTOUR_MTD_ISO)
+    {
+      errNum = WlzContourIsoSpx3D(srcObj, ctrVal, &spx);
+    }
+    else
+    {
+      errNum = WlzContourGrdSpx3D(srcObj, ctrVal, ctrVal, ctrWth, &spx);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      srf = WlzIndexedSurfaceFromTriangles(spx.nSpx, spx.pos, &errNum);
+    }
+    AlcFree(spx.pos);
+    /* Scale surface using object voxel size. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzDVertex3 vSz;
+
+      vSz.vtX = srcObj->domain.p->voxel_size[0];
+      vSz.vtY = srcObj->domain.p->voxel_size[1];
+      vSz.vtZ = srcObj->domain.p->voxel_size[2];
+      errNum = WlzIndexedSurfaceScale(srf, vSz);
+    }
+  }
+  else
+  {
+    WlzDomain	dom;
+
+    dom.ctr = WlzContourObj(srcObj, ctrMtd, ctrVal, ctrWth, nrmFlg, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dom = WlzAssignDomain(dom, NULL);
+      srf = WlzIndexedSurfaceFromGMModel(dom.ctr->model, &errNum);
+      (void )WlzFreeContour(dom.ctr);
+    }
+  }
+  if(nrmFlg && (errNum == WLZ_ERR_NONE) && (srf->nrm == NULL))
+  {
+    errNum = WlzIndexedSurfaceSetNormals(srf);
+  }
+  if((errNum != WLZ_ERR_NONE) && (srf != NULL))
+  {
+    (void )WlzFreeIndexedSurface(srf);
+    srf = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(srf);
+}
+
 /*!
 * \return	New contour or NULL on error.
 * \ingroup	WlzContour
@@ -1064,36 +1288,63 @@ static WlzContour *WlzContourIsoObj2D(WlzObject *srcObj, double isoVal,
 static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
 				      WlzErrorNum *dstErr)
 {
-  int		klIdx,
-  		lnIdx,
-		pnIdx,
-		klCnt,
-  		lnCnt,
-		pnCnt,
-  		bufIdx0,
-  		bufIdx1,
-		lastKlIn,
-		thisKlIn;
-  WlzObject	*obj2D = NULL;
-  WlzValues	dummyValues;
-  WlzDomain	dummyDom,
-  		srcDom;
-  WlzIVertex2	bufSz,
-		bufOff;
-  WlzIBox2	bBox2D;
-  WlzIBox3	bBox3D;
-  WlzDVertex3	cbOrg;
-  WlzUByte	*tUP0,
-  		*tUP1,
-		*tUP2,
-		*tUP3;
-  WlzUByte	**itvBuf[2] = {NULL, NULL};
-  double	**valBuf[2] = {NULL, NULL};
+  WlzContourSpxBuf3D spx;
   WlzContour 	*ctr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  dummyDom.core = NULL;
-  dummyValues.core = NULL;
+  /* Create contour. */
+  if((ctr = WlzMakeContour(&errNum)) != NULL)
+  {
+    ctr->model = WlzAssignGMModel(
+		 WlzGMModelNew(WLZ_GMMOD_3D, 0, 0, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    spx.model = ctr->model;
+    spx.nSpx = spx.maxSpx = 0;
+    spx.pos = NULL;
+    errNum = WlzContourIsoSpx3D(srcObj, isoVal, &spx);
+  }
+  /* Scale model using object voxel size. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzContourScaleModelVoxSz(ctr->model, srcObj->domain.p);
+  }
+  /* Tidy up on error. */
+  if((errNum != WLZ_ERR_NONE) && (ctr != NULL))
+  {
+    (void )WlzFreeContour(ctr);
+    ctr = NULL;
+  }
+  /* Set error code. */
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(ctr);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Computes the simplices of an iso-value contour of a 3D
+*		Woolz object's values, adding them to the given simplex
+*		buffer. The object is split into slabs of planes which
+*		are processed in parallel, with the simplices of each
+*		slab then added in plane order. The simplices are the
+*		same as those from a single sweep through the planes.
+* \param	srcObj			Given object from which to
+*                                       compute the contours.
+* \param	isoVal			The iso-value.
+* \param	dst			Destination for the simplices.
+*/
+static WlzErrorNum WlzContourIsoSpx3D(WlzObject *srcObj, double isoVal,
+				      WlzContourSpxBuf3D *dst)
+{
+  WlzDomain	srcDom;
+  WlzContourIsoSlabData3D slb;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
   if((srcDom = srcObj->domain).core == NULL)
   {
     errNum = WLZ_ERR_DOMAIN_NULL;
@@ -1117,31 +1368,76 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Create contour. */
-    if((ctr = WlzMakeContour(&errNum)) != NULL)
-    {
-      ctr->model = WlzAssignGMModel(
-      		   WlzGMModelNew(WLZ_GMMOD_3D, 0, 0, &errNum), NULL);
-    }
+    slb.bBox = WlzBoundingBox3I(srcObj, &errNum);
   }
+  /* Sweep down through the object in slabs of planes. */
   if(errNum == WLZ_ERR_NONE)
   {
-    bBox3D = WlzBoundingBox3I(srcObj, &errNum);
+    slb.obj = srcObj;
+    slb.isoVal = isoVal;
+    errNum = WlzContourSlabs3D(dst, srcDom.p->lastpl - srcDom.p->plane1 + 1,
+			       WlzContourIsoSlab3D, &slb);
   }
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Computes the iso-value contour simplices of a slab of
+*		planes of a 3D object, sweeping down through the slab
+*		using a pair of plane buffers. The cubes between each
+*		plane of the slab and the plane before it are processed.
+* \param	data			Iso-value slab data.
+* \param	pn0			First plane of the slab.
+* \param	pn1			Last plane of the slab.
+* \param	spx			Destination for the simplices.
+*/
+static WlzErrorNum WlzContourIsoSlab3D(void *data, int pn0, int pn1,
+				       WlzContourSpxBuf3D *spx)
+{
+  int		klIdx,
+  		lnIdx,
+		pnIdx,
+		klCnt,
+  		lnCnt,
+  		bufIdx0,
+  		bufIdx1,
+		lastKlIn,
+		thisKlIn;
+  WlzObject	*obj2D = NULL;
+  WlzObject	*srcObj;
+  WlzValues	dummyValues;
+  WlzDomain	dummyDom;
+  WlzIVertex2	bufSz,
+		bufOff;
+  WlzIBox2	bBox2D;
+  WlzIBox3	bBox3D;
+  WlzDVertex3	cbOrg;
+  WlzUByte	*tUP0,
+  		*tUP1,
+		*tUP2,
+		*tUP3;
+  WlzUByte	**itvBuf[2] = {NULL, NULL};
+  double	**valBuf[2] = {NULL, NULL};
+  WlzContourIsoSlabData3D *slb;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  slb = (WlzContourIsoSlabData3D *)data;
+  srcObj = slb->obj;
+  bBox3D = slb->bBox;
+  dummyDom.core = NULL;
+  dummyValues.core = NULL;
   /* Make buffers. */
-  if(errNum == WLZ_ERR_NONE)
+  bufSz.vtX = bBox3D.xMax - bBox3D.xMin + 1;
+  bufSz.vtY = bBox3D.yMax - bBox3D.yMin + 1;
+  if((AlcBit2Calloc(&(itvBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcBit2Calloc(&(itvBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(valBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(valBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
   {
-    bufSz.vtX = bBox3D.xMax - bBox3D.xMin + 1;
-    bufSz.vtY = bBox3D.yMax - bBox3D.yMin + 1;
-    if((AlcBit2Calloc(&(itvBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcBit2Calloc(&(itvBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(valBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(valBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-    {
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
+    errNum = WLZ_ERR_MEM_ALLOC;
   }
-  /* Sweep down through the object using a pair of plane buffers. */
   if(errNum == WLZ_ERR_NONE)
   {
     obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dummyDom, dummyValues,
@@ -1149,9 +1445,10 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    pnIdx = 0;
-    pnCnt = srcObj->domain.p->lastpl - srcObj->domain.p->plane1 + 1;
-    while((errNum == WLZ_ERR_NONE) && (pnCnt-- > 0))
+    /* Start with the plane before the slab so that the cubes between it
+     * and the first plane of the slab are processed. */
+    pnIdx = (pn0 > 0)? pn0 - 1: 0;
+    while((errNum == WLZ_ERR_NONE) && (pnIdx <= pn1))
     {
       cbOrg.vtZ = bBox3D.zMin + pnIdx;
       bufIdx0 = (pnIdx + 1) % 2;
@@ -1175,12 +1472,12 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
       {
 	/* Compute the intersection of the iso-value plane with each cube
 	 * of values. */
-	if(pnIdx > 0)
+	if((pnIdx > 0) && (pnIdx >= pn0))
 	{
 	  klCnt = bBox2D.xMax - bBox2D.xMin; 			  /* NOT + 1 */
 	  lnIdx = bBox2D.yMin - bBox3D.yMin;
 	  lnCnt = bBox2D.yMax - bBox2D.yMin; 			  /* NOT + 1 */
-	  while(lnIdx < lnCnt)
+	  while((errNum == WLZ_ERR_NONE) && (lnIdx < lnCnt))
 	  {
             cbOrg.vtY = bBox3D.yMin + lnIdx;
 	    tUP0 = *(itvBuf[bufIdx0] + lnIdx);
@@ -1192,7 +1489,7 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
 	    	       (WLZ_BIT_GET(tUP1, klIdx) != 0) &&
 		       (WLZ_BIT_GET(tUP2, klIdx) != 0) &&
 		       (WLZ_BIT_GET(tUP3, klIdx) != 0);
-	    while(klIdx < klCnt)
+	    while((errNum == WLZ_ERR_NONE) && (klIdx < klCnt))
 	    {
 	      /* Check if cube is within the 3D object's domain. */
 	      thisKlIn = (WLZ_BIT_GET(tUP0, klIdx + 1) != 0) &&
@@ -1202,7 +1499,7 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
 	      if(lastKlIn && thisKlIn)
 	      {
                 cbOrg.vtX = bBox3D.xMin + klIdx;
-		errNum = WlzContourIsoCube3D6T(ctr, isoVal,
+		errNum = WlzContourIsoCube3D6T(spx, slb->isoVal,
 				       *(valBuf[bufIdx0] + lnIdx) + klIdx,
 				       *(valBuf[bufIdx0] + lnIdx + 1) + klIdx,
 				       *(valBuf[bufIdx1] + lnIdx) + klIdx,
@@ -1220,19 +1517,8 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
     }
     obj2D->domain = dummyDom;
     obj2D->values = dummyValues;
-    (void )WlzFreeObj(obj2D);
-  }
-  /* Scale model using object voxel size. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    errNum = WlzContourScaleModelVoxSz(ctr->model, srcDom.p);
-  }
-  /* Tidy up on error. */
-  if((errNum != WLZ_ERR_NONE) && (ctr != NULL))
-  {
-    (void )WlzFreeContour(ctr);
-    ctr = NULL;
   }
+  (void )WlzFreeObj(obj2D);
   /* Free buffers. */
   for(pnIdx = 0; pnIdx < 2; ++pnIdx)
   {
@@ -1245,12 +1531,7 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
       Alc2Free((void **)valBuf[pnIdx]);
     }
   }
-  /* Set error code. */
-  if(dstErr)
-  {
-    *dstErr = errNum;
-  }
-  return(ctr);
+  return(errNum);
 }
 
 /*!
@@ -1689,49 +1970,70 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
 				      WlzErrorNum *dstErr)
 {
   /* TODO use nrmFlg */
-  int		cnt,
-  		idX,
-		idY,
-		idZ,
-		pnIdx,
-  		pnCnt,
-		cbInObj;
-  double	gV,
-  		sGV,
-		grdLoSq;
+  WlzContourSpxBuf3D spx;
+  WlzContour 	*ctr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Create contour. */
+  if((ctr = WlzMakeContour(&errNum)) != NULL)
+  {
+    ctr->model = WlzAssignGMModel(
+		 WlzGMModelNew(WLZ_GMMOD_3D, 0, 0, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    spx.model = ctr->model;
+    spx.nSpx = spx.maxSpx = 0;
+    spx.pos = NULL;
+    errNum = WlzContourGrdSpx3D(srcObj, grdLo, grdHi, ftrPrm, &spx);
+  }
+  /* Scale model using object voxel size. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzContourScaleModelVoxSz(ctr->model, srcObj->domain.p);
+  }
+  /* Tidy up on error. */
+  if((errNum != WLZ_ERR_NONE) && (ctr != NULL))
+  {
+    (void )WlzFreeContour(ctr);
+    ctr = NULL;
+  }
+  /* Set error code. */
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(ctr);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Computes the simplices of a maximal gradient contour of
+*		a 3D Woolz object's values, adding them to the given
+*		simplex buffer. The object is split into slabs of planes
+*		which are processed in parallel, with the simplices of
+*		each slab then added in plane order. The simplices are
+*		the same as those from a single sweep through the planes.
+* \param	srcObj			Given object from which to
+*                                       compute the contours.
+* \param	grdLo			Lower threshold for modulus of
+*                                       gradient.
+* \param	grdHi			Upper threshold for modulus of
+*                                       gradient. TODO use grdHi!
+* \param	ftrPrm			Filter width parameter.
+* \param	dst			Destination for the simplices.
+*/
+static WlzErrorNum WlzContourGrdSpx3D(WlzObject *srcObj,
+				      double grdLo, double grdHi,
+				      double ftrPrm, WlzContourSpxBuf3D *dst)
+{
   WlzDomain	srcDom;
-  WlzUByte	*iMP,
-	  	*iMC,
-	  	*iMN;
   WlzRsvFilter	*ftr = NULL;
-  WlzObject	*srcObj2D = NULL,
-  		*xObj2D = NULL,
-  		*yObj2D = NULL,
-		*zObj2D = NULL,
-  		*zObj = NULL;
-  WlzContour 	*ctr = NULL;
-  WlzIVertex3	bufPos,
-  		cbOrg;
-  WlzIVertex2	bufSz,
-  		bufOff,
-		bufOrg;
-  WlzIBox2	bBox2D;
-  WlzIBox3	bBox3D = {0};        /* Avoids invalid uninitialized warning. */
-  int		bufIdx[3],
-  		iBufClr[3];
-  WlzUByte	**iBuf[3],
-  		**mBuf[3];
-  double	**xBuf[3],
-  		**yBuf[3],
-		**zBuf[3];
+  WlzObject	*zObj = NULL;
+  WlzContourGrdSlabData3D slb;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  iBufClr[0] = iBufClr[1] = iBufClr[2] = 1;
-  iBuf[0] = iBuf[1] = iBuf[2] = NULL;
-  mBuf[0] = mBuf[1] = mBuf[2] = NULL;
-  xBuf[0] = xBuf[1] = xBuf[2] = NULL;
-  yBuf[0] = yBuf[1] = yBuf[2] = NULL;
-  zBuf[0] = zBuf[1] = zBuf[2] = NULL;
   if(srcObj->values.core == NULL)
   {
     errNum = WLZ_ERR_VALUES_NULL;
@@ -1754,20 +2056,7 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Create contour. */
-    if((ctr = WlzMakeContour(&errNum)) != NULL)
-    {
-      ctr->model = WlzAssignGMModel(
-      		   WlzGMModelNew(WLZ_GMMOD_3D, 0, 0, &errNum), NULL);
-    }
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    bBox3D = WlzBoundingBox3I(srcObj, &errNum);
-    bufSz.vtX = bBox3D.xMax - bBox3D.xMin + 1;
-    bufSz.vtY = bBox3D.yMax - bBox3D.yMin + 1;
-    bufOrg.vtX = bBox3D.xMin;
-    bufOrg.vtY = bBox3D.yMin;
+    slb.bBox = WlzBoundingBox3I(srcObj, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1785,42 +2074,124 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
 	     		     &errNum), NULL);
     }
   }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    /* Create buffers. */
-    if((AlcUnchar2Calloc(&(mBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcUnchar2Calloc(&(mBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcUnchar2Calloc(&(mBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcBit2Calloc(&(iBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcBit2Calloc(&(iBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcBit2Calloc(&(iBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(xBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(xBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(xBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(yBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(yBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(yBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(zBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(zBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(zBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-    {
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
-  }
-  /* Work down through the object. */
+  /* Work down through the object in slabs of planes. */
   if(errNum == WLZ_ERR_NONE)
   {
     /* Enforce a minimum gradient. */
-    if((grdLoSq = grdLo * grdLo) < 1.0)
+    if((slb.grdLoSq = grdLo * grdLo) < 1.0)
     {
-      grdLoSq = 1.0;
+      slb.grdLoSq = 1.0;
     }
-    pnIdx = 0;
-    pnCnt = srcDom.p->lastpl - srcDom.p->plane1 + 1;
-    while((errNum == WLZ_ERR_NONE) && (pnCnt-- > 0))
+    slb.obj = srcObj;
+    slb.zObj = zObj;
+    slb.ftr = ftr;
+    errNum = WlzContourSlabs3D(dst, srcDom.p->lastpl - srcDom.p->plane1 + 1,
+			       WlzContourGrdSlab3D, &slb);
+  }
+  if(zObj)
+  {
+    (void )WlzFreeObj(zObj);
+  }
+  if(ftr)
+  {
+    WlzRsvFilterFreeFilter(ftr);
+  }
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Computes the maximal gradient contour simplices of a
+*		slab of planes of a 3D object, sweeping down through the
+*		slab using three plane buffers. Because the simplices
+*		found for each plane depend on the maximal gradient
+*		voxels of the two planes before it, the sweep starts
+*		three planes before the slab, with the maximal gradient
+*		voxels of the plane before the slab found but not linked.
+* \param	data			Maximal gradient slab data.
+* \param	pn0			First plane of the slab.
+* \param	pn1			Last plane of the slab.
+* \param	spx			Destination for the simplices.
+*/
+static WlzErrorNum WlzContourGrdSlab3D(void *data, int pn0, int pn1,
+				       WlzContourSpxBuf3D *spx)
+{
+  int		cnt,
+  		idX,
+		idY,
+		idZ,
+		pnIdx,
+		cbInObj;
+  double	gV,
+  		sGV;
+  WlzUByte	*iMP,
+	  	*iMC,
+	  	*iMN;
+  WlzObject	*srcObj,
+  		*zObj,
+		*srcObj2D = NULL,
+  		*xObj2D = NULL,
+  		*yObj2D = NULL,
+		*zObj2D = NULL;
+  WlzIVertex3	bufPos,
+  		cbOrg;
+  WlzIVertex2	bufSz,
+  		bufOff,
+		bufOrg;
+  WlzIBox2	bBox2D;
+  WlzIBox3	bBox3D;
+  int		bufIdx[3],
+  		iBufClr[3];
+  WlzUByte	**iBuf[3],
+  		**mBuf[3];
+  double	**xBuf[3],
+  		**yBuf[3],
+		**zBuf[3];
+  WlzContourGrdSlabData3D *slb;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  slb = (WlzContourGrdSlabData3D *)data;
+  srcObj = slb->obj;
+  zObj = slb->zObj;
+  bBox3D = slb->bBox;
+  iBufClr[0] = iBufClr[1] = iBufClr[2] = 1;
+  iBuf[0] = iBuf[1] = iBuf[2] = NULL;
+  mBuf[0] = mBuf[1] = mBuf[2] = NULL;
+  xBuf[0] = xBuf[1] = xBuf[2] = NULL;
+  yBuf[0] = yBuf[1] = yBuf[2] = NULL;
+  zBuf[0] = zBuf[1] = zBuf[2] = NULL;
+  bufSz.vtX = bBox3D.xMax - bBox3D.xMin + 1;
+  bufSz.vtY = bBox3D.yMax - bBox3D.yMin + 1;
+  bufOrg.vtX = bBox3D.xMin;
+  bufOrg.vtY = bBox3D.yMin;
+  /* Create buffers. */
+  if((AlcUnchar2Calloc(&(mBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcUnchar2Calloc(&(mBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcUnchar2Calloc(&(mBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcBit2Calloc(&(iBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcBit2Calloc(&(iBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcBit2Calloc(&(iBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(xBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(xBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(xBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(yBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(yBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(yBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(zBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(zBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(zBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Work down through the slab. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    pnIdx = (pn0 > 3)? pn0 - 3: 0;
+    while((errNum == WLZ_ERR_NONE) && (pnIdx <= pn1))
     { 
 #ifdef WLZ_CONTOUR_DEBUG
-    (void )fprintf(stderr, "WLZ_CONTOUR_DEBUG pnCnt = %d\n", pnCnt);
+    (void )fprintf(stderr, "WLZ_CONTOUR_DEBUG pnIdx = %d\n", pnIdx);
 #endif /* WLZ_CONTOUR_DEBUG */
       bufIdx[0] = (pnIdx + 3 - 2) % 3;
       bufIdx[1] = (pnIdx + 3 - 1) % 3;
@@ -1854,13 +2225,13 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
 	if(errNum == WLZ_ERR_NONE)
 	{
 	  xObj2D = WlzAssignObject(
-	  	   WlzRsvFilterObj(srcObj2D, ftr, WLZ_RSVFILTER_ACTION_X,
+	  	   WlzRsvFilterObj(srcObj2D, slb->ftr, WLZ_RSVFILTER_ACTION_X,
 	  			 &errNum), NULL);
 	}
 	if(errNum == WLZ_ERR_NONE)
 	{
 	  yObj2D = WlzAssignObject(
-	  	   WlzRsvFilterObj(srcObj2D, ftr, WLZ_RSVFILTER_ACTION_Y,
+	  	   WlzRsvFilterObj(srcObj2D, slb->ftr, WLZ_RSVFILTER_ACTION_Y,
 	  			 &errNum), NULL);
 	}
 	/* Update buffers. */
@@ -1907,9 +2278,14 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
 	  {
 	    *iMP++ &= *iMC++ & *iMN++;
 	  }
-	  /* For each cube with all interval mask bits set find the x, y, z
-	   * partial derivatives, cumpute the maximal gradient surface
-	   * elements and add them to the model. */
+	}
+	/* For each cube with all interval mask bits set find the x, y, z
+	 * partial derivatives, cumpute the maximal gradient surface
+	 * elements and add them to the model. Planes before the slab are
+	 * only used to find maximal gradient voxels, these are not linked. */
+	if((errNum == WLZ_ERR_NONE) && (pnIdx >= pn0 - 1) &&
+	   (iBufClr[bufIdx[0]] == 0) && (iBufClr[bufIdx[1]] == 0))
+	{
 	  bufPos.vtZ = bufIdx[0];
           cbOrg.vtZ = bBox3D.zMin + pnIdx - 2;
 	  bufPos.vtY = bufOff.vtY;
@@ -1945,9 +2321,10 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
 		/* If central voxel has a modulus of gradient greater than the
 		 * threshold value then compute the maximal surface
 		 * simplicies and add them to the model. */
-		if(sGV >= grdLoSq)
+		if(sGV >= slb->grdLoSq)
 		{
-		  errNum = WlzContourGrdCube3D(ctr, mBuf, zBuf, yBuf, xBuf,
+		  errNum = WlzContourGrdCube3D((pnIdx < pn0)? NULL: spx,
+		  			       mBuf, zBuf, yBuf, xBuf,
 		  			       bufIdx, bufPos, cbOrg);
 		}
 #ifdef WLZ_CONTOUR_DEBUG
@@ -1987,17 +2364,6 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
       ++pnIdx;
     }
   }
-  /* Scale model using object voxel size. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    errNum = WlzContourScaleModelVoxSz(ctr->model, srcDom.p);
-  }
-  /* Tidy up on error. */
-  if((errNum != WLZ_ERR_NONE) && (ctr != NULL))
-  {
-    (void )WlzFreeContour(ctr);
-    ctr = NULL;
-  }
   /* Free buffer and temporary objects. */
   if(xObj2D)
   {
@@ -2007,10 +2373,6 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
   {
     (void )WlzFreeObj(yObj2D);
   }
-  if(zObj)
-  {
-    (void )WlzFreeObj(zObj);
-  }
   for(idZ = 0; idZ < 3; ++idZ)
   {
     if(iBuf[idZ])
@@ -2034,16 +2396,413 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
       Alc2Free((void **)(zBuf[idZ]));
     }
   }
-  if(ftr)
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Computes the simplices of a 3D contour by splitting the
+*		planes of the object into slabs of WLZ_CONTOUR_SLAB_SZ
+*		planes and calling the given function for each slab.
+*		Rounds of slabs, one per thread, are computed in
+*		parallel with the simplices of each slab buffered and,
+*		if the destination has a model, the vertices of each
+*		slab welded. The buffered simplices are then added to
+*		the destination one slab at a time in plane order, so
+*		that the result is the same as that of a single sweep
+*		through the planes, whatever the number of threads.
+* \param	dst			Destination for the simplices.
+* \param	pnCnt			Number of planes in the object.
+* \param	fn			Function to compute the simplices
+*					of a slab.
+* \param	data			Data passed to the slab function.
+*/
+static WlzErrorNum WlzContourSlabs3D(WlzContourSpxBuf3D *dst, int pnCnt,
+				     WlzContourSlabFn3D fn, void *data)
+{
+  int		idS,
+  		nThr = 1,
+  		slbCnt,
+		slbIdx;
+  WlzContourSpxBuf3D *spx = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp parallel
   {
-    WlzRsvFilterFreeFilter(ftr);
+#pragma omp master
+    {
+      nThr = omp_get_num_threads();
+    }
   }
-  /* Set error code. */
-  if(dstErr)
+#endif
+  slbCnt = (pnCnt + WLZ_CONTOUR_SLAB_SZ - 1) / WLZ_CONTOUR_SLAB_SZ;
+  if(nThr > slbCnt)
   {
-    *dstErr = errNum;
+    nThr = slbCnt;
   }
-  return(ctr);
+  if(nThr > 1)
+  {
+    if((spx = (WlzContourSpxBuf3D *)
+              AlcCalloc(nThr, sizeof(WlzContourSpxBuf3D))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if(dst->model)
+    {
+      /* Any vertices already in the model may be matched by those of
+       * any slab. */
+      dst->maxZ = (dst->model->res.vertex.numElm > 0)? DBL_MAX: -DBL_MAX;
+    }
+  }
+  if(nThr <= 1)
+  {
+    /* Single sweep adding simplices directly to the destination. */
+    if(pnCnt > 0)
+    {
+      errNum = (*fn)(data, 0, pnCnt - 1, dst);
+    }
+  }
+  else
+  {
+    slbIdx = 0;
+    while((errNum == WLZ_ERR_NONE) && (slbIdx < slbCnt))
+    {
+      int	rndCnt;
+
+      rndCnt = ALG_MIN(nThr, slbCnt - slbIdx);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
+#endif
+      for(idS = 0; idS < rndCnt; ++idS)
+      {
+	int	pn0,
+		pn1;
+	WlzErrorNum errNum2;
+
+	pn0 = (slbIdx + idS) * WLZ_CONTOUR_SLAB_SZ;
+	pn1 = ALG_MIN(pn0 + WLZ_CONTOUR_SLAB_SZ, pnCnt) - 1;
+	spx[idS].nSpx = 0;
+	errNum2 = (*fn)(data, pn0, pn1, spx + idS);
+	if((errNum2 == WLZ_ERR_NONE) && dst->model)
+	{
+	  errNum2 = WlzContourSpxBufWeld3D(spx + idS);
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzContourSlabs3D)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+      /* Add the slabs to the destination in plane order. */
+      for(idS = 0; (errNum == WLZ_ERR_NONE) && (idS < rndCnt); ++idS)
+      {
+	errNum = WlzContourSpxBufMerge3D(dst, spx + idS);
+      }
+      slbIdx += rndCnt;
+    }
+  }
+  if(spx)
+  {
+    for(idS = 0; idS < nThr; ++idS)
+    {
+      AlcFree(spx[idS].pos);
+      AlcFree(spx[idS].vIdx);
+      AlcFree(spx[idS].vFst);
+      AlcFree(spx[idS].vNxt);
+      AlcFree(spx[idS].vHT);
+      AlcFree(spx[idS].vHV);
+      AlcFree(spx[idS].vGM);
+    }
+    AlcFree(spx);
+  }
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Adds a simplex (triangle) to the given simplex buffer,
+*		either directly to the buffer's model or by appending it
+*		to the buffer.
+* \param	spx			Given simplex buffer.
+* \param	pos			The three vertex positions of the
+*					simplex.
+*/
+static WlzErrorNum WlzContourSpxBufAdd3D(WlzContourSpxBuf3D *spx,
+					 WlzDVertex3 *pos)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(spx->model)
+  {
+    errNum = WlzGMModelConstructSimplex3D(spx->model, pos);
+  }
+  else
+  {
+    if(spx->nSpx >= spx->maxSpx)
+    {
+      int	  maxSpx;
+      WlzDVertex3 *newPos;
+
+      maxSpx = (spx->maxSpx > 0)? 2 * spx->maxSpx: 1024;
+      if((newPos = (WlzDVertex3 *)AlcRealloc(spx->pos,
+      				  3 * maxSpx * sizeof(WlzDVertex3))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        spx->pos = newPos;
+	spx->maxSpx = maxSpx;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzDVertex3 *p;
+
+      p = spx->pos + (3 * spx->nSpx++);
+      p[0] = pos[0];
+      p[1] = pos[1];
+      p[2] = pos[2];
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Welds the vertices of the buffered simplices, giving
+*		each distinct vertex an index in the order in which
+*		the vertices are first used. Vertices are the same if
+*		they have the same hash value and are within the
+*		tolerance of each other, as for the vertices of a
+*		model. Degenerate simplices, which would not be added
+*		to a model, are marked and their vertices are not
+*		used. The welding only uses the given buffer so that
+*		the buffers of several slabs may be welded in parallel.
+* \param	spx			Given simplex buffer.
+*/
+static WlzErrorNum WlzContourSpxBufWeld3D(WlzContourSpxBuf3D *spx)
+{
+  int		idC,
+  		idS,
+  		nCnr,
+		htSz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nCnr = 3 * spx->nSpx;
+  htSz = 1;
+  while(htSz < nCnr)
+  {
+    htSz <<= 1;
+  }
+  if(nCnr > spx->maxWld)
+  {
+    AlcFree(spx->vIdx);
+    AlcFree(spx->vFst);
+    AlcFree(spx->vNxt);
+    AlcFree(spx->vHV);
+    AlcFree(spx->vGM);
+    spx->maxWld = 0;
+    if(((spx->vIdx = (int *)AlcMalloc(nCnr * sizeof(int))) == NULL) ||
+       ((spx->vFst = (int *)AlcMalloc(nCnr * sizeof(int))) == NULL) ||
+       ((spx->vNxt = (int *)AlcMalloc(nCnr * sizeof(int))) == NULL) ||
+       ((spx->vHV = (unsigned int *)
+                    AlcMalloc(nCnr * sizeof(unsigned int))) == NULL) ||
+       ((spx->vGM = (WlzGMVertex **)
+                    AlcMalloc(nCnr * sizeof(WlzGMVertex *))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      spx->maxWld = nCnr;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (htSz > spx->maxHT))
+  {
+    AlcFree(spx->vHT);
+    spx->maxHT = 0;
+    if((spx->vHT = (int *)AlcMalloc(htSz * sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      spx->maxHT = htSz;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idC = 0; idC < htSz; ++idC)
+    {
+      spx->vHT[idC] = -1;
+    }
+    spx->nVtx = 0;
+    spx->maxZ = -DBL_MAX;
+    for(idS = 0; idS < spx->nSpx; ++idS)
+    {
+      WlzDVertex3 *p;
+
+      idC = 3 * idS;
+      p = spx->pos + idC;
+      if(WlzGeomTriangleArea2Sq3(p[0], p[1], p[2]) <= WLZ_GM_TOLERANCE_SQ)
+      {
+	spx->vIdx[idC] = -1;
+      }
+      else
+      {
+	int	idK;
+
+	for(idK = 0; idK < 3; ++idK)
+	{
+	  int		idV,
+	  		idH;
+	  unsigned int	hV;
+
+	  hV = WlzGeomHashVtx3D(p[idK], WLZ_GM_TOLERANCE);
+	  idH = hV & (htSz - 1);
+	  idV = spx->vHT[idH];
+	  while((idV >= 0) &&
+	        ((spx->vHV[idV] != hV) ||
+		 (WlzGeomCmpVtx3D(spx->pos[spx->vFst[idV]], p[idK],
+		                  WLZ_GM_TOLERANCE) != 0)))
+	  {
+	    idV = spx->vNxt[idV];
+	  }
+	  if(idV < 0)
+	  {
+	    idV = spx->nVtx++;
+	    spx->vHV[idV] = hV;
+	    spx->vFst[idV] = idC + idK;
+	    spx->vNxt[idV] = spx->vHT[idH];
+	    spx->vHT[idH] = idV;
+	    if(p[idK].vtZ > spx->maxZ)
+	    {
+	      spx->maxZ = p[idK].vtZ;
+	    }
+	  }
+	  spx->vIdx[idC + idK] = idV;
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Adds the simplices of a simplex buffer to the destination
+*		in the order in which they were buffered. If the
+*		destination has a model the model's vertex hash table is
+*		first rehashed if it would become crowded, otherwise the
+*		simplices are appended to the destination's buffer. The
+*		given buffer is left empty.
+*		When adding to a model the buffer's vertices must have
+*		been welded by WlzContourSpxBufWeld3D(). Only those
+*		distinct vertices which are not above the vertices
+*		already merged into the model are matched using the
+*		model's vertex hash table, with the rest known to be
+*		new. The simplices are then constructed from the
+*		matched or previously constructed vertices without
+*		searching the model's vertex hash table.
+* \param	dst			Destination simplex buffer.
+* \param	spx			Given simplex buffer.
+*/
+static WlzErrorNum WlzContourSpxBufMerge3D(WlzContourSpxBuf3D *dst,
+					   WlzContourSpxBuf3D *spx)
+{
+  int		idS;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(dst->model)
+  {
+    int		nVtx;
+
+    nVtx = dst->model->res.vertex.numElm + spx->nVtx;
+    if(nVtx > dst->model->vertexHTSz)
+    {
+      errNum = WlzGMModelRehashVHT(dst->model, 2 * nVtx);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	idV;
+      double	mZ;
+
+      /* Match the vertices which may be shared with earlier slabs. */
+      mZ = dst->maxZ + (2.0 * WLZ_GM_TOLERANCE);
+      for(idV = 0; idV < spx->nVtx; ++idV)
+      {
+	WlzDVertex3 p;
+
+	p = spx->pos[spx->vFst[idV]];
+	spx->vGM[idV] = (p.vtZ <= mZ)?
+			WlzGMModelMatchVertexG3D(dst->model, p): NULL;
+      }
+      if(spx->maxZ > dst->maxZ)
+      {
+        dst->maxZ = spx->maxZ;
+      }
+    }
+    for(idS = 0; (errNum == WLZ_ERR_NONE) && (idS < spx->nSpx); ++idS)
+    {
+      int	*vI;
+
+      vI = spx->vIdx + (3 * idS);
+      if(vI[0] >= 0)
+      {
+        WlzGMVertex *vG[3];
+
+	vG[0] = spx->vGM[vI[0]];
+	vG[1] = spx->vGM[vI[1]];
+	vG[2] = spx->vGM[vI[2]];
+	errNum = WlzGMModelConstructSimplex3V(dst->model,
+					      spx->pos + (3 * idS), vG);
+	spx->vGM[vI[0]] = vG[0];
+	spx->vGM[vI[1]] = vG[1];
+	spx->vGM[vI[2]] = vG[2];
+      }
+    }
+  }
+  else if(spx->nSpx > 0)
+  {
+    if(dst->nSpx + spx->nSpx > dst->maxSpx)
+    {
+      int	  maxSpx;
+      WlzDVertex3 *newPos;
+
+      maxSpx = ALG_MAX(2 * dst->maxSpx, dst->nSpx + spx->nSpx);
+      if((newPos = (WlzDVertex3 *)AlcRealloc(dst->pos,
+      				  3 * maxSpx * sizeof(WlzDVertex3))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        dst->pos = newPos;
+	dst->maxSpx = maxSpx;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )memcpy(dst->pos + (3 * dst->nSpx), spx->pos,
+      		    3 * spx->nSpx * sizeof(WlzDVertex3));
+      dst->nSpx += spx->nSpx;
+    }
+  }
+  spx->nSpx = 0;
+  return(errNum);
 }
 
 /*!
@@ -2984,7 +3743,7 @@ static WlzContour *WlzContourBndObj3D(WlzObject *obj, double ctrVal,
                   o----->x
  
 \endverbatim
-* \param	ctr			Contour being built.
+* \param	spx			Destination for the simplices.
 * \param	mBuf			Buffers containing non-zero
 *                                       values for maximal gradient
 *                                       voxels.
@@ -2994,7 +3753,7 @@ static WlzContour *WlzContourBndObj3D(WlzObject *obj, double ctrVal,
 * \param	cbOrg			Absolute position of the 
 *                                       neighbourhoods origin.
 */
-static WlzErrorNum	WlzContourGrdLink3D(WlzContour *ctr,
+static WlzErrorNum	WlzContourGrdLink3D(WlzContourSpxBuf3D *spx,
 					    WlzUByte ***mBuf,
 					    int *bufIdx, WlzIVertex3 bufPos,
 					    WlzIVertex3 cbOrg)
@@ -3090,7 +3849,7 @@ static WlzErrorNum	WlzContourGrdLink3D(WlzContour *ctr,
         WLZ_VTX_3_ADD(sIsn[1], cbOrg, tIV0);
         WLZ_VTX_3_ADD(sIsn[2], cbOrg, tIV1);
 	++spxCnt;;
-	errNum = WlzGMModelConstructSimplex3D(ctr->model, sIsn);
+	errNum = WlzContourSpxBufAdd3D(spx, sIsn);
       }
       ++idN;
     }
@@ -3325,8 +4084,12 @@ static WlzErrorNum WlzContourBndPlane3D(WlzContour *ctr, double isoVal,
 		dPn1Ln0[2],
 		dPn1Ln1[2];
   WlzDVertex3	cbOrg;
+  WlzContourSpxBuf3D spx;
   WlzErrorNum   errNum = WLZ_ERR_NONE;
 
+  spx.model = ctr->model;
+  spx.nSpx = spx.maxSpx = 0;
+  spx.pos = NULL;
   idY = 0;
   cbOrg.vtZ = plane0;
   while((idY < (bufSz.vtY - 1)) && (errNum == WLZ_ERR_NONE))
@@ -3362,7 +4125,7 @@ static WlzErrorNum WlzContourBndPlane3D(WlzContour *ctr, double isoVal,
 	dPn1Ln0[1] = iPn1Ln0[1];
 	dPn1Ln1[0] = iPn1Ln1[0];
 	dPn1Ln1[1] = iPn1Ln1[1];
-        errNum = WlzContourIsoCube3D6T(ctr, isoVal,
+        errNum = WlzContourIsoCube3D6T(&spx, isoVal,
 				       dPn0Ln0, dPn0Ln1, dPn1Ln0, dPn1Ln1,
 				       cbOrg);
       }
@@ -3447,8 +4210,12 @@ static WlzErrorNum WlzContourBndEmptyPlane3D(WlzContour *ctr, double isoVal,
 		dPn1Ln0[2],
 		dPn1Ln1[2];
   WlzDVertex3	cbOrg;
+  WlzContourSpxBuf3D spx;
   WlzErrorNum   errNum = WLZ_ERR_NONE;
 
+  spx.model = ctr->model;
+  spx.nSpx = spx.maxSpx = 0;
+  spx.pos = NULL;
   idY = 0;
   dPn1Ln0[0] = 0.0;
   dPn1Ln0[1] = 0.0;
@@ -3476,7 +4243,7 @@ static WlzErrorNum WlzContourBndEmptyPlane3D(WlzContour *ctr, double isoVal,
 	dPn0Ln0[1] = iPn0Ln0[1];
 	dPn0Ln1[0] = iPn0Ln1[0];
 	dPn0Ln1[1] = iPn0Ln1[1];
-        errNum = WlzContourIsoCube3D6T(ctr, isoVal,
+        errNum = WlzContourIsoCube3D6T(&spx, isoVal,
 				       dPn0Ln0, dPn0Ln1, dPn1Ln0, dPn1Ln1,
 				       cbOrg);
       }
@@ -3840,7 +4607,7 @@ static WlzErrorNum WlzContourIsoCube2D(WlzContour *ctr,
 *		tetrahedron vertex 3 is always the cube face vertex
 *		(9, 10, 11, 12, 13, 14) and the tetrahedron verticies
 *		1 and 2 are cube edge verticies.
-* \param	ctr			Contour being built.
+* \param	spx			Destination for the simplices.
 * \param	isoVal			Iso-value to use.
 * \param	vPn0Ln0			Ptr to 2 data values at
 *                                       z = zPos, y = yPos and
@@ -3856,7 +4623,7 @@ static WlzErrorNum WlzContourIsoCube2D(WlzContour *ctr,
 *                                       x = xPos, xpos + 1.
 * \param	cbOrg			The cube's origin.
 */
-static WlzErrorNum WlzContourIsoCube3D24(WlzContour *ctr,
+static WlzErrorNum WlzContourIsoCube3D24(WlzContourSpxBuf3D *spx,
 				double isoVal,
 				double *vPn0Ln0, double *vPn0Ln1,
 				double *vPn1Ln0, double *vPn1Ln1,
@@ -3945,7 +4712,7 @@ static WlzErrorNum WlzContourIsoCube3D24(WlzContour *ctr,
       tI3 = tVxLUT[tIdx][3];
       tVal[1] = cVal[tI1]; tVal[2] = cVal[tI2]; tVal[3] = cVal[tI3];
       tPos[1] = cPos[tI1]; tPos[2] = cPos[tI2]; tPos[3] = cPos[tI3];
-      errNum = WlzContourIsoTet3D(ctr, tVal, tPos, cbOrg);
+      errNum = WlzContourIsoTet3D(spx, tVal, tPos, cbOrg);
       ++tIdx;
     }
   }
@@ -3974,7 +4741,9 @@ static WlzErrorNum WlzContourIsoCube3D24(WlzContour *ctr,
 *               The modulus of the central gradient is known to be
 *               non-zero.
 *               The buffer position wrt z is always modulo 3.
-* \param	ctr			Contour being built.
+* \param	spx			Destination for the simplices, if
+*					NULL maximal gradient voxels are
+*					marked but not linked.
 * \param	mBuf			Buffer with maximal voxels
 *                                       marked non-zero.
 * \param	zBuf			Z gradients.
@@ -3984,7 +4753,7 @@ static WlzErrorNum WlzContourIsoCube3D24(WlzContour *ctr,
 * \param	bufPos			Index into buffers.
 * \param	cbOrg			Origin of the cube.
 */
-static WlzErrorNum WlzContourGrdCube3D(WlzContour *ctr,
+static WlzErrorNum WlzContourGrdCube3D(WlzContourSpxBuf3D *spx,
 				       WlzUByte ***mBuf,
 				       double ***zBuf, double ***yBuf,
 				       double ***xBuf,
@@ -4201,7 +4970,10 @@ static WlzErrorNum WlzContourGrdCube3D(WlzContour *ctr,
                    modCGV * cGV.vtX, modCGV * cGV.vtY, modCGV * cGV.vtZ);
 #endif /* WLZ_CONTOUR_DEBUG */
     *(*(*(mBuf + aCC.vtZ) + aCC.vtY) + aCC.vtX) = 1;
-    errNum = WlzContourGrdLink3D(ctr, mBuf, bufIdx, bufPos, cbOrg);
+    if(spx)
+    {
+      errNum = WlzContourGrdLink3D(spx, mBuf, bufIdx, bufPos, cbOrg);
+    }
   }
 #ifdef WLZ_CONTOUR_DEBUG
   else
@@ -4263,7 +5035,7 @@ static WlzErrorNum WlzContourGrdCube3D(WlzContour *ctr,
  		   5        		0, 3, 4, 5
 
 \endverbatim
-* \param	ctr			Contour being built.
+* \param	spx			Destination for the simplices.
 * \param	isoVal			Iso-value to use.
 * \param	vPn0Ln0			Ptr to 2 data values at
 *                                       z = zPos, y = yPos and
@@ -4279,7 +5051,7 @@ static WlzErrorNum WlzContourGrdCube3D(WlzContour *ctr,
 *                                       x = xPos, xpos + 1.
 * \param	cbOrg			The cube's origin.
 */
-static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
+static WlzErrorNum WlzContourIsoCube3D6T(WlzContourSpxBuf3D *spx,
 				double isoVal,
 				double *vPn0Ln0, double *vPn0Ln1,
 				double *vPn1Ln0, double *vPn1Ln1,
@@ -4346,7 +5118,7 @@ static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
 	tVal[vIdx] = cVal[tI0];
 	tPos[vIdx] = cPos[tI0];
       }
-      errNum = WlzContourIsoTet3D(ctr, tVal, tPos, cbOrg);
+      errNum = WlzContourIsoTet3D(spx, tVal, tPos, cbOrg);
       ++tIdx;
     }
   }
@@ -4361,14 +5133,14 @@ static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
 *               for the contour.
 *		The triangle vertices are always ordered such that
 *		when viewed from the +ve side they are in CCW order.
-* \param	ctr			Contour being built.
+* \param	spx			Destination for the simplices.
 * \param	tVal			Values wrt the iso-value at the
 *                                       verticies of the tetrahedron.
 * \param	tPos			Positions of the tetrahedron
 *                                       verticies wrt the cube's origin.
 * \param	cbOrg			The cube's origin.
 */
-static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
+static WlzErrorNum WlzContourIsoTet3D(WlzContourSpxBuf3D *spx,
 				      double *tVal,
 				      WlzDVertex3 *tPos,
 				      WlzDVertex3 cbOrg)
@@ -4937,15 +5709,14 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
 	sIsn[2] = tIsn[3];
 	tIsn[2] = tIsn[3];
       }
-      if((errNum = WlzGMModelConstructSimplex3D(ctr->model,
-      						tIsn)) == WLZ_ERR_NONE)
+      if((errNum = WlzContourSpxBufAdd3D(spx, tIsn)) == WLZ_ERR_NONE)
       {
-        errNum = WlzGMModelConstructSimplex3D(ctr->model, sIsn);
+        errNum = WlzContourSpxBufAdd3D(spx, sIsn);
       }
     }
     else
     {
-      errNum = WlzGMModelConstructSimplex3D(ctr->model, tIsn);
+      errNum = WlzContourSpxBufAdd3D(spx, tIsn);
     }
 #ifdef WLZ_CONTOUR_DEBUG
     (void )fprintf(stderr,
@@ -44,13 +44,62 @@ static char _WlzDistTransform_c[] = "University of Edinburgh $Id$";
 #include <stdio.h>
 #include <stdlib.h>
 #include <float.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <Wlz.h>
 
+static void			WlzDistTransformEuc1D(
+				  float *ary,
+				  size_t stp,
+				  int n,
+				  double sz,
+				  double *f,
+				  double *z,
+				  int *v);
 static WlzObject 		*WlzDistSample(
 				  WlzObject *obj,
 				  int dim,
 				  double scale,
     			          WlzErrorNum *dstErr);
+static WlzObject		*WlzDistTransformEuc(
+				  WlzObject *forObj,
+				  WlzObject *refObj,
+				  int dim,
+				  double dMax,
+				  WlzErrorNum *dstErr);
+static void			WlzDistTransformEucPlane(
+				  float *ary,
+				  WlzIVertex3 aSz,
+				  WlzDVertex3 vSz,
+				  int maxN,
+				  double *fBuf,
+				  int *vBuf);
+static void			WlzDistTransformEucColumnDist(
+				  float *ary,
+				  int nCol,
+				  int *colOff,
+				  int *colRun,
+				  int *colCur,
+				  int pln,
+				  double sz);
+static WlzErrorNum		WlzDistTransformEucColumns(
+				  WlzObject *obj,
+				  WlzIBox3 box,
+				  int **dstOff,
+				  int **dstRun);
+static WlzErrorNum		WlzDistTransformEucSites2D(
+				  float *ary,
+				  WlzObject *obj,
+				  WlzIBox3 box,
+				  int pln);
+static WlzErrorNum		WlzDistTransformEucValues2D(
+				  float *ary,
+				  WlzObject *obj,
+				  WlzIBox3 box,
+				  int pln,
+				  double dMax);
 
 /*!
 * \return	Distance object which shares the given foreground object's
@@ -90,6 +139,27 @@ static WlzObject 		*WlzDistSample(
 * 		reference domain using a sphere with a radius having the same
 * 		value as the scale parameter and then finaly sampling the
 * 		scaled distances.
+*
+*		An exact Euclidean distance transform
+*		(WLZ_EUCLIDEAN_DISTANCE) is computed using separable
+*		lower envelope of parabolas passes along each of the
+*		axes in turn, as in: P. F. Felzenszwalb and
+*		D. P. Huttenlocher "Distance Transforms of Sampled
+*		Functions" Theory of Computing 8:415-428, 2012.
+*		The distances are computed one plane at a time within
+*		the bounding box of the foreground and reference objects,
+*		with the pass along z being computed from the runs of
+*		reference voxels along each column. The time taken is
+*		linear in the number of pixels within this box on the
+*		planes of the foreground object and independant of the
+*		maximum distance, while the memory used is that of a
+*		single plane of the box plus that of the runs.
+*		For 3D objects the voxel size of the foreground object's
+*		plane domain is used to scale the distances. Unlike the
+*		other distance functions the distances are not constrained
+*		to paths within the foreground domain and the distance
+*		values are of type WLZ_GREY_FLOAT rather than
+*		WLZ_GREY_INT.
 * \param	forObj			Foreground object.
 * \param	refObj			Reference object.
 * \param	dFn			Distance function which must be
@@ -214,6 +284,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_4_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_8_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 2;
 	    break;
@@ -229,6 +300,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_18_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_26_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 3;
 	    break;
@@ -272,13 +344,23 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	}
 	break;
       case WLZ_EUCLIDEAN_DISTANCE:
-	errNum = WLZ_ERR_UNIMPLEMENTED;
 	break;
       default:
         errNum = WLZ_ERR_PARAM_DATA;
 	break;
     }
   }
+  /* The exact Euclidean distance transform does not use domain
+   * propagation, so compute it and return. */
+  if((errNum == WLZ_ERR_NONE) && (dFn == WLZ_EUCLIDEAN_DISTANCE))
+  {
+    dstObj = WlzDistTransformEuc(forObj, refObj, dim, dMax, &errNum);
+    if(dstErr)
+    {
+      *dstErr = errNum;
+    }
+    return(dstObj);
+  }
   /* Create scaled domains and a sphere domain for structual erosion if the
    * distance function is approximate Euclidean. */
   if(errNum == WLZ_ERR_NONE)
@@ -575,3 +657,655 @@ static WlzObject *WlzDistSample(WlzObject *obj, int dim, double scale,
   }
   return(sObj);
 }
+
+/*!
+* \return	Distance object which shares the given foreground object's
+*		domain and has float distance values, null on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the exact Euclidean distance of every pixel/voxel
+*		in the foreground object from the reference object.
+*		Squared distances are computed one plane at a time in a
+*		float array which covers the union of the bounding boxes
+*		of the two objects in x and y, by a 1D lower envelope
+*		pass along every line parallel to the x and then the y
+*		axis. The lines of each pass are independant and are
+*		distributed over the available threads. For 3D objects
+*		the pass along z is done first, directly from runs of
+*		reference voxels along each column, so only the planes
+*		of the foreground object are visited and the memory used
+*		is proportional to the area of a plane plus the number
+*		of reference runs rather than to the volume of the
+*		bounding box.
+* \param	forObj			Foreground object.
+* \param	refObj			Reference object, either a domain
+*					object of the same type as the
+*					foreground object or points.
+* \param	dim			Dimension either 2D or 3D.
+* \param	dMax			Maximum distance, distances greater
+*					than this are set to zero as for
+*					the propagated distance functions.
+*					A value <= 0 implies an infinite
+*					maximum distance.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzDistTransformEuc(WlzObject *forObj, WlzObject *refObj,
+				      int dim, double dMax,
+				      WlzErrorNum *dstErr)
+{
+  int		idN,
+  		maxN,
+		nCol,
+		nThr = 1;
+  float		*ary = NULL;
+  double	*fBuf = NULL;
+  int		*vBuf = NULL,
+  		*colOff = NULL,
+		*colRun = NULL,
+		*colCur = NULL;
+  WlzIBox3	box,
+  		rBox;
+  WlzIVertex3	aSz;
+  WlzDVertex3	vSz;
+  WlzPixelV	bgdV;
+  WlzValues	dstVal;
+  WlzObject	*sRefObj = NULL,
+  		*dstObj = NULL;
+  WlzObjectType	dstGType;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dstVal.core = NULL;
+  vSz.vtX = vSz.vtY = vSz.vtZ = 1.0;
+  if(refObj->type == WLZ_POINTS)
+  {
+    sRefObj = WlzAssignObject(
+    	      WlzPointsToDomObj(refObj->domain.pts, 1.0, &errNum), NULL);
+  }
+  else
+  {
+    sRefObj = WlzAssignObject(refObj, NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    box = WlzBoundingBox3I(forObj, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rBox = WlzBoundingBox3I(sRefObj, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    box.xMin = ALG_MIN(box.xMin, rBox.xMin);
+    box.yMin = ALG_MIN(box.yMin, rBox.yMin);
+    box.zMin = ALG_MIN(box.zMin, rBox.zMin);
+    box.xMax = ALG_MAX(box.xMax, rBox.xMax);
+    box.yMax = ALG_MAX(box.yMax, rBox.yMax);
+    box.zMax = ALG_MAX(box.zMax, rBox.zMax);
+    if(dim == 2)
+    {
+      box.zMin = box.zMax = 0;
+    }
+    else
+    {
+      vSz.vtX = forObj->domain.p->voxel_size[0];
+      vSz.vtY = forObj->domain.p->voxel_size[1];
+      vSz.vtZ = forObj->domain.p->voxel_size[2];
+    }
+    aSz.vtX = box.xMax - box.xMin + 1;
+    aSz.vtY = box.yMax - box.yMin + 1;
+    aSz.vtZ = box.zMax - box.zMin + 1;
+    maxN = ALG_MAX(aSz.vtX, aSz.vtY);
+    nCol = aSz.vtX * aSz.vtY;
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+        nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    if(((ary = (float *)AlcMalloc(nCol * sizeof(float))) == NULL) ||
+       ((fBuf = (double *)AlcMalloc(nThr * (2 * maxN + 1) *
+                                    sizeof(double))) == NULL) ||
+       ((vBuf = (int *)AlcMalloc(nThr * maxN * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* For 2D objects set all sites to infinity and then those of the
+   * reference domain to zero, for 3D objects find the runs of the
+   * reference domain along each column. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(dim == 2)
+    {
+      for(idN = 0; idN < nCol; ++idN)
+      {
+	ary[idN] = FLT_MAX;
+      }
+      errNum = WlzDistTransformEucSites2D(ary, sRefObj, box, 0);
+    }
+    else
+    {
+      errNum = WlzDistTransformEucColumns(sRefObj, box, &colOff, &colRun);
+      if((errNum == WLZ_ERR_NONE) &&
+	 ((colCur = (int *)AlcMalloc(nCol * sizeof(int))) == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	for(idN = 0; idN < nCol; ++idN)
+	{
+	  colCur[idN] = colOff[idN];
+	}
+      }
+    }
+  }
+  /* Create a distance object using the foreground object's domain and
+   * new float values. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bgdV.type = WLZ_GREY_FLOAT;
+    bgdV.v.flv = 0.0f;
+    dstGType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, WLZ_GREY_FLOAT,
+    				     NULL);
+    if(dim == 2)
+    {
+      dstVal.v = WlzNewValueTb(forObj, dstGType, bgdV, &errNum);
+    }
+    else
+    {
+      dstVal.vox = WlzNewValuesVox(forObj, dstGType, bgdV, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    dstObj = WlzMakeMain(forObj->type, forObj->domain, dstVal,
+			 NULL, NULL, &errNum);
+    if(dstObj == NULL)
+    {
+      (void )WlzFreeValues(dstVal);
+    }
+  }
+  /* Compute the squared distances of each plane and then set the
+   * distances from them. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(dim == 2)
+    {
+      WlzDistTransformEucPlane(ary, aSz, vSz, maxN, fBuf, vBuf);
+      errNum = WlzDistTransformEucValues2D(ary, dstObj, box, 0, dMax);
+    }
+    else
+    {
+      int	idP,
+      		nPln;
+      WlzPlaneDomain *pDom;
+      WlzVoxelValues *vVal;
+
+      pDom = dstObj->domain.p;
+      vVal = dstObj->values.vox;
+      nPln = pDom->lastpl - pDom->plane1 + 1;
+      for(idP = 0; (errNum == WLZ_ERR_NONE) && (idP < nPln); ++idP)
+      {
+	if(pDom->domains[idP].core != NULL)
+	{
+	  int	pln;
+	  WlzObject *obj2;
+
+	  pln = pDom->plane1 + idP;
+	  WlzDistTransformEucColumnDist(ary, nCol, colOff, colRun, colCur,
+	  				pln, vSz.vtZ);
+	  WlzDistTransformEucPlane(ary, aSz, vSz, maxN, fBuf, vBuf);
+	  obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ, pDom->domains[idP],
+	  		     vVal->values[idP], NULL, NULL, &errNum);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = WlzDistTransformEucValues2D(ary, obj2, box, box.zMin,
+	    					 dMax);
+	  }
+	  (void )WlzFreeObj(obj2);
+	}
+      }
+    }
+  }
+  AlcFree(ary);
+  AlcFree(fBuf);
+  AlcFree(vBuf);
+  AlcFree(colOff);
+  AlcFree(colRun);
+  AlcFree(colCur);
+  (void )WlzFreeObj(sRefObj);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(dstObj);
+    dstObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dstObj);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the squared distances within a plane given the
+*		squared distances along z (or the sites for a 2D object)
+*		in place, using a pass along every line parallel to the
+*		x axis and then the y axis.
+* \param	ary			Array covering a plane of the box.
+* \param	aSz			Size of the box.
+* \param	vSz			Voxel size.
+* \param	maxN			Maximum of the box width and height.
+* \param	fBuf			Workspace for 2 * maxN + 1 doubles
+*					per thread.
+* \param	vBuf			Workspace for maxN ints per thread.
+*/
+static void	WlzDistTransformEucPlane(float *ary, WlzIVertex3 aSz,
+					 WlzDVertex3 vSz, int maxN,
+					 double *fBuf, int *vBuf)
+{
+  int		idA;
+
+  for(idA = 0; idA < 2; ++idA)
+  {
+    int		idL,
+    		nLn,
+		lnN;
+    size_t	lnStp;
+    double	lnSz;
+
+    if(idA == 0)
+    {
+      lnN = aSz.vtX;
+      lnSz = vSz.vtX;
+      lnStp = 1;
+      nLn = aSz.vtY;
+    }
+    else
+    {
+      lnN = aSz.vtY;
+      lnSz = vSz.vtY;
+      lnStp = aSz.vtX;
+      nLn = aSz.vtX;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idL = 0; idL < nLn; ++idL)
+    {
+      int	thrId = 0;
+      size_t	off;
+      double	*f;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      off = (idA == 0)? (size_t )idL * aSz.vtX: (size_t )idL;
+      f = fBuf + (thrId * (2 * maxN + 1));
+      WlzDistTransformEuc1D(ary + off, lnStp, lnN, lnSz,
+			    f, f + maxN, vBuf + (thrId * maxN));
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the 1D squared Euclidean distance transform of
+*		the given line of sampled squared distances in place, by
+*		finding the lower envelope of the parabolas rooted at each
+*		finite sample. Samples with value FLT_MAX are treated as
+*		being at an infinite distance.
+* \param	ary			Line of samples.
+* \param	stp			Step between successive samples.
+* \param	n			Number of samples in the line.
+* \param	sz			Sample size along the line.
+* \param	f			Workspace for at least n doubles.
+* \param	z			Workspace for at least n + 1 doubles.
+* \param	v			Workspace for at least n ints.
+*/
+static void	WlzDistTransformEuc1D(float *ary, size_t stp, int n,
+				      double sz, double *f, double *z, int *v)
+{
+  int		q,
+  		k = -1;
+  double	sz2;
+
+  sz2 = sz * sz;
+  for(q = 0; q < n; ++q)
+  {
+    f[q] = ary[q * stp];
+  }
+  for(q = 0; q < n; ++q)
+  {
+    if(f[q] < FLT_MAX)
+    {
+      if(k < 0)
+      {
+	k = 0;
+	v[0] = q;
+	z[0] = -DBL_MAX;
+	z[1] = DBL_MAX;
+      }
+      else
+      {
+	int	r;
+	double	s,
+		fq;
+
+	fq = f[q] + (sz2 * q * q);
+	for(;;)
+	{
+	  r = v[k];
+	  s = (fq - (f[r] + (sz2 * r * r))) / (2.0 * sz2 * (q - r));
+	  if((k == 0) || (s > z[k]))
+	  {
+	    break;
+	  }
+	  --k;
+	}
+	++k;
+	v[k] = q;
+	z[k] = s;
+	z[k + 1] = DBL_MAX;
+      }
+    }
+  }
+  if(k >= 0)
+  {
+    k = 0;
+    for(q = 0; q < n; ++q)
+    {
+      double	d;
+
+      while(z[k + 1] < q)
+      {
+        ++k;
+      }
+      d = sz * (q - v[k]);
+      ary[q * stp] = (float )((d * d) + f[v[k]]);
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Finds the runs of voxels of the given 3D domain object
+*		along each column (line parallel to the z axis) of the
+*		given box. The runs of column \f$c\f$, in order of
+*		increasing z, are runs[2 * i] to runs[2 * i + 1] (first and
+*		last plane) for off[c] <= i < off[c + 1], where columns
+*		are indexed in raster order within a plane of the box.
+* \param	obj			Given 3D domain object.
+* \param	box			Bounding box which covers the object.
+* \param	dstOff			Destination pointer for the offsets of
+*					the runs of each column, with one more
+*					entry than the number of columns.
+* \param	dstRun			Destination pointer for the runs.
+*/
+static WlzErrorNum WlzDistTransformEucColumns(WlzObject *obj, WlzIBox3 box,
+					      int **dstOff, int **dstRun)
+{
+  int		idC,
+  		idP,
+		nCol,
+		pass;
+  size_t	lnW;
+  int		*off = NULL,
+  		*run = NULL,
+		*cnt = NULL,
+		*lst = NULL;
+  WlzPlaneDomain *pDom;
+  WlzValues	nullVal;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nullVal.core = NULL;
+  pDom = obj->domain.p;
+  lnW = box.xMax - box.xMin + 1;
+  nCol = lnW * (box.yMax - box.yMin + 1);
+  if(((off = (int *)AlcCalloc(nCol + 1, sizeof(int))) == NULL) ||
+     ((cnt = (int *)AlcMalloc(nCol * sizeof(int))) == NULL) ||
+     ((lst = (int *)AlcMalloc(nCol * sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* The runs are counted in the first pass and then set in the second,
+   * with the last plane in which each column was found being used to
+   * tell the start of a new run from the continuation of one. */
+  for(pass = 0; (errNum == WLZ_ERR_NONE) && (pass < 2); ++pass)
+  {
+    for(idC = 0; idC < nCol; ++idC)
+    {
+      cnt[idC] = (pass == 0)? 0: off[idC];
+      lst[idC] = box.zMin - 2;
+    }
+    for(idP = pDom->plane1;
+        (errNum == WLZ_ERR_NONE) && (idP <= pDom->lastpl); ++idP)
+    {
+      WlzDomain	dom2;
+
+      dom2 = pDom->domains[idP - pDom->plane1];
+      if(dom2.core != NULL)
+      {
+	WlzObject *obj2;
+	WlzIntervalWSpace iWSp;
+
+	obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, nullVal,
+			   NULL, NULL, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzInitRasterScan(obj2, &iWSp, WLZ_RASTERDIR_ILIC);
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  while((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+	  {
+	    int	idX;
+
+	    idC = ((iWSp.linpos - box.yMin) * lnW) + iWSp.lftpos - box.xMin;
+	    for(idX = iWSp.lftpos; idX <= iWSp.rgtpos; ++idX)
+	    {
+	      if(lst[idC] != idP - 1)
+	      {
+		if(pass != 0)
+		{
+		  run[2 * cnt[idC]] = idP;
+		}
+		++cnt[idC];
+	      }
+	      if(pass != 0)
+	      {
+		run[(2 * cnt[idC]) - 1] = idP;
+	      }
+	      lst[idC++] = idP;
+	    }
+	  }
+	  if(errNum == WLZ_ERR_EOO)
+	  {
+	    errNum = WLZ_ERR_NONE;
+	  }
+	}
+	(void )WlzFreeObj(obj2);
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (pass == 0))
+    {
+      for(idC = 0; idC < nCol; ++idC)
+      {
+        off[idC + 1] = off[idC] + cnt[idC];
+      }
+      if((run = (int *)AlcMalloc((2 * off[nCol] + 1) * sizeof(int))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  AlcFree(cnt);
+  AlcFree(lst);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *dstOff = off;
+    *dstRun = run;
+  }
+  else
+  {
+    AlcFree(off);
+    AlcFree(run);
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the squared distances along z, from the nearest
+*		reference voxel in the same column, of every column in the
+*		given plane. The planes must be visited in order of
+*		increasing z, with the current run of each column being
+*		kept in the given array.
+* \param	ary			Array covering a plane of the box.
+* \param	nCol			Number of columns in a plane.
+* \param	colOff			Offsets of the runs of each column.
+* \param	colRun			First and last planes of the runs.
+* \param	colCur			Current run of each column, initially
+*					the first run of the column.
+* \param	pln			Plane.
+* \param	sz			Voxel size along z.
+*/
+static void	WlzDistTransformEucColumnDist(float *ary, int nCol,
+					      int *colOff, int *colRun,
+					      int *colCur, int pln,
+					      double sz)
+{
+  int		idC;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for(idC = 0; idC < nCol; ++idC)
+  {
+    int		c,
+    		d = -1;
+
+    c = colCur[idC];
+    while((c < colOff[idC + 1]) && (colRun[(2 * c) + 1] < pln))
+    {
+      ++c;
+    }
+    colCur[idC] = c;
+    if(c < colOff[idC + 1])
+    {
+      d = ALG_MAX(colRun[2 * c] - pln, 0);
+    }
+    if((c > colOff[idC]) && ((d < 0) || (pln - colRun[(2 * c) - 1] < d)))
+    {
+      d = pln - colRun[(2 * c) - 1];
+    }
+    ary[idC] = (d < 0)? FLT_MAX: (float )(sz * sz * d * d);
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the elements of the given array which are within the
+*		given 2D domain object to zero.
+* \param	ary			Array covering the given box.
+* \param	obj			Given 2D domain object.
+* \param	box			Bounding box of the array.
+* \param	pln			Plane of the 2D domain object.
+*/
+static WlzErrorNum WlzDistTransformEucSites2D(float *ary, WlzObject *obj,
+					      WlzIBox3 box, int pln)
+{
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum;
+
+  errNum = WlzInitRasterScan(obj, &iWSp, WLZ_RASTERDIR_ILIC);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    size_t	lnW,
+    		plOff;
+
+    lnW = box.xMax - box.xMin + 1;
+    plOff = (size_t )(pln - box.zMin) * lnW * (box.yMax - box.yMin + 1);
+    while((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      int	idX;
+      float	*ln;
+
+      ln = ary + plOff + ((size_t )(iWSp.linpos - box.yMin) * lnW) -
+           box.xMin;
+      for(idX = iWSp.lftpos; idX <= iWSp.rgtpos; ++idX)
+      {
+        ln[idX] = 0.0f;
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the float values of the given 2D domain object to the
+*		square roots of the squared distances in the given array.
+* \param	ary			Array of squared distances covering
+*					the given box.
+* \param	obj			Given 2D domain object with float
+*					values.
+* \param	box			Bounding box of the array.
+* \param	pln			Plane of the 2D domain object.
+* \param	dMax			Maximum distance, <= 0 implies
+*					an infinite maximum distance.
+*/
+static WlzErrorNum WlzDistTransformEucValues2D(float *ary, WlzObject *obj,
+					       WlzIBox3 box, int pln,
+					       double dMax)
+{
+  WlzGreyWSpace gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum;
+  const double	dEps = 1.0e-6;
+
+  errNum = WlzInitGreyScan(obj, &iWSp, &gWSp);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    size_t	lnW,
+    		plOff;
+    double	dMax2;
+
+    dMax2 = (dMax > dEps)? dMax * dMax: FLT_MAX;
+    lnW = box.xMax - box.xMin + 1;
+    plOff = (size_t )(pln - box.zMin) * lnW * (box.yMax - box.yMin + 1);
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      int	idX;
+      float	*ln,
+      		*gP;
+
+      gP = gWSp.u_grintptr.flp;
+      ln = ary + plOff + ((size_t )(iWSp.linpos - box.yMin) * lnW) -
+           box.xMin;
+      for(idX = iWSp.lftpos; idX <= iWSp.rgtpos; ++idX)
+      {
+	float	d2;
+
+	d2 = ln[idX];
+        *gP++ = (d2 < dMax2)? (float )sqrt(d2): 0.0f;
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  return(errNum);
+}
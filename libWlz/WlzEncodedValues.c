@@ -0,0 +1,2371 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzEncodedValues_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzEncodedValues.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2012],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Reading and writing of grey value tables as chunks of
+* 		encoded values.
+* \ingroup	WlzIO
+*
+* An encoded value table is written in place of the grey value
+* table of a 2D or 3D domain object and is identified by the value
+* table type WLZ_VALUETABLE_ENCODED. It has one of two forms, given
+* by the byte which follows the type. Values which are not tiled
+* are written as chunks of lines:
+* \verbatim
+  type			byte, WLZ_VALUETABLE_ENCODED
+  form			byte, 1 for chunks of lines
+  grey type		byte
+  background		grey value
+  number of chunks	word
+  chunks		{codec byte, plane word, first line word,
+  			 number of lines word, raw size word,
+			 encoded size word, encoded bytes}
+  \endverbatim
+* Tiled values are written a tile at a time:
+* \verbatim
+  type			byte, WLZ_VALUETABLE_ENCODED
+  form			byte, 2 for tiles
+  tiled table type	byte
+  dimension		byte
+  bounding box		words, kol1, lastkl, line1, lastln, plane1, lastpl
+  background		grey value
+  value rank		word
+  value dimensions	words, one for each rank
+  tile size		word
+  tile width		word
+  number of tiles	word
+  index dimensions	words, one for each dimension
+  tile indices		words
+  tile table		{codec byte, encoded size word} for each tile
+  tiles			encoded bytes of each tile
+  \endverbatim
+* Words are four byte little endian integers and grey values are
+* written as little endian bytes of their native size. Each chunk
+* holds the values of a range of lines within a single plane, in
+* the order they are visited by an interval scan. The values of a
+* chunk or tile are delta coded and byte shuffled (the first bytes of
+* all values, then the second bytes, ...) and then either compressed
+* or stored according to the chunk's codec. Chunks and tiles share
+* no state so they may be encoded and decoded concurrently, or in any
+* order. Since the offset of every encoded tile is known from the
+* tile table, the tiles of a paged tiled value table are read and
+* decoded only when they are first accessed.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#if HAVE_ZLIB != 0
+#include <zlib.h>
+#endif
+#include <Wlz.h>
+
+#ifdef HAVE_UNISTD_H
+#define WLZ_USE_PREAD
+#include <unistd.h>
+#endif
+
+/*!
+* \def		WLZ_ENCODEDVALUES_LINES
+* \ingroup	WlzIO
+* \brief	Form of an encoded value table with chunks of lines.
+*/
+#define WLZ_ENCODEDVALUES_LINES		(1)
+
+/*!
+* \def		WLZ_ENCODEDVALUES_TILES
+* \ingroup	WlzIO
+* \brief	Form of an encoded value table with tiles.
+*/
+#define WLZ_ENCODEDVALUES_TILES		(2)
+
+/*!
+* \def		WLZ_ENCODEDVALUES_CHUNK_SZ
+* \ingroup	WlzIO
+* \brief	Target size in bytes of the raw values in a chunk. Lines
+* 		are added to a chunk until this would be exceeded, so a
+* 		chunk always has at least one line.
+*/
+#define WLZ_ENCODEDVALUES_CHUNK_SZ	(1<<18)
+
+/*!
+* \def		WLZ_ENCODEDVALUES_BATCH_SZ
+* \ingroup	WlzIO
+* \brief	Target size in bytes of the raw values of a batch of
+* 		chunks or tiles which are read and then decoded (or
+* 		encoded and then written) together.
+*/
+#define WLZ_ENCODEDVALUES_BATCH_SZ	(1<<26)
+
+/*!
+* \struct	_WlzEncodedValuesChunk
+* \ingroup	WlzIO
+* \brief	A chunk of encoded values.
+*/
+typedef struct _WlzEncodedValuesChunk
+{
+  int		pIdx;			/*!< Plane index, relative to the
+  					     first plane of a 3D object or
+					     zero for a 2D object, or the
+					     tile index of a tile. */
+  int		ln0;			/*!< First line of the chunk. */
+  int		nLn;			/*!< Number of lines in the chunk. */
+  WlzValueEncoding codec;		/*!< Compression used for the
+  					     filtered values. */
+  size_t	rawSz;			/*!< Size of the values in bytes. */
+  size_t	encSz;			/*!< Size of the encoded values in
+  					     bytes. */
+  WlzUByte	*enc;			/*!< Encoded values. */
+  WlzErrorNum	errNum;			/*!< Error encoding or decoding the
+  					     chunk. */
+} WlzEncodedValuesChunk;
+
+static int			WlzEncodedValuesGreySz(
+				  WlzGreyType gType);
+static int			WlzEncodedValuesDomainOK(
+				  WlzDomain dom);
+static WlzErrorNum		WlzEncodedValuesCodecOK(
+				  WlzValueEncoding codec);
+static WlzErrorNum		WlzEncodedValuesWriteLines(
+				  FILE *fP,
+				  WlzObject *obj,
+				  WlzValueEncoding enc);
+static WlzErrorNum		WlzEncodedValuesWriteTiles(
+				  FILE *fP,
+				  WlzTiledValues *tVal,
+				  WlzValueEncoding enc);
+static WlzErrorNum		WlzEncodedValuesReadLines(
+				  FILE *fP,
+				  WlzObject *obj);
+static WlzErrorNum		WlzEncodedValuesReadTiles(
+				  FILE *fP,
+				  WlzObject *obj);
+static size_t			WlzEncodedValuesLineArea(
+				  WlzIntervalDomain *iDom,
+				  int ln);
+static void			WlzEncodedValuesFilter(
+				  WlzUByte *dst,
+				  WlzUByte *src,
+				  size_t n,
+				  int sz);
+static void			WlzEncodedValuesUnfilter(
+				  WlzUByte *dst,
+				  WlzUByte *src,
+				  size_t n,
+				  int sz);
+static size_t			WlzEncodedValuesRLE(
+				  WlzUByte *dst,
+				  WlzUByte *src,
+				  size_t n);
+static WlzErrorNum		WlzEncodedValuesUnRLE(
+				  WlzUByte *dst,
+				  size_t dstSz,
+				  WlzUByte *src,
+				  size_t srcSz);
+static WlzErrorNum		WlzEncodedValuesEncodeChunk(
+				  WlzEncodedValuesChunk *chk,
+				  WlzUByte *raw,
+				  int sz);
+static WlzErrorNum		WlzEncodedValuesDecodeChunk(
+				  WlzEncodedValuesChunk *chk,
+				  WlzUByte *raw,
+				  int sz);
+static WlzErrorNum		WlzEncodedValuesGather(
+				  WlzObject *pObj,
+				  WlzEncodedValuesChunk *chk,
+				  WlzUByte *raw,
+				  int sz);
+static void			WlzEncodedValuesScatter(
+				  WlzIntervalDomain *iDom,
+				  WlzValues val,
+				  WlzEncodedValuesChunk *chk,
+				  WlzUByte *raw,
+				  int sz);
+static void			WlzEncodedValuesToLE(
+				  WlzUByte *dst,
+				  WlzUByte *src,
+				  int sz);
+static void			WlzEncodedValuesFromLE(
+				  WlzUByte *dst,
+				  WlzUByte *src,
+				  int sz);
+static void			WlzEncodedValuesWordToLE(
+				  WlzUByte *b,
+				  WlzUInt w);
+static WlzUInt			WlzEncodedValuesWordFromLE(
+				  WlzUByte *b);
+static int			WlzEncodedValuesPutWord(
+				  FILE *fP,
+				  WlzUInt w);
+static WlzUInt			WlzEncodedValuesGetWord(
+				  FILE *fP,
+				  WlzErrorNum *dstErr);
+
+/*!
+* \ingroup	WlzIO
+* \brief	Encoding used when writing grey value tables, see
+* 		WlzEncodedValuesType().
+*/
+static WlzValueEncoding		wlzEncodedValuesType =
+				  WLZ_VALUE_ENCODING_NONE;
+
+/*!
+* \ingroup	WlzIO
+* \brief	Non-zero once wlzEncodedValuesType has been set either
+* 		from the environment or by WlzEncodedValuesSetType().
+*/
+static int			wlzEncodedValuesTypeSet = 0;
+
+/*!
+* \return	Encoding used for grey value tables.
+* \ingroup	WlzIO
+* \brief	Gets the encoding used by WlzWriteObj() when writing the
+* 		grey value tables (including tiled value tables) of 2D
+* 		and 3D domain objects.
+* 		Unless it has been set by WlzEncodedValuesSetType() the
+* 		encoding is taken from the environment variable
+* 		WLZ_VALUE_ENCODING, which may be "none", "rle" or "zlib",
+* 		and is otherwise WLZ_VALUE_ENCODING_NONE.
+*/
+WlzValueEncoding		WlzEncodedValuesType(void)
+{
+  WlzValueEncoding enc = WLZ_VALUE_ENCODING_NONE;
+
+#ifdef _OPENMP
+#pragma omp critical (WlzEncodedValuesType)
+#endif
+  {
+    if(wlzEncodedValuesTypeSet == 0)
+    {
+      char	*envStr;
+
+      if((envStr = getenv("WLZ_VALUE_ENCODING")) != NULL)
+      {
+        if(strcmp(envStr, "rle") == 0)
+	{
+	  wlzEncodedValuesType = WLZ_VALUE_ENCODING_RLE;
+	}
+	else if(strcmp(envStr, "zlib") == 0)
+	{
+	  wlzEncodedValuesType = WLZ_VALUE_ENCODING_ZLIB;
+	}
+      }
+      wlzEncodedValuesTypeSet = 1;
+    }
+    enc = wlzEncodedValuesType;
+  }
+  return(enc);
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Sets the encoding to be used by WlzWriteObj() when writing
+* 		grey value tables after this call. See
+* 		WlzEncodedValuesType().
+* \param	enc			Required encoding.
+*/
+void				WlzEncodedValuesSetType(
+				  WlzValueEncoding enc)
+{
+#ifdef _OPENMP
+#pragma omp critical (WlzEncodedValuesType)
+#endif
+  {
+    wlzEncodedValuesType = enc;
+    wlzEncodedValuesTypeSet = 1;
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes the grey value table of the given 2D or 3D domain
+* 		object as an encoded value table, including the value
+* 		table type. Tiled values are encoded a tile at a time,
+* 		other values are gathered in chunks of lines. In both
+* 		cases the values are encoded in parallel and then written
+* 		in order. If the values can not be encoded (because they
+* 		are of an unsupported grey type, have an unusual domain
+* 		or are tiled values without any tiles) WLZ_ERR_VALUES_TYPE
+* 		is returned before anything has been written, allowing the
+* 		caller to write the values in some other form.
+* \param	fP			Given file.
+* \param	obj			Given object which must have a
+* 					non-NULL domain and values.
+* \param	enc			Required encoding, if this is
+* 					WLZ_VALUE_ENCODING_NONE then the
+* 					values are stored uncompressed.
+*/
+WlzErrorNum			WlzEncodedValuesWrite(
+				  FILE *fP,
+				  WlzObject *obj,
+				  WlzValueEncoding enc)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+#if HAVE_ZLIB == 0
+  if(enc == WLZ_VALUE_ENCODING_ZLIB)
+  {
+    enc = WLZ_VALUE_ENCODING_RLE;
+  }
+#endif
+  if((fP == NULL) || (obj == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(obj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if((obj->type != WLZ_2D_DOMAINOBJ) && (obj->type != WLZ_3D_DOMAINOBJ))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(WlzGreyTableIsTiled(obj->values.core->type) != 0)
+  {
+    if(obj->values.t->dim != ((obj->type == WLZ_2D_DOMAINOBJ)? 2: 3))
+    {
+      errNum = WLZ_ERR_VALUES_TYPE;
+    }
+    else
+    {
+      errNum = WlzEncodedValuesWriteTiles(fP, obj->values.t, enc);
+    }
+  }
+  else
+  {
+    errNum = WlzEncodedValuesWriteLines(fP, obj, enc);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes the (non tiled) grey value table of the given 2D
+* 		or 3D domain object as an encoded value table of chunks
+* 		of lines. See WlzEncodedValuesWrite().
+* \param	fP			Given file.
+* \param	obj			Given object with non-NULL domain
+* 					and values.
+* \param	enc			Required encoding.
+*/
+static WlzErrorNum		WlzEncodedValuesWriteLines(
+				  FILE *fP,
+				  WlzObject *obj,
+				  WlzValueEncoding enc)
+{
+  int		idc,
+  		nPln = 1,
+		sz = 0,
+		nChk = 0,
+		plane1 = 0;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzPixelV	bgd;
+  WlzUByte	bgdLE[8];
+  WlzObject	*pObj = NULL;
+  WlzEncodedValuesChunk *chk = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((fP == NULL) || (obj == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(obj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else
+  {
+    switch(obj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	if((WlzGreyTableIsTiled(obj->values.core->type) != 0) ||
+	   (WlzEncodedValuesDomainOK(obj->domain) == 0))
+	{
+	  errNum = WLZ_ERR_VALUES_TYPE;
+	}
+	else
+	{
+	  gType = WlzGreyTableTypeToGreyType(obj->values.core->type, NULL);
+	}
+        break;
+      case WLZ_3D_DOMAINOBJ:
+	if((obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN) ||
+	   (obj->values.core->type != WLZ_VOXELVALUETABLE_GREY) ||
+	   (obj->values.vox->plane1 != obj->domain.p->plane1) ||
+	   (obj->values.vox->lastpl != obj->domain.p->lastpl))
+	{
+	  errNum = WLZ_ERR_VALUES_TYPE;
+	}
+	else
+	{
+	  int	   	p;
+	  WlzDomain 	*doms;
+	  WlzValues	*vals;
+
+	  plane1 = obj->domain.p->plane1;
+	  nPln = obj->domain.p->lastpl - plane1 + 1;
+	  doms = obj->domain.p->domains;
+	  vals = obj->values.vox->values;
+	  for(p = 0; (errNum == WLZ_ERR_NONE) && (p < nPln); ++p)
+	  {
+	    if((doms[p].core != NULL) && (vals[p].core != NULL) &&
+	       (doms[p].core->type != WLZ_EMPTY_DOMAIN))
+	    {
+	      WlzGreyType pGType;
+
+	      pGType = WlzGreyTableTypeToGreyType(vals[p].core->type, NULL);
+	      if((WlzGreyTableIsTiled(vals[p].core->type) != 0) ||
+		 (WlzEncodedValuesDomainOK(doms[p]) == 0) ||
+	         ((gType != WLZ_GREY_ERROR) && (pGType != gType)))
+	      {
+		errNum = WLZ_ERR_VALUES_TYPE;
+	      }
+	      gType = pGType;
+	    }
+	  }
+	  if(gType == WLZ_GREY_ERROR)
+	  {
+	    /* No planes with values so use the voxel table background. */
+	    gType = obj->values.vox->bckgrnd.type;
+	  }
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     ((sz = WlzEncodedValuesGreySz(gType)) == 0))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bgd = WlzGetBackground(obj, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzValueConvertPixel(&bgd, bgd, gType);
+    }
+    WlzEncodedValuesToLE(bgdLE, (WlzUByte *)&(bgd.v), sz);
+  }
+  /* Make a 2D object for each plane, these are only used for grey
+   * scans and are never assigned. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((pObj = (WlzObject *)AlcCalloc(nPln, sizeof(WlzObject))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if(obj->type == WLZ_2D_DOMAINOBJ)
+    {
+      pObj[0].type = WLZ_2D_DOMAINOBJ;
+      pObj[0].domain = obj->domain;
+      pObj[0].values = obj->values;
+    }
+    else
+    {
+      int	p;
+
+      for(p = 0; p < nPln; ++p)
+      {
+	WlzDomain dom;
+	WlzValues val;
+
+	dom = obj->domain.p->domains[p];
+	val = obj->values.vox->values[p];
+        pObj[p].type = WLZ_EMPTY_OBJ;
+	if((dom.core != NULL) && (val.core != NULL) &&
+	   (dom.core->type != WLZ_EMPTY_DOMAIN))
+	{
+	  pObj[p].type = WLZ_2D_DOMAINOBJ;
+	  pObj[p].domain = dom;
+	  pObj[p].values = val;
+	}
+      }
+    }
+  }
+  /* Partition the lines of each plane into chunks, counting them in the
+   * first pass and filling them in in the second. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		pass;
+
+    for(pass = 0; (errNum == WLZ_ERR_NONE) && (pass < 2); ++pass)
+    {
+      int	p;
+
+      nChk = 0;
+      for(p = 0; p < nPln; ++p)
+      {
+	if(pObj[p].type == WLZ_2D_DOMAINOBJ)
+	{
+	  int	ln,
+	  	ln0;
+	  size_t rawSz = 0;
+	  WlzIntervalDomain *iDom;
+
+	  iDom = pObj[p].domain.i;
+	  ln0 = iDom->line1;
+	  for(ln = iDom->line1; ln <= iDom->lastln + 1; ++ln)
+	  {
+	    size_t lnSz = 0;
+
+	    if(ln <= iDom->lastln)
+	    {
+	      lnSz = WlzEncodedValuesLineArea(iDom, ln) * sz;
+	    }
+	    if((ln > iDom->lastln) ||
+	       ((rawSz > 0) && (rawSz + lnSz > WLZ_ENCODEDVALUES_CHUNK_SZ)))
+	    {
+	      if(chk)
+	      {
+	        chk[nChk].pIdx = p;
+	        chk[nChk].ln0 = ln0;
+	        chk[nChk].nLn = ln - ln0;
+	        chk[nChk].codec = enc;
+	        chk[nChk].rawSz = rawSz;
+	      }
+	      ++nChk;
+	      ln0 = ln;
+	      rawSz = 0;
+	    }
+	    rawSz += lnSz;
+	  }
+	}
+      }
+      if((pass == 0) && (nChk > 0) &&
+         ((chk = (WlzEncodedValuesChunk *)
+	         AlcCalloc(nChk, sizeof(WlzEncodedValuesChunk))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    for(idc = 0; (errNum == WLZ_ERR_NONE) && (idc < nChk); ++idc)
+    {
+      if(chk[idc].rawSz > UINT_MAX)
+      {
+        errNum = WLZ_ERR_VALUES_DATA;
+      }
+    }
+  }
+  /* Gather and encode the chunks in parallel. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idc = 0; idc < nChk; ++idc)
+    {
+      WlzUByte	*raw = NULL;
+      WlzEncodedValuesChunk *c;
+
+      c = chk + idc;
+      if((raw = (WlzUByte *)AlcMalloc(c->rawSz + 1)) == NULL)
+      {
+        c->errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        c->errNum = WlzEncodedValuesGather(pObj + c->pIdx, c, raw, sz);
+      }
+      if(c->errNum == WLZ_ERR_NONE)
+      {
+	c->errNum = WlzEncodedValuesEncodeChunk(c, raw, sz);
+      }
+      AlcFree(raw);
+    }
+    for(idc = 0; (errNum == WLZ_ERR_NONE) && (idc < nChk); ++idc)
+    {
+      errNum = chk[idc].errNum;
+    }
+  }
+  /* Write the encoded value table. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((putc((unsigned int )WLZ_VALUETABLE_ENCODED, fP) == EOF) ||
+       (putc((unsigned int )WLZ_ENCODEDVALUES_LINES, fP) == EOF) ||
+       (putc((unsigned int )gType, fP) == EOF) ||
+       (fwrite(bgdLE, sizeof(WlzUByte), sz, fP) != (size_t )sz) ||
+       (WlzEncodedValuesPutWord(fP, nChk) == 0))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    for(idc = 0; (errNum == WLZ_ERR_NONE) && (idc < nChk); ++idc)
+    {
+      WlzEncodedValuesChunk *c;
+
+      c = chk + idc;
+      if((putc((unsigned int )(c->codec), fP) == EOF) ||
+	 (WlzEncodedValuesPutWord(fP, c->pIdx + plane1) == 0) ||
+	 (WlzEncodedValuesPutWord(fP, c->ln0) == 0) ||
+	 (WlzEncodedValuesPutWord(fP, c->nLn) == 0) ||
+	 (WlzEncodedValuesPutWord(fP, c->rawSz) == 0) ||
+	 (WlzEncodedValuesPutWord(fP, c->encSz) == 0) ||
+	 (fwrite(c->enc, sizeof(WlzUByte), c->encSz, fP) != c->encSz))
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+    }
+  }
+  if(chk)
+  {
+    for(idc = 0; idc < nChk; ++idc)
+    {
+      AlcFree(chk[idc].enc);
+    }
+    AlcFree(chk);
+  }
+  AlcFree(pObj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads an encoded value table for the given 2D or 3D
+* 		domain object, the value table type having already been
+* 		read. Encoded chunks of lines are read in batches which
+* 		are decoded in parallel into new ragged rectangle value
+* 		tables (or rectangular value tables for rectangular
+* 		domains). Encoded tiles are read into a new tiled value
+* 		table, either by reading and decoding all the tiles or,
+* 		if a page cache size has been set (see
+* 		WlzTiledValuesPageCacheSz()), by reading only the table
+* 		of encoded tiles so that each tile is read and decoded
+* 		when it is first paged in.
+* \param	fP			Given file.
+* \param	obj			Given object with a valid domain
+* 					and NULL values.
+*/
+WlzErrorNum			WlzEncodedValuesRead(
+				  FILE *fP,
+				  WlzObject *obj)
+{
+  int		c;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((fP == NULL) || (obj == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((obj->type != WLZ_2D_DOMAINOBJ) && (obj->type != WLZ_3D_DOMAINOBJ))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if((c = getc(fP)) == EOF)
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  else
+  {
+    switch(c)
+    {
+      case WLZ_ENCODEDVALUES_LINES:
+        errNum = WlzEncodedValuesReadLines(fP, obj);
+	break;
+      case WLZ_ENCODEDVALUES_TILES:
+        errNum = WlzEncodedValuesReadTiles(fP, obj);
+	break;
+      default:
+        errNum = WLZ_ERR_VALUES_TYPE;
+	break;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Decodes the values of a single encoded chunk or tile.
+* 		This is used to decode the tiles of a paged tiled value
+* 		table as they are read.
+* \param	raw			Destination for the raw native values.
+* \param	rawSz			Size of the raw values in bytes.
+* \param	enc			Encoded values.
+* \param	encSz			Size of the encoded values in bytes.
+* \param	codec			Codec used to encode the values.
+* \param	valSz			Size of a single grey value in bytes.
+*/
+WlzErrorNum			WlzEncodedValuesDecode(
+				  WlzUByte *raw,
+				  size_t rawSz,
+				  WlzUByte *enc,
+				  size_t encSz,
+				  WlzValueEncoding codec,
+				  int valSz)
+{
+  WlzEncodedValuesChunk chk;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((raw == NULL) || (enc == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((valSz < 1) || ((rawSz % valSz) != 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((errNum = WlzEncodedValuesCodecOK(codec)) == WLZ_ERR_NONE)
+  {
+    if((encSz > rawSz) ||
+       ((codec == WLZ_VALUE_ENCODING_NONE) && (encSz != rawSz)))
+    {
+      errNum = WLZ_ERR_VALUES_DATA;
+    }
+    else
+    {
+      (void )memset(&chk, 0, sizeof(WlzEncodedValuesChunk));
+      chk.codec = codec;
+      chk.rawSz = rawSz;
+      chk.encSz = encSz;
+      chk.enc = enc;
+      errNum = WlzEncodedValuesDecodeChunk(&chk, raw, valSz);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads the encoded chunks of lines of an encoded value
+* 		table, the value table type and form having already been
+* 		read. The chunks are read in batches with each batch
+* 		decoded in parallel before the next is read.
+* \param	fP			Given file.
+* \param	obj			Given 2D or 3D domain object with a
+* 					valid domain and NULL values.
+*/
+static WlzErrorNum		WlzEncodedValuesReadLines(
+				  FILE *fP,
+				  WlzObject *obj)
+{
+  int		c,
+  		idc,
+  		sz = 0,
+		nPln = 1,
+		plane1 = 0,
+		nChk = 0;
+  WlzGreyType	gType;
+  WlzPixelV	bgd;
+  WlzUByte	bgdLE[8];
+  WlzDomain	*doms = NULL;
+  WlzValues	*vals = NULL;
+  WlzEncodedValuesChunk *chk = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((c = getc(fP)) == EOF)
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  else if((sz = WlzEncodedValuesGreySz(gType = (WlzGreyType )c)) == 0)
+  {
+    errNum = WLZ_ERR_GREY_TYPE;
+  }
+  else if(fread(bgdLE, sizeof(WlzUByte), sz, fP) != (size_t )sz)
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  else
+  {
+    bgd.type = gType;
+    bgd.v.dbv = 0.0;
+    WlzEncodedValuesFromLE((WlzUByte *)&(bgd.v), bgdLE, sz);
+    nChk = (int )WlzEncodedValuesGetWord(fP, &errNum);
+    if((errNum == WLZ_ERR_NONE) && (nChk < 0))
+    {
+      errNum = WLZ_ERR_VALUES_DATA;
+    }
+  }
+  /* Set up the value tables, those for individual planes are only made
+   * as they are needed. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(obj->type == WLZ_2D_DOMAINOBJ)
+    {
+      doms = &(obj->domain);
+      vals = &(obj->values);
+    }
+    else if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+    {
+      errNum = WLZ_ERR_DOMAIN_TYPE;
+    }
+    else
+    {
+      WlzValues	val;
+
+      plane1 = obj->domain.p->plane1;
+      nPln = obj->domain.p->lastpl - plane1 + 1;
+      val.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
+				    plane1, obj->domain.p->lastpl,
+				    bgd, obj, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        obj->values = WlzAssignValues(val, NULL);
+	doms = obj->domain.p->domains;
+	vals = obj->values.vox->values;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nChk > 0) &&
+     ((chk = (WlzEncodedValuesChunk *)
+             AlcCalloc(nChk, sizeof(WlzEncodedValuesChunk))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Read the chunks in batches, decoding each batch in parallel (each
+   * chunk into it's own lines) before the next batch is read. This bounds
+   * the memory used for the encoded values and overlaps reading with
+   * decoding. */
+  idc = 0;
+  while((errNum == WLZ_ERR_NONE) && (idc < nChk))
+  {
+    int		idb,
+    		bat0;
+    size_t	batSz = 0;
+
+    bat0 = idc;
+    while((errNum == WLZ_ERR_NONE) && (idc < nChk) &&
+          (batSz < WLZ_ENCODEDVALUES_BATCH_SZ))
+    {
+      WlzEncodedValuesChunk *k;
+
+      k = chk + idc;
+      if((c = getc(fP)) == EOF)
+      {
+	errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+      else
+      {
+	k->codec = (WlzValueEncoding )c;
+	errNum = WlzEncodedValuesCodecOK(k->codec);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	k->pIdx = (int )WlzEncodedValuesGetWord(fP, &errNum) - plane1;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	k->ln0 = (int )WlzEncodedValuesGetWord(fP, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	k->nLn = (int )WlzEncodedValuesGetWord(fP, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	k->rawSz = WlzEncodedValuesGetWord(fP, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	k->encSz = WlzEncodedValuesGetWord(fP, &errNum);
+      }
+      /* Check the chunk against the domain of it's plane. */
+      if(errNum == WLZ_ERR_NONE)
+      {
+	if((k->pIdx < 0) || (k->pIdx >= nPln) || (k->nLn < 1) ||
+	   (doms[k->pIdx].core == NULL) ||
+	   (WlzEncodedValuesDomainOK(doms[k->pIdx]) == 0) ||
+	   (k->ln0 < doms[k->pIdx].i->line1) ||
+	   (k->ln0 + k->nLn - 1 > doms[k->pIdx].i->lastln))
+	{
+	  errNum = WLZ_ERR_VALUES_DATA;
+	}
+	else
+	{
+	  int	ln;
+	  size_t	rawSz = 0;
+
+	  for(ln = k->ln0; ln < k->ln0 + k->nLn; ++ln)
+	  {
+	    rawSz += WlzEncodedValuesLineArea(doms[k->pIdx].i, ln) * sz;
+	  }
+	  if((rawSz != k->rawSz) ||
+	     ((k->codec == WLZ_VALUE_ENCODING_NONE) && (k->encSz != rawSz)))
+	  {
+	    errNum = WLZ_ERR_VALUES_DATA;
+	  }
+	}
+      }
+      if((errNum == WLZ_ERR_NONE) && (vals[k->pIdx].core == NULL))
+      {
+	WlzObject	tObj;
+	WlzValues	val;
+	WlzObjectType vType;
+
+	tObj.type = WLZ_2D_DOMAINOBJ;
+	tObj.linkcount = 0;
+	tObj.domain = doms[k->pIdx];
+	tObj.values.core = NULL;
+	tObj.plist = NULL;
+	tObj.assoc = NULL;
+	vType = WlzGreyValueTableType(0,
+		      (tObj.domain.core->type == WLZ_INTERVALDOMAIN_RECT)?
+		      WLZ_GREY_TAB_RECT: WLZ_GREY_TAB_RAGR, gType, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  val.v = WlzNewValueTb(&tObj, vType, bgd, &errNum);
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  vals[k->pIdx] = WlzAssignValues(val, NULL);
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	if((k->enc = (WlzUByte *)AlcMalloc(k->encSz + 1)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else if(fread(k->enc, sizeof(WlzUByte), k->encSz, fP) != k->encSz)
+	{
+	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	}
+      }
+      batSz += k->rawSz;
+      ++idc;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for(idb = bat0; idb < idc; ++idb)
+      {
+	WlzUByte	*raw = NULL;
+	WlzEncodedValuesChunk *k;
+
+	k = chk + idb;
+	if((raw = (WlzUByte *)AlcMalloc(k->rawSz + 1)) == NULL)
+	{
+	  k->errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  k->errNum = WlzEncodedValuesDecodeChunk(k, raw, sz);
+	}
+	if(k->errNum == WLZ_ERR_NONE)
+	{
+	  WlzEncodedValuesScatter(doms[k->pIdx].i, vals[k->pIdx], k, raw, sz);
+	}
+	AlcFree(raw);
+      }
+      for(idb = bat0; (errNum == WLZ_ERR_NONE) && (idb < idc); ++idb)
+      {
+	errNum = chk[idb].errNum;
+      }
+    }
+    for(idb = bat0; idb < idc; ++idb)
+    {
+      AlcFree(chk[idb].enc);
+      chk[idb].enc = NULL;
+    }
+  }
+  if(chk)
+  {
+    for(idc = 0; idc < nChk; ++idc)
+    {
+      AlcFree(chk[idc].enc);
+    }
+    AlcFree(chk);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes a tiled value table as an encoded value table of
+* 		tiles. The tiles are encoded in parallel in batches, with
+* 		each batch written before the next is encoded. Space is
+* 		reserved for the table of encoded tiles which is written
+* 		once all of the tiles have been, so the file must be
+* 		seekable (as it must be for any tiled values).
+* \param	fP			Given file.
+* \param	tVal			Given tiled value table.
+* \param	enc			Required encoding.
+*/
+static WlzErrorNum		WlzEncodedValuesWriteTiles(
+				  FILE *fP,
+				  WlzTiledValues *tVal,
+				  WlzValueEncoding enc)
+{
+  int		idx,
+  		sz = 0;
+  size_t	idt,
+  		nBat = 1,
+  		nIdx = 1,
+		rawSz = 0;
+  long		tblOff = 0,
+  		endOff = 0;
+  WlzGreyType	gType;
+  WlzPixelV	bgd;
+  WlzUByte	bgdLE[8];
+  WlzUByte	*tbl = NULL;
+  WlzEncodedValuesChunk *chk = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gType = WlzGreyTableTypeToGreyType(tVal->type, &errNum);
+  if((errNum != WLZ_ERR_NONE) ||
+     ((sz = WlzEncodedValuesGreySz(gType)) == 0) ||
+     ((tVal->tiles.v == NULL) && (tVal->pager == NULL)) ||
+     (tVal->tileSz < 1) || (tVal->vpe < 1) ||
+     (tVal->numTiles < 1) || (tVal->numTiles > UINT_MAX))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else
+  {
+    rawSz = tVal->tileSz * tVal->vpe * sz;
+    for(idx = 0; idx < tVal->dim; ++idx)
+    {
+      nIdx *= tVal->nIdx[idx];
+    }
+    if(rawSz > UINT_MAX)
+    {
+      errNum = WLZ_ERR_VALUES_TYPE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzValueConvertPixel(&bgd, tVal->bckgrnd, gType);
+    WlzEncodedValuesToLE(bgdLE, (WlzUByte *)&(bgd.v), sz);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nBat = WLZ_ENCODEDVALUES_BATCH_SZ / rawSz;
+    nBat = WLZ_CLAMP(nBat, 1, tVal->numTiles);
+    if(((chk = (WlzEncodedValuesChunk *)
+               AlcCalloc(nBat, sizeof(WlzEncodedValuesChunk))) == NULL) ||
+       ((tbl = (WlzUByte *)AlcMalloc(tVal->numTiles * 5)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Write the header, reserving space for the table of encoded tiles. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((putc((unsigned int )WLZ_VALUETABLE_ENCODED, fP) == EOF) ||
+       (putc((unsigned int )WLZ_ENCODEDVALUES_TILES, fP) == EOF) ||
+       (putc((unsigned int )(tVal->type), fP) == EOF) ||
+       (putc((unsigned int )(tVal->dim), fP) == EOF) ||
+       (WlzEncodedValuesPutWord(fP, tVal->kol1) == 0) ||
+       (WlzEncodedValuesPutWord(fP, tVal->lastkl) == 0) ||
+       (WlzEncodedValuesPutWord(fP, tVal->line1) == 0) ||
+       (WlzEncodedValuesPutWord(fP, tVal->lastln) == 0) ||
+       (WlzEncodedValuesPutWord(fP, tVal->plane1) == 0) ||
+       (WlzEncodedValuesPutWord(fP, tVal->lastpl) == 0) ||
+       (fwrite(bgdLE, sizeof(WlzUByte), sz, fP) != (size_t )sz) ||
+       (WlzEncodedValuesPutWord(fP, tVal->vRank) == 0))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < (int )(tVal->vRank));
+        ++idx)
+    {
+      if(WlzEncodedValuesPutWord(fP, tVal->vDim[idx]) == 0)
+      {
+        errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) &&
+       ((WlzEncodedValuesPutWord(fP, tVal->tileSz) == 0) ||
+        (WlzEncodedValuesPutWord(fP, tVal->tileWidth) == 0) ||
+        (WlzEncodedValuesPutWord(fP, tVal->numTiles) == 0)))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < tVal->dim); ++idx)
+    {
+      if(WlzEncodedValuesPutWord(fP, tVal->nIdx[idx]) == 0)
+      {
+        errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+    }
+    for(idt = 0; (errNum == WLZ_ERR_NONE) && (idt < nIdx); ++idt)
+    {
+      if(WlzEncodedValuesPutWord(fP, tVal->indices[idt]) == 0)
+      {
+        errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) &&
+       (((tblOff = ftell(fP)) < 0) ||
+        (fseek(fP, (long )(tVal->numTiles * 5), SEEK_CUR) != 0)))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  /* Encode the tiles in parallel a batch at a time, writing each batch
+   * in order. */
+  for(idt = 0; (errNum == WLZ_ERR_NONE) && (idt < tVal->numTiles);
+      idt += nBat)
+  {
+    int		idb,
+    		nChk;
+
+    nChk = (int )WLZ_MIN(nBat, tVal->numTiles - idt);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idb = 0; idb < nChk; ++idb)
+    {
+      WlzTiledValuesPage *page;
+      WlzEncodedValuesChunk *c;
+
+      c = chk + idb;
+      c->pIdx = (int )(idt + idb);
+      c->codec = enc;
+      c->rawSz = rawSz;
+      c->errNum = WLZ_ERR_NONE;
+      if(tVal->tiles.v)
+      {
+        c->errNum = WlzEncodedValuesEncodeChunk(c,
+				tVal->tiles.ubp + (c->pIdx * rawSz), sz);
+      }
+      else if((page = WlzTiledValuesPageIn(tVal, c->pIdx,
+                                           &(c->errNum))) != NULL)
+      {
+        c->errNum = WlzEncodedValuesEncodeChunk(c, page->values.ubp, sz);
+	WlzTiledValuesPageOut(tVal, page);
+      }
+    }
+    for(idb = 0; idb < nChk; ++idb)
+    {
+      WlzEncodedValuesChunk *c;
+
+      c = chk + idb;
+      if(errNum == WLZ_ERR_NONE)
+      {
+        if((errNum = c->errNum) == WLZ_ERR_NONE)
+	{
+	  tbl[c->pIdx * 5] = (WlzUByte )(c->codec);
+	  WlzEncodedValuesWordToLE(tbl + (c->pIdx * 5) + 1, c->encSz);
+	  if(fwrite(c->enc, sizeof(WlzUByte), c->encSz, fP) != c->encSz)
+	  {
+	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	  }
+	}
+      }
+      AlcFree(c->enc);
+      c->enc = NULL;
+    }
+  }
+  /* Write the table of encoded tiles. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((endOff = ftell(fP)) < 0) ||
+       (fseek(fP, tblOff, SEEK_SET) != 0) ||
+       (fwrite(tbl, sizeof(WlzUByte), tVal->numTiles * 5, fP) !=
+        tVal->numTiles * 5) ||
+       (fseek(fP, endOff, SEEK_SET) != 0))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  AlcFree(chk);
+  AlcFree(tbl);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads the encoded tiles of an encoded value table into a
+* 		new tiled value table, the value table type and form
+* 		having already been read. If a page cache size has been
+* 		set (see WlzTiledValuesPageCacheSz()) then only the table
+* 		of encoded tiles is read and a pager is made for the tiled
+* 		values which reads and decodes each tile on demand.
+* 		Otherwise the tiles are read in batches with each batch
+* 		decoded in parallel before the next is read.
+* \param	fP			Given file.
+* \param	obj			Given 2D or 3D domain object with a
+* 					valid domain and NULL values.
+*/
+static WlzErrorNum		WlzEncodedValuesReadTiles(
+				  FILE *fP,
+				  WlzObject *obj)
+{
+  int		c,
+  		idx,
+		dim = 0,
+		vRank = 0,
+		sz = 0;
+  int		bnd[6];
+  size_t	idt,
+  		nBat = 1,
+  		nIdx = 1,
+		rawSz = 0;
+  long		*off = NULL;
+  WlzUByte	*tbl = NULL,
+  		*codec = NULL;
+  WlzObjectType	tType = WLZ_NULL;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzPixelV	bgd;
+  WlzUByte	bgdLE[8];
+  WlzTiledValues *tVal = NULL;
+  WlzEncodedValuesChunk *chk = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((c = getc(fP)) == EOF)
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  else if(WlzGreyTableIsTiled(tType = (WlzObjectType )c) == 0)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else
+  {
+    gType = WlzGreyTableTypeToGreyType(tType, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      vRank = WlzGreyTableTypeToRank(tType, &errNum);
+    }
+    if((errNum == WLZ_ERR_NONE) &&
+       ((sz = WlzEncodedValuesGreySz(gType)) == 0))
+    {
+      errNum = WLZ_ERR_GREY_TYPE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((dim = getc(fP)) == EOF)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else if(dim != ((obj->type == WLZ_2D_DOMAINOBJ)? 2: 3))
+    {
+      errNum = WLZ_ERR_VALUES_DATA;
+    }
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 6); ++idx)
+  {
+    bnd[idx] = (int )WlzEncodedValuesGetWord(fP, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(fread(bgdLE, sizeof(WlzUByte), sz, fP) != (size_t )sz)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else
+    {
+      bgd.type = gType;
+      bgd.v.dbv = 0.0;
+      WlzEncodedValuesFromLE((WlzUByte *)&(bgd.v), bgdLE, sz);
+    }
+  }
+  /* The rank given by the table type only distinguishes scalar from
+   * array values, so the actual rank follows. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		rank;
+
+    rank = (int )WlzEncodedValuesGetWord(fP, &errNum);
+    if((errNum == WLZ_ERR_NONE) &&
+       ((rank < 0) || ((rank > 0) != (vRank > 0))))
+    {
+      errNum = WLZ_ERR_VALUES_DATA;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      vRank = rank;
+      tVal = WlzMakeTiledValues(dim, vRank, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tVal->type = tType;
+    tVal->kol1 = bnd[0];
+    tVal->lastkl = bnd[1];
+    tVal->line1 = bnd[2];
+    tVal->lastln = bnd[3];
+    tVal->plane1 = bnd[4];
+    tVal->lastpl = bnd[5];
+    tVal->bckgrnd = bgd;
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < vRank); ++idx)
+    {
+      tVal->vDim[idx] = WlzEncodedValuesGetWord(fP, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tVal->vpe = WlzTiledValuesValPerElm(tVal);
+    tVal->tileSz = WlzEncodedValuesGetWord(fP, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tVal->tileWidth = WlzEncodedValuesGetWord(fP, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tVal->numTiles = WlzEncodedValuesGetWord(fP, &errNum);
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < dim); ++idx)
+  {
+    tVal->nIdx[idx] = (int )WlzEncodedValuesGetWord(fP, &errNum);
+    if((errNum == WLZ_ERR_NONE) && (tVal->nIdx[idx] < 1))
+    {
+      errNum = WLZ_ERR_VALUES_DATA;
+    }
+    nIdx *= tVal->nIdx[idx];
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rawSz = tVal->tileSz * tVal->vpe * sz;
+    if((tVal->tileSz < 1) || (tVal->vpe < 1) || (tVal->numTiles < 1) ||
+       (rawSz > UINT_MAX))
+    {
+      errNum = WLZ_ERR_VALUES_DATA;
+    }
+    else if(((tVal->indices = (unsigned int *)
+                 AlcMalloc(nIdx * sizeof(unsigned int))) == NULL) ||
+            ((tbl = (WlzUByte *)AlcMalloc(tVal->numTiles * 5)) == NULL) ||
+	    ((codec = (WlzUByte *)AlcMalloc(tVal->numTiles)) == NULL) ||
+	    ((off = (long *)AlcMalloc((tVal->numTiles + 1) *
+	                              sizeof(long))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  for(idt = 0; (errNum == WLZ_ERR_NONE) && (idt < nIdx); ++idt)
+  {
+    tVal->indices[idt] = WlzEncodedValuesGetWord(fP, &errNum);
+  }
+  /* Read the table of encoded tiles and compute the offset of each
+   * encoded tile (relative to the first) from it. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(fread(tbl, sizeof(WlzUByte), tVal->numTiles * 5, fP) !=
+       tVal->numTiles * 5)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    off[0] = 0;
+  }
+  for(idt = 0; (errNum == WLZ_ERR_NONE) && (idt < tVal->numTiles); ++idt)
+  {
+    size_t	encSz;
+
+    codec[idt] = tbl[idt * 5];
+    encSz = WlzEncodedValuesWordFromLE(tbl + (idt * 5) + 1);
+    if((errNum = WlzEncodedValuesCodecOK(
+                 (WlzValueEncoding )(codec[idt]))) == WLZ_ERR_NONE)
+    {
+      if((encSz > rawSz) ||
+         ((codec[idt] == WLZ_VALUE_ENCODING_NONE) && (encSz != rawSz)))
+      {
+        errNum = WLZ_ERR_VALUES_DATA;
+      }
+      off[idt + 1] = off[idt] + (long )encSz;
+    }
+  }
+#ifdef WLZ_USE_PREAD
+  /* If a page cache size has been set and the file is seekable then
+   * leave the tiles in the file to be read and decoded as they are
+   * paged in. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    long	base,
+    		end;
+    size_t	cacheSz;
+
+    if(((cacheSz = WlzTiledValuesPageCacheSz()) > 0) &&
+       ((base = ftell(fP)) >= 0))
+    {
+      int	fd;
+
+      if((fd = dup(fileno(fP))) >= 0)
+      {
+	tVal->tileOffset = base;
+	if(WlzMakeTiledValuesPager(tVal, fd, cacheSz) != WLZ_ERR_NONE)
+	{
+	  (void )close(fd);
+	}
+	else
+	{
+	  for(idt = 0; idt <= tVal->numTiles; ++idt)
+	  {
+	    off[idt] += base;
+	  }
+	  tVal->pager->encOffset = off;
+	  tVal->pager->encCodec = codec;
+	  off = NULL;
+	  codec = NULL;
+	  /* Check that the file is not truncated by reading the last
+	   * byte of the last tile, leaving the file after it. */
+	  end = tVal->pager->encOffset[tVal->numTiles];
+	  if(((end > base) &&
+	      ((fseek(fP, end - 1, SEEK_SET) != 0) || (getc(fP) == EOF))) ||
+	     (fseek(fP, end, SEEK_SET) != 0))
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	}
+      }
+    }
+  }
+#endif /* WLZ_USE_PREAD */
+  /* Otherwise read the tiles a batch at a time, decoding each batch in
+   * parallel before the next is read. */
+  if((errNum == WLZ_ERR_NONE) && (tVal->pager == NULL))
+  {
+    nBat = WLZ_ENCODEDVALUES_BATCH_SZ / rawSz;
+    nBat = WLZ_CLAMP(nBat, 1, tVal->numTiles);
+    if(((tVal->tiles.v = AlcMalloc(tVal->numTiles * rawSz)) == NULL) ||
+       ((chk = (WlzEncodedValuesChunk *)
+               AlcCalloc(nBat, sizeof(WlzEncodedValuesChunk))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    for(idt = 0; (errNum == WLZ_ERR_NONE) && (idt < tVal->numTiles);
+        idt += nBat)
+    {
+      int	idb,
+      		nChk;
+
+      nChk = (int )WLZ_MIN(nBat, tVal->numTiles - idt);
+      for(idb = 0; (errNum == WLZ_ERR_NONE) && (idb < nChk); ++idb)
+      {
+	WlzEncodedValuesChunk *k;
+
+	k = chk + idb;
+	k->pIdx = (int )(idt + idb);
+	k->codec = (WlzValueEncoding )(codec[k->pIdx]);
+	k->rawSz = rawSz;
+	k->encSz = off[k->pIdx + 1] - off[k->pIdx];
+	if((k->enc = (WlzUByte *)AlcMalloc(k->encSz + 1)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else if(fread(k->enc, sizeof(WlzUByte), k->encSz, fP) != k->encSz)
+	{
+	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for(idb = 0; idb < nChk; ++idb)
+	{
+	  WlzEncodedValuesChunk *k;
+
+	  k = chk + idb;
+	  k->errNum = WlzEncodedValuesDecodeChunk(k,
+				tVal->tiles.ubp + (k->pIdx * rawSz), sz);
+	}
+	for(idb = 0; (errNum == WLZ_ERR_NONE) && (idb < nChk); ++idb)
+	{
+	  errNum = chk[idb].errNum;
+	}
+      }
+      for(idb = 0; idb < nChk; ++idb)
+      {
+        AlcFree(chk[idb].enc);
+	chk[idb].enc = NULL;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj->values.t = tVal;
+    (void )WlzAssignValues(obj->values, NULL);
+  }
+  else if(tVal)
+  {
+    (void )WlzFreeTiledValues(tVal);
+  }
+  AlcFree(chk);
+  AlcFree(tbl);
+  AlcFree(codec);
+  AlcFree(off);
+  return(errNum);
+}
+
+/*!
+* \return	Size of a grey value in bytes or zero if the grey type
+* 		can not be encoded.
+* \ingroup	WlzIO
+* \brief	Gives the size of the grey values of an encoded value
+* 		table.
+* \param	gType			Given grey type.
+*/
+static int			WlzEncodedValuesGreySz(
+				  WlzGreyType gType)
+{
+  int		sz = 0;
+
+  switch(gType)
+  {
+    case WLZ_GREY_UBYTE:
+      sz = 1;
+      break;
+    case WLZ_GREY_SHORT:
+      sz = 2;
+      break;
+    case WLZ_GREY_INT:   /* FALLTHROUGH */
+    case WLZ_GREY_FLOAT: /* FALLTHROUGH */
+    case WLZ_GREY_RGBA:
+      sz = 4;
+      break;
+    case WLZ_GREY_DOUBLE:
+      sz = 8;
+      break;
+    default:
+      break;
+  }
+  return(sz);
+}
+
+/*!
+* \return	Non-zero if the domain is an interval or rectangular
+* 		domain.
+* \ingroup	WlzIO
+* \brief	Checks that a 2D domain can have encoded values.
+* \param	dom			Given domain, known to be non-NULL.
+*/
+static int			WlzEncodedValuesDomainOK(
+				  WlzDomain dom)
+{
+  return((dom.core->type == WLZ_INTERVALDOMAIN_INTVL) ||
+         (dom.core->type == WLZ_INTERVALDOMAIN_RECT));
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Checks that values encoded with the given codec can be
+* 		decoded.
+* \param	codec			Given codec.
+*/
+static WlzErrorNum		WlzEncodedValuesCodecOK(
+				  WlzValueEncoding codec)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(codec)
+  {
+    case WLZ_VALUE_ENCODING_NONE: /* FALLTHROUGH */
+    case WLZ_VALUE_ENCODING_RLE:
+      break;
+    case WLZ_VALUE_ENCODING_ZLIB:
+#if HAVE_ZLIB == 0
+      errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif
+      break;
+    default:
+      errNum = WLZ_ERR_VALUES_DATA;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Number of values in the line.
+* \ingroup	WlzIO
+* \brief	Computes the number of values within a line of an
+* 		interval or rectangular domain.
+* \param	iDom			Given domain.
+* \param	ln			Line within the domain.
+*/
+static size_t			WlzEncodedValuesLineArea(
+				  WlzIntervalDomain *iDom,
+				  int ln)
+{
+  size_t	area = 0;
+
+  if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+  {
+    area = iDom->lastkl - iDom->kol1 + 1;
+  }
+  else
+  {
+    int		idx;
+    WlzIntervalLine *itvLn;
+
+    itvLn = iDom->intvlines + ln - iDom->line1;
+    for(idx = 0; idx < itvLn->nintvs; ++idx)
+    {
+      area += itvLn->intvs[idx].iright - itvLn->intvs[idx].ileft + 1;
+    }
+  }
+  return(area);
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Delta codes and byte shuffles values so that they are
+* 		independent of the native byte order and (for smooth
+* 		images) have long runs of small bytes.
+* \param	dst			Destination for the n * sz filtered
+* 					bytes.
+* \param	src			Source native values.
+* \param	n			Number of values.
+* \param	sz			Size of the values in bytes.
+*/
+static void			WlzEncodedValuesFilter(
+				  WlzUByte *dst,
+				  WlzUByte *src,
+				  size_t n,
+				  int sz)
+{
+  size_t	idx;
+
+  switch(sz)
+  {
+    case 1:
+      {
+        WlzUByte p = 0;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+	  dst[idx] = (WlzUByte )(src[idx] - p);
+	  p = src[idx];
+	}
+      }
+      break;
+    case 2:
+      {
+        unsigned short p = 0,
+			v;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+	  unsigned short d;
+
+	  memcpy(&v, src + 2 * idx, 2);
+	  d = (unsigned short )(v - p);
+	  p = v;
+	  dst[idx] = (WlzUByte )(d & 0xff);
+	  dst[n + idx] = (WlzUByte )(d >> 8);
+	}
+      }
+      break;
+    case 4:
+      {
+        WlzUInt	p = 0,
+		v;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+	  WlzUInt d;
+
+	  memcpy(&v, src + 4 * idx, 4);
+	  d = v - p;
+	  p = v;
+	  dst[idx] = (WlzUByte )(d & 0xff);
+	  dst[n + idx] = (WlzUByte )((d >> 8) & 0xff);
+	  dst[2 * n + idx] = (WlzUByte )((d >> 16) & 0xff);
+	  dst[3 * n + idx] = (WlzUByte )(d >> 24);
+	}
+      }
+      break;
+    case 8:
+      {
+        WlzULong p = 0,
+		 v;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+	  int	  b;
+	  WlzULong d;
+
+	  memcpy(&v, src + 8 * idx, 8);
+	  d = v - p;
+	  p = v;
+	  for(b = 0; b < 8; ++b)
+	  {
+	    dst[b * n + idx] = (WlzUByte )((d >> (8 * b)) & 0xff);
+	  }
+	}
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Inverts WlzEncodedValuesFilter().
+* \param	dst			Destination for the n native values.
+* \param	src			Source filtered bytes.
+* \param	n			Number of values.
+* \param	sz			Size of the values in bytes.
+*/
+static void			WlzEncodedValuesUnfilter(
+				  WlzUByte *dst,
+				  WlzUByte *src,
+				  size_t n,
+				  int sz)
+{
+  size_t	idx;
+
+  switch(sz)
+  {
+    case 1:
+      {
+        WlzUByte p = 0;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+	  p = (WlzUByte )(p + src[idx]);
+	  dst[idx] = p;
+	}
+      }
+      break;
+    case 2:
+      {
+        unsigned short p = 0;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+	  p = (unsigned short )(p + (src[idx] | (src[n + idx] << 8)));
+	  memcpy(dst + 2 * idx, &p, 2);
+	}
+      }
+      break;
+    case 4:
+      {
+        WlzUInt	p = 0;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+	  p += (WlzUInt )(src[idx]) |
+	       ((WlzUInt )(src[n + idx]) << 8) |
+	       ((WlzUInt )(src[2 * n + idx]) << 16) |
+	       ((WlzUInt )(src[3 * n + idx]) << 24);
+	  memcpy(dst + 4 * idx, &p, 4);
+	}
+      }
+      break;
+    case 8:
+      {
+        WlzULong p = 0;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+	  int	  b;
+	  WlzULong d = 0;
+
+	  for(b = 0; b < 8; ++b)
+	  {
+	    d |= (WlzULong )(src[b * n + idx]) << (8 * b);
+	  }
+	  p += d;
+	  memcpy(dst + 8 * idx, &p, 8);
+	}
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \return	Number of encoded bytes.
+* \ingroup	WlzIO
+* \brief	Run length encodes bytes. Each run starts with a control
+* 		byte c, if c < 128 then c + 1 literal bytes follow, else
+* 		the following byte is repeated c - 125 times. The
+* 		destination must have space for at least n + n / 128 + 1
+* 		bytes.
+* \param	dst			Destination for the encoded bytes.
+* \param	src			Source bytes.
+* \param	n			Number of source bytes.
+*/
+static size_t			WlzEncodedValuesRLE(
+				  WlzUByte *dst,
+				  WlzUByte *src,
+				  size_t n)
+{
+  size_t	i = 0,
+  		m = 0;
+
+  while(i < n)
+  {
+    size_t	r = 1;
+
+    while((i + r < n) && (r < 130) && (src[i + r] == src[i]))
+    {
+      ++r;
+    }
+    if(r >= 3)
+    {
+      dst[m++] = (WlzUByte )(r + 125);
+      dst[m++] = src[i];
+      i += r;
+    }
+    else
+    {
+      size_t	j;
+
+      j = i + 1;
+      while((j < n) && (j - i < 128) &&
+            !((j + 2 < n) && (src[j] == src[j + 1]) && (src[j] == src[j + 2])))
+      {
+        ++j;
+      }
+      dst[m++] = (WlzUByte )(j - i - 1);
+      memcpy(dst + m, src + i, j - i);
+      m += j - i;
+      i = j;
+    }
+  }
+  return(m);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Decodes bytes encoded by WlzEncodedValuesRLE().
+* \param	dst			Destination for the decoded bytes.
+* \param	dstSz			Number of bytes to be decoded.
+* \param	src			Encoded bytes.
+* \param	srcSz			Number of encoded bytes.
+*/
+static WlzErrorNum		WlzEncodedValuesUnRLE(
+				  WlzUByte *dst,
+				  size_t dstSz,
+				  WlzUByte *src,
+				  size_t srcSz)
+{
+  size_t	i = 0,
+  		m = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  while((errNum == WLZ_ERR_NONE) && (i < srcSz))
+  {
+    size_t	c;
+
+    c = src[i++];
+    if(c < 128)
+    {
+      if((i + c + 1 > srcSz) || (m + c + 1 > dstSz))
+      {
+        errNum = WLZ_ERR_VALUES_DATA;
+      }
+      else
+      {
+	memcpy(dst + m, src + i, c + 1);
+	i += c + 1;
+	m += c + 1;
+      }
+    }
+    else
+    {
+      if((i >= srcSz) || (m + c - 125 > dstSz))
+      {
+        errNum = WLZ_ERR_VALUES_DATA;
+      }
+      else
+      {
+	memset(dst + m, src[i++], c - 125);
+	m += c - 125;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (m != dstSz))
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Filters and compresses the raw values of a chunk, setting
+* 		the chunk's encoded values. If compression fails to reduce
+* 		the size the filtered values are stored instead.
+* \param	chk			Given chunk with the required codec
+* 					and raw size set.
+* \param	raw			Raw native values of the chunk.
+* \param	sz			Size of the values in bytes.
+*/
+static WlzErrorNum		WlzEncodedValuesEncodeChunk(
+				  WlzEncodedValuesChunk *chk,
+				  WlzUByte *raw,
+				  int sz)
+{
+  WlzUByte	*flt = NULL,
+  		*enc = NULL;
+  size_t	encSz = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((flt = (WlzUByte *)AlcMalloc(chk->rawSz + 1)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    WlzEncodedValuesFilter(flt, raw, chk->rawSz / sz, sz);
+    switch(chk->codec)
+    {
+      case WLZ_VALUE_ENCODING_RLE:
+	if((enc = (WlzUByte *)
+	          AlcMalloc(chk->rawSz + (chk->rawSz / 128) + 1)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  encSz = WlzEncodedValuesRLE(enc, flt, chk->rawSz);
+	}
+        break;
+#if HAVE_ZLIB != 0
+      case WLZ_VALUE_ENCODING_ZLIB:
+	{
+	  uLongf  zSz;
+
+	  zSz = compressBound(chk->rawSz);
+	  if((enc = (WlzUByte *)AlcMalloc(zSz)) == NULL)
+	  {
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else if(compress2(enc, &zSz, flt, chk->rawSz, Z_BEST_SPEED) != Z_OK)
+	  {
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else
+	  {
+	    encSz = zSz;
+	  }
+	}
+	break;
+#endif
+      default:
+	chk->codec = WLZ_VALUE_ENCODING_NONE;
+        break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((enc == NULL) || (encSz >= chk->rawSz))
+    {
+      chk->codec = WLZ_VALUE_ENCODING_NONE;
+      chk->enc = flt;
+      chk->encSz = chk->rawSz;
+      flt = NULL;
+    }
+    else
+    {
+      chk->enc = enc;
+      chk->encSz = encSz;
+      enc = NULL;
+    }
+  }
+  AlcFree(flt);
+  AlcFree(enc);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Decompresses and unfilters the encoded values of a chunk.
+* \param	chk			Given chunk.
+* \param	raw			Destination for the raw native values
+* 					of the chunk.
+* \param	sz			Size of the values in bytes.
+*/
+static WlzErrorNum		WlzEncodedValuesDecodeChunk(
+				  WlzEncodedValuesChunk *chk,
+				  WlzUByte *raw,
+				  int sz)
+{
+  WlzUByte	*flt = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(chk->codec == WLZ_VALUE_ENCODING_NONE)
+  {
+    flt = chk->enc;
+  }
+  else if((flt = (WlzUByte *)AlcMalloc(chk->rawSz + 1)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    switch(chk->codec)
+    {
+      case WLZ_VALUE_ENCODING_RLE:
+        errNum = WlzEncodedValuesUnRLE(flt, chk->rawSz,
+				       chk->enc, chk->encSz);
+        break;
+#if HAVE_ZLIB != 0
+      case WLZ_VALUE_ENCODING_ZLIB:
+	{
+	  uLongf  zSz;
+
+	  zSz = chk->rawSz;
+	  if((uncompress(flt, &zSz, chk->enc, chk->encSz) != Z_OK) ||
+	     (zSz != chk->rawSz))
+	  {
+	    errNum = WLZ_ERR_VALUES_DATA;
+	  }
+	}
+	break;
+#endif
+      default:
+        errNum = WLZ_ERR_UNIMPLEMENTED;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzEncodedValuesUnfilter(raw, flt, chk->rawSz / sz, sz);
+  }
+  if(flt != chk->enc)
+  {
+    AlcFree(flt);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Gathers the values of a chunk's lines using a grey scan
+* 		of the chunk's plane. The object is only read so that
+* 		concurrent gathers from the same plane are safe.
+* \param	pObj			2D object for the chunk's plane.
+* \param	chk			Given chunk.
+* \param	raw			Destination for the raw native values.
+* \param	sz			Size of the values in bytes.
+*/
+static WlzErrorNum		WlzEncodedValuesGather(
+				  WlzObject *pObj,
+				  WlzEncodedValuesChunk *chk,
+				  WlzUByte *raw,
+				  int sz)
+{
+  int		lnL;
+  size_t	off = 0;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  lnL = chk->ln0 + chk->nLn - 1;
+  errNum = WlzInitGreyScan(pObj, &iWSp, &gWSp);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      if(iWSp.linpos > lnL)
+      {
+        break;
+      }
+      else if(iWSp.linpos >= chk->ln0)
+      {
+	size_t	n;
+
+	n = (size_t )(iWSp.colrmn) * sz;
+	if(off + n > chk->rawSz)
+	{
+	  errNum = WLZ_ERR_VALUES_DATA;
+	  break;
+	}
+	memcpy(raw + off, gWSp.u_grintptr.ubp, n);
+	off += n;
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (off != chk->rawSz))
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Scatters the raw values of a chunk into the lines of a
+* 		value table made by WlzEncodedValuesRead(). This
+* 		accesses the value table directly so that chunks within
+* 		the same plane may be scattered concurrently.
+* \param	iDom			Domain of the chunk's plane.
+* \param	val			Ragged rectangle value table, or
+* 					rectangular value table if the domain
+* 					is rectangular.
+* \param	chk			Given chunk.
+* \param	raw			Raw native values of the chunk.
+* \param	sz			Size of the values in bytes.
+*/
+static void			WlzEncodedValuesScatter(
+				  WlzIntervalDomain *iDom,
+				  WlzValues val,
+				  WlzEncodedValuesChunk *chk,
+				  WlzUByte *raw,
+				  int sz)
+{
+  if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+  {
+    WlzRectValues *rVal;
+
+    rVal = val.r;
+    memcpy(rVal->values.ubp +
+           (size_t )(chk->ln0 - rVal->line1) * rVal->width * sz,
+	   raw, chk->rawSz);
+  }
+  else
+  {
+    int		ln;
+    size_t	off = 0;
+    WlzRagRValues *vVal;
+
+    vVal = val.v;
+    for(ln = chk->ln0; ln < chk->ln0 + chk->nLn; ++ln)
+    {
+      int	idx;
+      WlzIntervalLine *itvLn;
+      WlzValueLine *vLn;
+
+      itvLn = iDom->intvlines + ln - iDom->line1;
+      vLn = vVal->vtblines + ln - vVal->line1;
+      for(idx = 0; idx < itvLn->nintvs; ++idx)
+      {
+	size_t	n;
+	WlzInterval *itv;
+
+	itv = itvLn->intvs + idx;
+	n = (size_t )(itv->iright - itv->ileft + 1) * sz;
+	memcpy(vLn->values.ubp +
+	       (size_t )(iDom->kol1 + itv->ileft -
+			 vVal->kol1 - vLn->vkol1) * sz,
+	       raw + off, n);
+	off += n;
+      }
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Converts a single native value to little endian bytes.
+* \param	dst			Destination for the bytes.
+* \param	src			Native value.
+* \param	sz			Size of the value in bytes.
+*/
+static void			WlzEncodedValuesToLE(
+				  WlzUByte *dst,
+				  WlzUByte *src,
+				  int sz)
+{
+  int		b;
+  WlzULong	v = 0;
+
+  switch(sz)
+  {
+    case 1:
+      v = *src;
+      break;
+    case 2:
+      {
+        unsigned short s;
+
+	memcpy(&s, src, 2);
+	v = s;
+      }
+      break;
+    case 4:
+      {
+        WlzUInt	u;
+
+	memcpy(&u, src, 4);
+	v = u;
+      }
+      break;
+    case 8:
+      memcpy(&v, src, 8);
+      break;
+    default:
+      break;
+  }
+  for(b = 0; b < sz; ++b)
+  {
+    dst[b] = (WlzUByte )((v >> (8 * b)) & 0xff);
+  }
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Converts little endian bytes to a single native value.
+* \param	dst			Destination for the native value.
+* \param	src			Little endian bytes.
+* \param	sz			Size of the value in bytes.
+*/
+static void			WlzEncodedValuesFromLE(
+				  WlzUByte *dst,
+				  WlzUByte *src,
+				  int sz)
+{
+  int		b;
+  WlzULong	v = 0;
+
+  for(b = 0; b < sz; ++b)
+  {
+    v |= (WlzULong )(src[b]) << (8 * b);
+  }
+  switch(sz)
+  {
+    case 1:
+      *dst = (WlzUByte )v;
+      break;
+    case 2:
+      {
+        unsigned short s;
+
+	s = (unsigned short )v;
+	memcpy(dst, &s, 2);
+      }
+      break;
+    case 4:
+      {
+        WlzUInt	u;
+
+	u = (WlzUInt )v;
+	memcpy(dst, &u, 4);
+      }
+      break;
+    case 8:
+      memcpy(dst, &v, 8);
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Sets four bytes to a little endian word.
+* \param	b			Destination bytes.
+* \param	w			Given word.
+*/
+static void			WlzEncodedValuesWordToLE(
+				  WlzUByte *b,
+				  WlzUInt w)
+{
+  b[0] = (WlzUByte )(w & 0xff);
+  b[1] = (WlzUByte )((w >> 8) & 0xff);
+  b[2] = (WlzUByte )((w >> 16) & 0xff);
+  b[3] = (WlzUByte )((w >> 24) & 0xff);
+}
+
+/*!
+* \return	Word.
+* \ingroup	WlzIO
+* \brief	Gets a word from four little endian bytes.
+* \param	b			Given bytes.
+*/
+static WlzUInt			WlzEncodedValuesWordFromLE(
+				  WlzUByte *b)
+{
+  return((WlzUInt )(b[0]) | ((WlzUInt )(b[1]) << 8) |
+         ((WlzUInt )(b[2]) << 16) | ((WlzUInt )(b[3]) << 24));
+}
+
+/*!
+* \return	Non-zero if the word was written.
+* \ingroup	WlzIO
+* \brief	Writes a four byte little endian word.
+* \param	fP			Given file.
+* \param	w			Word to write.
+*/
+static int			WlzEncodedValuesPutWord(
+				  FILE *fP,
+				  WlzUInt w)
+{
+  WlzUByte	b[4];
+
+  WlzEncodedValuesWordToLE(b, w);
+  return(fwrite(b, sizeof(WlzUByte), 4, fP) == 4);
+}
+
+/*!
+* \return	Word read.
+* \ingroup	WlzIO
+* \brief	Reads a four byte little endian word.
+* \param	fP			Given file.
+* \param	dstErr			Destination error pointer, set to
+* 					WLZ_ERR_READ_INCOMPLETE on failure
+* 					and otherwise unchanged.
+*/
+static WlzUInt			WlzEncodedValuesGetWord(
+				  FILE *fP,
+				  WlzErrorNum *dstErr)
+{
+  WlzUInt	w = 0;
+  WlzUByte	b[4];
+
+  if(fread(b, sizeof(WlzUByte), 4, fP) != 4)
+  {
+    *dstErr = WLZ_ERR_READ_INCOMPLETE;
+  }
+  else
+  {
+    w = WlzEncodedValuesWordFromLE(b);
+  }
+  return(w);
+}
@@ -204,6 +204,11 @@ static void		WlzGMElmMarkFree(
 static WlzGMDiskT 	*WlzGMModelNewDT(
 			  WlzGMModel *model,
 			  WlzErrorNum *dstErr);
+static WlzErrorNum	WlzGMModelConstructSimplex3Priv(
+			  WlzGMModel *model,
+			  WlzDVertex3 *pos,
+			  WlzDVertex3 *nrm,
+			  WlzGMVertex **vtx);
 
 /* Resource callback function list manipulation. */
 
@@ -9579,6 +9584,72 @@ WlzErrorNum	WlzGMModelConstructSimplex3D(WlzGMModel *model,
 WlzErrorNum	WlzGMModelConstructSimplex3N(WlzGMModel *model,
 				       	     WlzDVertex3 *pos,
 					     WlzDVertex3 *nrm)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzGMModelConstructSimplex3Priv(model, pos, nrm, NULL);
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup      WlzGeoModel
+* \brief	Constructs a 3D simplex (triangle) defined by three
+*               double precision verticies for which the caller has
+*		already found any matching verticies in the model,
+*		so that the model's vertex hash table is not searched.
+*		On return the vertex array holds the verticies of the
+*		simplex, either the given matching verticies or the
+*		new verticies created at the given positions. If the
+*		simplex is degenerate nothing is constructed and the
+*		vertex array is not changed.
+*		This is useful when the simplices are known to share
+*		verticies, eg when the verticies of a list of
+*		simplices have been indexed.
+*		If a new face is created then the child loopT of that
+*		face will have edgeT's that use the given vertices in
+*		their given order.
+* \param	model			The model to add the segment to.
+* \param	pos			Pointer to triangle verticies.
+* \param	vtx			Array of three verticies, each of
+*					which must be either the model
+*					vertex which matches the
+*					corresponding position or NULL
+*					if there is no such vertex.
+*/
+WlzErrorNum	WlzGMModelConstructSimplex3V(WlzGMModel *model,
+				       	     WlzDVertex3 *pos,
+					     WlzGMVertex **vtx)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzGMModelConstructSimplex3Priv(model, pos, NULL, vtx);
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup      WlzGeoModel
+* \brief	Constructs a 3D simplex (triangle) defined by three
+*               double precision verticies with optional normals,
+*		any of which may already exist within the model.
+*		If a vertex array is given then the matching verticies
+*		are taken from it rather than found using the model's
+*		vertex hash table, and it is set to the verticies of
+*		the simplex on return.
+* \param	model			The model to add the segment to.
+* \param	pos			Pointer to triangle verticies.
+* \param	nrm			Pointer to the normal values in
+*					the same order as the positions,
+*					may be NULL.
+* \param	vtx			Array of three matching verticies
+*					(NULL where there is no match),
+*					may be NULL.
+*/
+static WlzErrorNum WlzGMModelConstructSimplex3Priv(WlzGMModel *model,
+						   WlzDVertex3 *pos,
+						   WlzDVertex3 *nrm,
+						   WlzGMVertex **vtx)
 {
   int		idx0,
   		idx1,
@@ -9639,8 +9710,10 @@ WlzErrorNum	WlzGMModelConstructSimplex3N(WlzGMModel *model,
     idx0 = 0;
     while((idx0 < 3) && (errNum == WLZ_ERR_NONE))
     {
-      if((matchV[idx0] = WlzGMModelMatchVertexG3D(model,
-	      *(pos + idx0))) == NULL)
+      nV[idx0] = NULL;
+      matchV[idx0] = (vtx)? vtx[idx0]:
+                            WlzGMModelMatchVertexG3D(model, *(pos + idx0));
+      if(matchV[idx0] == NULL)
       {
 	if((nV[idx0] = WlzGMModelNewV(model, &errNum)) != NULL)
 	{
@@ -9793,6 +9866,17 @@ WlzErrorNum	WlzGMModelConstructSimplex3N(WlzGMModel *model,
       }
       /* Make sure that the order of the vertices are as given for the child
        * loopT of the new face. */
+      if(vtx && (errNum == WLZ_ERR_NONE))
+      {
+	for(idx0 = 0; idx0 < 3; ++idx0)
+	{
+	  if(matchV[idx0] == NULL)
+	  {
+	    matchV[idx0] = nV[idx0];
+	  }
+	  vtx[idx0] = matchV[idx0];
+	}
+      }
       if(nF)
       {
 	for(idx0 = 0; idx0 < 3; ++idx0)
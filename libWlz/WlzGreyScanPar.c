@@ -0,0 +1,1648 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzGreyScanPar_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzGreyScanPar.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2012],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Parallel scans of an object's grey values which compute
+* 		a histogram, simple statistics and a thresholded domain,
+* 		either separately or together in a single pass.
+* \ingroup	WlzFeatures
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <Wlz.h>
+
+/*!
+* \struct	_WlzGreyScanCtl
+* \ingroup	WlzFeatures
+* \brief	Parameters of a parallel grey value scan. These are set
+* 		before the scan and are only read while scanning.
+*/
+typedef struct _WlzGreyScanCtl
+{
+  int		doStats;		/*!< Non-zero to compute statistics. */
+  int		doHist;			/*!< Non-zero to compute a
+  					     histogram. */
+  int		doThr;			/*!< Non-zero to compute a thresholded
+  					     domain. */
+  int		nBins;			/*!< Number of histogram bins. */
+  int		unitBin;		/*!< Non-zero if the histogram bin
+  					     size is one, in which case the
+					     bins of integral values are
+					     indexed using originI. */
+  int		originI;		/*!< Integral histogram origin. */
+  double	origin;			/*!< Histogram origin. */
+  double	binSize;		/*!< Histogram bin size. */
+  WlzThresholdType thrType;		/*!< Threshold type. */
+  int		thrLoI;			/*!< Inclusive range of integral
+  					     (and RGBA squared modulus) values
+					     which are above threshold. */
+  int		thrHiI;			/*!< See thrLoI. */
+  int		thrRGBA;		/*!< Threshold for the squared modulus
+  					     of RGBA values. */
+  float		thrF;			/*!< Threshold for float values. */
+  double	thrD;			/*!< Threshold for double values. */
+} WlzGreyScanCtl;
+
+/*!
+* \struct	_WlzGreyScanUnit
+* \ingroup	WlzFeatures
+* \brief	A unit of work for a parallel grey value scan, which is
+* 		either a band of lines of a 2D object or a plane of a
+* 		3D object, together with the partial statistics and
+* 		thresholded intervals found for it. Each unit is only
+* 		written by the thread which scans it.
+*/
+typedef struct _WlzGreyScanUnit
+{
+  WlzObject	*obj;			/*!< 2D object to scan, may be NULL. */
+  int		pln;			/*!< Plane for tiled values. */
+  int		ln0;			/*!< First line of the unit. */
+  int		nLn;			/*!< Number of lines in the unit. */
+  WlzGreyType	gType;			/*!< Grey type found while scanning. */
+  long		area;			/*!< Number of values scanned. */
+  double	min;			/*!< Minimum value. */
+  double	max;			/*!< Maximum value. */
+  double	sum;			/*!< Sum of values. */
+  double	sumSq;			/*!< Sum of squared values. */
+  int		nItv;			/*!< Number of thresholded intervals. */
+  int		maxItv;			/*!< Space allocated for intervals. */
+  int		*lnItv;			/*!< Number of thresholded intervals
+  					     on each line of the unit. */
+  WlzInterval	*itv;			/*!< Thresholded intervals with
+  					     absolute column coordinates. */
+  WlzIBox2	thrBox;			/*!< Bounding box of the thresholded
+  					     intervals. */
+  WlzDomain	thrDom;			/*!< Thresholded domain of a plane. */
+  WlzErrorNum	errNum;			/*!< Error found scanning the unit. */
+} WlzGreyScanUnit;
+
+static void			WlzGreyScanItvStats(
+				  WlzGreyScanUnit *unt,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  int n);
+static void			WlzGreyScanItvHist(
+				  const WlzGreyScanCtl *ctl,
+				  int *bins,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  int n);
+static void			WlzGreyScanItvMask(
+				  const WlzGreyScanCtl *ctl,
+				  WlzUByte *msk,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  int n);
+static WlzErrorNum		WlzGreyScanItvThr(
+				  WlzGreyScanUnit *unt,
+				  const WlzUByte *msk,
+				  int ln,
+				  int kl0,
+				  int n);
+static void			WlzGreyScanUnit2D(
+				  const WlzGreyScanCtl *ctl,
+				  WlzGreyScanUnit *unt,
+				  int *bins);
+static void			WlzGreyScanUnitFree(
+				  WlzGreyScanUnit *unt);
+static WlzIntervalDomain	*WlzGreyScanThrDom(
+				  WlzGreyScanUnit *unt,
+				  int nUnt,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzGreyScanThrObj(
+				  WlzObject *obj,
+				  WlzGreyScanUnit *unt,
+				  int nUnt,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzGreyScanCtlThr(
+				  WlzGreyScanCtl *ctl,
+				  WlzPixelV threshV,
+				  WlzThresholdType highlow);
+static WlzErrorNum		WlzGreyScanObj(
+				  WlzObject *obj,
+				  const WlzGreyScanCtl *ctl,
+				  WlzGreyScanStats *stats,
+				  int *bins,
+				  WlzObject **dstThr);
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFeatures
+* \brief	Computes any of a histogram, simple statistics and a
+* 		thresholded object from the grey values of the given
+* 		2D or 3D domain object in a single scan of its intervals.
+* 		The scan is partitioned into bands of lines (2D) or
+* 		planes (3D) which are scanned concurrently. Each band or
+* 		plane has its own statistics and thresholded intervals
+* 		and each thread its own histogram bins, so that no locks
+* 		are needed while scanning, with the partial results
+* 		being merged in band or plane order afterwards.
+*
+* 		The histogram, statistics and thresholded object are the
+* 		same as those computed by WlzHistogramObj(), WlzGreyStats()
+* 		and WlzThreshold() except that:
+* 		<ul>
+* 		<li> RGBA values are represented by their modulus (as in
+* 		     WlzGreyStats()) for the histogram too.</li>
+* 		<li> Sums of floating point values may differ in their
+* 		     least significant bits because of the order of
+* 		     summation.</li>
+* 		</ul>
+* 		If the number of histogram bins is zero the histogram
+* 		covers the range of the values with a bin size of one.
+* 		For other than WlzUByte values this range is found by a
+* 		preliminary scan.
+* \param	obj			Given 2D or 3D domain object with
+* 					grey values.
+* \param	nBins			Number of histogram bins, may be
+* 					zero (see above).
+* \param	binOrigin		Lowest grey value in the first
+* 					histogram bin.
+* \param	binSize			Grey value range of each histogram
+* 					bin.
+* \param	threshV			Threshold value.
+* \param	highlow			Threshold type, see WlzThreshold().
+* \param	dstStats		Destination pointer for the
+* 					statistics, may be NULL if not
+* 					required.
+* \param	dstHist			Destination pointer for a new
+* 					histogram object with an int
+* 					histogram domain, may be NULL if
+* 					not required.
+* \param	dstThr			Destination pointer for the new
+* 					thresholded object, may be NULL
+* 					if not required.
+*/
+WlzErrorNum	WlzGreyScanPar(WlzObject *obj,
+			       int nBins, double binOrigin, double binSize,
+			       WlzPixelV threshV, WlzThresholdType highlow,
+			       WlzGreyScanStats *dstStats,
+			       WlzObject **dstHist, WlzObject **dstThr)
+{
+  int		idB,
+  		last;
+  int		*bins = NULL;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzObject	*histObj = NULL,
+  		*thrObj = NULL;
+  WlzGreyScanCtl ctl;
+  WlzGreyScanStats stats;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )memset(&ctl, 0, sizeof(WlzGreyScanCtl));
+  (void )memset(&stats, 0, sizeof(WlzGreyScanStats));
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if((obj->type != WLZ_2D_DOMAINOBJ) && (obj->type != WLZ_3D_DOMAINOBJ))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(obj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if((obj->type == WLZ_3D_DOMAINOBJ) &&
+          (obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN))
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((dstHist != NULL) &&
+          ((nBins < 0) || ((nBins > 0) && (binSize < DBL_EPSILON))))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    gType = WlzGreyTypeFromObj(obj, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && (dstThr != NULL))
+  {
+    ctl.doThr = 1;
+    errNum = WlzGreyScanCtlThr(&ctl, threshV, highlow);
+  }
+  if((errNum == WLZ_ERR_NONE) && (dstHist != NULL))
+  {
+    ctl.doHist = 1;
+    if(nBins > 0)
+    {
+      ctl.nBins = nBins;
+      ctl.origin = binOrigin;
+      ctl.binSize = binSize;
+    }
+    else if(gType == WLZ_GREY_UBYTE)
+    {
+      /* Histogram all possible values and trim the bins afterwards. */
+      ctl.nBins = 256;
+      ctl.origin = 0.0;
+      ctl.binSize = 1.0;
+    }
+    else
+    {
+      WlzGreyScanCtl rngCtl;
+
+      (void )memset(&rngCtl, 0, sizeof(WlzGreyScanCtl));
+      rngCtl.doStats = 1;
+      errNum = WlzGreyScanObj(obj, &rngCtl, &stats, NULL, NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        ctl.nBins = (stats.area > 0)?
+		    (int )ceil(stats.max - stats.min + 1.0): 0;
+	ctl.origin = stats.min;
+	ctl.binSize = 1.0;
+      }
+    }
+    ctl.originI = (int )floor(ctl.origin + DBL_EPSILON);
+    ctl.unitBin = (ctl.binSize >= (1.0 - DBL_EPSILON)) &&
+                  (ctl.binSize <= (1.0 + DBL_EPSILON));
+    if((errNum == WLZ_ERR_NONE) && (ctl.nBins > 0) &&
+       ((bins = (int *)AlcCalloc(ctl.nBins, sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    ctl.doStats = dstStats != NULL;
+    if(ctl.doStats || ctl.doThr || (ctl.nBins > 0))
+    {
+      errNum = WlzGreyScanObj(obj, &ctl, &stats, bins,
+                              (ctl.doThr)? &thrObj: NULL);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && ctl.doHist)
+  {
+    idB = 0;
+    last = ctl.nBins - 1;
+    if((nBins == 0) && (gType == WLZ_GREY_UBYTE))
+    {
+      while((idB <= last) && (bins[idB] == 0))
+      {
+        ++idB;
+      }
+      while((last >= idB) && (bins[last] == 0))
+      {
+        --last;
+      }
+    }
+    if((histObj = WlzMakeHistogram(WLZ_HISTOGRAMDOMAIN_INT,
+    				   last - idB + 1, &errNum)) != NULL)
+    {
+      WlzHistogramDomain *histDom;
+
+      histDom = histObj->domain.hist;
+      histDom->nBins = last - idB + 1;
+      histDom->origin = (idB <= last)? ctl.origin + idB: ctl.origin;
+      histDom->binSize = ctl.binSize;
+      if(histDom->nBins > 0)
+      {
+        WlzValueCopyIntToInt(histDom->binValues.inp, bins + idB,
+			     histDom->nBins);
+      }
+    }
+  }
+  AlcFree(bins);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(dstStats)
+    {
+      stats.gType = gType;
+      if(stats.area > 0)
+      {
+        stats.mean = stats.sum / stats.area;
+      }
+      else
+      {
+        stats.mean = -1.0;
+	stats.min = 0.0;
+	stats.max = 0.0;
+      }
+      stats.var = (stats.area > 1)?
+                  (stats.sumSq - (stats.sum * stats.sum / stats.area)) /
+		  (stats.area - 1):
+		  0.0;
+      *dstStats = stats;
+    }
+    if(dstHist)
+    {
+      *dstHist = histObj;
+    }
+    if(dstThr)
+    {
+      *dstThr = thrObj;
+    }
+  }
+  else
+  {
+    (void )WlzFreeObj(histObj);
+    (void )WlzFreeObj(thrObj);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New histogram object or NULL on error.
+* \ingroup	WlzHistogram
+* \brief	A parallel equivalent of WlzHistogramObj() which scans
+* 		bands of lines (2D) or planes (3D) concurrently, each
+* 		thread accumulating its own histogram bins, using
+* 		WlzGreyScanPar(). If the requested number of bins is
+* 		zero then the histogram covers the range of grey values
+* 		with a bin size of one.
+* \param	srcObj			Given source object.
+* \param	nBins			Required number of histogram bins.
+* \param	binOrigin		Lowest grey value in first histogram
+* 					bin.
+* \param	binSize			Grey value range for each
+*                                       histogram bin.
+* \param	dstErr			Destination error pointer, may be
+* 					NULL.
+*/
+WlzObject	*WlzHistogramObjPar(WlzObject *srcObj, int nBins,
+				    double binOrigin, double binSize,
+				    WlzErrorNum *dstErr)
+{
+  WlzGreyType	gType;
+  WlzPixelV	thrV;
+  WlzObject	*histObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  thrV.type = WLZ_GREY_INT;
+  thrV.v.inv = 0;
+  if(srcObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else
+  {
+    switch(srcObj->type)
+    {
+      case WLZ_EMPTY_OBJ:
+	histObj = WlzMakeEmpty(&errNum);
+        break;
+      case WLZ_TRANS_OBJ:
+	if(srcObj->values.core == NULL)
+	{
+	  errNum = WLZ_ERR_VALUES_NULL;
+	}
+	else
+	{
+	  histObj = WlzHistogramObjPar(srcObj->values.obj, nBins,
+				       binOrigin, binSize, &errNum);
+	}
+	break;
+      case WLZ_2D_DOMAINOBJ: /* FALLTHROUGH */
+      case WLZ_3D_DOMAINOBJ:
+	if(srcObj->values.core != NULL)
+	{
+	  /* As WlzHistogramObj() RGBA values are not histogrammed. */
+	  gType = WlzGreyTypeFromObj(srcObj, &errNum);
+	  if((errNum == WLZ_ERR_NONE) && (gType == WLZ_GREY_RGBA))
+	  {
+	    errNum = WLZ_ERR_GREY_TYPE;
+	  }
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzGreyScanPar(srcObj, nBins, binOrigin, binSize,
+	                          thrV, WLZ_THRESH_HIGH,
+				  NULL, &histObj, NULL);
+	}
+	break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(histObj);
+}
+
+/*!
+* \return	Object area or -1 on error.
+* \ingroup	WlzFeatures
+* \brief	A parallel equivalent of WlzGreyStats() which scans
+* 		bands of lines (2D) or planes (3D) concurrently using
+* 		WlzGreyScanPar(). Pointers provided for results may be
+* 		NULL without causing an error.
+* \param	srcObj			Object from which to calculate
+*                                       the statistics.
+* \param	dstGType		Pointer for grey type.
+* \param	dstMin			Pointer for minimum value.
+* \param	dstMax			Pointer for maximum value.
+* \param	dstSum			Pointer for sum of values.
+* \param	dstSumSq		Pointer for sum of squares of
+*                                       values.
+* \param	dstMean			Mean value.
+* \param	dstStdDev		Standard deviation of values.
+* \param	dstErr			Destination pointer for error
+*                                       number, may be NULL if not
+*                                       required.
+*/
+int		WlzGreyStatsPar(WlzObject *srcObj,
+			        WlzGreyType *dstGType,
+			        double *dstMin, double *dstMax,
+			        double *dstSum, double *dstSumSq,
+			        double *dstMean, double *dstStdDev,
+			        WlzErrorNum *dstErr)
+{
+  int		area = -1;
+  WlzPixelV	thrV;
+  WlzGreyScanStats stats;
+  WlzErrorNum	errNum;
+
+  thrV.type = WLZ_GREY_INT;
+  thrV.v.inv = 0;
+  errNum = WlzGreyScanPar(srcObj, 0, 0.0, 1.0, thrV, WLZ_THRESH_HIGH,
+                          &stats, NULL, NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    area = (int )(stats.area);
+    if(dstGType)
+    {
+      *dstGType = stats.gType;
+    }
+    if(dstMin)
+    {
+      *dstMin = stats.min;
+    }
+    if(dstMax)
+    {
+      *dstMax = stats.max;
+    }
+    if(dstSum)
+    {
+      *dstSum = stats.sum;
+    }
+    if(dstSumSq)
+    {
+      *dstSumSq = stats.sumSq;
+    }
+    if(dstMean)
+    {
+      *dstMean = stats.mean;
+    }
+    if(dstStdDev)
+    {
+      *dstStdDev = (stats.var > 0.0)? sqrt(stats.var): 0.0;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(area);
+}
+
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzThreshold
+* \brief	A parallel equivalent of WlzThreshold() which finds the
+* 		thresholded intervals of bands of lines (2D) or planes
+* 		(3D) concurrently in a single scan using WlzGreyScanPar().
+* \param	obj			Object to be thresholded.
+* \param	threshV			Threshold pixel value.
+* \param	highlow			Mode parameter with possible values:
+*					<ul>
+*					<li> WLZ_THRESH_LOW - thresholded
+*					object is of values < given value.
+*					</li>
+*					<li> WLZ_THRESH_HIGH - thresholded
+*					object is of values >= given value.
+*					</li>
+*					<li> WLZ_THRESH_EQUAL - thresholded
+*					object is of values == given value.
+*					</li>
+*					</ul>
+* \param	dstErr			Destination pointer for error number,
+*					may be NULL.
+*/
+WlzObject	*WlzThresholdPar(WlzObject *obj, WlzPixelV threshV,
+				 WlzThresholdType highlow,
+				 WlzErrorNum *dstErr)
+{
+  WlzObject	*nObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else
+  {
+    switch(obj->type)
+    {
+      case WLZ_2D_DOMAINOBJ: /* FALLTHROUGH */
+      case WLZ_3D_DOMAINOBJ:
+	errNum = WlzGreyScanPar(obj, 0, 0.0, 1.0, threshV, highlow,
+	                        NULL, NULL, &nObj);
+	break;
+      case WLZ_TRANS_OBJ:
+	if((nObj = WlzThresholdPar(obj->values.obj, threshV, highlow,
+				   &errNum)) != NULL)
+	{
+          WlzValues	values;
+
+	  values.obj = nObj;
+	  nObj = WlzMakeMain(obj->type, obj->domain, values, NULL, obj,
+	                     &errNum);
+	}
+	break;
+      case WLZ_EMPTY_OBJ:
+	nObj = WlzMakeEmpty(&errNum);
+	break;
+      default:
+	errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFeatures
+* \brief	Sets the threshold parameters of the scan control, with
+* 		the threshold value converted to each grey type in the
+* 		same way as by WlzThreshold(). Integral values (and the
+* 		squared modulus of RGBA values) are above threshold if
+* 		within an inclusive range.
+* \param	ctl			Scan control.
+* \param	threshV			Threshold value.
+* \param	highlow			Threshold type.
+*/
+static WlzErrorNum WlzGreyScanCtlThr(WlzGreyScanCtl *ctl,
+				     WlzPixelV threshV,
+				     WlzThresholdType highlow)
+{
+  int		thrI = 0;
+  double	thrR;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(threshV.type)
+  {
+    case WLZ_GREY_INT:
+      thrI = threshV.v.inv;
+      ctl->thrF = (float )thrI;
+      ctl->thrD = thrI;
+      break;
+    case WLZ_GREY_SHORT:
+      thrI = threshV.v.shv;
+      ctl->thrF = (float )thrI;
+      ctl->thrD = thrI;
+      break;
+    case WLZ_GREY_UBYTE:
+      thrI = threshV.v.ubv;
+      ctl->thrF = (float )thrI;
+      ctl->thrD = thrI;
+      break;
+    case WLZ_GREY_FLOAT:
+      ctl->thrF = threshV.v.flv;
+      ctl->thrD = ctl->thrF;
+      thrI = (int )(ctl->thrF);
+      break;
+    case WLZ_GREY_DOUBLE:
+      ctl->thrD = threshV.v.dbv;
+      ctl->thrF = (float )(ctl->thrD);
+      thrI = (int )(ctl->thrD);
+      break;
+    case WLZ_GREY_RGBA:
+      ctl->thrD = WLZ_RGBA_MODULUS(threshV.v.rgbv);
+      ctl->thrF = (float )(ctl->thrD);
+      thrI = (int )(ctl->thrD);
+      break;
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    ctl->thrType = highlow;
+    switch(highlow)
+    {
+      case WLZ_THRESH_LOW:
+	ctl->thrLoI = INT_MIN;
+	ctl->thrHiI = thrI - 1;
+	if(thrI == INT_MIN)
+	{
+	  /* No integral value is below threshold. */
+	  ctl->thrLoI = 1;
+	  ctl->thrHiI = 0;
+	}
+	break;
+      case WLZ_THRESH_HIGH:
+	ctl->thrLoI = thrI;
+	ctl->thrHiI = INT_MAX;
+	break;
+      case WLZ_THRESH_EQUAL:
+	ctl->thrLoI = thrI;
+	ctl->thrHiI = thrI;
+	break;
+      default:
+	errNum = WLZ_ERR_PARAM_DATA;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* RGBA values are compared using their squared modulus with the
+     * square of the integral threshold value. */
+    thrR = (double )thrI * (double )thrI;
+    ctl->thrRGBA = (thrR < INT_MAX)? (int )thrR: INT_MAX;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFeatures
+* \brief	Scans the given 2D or 3D domain object, partitioned into
+* 		units which are bands of lines (2D) or planes (3D), with
+* 		the units scanned concurrently. The partial results of
+* 		the units are merged after the scan in unit order.
+* \param	obj			Given 2D or 3D domain object which
+* 					has been checked to have a domain
+* 					and values.
+* \param	ctl			Scan control.
+* \param	stats			Statistics to be set if required,
+* 					only the area, min, max, sum and
+* 					sumSq are set.
+* \param	bins			Histogram bins to be set if required.
+* \param	dstThr			Destination pointer for the
+* 					thresholded object if required.
+*/
+static WlzErrorNum WlzGreyScanObj(WlzObject *obj,
+				  const WlzGreyScanCtl *ctl,
+				  WlzGreyScanStats *stats,
+				  int *bins,
+				  WlzObject **dstThr)
+{
+  int		idT,
+  		idU,
+  		nThr = 1,
+		nUnt = 0,
+		tiled = 0;
+  int		*thrBins = NULL;
+  WlzGreyScanUnit *unt = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp parallel
+  {
+#pragma omp master
+    {
+      nThr = omp_get_num_threads();
+    }
+  }
+#endif
+  /* Set up the units of work before scanning since making objects is
+   * not thread safe. */
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    int		nLn;
+
+    nLn = obj->domain.i->lastln - obj->domain.i->line1 + 1;
+    /* Use a few bands per thread so that the load is balanced even though
+     * the number of intervals per line varies. */
+    nUnt = ALG_MAX(1, ALG_MIN(nLn, 4 * nThr));
+  }
+  else
+  {
+    nUnt = obj->domain.p->lastpl - obj->domain.p->plane1 + 1;
+    tiled = WlzGreyTableIsTiled(obj->values.core->type);
+    if((tiled == 0) && (obj->values.core->type != WLZ_VOXELVALUETABLE_GREY))
+    {
+      errNum = WLZ_ERR_VALUES_TYPE;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     ((unt = (WlzGreyScanUnit *)
+             AlcCalloc(nUnt, sizeof(WlzGreyScanUnit))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if((errNum == WLZ_ERR_NONE) && (ctl->nBins > 0) &&
+     ((thrBins = (int *)AlcCalloc(nThr * ctl->nBins, sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(obj->type == WLZ_2D_DOMAINOBJ)
+    {
+      WlzIntervalDomain *iDom;
+
+      iDom = obj->domain.i;
+      if(nUnt == 1)
+      {
+        unt[0].obj = WlzAssignObject(obj, NULL);
+	unt[0].ln0 = iDom->line1;
+	unt[0].nLn = iDom->lastln - iDom->line1 + 1;
+      }
+      else
+      {
+	int	  nLn;
+	WlzIBox2  bndBox;
+
+	nLn = iDom->lastln - iDom->line1 + 1;
+	bndBox.xMin = iDom->kol1;
+	bndBox.xMax = iDom->lastkl;
+	for(idU = 0; (errNum == WLZ_ERR_NONE) && (idU < nUnt); ++idU)
+	{
+	  bndBox.yMin = iDom->line1 + (int )(((long )nLn * idU) / nUnt);
+	  bndBox.yMax = iDom->line1 +
+	                (int )(((long )nLn * (idU + 1)) / nUnt) - 1;
+	  unt[idU].ln0 = bndBox.yMin;
+	  unt[idU].nLn = bndBox.yMax - bndBox.yMin + 1;
+	  unt[idU].obj = WlzAssignObject(
+	                 WlzClipObjToBox2D(obj, bndBox, &errNum), NULL);
+	}
+      }
+    }
+    else
+    {
+      WlzPlaneDomain *pDom;
+
+      pDom = obj->domain.p;
+      for(idU = 0; (errNum == WLZ_ERR_NONE) && (idU < nUnt); ++idU)
+      {
+	WlzDomain dom;
+	WlzValues val;
+
+        dom = pDom->domains[idU];
+	val = (tiled)? obj->values: obj->values.vox->values[idU];
+	unt[idU].pln = pDom->plane1 + idU;
+	if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN) &&
+	   (val.core != NULL) && (val.core->type != WLZ_EMPTY_VALUES))
+	{
+	  unt[idU].ln0 = dom.i->line1;
+	  unt[idU].nLn = dom.i->lastln - dom.i->line1 + 1;
+	  unt[idU].obj = WlzAssignObject(
+	                 WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL,
+			             &errNum), NULL);
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
+#endif
+    for(idU = 0; idU < nUnt; ++idU)
+    {
+      int	thrId = 0;
+      WlzGreyScanUnit *u;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      u = unt + idU;
+      if((u->obj != NULL) && (u->obj->type == WLZ_2D_DOMAINOBJ))
+      {
+	WlzGreyScanUnit2D(ctl, u,
+	                  (thrBins)? thrBins + thrId * ctl->nBins: NULL);
+	/* The domain of each plane is made as soon as it's been scanned
+	 * to avoid holding all the intervals of a 3D object. */
+	if((u->errNum == WLZ_ERR_NONE) && ctl->doThr &&
+	   (obj->type == WLZ_3D_DOMAINOBJ))
+	{
+	  WlzDomain dom;
+
+	  dom.i = WlzGreyScanThrDom(u, 1, &(u->errNum));
+	  if(dom.i != NULL)
+	  {
+	    u->thrDom = WlzAssignDomain(dom, NULL);
+	  }
+	  AlcFree(u->itv);
+	  u->itv = NULL;
+	}
+      }
+    }
+    /* Merge the partial results. */
+    for(idU = 0; idU < nUnt; ++idU)
+    {
+      if(unt[idU].errNum != WLZ_ERR_NONE)
+      {
+        errNum = unt[idU].errNum;
+	break;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && ctl->doStats)
+  {
+    stats->area = 0;
+    stats->sum = stats->sumSq = 0.0;
+    stats->min = stats->max = 0.0;
+    for(idU = 0; idU < nUnt; ++idU)
+    {
+      WlzGreyScanUnit *u;
+
+      u = unt + idU;
+      if(u->area > 0)
+      {
+	if(stats->area == 0)
+	{
+	  stats->min = u->min;
+	  stats->max = u->max;
+	}
+	else
+	{
+	  stats->min = ALG_MIN(stats->min, u->min);
+	  stats->max = ALG_MAX(stats->max, u->max);
+	}
+	stats->area += u->area;
+	stats->sum += u->sum;
+	stats->sumSq += u->sumSq;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (thrBins != NULL))
+  {
+    WlzValueCopyIntToInt(bins, thrBins, ctl->nBins);
+    for(idT = 1; idT < nThr; ++idT)
+    {
+      int	idB;
+      int	*tB;
+
+      tB = thrBins + idT * ctl->nBins;
+      for(idB = 0; idB < ctl->nBins; ++idB)
+      {
+        bins[idB] += tB[idB];
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && ctl->doThr)
+  {
+    *dstThr = WlzGreyScanThrObj(obj, unt, nUnt, &errNum);
+  }
+  if(unt)
+  {
+    for(idU = 0; idU < nUnt; ++idU)
+    {
+      WlzGreyScanUnitFree(unt + idU);
+    }
+    AlcFree(unt);
+  }
+  AlcFree(thrBins);
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzFeatures
+* \brief	Frees the object, intervals and thresholded domain of
+* 		a scan unit.
+* \param	unt			Given scan unit.
+*/
+static void	WlzGreyScanUnitFree(WlzGreyScanUnit *unt)
+{
+  (void )WlzFreeObj(unt->obj);
+  if(unt->thrDom.core)
+  {
+    (void )WlzFreeDomain(unt->thrDom);
+  }
+  AlcFree(unt->lnItv);
+  AlcFree(unt->itv);
+}
+
+/*!
+* \ingroup	WlzFeatures
+* \brief	Scans the 2D object of a scan unit, accumulating the
+* 		unit's statistics and thresholded intervals and the
+* 		given histogram bins. Any error is set in the unit.
+* \param	ctl			Scan control.
+* \param	unt			Scan unit.
+* \param	bins			Histogram bins of the calling thread,
+* 					may be NULL.
+*/
+static void	WlzGreyScanUnit2D(const WlzGreyScanCtl *ctl,
+				  WlzGreyScanUnit *unt, int *bins)
+{
+  WlzUByte	*msk = NULL;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  unt->min = DBL_MAX;
+  unt->max = -DBL_MAX;
+  if(ctl->doThr)
+  {
+    WlzIntervalDomain *iDom;
+
+    iDom = unt->obj->domain.i;
+    unt->thrBox.xMin = unt->thrBox.yMin = INT_MAX;
+    unt->thrBox.xMax = unt->thrBox.yMax = INT_MIN;
+    if(((unt->lnItv = (int *)AlcCalloc(unt->nLn, sizeof(int))) == NULL) ||
+       ((msk = (WlzUByte *)
+               AlcMalloc(iDom->lastkl - iDom->kol1 + 1)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     ((errNum = WlzInitGreyScan(unt->obj, &iWSp, &gWSp)) == WLZ_ERR_NONE))
+  {
+    if(gWSp.tvb)
+    {
+      iWSp.plnpos = unt->pln;
+    }
+    while((errNum == WLZ_ERR_NONE) &&
+          ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+    {
+      int	n;
+      WlzGreyType gType;
+
+      n = iWSp.rgtpos - iWSp.lftpos + 1;
+      gType = gWSp.pixeltype;
+      switch(gType)
+      {
+        case WLZ_GREY_INT:   /* FALLTHROUGH */
+        case WLZ_GREY_SHORT: /* FALLTHROUGH */
+        case WLZ_GREY_UBYTE: /* FALLTHROUGH */
+        case WLZ_GREY_FLOAT: /* FALLTHROUGH */
+        case WLZ_GREY_DOUBLE: /* FALLTHROUGH */
+        case WLZ_GREY_RGBA:
+	  unt->gType = gType;
+	  break;
+	default:
+	  errNum = WLZ_ERR_GREY_TYPE;
+	  break;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	/* The interval's values are scanned once for each result, while
+	 * they are still in cache. */
+	if(ctl->doStats)
+	{
+	  WlzGreyScanItvStats(unt, gWSp.u_grintptr, gType, n);
+	}
+	if(bins)
+	{
+	  WlzGreyScanItvHist(ctl, bins, gWSp.u_grintptr, gType, n);
+	}
+	if(ctl->doThr)
+	{
+	  WlzGreyScanItvMask(ctl, msk, gWSp.u_grintptr, gType, n);
+	  errNum = WlzGreyScanItvThr(unt, msk, iWSp.linpos, iWSp.lftpos, n);
+	}
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  AlcFree(msk);
+  unt->errNum = errNum;
+}
+
+/*!
+* \ingroup	WlzFeatures
+* \brief	Accumulates the statistics of a scan unit from the values
+* 		of an interval.
+* \param	unt			Scan unit.
+* \param	gP			Pointer to the interval's values.
+* \param	gType			Grey type of the values.
+* \param	n			Number of values in the interval.
+*/
+static void	WlzGreyScanItvStats(WlzGreyScanUnit *unt,
+				    WlzGreyP gP, WlzGreyType gType, int n)
+{
+  int		i;
+  double	v,
+  		min,
+		max,
+		sum = 0.0,
+		sumSq = 0.0;
+
+  min = unt->min;
+  max = unt->max;
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      for(i = 0; i < n; ++i)
+      {
+        v = gP.inp[i];
+	min = (v < min)? v: min;
+	max = (v > max)? v: max;
+	sum += v;
+	sumSq += v * v;
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      for(i = 0; i < n; ++i)
+      {
+        v = gP.shp[i];
+	min = (v < min)? v: min;
+	max = (v > max)? v: max;
+	sum += v;
+	sumSq += v * v;
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      for(i = 0; i < n; ++i)
+      {
+        v = gP.ubp[i];
+	min = (v < min)? v: min;
+	max = (v > max)? v: max;
+	sum += v;
+	sumSq += v * v;
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      for(i = 0; i < n; ++i)
+      {
+        v = gP.flp[i];
+	min = (v < min)? v: min;
+	max = (v > max)? v: max;
+	sum += v;
+	sumSq += v * v;
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      for(i = 0; i < n; ++i)
+      {
+        v = gP.dbp[i];
+	min = (v < min)? v: min;
+	max = (v > max)? v: max;
+	sum += v;
+	sumSq += v * v;
+      }
+      break;
+    case WLZ_GREY_RGBA:
+      for(i = 0; i < n; ++i)
+      {
+        v = WLZ_RGBA_MODULUS(gP.rgbp[i]);
+	min = (v < min)? v: min;
+	max = (v > max)? v: max;
+	sum += v;
+	sumSq += v * v;
+      }
+      break;
+    default:
+      break;
+  }
+  unt->min = min;
+  unt->max = max;
+  unt->sum += sum;
+  unt->sumSq += sumSq;
+  unt->area += n;
+}
+
+/*!
+* \ingroup	WlzFeatures
+* \brief	Accumulates histogram bins from the values of an
+* 		interval, with the values binned as by WlzHistogramObj().
+* \param	ctl			Scan control.
+* \param	bins			Histogram bins.
+* \param	gP			Pointer to the interval's values.
+* \param	gType			Grey type of the values.
+* \param	n			Number of values in the interval.
+*/
+static void	WlzGreyScanItvHist(const WlzGreyScanCtl *ctl, int *bins,
+				   WlzGreyP gP, WlzGreyType gType, int n)
+{
+  int		i,
+  		idx,
+		nBins,
+		originI;
+  double	origin,
+  		binSize;
+
+  nBins = ctl->nBins;
+  origin = ctl->origin;
+  originI = ctl->originI;
+  binSize = ctl->binSize;
+  if(ctl->unitBin &&
+     ((gType == WLZ_GREY_INT) || (gType == WLZ_GREY_SHORT) ||
+      (gType == WLZ_GREY_UBYTE)))
+  {
+    switch(gType)
+    {
+      case WLZ_GREY_INT:
+	for(i = 0; i < n; ++i)
+	{
+	  idx = gP.inp[i] - originI;
+	  if((idx >= 0) && (idx < nBins))
+	  {
+	    ++bins[idx];
+	  }
+	}
+	break;
+      case WLZ_GREY_SHORT:
+	for(i = 0; i < n; ++i)
+	{
+	  idx = gP.shp[i] - originI;
+	  if((idx >= 0) && (idx < nBins))
+	  {
+	    ++bins[idx];
+	  }
+	}
+	break;
+      default: /* WLZ_GREY_UBYTE */
+	if((originI == 0) && (nBins == 256))
+	{
+	  for(i = 0; i < n; ++i)
+	  {
+	    ++bins[gP.ubp[i]];
+	  }
+	}
+	else
+	{
+	  for(i = 0; i < n; ++i)
+	  {
+	    idx = gP.ubp[i] - originI;
+	    if((idx >= 0) && (idx < nBins))
+	    {
+	      ++bins[idx];
+	    }
+	  }
+	}
+	break;
+    }
+  }
+  else
+  {
+    double	v = 0.0;
+
+    for(i = 0; i < n; ++i)
+    {
+      switch(gType)
+      {
+	case WLZ_GREY_INT:
+	  v = gP.inp[i];
+	  break;
+	case WLZ_GREY_SHORT:
+	  v = gP.shp[i];
+	  break;
+	case WLZ_GREY_UBYTE:
+	  v = gP.ubp[i];
+	  break;
+	case WLZ_GREY_FLOAT:
+	  v = gP.flp[i];
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  v = gP.dbp[i];
+	  break;
+	case WLZ_GREY_RGBA:
+	  v = WLZ_RGBA_MODULUS(gP.rgbp[i]);
+	  break;
+	default:
+	  break;
+      }
+      idx = (int )floor((v - origin) / binSize);
+      if((idx >= 0) && (idx < nBins))
+      {
+	++bins[idx];
+      }
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzFeatures
+* \brief	Sets a mask value for each value of an interval, which
+* 		is non-zero for values that are above threshold. Values
+* 		are compared as by WlzThreshold().
+* \param	ctl			Scan control.
+* \param	msk			Mask with space for the interval.
+* \param	gP			Pointer to the interval's values.
+* \param	gType			Grey type of the values.
+* \param	n			Number of values in the interval.
+*/
+static void	WlzGreyScanItvMask(const WlzGreyScanCtl *ctl, WlzUByte *msk,
+				   WlzGreyP gP, WlzGreyType gType, int n)
+{
+  int		i,
+  		lo,
+		hi;
+  const float	eps_f = 1.0e-6;
+  const double	eps_d = 1.0e-12;
+
+  lo = ctl->thrLoI;
+  hi = ctl->thrHiI;
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      for(i = 0; i < n; ++i)
+      {
+        msk[i] = (gP.inp[i] >= lo) && (gP.inp[i] <= hi);
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      for(i = 0; i < n; ++i)
+      {
+        msk[i] = (gP.shp[i] >= lo) && (gP.shp[i] <= hi);
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      for(i = 0; i < n; ++i)
+      {
+        msk[i] = (gP.ubp[i] >= lo) && (gP.ubp[i] <= hi);
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      {
+        float	t;
+
+	t = ctl->thrF;
+	switch(ctl->thrType)
+	{
+	  case WLZ_THRESH_LOW:
+	    for(i = 0; i < n; ++i)
+	    {
+	      msk[i] = gP.flp[i] < t;
+	    }
+	    break;
+	  case WLZ_THRESH_HIGH:
+	    for(i = 0; i < n; ++i)
+	    {
+	      msk[i] = gP.flp[i] >= t;
+	    }
+	    break;
+	  default: /* WLZ_THRESH_EQUAL */
+	    for(i = 0; i < n; ++i)
+	    {
+	      msk[i] = !((gP.flp[i] < (t - eps_f)) ||
+	                 (gP.flp[i] > (t + eps_f)));
+	    }
+	    break;
+	}
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      {
+        double	t;
+
+	t = ctl->thrD;
+	switch(ctl->thrType)
+	{
+	  case WLZ_THRESH_LOW:
+	    for(i = 0; i < n; ++i)
+	    {
+	      msk[i] = gP.dbp[i] < t;
+	    }
+	    break;
+	  case WLZ_THRESH_HIGH:
+	    for(i = 0; i < n; ++i)
+	    {
+	      msk[i] = gP.dbp[i] >= t;
+	    }
+	    break;
+	  default: /* WLZ_THRESH_EQUAL */
+	    for(i = 0; i < n; ++i)
+	    {
+	      msk[i] = !((gP.dbp[i] < (t - eps_d)) ||
+	                 (gP.dbp[i] > (t + eps_d)));
+	    }
+	    break;
+	}
+      }
+      break;
+    case WLZ_GREY_RGBA:
+      {
+        int	m,
+		t;
+
+	t = ctl->thrRGBA;
+	for(i = 0; i < n; ++i)
+	{
+	  m = WLZ_RGBA_MODULUS_2(gP.rgbp[i]);
+	  switch(ctl->thrType)
+	  {
+	    case WLZ_THRESH_LOW:
+	      msk[i] = m < t;
+	      break;
+	    case WLZ_THRESH_HIGH:
+	      msk[i] = m >= t;
+	      break;
+	    default: /* WLZ_THRESH_EQUAL */
+	      msk[i] = m == t;
+	      break;
+	  }
+	}
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFeatures
+* \brief	Appends the runs of above threshold values of an interval
+* 		to the thresholded intervals of a scan unit. As for
+* 		WlzThreshold() a run never extends beyond the interval
+* 		in which it was found.
+* \param	unt			Scan unit.
+* \param	msk			Threshold mask of the interval.
+* \param	ln			Line of the interval.
+* \param	kl0			First column of the interval.
+* \param	n			Number of values in the interval.
+*/
+static WlzErrorNum WlzGreyScanItvThr(WlzGreyScanUnit *unt,
+				     const WlzUByte *msk,
+				     int ln, int kl0, int n)
+{
+  int		i = 0,
+  		i0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  while(i < n)
+  {
+    while((i < n) && (msk[i] == 0))
+    {
+      ++i;
+    }
+    if(i < n)
+    {
+      WlzInterval *itv;
+
+      i0 = i;
+      while((i < n) && (msk[i] != 0))
+      {
+        ++i;
+      }
+      if(unt->nItv >= unt->maxItv)
+      {
+	int	  maxItv;
+	WlzInterval *newItv;
+
+	maxItv = (unt->maxItv > 0)? 2 * unt->maxItv: 1024;
+        if((newItv = (WlzInterval *)
+	             AlcRealloc(unt->itv,
+		                maxItv * sizeof(WlzInterval))) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	  break;
+	}
+	unt->itv = newItv;
+	unt->maxItv = maxItv;
+      }
+      itv = unt->itv + unt->nItv++;
+      itv->ileft = kl0 + i0;
+      itv->iright = kl0 + i - 1;
+      ++(unt->lnItv[ln - unt->ln0]);
+      if(itv->ileft < unt->thrBox.xMin)
+      {
+        unt->thrBox.xMin = itv->ileft;
+      }
+      if(itv->iright > unt->thrBox.xMax)
+      {
+        unt->thrBox.xMax = itv->iright;
+      }
+      if(ln < unt->thrBox.yMin)
+      {
+        unt->thrBox.yMin = ln;
+      }
+      if(ln > unt->thrBox.yMax)
+      {
+        unt->thrBox.yMax = ln;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New interval domain or NULL if there are no thresholded
+* 		intervals or on error.
+* \ingroup	WlzFeatures
+* \brief	Makes an interval domain from the thresholded intervals
+* 		of consecutive scan units which partition the lines of
+* 		a 2D object. The domain has a tight bounding box as
+* 		made by WlzThreshold().
+* \param	unt			Consecutive scan units.
+* \param	nUnt			Number of scan units.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzIntervalDomain *WlzGreyScanThrDom(WlzGreyScanUnit *unt, int nUnt,
+					    WlzErrorNum *dstErr)
+{
+  int		idU,
+  		nItv = 0;
+  WlzInterval	*itv = NULL;
+  WlzIBox2	box;
+  WlzIntervalDomain *iDom = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  box.xMin = box.yMin = INT_MAX;
+  box.xMax = box.yMax = INT_MIN;
+  for(idU = 0; idU < nUnt; ++idU)
+  {
+    if(unt[idU].nItv > 0)
+    {
+      nItv += unt[idU].nItv;
+      box.xMin = ALG_MIN(box.xMin, unt[idU].thrBox.xMin);
+      box.yMin = ALG_MIN(box.yMin, unt[idU].thrBox.yMin);
+      box.xMax = ALG_MAX(box.xMax, unt[idU].thrBox.xMax);
+      box.yMax = ALG_MAX(box.yMax, unt[idU].thrBox.yMax);
+    }
+  }
+  if(nItv > 0)
+  {
+    if((iDom = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+                                     box.yMin, box.yMax, box.xMin, box.xMax,
+				     &errNum)) != NULL)
+    {
+      if((itv = (WlzInterval *)AlcMalloc(nItv * sizeof(WlzInterval))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        iDom->freeptr = AlcFreeStackPush(iDom->freeptr, (void *)itv, NULL);
+      }
+    }
+    for(idU = 0; (errNum == WLZ_ERR_NONE) && (idU < nUnt); ++idU)
+    {
+      int	idL,
+      		idI = 0;
+      WlzGreyScanUnit *u;
+
+      u = unt + idU;
+      for(idL = 0; (errNum == WLZ_ERR_NONE) && (idL < u->nLn) &&
+                   (idI < u->nItv); ++idL)
+      {
+        int	n;
+
+	if((n = u->lnItv[idL]) > 0)
+	{
+	  int	i;
+
+	  for(i = 0; i < n; ++i)
+	  {
+	    itv[i].ileft = u->itv[idI + i].ileft - box.xMin;
+	    itv[i].iright = u->itv[idI + i].iright - box.xMin;
+	  }
+	  errNum = WlzMakeInterval(u->ln0 + idL, iDom, n, itv);
+	  itv += n;
+	  idI += n;
+	}
+      }
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      (void )WlzFreeIntervalDomain(iDom);
+      iDom = NULL;
+    }
+  }
+  *dstErr = errNum;
+  return(iDom);
+}
+
+/*!
+* \return	New thresholded object or NULL on error.
+* \ingroup	WlzFeatures
+* \brief	Makes the thresholded object from the scan units, in the
+* 		same form as made by WlzThreshold(). Empty objects are
+* 		returned for 2D objects with no thresholded values.
+* \param	obj			The given 2D or 3D domain object.
+* \param	unt			Scan units.
+* \param	nUnt			Number of scan units.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzGreyScanThrObj(WlzObject *obj,
+				    WlzGreyScanUnit *unt, int nUnt,
+				    WlzErrorNum *dstErr)
+{
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*thrObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    dom.i = WlzGreyScanThrDom(unt, nUnt, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(dom.i == NULL)
+      {
+	thrObj = WlzMakeEmpty(&errNum);
+      }
+      else
+      {
+	thrObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, obj->values,
+			     obj->plist, obj, &errNum);
+	if(thrObj == NULL)
+	{
+	  (void )WlzFreeIntervalDomain(dom.i);
+	}
+      }
+    }
+  }
+  else
+  {
+    int		idP,
+    		tiled;
+    WlzPlaneDomain *pDom,
+    		*nPDom;
+    WlzVoxelValues *vox = NULL,
+    		*nVox = NULL;
+
+    pDom = obj->domain.p;
+    tiled = WlzGreyTableIsTiled(obj->values.core->type);
+    nPDom = WlzMakePlaneDomain(pDom->type,
+			       pDom->plane1, pDom->lastpl,
+			       pDom->line1, pDom->lastln,
+			       pDom->kol1, pDom->lastkl, &errNum);
+    if((errNum == WLZ_ERR_NONE) && (tiled == 0))
+    {
+      vox = obj->values.vox;
+      nVox = WlzMakeVoxelValueTb(vox->type, vox->plane1, vox->lastpl,
+				 vox->bckgrnd, NULL, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idP = 0; idP < 3; ++idP)
+      {
+        nPDom->voxel_size[idP] = pDom->voxel_size[idP];
+      }
+      for(idP = 0; idP < nUnt; ++idP)
+      {
+        if(unt[idP].thrDom.core != NULL)
+	{
+	  nPDom->domains[idP] = WlzAssignDomain(unt[idP].thrDom, NULL);
+	  if(tiled == 0)
+	  {
+	    nVox->values[idP] = WlzAssignValues(vox->values[idP], NULL);
+	  }
+	}
+      }
+      errNum = WlzStandardPlaneDomain(nPDom, nVox);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dom.p = nPDom;
+      val.vox = nVox;
+      if((thrObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom,
+                               (tiled)? obj->values: val,
+			       NULL, obj, &errNum)) != NULL)
+      {
+	if(tiled == 0)
+	{
+	  nVox->original_table = WlzAssignValues(obj->values, NULL);
+	}
+	nPDom = NULL;
+	nVox = NULL;
+      }
+    }
+    (void )WlzFreePlaneDomain(nPDom);
+    (void )WlzFreeVoxelValueTb(nVox);
+  }
+  *dstErr = errNum;
+  return(thrObj);
+}
@@ -42,11 +42,61 @@ static char _WlzGreyValue_c[] = "University of Edinburgh $Id$";
 
 #include <stdlib.h>
 #include <limits.h>
+#include <math.h>
 #include <Wlz.h>
 #ifndef WLZ_FAST_CODE
 #define WLZ_FAST_CODE
 #endif
 
+#define WLZ_GREYVALUE_BATCH_CHUNK (256) /* Number of positions for which
+					   WlzGreyValueGetBatch() finds
+					   the value pointers before
+					   reading the values. */
+
+/*!
+* \struct	_WlzGreyValueBatchKey
+* \ingroup	WlzAccess
+* \brief	Integer coordinates of a position used to find the
+*		grey values of WlzGreyValueGetBatch().
+*		Typedef: ::WlzGreyValueBatchKey.
+*/
+typedef struct _WlzGreyValueBatchKey
+{
+  int		pln;			/*!< Plane coordinate. */
+  int		lin;			/*!< Line coordinate. */
+  int		kol;			/*!< Column coordinate. */
+} WlzGreyValueBatchKey;
+
+/*!
+* \struct	_WlzGreyValueBatchRow
+* \ingroup	WlzAccess
+* \brief	Cursor for access to the grey values along a single
+*		line of an object used by WlzGreyValueGetBatch().
+*		Typedef: ::WlzGreyValueBatchRow.
+*/
+typedef struct _WlzGreyValueBatchRow
+{
+  int		valid;			/*!< Non-zero if the line intersects
+  					     the domain. */
+  int		pln;			/*!< Plane coordinate. */
+  int		lin;			/*!< Line coordinate. */
+  int		kol1;			/*!< First column of the domain. */
+  int		lastkl;			/*!< Last column of the domain. */
+  int		nItv;			/*!< Number of intervals in the
+  					     line. */
+  WlzInterval	*itv;			/*!< Intervals of the line, NULL for
+  					     rectangular domains. */
+  WlzIntervalDomain *iDom;		/*!< Domain of the plane. */
+  WlzValues	values;			/*!< Values of the plane. */
+  WlzObjectType	gTabType;		/*!< Grey table type of the plane. */
+  WlzGreyP	base;			/*!< Base pointer for lines with
+  					     offsets linear in the column
+					     coordinate, otherwise NULL. */
+  long		off0;			/*!< Offset from base pointer to
+  					     column zero. */
+} WlzGreyValueBatchRow;
+
+
 static void			WlzGreyValueSetBkdP(
 				  WlzGreyV *gVP,
 				  WlzGreyP *gPP,
@@ -68,21 +118,40 @@ static void			WlzGreyValueComputeGreyP2D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
 				  WlzGreyValueWSpace *gVWSp,
+				  int pin,
 				  int line,
 				  int kol);
 static void			WlzGreyValueComputeGreyPTiled2D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
-				  WlzTiledValues *tVal,
+				  WlzGreyValueWSpace *gVWSp,
+				  int pin,
 				  int line,
 				  int kol);
 static void			WlzGreyValueComputeGreyPTiled3D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
-				  WlzTiledValues *tVal,
+				  WlzGreyValueWSpace *gVWSp,
+				  int pin,
 				  int plane,
 				  int line,
 				  int kol);
+static void			WlzGreyValueComputeGreyP2DNext(
+				  WlzGreyP *baseGVP,
+				  size_t *offset,
+				  WlzGreyValueWSpace *gVWSp,
+				  int pin,
+				  int line,
+				  int kol,
+				  WlzGreyP baseGVP0,
+				  size_t offset0);
+static void			WlzGreyValueTiledGreyP(
+				  WlzGreyP *baseGVP,
+				  size_t *offset,
+				  WlzGreyValueWSpace *gVWSp,
+				  int pin,
+				  size_t idx,
+				  size_t off);
 static void			WlzGreyValueGet2D1(
 				  WlzGreyValueWSpace *gVWSp,
 				  int line,
@@ -116,6 +185,48 @@ static void			WlzGreyValueGetTransCon(
 				  int plane,
 				  int line,
 				  int kol);
+static void			WlzGreyValueBatchKeys(
+				  WlzGreyValueBatchKey *key,
+				  WlzVertexType vType,
+				  WlzVertexP pos,
+				  int idx,
+				  int n,
+				  int lnr);
+static void			WlzGreyValueBatchKeyD(
+				  WlzGreyValueBatchKey *key,
+				  int lnr,
+				  double x,
+				  double y,
+				  double z);
+static double			WlzGreyValueBatchToD(
+				  WlzGreyType gType,
+				  WlzGreyV *gV,
+				  int idx);
+static double			WlzGreyValueBatchLinear(
+				  WlzObjectType objType,
+				  double *v,
+				  WlzDVertex3 p,
+				  WlzGreyValueBatchKey *key);
+static void			*WlzGreyValueBatchRowPtr(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzGreyValueBatchRow *row,
+				  int kol,
+				  size_t gSz);
+static void			WlzGreyValueBatchPtrToD(
+				  WlzGreyType gType,
+				  int n,
+				  void **ptr,
+				  double bkd,
+				  double *val);
+static void			WlzGreyValueBatchRowInit(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzGreyValueBatchRow *row,
+				  int pln,
+				  int lin);
+static WlzDVertex3		WlzGreyValueBatchPos(
+				  WlzVertexType vType,
+				  WlzVertexP pos,
+				  int idx);
 /*!
 * \return	Grey value work space or NULL on error.
 * \ingroup	WlzAccess
@@ -452,6 +563,15 @@ void		WlzGreyValueFreeWSp(WlzGreyValueWSpace *gVWSp)
 	    gVWSp));
   if(gVWSp)
   {
+    int		idx;
+
+    for(idx = 0; idx < 8; ++idx)
+    {
+      if(gVWSp->tPage[idx])
+      {
+        WlzTiledValuesPageOut(gVWSp->values.t, gVWSp->tPage[idx]);
+      }
+    }
     (void )WlzFreeAffineTransform(gVWSp->invTrans);
     AlcFree((void *)(gVWSp->gTabTypes3D));
     AlcFree(gVWSp);
@@ -773,6 +893,293 @@ void		WlzGreyValueGetDir(WlzGreyValueWSpace *gVWSp,
   }
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAccess
+* \brief	Gets the grey values at many points in a single call.
+*		This is equivalent to calling WlzGreyValueGet() (nearest
+*		neighbour) or WlzGreyValueGetCon() followed by bi/tri-linear
+*		weighting (linear) for each of the given positions, but
+*		is much cheaper for large numbers of points.
+*		The plane and interval line lookups are made once for
+*		each run of consecutive positions with the same plane
+*		and line rather than for each position, so positions
+*		should be given in raster order where possible, as they
+*		are along the lines of a section or transformed object.
+*		The vertex and grey types are switched on once for each
+*		chunk of positions rather than for each position.
+*		Positions which are outside of the domain's bounding box
+*		are rejected without any lookup.
+*		Values are returned as doubles in the same order as the
+*		given positions, with points outside of the object's domain
+*		having the background value. RGBA values may only be
+*		got using nearest neighbour interpolation, in which case
+*		the packed value is returned as by WlzGreyValueGetD().
+*		The grey value work space's cached plane and values are
+*		modified by this function.
+* \param	gVWSp			Grey value work space.
+* \param	interp			Interpolation, which must be either
+*					WLZ_INTERPOLATION_NEAREST or
+*					WLZ_INTERPOLATION_LINEAR.
+* \param	vType			Type of the given positions, which
+*					must be one of WLZ_VERTEX_I2,
+*					WLZ_VERTEX_F2, WLZ_VERTEX_D2,
+*					WLZ_VERTEX_I3, WLZ_VERTEX_F3 or
+*					WLZ_VERTEX_D3. Only 3D positions are
+*					valid for 3D objects, while the
+*					plane coordinate of 3D positions is
+*					ignored for 2D objects.
+* \param	nPos			Number of positions.
+* \param	pos			Given positions.
+* \param	dst			Destination array for the nPos grey
+*					values.
+*/
+WlzErrorNum	WlzGreyValueGetBatch(WlzGreyValueWSpace *gVWSp,
+				     WlzInterpolationType interp,
+				     WlzVertexType vType,
+				     int nPos,
+				     WlzVertexP pos,
+				     double *dst)
+{
+  int		idP,
+  		dim = 0,
+		nR = 1,
+		nV = 1;
+  void		**ptr = NULL;
+  double	*val = NULL;
+  WlzGreyValueBatchKey *key = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gVWSp == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(nPos < 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(nPos > 0)
+  {
+    if((pos.v == NULL) || (dst == NULL))
+    {
+      errNum = WLZ_ERR_PARAM_NULL;
+    }
+    else
+    {
+      switch(vType)
+      {
+        case WLZ_VERTEX_I2: /* FALLTHROUGH */
+        case WLZ_VERTEX_F2: /* FALLTHROUGH */
+        case WLZ_VERTEX_D2:
+	  dim = 2;
+	  break;
+        case WLZ_VERTEX_I3: /* FALLTHROUGH */
+        case WLZ_VERTEX_F3: /* FALLTHROUGH */
+        case WLZ_VERTEX_D3:
+	  dim = 3;
+	  break;
+	default:
+	  errNum = WLZ_ERR_PARAM_TYPE;
+	  break;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      switch(gVWSp->objType)
+      {
+        case WLZ_2D_DOMAINOBJ:
+	  break;
+	case WLZ_3D_DOMAINOBJ:
+	  if(dim != 3)
+	  {
+	    errNum = WLZ_ERR_PARAM_TYPE;
+	  }
+	  break;
+	default:
+	  errNum = WLZ_ERR_OBJECT_TYPE;
+	  break;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      switch(interp)
+      {
+        case WLZ_INTERPOLATION_NEAREST:
+	  break;
+	case WLZ_INTERPOLATION_LINEAR:
+	  if(gVWSp->gType == WLZ_GREY_RGBA)
+	  {
+	    errNum = WLZ_ERR_GREY_TYPE;
+	  }
+	  break;
+	default:
+	  errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	  break;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nPos > 0) && gVWSp->invTrans)
+  {
+    /* Values of transformed objects are got by inverse transforming
+     * each of the positions, so just use the single point functions. */
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      WlzDVertex3 p;
+
+      p = WlzGreyValueBatchPos(vType, pos, idP);
+      if(interp == WLZ_INTERPOLATION_NEAREST)
+      {
+	WlzGreyValueGet(gVWSp, p.vtZ, p.vtY, p.vtX);
+	dst[idP] = WlzGreyValueBatchToD(gVWSp->gType, gVWSp->gVal, 0);
+      }
+      else
+      {
+	int	idN,
+		nN;
+	double v[8];
+	WlzGreyValueBatchKey k;
+
+	k.pln = (int )floor(p.vtZ);
+	k.lin = (int )floor(p.vtY);
+	k.kol = (int )floor(p.vtX);
+	WlzGreyValueGetCon(gVWSp, k.pln, k.lin, k.kol);
+	nN = (gVWSp->objType == WLZ_2D_DOMAINOBJ)? 4: 8;
+	for(idN = 0; idN < nN; ++idN)
+	{
+	  v[idN] = WlzGreyValueBatchToD(gVWSp->gType, gVWSp->gVal, idN);
+	}
+	dst[idP] = WlzGreyValueBatchLinear(gVWSp->objType, v, p, &k);
+      }
+    }
+  }
+  else if((errNum == WLZ_ERR_NONE) && (nPos > 0))
+  {
+    nR = (interp == WLZ_INTERPOLATION_NEAREST)? 1:
+	 (gVWSp->objType == WLZ_2D_DOMAINOBJ)? 2: 4;
+    nV = (nR == 1)? 1: 2 * nR;
+    if(((key = (WlzGreyValueBatchKey *)
+	       AlcMalloc(sizeof(WlzGreyValueBatchKey) *
+			 WLZ_GREYVALUE_BATCH_CHUNK)) == NULL) ||
+       ((ptr = (void **)AlcMalloc(sizeof(void *) * nV *
+				  WLZ_GREYVALUE_BATCH_CHUNK)) == NULL) ||
+       ((val = (double *)AlcMalloc(sizeof(double) * nV *
+				   WLZ_GREYVALUE_BATCH_CHUNK)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (key != NULL))
+  {
+    int		idC,
+    		lnr,
+		paged,
+		rowSet = 0;
+    size_t	gSz;
+    double	bkd;
+    WlzIBox3	box;
+    WlzGreyValueBatchRow row[4];
+
+    /* Find the range of keys for which the neighbourhood may intersect
+     * the domain. */
+    lnr = (interp == WLZ_INTERPOLATION_LINEAR)? 1: 0;
+    if(gVWSp->objType == WLZ_2D_DOMAINOBJ)
+    {
+      box.zMin = box.zMax = 0;
+      box.yMin = gVWSp->iDom2D->line1 - lnr;
+      box.yMax = gVWSp->iDom2D->lastln;
+      box.xMin = gVWSp->iDom2D->kol1 - lnr;
+      box.xMax = gVWSp->iDom2D->lastkl;
+    }
+    else
+    {
+      box.zMin = gVWSp->domain.p->plane1 - lnr;
+      box.zMax = gVWSp->domain.p->lastpl;
+      box.yMin = gVWSp->domain.p->line1 - lnr;
+      box.yMax = gVWSp->domain.p->lastln;
+      box.xMin = gVWSp->domain.p->kol1 - lnr;
+      box.xMax = gVWSp->domain.p->lastkl;
+    }
+    bkd = WlzGreyValueBatchToD(gVWSp->gType, &(gVWSp->gBkd), 0);
+    gSz = WlzGreySize(gVWSp->gType);
+    paged = (gVWSp->gTabType == (WlzObjectType )WLZ_GREY_TAB_TILED) &&
+	    (gVWSp->values.t->pager != NULL);
+    /* Work through the positions a chunk at a time. The keys of a
+     * chunk are computed, then the pointers to their values are found
+     * using cursors for the lines of the neighbourhood, which are kept
+     * while consecutive positions have the same plane and line, and
+     * then the values of the chunk are read. Paged tile pointers are
+     * only valid until the page pin is reused so these values are read
+     * as soon as their pointer is found. */
+    for(idC = 0; idC < nPos; idC += WLZ_GREYVALUE_BATCH_CHUNK)
+    {
+      int	idK,
+      		nK;
+      double	*cVal;
+
+      nK = ALG_MIN(nPos - idC, WLZ_GREYVALUE_BATCH_CHUNK);
+      cVal = (nV == 1)? dst + idC: val;
+      WlzGreyValueBatchKeys(key, vType, pos, idC, nK, lnr);
+      for(idK = 0; idK < nK; ++idK)
+      {
+	int	idV,
+		in;
+	WlzGreyValueBatchKey *k;
+
+	k = key + idK;
+	if(gVWSp->objType == WLZ_2D_DOMAINOBJ)
+	{
+	  k->pln = 0;
+	}
+	in = (k->pln >= box.zMin) && (k->pln <= box.zMax) &&
+	     (k->lin >= box.yMin) && (k->lin <= box.yMax) &&
+	     (k->kol >= box.xMin) && (k->kol <= box.xMax);
+	if(in && ((rowSet == 0) ||
+	          (k->pln != row[0].pln) || (k->lin != row[0].lin)))
+	{
+	  for(idV = 0; idV < nR; ++idV)
+	  {
+	    WlzGreyValueBatchRowInit(gVWSp, row + idV,
+				     k->pln + (idV / 2), k->lin + (idV % 2));
+	  }
+	  rowSet = 1;
+	}
+	for(idV = 0; idV < nV; ++idV)
+	{
+	  int	idI;
+
+	  idI = (idK * nV) + idV;
+	  ptr[idI] = (in)? WlzGreyValueBatchRowPtr(gVWSp, row + (idV / 2),
+						   k->kol + (idV % 2), gSz):
+			   NULL;
+	  if(paged)
+	  {
+	    WlzGreyValueBatchPtrToD(gVWSp->gType, 1, ptr + idI, bkd,
+				    cVal + idI);
+	  }
+	}
+      }
+      if(!paged)
+      {
+	WlzGreyValueBatchPtrToD(gVWSp->gType, nK * nV, ptr, bkd, cVal);
+      }
+      if(nV > 1)
+      {
+	for(idK = 0; idK < nK; ++idK)
+	{
+	  dst[idC + idK] = WlzGreyValueBatchLinear(gVWSp->objType,
+				  val + (idK * nV),
+				  WlzGreyValueBatchPos(vType, pos, idC + idK),
+				  key + idK);
+	}
+      }
+    }
+  }
+  AlcFree(key);
+  AlcFree(ptr);
+  AlcFree(val);
+  return(errNum);
+}
+
 /*!
 * \return	void
 * \ingroup	WlzAccess
@@ -966,13 +1373,16 @@ static void	WlzGreyValueSetGreyP(WlzGreyV *gVP, WlzGreyP *gPP,
 * \param	offset			Destination pointer for the
 *                                       offset from base pointer.
 * \param	gVWSp			Grey value work space.
+* \param	pin			Index of the work space page pin
+* 					to use if the values are paged
+* 					tiled values.
 * \param	line			Line coordinate of point.
 * \param	kol			Column coordinate of point.
 */
 static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
 					   size_t *offset,
 					   WlzGreyValueWSpace *gVWSp,
-					   int line, int kol)
+					   int pin, int line, int kol)
 {
   int		itvCount,
   		kol0;
@@ -1021,7 +1431,7 @@ static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
       }
       break;
     case WLZ_GREY_TAB_TILED:
-      WlzGreyValueComputeGreyPTiled2D(baseGVP, offset, gVWSp->values.t,
+      WlzGreyValueComputeGreyPTiled2D(baseGVP, offset, gVWSp, pin,
                                       line, kol);
       break;
     default:
@@ -1040,18 +1450,22 @@ static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
 * \param	offset			Destination pointer for the
 *                                       offset from base pointer.
 * \param	gVWSp			Grey value work space.
+* \param	pin			Index of the work space page pin
+* 					to use if the tiles are paged.
 * \param	line			Line coordinate of point.
 * \param	kol			Column coordinate of point.
 */
 static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
-				size_t *offset, WlzTiledValues *tVal,
-				int line, int kol)
+				size_t *offset, WlzGreyValueWSpace *gVWSp,
+				int pin, int line, int kol)
 {
   WlzIVertex2 	rPos,
 		tIdx;
+  WlzTiledValues *tVal;
 
   *offset = 0;
   (*baseGVP).v = NULL;
+  tVal = gVWSp->values.t;
   rPos.vtX = kol - tVal->kol1;
   tIdx.vtX = rPos.vtX / tVal->tileWidth;
 #ifdef WLZ_FAST_CODE
@@ -1084,8 +1498,7 @@ static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 	tOff.vtX = rPos.vtX % tVal->tileWidth;
 	tOff.vtY = rPos.vtY % tVal->tileWidth;
 	off = (tOff.vtY * tVal->tileWidth) + tOff.vtX;
-	(*baseGVP).v = tVal->tiles.v;
-	*offset = ((idx * tVal->tileSz) + off) * tVal->vpe;
+	WlzGreyValueTiledGreyP(baseGVP, offset, gVWSp, pin, idx, off);
       }
     }
   }
@@ -1102,19 +1515,23 @@ static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 * \param	offset			Destination pointer for the
 *                                       offset from base pointer.
 * \param	gVWSp			Grey value work space.
+* \param	pin			Index of the work space page pin
+* 					to use if the tiles are paged.
 * \param	plane			Plane coordinate of point.
 * \param	line			Line coordinate of point.
 * \param	kol			Column coordinate of point.
 */
 static void	WlzGreyValueComputeGreyPTiled3D(WlzGreyP *baseGVP,
-				size_t *offset, WlzTiledValues *tVal,
-				int plane, int line, int kol)
+				size_t *offset, WlzGreyValueWSpace *gVWSp,
+				int pin, int plane, int line, int kol)
 {
   WlzIVertex3 	rPos,
 		tIdx;
+  WlzTiledValues *tVal;
 
   *offset = 0;
   (*baseGVP).v = NULL;
+  tVal = gVWSp->values.t;
   rPos.vtX = kol - tVal->kol1;
   tIdx.vtX = rPos.vtX / tVal->tileWidth;
 #ifdef WLZ_FAST_CODE
@@ -1158,14 +1575,113 @@ static void	WlzGreyValueComputeGreyPTiled3D(WlzGreyP *baseGVP,
 	  tOff.vtZ = rPos.vtZ % tVal->tileWidth;
 	  off = ((tOff.vtZ * tVal->tileWidth + tOff.vtY) * tVal->tileWidth) +
 	        tOff.vtX;
-	  (*baseGVP).v = tVal->tiles.v;
-	  *offset = ((idx * tVal->tileSz) + off) * tVal->vpe;
+	  WlzGreyValueTiledGreyP(baseGVP, offset, gVWSp, pin, idx, off);
 	}
       }
     }
   }
 }
 
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Computes the base pointer and offset for the column
+* 		following that of a base pointer and offset which have
+* 		already been computed. For tiled values the following
+* 		column may be in a different tile, otherwise it is simply
+* 		at the next offset.
+* \param	baseGVP			Destination pointer for the
+*                                       base pointer.
+* \param	offset			Destination pointer for the
+*                                       offset from base pointer.
+* \param	gVWSp			Grey value work space.
+* \param	pin			Index of the work space page pin
+* 					to use if the values are paged
+* 					tiled values.
+* \param	line			Line coordinate of point.
+* \param	kol			Column coordinate of point (not the
+* 					following column).
+* \param	baseGVP0		Base pointer computed for the point.
+* \param	offset0			Offset computed for the point.
+*/
+static void	WlzGreyValueComputeGreyP2DNext(WlzGreyP *baseGVP,
+					       size_t *offset,
+					       WlzGreyValueWSpace *gVWSp,
+					       int pin, int line, int kol,
+					       WlzGreyP baseGVP0,
+					       size_t offset0)
+{
+  if(gVWSp->gTabType2D == (WlzObjectType )WLZ_GREY_TAB_TILED)
+  {
+    WlzGreyValueComputeGreyP2D(baseGVP, offset, gVWSp, pin, line, kol + 1);
+  }
+  else
+  {
+    *baseGVP = baseGVP0;
+    *offset = offset0 + 1;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Computes the base pointer and offset for a value within
+* 		the given tile of the work space's tiled values.
+* 		If the tiles are paged then the tile is paged in and
+* 		pinned using the given pin of the work space, with any
+* 		other tile previously held by the pin being released.
+* 		The pointer then remains valid until the pin is reused
+* 		or the work space is freed. If the tile can not be read
+* 		the base pointer is set to the work space's background
+* 		value.
+* \param	baseGVP			Destination pointer for the
+*                                       base pointer.
+* \param	offset			Destination pointer for the
+*                                       offset from base pointer.
+* \param	gVWSp			Grey value work space.
+* \param	pin			Index of the work space page pin.
+* \param	idx			Index of the tile.
+* \param	off			Offset of the element within the
+* 					tile.
+*/
+static void	WlzGreyValueTiledGreyP(WlzGreyP *baseGVP, size_t *offset,
+				       WlzGreyValueWSpace *gVWSp, int pin,
+				       size_t idx, size_t off)
+{
+  WlzTiledValues *tVal;
+
+  tVal = gVWSp->values.t;
+  if(tVal->pager == NULL)
+  {
+    (*baseGVP).v = tVal->tiles.v;
+    *offset = ((idx * tVal->tileSz) + off) * tVal->vpe;
+  }
+  else
+  {
+    WlzTiledValuesPage *page;
+
+    page = gVWSp->tPage[pin];
+    if((page == NULL) || (page->idx != idx))
+    {
+      if(page)
+      {
+        WlzTiledValuesPageOut(tVal, page);
+      }
+      page = gVWSp->tPage[pin] = WlzTiledValuesPageIn(tVal, idx, NULL);
+    }
+    if(page)
+    {
+      *baseGVP = page->values;
+      *offset = off * tVal->vpe;
+    }
+    else
+    {
+      (*baseGVP).v = &(gVWSp->gBkd);
+      *offset = 0;
+    }
+  }
+}
+
 /*!
 * \return	void
 * \ingroup	WlzAccess
@@ -1210,7 +1726,7 @@ static void	WlzGreyValueGet2D1(WlzGreyValueWSpace *gVWSp,
 	if(gVWSp->iDom2D->type == WLZ_INTERVALDOMAIN_RECT)
 	{
 	  valSet = 1;
-	  WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, line, kol);
+	  WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, 0, line, kol);
 	  WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
 			       baseGVP, offset);
 	}
@@ -1228,7 +1744,8 @@ static void	WlzGreyValueGet2D1(WlzGreyValueWSpace *gVWSp,
 	    else if(kolRel <= itv->iright)
 	    {
 	      valSet = 1;
-	      WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, line, kol);
+	      WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, 0,
+	      				 line, kol);
 	      WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
 				   baseGVP, offset);
 	      break;
@@ -1331,8 +1848,7 @@ static void	WlzGreyValueGet3DTiled(WlzGreyValueWSpace *gVWSp,
 	    size_t   	offset;
 	    WlzGreyP 	baseGVP;
 
-	    WlzGreyValueComputeGreyPTiled3D(&baseGVP, &offset,
-					    gVWSp->values.t,
+	    WlzGreyValueComputeGreyPTiled3D(&baseGVP, &offset, gVWSp, 0,
 					    plane, line, kol);
 	    WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
 				 baseGVP, offset);
@@ -1421,9 +1937,11 @@ static void	WlzGreyValueGet2DCon(WlzGreyValueWSpace *gVWSp,
 		kolRel,
 		count,
   		pass;
-  size_t 	offset;
+  size_t 	offset,
+  		offset1;
   unsigned	hitMsk;
-  WlzGreyP	baseGVP;
+  WlzGreyP	baseGVP,
+  		baseGVP1;
   WlzInterval	*itv;
   WlzIntervalLine *itvLn;
   WlzGreyV	*gVP;
@@ -1456,7 +1974,11 @@ static void	WlzGreyValueGet2DCon(WlzGreyValueWSpace *gVWSp,
 	{
 	  if(gVWSp->iDom2D->type == WLZ_INTERVALDOMAIN_RECT)
 	  {
-	    WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, line, kol);
+	    WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, pass * 2,
+	    			       line, kol);
+	    WlzGreyValueComputeGreyP2DNext(&baseGVP1, &offset1, gVWSp,
+	    				   (pass * 2) + 1, line, kol,
+					   baseGVP, offset);
 	    if(kol >= kol1)
 	    {
 	      hitMsk |= 1 << (pass * 2);
@@ -1466,7 +1988,7 @@ static void	WlzGreyValueGet2DCon(WlzGreyValueWSpace *gVWSp,
 	    {
 	      hitMsk |= 1 << ((pass * 2) + 1);
 	      WlzGreyValueSetGreyP(gVP + 1, gPP + 1, gVWSp->gType,
-				   baseGVP, offset + 1);
+				   baseGVP1, offset1);
 	    }
 	  }
 	  else		  /* gVWSp->iDom2D->type == WLZ_INTERVALDOMAIN_INTVL */
@@ -1483,8 +2005,11 @@ static void	WlzGreyValueGet2DCon(WlzGreyValueWSpace *gVWSp,
 	      }
 	      else if(kolRel <= itv->iright)
 	      {
-		WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, line,
-					   kol);
+		WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, pass * 2,
+					   line, kol);
+		WlzGreyValueComputeGreyP2DNext(&baseGVP1, &offset1, gVWSp,
+					       (pass * 2) + 1, line, kol,
+					       baseGVP, offset);
 		if(kol >= (kol1 + itv->ileft))
 		{
 		  hitMsk |= 1 << (pass * 2);
@@ -1495,7 +2020,7 @@ static void	WlzGreyValueGet2DCon(WlzGreyValueWSpace *gVWSp,
 		{
 		  hitMsk |= 1 << ((pass * 2) + 1);
 		  WlzGreyValueSetGreyP(gVP + 1, gPP + 1, gVWSp->gType,
-				       baseGVP, offset + 1);
+				       baseGVP1, offset1);
 		}
 	      }
 	      ++itv;
@@ -1529,6 +2054,7 @@ static void	WlzGreyValueGet3DCon(WlzGreyValueWSpace *gVWSp,
 		pln,
   		planeOff,
 		planeRel,
+		saved = 0,
 		savePlane = 0;
   WlzDomain	*domP;
   WlzValues	*valP;
@@ -1568,6 +2094,7 @@ static void	WlzGreyValueGet3DCon(WlzGreyValueWSpace *gVWSp,
 	    saveIDom2D = gVWSp->iDom2D;
 	    saveValues2D = gVWSp->values2D;
 	    saveGTabType2D = gVWSp->gTabType2D;
+	    saved = 1;
 	  }
 	  gVWSp->plane = pln;
 	  gVWSp->iDom2D = (*domP).i;
@@ -1602,10 +2129,15 @@ static void	WlzGreyValueGet3DCon(WlzGreyValueWSpace *gVWSp,
   }
   if(planeSet[0])
   {
-    gVWSp->plane = savePlane;
-    gVWSp->iDom2D = saveIDom2D;
-    gVWSp->values2D = saveValues2D;
-    gVWSp->gTabType2D = saveGTabType2D;
+    /* Only restore the cached plane if it was changed for the second
+     * plane. */
+    if(saved)
+    {
+      gVWSp->plane = savePlane;
+      gVWSp->iDom2D = saveIDom2D;
+      gVWSp->values2D = saveValues2D;
+      gVWSp->gTabType2D = saveGTabType2D;
+    }
     for(tI0 = 0; tI0 < 4; ++tI0)
     {
       gVWSp->gPtr[tI0] = saveGPtr[tI0];
@@ -1731,6 +2263,7 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
     		tIdx,
 		tOff;
     size_t 	offset;
+    WlzGreyP	baseGVP;
     WlzTiledValues *tVal;
 
     idV = 0;
@@ -1757,10 +2290,10 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
             rPos.vtX = kol - tVal->kol1 + idK;
 	    tIdx.vtX = tIdx.vtY + (rPos.vtX / tVal->tileWidth);
             tOff.vtX = tOff.vtY + (rPos.vtX % tVal->tileWidth);
-            offset = (*(tVal->indices + tIdx.vtX) * tVal->tileSz +
-	              tOff.vtX) * tVal->vpe;
+	    WlzGreyValueTiledGreyP(&baseGVP, &offset, gVWSp, idV,
+	    			   *(tVal->indices + tIdx.vtX), tOff.vtX);
 	    WlzGreyValueSetGreyP(gVWSp->gVal + idV, gVWSp->gPtr + idV,
-	                         gVWSp->gType, tVal->tiles, offset);
+	                         gVWSp->gType, baseGVP, offset);
 	  }
 	  ++idV;
 	}
@@ -1854,3 +2387,481 @@ static void	WlzGreyValueGetTransCon(WlzGreyValueWSpace *gVWSp,
       break;
   }
 }
+
+/*!
+* \return	Position as a 3D double precision vertex.
+* \ingroup	WlzAccess
+* \brief	Gets the indexed position from an array of vertices.
+*		2D positions have their plane coordinate set to zero.
+* \param	vType			Vertex type.
+* \param	pos			Array of vertices.
+* \param	idx			Index of the vertex.
+*/
+static WlzDVertex3 WlzGreyValueBatchPos(WlzVertexType vType,
+				        WlzVertexP pos, int idx)
+{
+  WlzDVertex3	p;
+
+  p.vtZ = 0.0;
+  switch(vType)
+  {
+    case WLZ_VERTEX_I2:
+      p.vtX = pos.i2[idx].vtX;
+      p.vtY = pos.i2[idx].vtY;
+      break;
+    case WLZ_VERTEX_F2:
+      p.vtX = pos.f2[idx].vtX;
+      p.vtY = pos.f2[idx].vtY;
+      break;
+    case WLZ_VERTEX_D2:
+      p.vtX = pos.d2[idx].vtX;
+      p.vtY = pos.d2[idx].vtY;
+      break;
+    case WLZ_VERTEX_I3:
+      p.vtX = pos.i3[idx].vtX;
+      p.vtY = pos.i3[idx].vtY;
+      p.vtZ = pos.i3[idx].vtZ;
+      break;
+    case WLZ_VERTEX_F3:
+      p.vtX = pos.f3[idx].vtX;
+      p.vtY = pos.f3[idx].vtY;
+      p.vtZ = pos.f3[idx].vtZ;
+      break;
+    case WLZ_VERTEX_D3:
+      p = pos.d3[idx];
+      break;
+    default:
+      p.vtX = p.vtY = 0.0;
+      break;
+  }
+  return(p);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Computes the keys of a run of positions, these being the
+*		plane, line and column of the nearest voxel or, for
+*		linear interpolation, of the voxel with the least
+*		coordinates of the neighbourhood. The plane of 2D
+*		positions is set to zero.
+* \param	key			Destination for the n keys.
+* \param	vType			Vertex type.
+* \param	pos			Array of vertices.
+* \param	idx			Index of the first vertex.
+* \param	n			Number of vertices.
+* \param	lnr			Non-zero for linear interpolation.
+*/
+static void	WlzGreyValueBatchKeys(WlzGreyValueBatchKey *key,
+				      WlzVertexType vType, WlzVertexP pos,
+				      int idx, int n, int lnr)
+{
+  int		idK;
+
+  switch(vType)
+  {
+    case WLZ_VERTEX_I2:
+      for(idK = 0; idK < n; ++idK)
+      {
+	key[idK].pln = 0;
+	key[idK].lin = pos.i2[idx + idK].vtY;
+	key[idK].kol = pos.i2[idx + idK].vtX;
+      }
+      break;
+    case WLZ_VERTEX_I3:
+      for(idK = 0; idK < n; ++idK)
+      {
+	key[idK].pln = pos.i3[idx + idK].vtZ;
+	key[idK].lin = pos.i3[idx + idK].vtY;
+	key[idK].kol = pos.i3[idx + idK].vtX;
+      }
+      break;
+    case WLZ_VERTEX_F2:
+      for(idK = 0; idK < n; ++idK)
+      {
+	WlzGreyValueBatchKeyD(key + idK, lnr, pos.f2[idx + idK].vtX,
+			      pos.f2[idx + idK].vtY, 0.0);
+      }
+      break;
+    case WLZ_VERTEX_D2:
+      for(idK = 0; idK < n; ++idK)
+      {
+	WlzGreyValueBatchKeyD(key + idK, lnr, pos.d2[idx + idK].vtX,
+			      pos.d2[idx + idK].vtY, 0.0);
+      }
+      break;
+    case WLZ_VERTEX_F3:
+      for(idK = 0; idK < n; ++idK)
+      {
+	WlzGreyValueBatchKeyD(key + idK, lnr, pos.f3[idx + idK].vtX,
+			      pos.f3[idx + idK].vtY, pos.f3[idx + idK].vtZ);
+      }
+      break;
+    case WLZ_VERTEX_D3:
+      for(idK = 0; idK < n; ++idK)
+      {
+	WlzGreyValueBatchKeyD(key + idK, lnr, pos.d3[idx + idK].vtX,
+			      pos.d3[idx + idK].vtY, pos.d3[idx + idK].vtZ);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Sets a key from a floating point position, being the
+*		nearest voxel or, for linear interpolation, the voxel
+*		with the least coordinates of the neighbourhood.
+* \param	key			Key to set.
+* \param	lnr			Non-zero for linear interpolation.
+* \param	x			Column coordinate.
+* \param	y			Line coordinate.
+* \param	z			Plane coordinate.
+*/
+static void	WlzGreyValueBatchKeyD(WlzGreyValueBatchKey *key, int lnr,
+				      double x, double y, double z)
+{
+  if(lnr)
+  {
+    key->pln = (int )floor(z);
+    key->lin = (int )floor(y);
+    key->kol = (int )floor(x);
+  }
+  else
+  {
+    key->pln = WLZ_NINT(z);
+    key->lin = WLZ_NINT(y);
+    key->kol = WLZ_NINT(x);
+  }
+}
+
+/*!
+* \return	Grey value as a double.
+* \ingroup	WlzAccess
+* \brief	Converts the indexed grey value to a double.
+* \param	gType			Grey type.
+* \param	gV			Array of grey values.
+* \param	idx			Index of the grey value.
+*/
+static double	WlzGreyValueBatchToD(WlzGreyType gType, WlzGreyV *gV,
+				     int idx)
+{
+  double	v = 0.0;
+
+  switch(gType)
+  {
+    case WLZ_GREY_LONG:
+      v = gV[idx].lnv;
+      break;
+    case WLZ_GREY_INT:
+      v = gV[idx].inv;
+      break;
+    case WLZ_GREY_SHORT:
+      v = gV[idx].shv;
+      break;
+    case WLZ_GREY_UBYTE:
+      v = gV[idx].ubv;
+      break;
+    case WLZ_GREY_FLOAT:
+      v = gV[idx].flv;
+      break;
+    case WLZ_GREY_DOUBLE:
+      v = gV[idx].dbv;
+      break;
+    case WLZ_GREY_RGBA:
+      v = gV[idx].rgbv;
+      break;
+    default:
+      break;
+  }
+  return(v);
+}
+
+/*!
+* \return	Interpolated value.
+* \ingroup	WlzAccess
+* \brief	Computes the bi-linear (2D) or tri-linear (3D) interpolated
+*		value from the neighbourhood values which are ordered with
+*		column varying fastest, then line and then plane.
+* \param	objType			Object type.
+* \param	v			Neighbourhood values.
+* \param	p			Position.
+* \param	key			Key with the least coordinates of
+*					the neighbourhood.
+*/
+static double	WlzGreyValueBatchLinear(WlzObjectType objType, double *v,
+					WlzDVertex3 p,
+					WlzGreyValueBatchKey *key)
+{
+  double	tX,
+  		tY,
+		tZ,
+		r;
+
+  tX = p.vtX - key->kol;
+  tY = p.vtY - key->lin;
+  r = (1.0 - tY) * ((1.0 - tX) * v[0] + tX * v[1]) +
+      tY * ((1.0 - tX) * v[2] + tX * v[3]);
+  if(objType == WLZ_3D_DOMAINOBJ)
+  {
+    tZ = p.vtZ - key->pln;
+    r = (1.0 - tZ) * r +
+        tZ * ((1.0 - tY) * ((1.0 - tX) * v[4] + tX * v[5]) +
+              tY * ((1.0 - tX) * v[6] + tX * v[7]));
+  }
+  return(r);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Initialises a batch row cursor for the given plane and line.
+*		The cursor is only valid if the line intersects the
+*		object's domain.
+* \param	gVWSp			Grey value work space.
+* \param	row			Row cursor to initialise.
+* \param	pln			Plane coordinate (ignored for 2D).
+* \param	lin			Line coordinate.
+*/
+static void	WlzGreyValueBatchRowInit(WlzGreyValueWSpace *gVWSp,
+				         WlzGreyValueBatchRow *row,
+					 int pln, int lin)
+{
+  WlzIntervalDomain *iDom = NULL;
+
+  row->valid = 0;
+  row->pln = pln;
+  row->lin = lin;
+  row->base.v = NULL;
+  row->values.core = NULL;
+  if(gVWSp->objType == WLZ_2D_DOMAINOBJ)
+  {
+    iDom = gVWSp->iDom2D;
+    row->values = gVWSp->values2D;
+    row->gTabType = gVWSp->gTabType2D;
+  }
+  else
+  {
+    int		plRel;
+
+    plRel = pln - gVWSp->domain.p->plane1;
+    if((plRel >= 0) && (pln <= gVWSp->domain.p->lastpl))
+    {
+      WlzDomain	dom;
+
+      dom = gVWSp->domain.p->domains[plRel];
+      if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN))
+      {
+	if(gVWSp->gTabType == (WlzObjectType )WLZ_GREY_TAB_TILED)
+	{
+	  iDom = dom.i;
+	  row->gTabType = WLZ_GREY_TAB_TILED;
+	}
+	else
+	{
+	  WlzValues val;
+
+	  val = gVWSp->values.vox->values[plRel];
+	  if((val.core != NULL) && (val.core->type != WLZ_EMPTY_OBJ))
+	  {
+	    iDom = dom.i;
+	    row->values = val;
+	    row->gTabType = gVWSp->gTabTypes3D[plRel];
+	  }
+	}
+      }
+    }
+  }
+  if((iDom != NULL) && (lin >= iDom->line1) && (lin <= iDom->lastln))
+  {
+    row->valid = 1;
+    row->iDom = iDom;
+    row->kol1 = iDom->kol1;
+    row->lastkl = iDom->lastkl;
+    if(iDom->type == WLZ_INTERVALDOMAIN_INTVL)
+    {
+      WlzIntervalLine *itvLn;
+
+      itvLn = iDom->intvlines + lin - iDom->line1;
+      row->nItv = itvLn->nintvs;
+      row->itv = itvLn->intvs;
+      row->valid = row->nItv > 0;
+    }
+    else
+    {
+      row->nItv = 0;
+      row->itv = NULL;
+    }
+    /* For ragged rectangle and rectangular value tables the offset is
+     * linear in the column coordinate, so compute it's base here. */
+    if(row->gTabType == (WlzObjectType )WLZ_GREY_TAB_RAGR)
+    {
+      WlzValueLine *vLn;
+
+      vLn = row->values.v->vtblines + (lin - row->values.v->line1);
+      row->base = vLn->values;
+      row->off0 = -(long )(row->values.v->kol1 + vLn->vkol1);
+    }
+    else if(row->gTabType == (WlzObjectType )WLZ_GREY_TAB_RECT)
+    {
+      row->base = row->values.r->values;
+      row->off0 = ((long )(row->values.r->width) *
+		   (lin - row->values.r->line1)) - row->values.r->kol1;
+    }
+  }
+}
+
+/*!
+* \return	Pointer to the grey value or NULL if the column is not
+*		within the domain.
+* \ingroup	WlzAccess
+* \brief	Gets a pointer to the grey value at the given column of a
+*		batch row cursor.
+* \param	gVWSp			Grey value work space.
+* \param	row			Row cursor.
+* \param	kol			Column coordinate.
+* \param	gSz			Size of a grey value.
+*/
+static void	*WlzGreyValueBatchRowPtr(WlzGreyValueWSpace *gVWSp,
+				         WlzGreyValueBatchRow *row,
+					 int kol, size_t gSz)
+{
+  int		in = 0;
+  void		*ptr = NULL;
+
+  if(row->valid && (kol >= row->kol1) && (kol <= row->lastkl))
+  {
+    if(row->itv == NULL)
+    {
+      in = 1;
+    }
+    else
+    {
+      int	kolRel,
+      		nItv;
+      WlzInterval *itv;
+
+      kolRel = kol - row->kol1;
+      nItv = row->nItv;
+      itv = row->itv;
+      while((nItv > 0) && (kolRel > itv->iright))
+      {
+        ++itv;
+	--nItv;
+      }
+      in = (nItv > 0) && (kolRel >= itv->ileft);
+    }
+  }
+  if(in)
+  {
+    size_t	off = 0;
+    WlzGreyP	gP;
+
+    if(row->base.v)
+    {
+      gP = row->base;
+      off = (size_t )(row->off0 + kol);
+    }
+    else
+    {
+      gP.v = NULL;
+      if(gVWSp->objType == WLZ_3D_DOMAINOBJ)
+      {
+	if(row->gTabType == (WlzObjectType )WLZ_GREY_TAB_TILED)
+	{
+	  WlzGreyValueComputeGreyPTiled3D(&gP, &off, gVWSp, 0,
+					  row->pln, row->lin, kol);
+	}
+	else
+	{
+	  gVWSp->plane = row->pln;
+	  gVWSp->iDom2D = row->iDom;
+	  gVWSp->values2D = row->values;
+	  gVWSp->gTabType2D = row->gTabType;
+	  WlzGreyValueComputeGreyP2D(&gP, &off, gVWSp, 0, row->lin, kol);
+	}
+      }
+      else
+      {
+	WlzGreyValueComputeGreyP2D(&gP, &off, gVWSp, 0, row->lin, kol);
+      }
+    }
+    if(gP.v)
+    {
+      ptr = (void *)(gP.ubp + (off * gSz));
+    }
+  }
+  return(ptr);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Reads the grey values at the given pointers as doubles,
+*		with the background value for NULL pointers.
+* \param	gType			Grey type.
+* \param	n			Number of pointers.
+* \param	ptr			Pointers to the grey values.
+* \param	bkd			Background value.
+* \param	val			Destination for the n values.
+*/
+static void	WlzGreyValueBatchPtrToD(WlzGreyType gType, int n,
+					void **ptr, double bkd, double *val)
+{
+  int		idx;
+
+  switch(gType)
+  {
+    case WLZ_GREY_LONG:
+      for(idx = 0; idx < n; ++idx)
+      {
+        val[idx] = (ptr[idx])? *(WlzLong *)(ptr[idx]): bkd;
+      }
+      break;
+    case WLZ_GREY_INT:
+      for(idx = 0; idx < n; ++idx)
+      {
+        val[idx] = (ptr[idx])? *(int *)(ptr[idx]): bkd;
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      for(idx = 0; idx < n; ++idx)
+      {
+        val[idx] = (ptr[idx])? *(short *)(ptr[idx]): bkd;
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      for(idx = 0; idx < n; ++idx)
+      {
+        val[idx] = (ptr[idx])? *(WlzUByte *)(ptr[idx]): bkd;
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      for(idx = 0; idx < n; ++idx)
+      {
+        val[idx] = (ptr[idx])? *(float *)(ptr[idx]): bkd;
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      for(idx = 0; idx < n; ++idx)
+      {
+        val[idx] = (ptr[idx])? *(double *)(ptr[idx]): bkd;
+      }
+      break;
+    case WLZ_GREY_RGBA:
+      for(idx = 0; idx < n; ++idx)
+      {
+        val[idx] = (ptr[idx])? *(WlzUInt *)(ptr[idx]): bkd;
+      }
+      break;
+    default:
+      for(idx = 0; idx < n; ++idx)
+      {
+        val[idx] = bkd;
+      }
+      break;
+  }
+}
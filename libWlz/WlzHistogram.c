@@ -834,7 +834,8 @@ WlzObject	*WlzHistogramObj(WlzObject *srcObj, int nBins,
 		  WlzValueSetInt(histDom2D->binValues.inp, 0,
 				 histDom2D->maxBins);
 		  if((errNum = WlzHistogramCompute2D(histDom2D, srcObj2D,
-		                                    planeIdx)) == WLZ_ERR_NONE)
+		  			srcObj->domain.p->plane1 + planeIdx))
+				        == WLZ_ERR_NONE)
 		  {
 		    WlzHistogramAddIntBins(histDom, histDom2D);
 		  }
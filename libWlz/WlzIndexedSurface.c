@@ -0,0 +1,690 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzIndexedSurface_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzIndexedSurface.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2012],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Indexed triangulated surfaces: flat arrays of vertex
+* 		positions, optional vertex normals and vertex indices
+* 		for each triangle. These are a compact alternative to
+* 		geometric models for surfaces which are only to be
+* 		rendered or written to a file.
+* \ingroup	WlzContour
+*/
+
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <Wlz.h>
+
+/*!
+* \struct	_WlzIndexedSurfaceKey
+* \ingroup	WlzContour
+* \brief	Quantised vertex position used to weld the vertices of
+*		a list of triangles by sorting.
+*		Typedef: ::WlzIndexedSurfaceKey.
+*/
+typedef struct _WlzIndexedSurfaceKey
+{
+  double	k[3];			/*!< Quantised position. */
+  int		idx;			/*!< Index of the vertex in the list
+  					     of triangles. */
+} WlzIndexedSurfaceKey;
+
+static int			WlzIndexedSurfaceKeyCmp(
+				  const void *cData,
+				  const void *p0,
+				  const void *p1);
+static int			WlzIndexedSurfaceRmDupFaces(
+				  int nFce,
+				  int *idx,
+				  WlzIndexedSurfaceKey *key,
+				  int *keep);
+
+/*!
+* \return	New indexed surface or NULL on error.
+* \ingroup	WlzContour
+* \brief	Makes a new indexed surface with space for the given
+* 		numbers of vertices and faces. The vertex positions,
+* 		normals and indices are not initialised.
+* \param	nVtx			Number of vertices.
+* \param	nFce			Number of faces (triangles).
+* \param	nrmFlg			Allocate vertex normals if non-zero.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzIndexedSurface *WlzMakeIndexedSurface(int nVtx, int nFce, int nrmFlg,
+					 WlzErrorNum *dstErr)
+{
+  WlzIndexedSurface *srf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((nVtx < 0) || (nFce < 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((srf = (WlzIndexedSurface *)
+                 AlcCalloc(1, sizeof(WlzIndexedSurface))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    srf->nVtx = nVtx;
+    srf->nFce = nFce;
+    if(((srf->vtx = (WlzDVertex3 *)
+                    AlcMalloc((nVtx + 1) * sizeof(WlzDVertex3))) == NULL) ||
+       (nrmFlg &&
+        ((srf->nrm = (WlzDVertex3 *)
+	             AlcMalloc((nVtx + 1) * sizeof(WlzDVertex3))) == NULL)) ||
+       ((srf->idx = (int *)AlcMalloc(((3 * nFce) + 1) * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+      (void )WlzFreeIndexedSurface(srf);
+      srf = NULL;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(srf);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzContour
+* \brief	Frees the given indexed surface.
+* \param	srf			Given indexed surface.
+*/
+WlzErrorNum	WlzFreeIndexedSurface(WlzIndexedSurface *srf)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(srf == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    AlcFree(srf->vtx);
+    AlcFree(srf->nrm);
+    AlcFree(srf->idx);
+    AlcFree(srf);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New indexed surface or NULL on error.
+* \ingroup	WlzContour
+* \brief	Makes an indexed surface from a list of triangles.
+* 		Vertices are welded by sorting their positions quantised
+* 		using WLZ_GM_TOLERANCE, rather than by hashing each vertex
+* 		in turn. The surface vertices are in the order in which
+* 		they are first used by the triangles and the triangles
+* 		keep their given order and orientation. As when
+* 		constructing a geometric model, triangles with an area
+* 		too small to be distinguished from zero are discarded,
+* 		as are triangles with the same vertices as an earlier
+* 		triangle.
+* \param	nTri			Number of triangles.
+* \param	pos			Triangle vertex positions, three for
+* 					each triangle.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzIndexedSurface *WlzIndexedSurfaceFromTriangles(int nTri, WlzDVertex3 *pos,
+						  WlzErrorNum *dstErr)
+{
+  int		idT,
+  		idV,
+		nPos,
+		nFce = 0,
+		nVtx = 0;
+  int		*grp = NULL,
+  		*idx = NULL;
+  WlzIndexedSurfaceKey *key = NULL;
+  WlzIndexedSurface *srf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nPos = 3 * nTri;
+  if(nTri < 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((nTri > 0) && (pos == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(((key = (WlzIndexedSurfaceKey *)
+                  AlcMalloc((nPos + 1) *
+		            sizeof(WlzIndexedSurfaceKey))) == NULL) ||
+          ((grp = (int *)AlcMalloc((nPos + 1) * sizeof(int))) == NULL) ||
+          ((idx = (int *)AlcMalloc((nPos + 1) * sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Sort the quantised positions, so that each group of matching
+     * vertices is contiguous and starts with its first use. */
+    for(idV = 0; idV < nPos; ++idV)
+    {
+      key[idV].k[0] = floor(pos[idV].vtX / WLZ_GM_TOLERANCE);
+      key[idV].k[1] = floor(pos[idV].vtY / WLZ_GM_TOLERANCE);
+      key[idV].k[2] = floor(pos[idV].vtZ / WLZ_GM_TOLERANCE);
+      key[idV].idx = idV;
+    }
+    AlgQSort(key, nPos, sizeof(WlzIndexedSurfaceKey), NULL,
+             WlzIndexedSurfaceKeyCmp);
+    for(idV = 0; idV < nPos; ++idV)
+    {
+      WlzIndexedSurfaceKey *k0,
+      		*k1;
+
+      k1 = key + idV;
+      k0 = (idV > 0)? k1 - 1: NULL;
+      grp[k1->idx] = ((k0 != NULL) &&
+		      (k0->k[0] == k1->k[0]) && (k0->k[1] == k1->k[1]) &&
+		      (k0->k[2] == k1->k[2]))? grp[k0->idx]: k1->idx;
+    }
+    /* Number the vertices in the order of their first use, using the
+     * key buffer as the table of vertex numbers. */
+    for(idV = 0; idV < nPos; ++idV)
+    {
+      key[idV].idx = -1;
+    }
+    for(idT = 0; idT < nTri; ++idT)
+    {
+      int	*tI;
+      WlzDVertex3 *tP;
+
+      tI = idx + (3 * nFce);
+      tP = pos + (3 * idT);
+      if(WlzGeomTriangleArea2Sq3(tP[0], tP[1], tP[2]) > WLZ_GM_TOLERANCE_SQ)
+      {
+	for(idV = 0; idV < 3; ++idV)
+	{
+	  int	g;
+
+	  g = grp[(3 * idT) + idV];
+	  if(key[g].idx < 0)
+	  {
+	    key[g].idx = nVtx++;
+	  }
+	  tI[idV] = key[g].idx;
+	}
+	if((tI[0] != tI[1]) && (tI[1] != tI[2]) && (tI[2] != tI[0]))
+	{
+	  ++nFce;
+	}
+      }
+    }
+    srf = WlzMakeIndexedSurface(nVtx, nFce, 0, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idV = 0; idV < nPos; ++idV)
+    {
+      if(key[idV].idx >= 0)
+      {
+        srf->vtx[key[idV].idx] = pos[idV];
+      }
+    }
+    (void )memcpy(srf->idx, idx, 3 * nFce * sizeof(int));
+    srf->nFce = WlzIndexedSurfaceRmDupFaces(nFce, srf->idx, key, grp);
+  }
+  AlcFree(key);
+  AlcFree(grp);
+  AlcFree(idx);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(srf);
+}
+
+/*!
+* \return	New indexed surface or NULL on error.
+* \ingroup	WlzContour
+* \brief	Makes an indexed surface from the vertices and faces of
+* 		the given 3D geometric model. Vertices and faces are in
+* 		the order of the model's resources and the vertex
+* 		normals of a WLZ_GMMOD_3N model are kept.
+* \param	model			Given 3D geometric model.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzIndexedSurface *WlzIndexedSurfaceFromGMModel(WlzGMModel *model,
+						WlzErrorNum *dstErr)
+{
+  WlzGMResIdxTb *resIdxTb = NULL;
+  WlzIndexedSurface *srf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(model == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    switch(model->type)
+    {
+      case WLZ_GMMOD_3I: /* FALLTHROUGH */
+      case WLZ_GMMOD_3D: /* FALLTHROUGH */
+      case WLZ_GMMOD_3N:
+        break;
+      default:
+        errNum = WLZ_ERR_DOMAIN_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    resIdxTb = WlzGMModelResIdx(model, WLZ_GMELMFLG_VERTEX, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    srf = WlzMakeIndexedSurface(resIdxTb->vertex.idxCnt,
+    				model->res.face.numElm,
+				model->type == WLZ_GMMOD_3N, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idV,
+    		cnt = 0;
+    AlcVector	*vec;
+
+    vec = model->res.vertex.vec;
+    for(idV = 0; idV < model->res.vertex.numIdx; ++idV)
+    {
+      WlzGMVertex *vtx;
+
+      vtx = (WlzGMVertex *)AlcVectorItemGet(vec, idV);
+      if(vtx->idx >= 0)
+      {
+        if(srf->nrm)
+	{
+	  (void )WlzGMVertexGetG3N(vtx, srf->vtx + cnt, srf->nrm + cnt);
+	}
+	else
+	{
+	  (void )WlzGMVertexGetG3D(vtx, srf->vtx + cnt);
+	}
+	++cnt;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idF,
+    		cnt = 0;
+    int		*lut;
+    AlcVector	*vec;
+
+    vec = model->res.face.vec;
+    lut = resIdxTb->vertex.idxLut;
+    for(idF = 0; (cnt < srf->nFce) && (idF < model->res.face.numIdx); ++idF)
+    {
+      WlzGMFace	*fce;
+
+      fce = (WlzGMFace *)AlcVectorItemGet(vec, idF);
+      if(fce->idx >= 0)
+      {
+        int	*tI;
+        WlzGMEdgeT *tET;
+
+	tI = srf->idx + (3 * cnt++);
+	tET = fce->loopT->edgeT;
+	tI[0] = *(lut + tET->vertexT->diskT->vertex->idx);
+	tI[1] = *(lut + tET->next->vertexT->diskT->vertex->idx);
+	tI[2] = *(lut + tET->prev->vertexT->diskT->vertex->idx);
+      }
+    }
+  }
+  WlzGMModelResIdxFree(resIdxTb);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(srf);
+}
+
+/*!
+* \return	New geometric model or NULL on error.
+* \ingroup	WlzContour
+* \brief	Makes a 3D geometric model from the given indexed surface.
+* 		The model is a WLZ_GMMOD_3N model if the surface has vertex
+* 		normals, otherwise it is a WLZ_GMMOD_3D model.
+* \param	srf			Given indexed surface.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzGMModel	*WlzIndexedSurfaceToGMModel(WlzIndexedSurface *srf,
+					    WlzErrorNum *dstErr)
+{
+  WlzGMModel	*model = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(srf == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    int		vHTSz;
+
+    vHTSz = srf->nVtx / 8;
+    if(vHTSz < 1024)
+    {
+      vHTSz = 1024;
+    }
+    model = WlzGMModelNew((srf->nrm)? WLZ_GMMOD_3N: WLZ_GMMOD_3D, 0, vHTSz,
+    			  &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idF;
+    WlzDVertex3	pos[3],
+    		nrm[3];
+
+    for(idF = 0; idF < srf->nFce; ++idF)
+    {
+      int	idV;
+      int	*tI;
+
+      tI = srf->idx + (3 * idF);
+      for(idV = 0; idV < 3; ++idV)
+      {
+        if((tI[idV] < 0) || (tI[idV] >= srf->nVtx))
+	{
+	  errNum = WLZ_ERR_DOMAIN_DATA;
+	  break;
+	}
+	pos[idV] = srf->vtx[tI[idV]];
+	if(srf->nrm)
+	{
+	  nrm[idV] = srf->nrm[tI[idV]];
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzGMModelConstructSimplex3N(model, pos,
+					      (srf->nrm)? nrm: NULL);
+      }
+      if(errNum != WLZ_ERR_NONE)
+      {
+        break;
+      }
+    }
+  }
+  if((errNum != WLZ_ERR_NONE) && (model != NULL))
+  {
+    (void )WlzGMModelFree(model);
+    model = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(model);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzContour
+* \brief	Sets the vertex normals of the given indexed surface to
+* 		the normalised sum of the normals of the faces which use
+* 		each vertex, with each face normal weighted by the face's
+* 		area. Normals are allocated if the surface has none.
+* \param	srf			Given indexed surface.
+*/
+WlzErrorNum	WlzIndexedSurfaceSetNormals(WlzIndexedSurface *srf)
+{
+  int		idF,
+  		idV;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(srf == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((srf->nrm == NULL) &&
+          ((srf->nrm = (WlzDVertex3 *)
+	               AlcMalloc((srf->nVtx + 1) *
+		                 sizeof(WlzDVertex3))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idV = 0; idV < srf->nVtx; ++idV)
+    {
+      WLZ_VTX_3_ZERO(srf->nrm[idV]);
+    }
+    for(idF = 0; idF < srf->nFce; ++idF)
+    {
+      int	*tI;
+      WlzDVertex3 d0,
+      		d1,
+		n;
+
+      tI = srf->idx + (3 * idF);
+      if((tI[0] < 0) || (tI[0] >= srf->nVtx) ||
+         (tI[1] < 0) || (tI[1] >= srf->nVtx) ||
+         (tI[2] < 0) || (tI[2] >= srf->nVtx))
+      {
+        errNum = WLZ_ERR_DOMAIN_DATA;
+	break;
+      }
+      /* The cross product has length twice the area of the face. */
+      WLZ_VTX_3_SUB(d0, srf->vtx[tI[1]], srf->vtx[tI[0]]);
+      WLZ_VTX_3_SUB(d1, srf->vtx[tI[2]], srf->vtx[tI[0]]);
+      WLZ_VTX_3_CROSS(n, d0, d1);
+      for(idV = 0; idV < 3; ++idV)
+      {
+        WLZ_VTX_3_ADD(srf->nrm[tI[idV]], srf->nrm[tI[idV]], n);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idV = 0; idV < srf->nVtx; ++idV)
+    {
+      double	len;
+
+      len = WLZ_VTX_3_LENGTH(srf->nrm[idV]);
+      if(len > DBL_EPSILON)
+      {
+        WLZ_VTX_3_SCALE(srf->nrm[idV], srf->nrm[idV], 1.0 / len);
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzContour
+* \brief	Scales the vertex positions of the given indexed surface,
+* 		for example by the voxel size of the object from which the
+* 		surface was computed. Normals are rescaled to unit length.
+* \param	srf			Given indexed surface.
+* \param	scale			Scale factors for each direction.
+*/
+WlzErrorNum	WlzIndexedSurfaceScale(WlzIndexedSurface *srf,
+				       WlzDVertex3 scale)
+{
+  int		idV;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(srf == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    for(idV = 0; idV < srf->nVtx; ++idV)
+    {
+      srf->vtx[idV].vtX *= scale.vtX;
+      srf->vtx[idV].vtY *= scale.vtY;
+      srf->vtx[idV].vtZ *= scale.vtZ;
+    }
+    if(srf->nrm &&
+       ((scale.vtX != scale.vtY) || (scale.vtY != scale.vtZ)))
+    {
+      /* Normals transform by the inverse transpose, which for a
+       * scaling is the reciprocal scaling. */
+      for(idV = 0; idV < srf->nVtx; ++idV)
+      {
+        double	len;
+	WlzDVertex3 *n;
+
+	n = srf->nrm + idV;
+	n->vtX /= scale.vtX;
+	n->vtY /= scale.vtY;
+	n->vtZ /= scale.vtZ;
+	len = WLZ_VTX_3_LENGTH(*n);
+	if(len > DBL_EPSILON)
+	{
+	  WLZ_VTX_3_SCALE(*n, *n, 1.0 / len);
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Sort order: -ve, 0 or +ve.
+* \ingroup	WlzContour
+* \brief	Compares quantised vertex positions for AlgQSort(), with
+* 		equal positions ordered by their index.
+* \param	cData			Unused client data.
+* \param	p0			First key.
+* \param	p1			Second key.
+*/
+static int	WlzIndexedSurfaceKeyCmp(const void *cData,
+					const void *p0, const void *p1)
+{
+  int		idx,
+  		cmp = 0;
+  const WlzIndexedSurfaceKey *k0,
+  		*k1;
+
+  k0 = (const WlzIndexedSurfaceKey *)p0;
+  k1 = (const WlzIndexedSurfaceKey *)p1;
+  for(idx = 0; (cmp == 0) && (idx < 3); ++idx)
+  {
+    cmp = (k0->k[idx] < k1->k[idx])? -1: (k0->k[idx] > k1->k[idx]);
+  }
+  if(cmp == 0)
+  {
+    cmp = k0->idx - k1->idx;
+  }
+  return(cmp);
+}
+
+/*!
+* \return	Number of faces remaining.
+* \ingroup	WlzContour
+* \brief	Removes faces which have the same vertices (in any order)
+* 		as an earlier face, keeping the order of the remaining
+* 		faces. Duplicates are found by sorting the faces using
+* 		their sorted vertex indices.
+* \param	nFce			Number of faces.
+* \param	idx			Face vertex indices, three per face.
+* \param	key			Work buffer for at least nFce keys.
+* \param	keep			Work buffer for at least nFce ints.
+*/
+static int	WlzIndexedSurfaceRmDupFaces(int nFce, int *idx,
+					    WlzIndexedSurfaceKey *key,
+					    int *keep)
+{
+  int		idF,
+  		cnt = 0;
+
+  for(idF = 0; idF < nFce; ++idF)
+  {
+    int		t,
+    		i0,
+		i1,
+		i2;
+
+    i0 = idx[3 * idF];
+    i1 = idx[3 * idF + 1];
+    i2 = idx[3 * idF + 2];
+    if(i0 > i1)
+    {
+      t = i0; i0 = i1; i1 = t;
+    }
+    if(i1 > i2)
+    {
+      t = i1; i1 = i2; i2 = t;
+    }
+    if(i0 > i1)
+    {
+      t = i0; i0 = i1; i1 = t;
+    }
+    key[idF].k[0] = i0;
+    key[idF].k[1] = i1;
+    key[idF].k[2] = i2;
+    key[idF].idx = idF;
+  }
+  AlgQSort(key, nFce, sizeof(WlzIndexedSurfaceKey), NULL,
+	   WlzIndexedSurfaceKeyCmp);
+  for(idF = 0; idF < nFce; ++idF)
+  {
+    WlzIndexedSurfaceKey *k0,
+    		*k1;
+
+    k1 = key + idF;
+    k0 = (idF > 0)? k1 - 1: NULL;
+    keep[k1->idx] = (k0 == NULL) ||
+		    (k0->k[0] != k1->k[0]) || (k0->k[1] != k1->k[1]) ||
+		    (k0->k[2] != k1->k[2]);
+  }
+  for(idF = 0; idF < nFce; ++idF)
+  {
+    if(keep[idF])
+    {
+      if(cnt != idF)
+      {
+	idx[3 * cnt] = idx[3 * idF];
+	idx[3 * cnt + 1] = idx[3 * idF + 1];
+	idx[3 * cnt + 2] = idx[3 * idF + 2];
+      }
+      ++cnt;
+    }
+  }
+  return(cnt);
+}
@@ -494,6 +494,11 @@ static WlzErrorNum WlzIterateDomObj3D(WlzIterateWSpace *itWSp)
 	  }
 	  pIdx += pInc;
 	}
+	if((pIdx < 0) || (pIdx >= pCnt))
+	{
+	  /* The remaining planes are all empty. */
+	  errNum = WLZ_ERR_EOO;
+	}
 	itWSp->itvPos = 0;
 	itWSp->plnRmn = (pInc > 0)? pCnt - itWSp->plnIdx: itWSp->plnIdx + 1;
       }
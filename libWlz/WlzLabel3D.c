@@ -35,22 +35,118 @@ static char _WlzLabel3D_c[] = "University of Edinburgh $Id$";
 * License along with this program; if not, write to the Free
 * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
 * Boston, MA  02110-1301, USA.
-* \brief	3D labeling (segmention).
+* \brief	3D labeling (segmention) using the interval runs of the
+* 		domain and a concurrent union find tree.
 * \ingroup	WlzBinaryOps
 */
 
+
+#include <limits.h>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
 #include <Wlz.h>
 
+/*!
+* \struct	_WlzLabel3DRun
+* \ingroup	WlzBinaryOps
+* \brief	An interval run within a plane using absolute coordinates.
+*/
+typedef struct _WlzLabel3DRun
+{
+  int		ln;		/*!< Line of the run. */
+  int		lKol;		/*!< First column of the run. */
+  int		rKol;		/*!< Last column of the run. */
+} WlzLabel3DRun;
+
+/*!
+* \struct	_WlzLabel3DRuns
+* \ingroup	WlzBinaryOps
+* \brief	All of the interval runs of a plane domain in raster order,
+* 		indexed by plane and then by line within the plane.
+*/
+typedef struct _WlzLabel3DRuns
+{
+  int		nPln;		/*!< Number of planes. */
+  int		nRun;		/*!< Total number of runs. */
+  int		maxPlnRun;	/*!< Maximum number of runs in any plane. */
+  int		*plnRunOff;	/*!< Index of the first run in each plane,
+  				     nPln + 1 entries. */
+  int		*plnLnOff;	/*!< Index into lnRunOff of the first line
+  				     of each plane, nPln + 1 entries. */
+  int		*plnLn1;	/*!< First line of each plane. */
+  int		*plnNLn;	/*!< Number of lines in each plane. */
+  int		*lnRunOff;	/*!< Index of the first run on each line of
+  				     each plane, with an extra entry after
+				     the last line of each plane. */
+  WlzLabel3DRun	*run;		/*!< The runs. */
+} WlzLabel3DRuns;
+
+static void			WlzLabel3DRunsFree(
+				  WlzLabel3DRuns *rs);
+static void			WlzLabel3DUnionLines(
+				  AlcUFTree *uft,
+				  WlzLabel3DRuns *rs,
+				  int p,
+				  int l,
+				  int q,
+				  int m,
+				  int d,
+				  const char *ign);
+static void			WlzLabel3DUnionPlane(
+				  AlcUFTree *uft,
+				  WlzLabel3DRuns *rs,
+				  int p,
+				  int d);
+static void			WlzLabel3DUnionPlanes(
+				  AlcUFTree *uft,
+				  WlzLabel3DRuns *rs,
+				  int p,
+				  int d,
+				  const char *ign);
+static WlzErrorNum		WlzLabel3DFragments(
+				  AlcUFTree *uft,
+				  WlzLabel3DRuns *rs,
+				  int p,
+				  int maxObj,
+				  int ignLn,
+				  char *ign,
+				  int *wSp);
+static WlzErrorNum		WlzLabel3DPlaneDomains(
+				  WlzLabel3DRuns *rs,
+				  int p,
+				  int plane1,
+				  const int *lbl,
+				  WlzCompoundArray *objs,
+				  int *wSp);
+static WlzLabel3DRuns		*WlzLabel3DRunsMake(
+				  WlzPlaneDomain *pDom,
+				  WlzErrorNum *dstErr);
+
 /*!
 * \return	A compund array object containing the labeled object
 * 		components of the given object.
 * \ingroup	WlzBinaryOps
 * \brief	Labels (segments) a 3D domain object into connected component
-* 		objects using their connectivity. 
+* 		objects using their connectivity.
+*
+* 		The labeling works directly on the interval runs of the
+* 		given domain. Runs are first joined within each plane
+* 		(in parallel over the planes) using 4-connectivity for
+* 		6-connected labeling and 8-connectivity otherwise, which
+* 		gives the 2D fragments used to apply the maxObj and ignLn
+* 		constraints. The runs of adjacent planes are then joined,
+* 		in parallel over slabs of planes and then across the slab
+* 		boundaries. Runs are connected between planes if they
+* 		overlap for 6-connected labeling, otherwise if they overlap
+* 		when dilated by a 3x3 square. All joins are made using a
+* 		concurrent union find tree, so the time taken is close to
+* 		linear in the number of runs.
+*
+* 		The labeled objects are ordered by the position of their
+* 		first interval in raster (plane, line, column) order. They
+* 		share the values of the given object (if it has values).
 * \param	gObj		Given object to be labeled.
 * \param	maxObj		Maximum number of objects to be found in any
 * 				plane.
@@ -66,30 +162,19 @@ WlzObject			*WlzLabel3D(
 				  WlzConnectType con,
 				  WlzErrorNum *dstErr)
 {
-  int		nPln,		/* Number of planes in the input object. */
-  		nObjs = 0,	/* Number of 3D objects found by labeling. */
-		totNFrg = 0,	/* Total number of 2D fragment objects found
-				 * by labeling the planes. */
-		maxFrgPln = 0;  /* Maximum number of 2D fragment objects in
-				 * any plane. */
-  size_t	objBufSz = 0;
+  int		nThr = 1,
+		nObj = 0,	/* Number of 3D objects found by labeling. */
+  		d2 = 0,		/* Column tolerance within planes. */
+		d3 = 0;		/* Column and line tolerance between planes. */
+  int		*lbl = NULL,	/* Labeled object index of each run. */
+  		*bBox = NULL,	/* Plane, line and column bounding box of each
+				 * labeled object. */
+		*wSp = NULL;	/* Per thread workspace. */
+  char		*ign = NULL;	/* Non-zero for runs of ignored fragments. */
+  size_t	wSpSz = 0;
+  AlcUFTree	*uft = NULL;	/* Union-find tree for the runs. */
+  WlzLabel3DRuns *rs = NULL;
   WlzObject	*lObj = NULL;	/* The return compound object. */
-  WlzConnectType con2 = WLZ_0_CONNECTED,
-  		 con3 = WLZ_0_CONNECTED;
-  AlcUFTree	*uft = NULL;	/* Union-find tree for grouping the framents
-  				 * into 3D objects. */
-  WlzObject	**frgObjBuf = NULL; /* Buffer big enough for all the fragment
-  				     * objects of any single plane for each
-				     * thread. */
-  WlzObject	***frgTbl = NULL; /* Objects in each plane, indexed by plane
-  				   * then fragment within plane. */
-  int		*nFrgTbl = NULL, /* Table of the number of fragments per plane,
-  				  * indexed by plane. */
-		*cNFrgTbl = NULL, /* Cumulative version of nFrgTbl, simplifies
-			           * OpenMP code. */
-  		*frgToObjTb = NULL; /* Look up table from fragment index to
-				       3D labeled object index. */
-  WlzPixelV	bgdV;
   WlzCompoundArray *objs = NULL;
   WlzValues	nulVal;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -122,82 +207,76 @@ WlzObject			*WlzLabel3D(
     {
       case WLZ_4_CONNECTED:  /* FALLTHROUGH */
       case WLZ_6_CONNECTED:
-        con2 = WLZ_4_CONNECTED;
-        con3 = WLZ_0_CONNECTED;
+        d2 = 0;
+	d3 = 0;
 	break;
       case WLZ_8_CONNECTED:  /* FALLTHROUGH */
       case WLZ_18_CONNECTED: /* FALLTHROUGH */
       case WLZ_26_CONNECTED:
-        con2 = WLZ_8_CONNECTED;
-        con3 = WLZ_8_CONNECTED;
+        d2 = 1;
+	d3 = 1;
 	break;
       default:
         errNum = WLZ_ERR_PARAM_DATA;
 	break;
     }
   }
-  /* Create a fragment objects table. */
+  /* Collect the interval runs of all planes. */
   if(errNum == WLZ_ERR_NONE)
   {
-    nPln = gObj->domain.p->lastpl - gObj->domain.p->plane1 + 1;
-    if(((frgTbl = (WlzObject ***)
-                  AlcCalloc(nPln, sizeof(WlzObject **))) == NULL) ||
-       ((nFrgTbl = (int *)AlcCalloc(nPln, sizeof(int))) == NULL) ||
-       ((cNFrgTbl = (int *)AlcCalloc(nPln, sizeof(int))) == NULL))
+    rs = WlzLabel3DRunsMake(gObj->domain.p, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel
     {
-      errNum = WLZ_ERR_MEM_ALLOC;
+#pragma omp master
+      {
+        nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    if(rs->nRun < 1)
+    {
+      /* No fragments but given a domain object. */
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+    else
+    {
+      wSpSz = 4 * rs->maxPlnRun;
+      if(((uft = AlcUFTreeNew(rs->nRun, rs->nRun)) == NULL) ||
+         ((wSp = (int *)AlcMalloc(nThr * wSpSz * sizeof(int))) == NULL) ||
+	 ((ignLn > 0) && ((ign = (char *)AlcCalloc(rs->nRun, 1)) == NULL)))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
     }
   }
-  /* Label each plane populating the fragment objects table. */
+  /* Join the runs within each plane to form the 2D fragments, then
+   * check the number of fragments in the plane and mark the runs of
+   * any ignored fragments. */
   if(errNum == WLZ_ERR_NONE)
   {
     int		p;
-    WlzDomain	*doms;
 
-    doms = gObj->domain.p->domains;
 #ifdef _OPENMP
-#pragma omp parallel for shared(nFrgTbl,frgTbl,doms,nulVal,maxObj,ignLn,con2)
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
 #endif
-    for(p = 0; p < nPln; ++p)
+    for(p = 0; p < rs->nPln; ++p)
     {
       if(errNum == WLZ_ERR_NONE)
       {
-        WlzDomain	dom2;
-	WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+	int	thrId = 0;
+	WlzErrorNum errNum2;
 
-	dom2 = doms[p];
-	if(dom2.core != NULL)
-	{
-	  WlzObject	*obj2;
-
-	  obj2 = WlzAssignObject(
-	         WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, nulVal,
-		 	     NULL, NULL, &errNum2), NULL);
-	  if(obj2)
-	  {
-	    int		nFrg = 0;
-	    WlzObject	**frgObj = NULL;
-
-	    errNum2 = WlzLabel(obj2, &nFrg, &frgObj, maxObj, ignLn, con2);
-	    WlzFreeObj(obj2);
-	    if(errNum2 == WLZ_ERR_NONE)
-	    {
-	      if(frgObj != NULL)
-	      {
-	        if(nFrg > 0)
-		{
-		  nFrgTbl[p] = nFrg;
-		  frgTbl[p] = frgObj;
-	        }
-		else
-		{
-		  AlcFree(frgObj);
-		}
-	      }
-	    }
-	  }
-	}
-	if(errNum2 == WLZ_ERR_NONE)
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	WlzLabel3DUnionPlane(uft, rs, p, d2);
+	errNum2 = WlzLabel3DFragments(uft, rs, p, maxObj, ignLn, ign,
+				      wSp + thrId * wSpSz);
+	if(errNum2 != WLZ_ERR_NONE)
 	{
 #ifdef _OPENMP
 #pragma omp critical (WlzLabel3D)
@@ -214,307 +293,241 @@ WlzObject			*WlzLabel3D(
       }
     }
   }
+  /* Join the runs of adjacent planes. Each thread works on it's own slab
+   * of planes so the threads don't contend for the same nodes of the
+   * union find tree, then the slab boundaries are joined. */
   if(errNum == WLZ_ERR_NONE)
   {
-    int		p;
+    int		s,
+    		nSlb;
 
-    for(p = 0; p < nPln; ++p)
+    nSlb = ALG_MIN(nThr, rs->nPln);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr)
+#endif
+    for(s = 0; s < nSlb; ++s)
     {
-      int	nFrg;
+      int	p,
+		p0,
+		p1;
 
-      nFrg = nFrgTbl[p];
-      cNFrgTbl[p] = totNFrg;
-      if(nFrg > maxFrgPln)
+      p0 = (int )(((long )(s) * rs->nPln) / nSlb);
+      p1 = (int )(((long )(s + 1) * rs->nPln) / nSlb);
+      for(p = p0 + 1; p < p1; ++p)
       {
-	maxFrgPln = nFrg;
+	WlzLabel3DUnionPlanes(uft, rs, p, d3, ign);
       }
-      totNFrg += nFrg;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr)
+#endif
+    for(s = 1; s < nSlb; ++s)
+    {
+      WlzLabel3DUnionPlanes(uft, rs, (int )(((long )(s) * rs->nPln) / nSlb),
+			    d3, ign);
     }
   }
-  if(errNum == WLZ_ERR_NONE) 
+  /* The root of each component is it's first run in raster order, so
+   * number the components in the order of their roots. */
+  if(errNum == WLZ_ERR_NONE)
   {
-    if(totNFrg < 1)
+    if((lbl = (int *)AlcMalloc(rs->nRun * sizeof(int))) == NULL)
     {
-      /* No fragments but given a domain object. */
-      errNum = WLZ_ERR_DOMAIN_DATA;
+      errNum = WLZ_ERR_MEM_ALLOC;
     }
-    else if(totNFrg == 1)
+    else
     {
-      /* Just have a single fragment so no need for complex connectivity
-       * code, just make a compound object with the single fragment. */
-      int	p;
-      WlzObject	*obj2 = NULL;
-      WlzDomain dom;
+      int	r;
 
-      for(p = 0; p < nPln; ++p)
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr)
+#endif
+      for(r = 0; r < rs->nRun; ++r)
+      {
+        lbl[r] = (ign && ign[r])? -1: AlcUFTreeConcFind(uft, r);
+      }
+      for(r = 0; r < rs->nRun; ++r)
       {
-	if(nFrgTbl[p])
+	if(lbl[r] >= 0)
 	{
-	  obj2 = *(frgTbl[p]);
-	  break;
+	  lbl[r] = (lbl[r] == r)? nObj++: lbl[lbl[r]];
 	}
       }
-      dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
-				 gObj->domain.p->plane1 + p,
-				 gObj->domain.p->lastpl + p,
-				 obj2->domain.i->line1,
-				 obj2->domain.i->lastln,
-				 obj2->domain.i->kol1,
-				 obj2->domain.i->lastkl,
-				 &errNum);
-      objs = WlzMakeCompoundArray(WLZ_COMPOUND_ARR_1, 1, 1, NULL,
-				  WLZ_3D_DOMAINOBJ, &errNum);
-      if(errNum == WLZ_ERR_NONE)
+      if(nObj < 1)
       {
-        objs->n = 1;
-	objs->o[0] = WlzAssignObject(
-		     WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, nulVal, NULL, NULL,
-				 &errNum), NULL);
+	errNum = WLZ_ERR_DOMAIN_DATA;
       }
     }
+  }
+  AlcUFTreeFree(uft);
+  AlcFree(ign);
+  /* Find the bounding box of each of the labeled objects. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((bBox = (int *)AlcMalloc(6 * nObj * sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
     else
     {
-      /* Have many fragments and so need to establish their connectivity. */
-      /* Create a find-union tree for all the fragment objects. */
-      if(errNum == WLZ_ERR_NONE)
+      int	i,
+      		p;
+
+      for(i = 0; i < nObj; ++i)
       {
-	if((uft = AlcUFTreeNew(totNFrg, totNFrg)) == NULL)
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
+        bBox[6 * i] = INT_MAX;
       }
-      /* Walk down through the planes checking for conectivity between
-       * the fragments of the current plane and the previous plane updating
-       * the union-find tree to build the connectivity. */
-      if(errNum == WLZ_ERR_NONE)
+      for(p = 0; p < rs->nPln; ++p)
       {
-	int		p;		/* Current plane */
+	int	r;
 
-#ifdef _OPENMP
-#pragma omp parallel for shared(nFrgTbl,cNFrgTbl,con3,uft)
-#endif
-	for(p = 1; p < nPln; ++p)
+	for(r = rs->plnRunOff[p]; r < rs->plnRunOff[p + 1]; ++r)
 	{
-
-	  if(errNum == WLZ_ERR_NONE)
+	  if(lbl[r] >= 0)
 	  {
-	    int	q,		/* Previous plane. */
-		    nFrgP,	/* Number of fgragment objects on plane p */
-		    nFrgQ; 	/* Number of fgragment objects on plane q */
-	    WlzErrorNum errNum2 = WLZ_ERR_NONE;
-
-	    q = p - 1;
-	    nFrgP = nFrgTbl[p];
-	    nFrgQ = nFrgTbl[q];
-	    if((nFrgP > 0) && (nFrgQ > 0))
-	    {
-	      int	  fP;	/* Fragment within the current plane p */
-	      WlzObject **frgP,	/* Array of fragment objects on plane p */
-			**frgQ;	/* Array of fragment objects on plane q */
+	    int	*b;
+	    WlzLabel3DRun *run;
 
-	      frgP = frgTbl[p];
-	      frgQ = frgTbl[q];
-	      for(fP = 0; (errNum2 == WLZ_ERR_NONE) && (fP < nFrgP); ++fP)
-	      {
-		int	fQ;
-		WlzObject *fObjP;
-
-		if(con3 == WLZ_0_CONNECTED)
-		{
-		  fObjP = WlzAssignObject(frgP[fP], NULL);
-		}
-		else
-		{
-		  fObjP = WlzDilation(frgP[fP], con3, &errNum2);
-		}
-		if((fObjP != NULL) &&
-		   (fObjP->type == WLZ_2D_DOMAINOBJ) &&
-		   (fObjP->domain.core != NULL))
-		{
-		  for(fQ = 0; (errNum2 == WLZ_ERR_NONE) && (fQ < nFrgQ); ++fQ)
-		  {
-		    WlzObject *fObjQ;
-
-		     fObjQ = frgQ[fQ];
-		    /* Avoid calling WlzHasIntersection() if possible, saves
-		     * a significant amount of CPU time. */
-		    if((fObjQ != NULL) &&
-		       (fObjQ->type == WLZ_2D_DOMAINOBJ) &&
-		       (fObjQ->domain.core != NULL) &&
-		       (fObjP->domain.i->kol1 < fObjQ->domain.i->lastkl) &&
-		       (fObjQ->domain.i->kol1 < fObjP->domain.i->lastkl) &&
-		       (fObjP->domain.i->line1 < fObjQ->domain.i->lastln) &&
-		       (fObjQ->domain.i->line1 < fObjP->domain.i->lastln) &&
-		       WlzHasIntersection(fObjQ, fObjP, &errNum2))
-		    {
-#ifdef _OPENMP
-#pragma omp critical (WlzLabel3D)
-		      {
-#endif
-			AlcUFTreeUnion(uft, cNFrgTbl[q] + fQ, cNFrgTbl[p] + fP);
-#ifdef _OPENMP
-		      }
-#endif
-		    }
-		  }
-		}
-		(void )WlzFreeObj(fObjP);
-	      }
+	    run = rs->run + r;
+	    b = bBox + 6 * lbl[r];
+	    if(b[0] == INT_MAX)
+	    {
+	      b[0] = b[1] = p;
+	      b[2] = b[3] = run->ln;
+	      b[4] = run->lKol;
+	      b[5] = run->rKol;
 	    }
-	    if(errNum2 != WLZ_ERR_NONE)
+	    else
 	    {
-#ifdef _OPENMP
-#pragma omp critical (WlzLabel3D)
+	      b[1] = p;
+	      if(run->ln < b[2])
 	      {
-		if(errNum == WLZ_ERR_NONE)
-		{
-		  errNum = errNum2;
-		}
+		b[2] = run->ln;
+	      }
+	      else if(run->ln > b[3])
+	      {
+		b[3] = run->ln;
+	      }
+	      if(run->lKol < b[4])
+	      {
+		b[4] = run->lKol;
+	      }
+	      if(run->rKol > b[5])
+	      {
+		b[5] = run->rKol;
 	      }
-#else
-	      errNum = errNum2;
-#endif
 	    }
 	  }
 	}
       }
-      /* The union-find tree now holds the connectivity of all the fragments.
-       * Create a simple table which maps the fragment index to the 3D labeled
-       * object index. */
-      if(errNum == WLZ_ERR_NONE)
-      {
-	nObjs = uft->nCmp;
-	if((frgToObjTb = (int *)AlcMalloc(totNFrg * sizeof(int))) == NULL)
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	else
-	{
-	  int	f,
-		    o = 0;
+    }
+  }
+  /* Create the labeled objects with empty plane domains. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    objs = WlzMakeCompoundArray(WLZ_COMPOUND_ARR_1, 1, nObj, NULL,
+				WLZ_3D_DOMAINOBJ, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		i,
+    		plane1;
+    WlzPlaneDomain *gPDom;
 
-	  /* First create mapping from the union-find tree components to 3D
-	   * labeled object index. */
-	  for(f = 0; f < totNFrg; ++f)
-	  {
-	    if(uft->pr[f] == f)
-	    {
-	      frgToObjTb[f] = o++;
-	    }
-	  }
-	  /* Now assign the 3D labeled object index to each fragment. */
-	  for(f = 0; f < totNFrg; ++f)
-	  {
-	    frgToObjTb[f] = frgToObjTb[AlcUFTreeFind(uft, f)];
-	  }
-	}
-      }
-      /* Finished with the union-find tree so free it. */
-      AlcUFTreeFree(uft);
-      /* Create a buffer large enough to hold all fragments on any plane (for
-       * each thread if using OpenMP) and a compound array object for the
-       * labeled 3D objects initialise them with the bounding box of the given
-       * object. The plane domains will be fixed later. */
+    gPDom = gObj->domain.p;
+    plane1 = gPDom->plane1;
+    for(i = 0; (errNum == WLZ_ERR_NONE) && (i < nObj); ++i)
+    {
+      int	*b;
+      WlzDomain dom;
+
+      b = bBox + 6 * i;
+      dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+				 plane1 + b[0], plane1 + b[1],
+				 b[2], b[3], b[4], b[5], &errNum);
       if(errNum == WLZ_ERR_NONE)
       {
-	objBufSz = maxFrgPln * sizeof(WlzObject *);
-	if((frgObjBuf = (WlzObject **)AlcMalloc(objBufSz)) == NULL)
+	dom.p->voxel_size[0] = gPDom->voxel_size[0];
+	dom.p->voxel_size[1] = gPDom->voxel_size[1];
+	dom.p->voxel_size[2] = gPDom->voxel_size[2];
+	objs->o[i] = WlzAssignObject(
+		     WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, nulVal, NULL, NULL,
+				 &errNum), NULL);
+	if(errNum != WLZ_ERR_NONE)
 	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
+	  (void )WlzFreePlaneDomain(dom.p);
 	}
       }
-      if(errNum == WLZ_ERR_NONE)
-      {
-	objs = WlzMakeCompoundArray(WLZ_COMPOUND_ARR_1, 1, nObjs, NULL,
-				    WLZ_3D_DOMAINOBJ, &errNum);
-      }
-      if(errNum == WLZ_ERR_NONE)
+    }
+  }
+  AlcFree(bBox);
+  /* Build the interval domains of the labeled objects in each plane. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    AlcFree(wSp);
+    wSpSz = nObj + 3 * rs->maxPlnRun + 1;
+    if((wSp = (int *)AlcMalloc(nThr * wSpSz * sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	i,
+      		p;
+
+      for(i = 0; i < nThr; ++i)
       {
-	int		i;
+	int	j;
+	int	*slot;
 
-	for(i = 0; (errNum == WLZ_ERR_NONE) && (i < nObjs); ++i)
+	slot = wSp + i * wSpSz;
+	for(j = 0; j < nObj; ++j)
 	{
-	  WlzDomain dom;
-
-	  dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
-				     gObj->domain.p->plane1,
-				     gObj->domain.p->lastpl,
-				     gObj->domain.p->line1,
-				     gObj->domain.p->lastln,
-				     gObj->domain.p->kol1,
-				     gObj->domain.p->lastkl,
-				     &errNum);
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    objs->o[i] = WlzAssignObject(
-			 WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, nulVal, NULL, NULL,
-				     &errNum), NULL);
-	  }
+	  slot[j] = -1;
 	}
       }
-      /* Use the fragment to object index table to allocate the fragments
-       * within each plane to the appropriate object.*/
-      if(errNum == WLZ_ERR_NONE)
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
+#endif
+      for(p = 0; p < rs->nPln; ++p)
       {
-	int		p;		/* Current plane */
-
-	for(p = 0; (errNum == WLZ_ERR_NONE) && (p < nPln); ++p)
+	if(errNum == WLZ_ERR_NONE)
 	{
-	  int	fP,		/* Fragment within current plane p */
-		  nFrgP,
-		  frgIdxP; 	/* Index of the first fragment on plane p */
-	  WlzObject **frgP;
-
-	  frgP = frgTbl[p];
-	  nFrgP = nFrgTbl[p];
-	  frgIdxP = cNFrgTbl[p];
-	  for(fP = 0; (errNum == WLZ_ERR_NONE) && (fP < nFrgP); ++fP)
+	  int	thrId = 0;
+	  WlzErrorNum errNum2;
+
+#ifdef _OPENMP
+	  thrId = omp_get_thread_num();
+#endif
+	  errNum2 = WlzLabel3DPlaneDomains(rs, p, gObj->domain.p->plane1,
+	                                   lbl, objs, wSp + thrId * wSpSz);
+	  if(errNum2 != WLZ_ERR_NONE)
 	  {
-	    if(frgP[fP])
+#ifdef _OPENMP
+#pragma omp critical (WlzLabel3D)
 	    {
-	      /* Put all fragments on this plane which are part of the same
-	       * labeled 3D object into a buffer. Form their union and the
-	       * add the domain to the 3D object. */
-	      int	  fP1,
-		    objIdx,
-		    frgBufIdx;
-	      WlzObject *obj2 = NULL;
-
-	      frgBufIdx = 0;
-	      objIdx = frgToObjTb[frgIdxP + fP];
-	      for(fP1 = fP; fP1 < nFrgP; ++fP1)
-	      {
-		if(objIdx == frgToObjTb[frgIdxP + fP1])
-		{
-		  frgObjBuf[frgBufIdx++] = frgP[fP1];
-		  frgP[fP1] = NULL;
-		}
-	      }
-	      if(frgBufIdx > 0)
-	      {
-		obj2 = WlzAssignObject(
-		       WlzUnionN(frgBufIdx, frgObjBuf, 0, &errNum), NULL);
-	      }
-	      if(obj2)
-	      {
-		objs->o[objIdx]->domain.p->domains[p] =
-		    WlzAssignDomain(obj2->domain, NULL);
-		(void )WlzFreeObj(obj2);
-	      }
-	      for(fP1 = 0; fP1 < frgBufIdx; ++fP1)
+	      if(errNum == WLZ_ERR_NONE)
 	      {
-		(void )WlzFreeObj(frgObjBuf[fP1]);
+		errNum = errNum2;
 	      }
 	    }
+#else
+	    errNum = errNum2;
+#endif
 	  }
 	}
       }
     }
   }
-  /* For each of the labeled objects, standardise the plane domain, set the
-   * voxel size, values and possibly background for the objects. */
-  if((errNum == WLZ_ERR_NONE) && (totNFrg > 0) && (gObj->values.core != NULL))
+  AlcFree(wSp);
+  AlcFree(lbl);
+  WlzLabel3DRunsFree(rs);
+  /* For each of the labeled objects set the values if the given object
+   * has values. */
+  if((errNum == WLZ_ERR_NONE) && (gObj->values.core != NULL))
   {
+    WlzPixelV	bgdV;
+
     bgdV = WlzGetBackground(gObj, &errNum);
     if(errNum == WLZ_ERR_NONE)
     {
@@ -523,52 +536,35 @@ WlzObject			*WlzLabel3D(
 
       gPDom = gObj->domain.p;
 #ifdef _OPENMP
-#pragma omp parallel for shared(objs)
+#pragma omp parallel for num_threads(nThr)
 #endif
-      for(i = 0; i < nObjs; ++i)
+      for(i = 0; i < nObj; ++i)
       {
 	if(errNum == WLZ_ERR_NONE)
 	{
 	  WlzPlaneDomain *nPDom;
 	  WlzErrorNum    errNum2 = WLZ_ERR_NONE;
-	  WlzValues	nVal;
+	  WlzValues	gVal,
+	  		nVal;
 
-	  nVal.core = NULL;
+	  gVal = gObj->values;
 	  nPDom = objs->o[i]->domain.p;
-	  nPDom->voxel_size[0] = gPDom->voxel_size[0];
-	  nPDom->voxel_size[1] = gPDom->voxel_size[1];
-	  nPDom->voxel_size[2] = gPDom->voxel_size[2];
-	  if((errNum2 == WLZ_ERR_NONE) && (gObj->values.core != NULL))
+	  nVal.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
+					 nPDom->plane1, nPDom->lastpl,
+					 bgdV, NULL, &errNum2);
+	  if(errNum2 == WLZ_ERR_NONE)
 	  {
 	    int		p;
-	    WlzValues	gVal;
 
-	    gVal = gObj->values;
-	    nVal.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
-					   nPDom->plane1, nPDom->lastpl,
-					   bgdV, NULL, &errNum2);
-	    if(errNum2 == WLZ_ERR_NONE)
+	    objs->o[i]->values = WlzAssignValues(nVal, NULL);
+	    for(p = nPDom->plane1; p <= nPDom->lastpl; ++p)
 	    {
-	      objs->o[i]->values = WlzAssignValues(nVal, NULL);
-	      for(p = nPDom->plane1; p <= nPDom->lastpl; ++p)
-	      {
-		int		gP,
-				  nP;
-
-		nP = p - nPDom->plane1;
-		gP = p - gPDom->plane1;
-		nVal.vox->values[nP] = WlzAssignValues(
-				       gVal.vox->values[gP], NULL);
-	      }
+	      nVal.vox->values[p - nPDom->plane1] = WlzAssignValues(
+				     gVal.vox->values[p - gPDom->plane1], NULL);
 	    }
 	  }
-	  if(errNum2 == WLZ_ERR_NONE)
-	  {
-	    errNum2 = WlzStandardPlaneDomain(nPDom, nVal.vox);
-	  }
-	  if(errNum2 != WLZ_ERR_NONE)
+	  else
 	  {
-
 #ifdef _OPENMP
 #pragma omp critical (WlzLabel3D)
 	    {
@@ -585,34 +581,648 @@ WlzObject			*WlzLabel3D(
       }
     }
   }
-  /* Free the buffers, array of fragments per plane and the fragment
-   * table. */
-  AlcFree(frgObjBuf);
-  AlcFree(frgToObjTb);
-  if(frgTbl)
+  if(errNum == WLZ_ERR_NONE)
+  {
+    lObj = (WlzObject *)objs;
+  }
+  else if(objs)
+  {
+    WlzFreeObj((WlzObject *)objs);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(lObj);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Frees the interval runs.
+* \param	rs			Given interval runs, may be NULL.
+*/
+static void			WlzLabel3DRunsFree(
+				  WlzLabel3DRuns *rs)
+{
+  if(rs)
+  {
+    AlcFree(rs->run);
+    AlcFree(rs->lnRunOff);
+    AlcFree(rs->plnRunOff);
+    AlcFree(rs);
+  }
+}
+
+/*!
+* \return	New interval runs or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Collects the interval runs of all planes of the given plane
+* 		domain. The planes are scanned in parallel.
+* \param	pDom			Given plane domain.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzLabel3DRuns		*WlzLabel3DRunsMake(
+				  WlzPlaneDomain *pDom,
+				  WlzErrorNum *dstErr)
+{
+  int		nPln;
+  WlzLabel3DRuns *rs = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nPln = pDom->lastpl - pDom->plane1 + 1;
+  if(((rs = (WlzLabel3DRuns *)
+            AlcCalloc(1, sizeof(WlzLabel3DRuns))) == NULL) ||
+     ((rs->plnRunOff = (int *)
+                       AlcMalloc((4 * nPln + 2) * sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
   {
     int		p;
 
+    rs->nPln = nPln;
+    rs->plnLnOff = rs->plnRunOff + nPln + 1;
+    rs->plnLn1 = rs->plnLnOff + nPln + 1;
+    rs->plnNLn = rs->plnLn1 + nPln;
+    /* Count the lines and runs of each plane. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
     for(p = 0; p < nPln; ++p)
     {
-      AlcFree(frgTbl[p]);
+      int	nLn = 0,
+		ln1 = 0,
+		nRun = 0;
+      WlzDomain	dom;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      dom = pDom->domains[p];
+      if(dom.core != NULL)
+      {
+        switch(dom.core->type)
+	{
+	  case WLZ_INTERVALDOMAIN_INTVL:
+	    {
+	      int	l;
+
+	      ln1 = dom.i->line1;
+	      nLn = dom.i->lastln - ln1 + 1;
+	      for(l = 0; l < nLn; ++l)
+	      {
+	        nRun += dom.i->intvlines[l].nintvs;
+	      }
+	    }
+	    break;
+	  case WLZ_INTERVALDOMAIN_RECT:
+	    ln1 = dom.i->line1;
+	    nLn = dom.i->lastln - ln1 + 1;
+	    nRun = nLn;
+	    break;
+	  case WLZ_EMPTY_DOMAIN:
+	    break;
+	  default:
+	    errNum2 = WLZ_ERR_DOMAIN_TYPE;
+	    break;
+	}
+      }
+      rs->plnRunOff[p] = nRun;
+      rs->plnLn1[p] = ln1;
+      rs->plnNLn[p] = nLn;
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzLabel3DRunsMake)
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+#else
+	errNum = errNum2;
+#endif
+      }
     }
-    AlcFree(frgTbl);
   }
-  AlcFree(nFrgTbl);
-  AlcFree(cNFrgTbl);
   if(errNum == WLZ_ERR_NONE)
   {
-    lObj = (WlzObject *)objs;
+    int		p;
+    long	nRun = 0,
+    		nLnOff = 0;
+
+    for(p = 0; p < nPln; ++p)
+    {
+      int	n;
+
+      n = rs->plnRunOff[p];
+      if(n > rs->maxPlnRun)
+      {
+        rs->maxPlnRun = n;
+      }
+      rs->plnRunOff[p] = (int )nRun;
+      rs->plnLnOff[p] = (int )nLnOff;
+      nRun += n;
+      nLnOff += rs->plnNLn[p] + 1;
+    }
+    if((nRun > INT_MAX) || (nLnOff > INT_MAX))
+    {
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+    else
+    {
+      rs->nRun = (int )nRun;
+      rs->plnRunOff[nPln] = (int )nRun;
+      rs->plnLnOff[nPln] = (int )nLnOff;
+      if(((rs->lnRunOff = (int *)AlcMalloc(nLnOff * sizeof(int))) == NULL) ||
+	 ((rs->run = (WlzLabel3DRun *)
+		     AlcMalloc((nRun + 1) * sizeof(WlzLabel3DRun))) == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
   }
-  else if(objs)
+  /* Fill in the runs and the index of the first run on each line. */
+  if(errNum == WLZ_ERR_NONE)
   {
-    WlzFreeObj((WlzObject *)objs);
+    int		p;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(p = 0; p < nPln; ++p)
+    {
+      int	l,
+		r,
+		nLn;
+      int	*off;
+      WlzDomain	dom;
+      WlzLabel3DRun *run;
+
+      r = rs->plnRunOff[p];
+      nLn = rs->plnNLn[p];
+      off = rs->lnRunOff + rs->plnLnOff[p];
+      dom = pDom->domains[p];
+      run = rs->run + r;
+      for(l = 0; l < nLn; ++l)
+      {
+	off[l] = r;
+	if(dom.core->type == WLZ_INTERVALDOMAIN_INTVL)
+	{
+	  int	i;
+	  WlzIntervalLine *itvLn;
+
+	  itvLn = dom.i->intvlines + l;
+	  for(i = 0; i < itvLn->nintvs; ++i)
+	  {
+	    run->ln = rs->plnLn1[p] + l;
+	    run->lKol = dom.i->kol1 + itvLn->intvs[i].ileft;
+	    run->rKol = dom.i->kol1 + itvLn->intvs[i].iright;
+	    ++run;
+	    ++r;
+	  }
+	}
+	else
+	{
+	  run->ln = rs->plnLn1[p] + l;
+	  run->lKol = dom.i->kol1;
+	  run->rKol = dom.i->lastkl;
+	  ++run;
+	  ++r;
+	}
+      }
+      off[nLn] = r;
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzLabel3DRunsFree(rs);
+    rs = NULL;
   }
   if(dstErr)
   {
     *dstErr = errNum;
   }
-  return(lObj);
+  return(rs);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Joins the runs on a line of one plane with those on a line
+* 		of another (or the same) plane which are connected. Both
+* 		lines of runs are swept together in order of column.
+* \param	uft			Union find tree for the runs.
+* \param	rs			The runs.
+* \param	p			First plane index.
+* \param	l			Line on the first plane.
+* \param	q			Second plane index.
+* \param	m			Line on the second plane.
+* \param	d			Column tolerance, runs are connected
+* 					if they overlap when extended by this
+* 					many columns.
+* \param	ign			Non-zero for runs which should be
+* 					ignored, may be NULL.
+*/
+static void			WlzLabel3DUnionLines(
+				  AlcUFTree *uft,
+				  WlzLabel3DRuns *rs,
+				  int p,
+				  int l,
+				  int q,
+				  int m,
+				  int d,
+				  const char *ign)
+{
+  l -= rs->plnLn1[p];
+  m -= rs->plnLn1[q];
+  if((l >= 0) && (l < rs->plnNLn[p]) && (m >= 0) && (m < rs->plnNLn[q]))
+  {
+    int		i,
+		i1,
+		j,
+		j1;
+    const int	*offP,
+    		*offQ;
+
+    offP = rs->lnRunOff + rs->plnLnOff[p];
+    offQ = rs->lnRunOff + rs->plnLnOff[q];
+    i = offP[l];
+    i1 = offP[l + 1];
+    j = offQ[m];
+    j1 = offQ[m + 1];
+    while((i < i1) && (j < j1))
+    {
+      WlzLabel3DRun *rI,
+      		*rJ;
+
+      rI = rs->run + i;
+      rJ = rs->run + j;
+      if(rI->rKol + d < rJ->lKol)
+      {
+        ++i;
+      }
+      else if(rJ->rKol + d < rI->lKol)
+      {
+        ++j;
+      }
+      else
+      {
+	if((ign == NULL) || ((ign[i] == 0) && (ign[j] == 0)))
+	{
+	  (void )AlcUFTreeConcUnion(uft, i, j);
+	}
+	if(rI->rKol < rJ->rKol)
+	{
+	  ++i;
+	}
+	else
+	{
+	  ++j;
+	}
+      }
+    }
+  }
 }
 
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Joins the connected runs within a single plane.
+* \param	uft			Union find tree for the runs.
+* \param	rs			The runs.
+* \param	p			Plane index.
+* \param	d			Column tolerance between lines, zero
+* 					for 4-connectivity and one for
+* 					8-connectivity.
+*/
+static void			WlzLabel3DUnionPlane(
+				  AlcUFTree *uft,
+				  WlzLabel3DRuns *rs,
+				  int p,
+				  int d)
+{
+  int		l,
+  		ln1;
+  const int	*off;
+
+  ln1 = rs->plnLn1[p];
+  off = rs->lnRunOff + rs->plnLnOff[p];
+  for(l = 0; l < rs->plnNLn[p]; ++l)
+  {
+    int		r;
+
+    /* Runs on the same line only touch if the domain isn't standard. */
+    for(r = off[l] + 1; r < off[l + 1]; ++r)
+    {
+      if(rs->run[r].lKol <= rs->run[r - 1].rKol + 1)
+      {
+        (void )AlcUFTreeConcUnion(uft, r - 1, r);
+      }
+    }
+    if(l > 0)
+    {
+      WlzLabel3DUnionLines(uft, rs, p, ln1 + l, p, ln1 + l - 1, d, NULL);
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Joins the connected runs of the given plane and the
+* 		previous plane.
+* \param	uft			Union find tree for the runs.
+* \param	rs			The runs.
+* \param	p			Plane index, must be greater than zero.
+* \param	d			Zero if runs must overlap to be
+* 					connected, one if runs are connected
+* 					when they overlap after dilation by a
+* 					3x3 square.
+* \param	ign			Non-zero for runs which should be
+* 					ignored, may be NULL.
+*/
+static void			WlzLabel3DUnionPlanes(
+				  AlcUFTree *uft,
+				  WlzLabel3DRuns *rs,
+				  int p,
+				  int d,
+				  const char *ign)
+{
+  if((rs->plnRunOff[p] < rs->plnRunOff[p + 1]) &&
+     (rs->plnRunOff[p - 1] < rs->plnRunOff[p]))
+  {
+    int		l,
+    		l1;
+
+    l1 = rs->plnLn1[p] + rs->plnNLn[p];
+    for(l = rs->plnLn1[p]; l < l1; ++l)
+    {
+      int	m;
+
+      for(m = l - d; m <= l + d; ++m)
+      {
+	WlzLabel3DUnionLines(uft, rs, p, l, p - 1, m, d, ign);
+      }
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code, WLZ_ERR_PARAM_DATA if there are more than
+* 		the maximum number of fragments in the plane.
+* \ingroup	WlzBinaryOps
+* \brief	Counts the 2D fragments of a plane in which the runs have
+* 		been joined, marking the runs of fragments which are
+* 		ignored because they have too few lines or columns, in
+* 		the same way as WlzLabel().
+* \param	uft			Union find tree for the runs.
+* \param	rs			The runs.
+* \param	p			Plane index.
+* \param	maxObj			Maximum number of fragments.
+* \param	ignLn			Fragments with fewer than ignLn + 1
+* 					lines or columns are ignored.
+* \param	ign			Array of ignored run flags, only
+* 					used if ignLn is greater than zero.
+* \param	wSp			Workspace with room for four ints per
+* 					run of the plane.
+*/
+static WlzErrorNum		WlzLabel3DFragments(
+				  AlcUFTree *uft,
+				  WlzLabel3DRuns *rs,
+				  int p,
+				  int maxObj,
+				  int ignLn,
+				  char *ign,
+				  int *wSp)
+{
+  int		r,
+  		r0,
+		r1,
+  		nFrg = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  r0 = rs->plnRunOff[p];
+  r1 = rs->plnRunOff[p + 1];
+  if(ignLn > 0)
+  {
+    /* The root of a fragment is it's first run, so it is always visited
+     * before any of the fragment's other runs. */
+    for(r = r0; r < r1; ++r)
+    {
+      int	t;
+      int	*b;
+      WlzLabel3DRun *run;
+
+      run = rs->run + r;
+      t = AlcUFTreeConcFind(uft, r);
+      b = wSp + 4 * (t - r0);
+      if(t == r)
+      {
+        b[0] = b[1] = run->ln;
+	b[2] = run->lKol;
+	b[3] = run->rKol;
+      }
+      else
+      {
+        b[1] = run->ln;
+	if(run->lKol < b[2])
+	{
+	  b[2] = run->lKol;
+	}
+	if(run->rKol > b[3])
+	{
+	  b[3] = run->rKol;
+	}
+      }
+    }
+    for(r = r0; r < r1; ++r)
+    {
+      int	t;
+
+      t = AlcUFTreeConcFind(uft, r);
+      if(t == r)
+      {
+	int	*b;
+
+	b = wSp + 4 * (t - r0);
+        ign[r] = ((b[1] - b[0]) < ignLn) || ((b[3] - b[2]) < ignLn);
+	nFrg += (ign[r] == 0);
+      }
+      else
+      {
+        ign[r] = ign[t];
+      }
+    }
+  }
+  else
+  {
+    for(r = r0; r < r1; ++r)
+    {
+      nFrg += (AlcUFTreeConcFind(uft, r) == r);
+    }
+  }
+  if(nFrg > maxObj)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Builds the interval domains of the labeled objects within
+* 		the given plane and sets them in the objects' plane domains.
+* 		The runs of the plane are grouped by label using a stable
+* 		counting sort so each group remains in raster order.
+* \param	rs			The runs.
+* \param	p			Plane index.
+* \param	plane1			First plane of the given object.
+* \param	lbl			Labeled object index of each run, with
+* 					negative values for ignored runs.
+* \param	objs			The labeled objects.
+* \param	wSp			Workspace with room for objs->n ints,
+* 					all of which must be negative, and then
+* 					three ints per run of the plane plus
+* 					one. The first objs->n ints are
+* 					restored on return.
+*/
+static WlzErrorNum		WlzLabel3DPlaneDomains(
+				  WlzLabel3DRuns *rs,
+				  int p,
+				  int plane1,
+				  const int *lbl,
+				  WlzCompoundArray *objs,
+				  int *wSp)
+{
+  int		g,
+  		n,
+  		r,
+		r0,
+		r1,
+		nGrp = 0;
+  int		*slot,
+  		*grpLbl,
+		*grpOff,
+		*ord;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  r0 = rs->plnRunOff[p];
+  r1 = rs->plnRunOff[p + 1];
+  slot = wSp;
+  grpLbl = slot + objs->n;
+  grpOff = grpLbl + rs->maxPlnRun;
+  ord = grpOff + rs->maxPlnRun + 1;
+  /* Count the runs of each labeled object in the plane. */
+  for(r = r0; r < r1; ++r)
+  {
+    int		l;
+
+    if((l = lbl[r]) >= 0)
+    {
+      if(slot[l] < 0)
+      {
+        slot[l] = nGrp;
+	grpLbl[nGrp] = l;
+	grpOff[nGrp] = 0;
+	++nGrp;
+      }
+      ++grpOff[slot[l]];
+    }
+  }
+  n = 0;
+  for(g = 0; g < nGrp; ++g)
+  {
+    int		t;
+
+    t = grpOff[g];
+    grpOff[g] = n;
+    n += t;
+  }
+  for(r = r0; r < r1; ++r)
+  {
+    int		l;
+
+    if((l = lbl[r]) >= 0)
+    {
+      ord[grpOff[slot[l]]++] = r;
+    }
+  }
+  /* Each grpOff[g] is now the end of group g. */
+  for(g = 0; (errNum == WLZ_ERR_NONE) && (g < nGrp); ++g)
+  {
+    int		i,
+    		i0,
+		i1,
+		kol1,
+		lastkl;
+    WlzInterval	*itv = NULL;
+    WlzIntervalDomain *iDom;
+
+    i0 = (g > 0)? grpOff[g - 1]: 0;
+    i1 = grpOff[g];
+    kol1 = rs->run[ord[i0]].lKol;
+    lastkl = rs->run[ord[i0]].rKol;
+    for(i = i0 + 1; i < i1; ++i)
+    {
+      WlzLabel3DRun *run;
+
+      run = rs->run + ord[i];
+      if(run->lKol < kol1)
+      {
+        kol1 = run->lKol;
+      }
+      if(run->rKol > lastkl)
+      {
+        lastkl = run->rKol;
+      }
+    }
+    iDom = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+    				 rs->run[ord[i0]].ln, rs->run[ord[i1 - 1]].ln,
+				 kol1, lastkl, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if((itv = (WlzInterval *)
+                AlcMalloc((i1 - i0) * sizeof(WlzInterval))) == NULL)
+      {
+        (void )WlzFreeIntervalDomain(iDom);
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	iDom->freeptr = AlcFreeStackPush(iDom->freeptr, (void *)itv, NULL);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzDomain	dom;
+      WlzPlaneDomain *pDom;
+
+      i = i0;
+      while(i < i1)
+      {
+	int	ln,
+		nItv = 0;
+	WlzInterval *itv0;
+
+	itv0 = itv;
+	ln = rs->run[ord[i]].ln;
+	while((i < i1) && (rs->run[ord[i]].ln == ln))
+	{
+	  itv->ileft = rs->run[ord[i]].lKol - kol1;
+	  itv->iright = rs->run[ord[i]].rKol - kol1;
+	  ++itv;
+	  ++nItv;
+	  ++i;
+	}
+	(void )WlzMakeInterval(ln, iDom, nItv, itv0);
+      }
+      dom.i = iDom;
+      pDom = objs->o[grpLbl[g]]->domain.p;
+      pDom->domains[plane1 + p - pDom->plane1] = WlzAssignDomain(dom, NULL);
+    }
+  }
+  for(g = 0; g < nGrp; ++g)
+  {
+    slot[grpLbl[g]] = -1;
+  }
+  return(errNum);
+}
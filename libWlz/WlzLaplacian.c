@@ -146,12 +146,7 @@ WlzObject	*WlzLaplacian(WlzObject *srcObj, int kSize,
   if(errNum == WLZ_ERR_NONE)
   {
     tmpObj = srcObj;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      lConv.linkcount = 0;
-    }
+    lConv.linkcount = 0;
     lConv.xsize = kSize;
     lConv.ysize = kSize;
     lConv.cv = NULL;
@@ -135,6 +135,13 @@ extern "C" {
 #define WLZ_MESH_TOLERANCE_SQ   (WLZ_MESH_TOLERANCE * WLZ_MESH_TOLERANCE)
 #define WLZ_MESH_ELEM_AREA_TOLERANCE   (WLZ_M_SQRT3_2 * WLZ_MESH_TOLERANCE_SQ)
 
+/************************************************************************
+* Suggested basis function evaluation tolerance, the displacement	*
+* error to aim for when a caller chooses to have basis functions	*
+* approximated for many positions. Evaluation is exact by default.	*
+************************************************************************/
+#define WLZ_BASISFN_EVAL_TOL    (1.0E-02)
+
 /************************************************************************
 * Byte packed bitmap macros
 ************************************************************************/
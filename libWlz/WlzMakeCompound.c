@@ -157,12 +157,7 @@ WlzMakeCompoundArray(WlzObjectType	type,
     if (type == WLZ_COMPOUND_ARR_1){
       co->otype = otype;
     }
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      co->linkcount = 0;
-    }
+    co->linkcount = 0;
   }
 
   if( dstErr ){
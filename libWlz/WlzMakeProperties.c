@@ -104,12 +104,7 @@ WlzSimpleProperty *WlzMakeSimpleProperty(int size, WlzErrorNum *dstErr)
   else
   {
     p->type = WLZ_PROPERTY_SIMPLE;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      p->linkcount = 0;
-    }
+    p->linkcount = 0;
     p->size = size;
     if((p->prop = AlcMalloc(size)) == NULL)
     {
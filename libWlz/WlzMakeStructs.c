@@ -124,12 +124,7 @@ WlzIntervalDomain *WlzMakeIntervalDomain(WlzObjectType type,
     idom->kol1 = k1;
     idom->lastkl = kl;
     idom->freeptr = NULL;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      idom->linkcount = 0;
-    }
+    idom->linkcount = 0;
   }
 
   if( dstErr ){
@@ -212,12 +207,7 @@ WlzMakePlaneDomain(WlzObjectType type,
     planedm->kol1 = k1;
     planedm->lastkl = kl;
     planedm->freeptr = NULL;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      planedm->linkcount = 0;
-    }
+    planedm->linkcount = 0;
     planedm->voxel_size[0] = 1.0;
     planedm->voxel_size[1] = 1.0;
     planedm->voxel_size[2] = 1.0;
@@ -442,12 +432,7 @@ WlzMakeMain(WlzObjectType 	type,
     case WLZ_TRANS_OBJ:
     case WLZ_SPLINE:
       obj->type = type;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-      {
-        obj->linkcount = 0;
-      }
+      obj->linkcount = 0;
       obj->domain = WlzAssignDomain(domain, &errNum);
       if( errNum == WLZ_ERR_NONE ){
 	obj->values = WlzAssignValues(values, &errNum);
@@ -603,12 +588,7 @@ WlzMakeValueTb(WlzObjectType	type,
   }
   if( errNum == WLZ_ERR_NONE ){
     vtb->freeptr = NULL;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      vtb->linkcount = 0;
-    }
+    vtb->linkcount = 0;
     vtb->vtblines = (WlzValueLine *) (vtb + 1);
     vtb->original_table.core = NULL;
   }
@@ -682,12 +662,7 @@ WlzMakeVoxelValueTb(WlzObjectType	type,
       voxtab->bckgrnd = backgrnd;
       voxtab->freeptr = NULL;
       voxtab->original_table.core = NULL;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-      {
-        voxtab->linkcount = 0;
-      }
+      voxtab->linkcount = 0;
       voxtab->values = (WlzValues *) (voxtab + 1);
       for(p=0; p < nplanes; p++){
 	voxtab->values[p].core = NULL;
@@ -765,12 +740,7 @@ WlzMakeRectValueTb(WlzObjectType	type,
     else {
       vtb->type = type;
       vtb->freeptr = NULL;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-      {
-        vtb->linkcount = 0;
-      }
+      vtb->linkcount = 0;
       vtb->line1 = line1;
       vtb->lastln = lastln;
       vtb->kol1 = kol1;
@@ -1412,12 +1382,7 @@ WlzMakePolygonDomain(WlzObjectType	type,
       p->type = type;
       p->nvertices = n;
       p->maxvertices = maxv;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-      {
-        p->linkcount = 0;
-      }
+      p->linkcount = 0;
       if( copy == 0 ){
 	p->vtx = vertices;
       } 
@@ -1478,12 +1443,7 @@ WlzMakeBoundList(WlzObjectType		type,
     }
     else {
       blist->type = type;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-      {
-	blist->linkcount = 0;
-      }
+      blist->linkcount = 0;
       blist->freeptr = NULL;
       blist->up = NULL;
       blist->next = NULL;
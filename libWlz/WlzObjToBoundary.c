@@ -128,12 +128,7 @@ WlzObject *WlzObjToBoundary(
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
   uhole.type = WLZ_BOUNDLIST_HOLE;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-  {
-    uhole.linkcount = 0;
-  }
+  uhole.linkcount = 0;
   uhole.freeptr = NULL;
   uhole.up = NULL;
   uhole.next = NULL;
@@ -562,12 +557,7 @@ WlzObject *WlzObjToBoundary(
    * Also remember that makemain() increments the "idom" linkcount.
    */
   if( errNum == WLZ_ERR_NONE ){
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      (bi+1)->lb->linkcount=0;
-    }
+    (bi+1)->lb->linkcount=0;
     domain.b = (bi+1)->lb;
     values.core = NULL;
     bobj = WlzMakeMain(WLZ_BOUNDLIST, domain, values, NULL, NULL, &errNum);
@@ -644,12 +634,7 @@ static int nextunprocessed(WlzBoundInterval *bi,
        */
       bl = (WlzBoundList *)AlcCalloc(sizeof(WlzBoundList), 1);
       bl->type = WLZ_BOUNDLIST_PIECE;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-      {
-        bl->linkcount = 1;
-      }
+      bl->linkcount = 1;
       bnd_link(bl,(bi-1)->rb);
       bi->lb = bl;
       bp->bi = bi;
@@ -666,12 +651,7 @@ static int nextunprocessed(WlzBoundInterval *bi,
        */
       bl = (WlzBoundList *) AlcCalloc(sizeof(WlzBoundList),1);
       bl->type = WLZ_BOUNDLIST_HOLE;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-      {
-        bl->linkcount = 1;
-      }
+      bl->linkcount = 1;
       bnd_link(bl,bi->lb);
       bi->rb = bl;
       bp->bi = bi;
@@ -166,6 +166,18 @@ extern WlzObject 		*WlzGetSubSectionFromObject(
 				  WlzInterpolationType	interp,
 				  WlzObject	**maskRtn,
 				  WlzErrorNum *dstErr);
+extern WlzSectionServer		*WlzMakeSectionServer(
+				  WlzObject	*obj,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeSectionServer(
+				  WlzSectionServer *srv);
+extern WlzObject 		*WlzGetSubSectionFromServer(
+				  WlzSectionServer *srv,
+				  WlzObject	*subDomain,
+				  WlzThreeDViewStruct *viewStr,
+				  WlzInterpolationType	interp,
+				  WlzObject	**maskRtn,
+				  WlzErrorNum *dstErr);
 #endif
 
 /************************************************************************
@@ -1100,6 +1112,21 @@ extern WlzDVertex2		WlzBasisFnValueIMQ2D(
 extern WlzDVertex3		WlzBasisFnValueIMQ3D(
 				  WlzBasisFn *basisFn,
 				  WlzDVertex3 srcVx);
+extern WlzDVertex3		WlzBasisFnValueCS3D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex3 srcVx);
+extern WlzErrorNum		WlzBasisFnValueBatch2D(
+				  WlzBasisFn *basisFn,
+				  int nPos,
+				  WlzDVertex2 *pos,
+				  WlzDVertex2 *dsp,
+				  double tol);
+extern WlzErrorNum		WlzBasisFnValueBatch3D(
+				  WlzBasisFn *basisFn,
+				  int nPos,
+				  WlzDVertex3 *pos,
+				  WlzDVertex3 *dsp,
+				  double tol);
 extern WlzDVertex2		WlzBasisFnValuePoly2D(
 				  WlzBasisFn *basisFn,
 				  WlzDVertex2 srcVx);
@@ -1162,6 +1189,12 @@ extern WlzBasisFn		*WlzBasisFnIMQ3DFromCPts(
 				  WlzBasisFn *prvBasisFn,
 				  WlzCMesh3D *mesh,
 				  WlzErrorNum *dstErr);
+extern WlzBasisFn		*WlzBasisFnCS3DFromCPts(
+				  int nPts,
+				  WlzDVertex3 *dPts,
+				  WlzDVertex3 *sPts,
+				  double delta,
+				  WlzErrorNum *dstErr);
 extern WlzBasisFn		*WlzBasisFnMQ2DFromCPts(
 				  int nPts,
 				  WlzDVertex2 *dPts,
@@ -1293,6 +1326,14 @@ extern WlzErrorNum		WlzBasisFnSetCMesh2D(
 extern WlzErrorNum		WlzBasisFnSetCMesh3D(
 				  WlzObject *mObj,
 				  WlzBasisFnTransform *basisTr);
+extern WlzErrorNum		WlzBasisFnSetCMesh2DTol(
+				  WlzObject *mObj,
+				  WlzBasisFnTransform *basisTr,
+				  double tol);
+extern WlzErrorNum		WlzBasisFnSetCMesh3DTol(
+				  WlzObject *mObj,
+				  WlzBasisFnTransform *basisTr,
+				  double tol);
 extern WlzErrorNum 		WlzBasisFnFreeTransform(
 				  WlzBasisFnTransform *basisTr);
 extern WlzObject		*WlzBasisFnTransformObj(
@@ -1319,6 +1360,12 @@ extern WlzGMModel		*WlzBasisFnTransformGMModel(WlzGMModel *srcM,
 				  WlzBasisFnTransform *basisTr,
 				  int newModel,
 				  WlzErrorNum *dstErr);
+extern WlzGMModel		*WlzBasisFnTransformGMModelTol(
+				  WlzGMModel *srcM,
+				  WlzBasisFnTransform *basisTr,
+				  int newModel,
+				  double tol,
+				  WlzErrorNum *dstErr);
 extern WlzIVertex2		WlzBasisFnTransformVertexI(
 				  WlzBasisFnTransform *basisTr,
 				  WlzIVertex2 srcVxF,
@@ -1331,6 +1378,12 @@ extern WlzDVertex2		WlzBasisFnTransformVertexD(
 				  WlzBasisFnTransform *basisTr,
 			          WlzDVertex2 srcVxF,
 				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzBasisFnTransformVertexBatchD(
+				  WlzBasisFnTransform *basisTr,
+				  int nVtx,
+				  WlzDVertex2 *srcVx,
+				  WlzDVertex2 *dstVx,
+				  double tol);
 extern WlzDVertex2     		WlzBasisFnTransformNormalD(
 				  WlzBasisFnTransform *basisTr,
 				  WlzDVertex2 srcVx,
@@ -1565,6 +1618,39 @@ extern WlzObject		*WlzClipObjToBox3D(
 				  WlzIBox3 clipBox,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzCMeshCompact.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzCMeshCompact3D	*WlzCMeshCompactFromMesh3D(
+				  WlzCMesh3D *mesh,
+				  WlzErrorNum *dstErr);
+extern WlzCMesh3D		*WlzCMeshCompactToMesh3D(
+				  WlzCMeshCompact3D *cMesh,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzCMeshCompactFree3D(
+				  WlzCMeshCompact3D *cMesh);
+extern WlzErrorNum		WlzCMeshCompactSetNodPos3D(
+				  WlzCMesh3D *mesh,
+				  WlzCMeshCompact3D *cMesh,
+				  int update);
+extern WlzErrorNum		WlzCMeshCompactLaplacianSmooth3D(
+				  WlzCMeshCompact3D *cMesh,
+				  int itr,
+				  double alpha,
+				  int doBnd,
+				  int update);
+extern int			WlzCMeshCompactElmEnclosingPos3D(
+				  WlzCMeshCompact3D *cMesh,
+				  int lastElmIdx,
+				  WlzDVertex3 pos);
+extern int			WlzCMeshCompactNodRing3D(
+				  WlzCMeshCompact3D *cMesh,
+				  int nodIdx,
+				  int maxNbr,
+				  int *nbr);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzCMeshCurvature.c							*
 ************************************************************************/
@@ -2328,6 +2414,15 @@ extern WlzContour		*WlzContourObjGrd(
 				  double ctrWth,
 				  int nrmFlg,
 				  WlzErrorNum *dstErr);
+#ifndef WLZ_EXT_BIND
+extern WlzIndexedSurface	*WlzContourObjIndexedSurface(
+				  WlzObject *srcObj,
+				  WlzContourMethod ctrMtd,
+				  double ctrVal,
+				  double ctrWth,
+				  int nrmFlg,
+				  WlzErrorNum *dstErr);
+#endif /* WLZ_EXT_BIND */
 extern WlzContour 		*WlzContourGrdObj2D(
 				  WlzObject *srcObj,
 				  WlzObject *gXObj,
@@ -2721,6 +2816,27 @@ extern WlzErrorNum		WlzStandardIntervalDomain(
 				  WlzIntervalDomain *idom);
 #endif /* WLZ_EXT_BIND */
 
+/************************************************************************
+* WlzEncodedValues.c							*
+************************************************************************/
+extern WlzValueEncoding		WlzEncodedValuesType(void);
+extern void			WlzEncodedValuesSetType(
+				  WlzValueEncoding enc);
+extern WlzErrorNum		WlzEncodedValuesWrite(
+				  FILE *fP,
+				  WlzObject *obj,
+				  WlzValueEncoding enc);
+extern WlzErrorNum		WlzEncodedValuesRead(
+				  FILE *fP,
+				  WlzObject *obj);
+extern WlzErrorNum		WlzEncodedValuesDecode(
+				  WlzUByte *raw,
+				  size_t rawSz,
+				  WlzUByte *enc,
+				  size_t encSz,
+				  WlzValueEncoding codec,
+				  int valSz);
+
 /************************************************************************
 * WlzErosion.c								*
 ************************************************************************/
@@ -3249,6 +3365,10 @@ extern WlzErrorNum		WlzGMModelConstructSimplex3N(
 			  	  WlzGMModel *model,
 			  	  WlzDVertex3 *pos,
 			  	  WlzDVertex3 *nrm);
+extern WlzErrorNum		WlzGMModelConstructSimplex3V(
+			  	  WlzGMModel *model,
+			  	  WlzDVertex3 *pos,
+			  	  WlzGMVertex **vtx);
 extern WlzErrorNum		WlzGMModelConstructSimplex2D(
 			  	  WlzGMModel *model,
 			  	  WlzDVertex2 *pos);
@@ -3843,6 +3963,43 @@ extern WlzErrorNum 		WlzNextGreyInterval(
 extern WlzErrorNum 		WlzGreyInterval(
 				  WlzIntervalWSpace *iwsp);
 
+/************************************************************************
+* WlzGreyScanPar.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzErrorNum		WlzGreyScanPar(
+				  WlzObject *obj,
+				  int nBins,
+				  double binOrigin,
+				  double binSize,
+				  WlzPixelV threshV,
+				  WlzThresholdType highlow,
+				  WlzGreyScanStats *dstStats,
+				  WlzObject **dstHist,
+				  WlzObject **dstThr);
+#endif /* WLZ_EXT_BIND */
+extern WlzObject		*WlzHistogramObjPar(
+				  WlzObject *srcObj,
+				  int nBins,
+				  double binOrigin,
+				  double binSize,
+				  WlzErrorNum *dstErr);
+extern int			WlzGreyStatsPar(
+				  WlzObject *srcObj,
+				  WlzGreyType *dstGType,
+				  double *dstMin,
+				  double *dstMax,
+				  double *dstSum,
+				  double *dstSumSq,
+				  double *dstMean,
+				  double *dstStdDev,
+				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzThresholdPar(
+				  WlzObject *obj,
+				  WlzPixelV threshV,
+				  WlzThresholdType highlow,
+				  WlzErrorNum *dstErr);
+
 /************************************************************************
 * WlzGreySetIncValues.c  						*
 ************************************************************************/
@@ -3967,6 +4124,13 @@ extern void	                WlzGreyValueGetDir(
 				  int plane,
 				  int line,
 				  int kol);
+extern WlzErrorNum		WlzGreyValueGetBatch(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzInterpolationType interp,
+				  WlzVertexType vType,
+				  int nPos,
+				  WlzVertexP pos,
+				  double *dst);
 
 
 /************************************************************************
@@ -4115,6 +4279,34 @@ extern WlzCompoundArray 	*WlzIndexObjToCompound(
 				  WlzObject *gObj,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzIndexedSurface.c
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzIndexedSurface	*WlzMakeIndexedSurface(
+				  int nVtx,
+				  int nFce,
+				  int nrmFlg,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeIndexedSurface(
+				  WlzIndexedSurface *srf);
+extern WlzIndexedSurface	*WlzIndexedSurfaceFromTriangles(
+				  int nTri,
+				  WlzDVertex3 *pos,
+				  WlzErrorNum *dstErr);
+extern WlzIndexedSurface	*WlzIndexedSurfaceFromGMModel(
+				  WlzGMModel *model,
+				  WlzErrorNum *dstErr);
+extern WlzGMModel		*WlzIndexedSurfaceToGMModel(
+				  WlzIndexedSurface *srf,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzIndexedSurfaceSetNormals(
+				  WlzIndexedSurface *srf);
+extern WlzErrorNum		WlzIndexedSurfaceScale(
+				  WlzIndexedSurface *srf,
+				  WlzDVertex3 scale);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzInsideDomain.c							*
 ************************************************************************/
@@ -5752,6 +5944,11 @@ extern WlzObjectType		WlzReadObjType(
 extern WlzObject		*WlzReadObj(
 				  FILE *fP,
 			          WlzErrorNum *dstErr);
+extern WlzObject		*WlzReadObjPlanes(
+				  FILE *fP,
+				  int plane1,
+				  int lastpl,
+				  WlzErrorNum *dstErr);
 #ifndef WLZ_EXT_BIND
 extern WlzMeshTransform3D 	*WlzReadMeshTransform3D(
 				  FILE *fP,
@@ -5827,6 +6024,19 @@ extern WlzAffineTransform	*WlzRegICPObjs(
 				  double delta,
 				  double minDistWgt,
 				  WlzErrorNum *dstErr);
+extern WlzAffineTransform	*WlzRegICPObjsMR(
+				  WlzObject *tObj,
+				  WlzObject *sObj,
+				  WlzAffineTransform *initTr,
+				  WlzTransformType trType,
+				  int *dstConv,
+				  int *dstItr,
+				  int maxItr,
+				  int noNrm,
+				  double delta,
+				  double minDistWgt,
+				  int nLvl,
+				  WlzErrorNum *dstErr);
 extern WlzAffineTransform	*WlzRegICPObjsGrd(
 				  WlzObject *tObj,
 				  WlzObject *sObj,
@@ -5860,6 +6070,24 @@ extern WlzAffineTransform	*WlzRegICPVertices(
 				  double delta,
 				  double minDistWgt,
 				  WlzErrorNum *dstErr);
+extern WlzAffineTransform	*WlzRegICPVerticesMR(
+				  WlzVertexP tVx,
+				  WlzVertexP tNr,
+				  int tCnt,
+				  WlzVertexP sVx,
+				  WlzVertexP sNr,
+				  int sCnt,
+				  WlzVertexType vType,
+				  int sgnNrm,
+				  WlzAffineTransform *initTr,
+				  WlzTransformType trType,
+				  int *dstConv,
+				  int *dstItr,
+				  int maxItr,
+				  double delta,
+				  double minDistWgt,
+				  int nLvl,
+				  WlzErrorNum *dstErr);
 extern WlzAffineTransform	*WlzRegICPTreeAndVertices(
 				  AlcKDTTree *tree,
 				  WlzTransformType trType,
@@ -6032,6 +6260,15 @@ extern WlzObject   		*WlzSepFilter(WlzObject *inObj,
 				  double padVal,
 				  int sep,
                                   WlzErrorNum *dstErr);
+extern WlzObject   		*WlzSepFilterFast(WlzObject *inObj,
+                                  WlzIVertex3 cBufSz,
+                                  double *cBuf[],
+                                  WlzIVertex3 direc,
+                                  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  int sep,
+                                  WlzErrorNum *dstErr);
 extern WlzObject		*WlzGaussFilter(
 				  WlzObject *inObj,
 				  WlzDVertex3 sigma,
@@ -6042,6 +6279,16 @@ extern WlzObject		*WlzGaussFilter(
 				  double padVal,
 				  int sep,
 				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzGaussFilterFast(
+				  WlzObject *inObj,
+				  WlzDVertex3 sigma,
+				  WlzIVertex3 order,
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  int sep,
+				  WlzErrorNum *dstErr);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -6392,6 +6639,26 @@ extern WlzObject 		*WlzStructDilation(
 				  WlzObject *obj,
 				  WlzObject *structElm,
 				  WlzErrorNum *dstErr);
+extern WlzObject 		*WlzStructDilationDecomp(
+				  WlzObject *obj,
+				  WlzObject *structElm,
+				  WlzStructElmDecomp dcp,
+				  WlzErrorNum *dstErr);
+
+/************************************************************************
+* WlzStructElmDecomp.c							*
+************************************************************************/
+extern WlzStructElmDecomp	WlzStructElmDecompFind(
+				  WlzObject *obj,
+				  WlzObject *se,
+				  int ers,
+				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzStructElmDecompMorph(
+				  WlzObject *obj,
+				  WlzObject *se,
+				  WlzStructElmDecomp dcp,
+				  int ers,
+				  WlzErrorNum *dstErr);
 
 /************************************************************************
 * WlzStructErosion.c							*
@@ -6399,6 +6666,11 @@ extern WlzObject 		*WlzStructDilation(
 extern WlzObject 		*WlzStructErosion(WlzObject *obj,
 				  WlzObject *structElm,
 				  WlzErrorNum *dstErr);
+extern WlzObject 		*WlzStructErosionDecomp(
+				  WlzObject *obj,
+				  WlzObject *structElm,
+				  WlzStructElmDecomp dcp,
+				  WlzErrorNum *dstErr);
 
 /************************************************************************
 * WlzRGBAConvert.c							*
@@ -6677,6 +6949,20 @@ extern void			WlzTiledValuesCopyLine(
 extern void			WlzTiledValueBufferFill(
 				  WlzTiledValueBuffer *tvb,
 				  WlzTiledValues *tv);
+extern size_t			WlzTiledValuesPageCacheSz(void);
+extern void			WlzTiledValuesSetPageCacheSz(
+				  size_t sz);
+extern WlzErrorNum		WlzMakeTiledValuesPager(
+				  WlzTiledValues *tVal,
+				  int fd,
+				  size_t cacheSz);
+extern WlzTiledValuesPage	*WlzTiledValuesPageIn(
+				  WlzTiledValues *tVal,
+				  size_t idx,
+				  WlzErrorNum *dstErr);
+extern void			WlzTiledValuesPageOut(
+				  WlzTiledValues *tVal,
+				  WlzTiledValuesPage *page);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -7331,6 +7617,9 @@ extern const char 		*WlzWindowFnName(
 extern WlzErrorNum 		WlzWriteObj(
 				  FILE *fp,
 			          WlzObject *obj);
+extern int			WlzWriteObjPlaneIndex(void);
+extern void			WlzWriteObjSetPlaneIndex(
+				  int idx);
 
 #ifndef WLZ_EXT_BIND
 extern WlzErrorNum  		WlzWriteMeshTransform3D(
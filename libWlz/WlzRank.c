@@ -45,8 +45,67 @@ static char _WlzRank_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <limits.h>
 #include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <Wlz.h>
 
+#define WLZ_RANK_HIST_MAXBIN	(65536)	/* Maximum number of histogram bins
+					   for the sliding histogram rank
+					   filter. */
+#define WLZ_RANK_HIST_CRSSHF	(8)	/* Shift from fine to coarse histogram
+					   bins. */
+
+/*!
+* \struct	_WlzRankHistWSp
+* \ingroup	WlzValuesFilters
+* \brief	Workspace for the sliding histogram rank filter. The
+*		value bin and mask arrays are shared between threads,
+*		each of which has it's own histograms.
+*		Typedef: ::WlzRankHistWSp.
+*/
+typedef struct _WlzRankHistWSp
+{
+  int		fSz;		/*!< Rank filter size. */
+  int		fSz2;		/*!< Half the rank filter size. */
+  int		vMin;		/*!< Value of the first histogram bin. */
+  int		nCrs;		/*!< Number of coarse histogram bins. */
+  int		nHst;		/*!< Number of values in the histogram. */
+  double	rank;		/*!< Required rank. */
+  WlzIBox3	box;		/*!< Bounding box of the object. */
+  WlzIVertex3	sz;		/*!< Size of the bounding box. */
+  size_t	mskLnSz;	/*!< Number of bytes in a mask line. */
+  unsigned short *bin;		/*!< Array of value bins covering the
+  				     bounding box. */
+  WlzUByte	*msk;		/*!< Bit mask array for the domain covering
+  				     the bounding box. */
+  int		*hFn;		/*!< Fine histogram. */
+  int		*hCrs;		/*!< Coarse histogram. */
+} WlzRankHistWSp;
+
+static WlzErrorNum		WlzRankFilterHist(
+				  WlzObject *gObj,
+				  int fSz,
+				  double rank,
+				  WlzGreyType vType,
+				  int vMin,
+				  int nBin);
+static WlzErrorNum		WlzRankFilterHistSet(
+				  WlzRankHistWSp *hWSp,
+				  WlzObject *obj2D,
+				  int pln,
+				  WlzGreyType vType);
+static WlzErrorNum		WlzRankFilterHistPl(
+				  WlzRankHistWSp *hWSp,
+				  WlzObject *obj2D,
+				  int pln,
+				  WlzGreyType vType);
+static void			WlzRankFilterHistCol(
+				  WlzRankHistWSp *hWSp,
+				  int px,
+				  int py,
+				  int pz,
+				  int inc);
 static WlzErrorNum 		WlzRankFilterDomObj2D(
 				  WlzObject *gObj,
 				  int fSz,
@@ -92,6 +151,20 @@ static void			WlzRankFilterValues(
 *		ranked value of the values in it's immediate neighborhood,
 *		where the neighborhood is a simple axis aligned cuboid
 *		with the size.
+*
+*		For objects with WLZ_GREY_UBYTE, WLZ_GREY_SHORT or
+*		WLZ_GREY_INT values which span no more than 65536
+*		distinct values a sliding histogram filter is used.
+*		This keeps a histogram of the values in the neighborhood
+*		which is updated incrementally along each interval, so
+*		that only the values entering and leaving the neighborhood
+*		are visited (as in T. S. Huang, G. J. Yang and G. Y. Tang.
+*		"A Fast Two-Dimensional Median Filtering Algorithm",
+*		IEEE Trans. ASSP, 27:13-18, 1979). The planes of 3D
+*		objects are filtered in parallel.
+*		Other objects are filtered by selecting the ranked value
+*		from a buffer of the neighborhood values for each
+*		pixel/voxel.
 * \param	gObj			Given object.
 * \param	fSz			Rank filter size.
 * \param	rank			Required rank with values:
@@ -100,6 +173,10 @@ static void			WlzRankFilterValues(
 */
 WlzErrorNum	WlzRankFilter(WlzObject *gObj, int fSz, double rank)
 {
+  int		nBin = 0;
+  WlzPixelV	minV,
+  		maxV;
+  WlzGreyType	vType = WLZ_GREY_ERROR;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if(gObj == NULL)
@@ -134,20 +211,488 @@ WlzErrorNum	WlzRankFilter(WlzObject *gObj, int fSz, double rank)
     }
     switch(gObj->type)
     {
-      case WLZ_2D_DOMAINOBJ:
-	errNum = WlzRankFilterDomObj2D(gObj, fSz, rank);
-	break;
+      case WLZ_2D_DOMAINOBJ: /* FALLTHROUGH */
       case WLZ_3D_DOMAINOBJ:
-	errNum = WlzRankFilterDomObj3D(gObj, fSz, rank);
+	vType = WlzGreyTypeFromObj(gObj, &errNum);
 	break;
       default:
 	errNum = WLZ_ERR_OBJECT_TYPE;
 	break;
     }
   }
+  /* Use the sliding histogram filter if the values are of an integral
+   * type and their range is not too great. */
+  if((errNum == WLZ_ERR_NONE) && (fSz > 1) &&
+     ((vType == WLZ_GREY_UBYTE) || (vType == WLZ_GREY_SHORT) ||
+      (vType == WLZ_GREY_INT)))
+  {
+    errNum = WlzGreyRange(gObj, &minV, &maxV);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzValueConvertPixel(&minV, minV, WLZ_GREY_INT);
+      (void )WlzValueConvertPixel(&maxV, maxV, WLZ_GREY_INT);
+      /* The range is found as a long as it may overflow an int. */
+      if((maxV.v.inv >= minV.v.inv) &&
+         (((WlzLong )(maxV.v.inv) - minV.v.inv) < WLZ_RANK_HIST_MAXBIN))
+      {
+        nBin = maxV.v.inv - minV.v.inv + 1;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(nBin > 0)
+    {
+      errNum = WlzRankFilterHist(gObj, fSz, rank, vType, minV.v.inv, nBin);
+    }
+    else if(gObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      errNum = WlzRankFilterDomObj2D(gObj, fSz, rank);
+    }
+    else
+    {
+      errNum = WlzRankFilterDomObj3D(gObj, fSz, rank);
+    }
+  }
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Applies a sliding histogram rank filter in place to the
+*		given 2 or 3D domain object with integral grey values.
+*		The values are first copied to an array of histogram bins
+*		(with a bit mask for the domain) that covers the object's
+*		bounding box, then each plane is filtered using it's own
+*		histograms.
+* \param	gObj			Given object.
+* \param	fSz			Rank filter size.
+* \param	rank			Required rank.
+* \param	vType			Grey type of the object's values.
+* \param	vMin			Minimum value in the object.
+* \param	nBin			Number of histogram bins required,
+*					which is the range of values.
+*/
+static WlzErrorNum WlzRankFilterHist(WlzObject *gObj, int fSz, double rank,
+				     WlzGreyType vType, int vMin, int nBin)
+{
+  int		idT,
+		nPln,
+  		nThr = 1;
+  size_t	nVx;
+  WlzRankHistWSp hWSp0;
+  WlzRankHistWSp *hWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  hWSp0.fSz = fSz;
+  hWSp0.fSz2 = fSz / 2;
+  hWSp0.vMin = vMin;
+  hWSp0.nCrs = (nBin + (1 << WLZ_RANK_HIST_CRSSHF) - 1) >>
+               WLZ_RANK_HIST_CRSSHF;
+  hWSp0.nHst = 0;
+  hWSp0.rank = rank;
+  hWSp0.bin = NULL;
+  hWSp0.msk = NULL;
+  hWSp0.hFn = hWSp0.hCrs = NULL;
+  if(gObj->type == WLZ_2D_DOMAINOBJ)
+  {
+    hWSp0.box.xMin = gObj->domain.i->kol1;
+    hWSp0.box.xMax = gObj->domain.i->lastkl;
+    hWSp0.box.yMin = gObj->domain.i->line1;
+    hWSp0.box.yMax = gObj->domain.i->lastln;
+    hWSp0.box.zMin = hWSp0.box.zMax = 0;
+  }
+  else
+  {
+    hWSp0.box.xMin = gObj->domain.p->kol1;
+    hWSp0.box.xMax = gObj->domain.p->lastkl;
+    hWSp0.box.yMin = gObj->domain.p->line1;
+    hWSp0.box.yMax = gObj->domain.p->lastln;
+    hWSp0.box.zMin = gObj->domain.p->plane1;
+    hWSp0.box.zMax = gObj->domain.p->lastpl;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    hWSp0.sz.vtX = hWSp0.box.xMax - hWSp0.box.xMin + 1;
+    hWSp0.sz.vtY = hWSp0.box.yMax - hWSp0.box.yMin + 1;
+    hWSp0.sz.vtZ = hWSp0.box.zMax - hWSp0.box.zMin + 1;
+    hWSp0.mskLnSz = (hWSp0.sz.vtX + 7) / 8;
+    nPln = hWSp0.sz.vtZ;
+    nVx = (size_t )(hWSp0.sz.vtX) * hWSp0.sz.vtY * hWSp0.sz.vtZ;
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+        nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    if(((hWSp0.bin = (unsigned short *)
+		     AlcMalloc(nVx * sizeof(unsigned short))) == NULL) ||
+       ((hWSp0.msk = (WlzUByte *)
+		     AlcCalloc(hWSp0.mskLnSz * hWSp0.sz.vtY * hWSp0.sz.vtZ,
+		     sizeof(WlzUByte))) == NULL) ||
+       ((hWSp = (WlzRankHistWSp *)
+                AlcMalloc(nThr * sizeof(WlzRankHistWSp))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      hWSp[idT] = hWSp0;
+      hWSp[idT].hFn = NULL;
+      hWSp[idT].hCrs = NULL;
+    }
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      if(((hWSp[idT].hFn = (int *)
+                           AlcMalloc(hWSp0.nCrs *
+			             (1 << WLZ_RANK_HIST_CRSSHF) *
+				     sizeof(int))) == NULL) ||
+	 ((hWSp[idT].hCrs = (int *)
+	                    AlcMalloc(hWSp0.nCrs * sizeof(int))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+	break;
+      }
+    }
+  }
+  /* Copy the values into the value bin array, then filter the planes
+   * with all values available. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(gObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      errNum = WlzRankFilterHistSet(hWSp, gObj, 0, vType);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        errNum = WlzRankFilterHistPl(hWSp, gObj, 0, vType);
+      }
+    }
+    else
+    {
+      int	idP,
+		pass;
+      WlzDomain	*doms;
+      WlzValues	*vals;
+
+      doms = gObj->domain.p->domains;
+      vals = gObj->values.vox->values;
+      for(pass = 0; pass < 2; ++pass)
+      {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for(idP = 0; idP < nPln; ++idP)
+	{
+	  if((errNum == WLZ_ERR_NONE) && (doms[idP].core != NULL))
+	  {
+	    int		thrId = 0;
+	    WlzObject	*obj2D;
+	    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+	    thrId = omp_get_thread_num();
+#endif
+	    obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, doms[idP], vals[idP],
+				NULL, NULL, &errNum2);
+	    if(errNum2 == WLZ_ERR_NONE)
+	    {
+	      errNum2 = (pass == 0)?
+			WlzRankFilterHistSet(hWSp + thrId, obj2D, idP, vType):
+			WlzRankFilterHistPl(hWSp + thrId, obj2D, idP, vType);
+	    }
+	    (void )WlzFreeObj(obj2D);
+	    if(errNum2 != WLZ_ERR_NONE)
+	    {
+#ifdef _OPENMP
+#pragma omp critical (WlzRankFilterHist)
+	      {
+		if(errNum == WLZ_ERR_NONE)
+		{
+		  errNum = errNum2;
+		}
+	      }
+#else
+	      errNum = errNum2;
+#endif
+	    }
+	  }
+	}
+      }
+    }
+  }
+  if(hWSp)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      AlcFree(hWSp[idT].hFn);
+      AlcFree(hWSp[idT].hCrs);
+    }
+    AlcFree(hWSp);
+  }
+  AlcFree(hWSp0.bin);
+  AlcFree(hWSp0.msk);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Sets the value bins and domain mask bits for the given
+*		2D object, which may be a plane of a 3D object.
+* \param	hWSp			Sliding histogram workspace.
+* \param	obj2D			Given 2D domain object with values.
+* \param	pln			Plane offset of the 2D object within
+*					the bounding box.
+* \param	vType			Grey value type.
+*/
+static WlzErrorNum WlzRankFilterHistSet(WlzRankHistWSp *hWSp,
+				        WlzObject *obj2D, int pln,
+					WlzGreyType vType)
+{
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum;
+
+  errNum = WlzInitGreyScan(obj2D, &iWSp, &gWSp);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      int	idX,
+      		lnY,
+		itvLen;
+      unsigned short *bP;
+      WlzUByte	*mP;
+      WlzGreyP	gP;
+
+      gP = gWSp.u_grintptr;
+      itvLen = iWSp.rgtpos - iWSp.lftpos + 1;
+      lnY = (pln * hWSp->sz.vtY) + iWSp.linpos - hWSp->box.yMin;
+      mP = hWSp->msk + (lnY * hWSp->mskLnSz);
+      bP = hWSp->bin + ((size_t )lnY * hWSp->sz.vtX) +
+           iWSp.lftpos - hWSp->box.xMin;
+      switch(vType)
+      {
+        case WLZ_GREY_UBYTE:
+	  for(idX = 0; idX < itvLen; ++idX)
+	  {
+	    bP[idX] = gP.ubp[idX] - hWSp->vMin;
+	  }
+	  break;
+        case WLZ_GREY_SHORT:
+	  for(idX = 0; idX < itvLen; ++idX)
+	  {
+	    bP[idX] = gP.shp[idX] - hWSp->vMin;
+	  }
+	  break;
+        case WLZ_GREY_INT:
+	  for(idX = 0; idX < itvLen; ++idX)
+	  {
+	    bP[idX] = gP.inp[idX] - hWSp->vMin;
+	  }
+	  break;
+	default:
+	  break;
+      }
+      WlzBitLnSetItv(mP, iWSp.lftpos - hWSp->box.xMin,
+                     iWSp.rgtpos - hWSp->box.xMin, hWSp->sz.vtX);
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Rank filters the values of the given 2D object, which may
+*		be a plane of a 3D object, using the workspace's value bin
+*		array. The neighborhood histogram is slid along each
+*		interval, adding and removing a column of values at
+*		a time.
+* \param	hWSp			Sliding histogram workspace with
+*					histograms for this thread.
+* \param	obj2D			Given 2D domain object with values.
+* \param	pln			Plane offset of the 2D object within
+*					the bounding box.
+* \param	vType			Grey value type.
+*/
+static WlzErrorNum WlzRankFilterHistPl(WlzRankHistWSp *hWSp,
+				       WlzObject *obj2D, int pln,
+				       WlzGreyType vType)
+{
+  int		cX = 0,
+  		cY = 0,
+		cValid = 0;
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum;
+
+  (void )memset(hWSp->hFn, 0,
+                hWSp->nCrs * (1 << WLZ_RANK_HIST_CRSSHF) * sizeof(int));
+  (void )memset(hWSp->hCrs, 0, hWSp->nCrs * sizeof(int));
+  hWSp->nHst = 0;
+  errNum = WlzInitGreyScan(obj2D, &iWSp, &gWSp);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      int	idX,
+		lft,
+		rgt,
+		pY;
+      WlzGreyP	gP;
+
+      gP = gWSp.u_grintptr;
+      pY = iWSp.linpos - hWSp->box.yMin;
+      lft = iWSp.lftpos - hWSp->box.xMin;
+      rgt = iWSp.rgtpos - hWSp->box.xMin;
+      /* Move the neighborhood to the start of the interval, either by
+       * sliding it or by emptying it and then filling it afresh. */
+      if(cValid && (cY == pY) && (cX <= lft) && (lft - cX < hWSp->fSz))
+      {
+        while(cX < lft)
+	{
+	  WlzRankFilterHistCol(hWSp, cX - hWSp->fSz2, pY, pln, -1);
+	  WlzRankFilterHistCol(hWSp, cX - hWSp->fSz2 + hWSp->fSz, pY, pln, 1);
+	  ++cX;
+	}
+      }
+      else
+      {
+        if(cValid)
+	{
+	  for(idX = 0; idX < hWSp->fSz; ++idX)
+	  {
+	    WlzRankFilterHistCol(hWSp, cX - hWSp->fSz2 + idX, cY, pln, -1);
+	  }
+	}
+	cX = lft;
+	cY = pY;
+	cValid = 1;
+	for(idX = 0; idX < hWSp->fSz; ++idX)
+	{
+	  WlzRankFilterHistCol(hWSp, cX - hWSp->fSz2 + idX, cY, pln, 1);
+	}
+      }
+      for(idX = lft; idX <= rgt; ++idX)
+      {
+	int	bC,
+		bF,
+		acc,
+		rnk;
+
+        if(cX < idX)
+	{
+	  WlzRankFilterHistCol(hWSp, cX - hWSp->fSz2, pY, pln, -1);
+	  WlzRankFilterHistCol(hWSp, cX - hWSp->fSz2 + hWSp->fSz, pY, pln, 1);
+	  ++cX;
+	}
+	/* Find the ranked value using the coarse and then fine
+	 * histograms. */
+	acc = 0;
+	bC = 0;
+	rnk = (int )floor(hWSp->nHst * hWSp->rank);
+	while(acc + hWSp->hCrs[bC] <= rnk)
+	{
+	  acc += hWSp->hCrs[bC++];
+	}
+	bF = bC << WLZ_RANK_HIST_CRSSHF;
+	while(acc + hWSp->hFn[bF] <= rnk)
+	{
+	  acc += hWSp->hFn[bF++];
+	}
+	bF += hWSp->vMin;
+	switch(vType)
+	{
+	  case WLZ_GREY_UBYTE:
+	    *(gP.ubp)++ = (WlzUByte )bF;
+	    break;
+	  case WLZ_GREY_SHORT:
+	    *(gP.shp)++ = (short )bF;
+	    break;
+	  case WLZ_GREY_INT:
+	    *(gP.inp)++ = bF;
+	    break;
+	  default:
+	    break;
+	}
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup      WlzValuesFilters
+* \brief	Adds or removes a column of the neighborhood to or from
+*		the histograms. The column is at the given column offset
+*		and is centred on the given line and plane offsets.
+* \param	hWSp			Sliding histogram workspace.
+* \param	px			Column offset of the column.
+* \param	py			Line offset of the neighborhood.
+* \param	pz			Plane offset of the neighborhood.
+* \param	inc			Histogram increment, either 1 to
+*					add or -1 to remove the column.
+*/
+static void	WlzRankFilterHistCol(WlzRankHistWSp *hWSp,
+				     int px, int py, int pz, int inc)
+{
+  if((px >= 0) && (px < hWSp->sz.vtX))
+  {
+    int		idY,
+    		idZ,
+		y0,
+		y1,
+		z0,
+		z1;
+
+    y0 = ALG_MAX(py - hWSp->fSz2, 0);
+    y1 = ALG_MIN(py - hWSp->fSz2 + hWSp->fSz, hWSp->sz.vtY);
+    z0 = ALG_MAX(pz - hWSp->fSz2, 0);
+    z1 = ALG_MIN(pz - hWSp->fSz2 + hWSp->fSz, hWSp->sz.vtZ);
+    if(hWSp->sz.vtZ == 1)
+    {
+      z0 = 0;
+      z1 = 1;
+    }
+    for(idZ = z0; idZ < z1; ++idZ)
+    {
+      for(idY = y0; idY < y1; ++idY)
+      {
+	size_t	lnY;
+
+        lnY = ((size_t )idZ * hWSp->sz.vtY) + idY;
+	if(WLZ_BIT_GET(hWSp->msk + (lnY * hWSp->mskLnSz), px) != 0)
+	{
+	  int	b;
+
+	  b = hWSp->bin[(lnY * hWSp->sz.vtX) + px];
+	  hWSp->hFn[b] += inc;
+	  hWSp->hCrs[b >> WLZ_RANK_HIST_CRSSHF] += inc;
+	  hWSp->nHst += inc;
+	}
+      }
+    }
+  }
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup      WlzValuesFilters
@@ -277,7 +822,7 @@ static WlzErrorNum WlzRankFilterDomObj2D(WlzObject *gObj, int fSz,
       {
 	while(inLn < iWSp.linpos)
 	{
-	  outLn = inLn - fSz2 - 1; 	         /* -1 because previous line */
+	  outLn = inLn - fSz2;	     /* Lines up to inLn are in the buffer */
 	  if(outLn >= gDom.i->line1)
 	  {
 	    WlzRankFilterValLn(gObj, gVWSp, vBuf, iBuf, rBuf,
@@ -333,8 +878,11 @@ static WlzErrorNum WlzRankFilterDomObj2D(WlzObject *gObj, int fSz,
     {
       while(++outLn <= gDom.i->lastln)
       {
-	WlzRankFilterValLn(gObj, gVWSp, vBuf, iBuf, rBuf, 
-			   outLn, vType, bufSz, rank);
+        if(outLn >= gDom.i->line1)
+	{
+	  WlzRankFilterValLn(gObj, gVWSp, vBuf, iBuf, rBuf,
+			     outLn, vType, bufSz, rank);
+	}
 	bufLn = (++inLn + bufSz.vtY - gDom.i->line1) % bufSz.vtY;
         WlzValueSetUByte(iBuf[bufLn], 0, iBufWidth);
       }
@@ -472,40 +1020,45 @@ static WlzErrorNum WlzRankFilterDomObj3D(WlzObject *gObj, int fSz,
   /* Work down through the object. */
   if(errNum == WLZ_ERR_NONE)
   {
+    /* Planes are held in the buffer at their offset from the first
+     * plane modulo the filter size, each plane is filtered once all the
+     * planes of it's neighbourhood are in the buffer and the planes
+     * beyond the last are empty. */
     plIdx = 0;
     outPl = gDom.p->plane1 + plIdx - fSz2;
-    pnCnt = gDom.p->lastpl - gDom.p->plane1 + 1;
+    pnCnt = gDom.p->lastpl - gDom.p->plane1 + 1 + fSz2;
+    bufOrg2D.vtX = gDom.p->kol1 - fSz2;
+    bufOrg2D.vtY = gDom.p->line1 - fSz2;
     while((errNum == WLZ_ERR_NONE) && (pnCnt-- > 0))
     {
-      if((errNum == WLZ_ERR_NONE) && (outPl >= gDom.p->plane1))
+      bufPl = plIdx % bufSz.vtZ;
+      if((plIdx > gDom.p->lastpl - gDom.p->plane1) ||
+         (gObj->domain.p->domains[plIdx].core == NULL) ||
+	 (gObj->values.vox->values[plIdx].core == NULL))
       {
-        WlzRankFilterValPl(gObj, gVWSp, vBuf, iBuf, rBuf,
-			   outPl, vType, bufSz, rank);
+        WlzValueSetUByte(**(iBuf + bufPl), 0,
+			 bufSz.vtY * ((bufSz.vtX + 7) / 8));
       }
-      bufPl = (gDom.p->plane1 + plIdx) % bufSz.vtZ;
-      obj2D->domain = *(gObj->domain.p->domains + plIdx);
-      obj2D->values = *(gObj->values.vox->values + plIdx);
-      if(errNum == WLZ_ERR_NONE)
+      else
       {
-        bufOrg2D.vtX = obj2D->domain.i->kol1 - fSz2;
-	bufOrg2D.vtY = obj2D->domain.i->line1 - fSz2;
+	obj2D->domain = *(gObj->domain.p->domains + plIdx);
+	obj2D->values = *(gObj->values.vox->values + plIdx);
 	errNum = WlzToArray2D((void ***)(iBuf + bufPl), obj2D,
 			      bufSz2D, bufOrg2D, 0, WLZ_GREY_BIT);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzToArray2D((void ***)(vBuf + bufPl), obj2D,
+				bufSz2D, bufOrg2D, 0, vType);
+	}
       }
-      if(errNum == WLZ_ERR_NONE)
+      if((errNum == WLZ_ERR_NONE) && (outPl >= gDom.p->plane1))
       {
-        errNum = WlzToArray2D((void ***)(vBuf + bufPl), obj2D,
-			      bufSz2D, bufOrg2D, 0, vType);
+        WlzRankFilterValPl(gObj, gVWSp, vBuf, iBuf, rBuf,
+			   outPl, vType, bufSz, rank);
       }
       ++plIdx;
       ++outPl;
     }
-    while((errNum == WLZ_ERR_NONE) && (outPl <= gDom.p->lastpl))
-    {
-      WlzRankFilterValPl(gObj, gVWSp, vBuf, iBuf, rBuf,
-			 outPl, vType, bufSz, rank);
-      ++outPl;
-    }
   }
   if(obj2D)
   {
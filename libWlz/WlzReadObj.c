@@ -49,6 +49,11 @@ static char _WlzReadObj_c[] = "University of Edinburgh $Id$";
 #include <unistd.h>
 #include <sys/mman.h>
 #endif
+#ifdef HAVE_UNISTD_H
+#define WLZ_USE_PREAD
+#include <errno.h>
+#include <unistd.h>
+#endif
 
 /* #define WLZ_DEBUG_READOBJ */
 #define WLZ_OLD_CMESH_TRANS_SUPPORT
@@ -86,6 +91,38 @@ static WlzErrorNum 		WlzReadTiledValues(
 static WlzErrorNum		WlzReadVoxelValues(
 				  FILE *fp,
 				  WlzObject *obj);
+static WlzObject		*WlzReadDomObj3D(
+				  FILE *fP,
+				  int rng,
+				  int rP1,
+				  int rLp,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzReadObjPlanesSelect(
+				  WlzObject *gObj,
+				  int plane1,
+				  int lastpl,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzReadIndexedPlanes(
+				  FILE *fP,
+				  int rng,
+				  int rP1,
+				  int rLp,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzReadIndexedPlanesIdxCheck(
+				  WlzLong *idx,
+				  int nPln,
+				  WlzLong recSz);
+static WlzErrorNum		WlzReadIndexedPlane(
+				  FILE *fP,
+				  WlzObject *obj,
+				  int pIdx);
+#if defined(WLZ_USE_PREAD) && defined(HAVE_FMEMOPEN)
+static WlzErrorNum		WlzReadPread(
+				  int fd,
+				  WlzLong off,
+				  size_t nB,
+				  WlzUByte *buf);
+#endif /* WLZ_USE_PREAD && HAVE_FMEMOPEN */
 static WlzProperty	 	WlzReadProperty(
 				  FILE *fp,
 				  WlzErrorNum *);
@@ -363,6 +400,41 @@ static double 	getdouble(FILE *fp)
   return(out.dbv);
 }
 
+/*!
+* \return	The long value.
+* \ingroup	WlzIO
+* \brief	Converts eight bytes, as written by putlong() (two words
+* 		in DEC VAX(!) byte order with the least significant word
+* 		first), to a long.
+* \param	b			Given bytes.
+*/
+static WlzLong	WlzReadLongFromBytes(WlzUByte *b)
+{
+  int		i;
+  WlzULong	l = 0;
+
+  for(i = 7; i >= 0; --i)
+  {
+    l = (l << 8) | b[i];
+  }
+  return((WlzLong )l);
+}
+
+/*!
+* \return	The long value.
+* \ingroup	WlzIO
+* \brief	Reads the next long from the input file, see
+* 		WlzReadLongFromBytes().
+* \param	fp			Input file.
+*/
+static WlzLong	getlong(FILE *fp)
+{
+  WlzUByte	b[8] = {0};
+
+  (void )fread(b, sizeof(char), 8, fp);
+  return(WlzReadLongFromBytes(b));
+}
+
 /*!
 * \return	Woolz object type as read from file.
 * \ingroup	WlzIO
@@ -462,18 +534,7 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 	break;
 
       case WLZ_3D_DOMAINOBJ:
-	if(((domain.p = WlzReadPlaneDomain(fp, &errNum)) != NULL) &&
-	   ((obj = WlzMakeMain(type, domain, values, NULL, NULL,
-			       &errNum)) != NULL ))
-	{
-	  if((errNum = WlzReadDomObjValues3D(fp, obj)) == WLZ_ERR_NONE)
-	  {
-	    obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fp, NULL),
-					       NULL);
-	  }
-	  /* Don't clear up on error, instead return partial object as it may
-	   * be salvagable. */
-	}
+	obj = WlzReadDomObj3D(fp, 0, 0, 0, &errNum);
 	break;
 
       case WLZ_TRANS_OBJ:
@@ -659,6 +720,243 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
   return(obj);
 }
 
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads the given range of planes of a 3D domain object from
+* 		the given input stream. If the object was written with a
+* 		plane index (see WlzWriteObjPlaneIndex()) and the stream
+* 		is seekable then only the records of the planes within the
+* 		range are read, otherwise the whole object is read and the
+* 		planes within the range are selected from it. In either
+* 		case the stream is left positioned after the object. The
+* 		returned object's plane bounds are the intersection of
+* 		the given range with those of the object in the file; if
+* 		this intersection is empty then an empty object is
+* 		returned. The plane domains and values of the returned
+* 		object are not standardised. As with WlzReadObj() a
+* 		partial object may be returned with the error set to
+* 		WLZ_ERR_READ_INCOMPLETE.
+* \param	fP			Input file.
+* \param	plane1			First plane of the range.
+* \param	lastpl			Last plane of the range.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzReadObjPlanes(FILE *fP, int plane1, int lastpl,
+				  WlzErrorNum *dstErr)
+{
+  WlzObjectType	type;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  type = WlzReadObjType(fP, &errNum);
+  if((errNum == WLZ_ERR_NONE) && (type == (WlzObjectType )EOF))
+  {
+    errNum = WLZ_ERR_READ_EOF;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(type == WLZ_3D_DOMAINOBJ)
+    {
+      obj = WlzReadDomObj3D(fP, 1, plane1, lastpl, &errNum);
+      if((errNum == WLZ_ERR_NONE) && (obj->type == WLZ_3D_DOMAINOBJ) &&
+	 ((obj->domain.p->plane1 < plane1) ||
+	  (obj->domain.p->lastpl > lastpl)))
+      {
+	WlzObject	*rObj;
+
+	/* The planes were not read selectively. */
+	rObj = WlzReadObjPlanesSelect(obj, plane1, lastpl, &errNum);
+	(void )WlzFreeObj(obj);
+	obj = rObj;
+      }
+    }
+    else
+    {
+      /* Read the object so that the stream is left positioned after it. */
+      (void )ungetc(type, fP);
+      if((obj = WlzReadObj(fP, &errNum)) != NULL)
+      {
+	(void )WlzFreeObj(obj);
+	obj = NULL;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WLZ_ERR_OBJECT_TYPE;
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Makes a new 3D domain object from the given 3D domain object
+* 		which has only those planes which are within the given
+* 		range. The plane domains and values of the new object
+* 		are shared with those of the given object. If the range
+* 		does not intersect the object's planes then an empty object
+* 		is returned.
+* \param	gObj			Given 3D domain object.
+* \param	plane1			First plane of the range.
+* \param	lastpl			Last plane of the range.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzReadObjPlanesSelect(WlzObject *gObj,
+					 int plane1, int lastpl,
+					 WlzErrorNum *dstErr)
+{
+  int		idp,
+  		off,
+		nObj;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzPlaneDomain *gDom;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  gDom = gObj->domain.p;
+  plane1 = WLZ_MAX(plane1, gDom->plane1);
+  lastpl = WLZ_MIN(lastpl, gDom->lastpl);
+  if(gDom->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((gObj->values.core != NULL) &&
+          (gObj->values.core->type != WLZ_VOXELVALUETABLE_GREY))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if(plane1 > lastpl)
+  {
+    obj = WlzMakeEmpty(&errNum);
+  }
+  else
+  {
+    nObj = lastpl - plane1 + 1;
+    off = plane1 - gDom->plane1;
+    if((dom.p = WlzMakePlaneDomain(gDom->type, plane1, lastpl,
+                                   gDom->line1, gDom->lastln,
+				   gDom->kol1, gDom->lastkl,
+				   &errNum)) != NULL)
+    {
+      dom.p->voxel_size[0] = gDom->voxel_size[0];
+      dom.p->voxel_size[1] = gDom->voxel_size[1];
+      dom.p->voxel_size[2] = gDom->voxel_size[2];
+      for(idp = 0; idp < nObj; ++idp)
+      {
+	dom.p->domains[idp] = WlzAssignDomain(gDom->domains[off + idp], NULL);
+      }
+      if((obj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, NULL, NULL,
+			    &errNum)) == NULL)
+      {
+	(void )WlzFreePlaneDomain(dom.p);
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (gObj->values.core != NULL))
+    {
+      WlzVoxelValues *gVal;
+
+      gVal = gObj->values.vox;
+      if((val.vox = WlzMakeVoxelValueTb(gVal->type, plane1, lastpl,
+					gVal->bckgrnd, obj, &errNum)) != NULL)
+      {
+	for(idp = 0; idp < nObj; ++idp)
+	{
+	  val.vox->values[idp] = WlzAssignValues(gVal->values[off + idp],
+						 NULL);
+	}
+	obj->values = WlzAssignValues(val, NULL);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj->plist = WlzAssignPropertyList(gObj->plist, NULL);
+    }
+    else if(obj != NULL)
+    {
+      (void )WlzFreeObj(obj);
+      obj = NULL;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
+/*!
+* \return	New 3D domain object, empty object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads a 3D domain object, the type of which has already
+* 		been read, along with its property list. If a range of
+* 		planes is required and the object was written with a
+* 		plane index then only those planes within the range may
+* 		be read (see WlzReadIndexedPlanes()), otherwise all the
+* 		planes are read. On error a partial object may be
+* 		returned, as it may be salvagable.
+* \param	fP			Input file.
+* \param	rng			Non-zero if only the planes within
+* 					the given range are required.
+* \param	rP1			First plane of the range.
+* \param	rLp			Last plane of the range.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzReadDomObj3D(FILE *fP, int rng, int rP1, int rLp,
+				  WlzErrorNum *dstErr)
+{
+  int		c;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  /* Indexed planes are identified by their plane domain type. */
+  if((c = getc(fP)) == WLZ_PLANEDOMAIN_INDEXED)
+  {
+    obj = WlzReadIndexedPlanes(fP, rng, rP1, rLp, &errNum);
+  }
+  else
+  {
+    (void )ungetc(c, fP);
+    if(((dom.p = WlzReadPlaneDomain(fP, &errNum)) != NULL) &&
+       ((obj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, NULL, NULL,
+			   &errNum)) != NULL ))
+    {
+      errNum = WlzReadDomObjValues3D(fP, obj);
+    }
+  }
+  if((obj != NULL) && (errNum == WLZ_ERR_NONE))
+  {
+    WlzPropertyList *pList;
+
+    pList = WlzReadPropertyList(fP, NULL);
+    if(obj->type == WLZ_3D_DOMAINOBJ)
+    {
+      obj->plist = WlzAssignPropertyList(pList, NULL);
+    }
+    else
+    {
+      (void )WlzFreePropertyList(pList);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
@@ -1534,6 +1832,9 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
   ll = obj->domain.i->lastln;
   k1 = obj->domain.i->kol1;
   backgrnd.type = gtype;
+  /* Clear all of the background value, not just the member for the grey
+   * type, as the voxel value table background is copied from it. */
+  backgrnd.v.dbv = 0.0;
   switch (type) {
 
   case WLZ_VALUETABLE_RAGR_INT:
@@ -2088,6 +2389,9 @@ static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj)
       case WLZ_VALUETABLE_TILED_RGBA:
 	errNum = WlzReadTiledValues(fP, obj, 2, type, 1);
 	break;
+      case WLZ_VALUETABLE_ENCODED:
+        errNum = WlzEncodedValuesRead(fP, obj);
+	break;
       default:
         errNum = WlzReadGreyValues(fP, type, obj);
 	break;
@@ -2142,6 +2446,9 @@ static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
       case WLZ_VALUETABLE_TILED_ARY_RGBA:
         errNum = WlzReadTiledValues(fP, obj, 3, type, 1);
 	break;
+      case WLZ_VALUETABLE_ENCODED:
+        errNum = WlzEncodedValuesRead(fP, obj);
+	break;
       default:
         errNum = WLZ_ERR_VALUES_TYPE;
 	break;
@@ -2155,6 +2462,9 @@ static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
 * \ingroup	WlzIO
 * \brief	Reads a Woolz tiled value table from the input file.
 * 		The table type has already been read and verified.
+* 		If WlzTiledValuesPageCacheSz() is non-zero then the
+* 		tiles are neither mapped nor read, but instead are
+* 		paged on demand into a bounded cache.
 * \param	fp			Input file.
 * \param	obj			Object defining the domain of the
 *					grey values.
@@ -2297,7 +2607,32 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
 
     gSz = WlzGreySize(gType);
     tSz = tVal->numTiles * tVal->tileSz;
-    if(map)
+#ifdef WLZ_USE_PREAD
+    {
+      size_t	cacheSz;
+
+      /* If a page cache size has been set then neither map nor read the
+       * tiles, but page them on demand into a bounded cache. */
+      if((cacheSz = WlzTiledValuesPageCacheSz()) > 0)
+      {
+	int	fd;
+
+	if((fd = dup(fileno(fP))) >= 0)
+	{
+	  if(WlzMakeTiledValuesPager(tVal, fd, cacheSz) != WLZ_ERR_NONE)
+	  {
+	    (void )close(fd);
+	  }
+	  else if(fseek(fP, tVal->tileOffset + (gSz * tSz * vSz),
+	                SEEK_SET) != 0)
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	}
+      }
+    }
+#endif /* WLZ_USE_PREAD */
+    if(map && (tVal->pager == NULL))
     {
 #ifdef WLZ_USE_MMAP
       /* For mmap to work the file must have been opened either with
@@ -2338,7 +2673,7 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
       tVal->tiles.v = NULL;
 #endif /* WLZ_USE_MMAP */
     }
-    if((errNum == WLZ_ERR_NONE) && (tVal->fd < 0))
+    if((errNum == WLZ_ERR_NONE) && (tVal->fd < 0) && (tVal->pager == NULL))
     {
       /* Have either failed to mmap the tiles or we're not using mmap
        * so just malloc space and read them. */
@@ -2534,6 +2869,452 @@ static WlzErrorNum WlzReadVoxelValues(FILE *fp, WlzObject *obj)
   return errNum;
 }
 
+/*!
+* \return	New 3D domain object, empty object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads the plane domain and values of a 3D domain object
+* 		which were written as independent per-plane records
+* 		followed by a plane index (see WlzWriteIndexedPlanes()).
+* 		The type byte WLZ_PLANEDOMAIN_INDEXED has already been
+* 		read. If the file can be read using pread() then the
+* 		index is read first and the planes are read and decoded
+* 		concurrently. Otherwise, if the file is seekable and a
+* 		range of planes is required, the index is read and the
+* 		planes in the range are read in turn. Otherwise the
+* 		records are read and decoded in order and any range is
+* 		ignored. In all cases the file is left positioned after
+* 		the index. If a range is required and it does not
+* 		intersect the object's planes then an empty object is
+* 		returned. As with WlzReadObj() a partial object may be
+* 		returned along with an error.
+* \param	fP			Input file.
+* \param	rng			Non-zero if only the planes within
+* 					the given range are required.
+* \param	rP1			First plane of the range.
+* \param	rLp			Last plane of the range.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzReadIndexedPlanes(FILE *fP, int rng, int rP1, int rLp,
+				       WlzErrorNum *dstErr)
+{
+  int		idp,
+  		par = 0,
+		empty = 0,
+		nPln = 0,
+		nObj = 0,
+		off = 0,
+		vType = 0,
+		bgdV = 0,
+		p1,
+		pl,
+		l1,
+		ll,
+		k1,
+		kl,
+		q1,
+		ql;
+  long		recMrk = -1,
+  		endMrk = -1;
+  WlzLong	recSz = 0;
+  float		vSz[3];
+  WlzLong	*idx = NULL;
+  WlzObjectType	type = WLZ_NULL;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  switch(getc(fP))
+  {
+    case EOF:
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+      break;
+    case WLZ_PLANEINDEX_VERSION:
+      type = (WlzObjectType )getc(fP);
+      break;
+    default:
+      errNum = WLZ_ERR_FILE_FORMAT;
+      break;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    p1 = getword(fP);
+    pl = getword(fP);
+    l1 = getword(fP);
+    ll = getword(fP);
+    k1 = getword(fP);
+    kl = getword(fP);
+    vSz[0] = getfloat(fP);
+    vSz[1] = getfloat(fP);
+    vSz[2] = getfloat(fP);
+    if((vType = getc(fP)) == WLZ_VOXELVALUETABLE_GREY)
+    {
+      bgdV = getword(fP);
+    }
+    recSz = getlong(fP);
+    if(feof(fP) != 0)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else if((type != WLZ_PLANEDOMAIN_DOMAIN) || (pl < p1) || (recSz < 0) ||
+            ((vType != 0) && (vType != WLZ_VOXELVALUETABLE_GREY)))
+    {
+      errNum = WLZ_ERR_FILE_FORMAT;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nPln = pl - p1 + 1;
+    if((recMrk = ftell(fP)) >= 0)
+    {
+      endMrk = recMrk + recSz + (WLZ_PLANEINDEX_ENTRY_SZ * nPln);
+    }
+    /* A range of planes can only be read from a seekable file. */
+    q1 = p1;
+    ql = pl;
+    if(rng && (recMrk >= 0))
+    {
+      q1 = WLZ_MAX(p1, rP1);
+      ql = WLZ_MIN(pl, rLp);
+    }
+    rng = (q1 != p1) || (ql != pl);
+    empty = q1 > ql;
+  }
+  if((errNum == WLZ_ERR_NONE) && empty)
+  {
+    if(fseek(fP, endMrk, SEEK_SET) != 0)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else
+    {
+      obj = WlzMakeEmpty(&errNum);
+    }
+  }
+  else if(errNum == WLZ_ERR_NONE)
+  {
+    nObj = ql - q1 + 1;
+    off = q1 - p1;
+    if((dom.p = WlzMakePlaneDomain(type, q1, ql, l1, ll, k1, kl,
+				   &errNum)) != NULL)
+    {
+      (dom.p->voxel_size)[0] = vSz[0];
+      (dom.p->voxel_size)[1] = vSz[1];
+      (dom.p->voxel_size)[2] = vSz[2];
+      if((obj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, NULL, NULL,
+			    &errNum)) == NULL)
+      {
+	(void )WlzFreePlaneDomain(dom.p);
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (vType != 0))
+    {
+      WlzPixelV	bgd;
+
+      /* As in WlzReadVoxelValues() the background is replaced by that of
+       * the plane value tables once they have been read. */
+      bgd.type = WLZ_GREY_INT;
+      bgd.v.inv = 0;
+      if((val.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY, q1, ql,
+					bgd, obj, &errNum)) != NULL)
+      {
+	val.vox->bckgrnd.v.inv = bgdV;
+	obj->values = WlzAssignValues(val, NULL);
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) &&
+       ((idx = (WlzLong *)AlcMalloc(sizeof(WlzLong) * 4 * nPln)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+#if defined(WLZ_USE_PREAD) && defined(HAVE_FMEMOPEN)
+  if((errNum == WLZ_ERR_NONE) && (empty == 0) && (recMrk >= 0))
+  {
+    int		fd;
+    WlzUByte	*iBuf;
+
+    /* Try to read the index, which fails for streams that can not be
+     * read using pread(), such as pipes. */
+    if(((fd = fileno(fP)) >= 0) &&
+       ((iBuf = (WlzUByte *)AlcMalloc(WLZ_PLANEINDEX_ENTRY_SZ * nPln)) != NULL))
+    {
+      par = WlzReadPread(fd, recMrk + recSz, WLZ_PLANEINDEX_ENTRY_SZ * nPln,
+                         iBuf) == WLZ_ERR_NONE;
+      for(idp = 0; par && (idp < 4 * nPln); ++idp)
+      {
+        idx[idp] = WlzReadLongFromBytes(iBuf + (8 * idp));
+      }
+      AlcFree(iBuf);
+    }
+    if(par && ((errNum = WlzReadIndexedPlanesIdxCheck(idx, nPln,
+                                                      recSz)) != WLZ_ERR_NONE))
+    {
+      par = 0;
+    }
+    if(par)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for(idp = 0; idp < nObj; ++idp)
+      {
+        WlzLong	*ix;
+	WlzUByte *buf = NULL;
+	WlzErrorNum errNum2;
+
+	ix = idx + (4 * (off + idp));
+	if((buf = (WlzUByte *)AlcMalloc(ix[1] + ix[3])) == NULL)
+	{
+	  errNum2 = WLZ_ERR_MEM_ALLOC;
+	}
+	else if((errNum2 = WlzReadPread(fd, recMrk + ix[0], ix[1] + ix[3],
+	                                buf)) == WLZ_ERR_NONE)
+	{
+	  FILE	*mP;
+
+	  if((mP = fmemopen(buf, ix[1] + ix[3], "rb")) == NULL)
+	  {
+	    errNum2 = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else
+	  {
+	    errNum2 = WlzReadIndexedPlane(mP, obj, idp);
+	    (void )fclose(mP);
+	  }
+	}
+	AlcFree(buf);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzReadIndexedPlanes)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+      if((errNum == WLZ_ERR_NONE) && (fseek(fP, endMrk, SEEK_SET) != 0))
+      {
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+    }
+  }
+#endif /* WLZ_USE_PREAD && HAVE_FMEMOPEN */
+  if((errNum == WLZ_ERR_NONE) && (empty == 0) && (par == 0) && rng)
+  {
+    /* Seek to and read the index and then seek to and read each of the
+     * plane records in the range. */
+    if(fseek(fP, recMrk + recSz, SEEK_SET) != 0)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else
+    {
+      for(idp = 0; idp < 4 * nPln; ++idp)
+      {
+	idx[idp] = getlong(fP);
+      }
+      errNum = (feof(fP) != 0)? WLZ_ERR_READ_INCOMPLETE:
+               WlzReadIndexedPlanesIdxCheck(idx, nPln, recSz);
+    }
+    for(idp = 0; (errNum == WLZ_ERR_NONE) && (idp < nObj); ++idp)
+    {
+      if(fseek(fP, recMrk + idx[4 * (off + idp)], SEEK_SET) != 0)
+      {
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+      else
+      {
+        errNum = WlzReadIndexedPlane(fP, obj, idp);
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (fseek(fP, endMrk, SEEK_SET) != 0))
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+  else if((errNum == WLZ_ERR_NONE) && (empty == 0) && (par == 0))
+  {
+    for(idp = 0; (errNum == WLZ_ERR_NONE) && (idp < nPln); ++idp)
+    {
+      errNum = WlzReadIndexedPlane(fP, obj, idp);
+    }
+    /* Read past the index which is not needed when reading in order. */
+    for(idp = 0; (errNum == WLZ_ERR_NONE) && (idp < 4 * nPln); ++idp)
+    {
+      (void )getlong(fP);
+    }
+    if((errNum == WLZ_ERR_NONE) && (feof(fP) != 0))
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+  if((obj != NULL) && (empty == 0) && (obj->values.core != NULL))
+  {
+    WlzValues	*values;
+    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+    /* Reset the voxel table background just as WlzReadVoxelValues()
+     * does, from the last plane value table. */
+    values = obj->values.vox->values;
+    for(idp = 0; (errNum2 == WLZ_ERR_NONE) && (idp < nObj); ++idp)
+    {
+      if(values[idp].core != NULL)
+      {
+	switch(WlzGreyTableTypeToTableType(values[idp].core->type, NULL))
+	{
+	  case WLZ_GREY_TAB_RAGR:
+	    obj->values.vox->bckgrnd = values[idp].v->bckgrnd;
+	    break;
+	  case WLZ_GREY_TAB_RECT:
+	    obj->values.vox->bckgrnd = values[idp].r->bckgrnd;
+	    break;
+	  case WLZ_GREY_TAB_INTL:
+	    obj->values.vox->bckgrnd = values[idp].i->bckgrnd;
+	    break;
+	  default:
+	    errNum2 = WLZ_ERR_VALUES_TYPE;
+	    break;
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = errNum2;
+    }
+  }
+  AlcFree(idx);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Checks that the entries of a plane index are consistent
+* 		with each other and with the size of the plane records.
+* \param	idx			Plane index with four entries (domain
+* 					offset, domain size, values offset
+* 					and values size) for each plane.
+* \param	nPln			Number of planes.
+* \param	recSz			Size of the plane records.
+*/
+static WlzErrorNum WlzReadIndexedPlanesIdxCheck(WlzLong *idx, int nPln,
+						WlzLong recSz)
+{
+  int		idp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(idp = 0; idp < nPln; ++idp)
+  {
+    WlzLong	*ix;
+
+    ix = idx + (4 * idp);
+    if((ix[0] < 0) || (ix[1] < 1) || (ix[3] < 0) ||
+       (ix[2] != ix[0] + ix[1]) || (ix[2] + ix[3] > recSz))
+    {
+      errNum = WLZ_ERR_FILE_FORMAT;
+      break;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads the interval domain and value table of a single
+* 		plane record of an indexed 3D domain object, setting the
+* 		plane's domain and values in the given object.
+* \param	fP			Input file or memory stream
+* 					positioned at the start of the
+* 					plane record.
+* \param	obj			Given 3D domain object with a plane
+* 					domain and either no values or a
+* 					voxel value table.
+* \param	pIdx			Plane index, relative to the first
+* 					plane of the object.
+*/
+static WlzErrorNum WlzReadIndexedPlane(FILE *fP, WlzObject *obj, int pIdx)
+{
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*tObj;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  val.core = NULL;
+  if((dom.i = WlzReadIntervalDomain(fP, &errNum)) != NULL)
+  {
+    obj->domain.p->domains[pIdx] = WlzAssignDomain(dom, NULL);
+  }
+  else if(errNum == WLZ_ERR_EOO)
+  {
+    errNum = WLZ_ERR_NONE;
+  }
+  if((errNum == WLZ_ERR_NONE) && (obj->values.core != NULL))
+  {
+    if((tObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL,
+			   &errNum)) != NULL)
+    {
+      if((errNum = WlzReadDomObjValues2D(fP, tObj)) == WLZ_ERR_NONE)
+      {
+	obj->values.vox->values[pIdx] = WlzAssignValues(tObj->values, NULL);
+      }
+      else if(dom.core != NULL)
+      {
+	(void )WlzFreeDomain(dom);
+	obj->domain.p->domains[pIdx].core = NULL;
+      }
+      (void )WlzFreeObj(tObj);
+    }
+  }
+  return(errNum);
+}
+
+#if defined(WLZ_USE_PREAD) && defined(HAVE_FMEMOPEN)
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads the given number of bytes from the given offset of
+* 		a file descriptor using pread(), so that any number of
+* 		threads may read concurrently.
+* \param	fd			File descriptor.
+* \param	off			Offset in the file.
+* \param	nB			Number of bytes to read.
+* \param	buf			Destination buffer.
+*/
+static WlzErrorNum WlzReadPread(int fd, WlzLong off, size_t nB, WlzUByte *buf)
+{
+  size_t	n = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  while((errNum == WLZ_ERR_NONE) && (n < nB))
+  {
+    ssize_t	m;
+
+    m = pread(fd, buf + n, nB - n, (off_t )(off + n));
+    if(m > 0)
+    {
+      n += m;
+    }
+    else if((m == 0) || (errno != EINTR))
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+  return(errNum);
+}
+#endif /* WLZ_USE_PREAD && HAVE_FMEMOPEN */
+
 /*!
 * \return	New Woolz property.
 * \ingroup	WlzIO
@@ -3099,12 +3880,7 @@ static WlzIRect *WlzReadRect(FILE *fp, WlzErrorNum *dstErr)
 	  break;
 	}
 	ir->type = type;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-	{
-	  ir->linkcount = 0;
-	}
+	ir->linkcount = 0;
 	ir->freeptr = NULL;
 	for(i=0; i < 4; i++){
 	  ir->irk[i] = getword(fp);
@@ -3121,12 +3897,7 @@ static WlzIRect *WlzReadRect(FILE *fp, WlzErrorNum *dstErr)
 	  break;
 	}
 	fr->type = type;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-	{
-	  fr->linkcount = 0;
-	}
+	fr->linkcount = 0;
 	fr->freeptr = NULL;
 	for(i=0; i < 4; i++){
 	  fr->frk[i] = getfloat(fp);
@@ -3381,12 +4152,7 @@ static WlzAffineTransform *WlzReadAffineTransform(FILE *fp,
   else if((trans = WlzMakeAffineTransform(type, &errNum)) != NULL){
 
     /* set linkcount and freeptr */
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      trans->linkcount = 0;
-    }
+    trans->linkcount = 0;
     trans->freeptr   = NULL;
 
     /* This code has been commented out rather than removed, just incase
@@ -3461,12 +4227,7 @@ static WlzWarpTrans *WlzReadWarpTrans(FILE *fp, WlzErrorNum *dstErr)
   }
   else {
     obj->type = type;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      obj->linkcount = 0;
-    }
+    obj->linkcount = 0;
 
     obj->nelts = getword(fp);
     obj->nodes = getword(fp);
@@ -3581,12 +4342,7 @@ static WlzFMatchObj *WlzReadFMatchObj(FILE *fp,
   }
   else {
     obj->type = WLZ_FMATCHOBJ;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      obj->linkcount = 0;
-    }
+    obj->linkcount = 0;
 
     obj->nopts = getword(fp);
     if( feof(fp) != 0 ){
@@ -3651,12 +4407,7 @@ static Wlz3DWarpTrans *WlzRead3DWarpTrans(FILE *fp, WlzErrorNum *dstErr)
   }
   else {
     obj->type = WLZ_3D_WARP_TRANS;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      obj->linkcount = 0;
-    }
+    obj->linkcount = 0;
     obj->iteration = getword(fp);
     obj->currentplane = getword(fp);
     obj->maxdisp = getfloat(fp);
@@ -3673,12 +4424,7 @@ static Wlz3DWarpTrans *WlzRead3DWarpTrans(FILE *fp, WlzErrorNum *dstErr)
       obj = NULL;
     }
     else {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-      {
-        obj->pdom->linkcount = 1;
-      }
+      obj->pdom->linkcount = 1;
       nplanes = obj->pdom->lastln - obj->pdom->line1 + 1;
       if( (obj->intptdoms = (WlzFMatchObj **)
 	   AlcMalloc(sizeof(WlzFMatchObj *) * nplanes)) == NULL ){
@@ -3691,12 +4437,7 @@ static Wlz3DWarpTrans *WlzRead3DWarpTrans(FILE *fp, WlzErrorNum *dstErr)
 	intdoms = obj->intptdoms;
 	for(i=obj->pdom->plane1; i<=obj->pdom->lastpl; i++, intdoms++){
 	  if( (*intdoms = WlzReadFMatchObj(fp, &errNum)) ){
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-	    {
-	      (*intdoms)->linkcount = 1;
-	    }
+	    (*intdoms)->linkcount = 1;
 	  }
 	  else if( errNum != WLZ_ERR_EOO ){
 	    WlzFree3DWarpTrans(obj);
@@ -4154,12 +4895,7 @@ WlzMeshTransform *WlzReadMeshTransform2D(FILE *fp,
   else
   {
     obj->type = WLZ_TRANSFORM_2D_MESH;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      obj->linkcount = 0;
-    }
+    obj->linkcount = 0;
 
     obj->nElem = getword(fp);
     obj->nNodes = getword(fp);
@@ -844,10 +844,8 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
     aBox.yMax = WLZ_MAX(pBox[0].yMax, pBox[1].yMax) + (int )(maxTran.vtY) + 1;
     aOrg.vtX = aBox.xMin;
     aOrg.vtY = aBox.yMin;
-    aSz.vtX = aBox.xMax - aBox.xMin + 1;
-    aSz.vtY = aBox.yMax - aBox.yMin + 1;
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtX), aSz.vtX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtY), aSz.vtY);
+    aSz.vtX = AlgFourGoodSize(aBox.xMax - aBox.xMin + 1);
+    aSz.vtY = AlgFourGoodSize(aBox.yMax - aBox.yMin + 1);
     oIdx = 0;
     while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
     {
@@ -1105,10 +1103,8 @@ static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
     aBox.yMax += rotPad.vtY;
     aOrg.vtX = aBox.xMin;
     aOrg.vtY = aBox.yMin;
-    aSz.vtX = aBox.xMax - aBox.xMin + 1;
-    aSz.vtY = aBox.yMax - aBox.yMin + 1;
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtX), aSz.vtX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtY), aSz.vtY);
+    aSz.vtX = AlgFourGoodSize(aBox.xMax - aBox.xMin + 1);
+    aSz.vtY = AlgFourGoodSize(aBox.yMax - aBox.yMin + 1);
     oIdx = 0;
     while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
     {
@@ -52,6 +52,13 @@ static char _WlzRegICP_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
+/*!
+* \ingroup	WlzTransform
+* \brief	Minimum number of source vertices at the coarsest level
+*		of a multi-resolution ICP registration.
+*/
+#define WLZ_REGICP_MR_MINVTX	(256)
+
 /*!
 * \struct	_WlzRegICPWSp
 * \ingroup      WlzTransform
@@ -95,6 +102,12 @@ static void     		WlzRegICPTrans(
 				  WlzRegICPWSp *wSp);
 static void			WlzRegICPFindNN(
 				  WlzRegICPWSp *wSp);
+static int			WlzRegICPLevel(
+				  WlzRegICPWSp *wSp,
+			          WlzTransformType trType,
+				  int maxItr,
+				  double minDistWgt,
+				  WlzErrorNum *dstErr);
 static int			WlzRegICPItr(
 				  WlzRegICPWSp *wSp,
 			          WlzTransformType trType,
@@ -325,6 +338,8 @@ WlzAffineTransform *WlzRegICPObjsGrd(WlzObject *tObj, WlzObject *sObj,
 * 		closest point algorithm. An affine transform is
 *		computed, which when applied to the source object
 *		takes it into register with the target object.
+*		This function is equivalent to WlzRegICPObjsMR()
+*		with a single level.
 * \param	tObj			The target object.
 * \param	sObj			The source object to be
 *					registered with target object.
@@ -354,6 +369,56 @@ WlzAffineTransform *WlzRegICPObjs(WlzObject *tObj, WlzObject *sObj,
 				  int *dstConv, int *dstItr, int maxItr,
 				  int noNrm, double delta, double minDistWgt,
 				  WlzErrorNum *dstErr)
+{
+  WlzAffineTransform *regTr;
+
+  regTr = WlzRegICPObjsMR(tObj, sObj, initTr, trType, dstConv, dstItr,
+  			  maxItr, noNrm, delta, minDistWgt, 1, dstErr);
+  return(regTr);
+}
+
+/*!
+* \return				Affine transform which brings
+*					the two objects into register.
+* \ingroup	WlzTransform
+* \brief	Registers the two given objects using the iterative
+* 		closest point algorithm. An affine transform is
+*		computed, which when applied to the source object
+*		takes it into register with the target object.
+*		See WlzRegICPVerticesMR() for the multi-resolution
+*		registration.
+* \param	tObj			The target object.
+* \param	sObj			The source object to be
+*					registered with target object.
+* \param	initTr			Initial affine transform
+*					to be applied to the source
+*					object prior to using the ICP
+*					algorithm. May be NULL.
+* \param	trType			Required transform type.
+* \param	dstConv			Destination ptr for the
+*					convergence flag (non zero
+*					on convergence), may be NULL.
+* \param	dstItr			Destination ptr for the number
+*					of iterations, may be NULL.
+* \param	maxItr			Maximum number of iterations,
+*					if <= 0 then infinite iterations
+*					are allowed.
+* \param	noNrm			Don't weight using normals if non-zero.
+* \param	delta			Tolerance for mean value of
+*					registration metric.
+* \param	minDistWgt		Minimum distance weighting.
+* \param	nLvl			Number of resolution levels, values
+*					less than two give a single full
+*					resolution registration.
+* \param	dstErr			Destination error pointer,
+*					may be NULL.
+*/
+WlzAffineTransform *WlzRegICPObjsMR(WlzObject *tObj, WlzObject *sObj,
+				  WlzAffineTransform *initTr,
+				  WlzTransformType trType,
+				  int *dstConv, int *dstItr, int maxItr,
+				  int noNrm, double delta, double minDistWgt,
+				  int nLvl, WlzErrorNum *dstErr)
 {
   int		idx,
 		conv,
@@ -410,11 +475,11 @@ WlzAffineTransform *WlzRegICPObjs(WlzObject *tObj, WlzObject *sObj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-     regTr = WlzRegICPVertices(vData[0], nData[0], vCnt[0],
-     			       vData[1], nData[1], vCnt[1],
-     			       vType[0], sgnNrm, initTr,
-			       trType, &conv, &itr, maxItr,
-			       delta, minDistWgt, &errNum);
+     regTr = WlzRegICPVerticesMR(vData[0], nData[0], vCnt[0],
+     			         vData[1], nData[1], vCnt[1],
+     			         vType[0], sgnNrm, initTr,
+			         trType, &conv, &itr, maxItr,
+			         delta, minDistWgt, nLvl, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -715,6 +780,8 @@ static WlzErrorNum WlzRegICPCheckVertices(WlzVertexP *vData, int *vCnt,
 *		takes it into register with the target vertices.
 *		The vertices and their normals are known to be either
 *		WlzDVertex2 or WlzDVertex3.
+*		This function is equivalent to WlzRegICPVerticesMR()
+*		with a single level.
 * \param	tVx			Target vertices.
 * \param	tNr			Target normals, may be NULL.
 * \param	tCnt			Number of target vertices.
@@ -756,8 +823,87 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
 					    double minDistWgt,
 					    WlzErrorNum *dstErr)
 {
-  int		conv = 0,
-		maxCnt = 0;
+  WlzAffineTransform *regTr;
+
+  regTr = WlzRegICPVerticesMR(tVx, tNr, tCnt, sVx, sNr, sCnt, vType, sgnNrm,
+  			      initTr, trType, dstConv, dstItr, maxItr,
+			      delta, minDistWgt, 1, dstErr);
+  return(regTr);
+}
+
+/*!
+* \return				Affine transform which brings
+*					the two sets of vertices into
+*					register.
+* \ingroup	WlzTransform
+* \brief	Registers the two given sets of vertices using the
+*		iterative closest point algorithm. An affine transform
+*		is computed, which when applied to the source vertices
+*		takes it into register with the target vertices.
+*		The vertices and their normals are known to be either
+*		WlzDVertex2 or WlzDVertex3.
+*		If more than one level is given then the registration
+*		is coarse to fine: at each level the source vertices
+*		are subsampled by a factor of four more than at the
+*		next finer level and the transform found at a coarse
+*		level is used to start the next finer level. The
+*		target vertices are always used at full resolution.
+*		Failure to converge at a coarse level is not an error.
+*		The number of levels is reduced if required so that
+*		the coarsest level has at least WLZ_REGICP_MR_MINVTX
+*		source vertices.
+* \param	tVx			Target vertices.
+* \param	tNr			Target normals, may be NULL.
+* \param	tCnt			Number of target vertices.
+* \param	sVx			Source vertices.
+* \param	sNr			Source normals, may be NULL.
+* \param	sCnt			Number of source vertices.
+* \param	vType			Type of the vertices.
+* \param	sgnNrm			Non zero if the normals have reliably
+*					signed components.
+* \param	initTr			Initial affine transform
+*					to be applied to the source
+*					object prior to using the ICP
+*					algorithm. May be NULL.
+* \param	trType			Required transform type.
+* \param	dstConv			Destination ptr for the
+*					convergence flag (non zero
+*					on convergence), may be NULL.
+* \param	dstItr			Destination ptr for the total
+*					number of iterations over all
+*					levels, may be NULL.
+* \param	maxItr			Maximum number of iterations,
+*					if <= 0 then infinite iterations
+*					are allowed.
+* \param	delta			Tolerance for mean value of
+*					registration metric.
+* \param	minDistWgt		Minimum distance weighting.
+* \param	nLvl			Number of resolution levels, values
+*					less than two give a single full
+*					resolution registration.
+* \param	dstErr			Destination error pointer,
+*					may be NULL.
+*/
+WlzAffineTransform	*WlzRegICPVerticesMR(WlzVertexP tVx, WlzVertexP tNr,
+					    int tCnt,
+					    WlzVertexP sVx, WlzVertexP sNr,
+					    int sCnt,
+					    WlzVertexType vType, int sgnNrm,
+					    WlzAffineTransform *initTr,
+					    WlzTransformType trType,
+					    int *dstConv, int *dstItr,
+					    int maxItr,
+				     	    double delta,
+					    double minDistWgt,
+					    int nLvl,
+					    WlzErrorNum *dstErr)
+{
+  int		lvl,
+		conv = 0,
+		maxCnt = 0,
+		totItr = 0;
+  WlzVertexP	subSVx,
+  		subSNr;
   WlzAffineTransform *regTr = NULL;
   WlzRegICPWSp	wSp;
   WlzErrorNum 	errNum = WLZ_ERR_NONE;
@@ -786,7 +932,18 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
   wSp.wgt = NULL;
   wSp.prvTr = NULL;
   wSp.curTr = NULL;
+  subSVx.v = NULL;
+  subSNr.v = NULL;
   maxCnt = WLZ_MAX(tCnt, sCnt);
+  /* Limit the number of levels so that the coarsest has enough source
+   * vertices. */
+  lvl = 1;
+  while((lvl < nLvl) &&
+        ((sCnt >> (2 * lvl)) >= WLZ_REGICP_MR_MINVTX))
+  {
+    ++lvl;
+  }
+  nLvl = lvl;
   if(((wSp.sNN = (int *)AlcMalloc(sizeof(int) * maxCnt)) == NULL) ||
      ((wSp.dist = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL) ||
      ((wSp.wgt = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL))
@@ -850,33 +1007,75 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
       }
     }
   }
+  if((errNum == WLZ_ERR_NONE) && (nLvl > 1))
+  {
+    /* Allocate buffers for the subsampled source vertices and normals,
+     * the finest subsampled level being the largest. */
+    size_t	vSz;
+
+    vSz = (vType == WLZ_VERTEX_D2)? sizeof(WlzDVertex2): sizeof(WlzDVertex3);
+    if(((subSVx.v = AlcMalloc(vSz * ((sCnt + 3) / 4))) == NULL) ||
+       ((sNr.v != NULL) &&
+        ((subSNr.v = AlcMalloc(vSz * ((sCnt + 3) / 4))) == NULL)))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
   if(errNum == WLZ_ERR_NONE)
   {
     /* Build k-D tree for the target vertices. */
     errNum = WlzRegICPBuildTree(&wSp);
   }
-  if(errNum == WLZ_ERR_NONE)
+  lvl = nLvl - 1;
+  while((errNum == WLZ_ERR_NONE) && (lvl >= 0))
   {
-    switch(trType)
+    if(lvl > 0)
     {
-      case WLZ_TRANSFORM_2D_AFFINE:
-      case WLZ_TRANSFORM_3D_AFFINE:
-        conv = WlzRegICPItr(&wSp, (trType == WLZ_TRANSFORM_2D_AFFINE)?
-			           WLZ_TRANSFORM_2D_REG: WLZ_TRANSFORM_3D_REG,
-				   maxItr, minDistWgt, &errNum);
-	if(conv && (errNum == WLZ_ERR_NONE))
+      int	idx,
+      		stride;
+
+      /* Subsample the source vertices and normals for this level. */
+      stride = 1 << (2 * lvl);
+      wSp.nS = (sCnt + stride - 1) / stride;
+      for(idx = 0; idx < wSp.nS; ++idx)
+      {
+        if(vType == WLZ_VERTEX_D2)
+	{
+	  subSVx.d2[idx] = sVx.d2[idx * stride];
+	  if(sNr.v)
+	  {
+	    subSNr.d2[idx] = sNr.d2[idx * stride];
+	  }
+	}
+	else /* vType == WLZ_VERTEX_D3 */
 	{
-          conv = WlzRegICPItr(&wSp, trType, maxItr, minDistWgt, &errNum);
+	  subSVx.d3[idx] = sVx.d3[idx * stride];
+	  if(sNr.v)
+	  {
+	    subSNr.d3[idx] = sNr.d3[idx * stride];
+	  }
 	}
-        break;
-      case WLZ_TRANSFORM_2D_REG:
-      case WLZ_TRANSFORM_3D_REG:
-        conv = WlzRegICPItr(&wSp, trType, maxItr, minDistWgt, &errNum);
-        break;
-      default:
-        errNum = WLZ_ERR_DOMAIN_TYPE;
-	break;
+      }
+      wSp.gSVx = subSVx;
+      wSp.gSNr = subSNr;
+    }
+    else
+    {
+      wSp.nS = sCnt;
+      wSp.gSVx = sVx;
+      wSp.gSNr = sNr;
     }
+    wSp.nMatch = WLZ_MIN(tCnt, wSp.nS);
+    wSp.itr = 0;
+    wSp.curMetric = DBL_MAX;
+    wSp.prvMetric = DBL_MAX;
+    conv = WlzRegICPLevel(&wSp, trType, maxItr, minDistWgt, &errNum);
+    totItr += wSp.itr;
+    if((lvl > 0) && (errNum == WLZ_ERR_ALG_CONVERGENCE))
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    --lvl;
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -886,9 +1085,12 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
     }
     if(dstItr)
     {
-      *dstItr = wSp.itr;
+      *dstItr = totItr;
     }
   }
+  AlcFree(subSVx.v);
+  AlcFree(subSNr.v);
+  (void )AlcKDTTreeFree(wSp.tTree);
   AlcFree(wSp.sNN);
   AlcFree(wSp.dist);
   AlcFree(wSp.wgt);
@@ -1099,6 +1301,7 @@ WlzObject	*WlzRegICPVerticesWSD2D(WlzVertexP tVx, WlzVertexP tNr,
   AlcFree(wSp.tSVx.v);
   AlcFree(wSp.tSNr.v);
   AlcFree(wSp.nNTVx.v);
+  (void )AlcKDTTreeFree(wSp.tTree);
   (void )WlzFreeAffineTransform(wSp.curTr);
   if(errNum != WLZ_ERR_NONE)
   {
@@ -1135,6 +1338,55 @@ static WlzErrorNum WlzRegICPBuildTree(WlzRegICPWSp *wSp)
   return(errNum);
 }
 
+/*!
+* \return				Nonzero if the iteration has
+* 					converged.
+* \ingroup	WlzTransform
+* \brief	Iterates to find the registration transform of the
+*		required type using the current source vertices of
+*		the workspace. For affine transforms a rigid body
+*		registration is found first and this is then refined.
+* \param	wSp			ICP registration workspace.
+* \param	trType			Required transform type.
+* \param	maxItr			Maximum number of iterations.
+* \param	minDistWgt		Minimum distance weighting.
+* \param	dstErr			Destination error pointer,
+*					may be NULL.
+*/
+static int	WlzRegICPLevel(WlzRegICPWSp *wSp,
+			       WlzTransformType trType, int maxItr,
+			       double minDistWgt, WlzErrorNum *dstErr)
+{
+  int		conv = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(trType)
+  {
+    case WLZ_TRANSFORM_2D_AFFINE:
+    case WLZ_TRANSFORM_3D_AFFINE:
+      conv = WlzRegICPItr(wSp, (trType == WLZ_TRANSFORM_2D_AFFINE)?
+			       WLZ_TRANSFORM_2D_REG: WLZ_TRANSFORM_3D_REG,
+			       maxItr, minDistWgt, &errNum);
+      if(conv && (errNum == WLZ_ERR_NONE))
+      {
+	conv = WlzRegICPItr(wSp, trType, maxItr, minDistWgt, &errNum);
+      }
+      break;
+    case WLZ_TRANSFORM_2D_REG:
+    case WLZ_TRANSFORM_3D_REG:
+      conv = WlzRegICPItr(wSp, trType, maxItr, minDistWgt, &errNum);
+      break;
+    default:
+      errNum = WLZ_ERR_DOMAIN_TYPE;
+      break;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(conv);
+}
+
 /*!
 * \return				Nonzero if the iteration has
 * 					converged.
@@ -1172,7 +1424,7 @@ static int	WlzRegICPItr(WlzRegICPWSp *wSp,
 #ifdef WLZ_REGICP_DEBUG
     (void )fprintf(stderr, "WlzRegICP conv = %s\n", (conv)? "TRUE": "FALSE");
 #endif /* WLZ_REGICP_DEBUG */
-    if(conv && (wSp->itr > 1))
+    if(conv && (wSp->itr > 1) && (wSp->prvTr != NULL))
     {
       (void )WlzFreeAffineTransform(wSp->curTr);
       wSp->curTr = wSp->prvTr;
@@ -1208,14 +1460,14 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
 
   if(wSp->vType == WLZ_VERTEX_D2)
   {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for(idx = 0; idx < wSp->nS; ++idx)
     {
       *(wSp->tSVx.d2 + idx) = WlzAffineTransformVertexD2(wSp->curTr,
       						*(wSp->gSVx.d2 + idx), NULL);
-    }
-    if(wSp->gSNr.v)
-    {
-      for(idx = 0; idx < wSp->nS; ++idx)
+      if(wSp->gSNr.v)
       {
         *(wSp->tSNr.d2 + idx) = WlzAffineTransformNormalD2(wSp->curTr,
 						*(wSp->gSNr.d2 + idx), NULL);
@@ -1224,14 +1476,14 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
   }
   else /* wSp->vType == WLZ_VERTEX_D3 */
   {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for(idx = 0; idx < wSp->nS; ++idx)
     {
       *(wSp->tSVx.d3 + idx) = WlzAffineTransformVertexD3(wSp->curTr,
       						*(wSp->gSVx.d3 + idx), NULL);
-    }
-    if(wSp->gSNr.v)
-    {
-      for(idx = 0; idx < wSp->nS; ++idx)
+      if(wSp->gSNr.v)
       {
         *(wSp->tSNr.d3 + idx) = WlzAffineTransformNormalD3(wSp->curTr,
 						*(wSp->gSNr.d3 + idx), NULL);
@@ -1252,13 +1504,19 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
 static void	WlzRegICPFindNN(WlzRegICPWSp *wSp)
 {
   int		idx;
-  WlzDVertex2	tVD2;
-  WlzDVertex3	tVD3;
-  double	datD[3];
-  AlcKDTNode	*node;
 
+  /* The tree is not modified by queries so they may be made in
+   * parallel. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
   for(idx = 0; idx < wSp->nMatch; ++idx)
   {
+    WlzDVertex2	tVD2;
+    WlzDVertex3	tVD3;
+    double	datD[3];
+    AlcKDTNode	*node;
+
     if(wSp->vType == WLZ_VERTEX_D2)
     {
       tVD2 = *(wSp->tSVx.d2 + idx);
@@ -1327,37 +1585,39 @@ static void	WlzRegICPFindNN(WlzRegICPWSp *wSp)
 static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
 {
   int		idx;
-  double	tD0,
-		w0,
+  double	w0,
 		w1,
 		w2,
-  		wVx,
 		minDist,
 		maxDist,
-		wNr = 0.0,
 		meanSumWgt = 0.0;
-  WlzVertex	sV,
-  		tV;
 
   /* Find the maximum and minimum distances. */
   minDist = maxDist = *(wSp->dist + 0);
   for(idx = 1; idx < wSp->nMatch; ++idx)
   {
-    if((tD0 = *(wSp->dist + idx)) < minDist)
-    {
-      minDist = tD0;
-    }
-    else if(tD0 > maxDist)
-    {
-      maxDist = tD0;
-    }
+    double	d;
+
+    d = *(wSp->dist + idx);
+    minDist = WLZ_MIN(minDist, d);
+    maxDist = WLZ_MAX(maxDist, d);
   }
-  /* Compute weights. */
+  /* Compute weights, each of which depends only on its own match so
+   * they may be computed in parallel. */
   w0 = maxDist - minDist;
   w1 = 1.0 - minVxWgt;
   w2 = (w0 > DBL_EPSILON)? w1 / w0: 1.0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
   for(idx = 0; idx < wSp->nMatch; ++idx)
   {
+    double	tD0,
+    		wVx,
+		wNr = 0.0;
+    WlzVertex	sV,
+  		tV;
+
     /* Use linear weighting for distance such that:
      *   w = minVxWgt, d = maxDist
      * and
@@ -1405,9 +1665,14 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
 	tD0 = wVx * wNr * wNr;
       }
     }
-    meanSumWgt += tD0 * *(wSp->dist + idx);
     *(wSp->wgt + idx) = tD0;
   }
+  /* Sum in index order so that the metric does not depend on the
+   * number of threads. */
+  for(idx = 0; idx < wSp->nMatch; ++idx)
+  {
+    meanSumWgt += *(wSp->wgt + idx) * *(wSp->dist + idx);
+  }
   meanSumWgt /= wSp->nMatch;
   return(meanSumWgt);
 }
@@ -1785,7 +2050,7 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	  {
 	    wMinDist = dist;
 	  }
-	  else if(wMaxDist < dist)
+	  if(wMaxDist < dist)
 	  {
 	    wMaxDist = dist;
 	  }
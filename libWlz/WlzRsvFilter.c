@@ -44,14 +44,39 @@ static char _WlzRsvFilter_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* These tests are for debuging only. */
 /* #define WLZ_RSVFILTER_TEST_1D */
 /* #define WLZ_RSVFILTER_TEST_2D */
 /* #define WLZ_RSVFILTER_TEST_3D */
 
-static WlzObject *WlzRsvFilterObj2DX(WlzObject *, WlzRsvFilter *,
+#define WLZ_RSVFILTER_LNGRP	(8) 	/* Maximum number of lines filtered
+					   together in lockstep. */
+
+/*!
+* \struct	_WlzRsvFilterItv
+* \ingroup	WlzValueFilters
+* \brief	An interval of a plane which has been copied into the
+* 		buffers of the through plane filter, but which has yet
+* 		to be filtered.
+*		Typedef: ::WlzRsvFilterItv.
+*/
+typedef struct _WlzRsvFilterItv
+{
+  WlzIVertex3	bufPos;		/*!< Position of the interval within the
+  				     buffers. */
+  int		itvLen;		/*!< Interval length. */
+  WlzGreyP	dstGP;		/*!< Destination values of the interval. */
+} WlzRsvFilterItv;
+
+static WlzObject *WlzRsvFilterObj2D(WlzObject *, int, WlzRsvFilter *,
+				    int, WlzErrorNum *);
+static WlzObject *WlzRsvFilterObj2DX(WlzObject *, int, WlzRsvFilter *,
 				     WlzErrorNum *);
-static WlzObject *WlzRsvFilterObj2DY(WlzObject *, WlzRsvFilter *,
+static WlzObject *WlzRsvFilterObj2DY(WlzObject *, int, WlzRsvFilter *,
 				     WlzErrorNum *);
 static WlzObject *WlzRsvFilterObj3DXY(WlzObject *, WlzRsvFilter *,
 			              int, WlzErrorNum *);
@@ -60,6 +85,18 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *, WlzRsvFilter *,
 static void	WlzRsvFilterFilterBufXF(WlzRsvFilter *,
 				      double *, double *, double *,
 				      int);
+static void	WlzRsvFilterFilterBufXG(WlzRsvFilter *,
+				      double *, double *, double *,
+				      int, int);
+static void	WlzRsvFilterFlushXG(WlzRsvFilter *ftr,
+				    double *datBuf,
+				    double *lnBuf0,
+				    double *lnBuf1,
+				    double *lnBufT,
+				    WlzGreyP *dstGP,
+				    WlzGreyType dstGType,
+				    int itvLen,
+				    int nLn);
 static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *,
 				      double **, double **, WlzUByte **,
 				      WlzIVertex2, int, int);
@@ -230,6 +267,16 @@ WlzRsvFilter *WlzRsvFilterMakeFilter(WlzRsvFilterName name,
 * \return	The filtered object, or NULL on error.
 * \ingroup	WlzValueFilters
 * \brief	Applies a recursive filter to the given object.
+*		The filter is applied along the lines in groups of lines
+*		with the same interval length, the groups being filtered
+*		together in lockstep. Through the columns and planes the
+*		filter is applied to all columns of a line or plane
+*		together. The planes of 3D objects are filtered in
+*		parallel along the lines and through the columns, with
+*		the intervals of each plane filtered in parallel through
+*		the planes. The given object may have either plain or
+*		tiled values, but the filtered object always has plain
+*		values.
 * \param	srcObj			Given object.
 * \param	ftr			Recursive filter.
 * \param	actionMsk		Action mask.
@@ -240,9 +287,7 @@ WlzObject	*WlzRsvFilterObj(WlzObject *srcObj, WlzRsvFilter *ftr,
 			         int actionMsk, WlzErrorNum *dstErr)
 {
   WlzValues	tVal;
-  WlzObject	*xObj = NULL,
-		*yObj = NULL,
-		*xyObj = NULL,
+  WlzObject	*xyObj = NULL,
 		*zObj = NULL,
   		*dstObj = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -259,10 +304,6 @@ WlzObject	*WlzRsvFilterObj(WlzObject *srcObj, WlzRsvFilter *ftr,
   {
     errNum = WLZ_ERR_VALUES_NULL;
   }
-  else if(WlzGreyTableIsTiled(srcObj->values.core->type))
-  {
-    errNum = WLZ_ERR_VALUES_TYPE;
-  }
   else
   {
     switch(srcObj->type)
@@ -274,38 +315,7 @@ WlzObject	*WlzRsvFilterObj(WlzObject *srcObj, WlzRsvFilter *ftr,
 	if((actionMsk & (WLZ_RSVFILTER_ACTION_X |
 			 WLZ_RSVFILTER_ACTION_Y)) != 0)
 	{
-	  /* Filter in each required direction. */
-	  if((actionMsk & WLZ_RSVFILTER_ACTION_X) != 0)
-	  {
-	    xObj = WlzRsvFilterObj2DX(srcObj, ftr, &errNum);
-	  }
-	  if((errNum == WLZ_ERR_NONE) &&
-	     ((actionMsk & WLZ_RSVFILTER_ACTION_Y) != 0))
-	  {
-	    yObj = WlzRsvFilterObj2DY((xObj)? xObj: srcObj,
-	    		              ftr, &errNum);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    if(yObj)
-	    {
-	      dstObj = yObj;
-	      yObj = NULL;
-	    }
-	    else if(xObj)
-	    {
-	      dstObj = xObj;
-	      xObj = NULL;
-	    }
-	  }
-	  if(xObj)
-	  {
-	    WlzFreeObj(xObj);
-	  }
-	  if(yObj)
-	  {
-	    WlzFreeObj(yObj);
-	  }
+	  dstObj = WlzRsvFilterObj2D(srcObj, 0, ftr, actionMsk, &errNum);
 	}
 	else
 	{
@@ -470,6 +480,160 @@ static void	WlzRsvFilterFilterBufXF(WlzRsvFilter *ftr, double *data,
   }
 }
 
+/*!
+* \return	void
+* \ingroup	WlzValueFilters
+* \brief	Filters a group of lines, all of the same length, using
+*		an IIR filter defined by the filter coefficients and
+*		double precision arithmetic. The lines are interleaved
+*		in the buffers so that the recurrences of the lines are
+*		evaluated in lockstep, with the inner loops over the
+*		lines being free of dependencies. For each of the lines
+*		the arithmetic is exactly that of WlzRsvFilterFilterBufXF().
+* \param	ftr			The filter.
+* \param	data			The interleaved lines of data to be
+*					filtered, with element i of line j
+*					at data[(i * nLn) + j].
+* \param	buf0			Buffer with at least dataSz * nLn
+*                                       elements.
+* \param	buf1			Buffer with at least dataSz * nLn
+*                                       elements.
+* \param	dataSz			Number of data in each line.
+* \param	nLn			Number of lines, which must not be
+*					greater than WLZ_RSVFILTER_LNGRP.
+*/
+static void	WlzRsvFilterFilterBufXG(WlzRsvFilter *ftr, double *data,
+				      double *buf0, double *buf1,
+				      int dataSz, int nLn)
+{
+  int		idi,
+  		idj;
+  double	a0,
+  		a1,
+		a2,
+		a3,
+		b0,
+		b1,
+		c;
+  const int	nS = WLZ_RSVFILTER_LNGRP;
+  double	*dP,
+  		*fP;
+
+  a0 = ftr->a[0];
+  a1 = ftr->a[1];
+  a2 = ftr->a[2];
+  a3 = ftr->a[3];
+  b0 = ftr->b[0];
+  b1 = ftr->b[1];
+  c = ftr->c;
+  /* Causal pass. */
+  for(idj = 0; idj < nLn; ++idj)
+  {
+    buf0[idj] = (a0 + a1) * data[idj] / (b0 + b1 + 1);
+  }
+  if(dataSz > 1)
+  {
+    dP = data + nS;
+    fP = buf0 + nS;
+    for(idj = 0; idj < nLn; ++idj)
+    {
+      fP[idj] = (a0 * dP[idj]) + (a1 * dP[idj - nS]) -
+                (b0 * fP[idj - nS]) - (b1 * fP[idj - nS]);
+    }
+    for(idi = 2; idi < dataSz; ++idi)
+    {
+      dP += nS;
+      fP += nS;
+      for(idj = 0; idj < nLn; ++idj)
+      {
+	fP[idj] = (a0 * dP[idj]) + (a1 * dP[idj - nS]) -
+		  (b0 * fP[idj - nS]) - (b1 * fP[idj - (2 * nS)]);
+      }
+    }
+  }
+  /* Anti-causal pass. */
+  dP = data + ((dataSz - 1) * nS);
+  fP = buf1 + ((dataSz - 1) * nS);
+  for(idj = 0; idj < nLn; ++idj)
+  {
+    fP[idj] = (a2 + a3) * dP[idj] / (b0 + b1 + 1);
+  }
+  if(dataSz > 1)
+  {
+    fP -= nS;
+    for(idj = 0; idj < nLn; ++idj)
+    {
+      fP[idj] = (a2 * dP[idj]) + (a3 * dP[idj]) -
+                (b0 * fP[idj + nS]) - (b1 * fP[idj + nS]);
+    }
+    for(idi = dataSz - 3; idi >= 0; --idi)
+    {
+      dP -= nS;
+      fP -= nS;
+      for(idj = 0; idj < nLn; ++idj)
+      {
+	fP[idj] = (a2 * dP[idj]) + (a3 * dP[idj + nS]) -
+		  (b0 * fP[idj + nS]) - (b1 * fP[idj + (2 * nS)]);
+      }
+    }
+  }
+  /* Sum of the causal and anti-causal passes. */
+  for(idi = 0; idi < dataSz * nS; idi += nS)
+  {
+    for(idj = 0; idj < nLn; ++idj)
+    {
+      data[idi + idj] = c * (buf0[idi + idj] + buf1[idi + idj]);
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValueFilters
+* \brief	Filters a group of intervals which have been interleaved
+*		in the given data buffer using WlzRsvFilterFilterBufXG()
+*		and then clamps the filtered values into the intervals'
+*		destination values.
+* \param	ftr			The filter.
+* \param	datBuf			Buffer with the interleaved data
+*					of the intervals.
+* \param	lnBuf0			Buffer with at least itvLen *
+*					WLZ_RSVFILTER_LNGRP elements.
+* \param	lnBuf1			Buffer with at least itvLen *
+*					WLZ_RSVFILTER_LNGRP elements.
+* \param	lnBufT			Buffer with at least itvLen elements.
+* \param	dstGP			Destination values of the intervals.
+* \param	dstGType		Destination grey type.
+* \param	itvLen			Length of the intervals.
+* \param	nLn			Number of intervals.
+*/
+static void	WlzRsvFilterFlushXG(WlzRsvFilter *ftr,
+				    double *datBuf,
+				    double *lnBuf0,
+				    double *lnBuf1,
+				    double *lnBufT,
+				    WlzGreyP *dstGP,
+				    WlzGreyType dstGType,
+				    int itvLen,
+				    int nLn)
+{
+  int		idi,
+  		idj;
+  WlzGreyP	bufGP;
+
+  WlzRsvFilterFilterBufXG(ftr, datBuf, lnBuf0, lnBuf1, itvLen, nLn);
+  bufGP.dbp = lnBufT;
+  for(idj = 0; idj < nLn; ++idj)
+  {
+    for(idi = 0; idi < itvLen; ++idi)
+    {
+      lnBufT[idi] = datBuf[(idi * WLZ_RSVFILTER_LNGRP) + idj];
+    }
+    WlzValueClampGreyIntoGrey(dstGP[idj], 0, dstGType,
+			      bufGP, 0, WLZ_GREY_DOUBLE, itvLen);
+  }
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzValueFilters
@@ -870,6 +1034,69 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
   }
 }
 
+/*!
+* \return	The filtered object, or NULL on error.
+* \ingroup	WlzValueFilters
+* \brief	Applies a recursive filter along the lines and/or through
+*		the columns of the given 2D domain object with grey values.
+*               It is assumed that the object type has already been
+*               checked, the domain and values are non-null.
+* \param	srcObj			Given 2D domain object.
+* \param	pln			Plane coordinate if the object's
+*					values are tiled, otherwise ignored.
+* \param	ftr			Recursive filter.
+* \param	actionMsk		Action mask.
+* \param	dstErr			Destination error pointer, may
+*                                       be null.
+*/
+static WlzObject *WlzRsvFilterObj2D(WlzObject *srcObj, int pln,
+				    WlzRsvFilter *ftr, int actionMsk,
+				    WlzErrorNum *dstErr)
+{
+  WlzObject	*xObj = NULL,
+		*yObj = NULL,
+		*dstObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Filter in each required direction. */
+  if((actionMsk & WLZ_RSVFILTER_ACTION_X) != 0)
+  {
+    xObj = WlzRsvFilterObj2DX(srcObj, pln, ftr, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     ((actionMsk & WLZ_RSVFILTER_ACTION_Y) != 0))
+  {
+    yObj = (xObj)? WlzRsvFilterObj2DY(xObj, 0, ftr, &errNum):
+		   WlzRsvFilterObj2DY(srcObj, pln, ftr, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(yObj)
+    {
+      dstObj = yObj;
+      yObj = NULL;
+    }
+    else if(xObj)
+    {
+      dstObj = xObj;
+      xObj = NULL;
+    }
+  }
+  if(xObj)
+  {
+    WlzFreeObj(xObj);
+  }
+  if(yObj)
+  {
+    WlzFreeObj(yObj);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dstObj);
+}
+
 /*!
 * \return	The filtered object, or NULL on error.
 * \ingroup	WlzValueFilters
@@ -877,30 +1104,41 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
 *               2D domain object with grey values using either double
 *               precision floating point arithmetic or fixed
 *               point arithmetic.
+*               Intervals of the same length are copied into an
+*               interleaved buffer and filtered together in groups of
+*               up to WLZ_RSVFILTER_LNGRP.
 *               It is assumed that the object type has already been
 *               checked, the domain and values are non-null.
 * \param	srcObj			Given 2D domain object.
+* \param	pln			Plane coordinate if the object's
+*					values are tiled, otherwise ignored.
 * \param	ftr			Recursive filter.
 * \param	dstErr			Destination error pointer, may
 *                                       be null.
 */
-static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
+static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, int pln,
+				     WlzRsvFilter *ftr,
 				     WlzErrorNum *dstErr)
 {
-  int		bufSz,
+  int		idi,
+		bufSz,
 		bufSpace,
-		itvLen;
+		itvLen,
+		grpLen = 0,
+		nGrp = 0;
   WlzGreyType	bufType,
   		srcGType,
   		dstGType;
   WlzObjectType	vType;
   WlzGreyP	bufGP;
+  WlzGreyP	dstGP[WLZ_RSVFILTER_LNGRP];
   WlzPixelV	bgdPix;
   WlzDomain	srcDom;
   WlzValues	dstVal;
   WlzObject	*dstObj = NULL;
   void		*lnBuf0 = NULL,
   		*lnBuf1 = NULL,
+		*lnBufT = NULL,
   		*datBuf = NULL;
   WlzIntervalWSpace srcIWSp,
   		dstIWSp;
@@ -944,7 +1182,9 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    vType = WlzGreyTableTypeToTableType(srcObj->values.core->type, &errNum);
+    vType = (WlzGreyTableIsTiled(srcObj->values.core->type))?
+	    WLZ_GREY_TAB_RAGR:
+            WlzGreyTableTypeToTableType(srcObj->values.core->type, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -967,18 +1207,22 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
   {
     bufSz = srcDom.i->lastkl - srcDom.i->kol1 + 1;
     bufSpace = sizeof(double) * bufSz;
-    if(((datBuf = AlcMalloc(bufSpace)) == NULL) ||
-       ((lnBuf0 = AlcMalloc(bufSpace)) == NULL) ||
-       ((lnBuf1 = AlcMalloc(bufSpace)) ==  NULL))
+    if(((datBuf = AlcMalloc(bufSpace * WLZ_RSVFILTER_LNGRP)) == NULL) ||
+       ((lnBuf0 = AlcMalloc(bufSpace * WLZ_RSVFILTER_LNGRP)) == NULL) ||
+       ((lnBuf1 = AlcMalloc(bufSpace * WLZ_RSVFILTER_LNGRP)) == NULL) ||
+       ((lnBufT = AlcMalloc(bufSpace)) ==  NULL))
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
-  /* Work down through the object from the first line to last. */
+  /* Work down through the object from the first line to last, filtering
+   * groups of intervals with the same length together. The destination
+   * values are never tiled so the destination interval pointers remain
+   * valid until the group is filtered. */
   if(errNum == WLZ_ERR_NONE)
   {
     bufType = WLZ_GREY_DOUBLE;
-    bufGP.dbp = (double *)datBuf;
+    bufGP.dbp = (double *)lnBufT;
     if(((errNum = WlzInitGreyRasterScan(srcObj, &srcIWSp, &srcGWSp,
     					WLZ_RASTERDIR_ILIC,
 					0)) == WLZ_ERR_NONE) &&
@@ -986,27 +1230,55 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
        					WLZ_RASTERDIR_ILIC,
 					0)) == WLZ_ERR_NONE))
     {
+      if(srcGWSp.tvb)
+      {
+        srcIWSp.plnpos = pln;
+      }
       while((errNum == WLZ_ERR_NONE) &&
             ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
 	    ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
       {
-	/* Copy interval to working buffer. */
 	itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
+	if((nGrp > 0) && (itvLen != grpLen))
+	{
+	  WlzRsvFilterFlushXG(ftr, (double *)datBuf,
+			      (double *)lnBuf0, (double *)lnBuf1,
+			      (double *)lnBufT, dstGP, dstGType,
+			      grpLen, nGrp);
+	  nGrp = 0;
+	}
+	/* Copy interval into the group's interleaved working buffer. */
 	WlzValueCopyGreyToGrey(bufGP, 0, bufType,
 			       srcGWSp.u_grintptr, 0, srcGWSp.pixeltype,
 			       itvLen);
-	/* Apply filter. */
-	WlzRsvFilterFilterBufXF(ftr, (double *)datBuf,
-			        (double *)lnBuf0, (double *)lnBuf1,
-				itvLen);
-	/* Clamp data from buffer into the dst interval. */
-	WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-			          bufGP, 0, bufType, itvLen);
+	for(idi = 0; idi < itvLen; ++idi)
+	{
+	  *((double *)datBuf + (idi * WLZ_RSVFILTER_LNGRP) + nGrp) =
+	      bufGP.dbp[idi];
+	}
+	dstGP[nGrp++] = dstGWSp.u_grintptr;
+	grpLen = itvLen;
+	if(nGrp == WLZ_RSVFILTER_LNGRP)
+	{
+	  WlzRsvFilterFlushXG(ftr, (double *)datBuf,
+			      (double *)lnBuf0, (double *)lnBuf1,
+			      (double *)lnBufT, dstGP, dstGType,
+			      grpLen, nGrp);
+	  nGrp = 0;
+	}
       }
-    }
-    if(errNum == WLZ_ERR_EOO)
-    {
-      errNum = WLZ_ERR_NONE;
+      if(errNum == WLZ_ERR_EOO)
+      {
+	if(nGrp > 0)
+	{
+	  WlzRsvFilterFlushXG(ftr, (double *)datBuf,
+			      (double *)lnBuf0, (double *)lnBuf1,
+			      (double *)lnBufT, dstGP, dstGType,
+			      grpLen, nGrp);
+	}
+	errNum = WLZ_ERR_NONE;
+      }
+      (void )WlzEndGreyScan(&srcIWSp, &srcGWSp);
     }
   }
   /* Free buffers. */
@@ -1014,6 +1286,10 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
   {
     AlcFree(datBuf);
   }
+  if(lnBufT)
+  {
+    AlcFree(lnBufT);
+  }
   if(lnBuf0)
   {
     AlcFree(lnBuf0);
@@ -1047,11 +1323,14 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
 *               It is assumed that the object type has already been
 *               checked, the domain and values are non-null.
 * \param	srcObj			Given 2D domain object.
+* \param	pln			Plane coordinate if the object's
+*					values are tiled, otherwise ignored.
 * \param	ftr			Recursive filter.
 * \param	dstErr			Destination error pointer, may
 *                                       be null.
 */
-static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
+static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, int pln,
+				     WlzRsvFilter *ftr,
 			             WlzErrorNum *dstErr)
 {
   int		idD,
@@ -1119,7 +1398,9 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    vType = WlzGreyTableTypeToTableType(srcObj->values.core->type, &errNum);
+    vType = (WlzGreyTableIsTiled(srcObj->values.core->type))?
+	    WLZ_GREY_TAB_RAGR:
+            WlzGreyTableTypeToTableType(srcObj->values.core->type, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1178,6 +1459,10 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 	 ((errNum = WlzInitGreyRasterScan(dstObj, &dstIWSp, &dstGWSp, rasDir,
 					  0)) == WLZ_ERR_NONE))
       {
+	if(srcGWSp.tvb)
+	{
+	  srcIWSp.plnpos = pln;
+	}
 	while((errNum == WLZ_ERR_NONE) &&
 	      ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
 	      ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
@@ -1226,6 +1511,7 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 				      dstBufGP, bufPos.vtX, bufType, itvLen);
 	  }
 	}
+	(void )WlzEndGreyScan(&srcIWSp, &srcGWSp);
       }
       if(errNum == WLZ_ERR_EOO)
       {
@@ -1269,6 +1555,7 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 *               object with grey values using either double
 *               precision floating point arithmetic or fixed
 *               point arithmetic.
+*               The planes are filtered in parallel.
 *               It is assumed that the object type has already been
 *               checked, the domain and values are non-null.
 * \param	srcObj			Given object.
@@ -1280,12 +1567,12 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
 			              int actionMsk, WlzErrorNum *dstErr)
 {
-  int		nPlanes;
-  WlzObject	*srcObj2D,
-  		*dstObj2D,
-		*dstObj = NULL;
+  int		idP,
+  		tiled,
+  		nPlanes;
+  WlzObject	*dstObj = NULL;
   WlzDomain 	*srcDom2D;
-  WlzValues	*srcVal2D,
+  WlzValues	*srcVal2D = NULL,
   		*dstVal2D;
   WlzDomain	srcDom;
   WlzValues	dstVal;
@@ -1294,9 +1581,13 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
   dstVal.core = NULL;
   srcDom = srcObj->domain;
   srcDom2D = srcDom.p->domains;
-  srcVal2D = srcObj->values.vox->values;
+  tiled = WlzGreyTableIsTiled(srcObj->values.core->type);
+  if(!tiled)
+  {
+    srcVal2D = srcObj->values.vox->values;
+  }
   nPlanes = srcDom.p->lastpl - srcDom.p->plane1 + 1;
-  dstVal.vox = WlzMakeVoxelValueTb(srcObj->values.vox->type,
+  dstVal.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
 				   srcDom.p->plane1, srcDom.p->lastpl,
 				   WlzGetBackground(srcObj, NULL),
 				   NULL, &errNum);
@@ -1305,46 +1596,60 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
     dstVal2D = dstVal.vox->values;
     dstObj = WlzMakeMain(srcObj->type, srcDom, dstVal, NULL, NULL, &errNum);
   }
-  while((errNum == WLZ_ERR_NONE) &&
-        (nPlanes-- > 0))
+  if(errNum == WLZ_ERR_NONE)
   {
-    srcObj2D = NULL;
-    dstObj2D = NULL;
-    if(srcDom2D->core)
+    /* The planes are independent so filter them in parallel. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idP = 0; idP < nPlanes; ++idP)
     {
-      dstObj2D = NULL;
-      srcObj2D = WlzAssignObject(
-      		 WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D++, *srcVal2D++,
-			     NULL, NULL, &errNum), NULL);
-      if(errNum == WLZ_ERR_NONE)
+      if((errNum == WLZ_ERR_NONE) && srcDom2D[idP].core)
       {
-	dstObj2D = WlzAssignObject(
-		   WlzRsvFilterObj(srcObj2D, ftr, actionMsk, &errNum), NULL);
-      }
-      if(errNum == WLZ_ERR_NONE)
-      {
-	*dstVal2D = WlzAssignValues(dstObj2D->values, NULL);
-      }
-      if(srcObj2D)
-      {
-        WlzFreeObj(srcObj2D);
-      }
-      if(dstObj2D)
-      {
-        WlzFreeObj(dstObj2D);
+	WlzObject *srcObj2D,
+		  *dstObj2D = NULL;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	srcObj2D = WlzAssignObject(
+		   WlzMakeMain(WLZ_2D_DOMAINOBJ, srcDom2D[idP],
+			       (tiled)? srcObj->values: srcVal2D[idP],
+			       NULL, NULL, &errNum2), NULL);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  dstObj2D = WlzAssignObject(
+		     WlzRsvFilterObj2D(srcObj2D, srcDom.p->plane1 + idP,
+		                       ftr, actionMsk, &errNum2), NULL);
+	}
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  dstVal2D[idP] = WlzAssignValues(dstObj2D->values, NULL);
+	}
+	if(srcObj2D)
+	{
+	  WlzFreeObj(srcObj2D);
+	}
+	if(dstObj2D)
+	{
+	  WlzFreeObj(dstObj2D);
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj3DXY)
+#endif
+	  {
+	    errNum = errNum2;
+	  }
+	}
       }
     }
-    else
-    {
-      dstVal2D->core = NULL;
-    }
-    ++dstVal2D;
   }
   if(errNum != WLZ_ERR_NONE)
   {
     if(dstObj)
     {
       WlzFreeObj(dstObj);
+      dstObj = NULL;
     }
     else if(dstVal.core)
     {
@@ -1379,7 +1684,9 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
   		idD,
 		idN,
   		idP,
-		itvLen,
+		nItv,
+		maxItv,
+		tiled,
 		dstPnIdx,
 		bufPlIdx,
   		nPlanes,
@@ -1395,9 +1702,9 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 		bufType,
   		srcGType = WLZ_GREY_ERROR,
   		dstGType = WLZ_GREY_ERROR;
-  WlzGreyP	dstBufGP,
-  		srcBufGP,
+  WlzGreyP	srcBufGP,
   		wrkBufGP;
+  WlzRsvFilterItv *itvs = NULL;
   void		***srcBuf = NULL,
   		***wrkBuf = NULL;
   void		**srcBuf2D,
@@ -1424,10 +1731,12 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
   {
     errNum = WLZ_ERR_DOMAIN_TYPE;
   }
-  else if((srcVal = srcObj->values).core->type != WLZ_VOXELVALUETABLE_GREY)
+  else if(((srcVal = srcObj->values).core->type != WLZ_VOXELVALUETABLE_GREY) &&
+          !WlzGreyTableIsTiled(srcVal.core->type))
   {
     errNum = WLZ_ERR_VALUES_TYPE;
   }
+  tiled = (errNum == WLZ_ERR_NONE) && WlzGreyTableIsTiled(srcVal.core->type);
   if(errNum == WLZ_ERR_NONE)
   {
     bgdPix = WlzGetBackground(srcObj, &errNum);
@@ -1436,10 +1745,14 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
   {
     /* Find grey type, checking all planes have same grey type. */
     srcDom2D = srcDom.p->domains;
-    srcVal2D = srcVal.vox->values;
     nPlanes = srcDom.p->lastpl - srcDom.p->plane1 + 1;
-    if(nPlanes > 0)
+    if(tiled)
     {
+      srcGType = WlzGreyTableTypeToGreyType(srcVal.core->type, &errNum);
+    }
+    else if(nPlanes > 0)
+    {
+      srcVal2D = srcVal.vox->values;
       idP = 0;
       srcGType = WLZ_GREY_ERROR;
       while((errNum == WLZ_ERR_NONE) && (idP < nPlanes))
@@ -1509,6 +1822,7 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 	bufSz.vtZ = 3;
 	tI0 = (bufSz.vtX + 7) / 8;
 	itvBufArea = tI0 * bufSz.vtY;
+	maxItv = 0;
 	if(AlcBit3Malloc(&itvBuf, bufSz.vtZ, bufSz.vtY,
 			 bufSz.vtX) != ALC_ER_NONE)
 	{
@@ -1559,7 +1873,7 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 	    bufPlIdx = (bufPos.vtZ + 3 + 0) % 3;
 	    dstPnIdx = (bufPos.vtZ + 3 + 2) % 3;
 	    srcDom2D = srcDom.p->domains + bufPos.vtZ;
-	    srcVal2D = srcVal.vox->values + bufPos.vtZ;
+	    srcVal2D = (tiled)? &srcVal: srcVal.vox->values + bufPos.vtZ;
 	    dstVal2D = dstVal.vox->values + bufPos.vtZ;
 	    itvBuf2D = *(itvBuf + bufPlIdx);
 	    srcBuf2D = *(srcBuf + bufPlIdx); 
@@ -1587,63 +1901,98 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 	      /* Make a 2D object from destination plane. */
 	      dstObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D, *dstVal2D,
 				     NULL, NULL, &errNum);
-	      /* Process each interval of this plane. */
+	      /* Copy each interval of this plane into the buffers, then
+	       * filter the intervals in parallel. The intervals of a plane
+	       * are independent, since the filter only reads the bit masks
+	       * of the other two planes in the buffers. */
+	      nItv = 0;
 	      if(((errNum = WlzInitGreyScan(srcObj2D, &srcIWSp,
 	      				    &srcGWSp)) == WLZ_ERR_NONE) &&
 	         ((errNum = WlzInitGreyScan(dstObj2D, &dstIWSp,
 	      				    &dstGWSp)) == WLZ_ERR_NONE))
 	      {
+		if(srcGWSp.tvb)
+		{
+		  srcIWSp.plnpos = srcDom.p->plane1 + bufPos.vtZ;
+		}
 		while((errNum == WLZ_ERR_NONE) &&
 		      ((errNum = WlzNextGreyInterval(
 		      			&srcIWSp)) == WLZ_ERR_NONE) &&
 		      ((errNum = WlzNextGreyInterval(
 		      			&dstIWSp)) == WLZ_ERR_NONE))
 		{
-		  itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-		  bufPos.vtX = srcIWSp.lftpos - srcDom.p->kol1;
-		  bufPos.vtY = srcIWSp.linpos - srcDom.p->line1;
+		  WlzRsvFilterItv *itv;
+
+		  if(nItv >= maxItv)
+		  {
+		    WlzRsvFilterItv *newItvs;
+
+		    maxItv = (maxItv + bufSz.vtY) * 2;
+		    if((newItvs = (WlzRsvFilterItv *)
+		                  AlcRealloc(itvs, sizeof(WlzRsvFilterItv) *
+			                           maxItv)) == NULL)
+		    {
+		      errNum = WLZ_ERR_MEM_ALLOC;
+		      break;
+		    }
+		    itvs = newItvs;
+		  }
+		  itv = itvs + nItv++;
+		  itv->itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
+		  itv->bufPos = bufPos;
+		  itv->bufPos.vtX = srcIWSp.lftpos - srcDom.p->kol1;
+		  itv->bufPos.vtY = srcIWSp.linpos - srcDom.p->line1;
+		  itv->dstGP = dstGWSp.u_grintptr;
 		  /* Copy interval to buffer. */
-		  srcBufGP.dbp = *((double **)srcBuf2D + bufPos.vtY);
-		  wrkBufGP.dbp = *((double **)wrkBuf2D + bufPos.vtY);
-		  dstBufGP.dbp = *((double **)dstBuf2D + bufPos.vtY);
-		  WlzBitLnSetItv(*(itvBuf2D + bufPos.vtY),
-		  		 bufPos.vtX, bufPos.vtX + itvLen - 1,
+		  srcBufGP.dbp = *((double **)srcBuf2D + itv->bufPos.vtY);
+		  wrkBufGP.dbp = *((double **)wrkBuf2D + itv->bufPos.vtY);
+		  WlzBitLnSetItv(*(itvBuf2D + itv->bufPos.vtY),
+		  		 itv->bufPos.vtX,
+				 itv->bufPos.vtX + itv->itvLen - 1,
 				 bufSz.vtX);
-		  WlzValueCopyGreyToGrey(srcBufGP, bufPos.vtX, bufType,
+		  WlzValueCopyGreyToGrey(srcBufGP, itv->bufPos.vtX, bufType,
 		  			 srcGWSp.u_grintptr, 0,
 					 srcGWSp.pixeltype,
-					 itvLen);
+					 itv->itvLen);
 		  if(idD)
 		  {
-		    WlzValueCopyGreyToGrey(wrkBufGP, bufPos.vtX, bufType,
+		    WlzValueCopyGreyToGrey(wrkBufGP, itv->bufPos.vtX, bufType,
 					   dstGWSp.u_grintptr, 0,
 					   dstGWSp.pixeltype,
-					   itvLen);
-		  }
-		  /* Apply filter to this interval. */
-		  WlzRsvFilterFilterBufZF(ftr, (double ***)wrkBuf,
-					  (double ***)srcBuf, itvBuf,
-					  bufPos, itvLen, idD);
-		  /* Clamp data buffer back into the destination plane. */
-		  if(idD == 0)
-		  {
-		    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
-					      dstGWSp.pixeltype,
-					      wrkBufGP, bufPos.vtX, bufType,
-					      itvLen);
-		  }
-		  else
-		  {
-		    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
-					      dstGWSp.pixeltype,
-					      dstBufGP, bufPos.vtX, bufType,
-					      itvLen);
+					   itv->itvLen);
 		  }
 		}
 		if(errNum == WLZ_ERR_EOO)
 		{
 		  errNum = WLZ_ERR_NONE;
 		}
+		(void )WlzEndGreyScan(&srcIWSp, &srcGWSp);
+	      }
+	      if(errNum == WLZ_ERR_NONE)
+	      {
+		int	idI;
+
+#ifdef _OPENMP
+#pragma omp parallel for if(nItv > 1)
+#endif
+		for(idI = 0; idI < nItv; ++idI)
+		{
+		  WlzGreyP	bufGP;
+		  WlzRsvFilterItv *itv;
+
+		  itv = itvs + idI;
+		  /* Apply filter to this interval. */
+		  WlzRsvFilterFilterBufZF(ftr, (double ***)wrkBuf,
+					  (double ***)srcBuf, itvBuf,
+					  itv->bufPos, itv->itvLen, idD);
+		  /* Clamp data buffer back into the destination plane. */
+		  bufGP.dbp = *((double **)((idD)? dstBuf2D: wrkBuf2D) +
+		                itv->bufPos.vtY);
+		  WlzValueClampGreyIntoGrey(itv->dstGP, 0,
+					    dstGWSp.pixeltype,
+					    bufGP, itv->bufPos.vtX, bufType,
+					    itv->itvLen);
+		}
 	      }
 	      if(srcObj2D)
 	      {
@@ -1662,6 +2011,7 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
       }
     }
   }
+  AlcFree(itvs);
   if(itvBuf)
   {
     Alc3Free((void ***)itvBuf);
@@ -49,6 +49,8 @@ static char _WlzSepFilter_c[] = "University of Edinburgh $Id$";
 #include <omp.h>
 #endif
 
+#define WLZ_SEPFILTER_BLKSZ 256  /* Number of columns filtered together in
+				    the blocked y and z passes. */
 
 static WlzObject		*WlzSepFilterX(WlzObject *inObj,
 				  int dim,
@@ -80,6 +82,59 @@ static WlzObject		*WlzSepFilterZ(WlzObject *inObj,
 				  AlgPadType pad,
 				  double padVal,
 				  WlzErrorNum *dstErr);
+static WlzObject		*WlzGaussFilterPriv(
+				  WlzObject *inObj,
+				  WlzDVertex3 sigma,
+				  WlzIVertex3 order,
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  int sep,
+				  int fast,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzSepFilterPriv(
+				  WlzObject *inObj,
+				  WlzIVertex3 cBufSz,
+				  double *cBuf[],
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  int sep,
+				  int fast,
+				  WlzErrorNum *dstErr);
+static int			WlzSepFilterBlkValid(WlzObject *inObj,
+				  WlzIBox3 bBox,
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  int sep);
+static void			WlzSepFilterBlkLine(float *dst,
+				  float *buf,
+				  int nV,
+				  int cBufSz,
+				  float *cBuf,
+				  AlgPadType pad,
+				  float padVal);
+static void			WlzSepFilterBlkLines(float *dst,
+				  float *src,
+				  int nL,
+				  size_t lStep,
+				  int nV,
+				  int cBufSz,
+				  float *cBuf,
+				  AlgPadType pad,
+				  float padVal);
+static WlzObject		*WlzSepFilterBlk3D(WlzObject *inObj,
+				  WlzIBox3 bBox,
+				  int maxThr,
+				  WlzIVertex3 cBufSz,
+				  double *cBuf[],
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  WlzErrorNum *dstErr);
 /*!
 * \return	New Gaussian filtered object with new values or NULL on error.
 * \ingroup	WlzValuesFilters
@@ -129,6 +184,117 @@ WlzObject			*WlzGaussFilter(
 				  double padVal,
 				  int sep,
 				  WlzErrorNum *dstErr)
+{
+  return(WlzGaussFilterPriv(inObj, sigma, order, direc, gType, pad, padVal,
+                            sep, 0, dstErr));
+}
+
+/*!
+* \return	New Gaussian filtered object with new values or NULL on error.
+* \ingroup	WlzValuesFilters
+* \brief	Applies a Gaussian filter to the given input spatial domain
+* 		object in the same way as WlzGaussFilter(), but allowing
+* 		the faster single precision filter described for
+* 		WlzSepFilterFast() to be used.
+* \param	inObj			Input 2 or 3D spatial domain object
+* 					which must have values.
+* \param	sigma			Gaussian sigma values for each of the
+* 					Cartesian directions.
+* \param	order			Derivative order for each of the
+* 					Cartesian directions, range 0-2,
+* 					where 0 implies no derivative.
+* \param	direc			Required Cartesian directions, with
+* 					zero value indicating that no filtering
+* 					is to be applied for a direction.
+* \param	gType			Required return object grey type.
+* 					Passing in WLZ_GREY_ERROR will
+* 					request the given input object's grey
+* 					type.
+* \param	pad			Type of padding.
+* \param	padVal			Padding value, only used when
+* 					pad == ALG_PAD_VALUE.
+* \param	sep			If non zero each directional filter
+* 					operation is applied to the input
+* 					object rather than the output of the
+* 					previous directional filter. The
+* 					method by which the separate filter
+* 					passes are combined is determined
+* 					by the given value with the valid
+* 					operations:
+* 					<ul>
+* 					  <li>1 - compound object</li>
+* 					  <li>2 - sum of values</li>
+* 					  <li>3 - square root of the of sum
+* 					          of the squared values</li>
+* 				        </ul>
+* \param	dstErr			Destination error pointer may be NULL.
+*/
+WlzObject			*WlzGaussFilterFast(
+				  WlzObject *inObj,
+				  WlzDVertex3 sigma,
+				  WlzIVertex3 order,
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  int sep,
+				  WlzErrorNum *dstErr)
+{
+  return(WlzGaussFilterPriv(inObj, sigma, order, direc, gType, pad, padVal,
+                            sep, 1, dstErr));
+}
+
+/*!
+* \return	New Gaussian filtered object with new values or NULL on error.
+* \ingroup	WlzValuesFilters
+* \brief	Applies a Gaussian filter to the given input spatial domain
+* 		object, see WlzGaussFilter().
+* \param	inObj			Input 2 or 3D spatial domain object
+* 					which must have values.
+* \param	sigma			Gaussian sigma values for each of the
+* 					Cartesian directions.
+* \param	order			Derivative order for each of the
+* 					Cartesian directions, range 0-2,
+* 					where 0 implies no derivative.
+* \param	direc			Required Cartesian directions, with
+* 					zero value indicating that no filtering
+* 					is to be applied for a direction.
+* \param	gType			Required return object grey type.
+* 					Passing in WLZ_GREY_ERROR will
+* 					request the given input object's grey
+* 					type.
+* \param	pad			Type of padding.
+* \param	padVal			Padding value, only used when
+* 					pad == ALG_PAD_VALUE.
+* \param	sep			If non zero each directional filter
+* 					operation is applied to the input
+* 					object rather than the output of the
+* 					previous directional filter. The
+* 					method by which the separate filter
+* 					passes are combined is determined
+* 					by the given value with the valid
+* 					operations:
+* 					<ul>
+* 					  <li>1 - compound object</li>
+* 					  <li>2 - sum of values</li>
+* 					  <li>3 - square root of the of sum
+* 					          of the squared values</li>
+* 				        </ul>
+* \param	fast			Non-zero if the faster single precision
+* 					filter may be used.
+* \param	dstErr			Destination error pointer may be NULL.
+*/
+static WlzObject		*WlzGaussFilterPriv(
+				  WlzObject *inObj,
+				  WlzDVertex3 sigma,
+				  WlzIVertex3 order,
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  int sep,
+				  int fast,
+				  WlzErrorNum *dstErr)
 {
   int		dim = 0;
   double	*cBuf[3] = {NULL};
@@ -336,8 +502,8 @@ WlzObject			*WlzGaussFilter(
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    rnObj = WlzSepFilter(inObj, cBufSz, cBuf, direc, gType, pad, padVal,
-    			 sep, &errNum);
+    rnObj = WlzSepFilterPriv(inObj, cBufSz, cBuf, direc, gType, pad, padVal,
+    			     sep, fast, &errNum);
   }
   AlcFree(cBuf[0]);
   if(errNum != WLZ_ERR_NONE)
@@ -399,8 +565,127 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
 				  double padVal,
 				  int sep,
 				  WlzErrorNum *dstErr)
+{
+  return(WlzSepFilterPriv(inObj, cBufSz, cBuf, direc, gType, pad, padVal,
+                          sep, 0, dstErr));
+}
+
+/*!
+* \return	New filtered object with new values or NULL on error.
+* \ingroup	WlzValuesFilters
+* \brief	Applies a seperable filter to the given object using the given
+* 		convolution kernels in the same way as WlzSepFilter(), but
+* 		much faster for some objects.
+* 		When the object is 3D with a cuboid domain, unsigned byte,
+* 		short or float values, a non-double return grey type and
+* 		the filter passes are not seperate, the values are filtered
+* 		in single precision in blocks of several lines at a time
+* 		rather than in double precision one line of each domain
+* 		interval at a time. The filtered values then differ from
+* 		those of WlzSepFilter() by the single precision rounding
+* 		error, which can change integer values by one. All other
+* 		objects are filtered exactly as by WlzSepFilter().
+* \param	inObj			Input 2 or 3D spatial domain object
+* 					to be filtered which must have scalar
+* 					values.
+* \param	cBufSz			Convolution kernel sizes (sz), each
+* 					kernel buffer is sized (2 * sz) + 1
+* 					with the centre indexed sz into the
+* 					buffer.
+* \param	cBuf			Convolution kernel buffers.
+* \param	direc			Set to non-zero in directions for which
+* 					the filter is to be applied.
+* \param	gType			Required return object grey type.
+* 					Passing in WLZ_GREY_ERROR will
+* 					request the given input object's grey
+* 					type.
+* \param	pad			Type of padding.
+* \param	padVal			Padding value, only used when
+* 					pad == ALG_PAD_VALUE.
+* \param	sep			If non zero each directional filter
+* 					operation is applied to the input
+* 					object rather than the output of the
+* 					previous directional filter. The
+* 					method by which the separate filter
+* 					passes are combined is determined
+* 					by the given value with the valid
+* 					operations:
+* 					<ul>
+* 					  <li>1 - compound object</li>
+* 					  <li>2 - sum of values</li>
+* 					  <li>3 - square root of the of sum
+* 					          of the squared values</li>
+* 				        </ul>
+* \param	dstErr			Destination error pointer may be NULL.
+*/
+WlzObject			*WlzSepFilterFast(WlzObject *inObj,
+				  WlzIVertex3 cBufSz,
+				  double *cBuf[],
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  int sep,
+				  WlzErrorNum *dstErr)
+{
+  return(WlzSepFilterPriv(inObj, cBufSz, cBuf, direc, gType, pad, padVal,
+                          sep, 1, dstErr));
+}
+
+/*!
+* \return	New filtered object with new values or NULL on error.
+* \ingroup	WlzValuesFilters
+* \brief	Applies a seperable filter to the given object using the given
+* 		convolution kernels, see WlzSepFilter() and
+* 		WlzSepFilterFast().
+* \param	inObj			Input 2 or 3D spatial domain object
+* 					to be filtered which must have scalar
+* 					values.
+* \param	cBufSz			Convolution kernel sizes (sz), each
+* 					kernel buffer is sized (2 * sz) + 1
+* 					with the centre indexed sz into the
+* 					buffer.
+* \param	cBuf			Convolution kernel buffers.
+* \param	direc			Set to non-zero in directions for which
+* 					the filter is to be applied.
+* \param	gType			Required return object grey type.
+* 					Passing in WLZ_GREY_ERROR will
+* 					request the given input object's grey
+* 					type.
+* \param	pad			Type of padding.
+* \param	padVal			Padding value, only used when
+* 					pad == ALG_PAD_VALUE.
+* \param	sep			If non zero each directional filter
+* 					operation is applied to the input
+* 					object rather than the output of the
+* 					previous directional filter. The
+* 					method by which the separate filter
+* 					passes are combined is determined
+* 					by the given value with the valid
+* 					operations:
+* 					<ul>
+* 					  <li>1 - compound object</li>
+* 					  <li>2 - sum of values</li>
+* 					  <li>3 - square root of the of sum
+* 					          of the squared values</li>
+* 				        </ul>
+* \param	fast			Non-zero if the faster single precision
+* 					filter may be used.
+* \param	dstErr			Destination error pointer may be NULL.
+*/
+static WlzObject		*WlzSepFilterPriv(WlzObject *inObj,
+				  WlzIVertex3 cBufSz,
+				  double *cBuf[],
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  int sep,
+				  int fast,
+				  WlzErrorNum *dstErr)
 {
   int		dim = 0,
+  		blk = 0,
   		vSz = 0,
   		nThr = 1;
   double	**iBuf = NULL,
@@ -409,6 +694,7 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
   WlzObject	*rnObj = NULL;
   WlzIVertex3	vBufSz = {0};
   WlzIBox3	bBox = {0};
+  WlzGreyType	rGType = WLZ_GREY_DOUBLE;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
 #ifdef _OPENMP
@@ -483,6 +769,16 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
     }
   }
   if(errNum == WLZ_ERR_NONE)
+  {
+    blk = fast && WlzSepFilterBlkValid(inObj, bBox, direc, gType, sep);
+    if(blk)
+    {
+      rnObj = WlzSepFilterBlk3D(inObj, bBox, nThr, cBufSz, cBuf, direc,
+      				gType, pad, padVal, &errNum);
+      rGType = gType;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && !blk)
   {
     vSz = ALG_MAX3(vBufSz.vtX, vBufSz.vtY, vBufSz.vtZ);
     if(((iBuf = (double **)
@@ -504,7 +800,7 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
       }
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && !blk)
   {
     WlzObject *tObj[3] = {NULL};
 
@@ -733,7 +1029,7 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
       (void )WlzFreeObj(tObj[2]);
     }
   }
-  if((errNum == WLZ_ERR_NONE) && (rnObj != NULL) && (gType != WLZ_GREY_DOUBLE))
+  if((errNum == WLZ_ERR_NONE) && (rnObj != NULL) && (gType != rGType))
   {
     /* Convert object values to the required grey type. */
     switch(rnObj->type)
@@ -1342,3 +1638,507 @@ static WlzObject		*WlzSepFilterZ(WlzObject *inObj,
   }
   return(rnObj);
 }
+
+/*!
+* \return	Non-zero if the blocked filter may be used.
+* \ingroup	WlzValuesFilters
+* \brief	Checks whether the given object and parameters may be
+* 		filtered using WlzSepFilterBlk3D(). This requires a 3D
+* 		object with a cuboid domain, a voxel value table with
+* 		unsigned byte, short or float values (all of which can be
+* 		represented exactly as floats), a return grey type other
+* 		than double and the filter passes must not be seperate.
+* \param	inObj			Given object.
+* \param	bBox			Bounding box of the given object.
+* \param	direc			Directions for which the filter is
+* 					to be applied.
+* \param	gType			Required return object grey type.
+* \param	sep			Seperate filter passes flag.
+*/
+static int			WlzSepFilterBlkValid(WlzObject *inObj,
+				  WlzIBox3 bBox,
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  int sep)
+{
+  int		valid = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((inObj->type == WLZ_3D_DOMAINOBJ) && (sep == 0) &&
+     (gType != WLZ_GREY_DOUBLE) &&
+     (direc.vtX || direc.vtY || direc.vtZ) &&
+     (inObj->domain.core->type == WLZ_PLANEDOMAIN_DOMAIN) &&
+     (inObj->values.core->type == WLZ_VOXELVALUETABLE_GREY))
+  {
+    switch(WlzGreyTypeFromObj(inObj, &errNum))
+    {
+      case WLZ_GREY_UBYTE: /* FALLTHROUGH */
+      case WLZ_GREY_SHORT: /* FALLTHROUGH */
+      case WLZ_GREY_FLOAT:
+	valid = (errNum == WLZ_ERR_NONE);
+        break;
+      default:
+        break;
+    }
+  }
+  if(valid)
+  {
+    WlzLong	vol;
+
+    /* The domain is a cuboid only if its volume is that of its
+     * bounding box. */
+    vol = WlzVolume(inObj, &errNum);
+    valid = (errNum == WLZ_ERR_NONE) &&
+            (vol == (WlzLong )(bBox.xMax - bBox.xMin + 1) *
+	            (WlzLong )(bBox.yMax - bBox.yMin + 1) *
+		    (WlzLong )(bBox.zMax - bBox.zMin + 1));
+  }
+  return(valid);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Convolves a single line of contiguous float values with the
+* 		given kernel. The padding is the same as that of
+* 		AlgConvolveD(), but the loops are ordered so that the
+* 		inner loop is over the values and can be vectorised.
+* \param	dst			Destination for the nV filtered values
+* 					which must not be aliased to buf.
+* \param	buf			Buffer of nV + (2 * cBufSz) values
+* 					with the values to be filtered at
+* 					offset cBufSz, the padding is set
+* 					by this function.
+* \param	nV			Number of values.
+* \param	cBufSz			Convolution kernel size.
+* \param	cBuf			Convolution kernel buffer.
+* \param	pad			Type of padding.
+* \param	padVal			Padding value.
+*/
+static void			WlzSepFilterBlkLine(float *dst,
+				  float *buf,
+				  int nV,
+				  int cBufSz,
+				  float *cBuf,
+				  AlgPadType pad,
+				  float padVal)
+{
+  int		idk,
+  		idv;
+  float		p0,
+  		p1;
+
+  switch(pad)
+  {
+    case ALG_PAD_END:
+      p0 = buf[cBufSz];
+      p1 = buf[cBufSz + nV - 1];
+      break;
+    case ALG_PAD_VALUE:
+      p0 = p1 = padVal;
+      break;
+    default:
+      p0 = p1 = 0.0f;
+      break;
+  }
+  for(idv = 0; idv < cBufSz; ++idv)
+  {
+    buf[idv] = p0;
+    buf[cBufSz + nV + idv] = p1;
+  }
+  for(idv = 0; idv < nV; ++idv)
+  {
+    dst[idv] = 0.0f;
+  }
+  for(idk = 0; idk <= 2 * cBufSz; ++idk)
+  {
+    float	k,
+    		*b;
+
+    k = cBuf[idk];
+    b = buf + idk;
+    for(idv = 0; idv < nV; ++idv)
+    {
+      dst[idv] += k * b[idv];
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Convolves nV adjacent lines of float values with the given
+* 		kernel, where the values of each line are lStep apart and
+* 		those of adjacent lines are contiguous. The lines are
+* 		filtered together in blocks of WLZ_SEPFILTER_BLKSZ so that
+* 		the inner loop is over contiguous values and can be
+* 		vectorised, while the rows of a block which are used by
+* 		the kernel remain in the cache. The padding is the same as
+* 		that of AlgConvolveD().
+* \param	dst			Destination for the filtered values
+* 					which must not be aliased to src.
+* \param	src			Values to be filtered.
+* \param	nL			Number of values in each line.
+* \param	lStep			Offset between successive values of
+* 					a line.
+* \param	nV			Number of adjacent lines.
+* \param	cBufSz			Convolution kernel size.
+* \param	cBuf			Convolution kernel buffer.
+* \param	pad			Type of padding.
+* \param	padVal			Padding value.
+*/
+static void			WlzSepFilterBlkLines(float *dst,
+				  float *src,
+				  int nL,
+				  size_t lStep,
+				  int nV,
+				  int cBufSz,
+				  float *cBuf,
+				  AlgPadType pad,
+				  float padVal)
+{
+  int		idb;
+
+  for(idb = 0; idb < nV; idb += WLZ_SEPFILTER_BLKSZ)
+  {
+    int		idl,
+    		nB;
+
+    nB = ALG_MIN(WLZ_SEPFILTER_BLKSZ, nV - idb);
+    for(idl = 0; idl < nL; ++idl)
+    {
+      int	idk,
+      		idv;
+      float	pSum = 0.0f;
+      float	*d;
+
+      d = dst + (idl * lStep) + idb;
+      for(idv = 0; idv < nB; ++idv)
+      {
+        d[idv] = 0.0f;
+      }
+      for(idk = 0; idk <= 2 * cBufSz; ++idk)
+      {
+	int	idr;
+
+        idr = idl + idk - cBufSz;
+	if((idr < 0) || (idr >= nL))
+	{
+	  if(pad == ALG_PAD_END)
+	  {
+	    idr = (idr < 0)? 0: nL - 1;
+	  }
+	  else
+	  {
+	    pSum += cBuf[idk];
+	    idr = -1;
+	  }
+	}
+	if(idr >= 0)
+	{
+	  float	k,
+	  	*s;
+
+	  k = cBuf[idk];
+	  s = src + (idr * lStep) + idb;
+	  for(idv = 0; idv < nB; ++idv)
+	  {
+	    d[idv] += k * s[idv];
+	  }
+	}
+      }
+      if(pad == ALG_PAD_VALUE)
+      {
+        pSum *= padVal;
+	for(idv = 0; idv < nB; ++idv)
+	{
+	  d[idv] += pSum;
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \return	New filtered object with new values or NULL on error.
+* \ingroup	WlzValuesFilters
+* \brief	Applies a seperable filter to the given 3D object which must
+* 		have been checked using WlzSepFilterBlkValid(). The values
+* 		are copied into a dense single precision volume, which is
+* 		then filtered along the x, y and z axes in turn, with each
+* 		pass parallelised over planes (or lines for the z pass).
+* 		The y and z passes filter many adjacent lines together
+* 		using WlzSepFilterBlkLines(). Because the domain is a
+* 		cuboid each domain interval is a complete line of the
+* 		volume and the padding is the same as for the line by
+* 		line filters.
+* \param	inObj			Input 3D spatial domain object.
+* \param	bBox			Bounding box of the input object.
+* \param	maxThr			Maximum number of threads to use.
+* \param	cBufSz			Convolution kernel sizes.
+* \param	cBuf			Convolution kernel buffers.
+* \param	direc			Set to non-zero in directions for which
+* 					the filter is to be applied.
+* \param	gType			Required return object grey type.
+* \param	pad			Type of padding.
+* \param	padVal			Padding value.
+* \param	dstErr			Destination error pointer may be NULL.
+*/
+static WlzObject		*WlzSepFilterBlk3D(WlzObject *inObj,
+				  WlzIBox3 bBox,
+				  int maxThr,
+				  WlzIVertex3 cBufSz,
+				  double *cBuf[],
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  WlzErrorNum *dstErr)
+{
+  int		idp,
+  		nPln,
+		poff,
+		lBufSz;
+  size_t	nXY,
+  		nXYZ;
+  float		fPadVal;
+  float		*kBuf[3],
+  		*lBuf = NULL,
+		*vBuf[2] = {NULL};
+  WlzIVertex3	sz;
+  WlzObjectType	rGTT;
+  WlzDomain	*domains;
+  WlzValues	*iVal,
+  		*rVal;
+  WlzPixelV	zV;
+  WlzObject	*rnObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(pad == ALG_PAD_NONE)
+  {
+    pad = ALG_PAD_ZERO;
+  }
+  fPadVal = (float )padVal;
+  sz.vtX = bBox.xMax - bBox.xMin + 1;
+  sz.vtY = bBox.yMax - bBox.yMin + 1;
+  sz.vtZ = bBox.zMax - bBox.zMin + 1;
+  nXY = (size_t )(sz.vtX) * sz.vtY;
+  nXYZ = nXY * sz.vtZ;
+  lBufSz = sz.vtX + (2 * cBufSz.vtX);
+  kBuf[0] = NULL;
+  if(((kBuf[0] = (float *)AlcMalloc(sizeof(float) *
+                 (cBufSz.vtX + cBufSz.vtY + cBufSz.vtZ + 3) * 2)) == NULL) ||
+     ((lBuf = (float *)AlcMalloc(sizeof(float) * maxThr * lBufSz)) == NULL) ||
+     ((vBuf[0] = (float *)AlcMalloc(sizeof(float) * nXYZ)) == NULL) ||
+     ((vBuf[1] = (float *)AlcMalloc(sizeof(float) * nXYZ)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    int		idk;
+
+    kBuf[1] = kBuf[0] + (2 * cBufSz.vtX) + 1;
+    kBuf[2] = kBuf[1] + (2 * cBufSz.vtY) + 1;
+    for(idk = 0; idk <= 2 * cBufSz.vtX; ++idk)
+    {
+      kBuf[0][idk] = (float )(cBuf[0][idk]);
+    }
+    for(idk = 0; idk <= 2 * cBufSz.vtY; ++idk)
+    {
+      kBuf[1][idk] = (float )(cBuf[1][idk]);
+    }
+    for(idk = 0; idk <= 2 * cBufSz.vtZ; ++idk)
+    {
+      kBuf[2][idk] = (float )(cBuf[2][idk]);
+    }
+    zV.type = WLZ_GREY_INT;
+    zV.v.inv = 0;
+    (void )WlzValueConvertPixel(&zV, zV, gType);
+    rGTT = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, NULL);
+    rnObj = WlzNewObjectValues(inObj, rGTT, zV, 1, zV, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nPln = inObj->domain.p->lastpl - inObj->domain.p->plane1 + 1;
+    domains = inObj->domain.p->domains;
+    iVal = inObj->values.vox->values;
+    poff = inObj->domain.p->plane1 - inObj->values.vox->plane1;
+    rVal = rnObj->values.vox->values;
+    /* Copy the values into the volume buffer, filtering along the x axis
+     * at the same time. */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(maxThr)
+#endif
+    for(idp = 0; idp < nPln; ++idp)
+    {
+      if((errNum == WLZ_ERR_NONE) && (domains[idp].core != NULL))
+      {
+	int		thrId = 0;
+	WlzObject 	*iObj;
+	WlzIntervalWSpace iIWSp;
+	WlzGreyWSpace	iGWSp;
+	WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	iObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, domains[idp], iVal[idp + poff],
+			   NULL, NULL, &errNum2);
+	if((errNum2 == WLZ_ERR_NONE) &&
+	   ((errNum2 = WlzInitGreyScan(iObj, &iIWSp,
+				       &iGWSp)) == WLZ_ERR_NONE))
+	{
+	  float	*lB;
+
+	  lB = lBuf + (thrId * lBufSz);
+	  while((errNum2 = WlzNextGreyInterval(&iIWSp)) == WLZ_ERR_NONE)
+	  {
+	    int		len;
+	    WlzGreyP	vGP;
+
+	    len = iIWSp.rgtpos - iIWSp.lftpos + 1;
+	    vGP.flp = vBuf[0] + (idp * nXY) +
+	              ((iIWSp.linpos - bBox.yMin) * sz.vtX) +
+		      (iIWSp.lftpos - bBox.xMin);
+	    if(direc.vtX)
+	    {
+	      WlzGreyP	lGP;
+
+	      lGP.flp = lB + cBufSz.vtX;
+	      WlzValueCopyGreyToGrey(lGP, 0, WLZ_GREY_FLOAT,
+				     iGWSp.u_grintptr, 0, iGWSp.pixeltype,
+				     len);
+	      WlzSepFilterBlkLine(vGP.flp, lB, len,
+	      			  cBufSz.vtX, kBuf[0], pad, fPadVal);
+	    }
+	    else
+	    {
+	      WlzValueCopyGreyToGrey(vGP, 0, WLZ_GREY_FLOAT,
+				     iGWSp.u_grintptr, 0, iGWSp.pixeltype,
+				     len);
+	    }
+	  }
+	  (void )WlzEndGreyScan(&iIWSp, &iGWSp);
+	  if(errNum2 == WLZ_ERR_EOO)
+	  {
+	    errNum2 = WLZ_ERR_NONE;
+	  }
+	}
+	(void )WlzFreeObj(iObj);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzSepFilterBlk3D)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && direc.vtY)
+  {
+    float	*t;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(maxThr)
+#endif
+    for(idp = 0; idp < sz.vtZ; ++idp)
+    {
+      WlzSepFilterBlkLines(vBuf[1] + (idp * nXY), vBuf[0] + (idp * nXY),
+      			   sz.vtY, sz.vtX, sz.vtX,
+			   cBufSz.vtY, kBuf[1], pad, fPadVal);
+    }
+    t = vBuf[0]; vBuf[0] = vBuf[1]; vBuf[1] = t;
+  }
+  if((errNum == WLZ_ERR_NONE) && direc.vtZ)
+  {
+    int		idy;
+    float	*t;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(maxThr)
+#endif
+    for(idy = 0; idy < sz.vtY; ++idy)
+    {
+      WlzSepFilterBlkLines(vBuf[1] + (idy * sz.vtX), vBuf[0] + (idy * sz.vtX),
+      			   sz.vtZ, nXY, sz.vtX,
+			   cBufSz.vtZ, kBuf[2], pad, fPadVal);
+    }
+    t = vBuf[0]; vBuf[0] = vBuf[1]; vBuf[1] = t;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Copy the filtered values from the volume buffer into the new
+     * object's values converting them to the required grey type. */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(maxThr)
+#endif
+    for(idp = 0; idp < nPln; ++idp)
+    {
+      if((errNum == WLZ_ERR_NONE) && (domains[idp].core != NULL))
+      {
+	WlzObject 	*rObj;
+	WlzIntervalWSpace rIWSp;
+	WlzGreyWSpace	rGWSp;
+	WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+	rObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, domains[idp], rVal[idp],
+			   NULL, NULL, &errNum2);
+	if((errNum2 == WLZ_ERR_NONE) &&
+	   ((errNum2 = WlzInitGreyScan(rObj, &rIWSp,
+				       &rGWSp)) == WLZ_ERR_NONE))
+	{
+	  while((errNum2 = WlzNextGreyInterval(&rIWSp)) == WLZ_ERR_NONE)
+	  {
+	    WlzGreyP	vGP;
+
+	    vGP.flp = vBuf[0] + (idp * nXY) +
+	              ((rIWSp.linpos - bBox.yMin) * sz.vtX) +
+		      (rIWSp.lftpos - bBox.xMin);
+	    WlzValueCopyGreyToGrey(rGWSp.u_grintptr, 0, rGWSp.pixeltype,
+	    			   vGP, 0, WLZ_GREY_FLOAT,
+				   rIWSp.rgtpos - rIWSp.lftpos + 1);
+	  }
+	  (void )WlzEndGreyScan(&rIWSp, &rGWSp);
+	  if(errNum2 == WLZ_ERR_EOO)
+	  {
+	    errNum2 = WLZ_ERR_NONE;
+	  }
+	}
+	(void )WlzFreeObj(rObj);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzSepFilterBlk3D)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(kBuf[0]);
+  AlcFree(lBuf);
+  AlcFree(vBuf[0]);
+  AlcFree(vBuf[1]);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(rnObj);
+    rnObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rnObj);
+}
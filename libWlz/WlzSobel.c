@@ -114,12 +114,7 @@ WlzObject	*WlzSobel(WlzObject *srcObj, int hFlag, int vFlag,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-    {
-      sConv.linkcount = 0;
-    }
+    sConv.linkcount = 0;
     sConv.xsize = 3;
     sConv.ysize = 3;
     sConv.cv = NULL;
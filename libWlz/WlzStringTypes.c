@@ -1134,6 +1134,7 @@ WlzFnType	WlzStringToFnType(const char *tStr,
 		       "WLZ_FN_BASIS_3DCONF_POLY", WLZ_FN_BASIS_3DCONF_POLY,
 		       "WLZ_FN_BASIS_3DMOS", WLZ_FN_BASIS_3DMOS,
 		       "WLZ_FN_BASIS_SCALAR_3DMOS", WLZ_FN_BASIS_SCALAR_3DMOS,
+		       "WLZ_FN_BASIS_3DCS", WLZ_FN_BASIS_3DCS,
 		       NULL))
   {
     fn = (WlzFnType )tI0;
@@ -1204,6 +1205,9 @@ const char	*WlzStringFromFnType(WlzFnType fn,
     case WLZ_FN_BASIS_SCALAR_3DMOS:
       tStr = "WLZ_FN_BASIS_SCALAR_3DMOS";
       break;
+    case WLZ_FN_BASIS_3DCS:
+      tStr = "WLZ_FN_BASIS_3DCS";
+      break;
     default:
       errNum = WLZ_ERR_PARAM_DATA;
       break;
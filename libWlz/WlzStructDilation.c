@@ -64,6 +64,10 @@ static WlzObject 		*WlzStructDilation3d(
 				  WlzObject *obj,
 				  WlzObject *structElm,
 				  WlzErrorNum *dstErr);
+static WlzObject 		*WlzStructDilationDirect(
+				  WlzObject *obj,
+				  WlzObject *structElm,
+				  WlzErrorNum *dstErr);
 
 
 /*! 
@@ -73,6 +77,9 @@ static WlzObject 		*WlzStructDilation3d(
 *		structuring element. This is defined as the domain
 *		obtained as the union of the SE placed at every pixel
 *		of the input domain.
+*		Structuring elements which may be decomposed are
+*		applied using the decomposition chosen by
+*		WlzStructElmDecompFind().
 * \param    obj	Input object to be dilated
 * \param    structElm	Structuring element.
 * \param    dstErr	Error return.
@@ -83,6 +90,58 @@ WlzObject *WlzStructDilation(
   WlzObject	*obj,
   WlzObject	*structElm,
   WlzErrorNum	*dstErr)
+{
+  return WlzStructDilationDecomp(obj, structElm, WLZ_STRUCTELM_DECOMP_AUTO,
+  				 dstErr);
+}
+
+/*! 
+* \return       Dilated domain object.
+* \ingroup      WlzMorphologyOps
+* \brief        Dilate an object with respect to the given
+*		structuring element using the given decomposition
+*		of the structuring element, see WlzStructElmDecompFind().
+*		All decompositions give the same domain as the
+*		direct method (WLZ_STRUCTELM_DECOMP_NONE).
+* \param    obj	Input object to be dilated
+* \param    structElm	Structuring element.
+* \param    dcp	Decomposition method, WLZ_STRUCTELM_DECOMP_AUTO
+*			to choose the method from the structuring element.
+* \param    dstErr	Error return.
+* \par      Source:
+*                WlzStructDilation.c
+*/
+WlzObject *WlzStructDilationDecomp(
+  WlzObject	*obj,
+  WlzObject	*structElm,
+  WlzStructElmDecomp dcp,
+  WlzErrorNum	*dstErr)
+{
+  if( dcp == WLZ_STRUCTELM_DECOMP_AUTO ){
+    dcp = WlzStructElmDecompFind(obj, structElm, 0, NULL);
+  }
+  if( dcp == WLZ_STRUCTELM_DECOMP_NONE ){
+    return WlzStructDilationDirect(obj, structElm, dstErr);
+  }
+  return WlzStructElmDecompMorph(obj, structElm, dcp, 0, dstErr);
+}
+
+/*! 
+* \return       Dilated domain object.
+* \ingroup      WlzMorphologyOps
+* \brief        Dilate an object with respect to the given
+*		structuring element, applying the structuring
+*		element directly.
+* \param    obj	Input object to be dilated
+* \param    structElm	Structuring element.
+* \param    dstErr	Error return.
+* \par      Source:
+*                WlzStructDilation.c
+*/
+static WlzObject *WlzStructDilationDirect(
+  WlzObject	*obj,
+  WlzObject	*structElm,
+  WlzErrorNum	*dstErr)
 {
   WlzObject 		*rtnObj = NULL, *bObj = NULL, *sObj = NULL;
   WlzDomain		bDom,
@@ -681,7 +740,7 @@ static WlzObject *WlzStructDilation3d(
 	  obj2 = WlzMakeEmpty(NULL);
 	}
 	obj2 = WlzAssignObject(obj2, NULL);
-	objList[i] = WlzAssignObject(WlzStructDilation(obj1, obj2, NULL),
+	objList[i] = WlzAssignObject(WlzStructDilationDirect(obj1, obj2, NULL),
 				     NULL);
       }
       obj3 = WlzUnionN(nStructPlanes, objList, 0, &errNum);
@@ -0,0 +1,1391 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzStructElmDecomp_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzStructElmDecomp.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2012],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Decomposition of structuring elements for fast
+* 		morphological dilation and erosion.
+* \ingroup	WlzMorphologyOps
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <Wlz.h>
+
+/*!
+* \def		WLZ_STRUCTELM_DECOMP_DIST_COST
+* \ingroup	WlzMorphologyOps
+* \brief	Approximate cost of the distance transform per voxel of
+* 		it's bounding box relative to the cost of applying a
+* 		single structuring element line to a single object
+* 		interval by direct dilation or erosion.
+*/
+#define WLZ_STRUCTELM_DECOMP_DIST_COST	(10)
+
+/*!
+* \def		WLZ_STRUCTELM_DECOMP_PLANES_COST
+* \ingroup	WlzMorphologyOps
+* \brief	Approximate cost of shifting and combining the object's
+* 		dilation or erosion by a single plane of the structuring
+* 		element relative to the cost of applying a single
+* 		structuring element line by direct dilation or erosion.
+*/
+#define WLZ_STRUCTELM_DECOMP_PLANES_COST (2)
+
+/*!
+* \struct	_WlzStructElmRow
+* \ingroup	WlzMorphologyOps
+* \brief	A single line of a structuring element. Only the extreme
+* 		columns are kept as only rows with a single interval
+* 		are of interest.
+*/
+typedef struct _WlzStructElmRow
+{
+  int		nItv;			/*!< Number of intervals. */
+  int		lft;			/*!< Left most column. */
+  int		rgt;			/*!< Right most column. */
+} WlzStructElmRow;
+
+/*!
+* \struct	_WlzStructElmShape
+* \ingroup	WlzMorphologyOps
+* \brief	Shape of a structuring element together with the
+* 		decompositions which may be used to apply it.
+*/
+typedef struct _WlzStructElmShape
+{
+  int		canLine;		/*!< Non zero if a rectangle or
+  					     cuboid. */
+  int		canSeq;			/*!< Non zero if a sequence of unit
+  					     structuring elements. */
+  int		canDist;		/*!< Non zero if a digital disc
+  					     or ball. */
+  int		canPlanes;		/*!< Non zero if 3D with nested
+  					     planes which are symmetric
+					     about the central plane. */
+  int		nRow;			/*!< Number of non-empty rows. */
+  int		nPlnRow;		/*!< Number of rows which differ
+  					     from those of the next plane
+					     out from the central plane,
+					     ie the number of rows which
+					     are applied directly by the
+					     planes decomposition. */
+  int		r2;			/*!< Square of the disc or ball
+  					     radius. */
+  WlzIBox3	box;			/*!< Bounding box. */
+  WlzIVertex3	cen;			/*!< Centre of the bounding box. */
+  WlzConnectType con[2];		/*!< Unit structuring elements. */
+  int		cnt[2];			/*!< Number of times each of the
+  					     unit structuring elements is
+					     applied. */
+  WlzStructElmRow *rows;		/*!< Rows of the structuring
+  					     element's bounding box, plane
+					     by plane, which must be freed
+					     using AlcFree(). */
+} WlzStructElmShape;
+
+static int			WlzStructElmDecompRowHW(
+				  WlzDistanceType dTyp,
+				  int n,
+				  int r2,
+				  int dy,
+				  int dz);
+static int			WlzStructElmDecompRowsMatch(
+				  WlzStructElmShape *shp,
+				  WlzStructElmRow *rows,
+				  WlzDistanceType dTyp,
+				  int n);
+static int			WlzStructElmDecompPlanesMatch(
+				  WlzStructElmShape *shp);
+static WlzObject		*WlzStructElmDecompUnitObj(
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructElmDecompBoxObj(
+				  WlzObjectType oType,
+				  WlzIBox3 box,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructElmDecompShift(
+				  WlzObject *obj,
+				  WlzObject *refObj,
+				  WlzIVertex3 sft,
+				  int neg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructElmDecompLine(
+				  WlzObject *obj,
+				  WlzStructElmShape *shp,
+				  int ers,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructElmDecompSeq(
+				  WlzObject *obj,
+				  WlzStructElmShape *shp,
+				  int ers,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructElmDecompDist(
+				  WlzObject *obj,
+				  WlzStructElmShape *shp,
+				  int ers,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructElmDecompRowsObj(
+				  WlzStructElmShape *shp,
+				  int p0,
+				  int p1,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructElmDecompPlanes(
+				  WlzObject *obj,
+				  WlzStructElmShape *shp,
+				  int ers,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzStructElmDecompShape(
+				  WlzObject *obj,
+				  WlzObject *se,
+				  WlzStructElmShape *shp);
+
+/*!
+* \return	Decomposition method.
+* \ingroup	WlzMorphologyOps
+* \brief	Chooses a method by which the given structuring element
+* 		may be decomposed for dilation or erosion of the given
+* 		object. The method chosen is:
+* 		<ul>
+* 		<li>WLZ_STRUCTELM_DECOMP_LINE for rectangles and cuboids,
+* 		    which are applied as line segments along each axis
+* 		    using a logarithmic number of unions or intersections
+* 		    per axis.
+* 		<li>WLZ_STRUCTELM_DECOMP_SEQ for diamonds, octagons and
+* 		    octahedra (as made by WlzMakeStdStructElement() for
+* 		    the 4, 6, 18 and octagonal distances), which are
+* 		    applied as a sequence of unit dilations or erosions.
+* 		<li>WLZ_STRUCTELM_DECOMP_DIST for digital discs and balls,
+* 		    ie the lattice points within a given Euclidean distance
+* 		    of the centre, which are applied by thresholding a
+* 		    Euclidean distance transform, but only when this is
+* 		    likely to be faster than the direct method.
+* 		<li>WLZ_STRUCTELM_DECOMP_PLANES for 3D structuring
+* 		    elements with nested planes which are symmetric about
+* 		    the central plane, such as the spheres made by
+* 		    WlzMakeSphereObject(), which are applied plane by
+* 		    plane, but only when this is likely to be faster
+* 		    than the direct method (or a distance transform).
+* 		<li>WLZ_STRUCTELM_DECOMP_NONE otherwise.
+* 		</ul>
+* 		All of these give exactly the same domain as the direct
+* 		method.
+* 		Only 2D and 3D domain objects are decomposed. The
+* 		decomposition of a structuring element requires only the
+* 		domain of the element and is linear in the number of
+* 		its lines.
+* \param	obj			Given object to be dilated or eroded.
+* \param	se			Given structuring element.
+* \param	ers			Non zero for erosion, zero for dilation.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzStructElmDecomp WlzStructElmDecompFind(WlzObject *obj, WlzObject *se,
+					int ers, WlzErrorNum *dstErr)
+{
+  WlzStructElmShape shp;
+  WlzStructElmDecomp dcp = WLZ_STRUCTELM_DECOMP_NONE;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzStructElmDecompShape(obj, se, &shp);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(shp.canLine)
+    {
+      dcp = WLZ_STRUCTELM_DECOMP_LINE;
+    }
+    else if(shp.canSeq)
+    {
+      dcp = WLZ_STRUCTELM_DECOMP_SEQ;
+    }
+    else if(shp.canDist || shp.canPlanes)
+    {
+      int	r;
+      double	vol,
+      		nItv,
+		cost,
+		minCost;
+      WlzIBox3	box;
+
+      /* Compare the cost of the direct method, which is proportional to
+       * the number of object intervals times the number of structuring
+       * element lines, with the cost of the distance transform, which is
+       * linear in the volume of the object's bounding box (expanded by
+       * the radius for dilation or by one for erosion), and with the
+       * cost of the planes decomposition, which applies fewer lines
+       * but shifts and combines the result for each plane. */
+      box = WlzBoundingBox3I(obj, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	nItv = (double )WlzIntervalCountObj(obj, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	minCost = nItv * shp.nRow;
+	if(shp.canDist)
+	{
+	  r = (ers)? 1: (int )floor(sqrt((double )(shp.r2)));
+	  vol = (double )(box.xMax - box.xMin + 2 * r + 1) *
+		(double )(box.yMax - box.yMin + 2 * r + 1);
+	  if(obj->type == WLZ_3D_DOMAINOBJ)
+	  {
+	    vol *= (double )(box.zMax - box.zMin + 2 * r + 1);
+	  }
+	  cost = WLZ_STRUCTELM_DECOMP_DIST_COST * vol;
+	  if(cost < minCost)
+	  {
+	    minCost = cost;
+	    dcp = WLZ_STRUCTELM_DECOMP_DIST;
+	  }
+	}
+	if(shp.canPlanes)
+	{
+	  cost = nItv * (shp.nPlnRow + WLZ_STRUCTELM_DECOMP_PLANES_COST *
+	                               (shp.box.zMax - shp.box.zMin + 1));
+	  if(cost < minCost)
+	  {
+	    dcp = WLZ_STRUCTELM_DECOMP_PLANES;
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(shp.rows);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    dcp = WLZ_STRUCTELM_DECOMP_NONE;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dcp);
+}
+
+/*!
+* \return	Dilated or eroded domain object.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes the given object by the given
+* 		structuring element using the given decomposition of
+* 		the structuring element. The returned object has the
+* 		same domain as that computed by WlzStructDilation() or
+* 		WlzStructErosion(), it has no values.
+* 		An error (WLZ_ERR_PARAM_DATA) is returned if the
+* 		structuring element can not be decomposed using the
+* 		given method.
+* \param	obj			Given 2D or 3D domain object.
+* \param	se			Given structuring element.
+* \param	dcp			Decomposition method, which must be
+* 					one of WLZ_STRUCTELM_DECOMP_LINE,
+* 					WLZ_STRUCTELM_DECOMP_SEQ,
+* 					WLZ_STRUCTELM_DECOMP_DIST or
+* 					WLZ_STRUCTELM_DECOMP_PLANES.
+* \param	ers			Erode if non zero, otherwise dilate.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzStructElmDecompMorph(WlzObject *obj, WlzObject *se,
+					WlzStructElmDecomp dcp, int ers,
+					WlzErrorNum *dstErr)
+{
+  WlzIVertex3	sft;
+  WlzStructElmShape shp;
+  WlzObject	*uObj = NULL,
+  		*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzStructElmDecompShape(obj, se, &shp);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(dcp)
+    {
+      case WLZ_STRUCTELM_DECOMP_LINE:
+        errNum = (shp.canLine)? WLZ_ERR_NONE: WLZ_ERR_PARAM_DATA;
+	break;
+      case WLZ_STRUCTELM_DECOMP_SEQ:
+        errNum = (shp.canSeq)? WLZ_ERR_NONE: WLZ_ERR_PARAM_DATA;
+	break;
+      case WLZ_STRUCTELM_DECOMP_DIST:
+        errNum = (shp.canDist)? WLZ_ERR_NONE: WLZ_ERR_PARAM_DATA;
+	break;
+      case WLZ_STRUCTELM_DECOMP_PLANES:
+        errNum = (shp.canPlanes)? WLZ_ERR_NONE: WLZ_ERR_PARAM_DATA;
+	break;
+      default:
+        errNum = WLZ_ERR_PARAM_DATA;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    uObj = WlzAssignObject(WlzStructElmDecompUnitObj(obj, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(dcp)
+    {
+      case WLZ_STRUCTELM_DECOMP_LINE:
+	rObj = WlzStructElmDecompLine(uObj, &shp, ers, &errNum);
+	break;
+      case WLZ_STRUCTELM_DECOMP_SEQ:
+	rObj = WlzStructElmDecompSeq(uObj, &shp, ers, &errNum);
+	break;
+      case WLZ_STRUCTELM_DECOMP_DIST:
+	rObj = WlzStructElmDecompDist(uObj, &shp, ers, &errNum);
+	break;
+      case WLZ_STRUCTELM_DECOMP_PLANES:
+	rObj = WlzStructElmDecompPlanes(uObj, &shp, ers, &errNum);
+	break;
+      default:
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzObject	*tObj;
+
+    /* Shift by the origin of the line segments or by the centre, the
+     * planes decomposition uses the structuring element's own
+     * coordinates. */
+    if(dcp == WLZ_STRUCTELM_DECOMP_LINE)
+    {
+      WLZ_VTX_3_SET(sft, shp.box.xMin, shp.box.yMin, shp.box.zMin);
+    }
+    else if(dcp == WLZ_STRUCTELM_DECOMP_PLANES)
+    {
+      WLZ_VTX_3_ZERO(sft);
+    }
+    else
+    {
+      sft = shp.cen;
+    }
+    tObj = WlzAssignObject(rObj, NULL);
+    rObj = WlzStructElmDecompShift(tObj, obj, sft, ers, &errNum);
+    (void )WlzFreeObj(tObj);
+  }
+  (void )WlzFreeObj(uObj);
+  AlcFree(shp.rows);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	Half width of the row or -1 if the row is empty.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the half width of a row of a symmetric
+* 		structuring element of the given type.
+* \param	dTyp			Type of structuring element:
+* 					WLZ_4_DISTANCE for a diamond,
+* 					WLZ_OCTAGONAL_DISTANCE for an
+* 					octagon, WLZ_6_DISTANCE or
+* 					WLZ_18_DISTANCE for the 3D
+* 					octahedra and WLZ_EUCLIDEAN_DISTANCE
+* 					for a disc or ball.
+* \param	n			Half width of the bounding box.
+* \param	r2			Square of the disc or ball radius.
+* \param	dy			Line offset from the centre.
+* \param	dz			Plane offset from the centre.
+*/
+static int	WlzStructElmDecompRowHW(WlzDistanceType dTyp, int n, int r2,
+					int dy, int dz)
+{
+  int		hw = -1;
+
+  dy = abs(dy);
+  dz = abs(dz);
+  switch(dTyp)
+  {
+    case WLZ_4_DISTANCE: /* FALLTHROUGH */
+    case WLZ_6_DISTANCE:
+      hw = n - dy - dz;
+      break;
+    case WLZ_OCTAGONAL_DISTANCE:
+      hw = ALG_MIN(n, (2 * ((n + 1) / 2)) + (n / 2) - dy);
+      break;
+    case WLZ_18_DISTANCE:
+      hw = ALG_MIN(n, (2 * n) - dy - dz);
+      break;
+    case WLZ_EUCLIDEAN_DISTANCE:
+      if((hw = r2 - (dy * dy) - (dz * dz)) >= 0)
+      {
+        int	s;
+
+	s = (int )floor(sqrt((double )hw));
+	while(s * s > hw)
+	{
+	  --s;
+	}
+	while((s + 1) * (s + 1) <= hw)
+	{
+	  ++s;
+	}
+	hw = s;
+      }
+      break;
+    default:
+      break;
+  }
+  return(hw);
+}
+
+/*!
+* \return	Non zero if the rows match the structuring element type.
+* \ingroup	WlzMorphologyOps
+* \brief	Checks whether every row of a structuring element is
+* 		the single centred interval required by the given type
+* 		of structuring element.
+* \param	shp			Structuring element shape.
+* \param	rows			Rows of the structuring element.
+* \param	dTyp			Type of structuring element, see
+* 					WlzStructElmDecompRowHW().
+* \param	n			Half width of the bounding box.
+*/
+static int	WlzStructElmDecompRowsMatch(WlzStructElmShape *shp,
+					    WlzStructElmRow *rows,
+					    WlzDistanceType dTyp, int n)
+{
+  int		y,
+  		z,
+		hw,
+		match = 1;
+  WlzStructElmRow *row;
+
+  row = rows;
+  for(z = shp->box.zMin; match && (z <= shp->box.zMax); ++z)
+  {
+    for(y = shp->box.yMin; match && (y <= shp->box.yMax); ++y)
+    {
+      hw = WlzStructElmDecompRowHW(dTyp, n, shp->r2,
+                                   y - shp->cen.vtY, z - shp->cen.vtZ);
+      match = (hw < 0)? (row->nItv == 0):
+			((row->nItv == 1) &&
+			 (row->lft == shp->cen.vtX - hw) &&
+			 (row->rgt == shp->cen.vtX + hw));
+      ++row;
+    }
+  }
+  return(match);
+}
+
+/*!
+* \return	New domain object with unit voxel size and no values.
+* \ingroup	WlzMorphologyOps
+* \brief	Makes a domain object which shares the domain of the
+* 		given object but which has no values and, if 3D, unit
+* 		voxel size.
+* \param	obj			Given 2D or 3D domain object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzStructElmDecompUnitObj(WlzObject *obj,
+					    WlzErrorNum *dstErr)
+{
+  int		p,
+  		nPln;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*uObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  val.core = NULL;
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    uObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, obj->domain, val, NULL, NULL,
+                       &errNum);
+  }
+  else
+  {
+    WlzPlaneDomain *pDom;
+
+    pDom = obj->domain.p;
+    dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+			       pDom->plane1, pDom->lastpl,
+			       pDom->line1, pDom->lastln,
+			       pDom->kol1, pDom->lastkl, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nPln = pDom->lastpl - pDom->plane1 + 1;
+      for(p = 0; p < nPln; ++p)
+      {
+	dom.p->domains[p] = WlzAssignDomain(pDom->domains[p], NULL);
+      }
+      uObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+      if(errNum != WLZ_ERR_NONE)
+      {
+	(void )WlzFreePlaneDomain(dom.p);
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(uObj);
+}
+
+/*!
+* \return	New rectangular or cuboid domain object.
+* \ingroup	WlzMorphologyOps
+* \brief	Makes a rectangular (2D) or cuboid (3D) domain object
+* 		with unit voxel size which covers the given box.
+* \param	oType			Object type, either WLZ_2D_DOMAINOBJ
+* 					or WLZ_3D_DOMAINOBJ.
+* \param	box			Given box.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzStructElmDecompBoxObj(WlzObjectType oType,
+					   WlzIBox3 box,
+					   WlzErrorNum *dstErr)
+{
+  int		p,
+  		nPln;
+  WlzDomain	dom,
+  		dom2;
+  WlzValues	val;
+  WlzObject	*bObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  if(oType == WLZ_2D_DOMAINOBJ)
+  {
+    dom.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_RECT,
+				  box.yMin, box.yMax, box.xMin, box.xMax,
+				  &errNum);
+  }
+  else
+  {
+    dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+			       box.zMin, box.zMax, box.yMin, box.yMax,
+			       box.xMin, box.xMax, &errNum);
+    nPln = box.zMax - box.zMin + 1;
+    for(p = 0; (errNum == WLZ_ERR_NONE) && (p < nPln); ++p)
+    {
+      dom2.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_RECT,
+				     box.yMin, box.yMax, box.xMin, box.xMax,
+				     &errNum);
+      dom.p->domains[p] = WlzAssignDomain(dom2, NULL);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bObj = WlzMakeMain(oType, dom, val, NULL, NULL, &errNum);
+  }
+  if((errNum != WLZ_ERR_NONE) && dom.core)
+  {
+    (void )WlzFreeDomain(dom);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(bObj);
+}
+
+/*!
+* \return	New shifted domain object.
+* \ingroup	WlzMorphologyOps
+* \brief	Shifts the given domain object, giving it the voxel
+* 		size of the reference object if 3D.
+* \param	obj			Given domain or empty object.
+* \param	refObj			Reference object for the voxel
+* 					size.
+* \param	sft			Shift.
+* \param	neg			Shift by minus the given shift if
+* 					non zero.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzStructElmDecompShift(WlzObject *obj, WlzObject *refObj,
+					  WlzIVertex3 sft, int neg,
+					  WlzErrorNum *dstErr)
+{
+  WlzObject	*sObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(neg)
+  {
+    WLZ_VTX_3_NEGATE(sft, sft);
+  }
+  sObj = WlzShiftObject(obj, sft.vtX, sft.vtY, sft.vtZ, &errNum);
+  if((errNum == WLZ_ERR_NONE) && (sObj->type == WLZ_3D_DOMAINOBJ))
+  {
+    sObj->domain.p->voxel_size[0] = refObj->domain.p->voxel_size[0];
+    sObj->domain.p->voxel_size[1] = refObj->domain.p->voxel_size[1];
+    sObj->domain.p->voxel_size[2] = refObj->domain.p->voxel_size[2];
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(sObj);
+}
+
+/*!
+* \return	Dilated or eroded object, not yet shifted by the
+* 		structuring element's origin.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes the given object by a rectangle or
+* 		cuboid with it's minimum coordinates at the origin.
+* 		This is done along each axis in turn by a line segment
+* 		using the union (dilation) or intersection (erosion)
+* 		of the object with itself shifted, so that a line of
+* 		length \f$L\f$ requires \f$\lceil\log_2 L\rceil\f$
+* 		unions or intersections.
+* \param	obj			Given domain object.
+* \param	shp			Structuring element shape.
+* \param	ers			Erode if non zero, otherwise dilate.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzStructElmDecompLine(WlzObject *obj,
+					 WlzStructElmShape *shp,
+					 int ers, WlzErrorNum *dstErr)
+{
+  int		ax,
+  		nAx,
+		len,
+		lenS,
+		s;
+  WlzIVertex3	sft;
+  WlzObject	*cObj,
+  		*sObj,
+		*tObj;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nAx = (obj->type == WLZ_2D_DOMAINOBJ)? 2: 3;
+  cObj = obj;
+  for(ax = 0; (errNum == WLZ_ERR_NONE) && (ax < nAx); ++ax)
+  {
+    switch(ax)
+    {
+      case 0:
+        lenS = shp->box.xMax - shp->box.xMin + 1;
+	break;
+      case 1:
+        lenS = shp->box.yMax - shp->box.yMin + 1;
+	break;
+      default:
+        lenS = shp->box.zMax - shp->box.zMin + 1;
+	break;
+    }
+    len = 1;
+    while((errNum == WLZ_ERR_NONE) && (len < lenS) &&
+          (cObj->type != WLZ_EMPTY_OBJ))
+    {
+      s = ALG_MIN(len, lenS - len);
+      WLZ_VTX_3_ZERO(sft);
+      switch(ax)
+      {
+        case 0:
+	  sft.vtX = (ers)? -s: s;
+	  break;
+        case 1:
+	  sft.vtY = (ers)? -s: s;
+	  break;
+        default:
+	  sft.vtZ = (ers)? -s: s;
+	  break;
+      }
+      tObj = NULL;
+      sObj = WlzAssignObject(
+             WlzShiftObject(cObj, sft.vtX, sft.vtY, sft.vtZ, &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	tObj = (ers)? WlzIntersect2(cObj, sObj, &errNum):
+		      WlzUnion2(cObj, sObj, &errNum);
+      }
+      (void )WlzFreeObj(sObj);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	if(cObj != obj)
+	{
+	  (void )WlzFreeObj(cObj);
+	}
+	cObj = tObj;
+      }
+      len += s;
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    if(cObj != obj)
+    {
+      (void )WlzFreeObj(cObj);
+    }
+    cObj = NULL;
+  }
+  else if(cObj == obj)
+  {
+    cObj = WlzMakeMain(obj->type, obj->domain, obj->values, NULL, NULL,
+                       &errNum);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cObj);
+}
+
+/*!
+* \return	Dilated or eroded object, not yet shifted by the
+* 		structuring element's centre.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes the given object by a structuring
+* 		element centred on the origin which is the Minkowski
+* 		sum of unit structuring elements, by applying each of
+* 		the unit structuring elements in turn.
+* \param	obj			Given domain object.
+* \param	shp			Structuring element shape.
+* \param	ers			Erode if non zero, otherwise dilate.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzStructElmDecompSeq(WlzObject *obj,
+				        WlzStructElmShape *shp,
+				        int ers, WlzErrorNum *dstErr)
+{
+  int		i,
+  		j;
+  WlzObject	*cObj,
+  		*tObj;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  cObj = obj;
+  for(i = 0; (errNum == WLZ_ERR_NONE) && (i < 2); ++i)
+  {
+    for(j = 0; (errNum == WLZ_ERR_NONE) && (j < shp->cnt[i]) &&
+               (cObj->type != WLZ_EMPTY_OBJ); ++j)
+    {
+      tObj = (ers)? WlzErosion(cObj, shp->con[i], &errNum):
+                    WlzDilation(cObj, shp->con[i], &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	if(cObj != obj)
+	{
+	  (void )WlzFreeObj(cObj);
+	}
+	cObj = tObj;
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    if(cObj != obj)
+    {
+      (void )WlzFreeObj(cObj);
+    }
+    cObj = NULL;
+  }
+  else if(cObj == obj)
+  {
+    cObj = WlzMakeMain(obj->type, obj->domain, obj->values, NULL, NULL,
+                       &errNum);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cObj);
+}
+
+/*!
+* \return	Dilated or eroded object, not yet shifted by the
+* 		structuring element's centre.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes the given object by a digital disc or
+* 		ball centred on the origin using an exact Euclidean
+* 		distance transform. For dilation the distance from the
+* 		object is computed within the object's bounding box
+* 		expanded by the radius, for erosion the distance from
+* 		the object's complement (within the object's bounding
+* 		box expanded by one) is computed within the object.
+* 		Since the squared distances are integers these are
+* 		thresholded at \f$\sqrt{r^2 + 1/2}\f$.
+* \param	obj			Given domain object with unit voxel
+* 					size.
+* \param	shp			Structuring element shape.
+* \param	ers			Erode if non zero, otherwise dilate.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzStructElmDecompDist(WlzObject *obj,
+				         WlzStructElmShape *shp,
+				         int ers, WlzErrorNum *dstErr)
+{
+  int		r;
+  WlzIBox3	box;
+  WlzPixelV	thr;
+  WlzObject	*bObj = NULL,
+  		*dObj = NULL,
+		*fObj = NULL,
+		*rObj = NULL,
+		*tObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  r = (ers)? 1: (int )floor(sqrt((double )(shp->r2)));
+  box = WlzBoundingBox3I(obj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    box.xMin -= r;
+    box.yMin -= r;
+    box.xMax += r;
+    box.yMax += r;
+    if(obj->type == WLZ_3D_DOMAINOBJ)
+    {
+      box.zMin -= r;
+      box.zMax += r;
+    }
+    bObj = WlzAssignObject(
+           WlzStructElmDecompBoxObj(obj->type, box, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(ers)
+    {
+      fObj = WlzAssignObject(obj, NULL);
+      rObj = WlzAssignObject(WlzDiffDomain(bObj, obj, &errNum), NULL);
+    }
+    else
+    {
+      fObj = WlzAssignObject(bObj, NULL);
+      rObj = WlzAssignObject(obj, NULL);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    dObj = WlzAssignObject(
+	   WlzDistanceTransform(fObj, rObj, WLZ_EUCLIDEAN_DISTANCE,
+				0.0, 0.0, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    thr.type = WLZ_GREY_DOUBLE;
+    thr.v.dbv = sqrt(shp->r2 + 0.5);
+    tObj = WlzAssignObject(
+           WlzThreshold(dObj, thr,
+	                (ers)? WLZ_THRESH_HIGH: WLZ_THRESH_LOW,
+			&errNum), NULL);
+  }
+  (void )WlzFreeObj(bObj);
+  (void )WlzFreeObj(dObj);
+  (void )WlzFreeObj(fObj);
+  (void )WlzFreeObj(rObj);
+  dObj = NULL;
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(tObj->type == WLZ_EMPTY_OBJ)
+    {
+      dObj = WlzMakeEmpty(&errNum);
+    }
+    else
+    {
+      dObj = WlzStructElmDecompUnitObj(tObj, &errNum);
+    }
+  }
+  (void )WlzFreeObj(tObj);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dObj);
+}
+
+/*!
+* \return	New 2D domain object or NULL if there are no rows.
+* \ingroup	WlzMorphologyOps
+* \brief	Makes a 2D domain object from the rows of the given
+* 		plane of the structuring element which differ from
+* 		those of a second plane. The object is in the
+* 		structuring element's own coordinates.
+* \param	shp			Structuring element shape with rows.
+* \param	p0			Index of the plane with the rows.
+* \param	p1			Index of the plane with the rows to
+* 					leave out, or -1 to keep all the
+* 					rows of plane p0.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzStructElmDecompRowsObj(WlzStructElmShape *shp,
+					    int p0, int p1,
+					    WlzErrorNum *dstErr)
+{
+  int		y,
+  		nLn,
+		nItv = 0;
+  WlzStructElmRow *r0,
+  		*r1;
+  WlzInterval	*itv;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  nLn = shp->box.yMax - shp->box.yMin + 1;
+  r0 = shp->rows + (p0 * nLn);
+  r1 = (p1 < 0)? NULL: shp->rows + (p1 * nLn);
+  for(y = 0; y < nLn; ++y)
+  {
+    if(r0[y].nItv &&
+       ((r1 == NULL) || (r1[y].nItv == 0) ||
+        (r0[y].lft != r1[y].lft) || (r0[y].rgt != r1[y].rgt)))
+    {
+      ++nItv;
+    }
+  }
+  if(nItv > 0)
+  {
+    dom.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+				  shp->box.yMin, shp->box.yMax,
+				  shp->box.xMin, shp->box.xMax, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if((itv = (WlzInterval *)
+		AlcCalloc(nItv, sizeof(WlzInterval))) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+	(void )WlzFreeIntervalDomain(dom.i);
+	dom.core = NULL;
+      }
+      else
+      {
+	dom.i->freeptr = AlcFreeStackPush(dom.i->freeptr, (void *)itv, NULL);
+	for(y = 0; y < nLn; ++y)
+	{
+	  if(r0[y].nItv &&
+	     ((r1 == NULL) || (r1[y].nItv == 0) ||
+	      (r0[y].lft != r1[y].lft) || (r0[y].rgt != r1[y].rgt)))
+	  {
+	    itv->ileft = r0[y].lft - shp->box.xMin;
+	    itv->iright = r0[y].rgt - shp->box.xMin;
+	    (void )WlzMakeInterval(shp->box.yMin + y, dom.i, 1, itv);
+	    ++itv;
+	  }
+	  else
+	  {
+	    (void )WlzMakeInterval(shp->box.yMin + y, dom.i, 0, NULL);
+	  }
+	}
+	(void )WlzStandardIntervalDomain(dom.i);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+      if(errNum != WLZ_ERR_NONE)
+      {
+        (void )WlzFreeIntervalDomain(dom.i);
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
+/*!
+* \return	Dilated or eroded object in the structuring element's
+* 		own coordinates.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes the given 3D object by a 3D structuring
+* 		element with nested planes which are symmetric about the
+* 		central plane. The structuring element is the union of
+* 		its planes \f$P_k\f$ shifted to \f$z_c \pm k\f$, so the
+* 		dilation is the union of the object's planewise
+* 		dilations \f$D_k\f$ by each plane shifted by
+* 		\f$z_c \pm k\f$ (and the erosion the intersection of
+* 		the planewise erosions \f$E_k\f$ shifted by
+* 		\f$-(z_c \pm k)\f$). Because the planes are nested,
+* 		\f$D_k = D_{k+1} \cup (O \oplus R_k)\f$ where \f$R_k\f$
+* 		are the rows of \f$P_k\f$ which differ from those of
+* 		\f$P_{k+1}\f$, so only these rows are applied directly.
+* \param	obj			Given 3D domain object with unit
+* 					voxel size.
+* \param	shp			Structuring element shape with rows.
+* \param	ers			Erode if non zero, otherwise dilate.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzStructElmDecompPlanes(WlzObject *obj,
+				           WlzStructElmShape *shp,
+				           int ers, WlzErrorNum *dstErr)
+{
+  int		k,
+  		pc,
+		zc,
+		nPln,
+		empty = 0;
+  WlzObject	*cObj = NULL,
+  		*rObj = NULL,
+		*sObj = NULL,
+		*tObj = NULL;
+  WlzObject	**pObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nPln = shp->box.zMax - shp->box.zMin + 1;
+  pc = nPln / 2;
+  zc = shp->box.zMin + pc;
+  if((pObj = (WlzObject **)AlcCalloc(nPln, sizeof(WlzObject *))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Work in from the outermost planes, applying only the rows which
+   * differ from those of the previous plane. */
+  for(k = pc; (errNum == WLZ_ERR_NONE) && !empty && (k >= 0); --k)
+  {
+    rObj = WlzAssignObject(
+	   WlzStructElmDecompRowsObj(shp, pc + k, (k < pc)? pc + k + 1: -1,
+				     &errNum), NULL);
+    if((errNum == WLZ_ERR_NONE) && rObj)
+    {
+      tObj = (ers)? WlzStructErosion(obj, rObj, &errNum):
+		    WlzStructDilation(obj, rObj, &errNum);
+      if((errNum == WLZ_ERR_NONE) && cObj)
+      {
+	sObj = WlzAssignObject(tObj, NULL);
+	tObj = (ers)? WlzIntersect2(cObj, sObj, &errNum):
+		      WlzUnion2(cObj, sObj, &errNum);
+	(void )WlzFreeObj(sObj);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	(void )WlzFreeObj(cObj);
+	cObj = WlzAssignObject(tObj, NULL);
+	empty = (cObj == NULL) || (cObj->type == WLZ_EMPTY_OBJ);
+      }
+    }
+    (void )WlzFreeObj(rObj);
+    if((errNum == WLZ_ERR_NONE) && !empty)
+    {
+      pObj[pc + k] = WlzAssignObject(
+		     WlzShiftObject(cObj, 0, 0, (ers)? -(zc + k): zc + k,
+				    &errNum), NULL);
+      if((errNum == WLZ_ERR_NONE) && (k > 0))
+      {
+	pObj[pc - k] = WlzAssignObject(
+		       WlzShiftObject(cObj, 0, 0, (ers)? -(zc - k): zc - k,
+				      &errNum), NULL);
+      }
+    }
+  }
+  (void )WlzFreeObj(cObj);
+  cObj = NULL;
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(empty)
+    {
+      cObj = WlzMakeEmpty(&errNum);
+    }
+    else
+    {
+      cObj = (ers)? WlzIntersectN(nPln, pObj, 0, &errNum):
+		    WlzUnionN(nPln, pObj, 0, &errNum);
+    }
+  }
+  if(pObj)
+  {
+    for(k = 0; k < nPln; ++k)
+    {
+      (void )WlzFreeObj(pObj[k]);
+    }
+    AlcFree(pObj);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Analyses the shape of the given structuring element
+* 		to find which decompositions may be used to dilate or
+* 		erode the given object. If the objects are not 2D or
+* 		3D domain objects, are empty or a 3D structuring
+* 		element is given with a 2D object then no decomposition
+* 		is possible, but this is not an error.
+* 		The rows of the structuring element are kept in the
+* 		shape and must be freed using AlcFree().
+* \param	obj			Given object.
+* \param	se			Given structuring element.
+* \param	shp			Destination for the shape.
+*/
+static WlzErrorNum WlzStructElmDecompShape(WlzObject *obj, WlzObject *se,
+				          WlzStructElmShape *shp)
+{
+  int		p,
+  		nPln,
+		nLn,
+		hx,
+		hy,
+		hz,
+		d2;
+  WlzObject	*pObj;
+  WlzStructElmRow *row,
+  		*rows = NULL;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )memset(shp, 0, sizeof(WlzStructElmShape));
+  if((obj == NULL) || (se == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if((obj->domain.core == NULL) || (se->domain.core == NULL) ||
+          (obj->domain.core->type == WLZ_EMPTY_DOMAIN) ||
+          (se->domain.core->type == WLZ_EMPTY_DOMAIN) ||
+	  ((obj->type != WLZ_2D_DOMAINOBJ) &&
+	   (obj->type != WLZ_3D_DOMAINOBJ)) ||
+	  ((se->type != WLZ_2D_DOMAINOBJ) &&
+	   (se->type != WLZ_3D_DOMAINOBJ)) ||
+	  ((obj->type == WLZ_2D_DOMAINOBJ) &&
+	   (se->type == WLZ_3D_DOMAINOBJ)))
+  {
+    return(WLZ_ERR_NONE);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    shp->box = WlzBoundingBox3I(se, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nPln = shp->box.zMax - shp->box.zMin + 1;
+    nLn = shp->box.yMax - shp->box.yMin + 1;
+    if((rows = (WlzStructElmRow *)
+	       AlcCalloc(nPln * nLn, sizeof(WlzStructElmRow))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    shp->rows = rows;
+  }
+  /* Gather the rows of the structuring element. */
+  for(p = 0; (errNum == WLZ_ERR_NONE) && (p < nPln); ++p)
+  {
+    WlzDomain	dom;
+    WlzValues	val;
+
+    pObj = NULL;
+    val.core = NULL;
+    dom = (se->type == WLZ_2D_DOMAINOBJ)?
+          se->domain:
+	  se->domain.p->domains[shp->box.zMin + p - se->domain.p->plane1];
+    if(dom.core && (dom.core->type != WLZ_EMPTY_DOMAIN))
+    {
+      pObj = WlzAssignObject(
+	     WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL,
+			 &errNum), NULL);
+    }
+    if((errNum == WLZ_ERR_NONE) && pObj)
+    {
+      errNum = WlzInitRasterScan(pObj, &iWSp, WLZ_RASTERDIR_ILIC);
+      while((errNum == WLZ_ERR_NONE) &&
+            ((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE))
+      {
+	row = rows + (p * nLn) + iWSp.linpos - shp->box.yMin;
+	if(row->nItv++ == 0)
+	{
+	  row->lft = iWSp.lftpos;
+	  ++(shp->nRow);
+	}
+	row->rgt = iWSp.rgtpos;
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+        errNum = WLZ_ERR_NONE;
+      }
+    }
+    (void )WlzFreeObj(pObj);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    hx = shp->box.xMax - shp->box.xMin;
+    hy = shp->box.yMax - shp->box.yMin;
+    hz = shp->box.zMax - shp->box.zMin;
+    /* Rectangle or cuboid. */
+    shp->canLine = shp->nRow == nPln * nLn;
+    row = rows;
+    for(p = 0; shp->canLine && (p < nPln * nLn); ++p)
+    {
+      shp->canLine = (row->nItv == 1) &&
+                     (row->lft == shp->box.xMin) &&
+		     (row->rgt == shp->box.xMax);
+      ++row;
+    }
+    /* Symmetric structuring elements with equal half widths in x and y
+     * and either a single plane or the same half width in z. */
+    if(!(shp->canLine) &&
+       ((hx % 2) == 0) && (hx == hy) && ((hz == 0) || (hz == hx)) &&
+       ((hz == 0) || (obj->type == WLZ_3D_DOMAINOBJ)))
+    {
+      hx /= 2;
+      hz /= 2;
+      shp->cen.vtX = shp->box.xMin + hx;
+      shp->cen.vtY = shp->box.yMin + hx;
+      shp->cen.vtZ = shp->box.zMin + hz;
+      /* Square of the radius of the smallest enclosing ball. */
+      row = rows;
+      for(p = 0; p < nPln * nLn; ++p)
+      {
+	if(row->nItv > 0)
+	{
+	  int	dx,
+	  	dy,
+		dz;
+
+	  dx = ALG_MAX(shp->cen.vtX - row->lft, row->rgt - shp->cen.vtX);
+	  dy = shp->box.yMin + (p % nLn) - shp->cen.vtY;
+	  dz = shp->box.zMin + (p / nLn) - shp->cen.vtZ;
+	  d2 = (dx * dx) + (dy * dy) + (dz * dz);
+	  shp->r2 = ALG_MAX(shp->r2, d2);
+	}
+	++row;
+      }
+      if(hz == 0)
+      {
+	if(WlzStructElmDecompRowsMatch(shp, rows, WLZ_4_DISTANCE, hx))
+	{
+	  shp->canSeq = 1;
+	  shp->con[0] = WLZ_4_CONNECTED;
+	  shp->cnt[0] = hx;
+	}
+	else if(WlzStructElmDecompRowsMatch(shp, rows,
+	                                    WLZ_OCTAGONAL_DISTANCE, hx))
+	{
+	  shp->canSeq = 1;
+	  shp->con[0] = WLZ_8_CONNECTED;
+	  shp->cnt[0] = (hx + 1) / 2;
+	  shp->con[1] = WLZ_4_CONNECTED;
+	  shp->cnt[1] = hx / 2;
+	}
+	shp->canDist = (obj->type == WLZ_2D_DOMAINOBJ) &&
+	               WlzStructElmDecompRowsMatch(shp, rows,
+		                                   WLZ_EUCLIDEAN_DISTANCE, hx);
+      }
+      else
+      {
+	if(WlzStructElmDecompRowsMatch(shp, rows, WLZ_6_DISTANCE, hx))
+	{
+	  shp->canSeq = 1;
+	  shp->con[0] = WLZ_6_CONNECTED;
+	  shp->cnt[0] = hx;
+	}
+	else if(WlzStructElmDecompRowsMatch(shp, rows, WLZ_18_DISTANCE, hx))
+	{
+	  shp->canSeq = 1;
+	  shp->con[0] = WLZ_18_CONNECTED;
+	  shp->cnt[0] = hx;
+	}
+	shp->canDist = WlzStructElmDecompRowsMatch(shp, rows,
+						   WLZ_EUCLIDEAN_DISTANCE, hx);
+      }
+    }
+    /* Nested planes symmetric about the central plane. */
+    shp->canPlanes = !(shp->canLine) &&
+		     (se->type == WLZ_3D_DOMAINOBJ) &&
+		     (obj->type == WLZ_3D_DOMAINOBJ) &&
+		     (nPln >= 3) && ((nPln % 2) == 1) &&
+		     WlzStructElmDecompPlanesMatch(shp);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Non zero if the planes match.
+* \ingroup	WlzMorphologyOps
+* \brief	Checks whether the planes of the structuring element
+* 		are symmetric about the central plane, have at most
+* 		one interval per row, are not empty and are nested,
+* 		so that each plane is contained within the plane next
+* 		to it towards the central plane. If the planes match
+* 		then the number of rows which differ from those of the
+* 		next plane out from the central plane is set in the
+* 		shape.
+* \param	shp			Shape with the rows of the
+* 					structuring element.
+*/
+static int	WlzStructElmDecompPlanesMatch(WlzStructElmShape *shp)
+{
+  int		k,
+  		y,
+		nLn,
+		pc,
+		nPR,
+		match = 1;
+  WlzStructElmRow *r0,
+  		*r1,
+		*r2;
+
+  nLn = shp->box.yMax - shp->box.yMin + 1;
+  pc = (shp->box.zMax - shp->box.zMin) / 2;
+  shp->nPlnRow = 0;
+  for(k = pc; match && (k >= 0); --k)
+  {
+    nPR = 0;
+    r0 = shp->rows + ((pc + k) * nLn);
+    r1 = shp->rows + ((pc - k) * nLn);
+    r2 = (k < pc)? shp->rows + ((pc + k + 1) * nLn): NULL;
+    for(y = 0; match && (y < nLn); ++y)
+    {
+      match = (r0[y].nItv <= 1) && (r0[y].nItv == r1[y].nItv) &&
+              ((r0[y].nItv == 0) ||
+	       ((r0[y].lft == r1[y].lft) && (r0[y].rgt == r1[y].rgt)));
+      if(match && r0[y].nItv)
+      {
+	if((r2 == NULL) || (r2[y].nItv == 0) ||
+	   (r0[y].lft != r2[y].lft) || (r0[y].rgt != r2[y].rgt))
+	{
+	  ++nPR;
+	}
+      }
+      if(match && r2 && r2[y].nItv)
+      {
+        match = (r0[y].nItv == 1) &&
+	        (r0[y].lft <= r2[y].lft) && (r0[y].rgt >= r2[y].rgt);
+      }
+    }
+    /* The outermost plane must not be empty. */
+    if(match && (k == pc))
+    {
+      for(y = 0; (y < nLn) && (r0[y].nItv == 0); ++y)
+      {
+        ;
+      }
+      match = y < nLn;
+    }
+    shp->nPlnRow += nPR;
+  }
+  return(match);
+}
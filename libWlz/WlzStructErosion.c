@@ -73,10 +73,18 @@ static WlzObject 		*WlzStructErosion3d(
 				  WlzObject *structElm,
 				  WlzErrorNum *dstErr);
 
+static WlzObject 		*WlzStructErosionDirect(
+				  WlzObject *obj,
+				  WlzObject *structElm,
+				  WlzErrorNum *dstErr);
+
 /*!
 * \return	New object or NULL on error.
 * \ingroup 	WlzMorphologyOps
 * \brief	Performs erosion using a structuring element.
+* 		Structuring elements which may be decomposed are
+* 		applied using the decomposition chosen by
+* 		WlzStructElmDecompFind().
 * \param	obj			Given object to be eroded.
 * \param	structElm		Structuring element.
 * \param	dstErr			Destination error pointer, may be NULL.
@@ -85,18 +93,67 @@ WlzObject *WlzStructErosion(
   WlzObject 	*obj,
   WlzObject	*structElm,
   WlzErrorNum	*dstErr)
+{
+  return WlzStructErosionDecomp(obj, structElm, WLZ_STRUCTELM_DECOMP_AUTO,
+  				dstErr);
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup 	WlzMorphologyOps
+* \brief	Performs erosion using a structuring element with the
+* 		given decomposition of the structuring element, see
+* 		WlzStructElmDecompFind(). All decompositions give the
+* 		same domain as the direct method
+* 		(WLZ_STRUCTELM_DECOMP_NONE).
+* \param	obj			Given object to be eroded.
+* \param	structElm		Structuring element.
+* \param	dcp			Decomposition method,
+* 					WLZ_STRUCTELM_DECOMP_AUTO to choose
+* 					the method from the structuring
+* 					element.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject *WlzStructErosionDecomp(
+  WlzObject 	*obj,
+  WlzObject	*structElm,
+  WlzStructElmDecomp dcp,
+  WlzErrorNum	*dstErr)
+{
+  if( dcp == WLZ_STRUCTELM_DECOMP_AUTO ){
+    dcp = WlzStructElmDecompFind(obj, structElm, 1, NULL);
+  }
+  if( dcp == WLZ_STRUCTELM_DECOMP_NONE ){
+    return WlzStructErosionDirect(obj, structElm, dstErr);
+  }
+  return WlzStructElmDecompMorph(obj, structElm, dcp, 1, dstErr);
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup 	WlzMorphologyOps
+* \brief	Performs erosion applying the structuring element
+* 		directly.
+* \param	obj			Given object to be eroded.
+* \param	structElm		Structuring element.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzStructErosionDirect(
+  WlzObject 	*obj,
+  WlzObject	*structElm,
+  WlzErrorNum	*dstErr)
 {
   WlzObject		*rtnObj=NULL;
   WlzDomain		bDom,
   			sDom,
   			domain;
   WlzValues		values;
-  WlzInterval		*jp, *jpw;
+  WlzInterval		*jp, *jpe;
   WlzIntervalLine	*bitv, *sitv;
   WlzInterval 		*aa = NULL;
   WlzInterval 		*bb = NULL;
   WlzInterval 		*cc = NULL;
-  int			i, j, k, m;
+  int			i, j, k, m, nItv;
   int			maxItvLn;
   int			line1, kol1, lastln, lastkl;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
@@ -207,6 +264,8 @@ WlzObject *WlzStructErosion(
        this assumes that every line of the structuring element
        has at least one interval */
     if(sDom.i->lastln - sDom.i->line1 > bDom.i->lastln - bDom.i->line1){
+      (void )WlzFreeDomain(bDom);
+      (void )WlzFreeDomain(sDom);
       return WlzMakeEmpty(dstErr);
     }
 
@@ -215,7 +274,7 @@ WlzObject *WlzStructErosion(
      */
     m = 2 * WlzIntervalCount(obj->domain.i, NULL);
     if((jp = (WlzInterval *)AlcMalloc(sizeof(WlzInterval) * m)) != NULL){
-      jpw = jp;
+      jpe = jp + m;
       /*
        * construct an interval domain approximately and the return object.
        * This assumes that the structuring element domain is "standard" ie
@@ -265,18 +324,34 @@ WlzObject *WlzStructErosion(
 
     k = sDom.i->lastln - sDom.i->line1 + 1;
     j = 0;
+    nItv = 0;
     bitv = &(bDom.i->intvlines[0]);
     sitv = &(sDom.i->intvlines[0]);
     for(i = line1; i <= lastln; i++){
+      /* the intersection of the eroded lines may have more intervals
+         than the object, so add space when a line might not fit */
+      if( jpe - jp < maxItvLn ){
+	if((jp = (WlzInterval *)
+	         AlcMalloc(sizeof(WlzInterval) * (m + maxItvLn))) == NULL){
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	  break;
+	}
+	domain.i->freeptr = AlcFreeStackPush(domain.i->freeptr, (void *)jp,
+					     NULL);
+	jpe = jp + m + maxItvLn;
+      }
       j = intersecitvs(bitv, sitv, k, jp, &aa[0], &bb[0], &cc[0]);
       WlzMakeInterval(i, domain.i, j, jp);
       jp += j;
+      nItv += j;
       bitv++;
     }
+  }
+  if( errNum == WLZ_ERR_NONE ){
     /*
      * final adjust - check for empty object and standardise the domain
      */
-    if(jp == jpw){
+    if(nItv == 0){
       WlzFreeObj(rtnObj);
       rtnObj = WlzMakeEmpty(&errNum);
     }
@@ -288,6 +363,10 @@ WlzObject *WlzStructErosion(
       }
     }
   }
+  else {
+    (void )WlzFreeObj(rtnObj);
+    rtnObj = NULL;
+  }
   if(bDom.core)
   {
     (void )WlzFreeDomain(bDom);
@@ -639,7 +718,7 @@ static WlzObject *WlzStructErosion3d(
 	  obj2 = WlzMakeEmpty(NULL);
 	}
 	obj2 = WlzAssignObject(obj2, NULL);
-	objList[i] = WlzAssignObject(WlzStructErosion(obj1, obj2, NULL),
+	objList[i] = WlzAssignObject(WlzStructErosionDirect(obj1, obj2, NULL),
 				     NULL);
 	WlzFreeObj(obj1);
 	WlzFreeObj(obj2);
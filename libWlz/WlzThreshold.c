@@ -835,15 +835,15 @@ static WlzObject *WlzThreshold2D(WlzObject	*obj,
 	      switch(highlow)
 	      {
 		case WLZ_THRESH_LOW:
-		  WLZ_THRESH_ADD_ITV_RGB_2(nints,nk1,g,itvl,iwsp,thresh_i,dbp,
+		  WLZ_THRESH_ADD_ITV_RGB_2(nints,nk1,g,itvl,iwsp,thresh_i,rgbp,
 		                           <,colno,over);
 		  break;
 		case WLZ_THRESH_HIGH:
-		  WLZ_THRESH_ADD_ITV_RGB_2(nints,nk1,g,itvl,iwsp,thresh_i,dbp,
+		  WLZ_THRESH_ADD_ITV_RGB_2(nints,nk1,g,itvl,iwsp,thresh_i,rgbp,
 		                           >=,colno,over);
 		  break;
 		case WLZ_THRESH_EQUAL:
-		  WLZ_THRESH_ADD_ITV_RGB_2(nints,nk1,g,itvl,iwsp,thresh_i,dbp,
+		  WLZ_THRESH_ADD_ITV_RGB_2(nints,nk1,g,itvl,iwsp,thresh_i,rgbp,
 					   ==,colno,over);
 		  break;
 	      }
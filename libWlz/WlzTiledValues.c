@@ -49,6 +49,47 @@ static char _WlzTiledValues_c[] = "University of Edinburgh $Id$";
 #include <fcntl.h>
 #include <sys/mman.h>
 #endif
+#ifdef HAVE_UNISTD_H
+#define WLZ_USE_PREAD
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+/*!
+* \def		WLZ_TILEDVALUES_PAGE_MIN
+* \ingroup	WlzAllocation
+* \brief	Minimum number of pages held in the cache of a tiled
+* 		values pager, this allows for all the pages of a
+* 		2x2x2 voxel neighbourhood to be pinned at once.
+*/
+#define WLZ_TILEDVALUES_PAGE_MIN	(8)
+
+static unsigned int		WlzTiledValuesPageKeyFn(
+				  AlcLRUCache *cache,
+				  void *entry);
+static int			WlzTiledValuesPageCmpFn(
+				  const void *entry0,
+				  const void *entry1);
+static void			WlzTiledValuesPageUnlinkFn(
+				  AlcLRUCache *cache,
+				  void *entry);
+static void			WlzFreeTiledValuesPager(
+				  WlzTiledValuesPager *pgr);
+static WlzTiledValuesPage	*WlzTiledValuesPageRead(
+				  WlzTiledValuesPager *pgr,
+				  size_t idx,
+				  WlzErrorNum *dstErr);
+
+/*!
+* \brief	Size of the page cache used for tiled values which are
+* 		read, see WlzTiledValuesPageCacheSz().
+*/
+static size_t 			wlzTiledValuesPageCacheSz = 0;
+
+/*!
+* \brief	Non-zero once the page cache size has been set.
+*/
+static int			wlzTiledValuesPageCacheSzSet = 0;
 
 /* The use of Hilbert order for tiles may need some testing before real use. */
 /* #define WLZ_TILES_USE_HILBERT */
@@ -156,6 +197,10 @@ WlzErrorNum			WlzFreeTiledValues(
 	{
 	  AlcFree(tVal->vDim);
 	}
+	if(tVal->pager)
+	{
+	  WlzFreeTiledValuesPager(tVal->pager);
+	}
 	if(tVal->tiles.v)
 	{
 #ifdef WLZ_USE_MMAP
@@ -231,6 +276,7 @@ WlzTiledValues			*WlzNewTiledValues(
       rVal->fd         = gVal->fd;
       rVal->tileOffset = gVal->tileOffset;
       rVal->tiles.v    = gVal->tiles.v;
+      rVal->pager      = gVal->pager;
       rVal->indices    = gVal->indices;
       rVal->bckgrnd    = bgdV;
       rVal->vRank      = gVal->vRank;
@@ -410,6 +456,10 @@ int				WlzTiledValuesMode(
   {
     errNum = WLZ_ERR_VALUES_TYPE;
   }
+  else if(tv->pager)
+  {
+    flags = WLZ_IOFLAGS_READ;
+  }
   else
   {
 #ifdef WLZ_USE_MMAP
@@ -451,6 +501,273 @@ int				WlzTiledValuesMode(
 }
 
 
+/*!
+* \return	Size of the page cache in bytes.
+* \ingroup	WlzAllocation
+* \brief	Gets the size of the page cache which is used for each
+* 		tiled value table as it is read. If the size is zero then
+* 		the tiles are instead memory mapped or read in their
+* 		entirety. Unless it has been set by
+* 		WlzTiledValuesSetPageCacheSz() the size is taken from the
+* 		environment variable WLZ_TILED_PAGE_CACHE_SZ (in bytes) and
+* 		is otherwise zero.
+*/
+size_t				WlzTiledValuesPageCacheSz(void)
+{
+  size_t	sz = 0;
+
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesPageCacheSz)
+#endif
+  {
+    if(wlzTiledValuesPageCacheSzSet == 0)
+    {
+      char	*envStr;
+      unsigned long val;
+
+      if(((envStr = getenv("WLZ_TILED_PAGE_CACHE_SZ")) != NULL) &&
+	 (sscanf(envStr, "%lu", &val) == 1))
+      {
+	wlzTiledValuesPageCacheSz = val;
+      }
+      wlzTiledValuesPageCacheSzSet = 1;
+    }
+    sz = wlzTiledValuesPageCacheSz;
+  }
+  return(sz);
+}
+
+/*!
+* \ingroup	WlzAllocation
+* \brief	Sets the size of the page cache to be used for each
+* 		tiled value table read after this call. Setting a size of
+* 		zero disables paging. See WlzTiledValuesPageCacheSz().
+* \param	sz			Required page cache size in bytes.
+*/
+void				WlzTiledValuesSetPageCacheSz(
+				  size_t sz)
+{
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesPageCacheSz)
+#endif
+  {
+    wlzTiledValuesPageCacheSz = sz;
+    wlzTiledValuesPageCacheSzSet = 1;
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAllocation
+* \brief	Makes a pager for the given tiled value table so that
+* 		it's tiles are read on demand from the given file into a
+* 		bounded cache of pages. The tiled value table must not
+* 		already have tiles, but must have it's tile offset, grey
+* 		type, tile size and values per element set. The pager
+* 		takes ownership of the file descriptor, closing it when
+* 		the tiled value table is freed. The cache will hold at
+* 		least WLZ_TILEDVALUES_PAGE_MIN tiles whatever the given
+* 		size.
+* \param	tVal			Given tiled value table.
+* \param	fd			File descriptor for the file from
+* 					which the tiles are read.
+* \param	cacheSz			Maximum size of the page cache
+* 					in bytes.
+*/
+WlzErrorNum			WlzMakeTiledValuesPager(
+				  WlzTiledValues *tVal,
+				  int fd,
+				  size_t cacheSz)
+{
+  size_t	gSz = 0,
+  		nPage;
+  WlzTiledValuesPager *pgr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if((tVal->tiles.v != NULL) || (tVal->pager != NULL) || (fd < 0) ||
+          (tVal->tileSz < 1) || (tVal->vpe < 1))
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else if((gSz = WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type,
+                                                        NULL))) <= 0)
+  {
+    errNum = WLZ_ERR_GREY_TYPE;
+  }
+#ifndef WLZ_USE_PREAD
+  else
+  {
+    errNum = WLZ_ERR_UNIMPLEMENTED;
+  }
+#endif
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((pgr = (WlzTiledValuesPager *)
+              AlcCalloc(1, sizeof(WlzTiledValuesPager))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      pgr->fd = -1;
+      pgr->valSz = (int )gSz;
+      pgr->tileOffset = tVal->tileOffset;
+      pgr->pageSz = tVal->tileSz * tVal->vpe * gSz;
+      nPage = cacheSz / pgr->pageSz;
+      if(nPage > tVal->numTiles)
+      {
+        nPage = tVal->numTiles;
+      }
+      if(nPage < WLZ_TILEDVALUES_PAGE_MIN)
+      {
+        nPage = WLZ_TILEDVALUES_PAGE_MIN;
+      }
+      if((pgr->cache = AlcLRUCacheNew((unsigned int )nPage,
+                                      nPage * pgr->pageSz,
+				      WlzTiledValuesPageKeyFn,
+				      WlzTiledValuesPageCmpFn,
+				      WlzTiledValuesPageUnlinkFn,
+				      NULL)) == NULL)
+      {
+        AlcFree(pgr);
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    pgr->fd = fd;
+    tVal->pager = pgr;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	The page for the tile, or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Pages in the indexed tile of a paged tiled value table,
+* 		reading it into the table's cache if it is not already
+* 		resident. The returned page is pinned and will not be
+* 		freed until it has been released with
+* 		WlzTiledValuesPageOut(), so the page values may be read
+* 		until then. Pages should be released as soon as they are
+* 		no longer needed, since the cache may not evict pinned
+* 		pages.
+*
+* 		This function is thread safe: Cache lookups are serialised
+* 		but tiles are read concurrently, with a page read by more
+* 		than one thread being discarded by all but one.
+* \param	tVal			Given tiled value table.
+* \param	idx			Index of the tile, ie the value
+* 					from the table's indices.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzTiledValuesPage		*WlzTiledValuesPageIn(
+				  WlzTiledValues *tVal,
+				  size_t idx,
+				  WlzErrorNum *dstErr)
+{
+  WlzTiledValuesPage *page = NULL;
+  WlzTiledValuesPager *pgr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tVal == NULL) || ((pgr = tVal->pager) == NULL))
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(idx >= tVal->numTiles)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    WlzTiledValuesPage key;
+
+    key.idx = idx;
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesPager)
+#endif
+    {
+      if((page = (WlzTiledValuesPage *)
+                 AlcLRUCEntryGetWithKey(pgr->cache, (unsigned int )idx,
+		                        &key)) != NULL)
+      {
+        ++(page->pins);
+      }
+    }
+    if(page == NULL)
+    {
+      WlzTiledValuesPage *newPage;
+
+      /* Read the tile without holding the lock, so that tiles may be
+       * read concurrently. */
+      newPage = WlzTiledValuesPageRead(pgr, idx, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesPager)
+#endif
+	{
+	  if((page = (WlzTiledValuesPage *)
+		     AlcLRUCEntryGetWithKey(pgr->cache, (unsigned int )idx,
+					    &key)) == NULL)
+	  {
+	    page = newPage;
+	    newPage = NULL;
+	    if(AlcLRUCEntryAddWithKey(pgr->cache, pgr->pageSz, page,
+	                              (unsigned int )idx, NULL) == NULL)
+	    {
+	      /* Not cached, so free the page when released. */
+	      page->evicted = 1;
+	    }
+	    ++(pgr->nRead);
+	  }
+	  ++(page->pins);
+	}
+	AlcFree(newPage);
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(page);
+}
+
+/*!
+* \ingroup	WlzAllocation
+* \brief	Releases a page which was pinned by WlzTiledValuesPageIn().
+* 		The page values must not be accessed after the page
+* 		has been released.
+* \param	tVal			Given tiled value table.
+* \param	page			Page to release, may be NULL.
+*/
+void				WlzTiledValuesPageOut(
+				  WlzTiledValues *tVal,
+				  WlzTiledValuesPage *page)
+{
+  if(tVal && tVal->pager && page)
+  {
+    int		fre = 0;
+
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesPager)
+#endif
+    {
+      fre = (--(page->pins) == 0) && page->evicted;
+    }
+    if(fre)
+    {
+      AlcFree(page);
+    }
+  }
+}
+
 /*!
 * \return	New tiled values buffer.
 * \ingroup	WlzAllocation
@@ -552,26 +869,29 @@ void				WlzTiledValueBufferFlush(
     while(kol <= tvb->kl[1])
     {
       int	i,
+		ii,
       		io,
-		itc = 0,
+		itc,
 		rmn;
-      size_t	ii;
 
       ti = kol / tv->tileWidth;
       to = kol % tv->tileWidth;
       io = tvb->lo + to;
+      rmn = tvb->kl[1] - kol + 1;
+      itc = (tv->tileWidth - to) * tv->vpe;
+      if(itc > rmn)
+      {
+	itc = rmn;
+      }
+      /* Values in tiles which are not allocated (negative index) are
+       * background and are not written, but the columns must still be
+       * skipped. */
       ii = *(tv->indices + tvb->li + ti);
-      if(ii > 0)
+      if(ii >= 0)
       {
 	size_t	off;
 
-	rmn = tvb->kl[1] - kol + 1;
-	itc = (tv->tileWidth - to) * tv->vpe;
-	off = ((ii * tv->tileSz) + io) * tv->vpe;
-	if(itc > rmn)
-	{
-	  itc = rmn;
-	}
+	off = (((size_t )ii * tv->tileSz) + io) * tv->vpe;
 	switch(tvb->gtype)
 	{
 	  case WLZ_GREY_INT:
@@ -699,6 +1019,8 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
       		io,
 		itc,
 		rmn;
+      WlzGreyP	tb;
+      WlzTiledValuesPage *page = NULL;
 
       ti[0] = kol / tv->tileWidth;
       to[0] = kol % tv->tileWidth;
@@ -711,6 +1033,22 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
       itc *= tv->vpe;
       io = tvb->lo + to[0];
       ii = *(tv->indices + tvb->li + ti[0]);
+      tb = tv->tiles;
+      if(ii >= 0)
+      {
+        if(tv->pager == NULL)
+	{
+	  io += ii * tv->tileSz;
+	}
+	else if((page = WlzTiledValuesPageIn(tv, ii, NULL)) != NULL)
+	{
+	  tb = page->values;
+	}
+	else
+	{
+	  ii = -1;
+	}
+      }
       switch(tvb->gtype)
       {
 	case WLZ_GREY_INT:
@@ -729,7 +1067,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      int *tp;
 
-	      tp = tv->tiles.inp + (ii * tv->tileSz) + io;
+	      tp = tb.inp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -753,7 +1091,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      short *tp;
 
-	      tp = tv->tiles.shp + (ii * tv->tileSz) + io;
+	      tp = tb.shp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -777,7 +1115,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      WlzUByte *tp;
 
-	      tp = tv->tiles.ubp + (ii * tv->tileSz) + io;
+	      tp = tb.ubp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -801,7 +1139,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      float *tp;
 
-	      tp = tv->tiles.flp + (ii * tv->tileSz) + io;
+	      tp = tb.flp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -825,7 +1163,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      double *tp;
 
-	      tp = tv->tiles.dbp + (ii * tv->tileSz) + io;
+	      tp = tb.dbp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -849,7 +1187,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      WlzUInt *tp;
 
-	      tp = tv->tiles.rgbp + (ii * tv->tileSz) + io;
+	      tp = tb.rgbp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -860,6 +1198,10 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	default:
 	  break;
       }
+      if(page)
+      {
+        WlzTiledValuesPageOut(tv, page);
+      }
       kol += itc;
     }
   }
@@ -1481,3 +1823,180 @@ int				WlzTiledValuesValPerElm(
   }
   return(vpe);
 }
+
+/*!
+* \return	Key for the page.
+* \ingroup	WlzAllocation
+* \brief	Computes the cache key of a tiled values page, which is
+* 		just it's tile index.
+* \param	cache			Unused cache.
+* \param	entry			Page.
+*/
+static unsigned int		WlzTiledValuesPageKeyFn(
+				  AlcLRUCache *cache,
+				  void *entry)
+{
+  return((unsigned int )(((WlzTiledValuesPage *)entry)->idx));
+}
+
+/*!
+* \return	Zero if the pages match, otherwise non-zero.
+* \ingroup	WlzAllocation
+* \brief	Compares the tile indices of two tiled values pages.
+* \param	entry0			First page.
+* \param	entry1			Second page.
+*/
+static int			WlzTiledValuesPageCmpFn(
+				  const void *entry0,
+				  const void *entry1)
+{
+  return(((const WlzTiledValuesPage *)entry0)->idx !=
+         ((const WlzTiledValuesPage *)entry1)->idx);
+}
+
+/*!
+* \ingroup	WlzAllocation
+* \brief	Called when a page is removed from a pager's cache. The
+* 		page is freed unless it is pinned, in which case it is
+* 		freed when released by WlzTiledValuesPageOut().
+* \param	cache			Unused cache.
+* \param	entry			Page.
+*/
+static void			WlzTiledValuesPageUnlinkFn(
+				  AlcLRUCache *cache,
+				  void *entry)
+{
+  WlzTiledValuesPage *page;
+
+  page = (WlzTiledValuesPage *)entry;
+  page->evicted = 1;
+  if(page->pins == 0)
+  {
+    AlcFree(page);
+  }
+}
+
+/*!
+* \ingroup	WlzAllocation
+* \brief	Frees a tiled values pager, it's cache of pages and
+* 		closes it's file descriptor. Pages should not be pinned
+* 		when this function is called.
+* \param	pgr			Given pager.
+*/
+static void			WlzFreeTiledValuesPager(
+				  WlzTiledValuesPager *pgr)
+{
+  if(pgr)
+  {
+    AlcLRUCacheFree(pgr->cache, 1);
+    AlcFree(pgr->encOffset);
+    AlcFree(pgr->encCodec);
+#ifdef WLZ_USE_PREAD
+    if(pgr->fd >= 0)
+    {
+      (void )close(pgr->fd);
+    }
+#endif /* WLZ_USE_PREAD */
+    AlcFree(pgr);
+  }
+}
+
+/*!
+* \return	New unpinned page or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Allocates a new page and reads the indexed tile into it,
+* 		decoding the tile if the tiles are encoded.
+* 		The page header and tile values are allocated together
+* 		with the values aligned for any grey type.
+* \param	pgr			Given pager.
+* \param	idx			Tile index.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzTiledValuesPage	*WlzTiledValuesPageRead(
+				  WlzTiledValuesPager *pgr,
+				  size_t idx,
+				  WlzErrorNum *dstErr)
+{
+  size_t	hdrSz,
+  		rdSz;
+  long		off;
+  WlzUByte	*buf = NULL,
+  		*enc = NULL;
+  WlzTiledValuesPage *page = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  hdrSz = (sizeof(WlzTiledValuesPage) + 15) & ~(size_t )15;
+  if(pgr->encOffset)
+  {
+    off = pgr->encOffset[idx];
+    rdSz = pgr->encOffset[idx + 1] - pgr->encOffset[idx];
+  }
+  else
+  {
+    /* The tiles are stored using native byte ordering. */
+    off = pgr->tileOffset + (long )(idx * pgr->pageSz);
+    rdSz = pgr->pageSz;
+  }
+  if((page = (WlzTiledValuesPage *)
+             AlcMalloc(hdrSz + pgr->pageSz)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    page->idx = idx;
+    page->pins = 0;
+    page->evicted = 0;
+    page->values.ubp = (WlzUByte *)page + hdrSz;
+    buf = page->values.ubp;
+    if(pgr->encOffset)
+    {
+      if((enc = (WlzUByte *)AlcMalloc(rdSz + 1)) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      buf = enc;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef WLZ_USE_PREAD
+    size_t	cnt = 0;
+
+    while((errNum == WLZ_ERR_NONE) && (cnt < rdSz))
+    {
+      ssize_t	n;
+
+      n = pread(pgr->fd, buf + cnt, rdSz - cnt, (off_t )off + (off_t )cnt);
+      if(n > 0)
+      {
+	cnt += n;
+      }
+      else if((n == 0) || (errno != EINTR))
+      {
+	errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+    }
+#else /* WLZ_USE_PREAD */
+    errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif /* WLZ_USE_PREAD */
+  }
+  if((errNum == WLZ_ERR_NONE) && pgr->encOffset)
+  {
+    errNum = WlzEncodedValuesDecode(page->values.ubp, pgr->pageSz,
+                                    enc, rdSz,
+				    (WlzValueEncoding )(pgr->encCodec[idx]),
+				    pgr->valSz);
+  }
+  AlcFree(enc);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    AlcFree(page);
+    page = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(page);
+}
@@ -179,6 +179,27 @@ typedef enum	_WlzGreyTableType
   WLZ_GREY_TAB_TILED		= 7     /*!< Tiled grey value table. */
 } WlzGreyTableType;
 
+/*!
+* \enum		_WlzValueEncoding
+* \ingroup	WlzType
+* \brief	Encodings of grey value tables when written to a file.
+* 		Other than WLZ_VALUE_ENCODING_NONE the values are written
+* 		as independently decodable chunks, each of which is delta
+* 		coded and byte shuffled before being compressed.
+*/
+typedef enum _WlzValueEncoding
+{
+  WLZ_VALUE_ENCODING_NONE	= 0,	/*!< Values are written without any
+  					     encoding (the historical format),
+					     or for a chunk the filtered values
+					     are stored without compression. */
+  WLZ_VALUE_ENCODING_RLE	= 1,	/*!< Run length encoding. */
+  WLZ_VALUE_ENCODING_ZLIB	= 2	/*!< Deflate compression using zlib,
+  					     run length encoding is used in
+					     place of this if Woolz has been
+					     built without zlib. */
+} WlzValueEncoding;
+
 /*!
 * \enum		_WlzObjectType
 * \ingroup	WlzType
@@ -288,6 +309,11 @@ typedef enum _WlzObjectType
 					     domains. */
   WLZ_PLANEDOMAIN_WARP		= WLZ_WARP_TRANS, /*!< 3D warp domain
   					     composed of 2D warp domains. */
+  WLZ_PLANEDOMAIN_INDEXED	= 241,	/*!< Only found in files, a plane
+  					     domain and its values written
+					     as independent per-plane records
+					     followed by a plane index, see
+					     WlzWriteObjSetPlaneIndex(). */
   /**********************************************************************
   * Value table types.
   **********************************************************************/
@@ -428,6 +454,10 @@ typedef enum _WlzObjectType
   					     value table. */
   WLZ_VOXELVALUETABLE_GREY	= 1,	/*!< Grey value voxel value table. */
   WLZ_VOXELVALUETABLE_CONV_HULL,	/*!< Convex hull voxel value table. */
+  WLZ_VALUETABLE_ENCODED	= 240,	/*!< Only found in files, a grey value
+  					     table written as independently
+					     encoded chunks, see
+					     WlzEncodedValuesWrite(). */
   /**********************************************************************
   * Polygon domain types.					
   **********************************************************************/
@@ -502,6 +532,21 @@ typedef enum _WlzObjectType
   					     Keep it the last enumerator! */
 } WlzObjectType;
 
+/*!
+* \def		WLZ_PLANEINDEX_VERSION
+* \ingroup	WlzIO
+* \brief	Version of the indexed plane (WLZ_PLANEDOMAIN_INDEXED)
+* 		file format.
+*/
+#define WLZ_PLANEINDEX_VERSION		(1)
+
+/*!
+* \def		WLZ_PLANEINDEX_ENTRY_SZ
+* \ingroup	WlzIO
+* \brief	Number of bytes in each plane's entry of the plane index
+* 		of the indexed plane file format, four longs.
+*/
+#define WLZ_PLANEINDEX_ENTRY_SZ		(32)
 
 /*! 
 * \enum		_WlzEMAPPropertyType
@@ -743,6 +788,39 @@ typedef enum _WlzDistanceType
   WLZ_APX_EUCLIDEAN_DISTANCE		/*! Approximate Euclidean. */
 } WlzDistanceType;
 
+/*!
+* \enum		_WlzStructElmDecomp
+* \ingroup	WlzType
+* \brief	Methods by which a structuring element may be decomposed
+* 		for morphological dilation and erosion.
+*		Typedef: ::WlzStructElmDecomp.
+*/
+typedef enum _WlzStructElmDecomp
+{
+  WLZ_STRUCTELM_DECOMP_AUTO	= 0,	/*!< Choose the method from the
+  					     shape of the structuring
+					     element. */
+  WLZ_STRUCTELM_DECOMP_NONE,		/*!< No decomposition, the
+  					     structuring element is
+					     applied directly. */
+  WLZ_STRUCTELM_DECOMP_LINE,		/*!< Rectangle or cuboid applied
+  					     as a sequence of line segments
+					     along each axis. */
+  WLZ_STRUCTELM_DECOMP_SEQ,		/*!< Diamond, octagon or octahedron
+  					     applied as a sequence of unit
+					     dilations or erosions. */
+  WLZ_STRUCTELM_DECOMP_DIST,		/*!< Digital disc or ball applied
+  					     by thresholding a Euclidean
+					     distance transform. */
+  WLZ_STRUCTELM_DECOMP_PLANES		/*!< Nested planes which are
+  					     symmetric about a central plane,
+					     such as the spheres made by
+					     WlzMakeSphereObject(), applied
+					     by combining the object's
+					     dilations or erosions by each
+					     plane shifted in z. */
+} WlzStructElmDecomp;
+
 /*!
 * \enum 	_WlzRCCClassIdx
 * \ingroup	WlzType
@@ -2467,6 +2545,26 @@ typedef struct _WlzContour
   					     defining the contour. */
 } WlzContour;
 
+#ifndef WLZ_EXT_BIND
+/*!
+* \struct	_WlzIndexedSurface
+* \ingroup	WlzContour
+* \brief	A triangulated surface represented by flat arrays of
+*		vertex positions, optional vertex normals and vertex
+*		indices, without the topology of a geometric model.
+*		Typedef: ::WlzIndexedSurface.
+*/
+typedef struct _WlzIndexedSurface
+{
+  int		nVtx;			/*!< Number of vertices. */
+  int		nFce;			/*!< Number of faces (triangles). */
+  WlzDVertex3	*vtx;			/*!< Vertex positions. */
+  WlzDVertex3	*nrm;			/*!< Vertex normals, may be NULL. */
+  int		*idx;			/*!< Vertex indices, three for each
+  					     face. */
+} WlzIndexedSurface;
+#endif /* WLZ_EXT_BIND */
+
 
 #ifndef WLZ_EXT_BIND
 /*!
@@ -3175,6 +3273,59 @@ typedef struct _WlzIndexedValues
   AlcVector     *values;                /*!< The indexed values. */
 } WlzIndexedValues;
 
+/*!
+* \struct	_WlzTiledValuesPage
+* \ingroup	WlzType
+* \brief	A single tile of a paged tiled value table which has been
+* 		read into memory. The tile values follow the page in the
+* 		same allocation.
+* 		Typedef: ::WlzTiledValuesPage.
+*/
+typedef struct _WlzTiledValuesPage
+{
+  size_t	idx;			/*!< Index of the tile. */
+  int		pins;			/*!< Number of users of the page,
+  					     the page may not be freed
+					     while this is non-zero. */
+  int		evicted;		/*!< Non-zero once the page has been
+  					     removed from the cache, it is
+					     then freed when unpinned. */
+  WlzGreyP	values;			/*!< The values of the tile. */
+} WlzTiledValuesPage;
+
+/*!
+* \struct	_WlzTiledValuesPager
+* \ingroup	WlzType
+* \brief	Reads the tiles of a tiled value table on demand into a
+* 		bounded least recently used cache of pages, rather than
+* 		either reading all the tiles or memory mapping them.
+* 		If the tiles were written as an encoded value table then
+* 		each tile is decoded as it is read.
+* 		Typedef: ::WlzTiledValuesPager.
+*/
+typedef struct _WlzTiledValuesPager
+{
+  int		fd;			/*!< File descriptor used to read the
+  					     tiles, owned by the pager. */
+  int		valSz;			/*!< Size of a single grey value in
+  					     bytes. */
+  long		tileOffset;		/*!< Offset from the start of the
+  					     file to the tiles. */
+  size_t	pageSz;			/*!< Number of bytes in each tile. */
+  size_t	nRead;			/*!< Number of tiles read. */
+  long		*encOffset;		/*!< If non-NULL the tiles are encoded
+  					     and these are the offsets from
+					     the start of the file to each
+					     of the encoded tiles, with a
+					     final offset to the end of the
+					     last tile. Owned by the pager. */
+  WlzUByte	*encCodec;		/*!< If the tiles are encoded, the
+  					     codec (a ::WlzValueEncoding) of
+					     each encoded tile. Owned by the
+					     pager. */
+  AlcLRUCache	*cache;			/*!< Cache of resident pages. */
+} WlzTiledValuesPager;
+
 /*!
 * \struct       _WlzTiledValues
 * \ingroup      WlzType
@@ -3231,6 +3382,12 @@ typedef struct _WlzIndexedValues
 * 		the file was opened in write or append mode. The function
 * 		WlzTiledValuesMode() may also be used to determine the
 * 		appropriate access mode(s) for the values table.
+*
+* 		Alternatively the tiles may be paged, in which case the
+* 		pager is non-NULL, the tiles pointer is NULL and tiles
+* 		are read on demand into a bounded cache of pages using
+* 		WlzTiledValuesPageIn() and released using
+* 		WlzTiledValuesPageOut(). Paged tiled values are read only.
 */
 typedef struct _WlzTiledValues
 {
@@ -3290,6 +3447,9 @@ typedef struct _WlzTiledValues
   					     file to the tiles. This may be
 					     set even if not memory mapped. */
   WlzGreyP 	tiles;			/*!< The tiles. */
+  struct _WlzTiledValuesPager *pager;   /*!< If non-NULL the tiles are read
+  					     on demand into a bounded cache
+					     and tiles is NULL. */
 } WlzTiledValues;
 
 /*!
@@ -3571,6 +3731,33 @@ typedef struct _WlzHistogramDomain
 					     WLZ_HISTOGRAMDOMAIN_FLOAT. */
 } WlzHistogramDomain;
 
+#ifndef WLZ_EXT_BIND
+/*!
+* \struct	_WlzGreyScanStats
+* \ingroup	WlzFeatures
+* \brief	Simple statistics of an object's grey values as computed
+* 		by WlzGreyScanPar(). RGBA values are represented by their
+* 		modulus.
+*		Typedef: ::WlzGreyScanStats.
+*/
+typedef struct _WlzGreyScanStats
+{
+  WlzGreyType	gType;			/*!< Grey type of the values. */
+  long		area;			/*!< Number of values, ie the area
+  					     or volume of the object. */
+  double	min;			/*!< Minimum value. */
+  double	max;			/*!< Maximum value. */
+  double	sum;			/*!< Sum of the values. */
+  double	sumSq;			/*!< Sum of the squares of the
+  					     values. */
+  double	mean;			/*!< Mean value, -1.0 if the area
+  					     is zero. */
+  double	var;			/*!< Unbiased variance of the values,
+  					     zero if the area is less than
+					     two. */
+} WlzGreyScanStats;
+#endif /* WLZ_EXT_BIND */
+
 /*!
 * \enum		_WlzHistFeature
 * \ingroup      WlzHistogram
@@ -4457,6 +4644,61 @@ typedef struct _WlzCMesh3D
 
 } WlzCMesh3D;
 
+#ifndef WLZ_EXT_BIND
+/*!
+* \struct	_WlzCMeshCompact3D
+* \ingroup	WlzMesh
+* \brief	A frozen, read only, compact form of a 3D conforming
+* 		mesh in which the nodes and elements are held in
+* 		contiguous arrays and are indexed from zero without gaps.
+* 		The nodes of an element are in the order given by
+* 		WLZ_CMESH_ELM3D_GET_NODE_0() to WLZ_CMESH_ELM3D_GET_NODE_3()
+* 		and the element neighbours are indexed by the node
+* 		opposite to the shared face. The elements which use
+* 		each node are held in compressed row form: the elements
+* 		using node \f$n\f$ are nodElm[nodElmOff[n]] to
+* 		nodElm[nodElmOff[n + 1] - 1]. A grid of cells, also in
+* 		compressed row form, is used to locate elements.
+*		Typedef: ::WlzCMeshCompact3D.
+*/
+typedef struct _WlzCMeshCompact3D
+{
+  int		nNod;			/*!< Number of nodes. */
+  int		nElm;			/*!< Number of elements. */
+  double	maxSqEdgLen;		/*!< Maximum of squared edge lengths
+  					     as in the mesh. */
+  WlzDBox3	bBox;			/*!< Axis aligned bounding box of
+  					     the mesh. */
+  WlzDVertex3	*nodPos;		/*!< Node positions. */
+  unsigned int	*nodFlags;		/*!< Node flags. */
+  int		*nodIdx;		/*!< Index of each node in the mesh
+  					     from which it was made. */
+  int		*elmNod;		/*!< Four node indices per element. */
+  int		*elmNbr;		/*!< Four neighbouring element indices
+  					     per element, with the neighbour
+					     across the face opposite node
+					     \f$i\f$ being at \f$i\f$ and
+					     -1 for boundary faces. */
+  int		*elmIdx;		/*!< Index of each element in the
+  					     mesh from which it was made. */
+  int		*nodElmOff;		/*!< Offsets into nodElm for each
+  					     node, with nNod + 1 entries. */
+  int		*nodElm;		/*!< Elements which use each node. */
+  double	cellSz;			/*!< Side length of the cubic cells
+  					     of the element location grid,
+					     which has its origin at the
+					     minimum of the bounding box. */
+  WlzIVertex3	cellNum;		/*!< Number of grid cells along each
+  					     axis. */
+  int		*cellElmOff;		/*!< Offsets into cellElm for each
+  					     grid cell (in raster order),
+					     with one more entry than the
+					     number of cells. */
+  int		*cellElm;		/*!< Elements with bounding boxes
+  					     which intersect each cell. */
+} WlzCMeshCompact3D;
+#endif /* WLZ_EXT_BIND */
+
 /*!
 * \union	_WlzCMeshP
 * \ingroup   	WlzMesh
@@ -4506,6 +4748,8 @@ typedef enum _WlzFnType
   WLZ_FN_SCALAR_SQRT,		        /*!< Square root (x^-1/2). */
   WLZ_FN_SCALAR_INVSQRT,		/*!< Inverse square root (x^-1/2). */
   WLZ_FN_SCALAR_SQR,			/*!< Square (x * x). */
+  WLZ_FN_BASIS_3DCS,			/*!< 3D compactly supported (Wendland)
+  					     radial basis function. */
   WLZ_FN_COUNT				/*!< Not a function but the number
   					     of functions. Keep this the
 					     last of the enums! */
@@ -5153,6 +5397,9 @@ typedef struct _WlzGreyValueWSpace
 					     which values are background.
 					     Value is 0 if there are no
 					     background values. */
+  WlzTiledValuesPage *tPage[8];		/*!< Pages of paged tiled values
+  					     which are pinned while the grey
+					     pointers may refer to them. */
 } WlzGreyValueWSpace;
 
 /************************************************************************
@@ -5497,6 +5744,30 @@ typedef struct _WlzThreeDViewStruct
 					  voxel size rescaling */
 } WlzThreeDViewStruct;
 
+/*!
+* \struct	_WlzSectionServer
+* \ingroup	WlzSectionTransform
+* \brief	Persistent data for cutting many sections from a single
+*		3D domain object with values. The data which do not
+*		depend on the view are built once and sections may be cut
+*		concurrently by several threads. The object must not be
+*		modified while the server exists.
+*		Typedef: ::WlzSectionServer.
+*/
+typedef struct _WlzSectionServer
+{
+  WlzObject	*obj;			/*!< The 3D object (assigned). */
+  void		*fast;			/*!< Private data for direct access
+  					     to the object's values, NULL
+					     if they can not be accessed
+					     directly. */
+  int		nWSp;			/*!< Number of grey value workspaces
+  					     in the pool. */
+  int		maxWSp;			/*!< Space allocated for the pool. */
+  WlzGreyValueWSpace **wSp;		/*!< Pool of grey value workspaces
+  					     which are not in use. */
+} WlzSectionServer;
+
 /*!
 * \typedef	WlzProjectIntMode
 * \ingroup	WlzTransform
@@ -2221,6 +2221,7 @@ void		WlzValueCopyGreyToGrey(WlzGreyP dst, size_t dstOff,
 	case WLZ_GREY_DOUBLE:
 	  WlzValueCopyDoubleToFloat(dst.flp + dstOff, src.dbp + srcOff,
 	  			    count);
+	  break;
 	case WLZ_GREY_RGBA:
 	  WlzValueCopyRGBAToFloat(dst.flp + dstOff, src.rgbp + srcOff,
 	  			  count);
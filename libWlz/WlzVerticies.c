@@ -2356,13 +2356,15 @@ static WlzDVertex2 WlzVerticesNormTriple2(WlzDVertex2 vA, WlzDVertex2 vB,
 * \ingroup      WlzFeatures
 * \return				Woolz error code
 * \brief	Allocates and populates a k-D tree from the given vertices.
-* 		The vertices are either WlzDVertex2 orWlzDVertex3
+* 		The vertices are either WlzDVertex2 orWlzDVertex3.
+*		The tree is built balanced by AlcKDTTreeBuild() with
+*		the index of each node being the index of it's vertex.
 * \param	vType 			Type of vertices.
 * \param	nV 			Number of vertices.
 * \param	vtx 			The vertices.
-* \param	shfBuf			Workspace with at least nV ints
-*					used to shuffle vertices for
-*					randomized input to the K-D tree.
+* \param	shfBuf			Workspace with at least nV ints,
+*					no longer used now that the tree
+*					is built balanced and may be NULL.
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
@@ -2371,12 +2373,9 @@ AlcKDTTree	*WlzVerticesBuildTree(WlzVertexType vType, int nV,
 				      WlzErrorNum *dstErr)
 {
   int		idx,
-		sIdx,
-  		treeDim;
-  double	datD[3];
+  		treeDim = 0;
+  double	*datD = NULL;
   AlcKDTTree	*tree = NULL;
-  AlcKDTNode	*node = NULL;
-  WlzVertexP	tVP;
   AlcErrno	alcErr = ALC_ER_NONE;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -2392,68 +2391,53 @@ AlcKDTTree	*WlzVerticesBuildTree(WlzVertexType vType, int nV,
       errNum = WLZ_ERR_PARAM_TYPE;
       break;
   }
-  /* Create tree. */
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && (nV <= 0))
   {
-    if((tree = AlcKDTTreeNew(ALC_POINTTYPE_DBL, treeDim, -1.0, nV,
-				   NULL)) == NULL)
+    /* No vertices so just create an empty tree. */
+    if((tree = AlcKDTTreeNew(ALC_POINTTYPE_DBL, treeDim, -1.0, 0,
+                             NULL)) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  else if(errNum == WLZ_ERR_NONE)
   {
-    (void )AlgShuffleIdx(nV, shfBuf, 0);
+    if((datD = (double *)AlcMalloc(sizeof(double) * nV * treeDim)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
   }
-  /* Populate tree using a shuffle index to get the behaviour of a randomized
-   * k-D tree, making sure that the indicies of nodes of the tree are not
-   * shuffled too. */
-  if(errNum == WLZ_ERR_NONE)
+  /* Gather the vertex keys and build the tree. */
+  if((errNum == WLZ_ERR_NONE) && (tree == NULL))
   {
-    idx = 0;
-    switch(vType)
+    if(vType == WLZ_VERTEX_D2)
     {
-      case WLZ_VERTEX_D2:
-	while((alcErr == ALC_ER_NONE) && (idx < nV))
-	{
-	  sIdx = *(shfBuf + idx);
-	  tVP.d2 = (vtx.d2 + sIdx);
-	  datD[0] = tVP.d2->vtX;
-	  datD[1] = tVP.d2->vtY;
-	  if((node = AlcKDTInsert(tree, datD, NULL, &alcErr)) != NULL)
-	  {
-	    node->idx = sIdx;
-	  }
-	  ++idx;
-	}
-	break;
-      case WLZ_VERTEX_D3:
-	while((alcErr == ALC_ER_NONE) && (idx < nV))
-	{
-	  sIdx = *(shfBuf + idx);
-	  tVP.d3 = (vtx.d3 + sIdx);
-	  datD[0] = tVP.d3->vtX;
-	  datD[1] = tVP.d3->vtY;
-	  datD[2] = tVP.d3->vtZ;
-	  if((node = AlcKDTInsert(tree, datD, NULL, &alcErr)) != NULL)
-	  {
-	    node->idx = sIdx;
-	  }
-	  ++idx;
-	}
-	break;
-      default:
-	errNum = WLZ_ERR_PARAM_TYPE;
-        break;
+      for(idx = 0; idx < nV; ++idx)
+      {
+	datD[2 * idx] = vtx.d2[idx].vtX;
+	datD[2 * idx + 1] = vtx.d2[idx].vtY;
+      }
     }
-    if(dstErr)
+    else /* vType == WLZ_VERTEX_D3 */
     {
-      if(alcErr != ALC_ER_NONE)
+      for(idx = 0; idx < nV; ++idx)
       {
-	errNum = WLZ_ERR_MEM_ALLOC;
+	datD[3 * idx] = vtx.d3[idx].vtX;
+	datD[3 * idx + 1] = vtx.d3[idx].vtY;
+	datD[3 * idx + 2] = vtx.d3[idx].vtZ;
       }
-      *dstErr = errNum;
     }
+    tree = AlcKDTTreeBuild(ALC_POINTTYPE_DBL, treeDim, -1.0, nV, datD,
+    			   &alcErr);
+    if(alcErr != ALC_ER_NONE)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  AlcFree(datD);
+  if(dstErr)
+  {
+    *dstErr = errNum;
   }
   return(tree);
 }
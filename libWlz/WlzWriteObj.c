@@ -43,6 +43,9 @@ static char _WlzWriteObj_c[] = "University of Edinburgh $Id$";
 #include <stdlib.h>
 #include <limits.h>
 #include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <Wlz.h>
 
 /* #define WLZ_DEBUG_WRITEOBJ */
@@ -64,6 +67,21 @@ static WlzErrorNum		WlzWritePropertyList(
 static WlzErrorNum		WlzWriteProperty(
 				  FILE *fP,
 				  WlzProperty property);
+static WlzErrorNum		WlzWriteDomObjValues(
+				  FILE *fP,
+				  WlzObject *obj);
+static WlzErrorNum		WlzWriteIndexedPlanes(
+				  FILE *fP,
+				  WlzObject *obj);
+static WlzErrorNum		WlzWriteIndexedPlane(
+				  char **dstBuf,
+				  size_t *dstBufSz,
+				  size_t *dstDomSz,
+				  WlzObject *obj,
+				  int pIdx);
+static int			WlzWriteIndexedPlanesOK(
+				  FILE *fP,
+				  WlzObject *obj);
 static WlzErrorNum		WlzWriteValueTable(
 				  FILE	*fP,
 				  WlzObject *obj);
@@ -337,6 +355,90 @@ static int putdouble(double d, FILE *fP)
   return((int )fwrite(out.ubytes, sizeof(char), 8, fP));
 }
 
+/*!
+* \return	Number of bytes written.
+* \ingroup	WlzIO
+* \brief	Writes a long integer as two words, the least significant
+* 		first, each reordered to DEC VAX(!) format.
+* \param	l			Value written.
+* \param	fP			Given file.
+*/
+static int putlong(WlzLong l, FILE *fP)
+{
+  int		n;
+
+  n = putword((int )(l & 0xffffffff), fP);
+  n += putword((int )((l >> 32) & 0xffffffff), fP);
+  return(n);
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Non-zero if 3D domain objects are to be written with a
+* 		plane index, see WlzWriteObjPlaneIndex().
+*/
+static int			wlzWriteObjPlaneIndex = 0;
+
+/*!
+* \ingroup	WlzIO
+* \brief	Non-zero once wlzWriteObjPlaneIndex has been set either
+* 		from the environment or by WlzWriteObjSetPlaneIndex().
+*/
+static int			wlzWriteObjPlaneIndexSet = 0;
+
+/*!
+* \return	Non-zero if planes are written with an index.
+* \ingroup	WlzIO
+* \brief	Gets whether WlzWriteObj() writes the planes of 3D domain
+* 		objects as independent records followed by a plane index
+* 		(see WlzWriteIndexedPlanes()), so that they may be encoded
+* 		and decoded in parallel. Unless it has been set by
+* 		WlzWriteObjSetPlaneIndex() this is taken from the
+* 		environment variable WLZ_PLANE_INDEX, which is
+* 		interpreted as an integer, and is otherwise zero.
+*/
+int				WlzWriteObjPlaneIndex(void)
+{
+  int		idx = 0;
+
+#ifdef _OPENMP
+#pragma omp critical (WlzWriteObjPlaneIndex)
+#endif
+  {
+    if(wlzWriteObjPlaneIndexSet == 0)
+    {
+      char	*envStr;
+
+      if((envStr = getenv("WLZ_PLANE_INDEX")) != NULL)
+      {
+        wlzWriteObjPlaneIndex = atoi(envStr) != 0;
+      }
+      wlzWriteObjPlaneIndexSet = 1;
+    }
+    idx = wlzWriteObjPlaneIndex;
+  }
+  return(idx);
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Sets whether WlzWriteObj() writes the planes of 3D domain
+* 		objects with a plane index after this call. See
+* 		WlzWriteObjPlaneIndex().
+* \param	idx			Non-zero for a plane index.
+*/
+void				WlzWriteObjSetPlaneIndex(
+				  int idx)
+{
+#ifdef _OPENMP
+#pragma omp critical (WlzWriteObjPlaneIndex)
+#endif
+  {
+    wlzWriteObjPlaneIndex = idx != 0;
+    wlzWriteObjPlaneIndexSet = 1;
+  }
+}
+
 /*!
 * \return       Woolz error number code.
 * \ingroup      WlzIO
@@ -383,15 +485,7 @@ WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
 	errNum = WlzWriteIntervalDomain(fP, obj->domain.i);
 	if(errNum == WLZ_ERR_NONE)
         {
-	  if((obj->values.core == NULL) ||
-	     (WlzGreyTableIsTiled(obj->values.core->type) == 0))
-	  {
-	    errNum = WlzWriteValueTable(fP, obj);
-	  }
-	  else
-	  {
-	    errNum = WlzWriteTiledValueTable(fP, obj, 1);
-	  }
+	  errNum = WlzWriteDomObjValues(fP, obj);
 	}
 	if(errNum == WLZ_ERR_NONE)
         {
@@ -399,17 +493,16 @@ WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
 	}
 	break;
       case WLZ_3D_DOMAINOBJ:
-	errNum = WlzWritePlaneDomain(fP, obj->domain.p);
-	if(errNum == WLZ_ERR_NONE)
-        {
-	  if((obj->values.core == NULL) ||
-	     (WlzGreyTableIsTiled(obj->values.core->type) == 0))
-	  {
-	    errNum = WlzWriteVoxelValueTable(fP, obj);
-	  }
-	  else
+	if(WlzWriteObjPlaneIndex() && WlzWriteIndexedPlanesOK(fP, obj))
+	{
+	  errNum = WlzWriteIndexedPlanes(fP, obj);
+	}
+	else
+	{
+	  errNum = WlzWritePlaneDomain(fP, obj->domain.p);
+	  if(errNum == WLZ_ERR_NONE)
 	  {
-	    errNum = WlzWriteTiledValueTable(fP, obj, 1);
+	    errNum = WlzWriteDomObjValues(fP, obj);
 	  }
 	}
 	if(errNum == WLZ_ERR_NONE)
@@ -1672,6 +1765,54 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes the values of a 2D or 3D domain object to the given
+* 		file. The values (whether tiled or not) are written as an
+* 		encoded value table if an encoding has been set (see
+* 		WlzEncodedValuesType()) and the values can be encoded,
+* 		otherwise they are written unencoded.
+* \param	fP			Given file.
+* \param	obj			Given 2D or 3D domain object.
+*/
+static WlzErrorNum WlzWriteDomObjValues(FILE *fP, WlzObject *obj)
+{
+  WlzValueEncoding enc = WLZ_VALUE_ENCODING_NONE;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(obj->values.core != NULL)
+  {
+    enc = WlzEncodedValuesType();
+  }
+  if(enc != WLZ_VALUE_ENCODING_NONE)
+  {
+    /* WLZ_ERR_VALUES_TYPE is only returned before anything has been
+     * written, in which case the values are written unencoded. */
+    errNum = WlzEncodedValuesWrite(fP, obj, enc);
+    if(errNum == WLZ_ERR_VALUES_TYPE)
+    {
+      enc = WLZ_VALUE_ENCODING_NONE;
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if(enc == WLZ_VALUE_ENCODING_NONE)
+  {
+    if((obj->values.core != NULL) &&
+       (WlzGreyTableIsTiled(obj->values.core->type) != 0))
+    {
+      errNum = WlzWriteTiledValueTable(fP, obj, 1);
+    }
+    else
+    {
+      errNum = (obj->type == WLZ_2D_DOMAINOBJ)?
+	       WlzWriteValueTable(fP, obj):
+	       WlzWriteVoxelValueTable(fP, obj);
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
@@ -1718,12 +1859,7 @@ static WlzErrorNum WlzWriteVoxelValueTable(FILE *fP, WlzObject *obj)
 	  values = voxtab->values;
 	  domains = planedm->domains;
 	  tempobj.type = WLZ_2D_DOMAINOBJ;
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
-#endif
-	  {
-	    tempobj.linkcount = 0;
-	  }
+	  tempobj.linkcount = 0;
 	  tempobj.plist = NULL;
 	  tempobj.assoc = NULL;
 	  for(i=0; (i < nplanes) && (errNum == WLZ_ERR_NONE);
@@ -1743,6 +1879,273 @@ static WlzErrorNum WlzWriteVoxelValueTable(FILE *fP, WlzObject *obj)
   return(errNum);
 }
 
+/*!
+* \return	Non-zero if the object can be written with a plane index.
+* \ingroup	WlzIO
+* \brief	Checks whether the given 3D domain object can be written
+* 		to the given file with a plane index. This requires a
+* 		seekable file, a plane domain of spatial domains and
+* 		either no values or a grey voxel value table covering the
+* 		same planes as the domain.
+* \param	fP			Given file.
+* \param	obj			Given 3D domain object.
+*/
+static int	WlzWriteIndexedPlanesOK(FILE *fP, WlzObject *obj)
+{
+  int		ok = 0;
+
+#ifdef HAVE_OPEN_MEMSTREAM
+  WlzPlaneDomain *pDom;
+  WlzVoxelValues *vox;
+
+  pDom = obj->domain.p;
+  vox = obj->values.vox;
+  ok = (pDom != NULL) && (pDom->type == WLZ_PLANEDOMAIN_DOMAIN) &&
+       ((vox == NULL) ||
+	((vox->type == WLZ_VOXELVALUETABLE_GREY) &&
+	 (vox->plane1 == pDom->plane1) && (vox->lastpl == pDom->lastpl))) &&
+       (ftell(fP) >= 0);
+#endif /* HAVE_OPEN_MEMSTREAM */
+  return(ok);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes the plane domain and values of a 3D domain object
+* 		as independent per-plane records followed by a plane
+* 		index. This is written in place of the plane domain and
+* 		voxel value table, with the form:
+* \verbatim
+  type			byte, WLZ_PLANEDOMAIN_INDEXED
+  version		byte, currently 1
+  plane domain type	byte, WLZ_PLANEDOMAIN_DOMAIN
+  plane1, lastpl, line1, lastln, kol1, lastkl	words
+  voxel size		three floats
+  values type		byte, either 0 or WLZ_VOXELVALUETABLE_GREY
+  background		word, only present if there are values
+  records size		long
+  plane records		{interval domain, value table} for each plane
+  plane index		{domain offset, domain size,
+  			 values offset, values size} longs for each plane
+  \endverbatim
+* 		The interval domains and value tables of the records are
+* 		written just as they are for 2D domain objects and the
+* 		offsets of the index are from the start of the first
+* 		plane record. Longs are written as two words with the
+* 		least significant first. The planes are encoded in
+* 		parallel, in batches, into memory and then written in
+* 		order. The records size is only known after the last
+* 		plane has been written, so the file must be seekable.
+* \param	fP			Given file.
+* \param	obj			Given 3D domain object which has
+* 					been checked by
+* 					WlzWriteIndexedPlanesOK().
+*/
+static WlzErrorNum WlzWriteIndexedPlanes(FILE *fP, WlzObject *obj)
+{
+  int		idp,
+  		nPln,
+		nBat = 1;
+  long		recMrk = 0,
+  		endMrk;
+  WlzLong	recSz = 0;
+  WlzLong	*idx = NULL;
+  char		**buf = NULL;
+  size_t	*bufSz = NULL,
+  		*domSz = NULL;
+  WlzPlaneDomain *pDom;
+  WlzVoxelValues *vox;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pDom = obj->domain.p;
+  vox = obj->values.vox;
+  nPln = pDom->lastpl - pDom->plane1 + 1;
+#ifdef _OPENMP
+  nBat = 4 * omp_get_max_threads();
+#endif
+  if(nBat > nPln)
+  {
+    nBat = nPln;
+  }
+  if(((idx = (WlzLong *)AlcCalloc(4 * nPln, sizeof(WlzLong))) == NULL) ||
+     ((buf = (char **)AlcCalloc(nBat, sizeof(char *))) == NULL) ||
+     ((bufSz = (size_t *)AlcCalloc(2 * nBat, sizeof(size_t))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    domSz = bufSz + nBat;
+    if((putc((unsigned int )WLZ_PLANEDOMAIN_INDEXED, fP) == EOF) ||
+       (putc((unsigned int )WLZ_PLANEINDEX_VERSION, fP) == EOF) ||
+       (putc((unsigned int )(pDom->type), fP) == EOF) ||
+       !putword(pDom->plane1, fP) ||
+       !putword(pDom->lastpl, fP) ||
+       !putword(pDom->line1, fP) ||
+       !putword(pDom->lastln, fP) ||
+       !putword(pDom->kol1, fP) ||
+       !putword(pDom->lastkl, fP) ||
+       !putfloat((pDom->voxel_size)[0], fP) ||
+       !putfloat((pDom->voxel_size)[1], fP) ||
+       !putfloat((pDom->voxel_size)[2], fP) ||
+       (putc((vox == NULL)? 0: (unsigned int )(vox->type), fP) == EOF) ||
+       ((vox != NULL) && !putword(vox->bckgrnd.v.inv, fP)) ||
+       ((recMrk = ftell(fP)) < 0) ||
+       !putlong(0, fP))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  for(idp = 0; (errNum == WLZ_ERR_NONE) && (idp < nPln); idp += nBat)
+  {
+    int		idb,
+    		nB;
+
+    nB = WLZ_MIN(nBat, nPln - idp);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idb = 0; idb < nB; ++idb)
+    {
+      WlzErrorNum errNum2;
+
+      errNum2 = WlzWriteIndexedPlane(buf + idb, bufSz + idb, domSz + idb,
+                                     obj, idp + idb);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzWriteIndexedPlanes)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+    for(idb = 0; idb < nB; ++idb)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	WlzLong	*ix;
+
+	ix = idx + (4 * (idp + idb));
+	ix[0] = recSz;
+	ix[1] = domSz[idb];
+	ix[2] = recSz + domSz[idb];
+	ix[3] = bufSz[idb] - domSz[idb];
+	recSz += bufSz[idb];
+	if(fwrite(buf[idb], sizeof(char), bufSz[idb], fP) != bufSz[idb])
+	{
+	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	}
+      }
+      /* Memory stream buffers are allocated by the C library. */
+      free(buf[idb]);
+      buf[idb] = NULL;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idp = 0; idp < 4 * nPln; ++idp)
+    {
+      if(!putlong(idx[idp], fP))
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	break;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((endMrk = ftell(fP)) < 0) ||
+       (fseek(fP, recMrk, SEEK_SET) != 0) ||
+       !putlong(recSz, fP) ||
+       (fseek(fP, endMrk, SEEK_SET) != 0))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  AlcFree(idx);
+  AlcFree(buf);
+  AlcFree(bufSz);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes the interval domain and value table of a single
+* 		plane of a 3D domain object to a new memory buffer.
+* \param	dstBuf			Destination pointer for the buffer,
+* 					which is allocated by the C library
+* 					and must be freed using free().
+* \param	dstBufSz		Destination pointer for the number
+* 					of bytes in the buffer.
+* \param	dstDomSz		Destination pointer for the number
+* 					of bytes of the interval domain.
+* \param	obj			Given 3D domain object.
+* \param	pIdx			Plane index, relative to the first
+* 					plane of the object.
+*/
+static WlzErrorNum WlzWriteIndexedPlane(char **dstBuf, size_t *dstBufSz,
+				        size_t *dstDomSz, WlzObject *obj,
+					int pIdx)
+{
+  char		*buf = NULL;
+  size_t	bufSz = 0;
+  long		domSz = 0;
+  WlzErrorNum	errNum = WLZ_ERR_UNIMPLEMENTED;
+
+#ifdef HAVE_OPEN_MEMSTREAM
+  FILE		*mP;
+
+  if((mP = open_memstream(&buf, &bufSz)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    WlzDomain	dom;
+
+    dom = obj->domain.p->domains[pIdx];
+    errNum = WlzWriteIntervalDomain(mP, dom.i);
+    if((errNum == WLZ_ERR_NONE) && ((domSz = ftell(mP)) < 0))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    if((errNum == WLZ_ERR_NONE) && (obj->values.core != NULL))
+    {
+      WlzObject	tObj;
+
+      tObj.type = WLZ_2D_DOMAINOBJ;
+      tObj.linkcount = 0;
+      tObj.domain = dom;
+      tObj.values = obj->values.vox->values[pIdx];
+      tObj.plist = NULL;
+      tObj.assoc = NULL;
+      errNum = WlzWriteDomObjValues(mP, &tObj);
+    }
+    if((fclose(mP) != 0) && (errNum == WLZ_ERR_NONE))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+#endif /* HAVE_OPEN_MEMSTREAM */
+  if(errNum != WLZ_ERR_NONE)
+  {
+    free(buf);
+    buf = NULL;
+    bufSz = 0;
+  }
+  *dstBuf = buf;
+  *dstBufSz = bufSz;
+  *dstDomSz = (size_t )domSz;
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup 	WlzIO
@@ -3496,6 +3899,27 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
         errNum = WLZ_ERR_WRITE_INCOMPLETE;
       }
     }
+    else if(tVal->pager != NULL)
+    {
+      size_t	idx,
+      		n;
+
+      /* Paged tiles are written a tile at a time. */
+      n = tVal->tileSz * vSz;
+      for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < tVal->numTiles); ++idx)
+      {
+	WlzTiledValuesPage *page;
+
+	if((page = WlzTiledValuesPageIn(tVal, idx, &errNum)) != NULL)
+	{
+	  if(fwrite(page->values.v, gSz, n, fP) != n)
+	  {
+	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	  }
+	  WlzTiledValuesPageOut(tVal, page);
+	}
+      }
+    }
     else if(writeTiles != 0)
     {
       /* No tile data so reserve tile space in the file by seeking
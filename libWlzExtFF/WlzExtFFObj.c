@@ -57,6 +57,10 @@ static WlzErrorNum		WlzEffWriteObjCM2Obj(
 static WlzErrorNum		WlzEffWriteObjCtrObj(
 				  FILE *fP,
 				  WlzObject *obj);
+static WlzErrorNum		WlzEffWriteObjIdxSurf(
+				  FILE *fP,
+				  WlzIndexedSurface *srf,
+				  const char *wrtStr);
 
 /*!
 * \return	Object read from file.
@@ -440,134 +444,115 @@ static WlzErrorNum WlzEffWriteObjCM2Obj(FILE *fP, WlzObject *obj)
 * \brief	Writes the given Woolz object (which is known to be a
 * 		WLZ_CONTOUR) to the given file stream using the Wavefront
 * 		obj file format, see WlzEffReadObjObj().
+* 		The contour's model is written via an indexed surface.
 * \param	fP			Output file stream.
 * \param	obj			Given woolz object (must not be NULL).
 */
 static WlzErrorNum WlzEffWriteObjCtrObj(FILE *fP, WlzObject *obj)
 {
-  int		nFce,
-  		nVtx;
-  WlzGMModel	*model;
-  WlzGMResIdxTb *resIdxTb = NULL;
+  WlzIndexedSurface *srf = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  if((obj->domain.core == NULL) || ((model = obj->domain.ctr->model) == NULL))
+  if((obj->domain.core == NULL) || (obj->domain.ctr->model == NULL))
   {
     errNum = WLZ_ERR_DOMAIN_NULL;
   }
   else
   {
-    switch(model->type)
-    {
-      case WLZ_GMMOD_3I: /* FALLTHROUGH */
-      case WLZ_GMMOD_3D: /* FALLTHROUGH */
-      case WLZ_GMMOD_3N:
-        break;
-      default:
-        errNum = WLZ_ERR_DOMAIN_TYPE;
-	break;
-    }
+    srf = WlzIndexedSurfaceFromGMModel(obj->domain.ctr->model, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Index the vertices. */
-    resIdxTb = WlzGMModelResIdx(model, WLZ_GMELMFLG_VERTEX, &errNum);
+    errNum = WlzEffWriteObjIdxSurf(fP, srf,
+                                   "WlzEffWriteObjCtrObj()");
   }
-  /* Check there are verticies and faces. */
-  if(errNum == WLZ_ERR_NONE)
+  (void )WlzFreeIndexedSurface(srf);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given indexed surface to the given file stream
+* 		using the Wavefront obj file format, see WlzEffReadObjObj().
+* \param	fP			Output file stream.
+* \param	srf			Given indexed surface.
+*/
+WlzErrorNum	WlzEffWriteIdxSurfObj(FILE *fP, WlzIndexedSurface *srf)
+{
+  return(WlzEffWriteObjIdxSurf(fP, srf, "WlzEffWriteIdxSurfObj()"));
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given indexed surface to the given file stream
+* 		using the Wavefront obj file format: vertex positions,
+* 		then vertex normals (if the surface has them) and then the
+* 		one based vertex indices of the faces.
+* \param	fP			Output file stream.
+* \param	srf			Given indexed surface.
+* \param	wrtStr			Name of the writer for the comment
+* 					header.
+*/
+static WlzErrorNum WlzEffWriteObjIdxSurf(FILE *fP, WlzIndexedSurface *srf,
+				const char *wrtStr)
+{
+  int		idN;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(srf == NULL)
   {
-    if(((nVtx = resIdxTb->vertex.idxCnt) != model->res.vertex.numElm) ||
-       (model->res.vertex.numElm < 3) || ((nFce = model->res.face.numElm) < 1))
-    {
-      errNum = WLZ_ERR_DOMAIN_DATA;
-    }
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((srf->nVtx < 3) || (srf->nFce < 1))
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
   }
   /* Output comment header. */
   if(errNum == WLZ_ERR_NONE)
   {
-    if(fprintf(fP,
-               "# wavefront obj file written by WlzEffWriteObjCtrObj()\n") <= 0)
+    if(fprintf(fP, "# wavefront obj file written by %s\n", wrtStr) <= 0)
     {
       errNum = WLZ_ERR_WRITE_INCOMPLETE;
     }
   }
   /* Output the vertex positions. */
-  if(errNum == WLZ_ERR_NONE)
+  for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < srf->nVtx); ++idN)
   {
-    int		idV;
-    AlcVector	*vec;
-    WlzDVertex3	pos;
+    WlzDVertex3	*pos;
 
-    vec = model->res.vertex.vec;
-    for(idV = 0; idV < model->res.vertex.numIdx; ++idV)
+    pos = srf->vtx + idN;
+    if(fprintf(fP, "v %lg %lg %lg\n", pos->vtX, pos->vtY, pos->vtZ) <= 0)
     {
-      WlzGMVertex *vtx;
-
-      vtx = (WlzGMVertex *)AlcVectorItemGet(vec, idV);
-      if(vtx->idx >= 0)
-      {
-	(void )WlzGMVertexGetG3D(vtx, &pos);
-	if(fprintf(fP, "v %lg %lg %lg\n", pos.vtX, pos.vtY, pos.vtZ) <=0)
-        {
-	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	}
-      }
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
     }
   }
-  /* Output vertex normals if the model has them. */
-  if((errNum == WLZ_ERR_NONE) && (model->type == WLZ_GMMOD_3N))
+  /* Output vertex normals if the surface has them. */
+  if(srf && srf->nrm)
   {
-    int		idV;
-    AlcVector	*vec;
-    WlzDVertex3	nrm;
-
-    vec = model->res.vertex.vec;
-    for(idV = 0; idV < model->res.vertex.numIdx; ++idV)
+    for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < srf->nVtx); ++idN)
     {
-      WlzGMVertex *vtx;
+      WlzDVertex3 *nrm;
 
-      vtx = (WlzGMVertex *)AlcVectorItemGet(vec, idV);
-      if(vtx->idx >= 0)
+      nrm = srf->nrm + idN;
+      if(fprintf(fP, "vn %lg %lg %lg\n", nrm->vtX, nrm->vtY, nrm->vtZ) <= 0)
       {
-	(void )WlzGMVertexGetG3N(vtx, NULL, &nrm);
-	if(fprintf(fP, "vn %lg %lg %lg\n", nrm.vtX, nrm.vtY, nrm.vtZ) <=0)
-        {
-	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	}
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
       }
     }
   }
   /* Output the vertex indices for the faces. */
-  if(errNum == WLZ_ERR_NONE)
+  for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < srf->nFce); ++idN)
   {
-    int		idF;
-    int		*lut;
-    WlzGMFace	*fce;
-    AlcVector	*vec;
-    int		idx[3];
+    int		*idx;
 
-    vec = model->res.face.vec;
-    lut = resIdxTb->vertex.idxLut;
-    for(idF = 0; idF < model->res.face.numIdx; ++idF)
+    idx = srf->idx + (3 * idN);
+    if(fprintf(fP, "f %d %d %d\n", idx[0] + 1, idx[1] + 1, idx[2] + 1) <= 0)
     {
-      fce = (WlzGMFace *)AlcVectorItemGet(vec, idF);
-      if(fce->idx >= 0)
-      {
-        WlzGMEdgeT	*tET;
-
-	tET = fce->loopT->edgeT;
-	idx[0] = *(lut + tET->vertexT->diskT->vertex->idx) + 1;
-	idx[1] = *(lut + tET->next->vertexT->diskT->vertex->idx) + 1;
-	idx[2] = *(lut + tET->prev->vertexT->diskT->vertex->idx) + 1;
-	if(fprintf(fP, "f %d %d %d\n", idx[0], idx[1], idx[2]) <= 0)
-	{
-	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	  break;
-	}
-      }
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
     }
   }
-  WlzGMModelResIdxFree(resIdxTb);
   return(errNum);
 }
 
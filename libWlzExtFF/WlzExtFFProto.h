@@ -189,6 +189,9 @@ extern WlzObject 		*WlzEffReadObjObj(
 extern WlzErrorNum 		WlzEffWriteObjObj(
 				  FILE *fP,
 				  WlzObject *obj);
+extern WlzErrorNum		WlzEffWriteIdxSurfObj(
+				  FILE *fP,
+				  WlzIndexedSurface *srf);
 
 /* From WlzExtFFEMT.c */
 extern WlzObject 		*WlzEffReadObjEMT(
@@ -290,6 +293,9 @@ extern WlzErrorNum		WlzEffWritePointsVtkScalarValues(
 extern WlzErrorNum		WlzEffWritePointsVtkFieldValues(
 				  FILE *fP, 
 				  WlzObject *obj);
+extern WlzErrorNum		WlzEffWriteIdxSurfVtk(
+				  FILE *fP,
+				  WlzIndexedSurface *srf);
 /* From WlzExtFFSlc.c */
 extern WlzObject 		*WlzEffReadObjSlc(
 				  FILE *fP,
@@ -315,6 +321,9 @@ extern WlzObject       		*WlzEffReadObjStl(
 extern WlzErrorNum     		WlzEffWriteObjStl(
 				  FILE *fP,
 				  WlzObject *obj);
+extern WlzErrorNum		WlzEffWriteIdxSurfStl(
+				  FILE *fP,
+				  WlzIndexedSurface *srf);
 /* From WlzExtFFIPL.c */
 extern WlzObject 		*WlzEffReadObjIPL(
 				  FILE *fP,
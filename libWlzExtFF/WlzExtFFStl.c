@@ -440,40 +440,51 @@ static WlzErrorNum WlzEffWriteObjCM2D5Stl(FILE *fP, WlzObject *obj)
 * \brief	Writes the given Woolz object (which is known to be a
 * 		WLZ_CONTOUR) to the given file stream using the
 * 		stereolithography stl file format, see WlzEffReadObjStl().
+* 		The contour's model is written via an indexed surface.
 * \param	fP			Output file stream.
 * \param	obj			Given woolz object (must not be NULL).
 */
 static WlzErrorNum WlzEffWriteObjCtrStl(FILE *fP, WlzObject *obj)
 {
-  int		nFce;
-  WlzGMModel	*model;
-  WlzGMResIdxTb *resIdxTb = NULL;
+  WlzIndexedSurface *srf = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  if((obj->domain.core == NULL) || ((model = obj->domain.ctr->model) == NULL))
+  if((obj->domain.core == NULL) || (obj->domain.ctr->model == NULL))
   {
     errNum = WLZ_ERR_DOMAIN_NULL;
   }
   else
   {
-    switch(model->type)
-    {
-      case WLZ_GMMOD_3I: /* FALLTHROUGH */
-      case WLZ_GMMOD_3D: /* FALLTHROUGH */
-      case WLZ_GMMOD_3N:
-        break;
-      default:
-        errNum = WLZ_ERR_DOMAIN_TYPE;
-	break;
-    }
+    srf = WlzIndexedSurfaceFromGMModel(obj->domain.ctr->model, &errNum);
   }
-  /* Check there are verticies and faces. */
   if(errNum == WLZ_ERR_NONE)
   {
-    if((model->res.vertex.numElm < 3) || ((nFce = model->res.face.numElm) < 1))
-    {
-      errNum = WLZ_ERR_DOMAIN_DATA;
-    }
+    errNum = WlzEffWriteIdxSurfStl(fP, srf);
+  }
+  (void )WlzFreeIndexedSurface(srf);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given indexed surface to the given file stream
+* 		using the stereolithography stl file format, see
+* 		WlzEffReadObjStl().
+* \param	fP			Output file stream.
+* \param	srf			Given indexed surface.
+*/
+WlzErrorNum	WlzEffWriteIdxSurfStl(FILE *fP, WlzIndexedSurface *srf)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(srf == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((srf->nVtx < 3) || (srf->nFce < 1))
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -485,42 +496,36 @@ static WlzErrorNum WlzEffWriteObjCtrStl(FILE *fP, WlzObject *obj)
   if(errNum == WLZ_ERR_NONE)
   {
     int		idF;
-    WlzGMFace	*fce;
-    AlcVector	*vec;
     WlzDVertex3 nrm;
-    WlzDVertex3	vBuf[3];
+    WlzDVertex3	*v[3];
 
-    vec = model->res.face.vec;
-    for(idF = 0; idF < model->res.face.numIdx; ++idF)
+    for(idF = 0; idF < srf->nFce; ++idF)
     {
-      fce = (WlzGMFace *)AlcVectorItemGet(vec, idF);
-      if(fce->idx >= 0)
+      int	*idx;
+
+      idx = srf->idx + (3 * idF);
+      v[0] = srf->vtx + idx[0];
+      v[1] = srf->vtx + idx[1];
+      v[2] = srf->vtx + idx[2];
+      nrm = WlzGeomTriangleNormal(*v[0], *v[1], *v[2]);
+      if(fprintf(fP,
+		 "  facet normal %g %g %g\n"
+		 "    outer loop\n"
+		 "      vertex %g %g %g\n"
+		 "      vertex %g %g %g\n"
+		 "      vertex %g %g %g\n"
+		 "    endloop\n"
+		 "  endfacet\n",
+		 nrm.vtX, nrm.vtY, nrm.vtZ,
+		 v[0]->vtX, v[0]->vtY, v[0]->vtZ,
+		 v[1]->vtX, v[1]->vtY, v[1]->vtZ,
+		 v[2]->vtX, v[2]->vtY, v[2]->vtZ) <= 0)
       {
-        errNum = WlzGMFaceGetG3D(fce, vBuf + 0, vBuf + 1, vBuf + 2);
-	if(errNum == WLZ_ERR_NONE)
-	{
-	  nrm = WlzGeomTriangleNormal(vBuf[0], vBuf[1], vBuf[2]);
-	  if(fprintf(fP,
-		     "  facet normal %g %g %g\n"
-		     "    outer loop\n"
-		     "      vertex %g %g %g\n"
-		     "      vertex %g %g %g\n"
-		     "      vertex %g %g %g\n"
-		     "    endloop\n"
-		     "  endfacet\n",
-		     nrm.vtX, nrm.vtY, nrm.vtZ,
-		     vBuf[0].vtX, vBuf[0].vtY, vBuf[0].vtZ,
-		     vBuf[1].vtX, vBuf[1].vtY, vBuf[1].vtZ,
-		     vBuf[2].vtX, vBuf[2].vtY, vBuf[2].vtZ) <= 0)
-	  {
-	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	    break;
-	  }
-	}
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	break;
       }
     }
   }
-  WlzGMModelResIdxFree(resIdxTb);
   if(errNum == WLZ_ERR_NONE)
   {
     if(fprintf(fP, "endsolid\n") <= 0)
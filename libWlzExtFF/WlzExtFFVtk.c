@@ -290,6 +290,20 @@ static WlzErrorNum WlzEffWriteCtrVtk(FILE *fP, WlzContour *ctr)
   {
     errNum = WLZ_ERR_DOMAIN_TYPE;
   }
+  else if((ctr->model != NULL) &&
+          ((ctr->model->type == WLZ_GMMOD_3I) ||
+	   (ctr->model->type == WLZ_GMMOD_3D) ||
+	   (ctr->model->type == WLZ_GMMOD_3N)))
+  {
+    WlzIndexedSurface *srf;
+
+    srf = WlzIndexedSurfaceFromGMModel(ctr->model, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzEffWriteIdxSurfVtk(fP, srf);
+      (void )WlzFreeIndexedSurface(srf);
+    }
+  }
   else
   {
     errNum = WlzEffWriteGMModelVtk(fP, ctr->model);
@@ -297,6 +311,75 @@ static WlzErrorNum WlzEffWriteCtrVtk(FILE *fP, WlzContour *ctr)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given indexed surface to the given stream
+*		using the Visualization Toolkit (polydata) file format.
+* \param	fP			Output file stream.
+* \param	srf			Given indexed surface.
+*/
+WlzErrorNum	WlzEffWriteIdxSurfVtk(FILE *fP, WlzIndexedSurface *srf)
+{
+  int		idN;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(srf == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(srf->nVtx < 1)
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Output the file header and vertex geometries. */
+    (void )fprintf(fP,
+    		   "# vtk DataFile Version 1.0\n"
+    		   "WlzGeoModel test output\n"
+		   "ASCII\n"
+		   "DATASET POLYDATA\n"
+		   "POINTS %d float\n",
+		   srf->nVtx);
+    for(idN = 0; idN < srf->nVtx; ++idN)
+    {
+      WlzDVertex3 *vtx;
+
+      vtx = srf->vtx + idN;
+      (void )fprintf(fP, "%g %g %g\n", vtx->vtX, vtx->vtY, vtx->vtZ);
+    }
+    /* Output the vertex indicies of the faces. */
+    (void )fprintf(fP,
+		   "POLYGONS %d %d\n",
+		   srf->nFce, 4 * srf->nFce);
+    for(idN = 0; idN < srf->nFce; ++idN)
+    {
+      int	*idx;
+
+      idx = srf->idx + (3 * idN);
+      (void )fprintf(fP, "3 %d %d %d\n", idx[0], idx[1], idx[2]);
+    }
+    /* Output the normals if the surface has them. */
+    if(srf->nrm)
+    {
+      (void )fprintf(fP,
+		     "\n"
+		     "POINT_DATA %d\n"
+		     "NORMALS normals float\n",
+		     srf->nVtx);
+      for(idN = 0; idN < srf->nVtx; ++idN)
+      {
+	WlzDVertex3 *nrm;
+
+	nrm = srf->nrm + idN;
+	(void )fprintf(fP, "%g %g %g\n", nrm->vtX, nrm->vtY, nrm->vtZ);
+      }
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error number.
 * \ingroup	WlzExtFF